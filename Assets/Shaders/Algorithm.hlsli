@@ -12,7 +12,9 @@ float3 ComputeWorldNormal(VSOutput Output, float3 NormalMapNormal)
 	float3 WorldBitangent = normalize(cross(WorldNormal, WorldTangent));
 	float3x3 TBN = float3x3(WorldTangent, WorldBitangent, WorldNormal);
 
-	WorldNormal = NormalMapNormal * 2.0 - 1.0;
+	// Normal maps may be BC5 which only keeps x and y, z is always rebuilt from them.
+	WorldNormal.xy = NormalMapNormal.xy * 2.0 - 1.0;
+	WorldNormal.z = sqrt(saturate(1.0 - dot(WorldNormal.xy, WorldNormal.xy)));
 	WorldNormal = mul(WorldNormal, TBN); // Transpose
 #endif
 	return WorldNormal;
@@ -182,15 +182,25 @@ private: \
 
 #define SHADER_VARIABLE_STORAGE_BUFFER(Name, Binding) RWBuffer Name : register(u##Binding);
 
+#if _OCTAHEDRAL_DIRECTION_
+	#define VS_INPUT_NORMAL float2
+	#define VS_INPUT_TANGENT float4
+#else
+	#define VS_INPUT_NORMAL float3
+	#define VS_INPUT_TANGENT float3
+#endif
+
 struct VSInput
 {
 	VK_LOCATION(0) float3 Position : POSITION;
 
 #if _HAS_NORMAL_
-	VK_LOCATION(1) float3 Normal : NORMAL;
+	VK_LOCATION(1) VS_INPUT_NORMAL Normal : NORMAL;
 	#if _HAS_TANGENT_
-		VK_LOCATION(2) float3 Tangent : TANGENT;
-		VK_LOCATION(3) float3 BiTangent : BITANGENT;
+		VK_LOCATION(2) VS_INPUT_TANGENT Tangent : TANGENT;
+		#if !_OCTAHEDRAL_DIRECTION_
+			VK_LOCATION(3) float3 BiTangent : BITANGENT;
+		#endif
 		#if _HAS_UV0_
 			VK_LOCATION(4) float3 UV0 : TEXCOORD0;
 			#if _HAS_UV1_
@@ -362,6 +372,8 @@ BEGIN_SHADER_VARIABLE_UNIFORM_BUFFER(WVP)
 	UNIFORM_BUFFER_VARIABLE(float4x4, WorldMatrix)
 	UNIFORM_BUFFER_VARIABLE(float4x4, ViewMatrix)
 	UNIFORM_BUFFER_VARIABLE(float4x4, ProjectionMatrix)
+	UNIFORM_BUFFER_VARIABLE(float4, PositionScale)
+	UNIFORM_BUFFER_VARIABLE(float4, PositionBias)
 END_SHADER_VARIABLE_UNIFORM_BUFFER
 
 BEGIN_SHADER_VARIABLE_UNIFORM_BUFFER(MaterialProperty)
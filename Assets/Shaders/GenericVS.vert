@@ -1,4 +1,5 @@
 #include "Shaders/Definitions.h"
+#include "Shaders/Math.hlsli"
 
 DEFINE_SHADER_VARIABLES_GENERIC_VS
 
@@ -6,18 +7,36 @@ VSOutput main(VSInput Input)
 {	
 	VSOutput Output = (VSOutput)0;
 
-	float4 WorldPosition = mul(WVP.WorldMatrix, float4(Input.Position, 1.0));
+#if _QUANTIZED_POSITION_
+	float3 Position = Input.Position * WVP.PositionScale.xyz + WVP.PositionBias.xyz;
+#else
+	float3 Position = Input.Position;
+#endif
+
+	float4 WorldPosition = mul(WVP.WorldMatrix, float4(Position, 1.0));
 
 	Output.WorldPosition = WorldPosition.xyz;
 	Output.Position = mul(WVP.ProjectionMatrix, mul(WVP.ViewMatrix, WorldPosition));
 
 #if _HAS_NORMAL_
-	Output.WorldNormal = mul(WVP.WorldMatrix, float4(Input.Normal, 1.0)).xyz;
+	#if _OCTAHEDRAL_DIRECTION_
+		float3 Normal = OctahedralDecode(Input.Normal);
+	#else
+		float3 Normal = Input.Normal;
+	#endif
+	Output.WorldNormal = mul(WVP.WorldMatrix, float4(Normal, 1.0)).xyz;
 #endif
 
 #if _HAS_TANGENT_
-	Output.WorldTangent = mul(WVP.WorldMatrix, float4(Input.Tangent, 1.0)).xyz;
-	Output.WorldBiTangent = mul(WVP.WorldMatrix, float4(Input.BiTangent, 1.0)).xyz;
+	#if _OCTAHEDRAL_DIRECTION_
+		float3 Tangent = OctahedralDecode(Input.Tangent.xy);
+		float3 BiTangent = cross(Normal, Tangent) * (Input.Tangent.z < 0.0 ? -1.0 : 1.0);
+	#else
+		float3 Tangent = Input.Tangent;
+		float3 BiTangent = Input.BiTangent;
+	#endif
+	Output.WorldTangent = mul(WVP.WorldMatrix, float4(Tangent, 1.0)).xyz;
+	Output.WorldBiTangent = mul(WVP.WorldMatrix, float4(BiTangent, 1.0)).xyz;
 #endif
 
 #if _HAS_UV0_
@@ -263,4 +263,15 @@ float4 pow6(float4 A)
 	return AA * AA * AA;
 }
 
+float3 OctahedralDecode(float2 Encoded)
+{
+	float3 Direction = float3(Encoded.xy, 1.0 - abs(Encoded.x) - abs(Encoded.y));
+	if (Direction.z < 0.0)
+	{
+		float2 Sign = float2(Direction.x >= 0.0 ? 1.0 : -1.0, Direction.y >= 0.0 ? 1.0 : -1.0);
+		Direction.xy = (1.0 - abs(Direction.yx)) * Sign;
+	}
+	return normalize(Direction);
+}
+
 #endif  // __INCLUDE_MATH__
\ No newline at end of file
@@ -167,6 +167,175 @@ VulkanPipelineBarrier& VulkanPipelineBarrier::AddImageLayoutTransition(
 	return *this;
 }
 
+struct VkStateScope
+{
+	vk::ImageLayout Layout = vk::ImageLayout::eUndefined;
+	vk::AccessFlags AccessFlags;
+	vk::PipelineStageFlags StageFlags;
+};
+
+static VkStateScope GetStateScope(ERHIResourceState State)
+{
+	VkStateScope Scope;
+
+	if (State == ERHIResourceState::Unknown || State == ERHIResourceState::Common)
+	{
+		Scope.StageFlags = vk::PipelineStageFlagBits::eTopOfPipe;
+		return Scope;
+	}
+
+	uint32_t NumStates = 0u;
+	for (uint32_t Bit = 1u; Bit <= static_cast<uint32_t>(ERHIResourceState::InputAttachment); Bit <<= 1u)
+	{
+		const auto SingleState = static_cast<ERHIResourceState>(Bit);
+		if (EnumHasAnyFlags(State, SingleState))
+		{
+			Scope.AccessFlags |= GetAccessFlags(SingleState);
+			Scope.StageFlags |= GetPipelineStageFlags(SingleState);
+			Scope.Layout = GetImageLayout(SingleState);
+			++NumStates;
+		}
+	}
+
+	/// Sampling a depth buffer bound read only is fine in the depth read only layout, every other combination needs the general one.
+	if (NumStates > 1u)
+	{
+		const auto DepthSampled = ERHIResourceState::DepthRead | ERHIResourceState::ShaderResource;
+		Scope.Layout = (State & DepthSampled) == State ? vk::ImageLayout::eDepthStencilReadOnlyOptimal : vk::ImageLayout::eGeneral;
+	}
+
+	if (!Scope.StageFlags)
+	{
+		Scope.StageFlags = vk::PipelineStageFlagBits::eAllCommands;
+	}
+
+	return Scope;
+}
+
+/// The release half only covers the source queue, which may not even support the stages of the destination state, the acquire half
+/// only the destination queue. Both transition the layout the same way. Queues of one family need no transfer at all.
+static void ApplyQueueTransfer(const VulkanDevice& Device, const VkQueueTransfer& QueueTransfer, VkStateScope& Src, VkStateScope& Dst, uint32_t& SrcQueueFamilyIndex, uint32_t& DstQueueFamilyIndex)
+{
+	SrcQueueFamilyIndex = DstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+	if (QueueTransfer.SrcQueue == QueueTransfer.DstQueue)
+	{
+		return;
+	}
+
+	const uint32_t SrcFamilyIndex = Device.GetQueue(QueueTransfer.SrcQueue).GetFamilyIndex();
+	const uint32_t DstFamilyIndex = Device.GetQueue(QueueTransfer.DstQueue).GetFamilyIndex();
+	if (SrcFamilyIndex == DstFamilyIndex)
+	{
+		return;
+	}
+
+	SrcQueueFamilyIndex = SrcFamilyIndex;
+	DstQueueFamilyIndex = DstFamilyIndex;
+
+	if (QueueTransfer.Acquire)
+	{
+		Src.AccessFlags = vk::AccessFlags();
+		Src.StageFlags = vk::PipelineStageFlagBits::eTopOfPipe;
+	}
+	else
+	{
+		Dst.AccessFlags = vk::AccessFlags();
+		Dst.StageFlags = vk::PipelineStageFlagBits::eBottomOfPipe;
+	}
+}
+
+VulkanPipelineBarrier& VulkanPipelineBarrier::AddImageTransition(
+	vk::Image Image,
+	ERHIResourceState SrcState,
+	ERHIResourceState DstState,
+	const vk::ImageSubresourceRange& Subresource,
+	bool Discard,
+	const VkQueueTransfer& QueueTransfer)
+{
+	auto Src = GetStateScope(SrcState);
+	auto Dst = GetStateScope(DstState);
+	const auto SrcLayout = Discard ? vk::ImageLayout::eUndefined : Src.Layout;
+
+	uint32_t SrcQueueFamilyIndex, DstQueueFamilyIndex;
+	ApplyQueueTransfer(GetDevice(), QueueTransfer, Src, Dst, SrcQueueFamilyIndex, DstQueueFamilyIndex);
+
+	if (m_UseBarrier2)
+	{
+		auto& ImageMemoryBarrier = m_ImageMemoryBarriers2.emplace_back();
+		ImageMemoryBarrier.setSrcStageMask(vk::PipelineStageFlags2(static_cast<VkPipelineStageFlags>(Src.StageFlags)))
+			.setSrcAccessMask(vk::AccessFlags2(static_cast<VkAccessFlags>(Src.AccessFlags)))
+			.setDstStageMask(vk::PipelineStageFlags2(static_cast<VkPipelineStageFlags>(Dst.StageFlags)))
+			.setDstAccessMask(vk::AccessFlags2(static_cast<VkAccessFlags>(Dst.AccessFlags)))
+			.setOldLayout(SrcLayout)
+			.setNewLayout(Dst.Layout)
+			.setSrcQueueFamilyIndex(SrcQueueFamilyIndex)
+			.setDstQueueFamilyIndex(DstQueueFamilyIndex)
+			.setImage(Image)
+			.setSubresourceRange(Subresource);
+	}
+	else
+	{
+		auto& ImageMemoryBarrier = m_ImageMemoryBarriers.emplace_back();
+		ImageMemoryBarrier.setSrcAccessMask(Src.AccessFlags)
+			.setDstAccessMask(Dst.AccessFlags)
+			.setOldLayout(SrcLayout)
+			.setNewLayout(Dst.Layout)
+			.setSrcQueueFamilyIndex(SrcQueueFamilyIndex)
+			.setDstQueueFamilyIndex(DstQueueFamilyIndex)
+			.setImage(Image)
+			.setSubresourceRange(Subresource);
+
+		m_SrcPipelineStageFlags |= Src.StageFlags;
+		m_DstPipelineStageFlags |= Dst.StageFlags;
+	}
+
+	return *this;
+}
+
+VulkanPipelineBarrier& VulkanPipelineBarrier::AddBufferTransition(
+	vk::Buffer Buffer,
+	ERHIResourceState SrcState,
+	ERHIResourceState DstState,
+	const VkQueueTransfer& QueueTransfer)
+{
+	auto Src = GetStateScope(SrcState);
+	auto Dst = GetStateScope(DstState);
+
+	uint32_t SrcQueueFamilyIndex, DstQueueFamilyIndex;
+	ApplyQueueTransfer(GetDevice(), QueueTransfer, Src, Dst, SrcQueueFamilyIndex, DstQueueFamilyIndex);
+
+	if (m_UseBarrier2)
+	{
+		auto& BufferMemoryBarrier = m_BufferMemoryBarriers2.emplace_back();
+		BufferMemoryBarrier.setSrcStageMask(vk::PipelineStageFlags2(static_cast<VkPipelineStageFlags>(Src.StageFlags)))
+			.setSrcAccessMask(vk::AccessFlags2(static_cast<VkAccessFlags>(Src.AccessFlags)))
+			.setDstStageMask(vk::PipelineStageFlags2(static_cast<VkPipelineStageFlags>(Dst.StageFlags)))
+			.setDstAccessMask(vk::AccessFlags2(static_cast<VkAccessFlags>(Dst.AccessFlags)))
+			.setSrcQueueFamilyIndex(SrcQueueFamilyIndex)
+			.setDstQueueFamilyIndex(DstQueueFamilyIndex)
+			.setBuffer(Buffer)
+			.setOffset(0u)
+			.setSize(VK_WHOLE_SIZE);
+	}
+	else
+	{
+		auto& BufferMemoryBarrier = m_BufferMemoryBarriers.emplace_back();
+		BufferMemoryBarrier.setSrcAccessMask(Src.AccessFlags)
+			.setDstAccessMask(Dst.AccessFlags)
+			.setSrcQueueFamilyIndex(SrcQueueFamilyIndex)
+			.setDstQueueFamilyIndex(DstQueueFamilyIndex)
+			.setBuffer(Buffer)
+			.setOffset(0u)
+			.setSize(VK_WHOLE_SIZE);
+
+		m_SrcPipelineStageFlags |= Src.StageFlags;
+		m_DstPipelineStageFlags |= Dst.StageFlags;
+	}
+
+	return *this;
+}
+
 void VulkanPipelineBarrier::Submit(VulkanCommandBuffer* CommandBuffer)
 {
 	assert(CommandBuffer);
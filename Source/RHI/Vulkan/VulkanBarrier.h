@@ -2,6 +2,14 @@
 
 #include "RHI/Vulkan/VulkanTypes.h"
 
+/// Ownership transfer between queue families, recorded once as the release on the source queue and once as the acquire on the destination queue.
+struct VkQueueTransfer
+{
+	ERHIDeviceQueue SrcQueue = ERHIDeviceQueue::Graphics;
+	ERHIDeviceQueue DstQueue = ERHIDeviceQueue::Graphics;
+	bool Acquire = false;
+};
+
 class VulkanPipelineBarrier : public VkBaseDeviceResource
 {
 public:
@@ -15,6 +23,21 @@ public:
 		vk::ImageLayout DstLayout, 
 		const vk::ImageSubresourceRange& Subresource);
 
+	/// Scopes and layouts follow from the resource states, which may combine several states. Discard transitions from an undefined layout.
+	VulkanPipelineBarrier& AddImageTransition(
+		vk::Image Image,
+		ERHIResourceState SrcState,
+		ERHIResourceState DstState,
+		const vk::ImageSubresourceRange& Subresource,
+		bool Discard = false,
+		const VkQueueTransfer& QueueTransfer = VkQueueTransfer());
+
+	VulkanPipelineBarrier& AddBufferTransition(
+		vk::Buffer Buffer,
+		ERHIResourceState SrcState,
+		ERHIResourceState DstState,
+		const VkQueueTransfer& QueueTransfer = VkQueueTransfer());
+
 	void Submit(class VulkanCommandBuffer* CommandBuffer);
 private:
 	std::vector<vk::MemoryBarrier> m_MemoryBarriers;
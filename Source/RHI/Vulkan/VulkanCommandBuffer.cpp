@@ -2,6 +2,7 @@
 #include "RHI/Vulkan/VulkanCommandPool.h"
 #include "RHI/Vulkan/VulkanDevice.h"
 #include "RHI/Vulkan/VulkanBuffer.h"
+#include "RHI/Vulkan/VulkanTexture.h"
 #include "RHI/Vulkan/VulkanPipeline.h"
 #include "RHI/Vulkan/VulkanLayerExtensions.h"
 #include "RHI/Vulkan/VulkanBarrier.h"
@@ -65,9 +66,13 @@ void VulkanCommandBuffer::Begin()
 
 	assert(IsReady());
 
+	/// Secondary command buffers are recorded outside of render pass instances and inherit nothing, but must still name an inheritance info.
+	vk::CommandBufferInheritanceInfo InheritanceInfo;
+
 	vk::CommandBufferBeginInfo BeginInfo;
-	BeginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
-	
+	BeginInfo.setFlags(vk::CommandBufferUsageFlagBits::eOneTimeSubmit)
+		.setPInheritanceInfo(GetLevel() == ERHICommandBufferLevel::Secondary ? &InheritanceInfo : nullptr);
+
 	VERIFY_VK(GetNative().begin(&BeginInfo));
 
 	SetStatus(EStatus::Recording);
@@ -150,9 +155,22 @@ void VulkanCommandBuffer::Reset()
 
 	GetNative().reset(vk::CommandBufferResetFlagBits::eReleaseResources);
 
+	m_WaitSemaphores.clear();
+	m_WaitDstStageFlags.clear();
+	m_WaitValues.clear();
+
 	SetStatus(EStatus::Initial);
 }
 
+void VulkanCommandBuffer::AddWaitSemaphore(VulkanSemaphore* Semaphore, vk::PipelineStageFlags StageFlags, uint64_t Value)
+{
+	assert(Semaphore && GetLevel() == ERHICommandBufferLevel::Primary);
+
+	m_WaitSemaphores.push_back(Semaphore);
+	m_WaitDstStageFlags.push_back(StageFlags);
+	m_WaitValues.push_back(Value);
+}
+
 void VulkanCommandBuffer::BeginDebugMarker(const char* Name, const Math::Color& MarkerColor)
 {
 	assert(IsRecording() && Name);
@@ -344,6 +362,15 @@ void VulkanCommandBuffer::SetScissorRects(const RHIScissorRect* ScissorRects, ui
 
 void VulkanCommandBuffer::RefreshStatus()
 {
+	if (GetLevel() == ERHICommandBufferLevel::Secondary)
+	{
+		if (IsSubmitted() && IsPrimarySubmissionCompleted())
+		{
+			SetStatus(EStatus::NeedReset);
+		}
+		return;
+	}
+
 	if (IsSubmitted() && m_Fence.IsSignaled())
 	{
 		m_Fence.Reset();
@@ -588,7 +615,7 @@ void VulkanCommandBuffer::WriteBuffer(const RHIBuffer* Buffer, const RHIBuffer*
 
 void VulkanCommandBuffer::WriteTexture(const RHITexture* Texture, const RHIBuffer* StagingBuffer, size_t Size, uint32_t ArrayLayer, uint32_t MipLevel, size_t SrcOffset)
 {
-	assert(Texture && StagingBuffer && Size && SrcOffset < Size);
+	assert(Texture && StagingBuffer && Size);
 	assert(!IsInsideRenderPass());
 
 	auto SrcBuffer = Cast<VulkanBuffer>(StagingBuffer);
@@ -605,12 +632,13 @@ void VulkanCommandBuffer::WriteTexture(const RHITexture* Texture, const RHIBuffe
 	vk::ImageSubresourceRange SubresourceRange(vk::ImageAspectFlagBits::eColor, MipLevel, 1u, ArrayLayer, 1u);
 	ERHIDeviceQueue DstQueue = GetDevice().GetCapabilities().SupportsTransferQueue ? ERHIDeviceQueue::Transfer : ERHIDeviceQueue::Graphics;
 
+	/// Copied on the transfer queue, the image is released to the graphics queue afterwards, see RHIUploadManager::AcquireUploadedTexture.
 	VulkanPipelineBarrier Barrier(GetDevice());
-	Barrier.AddImageLayoutTransition(ERHIDeviceQueue::Graphics, DstQueue, DstImage->GetNative(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, SubresourceRange)
+	Barrier.AddImageLayoutTransition(DstQueue, DstQueue, DstImage->GetNative(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, SubresourceRange)
 		.Submit(this);
 
 	vk::BufferImageCopy CopyRegion(
-		0u,
+		SrcOffset,
 		FormatAttributes.NumCols * FormatAttributes.BlockSize,
 		FormatAttributes.NumRows * FormatAttributes.BlockSize,
 		vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, MipLevel, ArrayLayer, 1u),
@@ -618,13 +646,13 @@ void VulkanCommandBuffer::WriteTexture(const RHITexture* Texture, const RHIBuffe
 		vk::Extent3D(MipWidth, MipHeight, MipDepth));
 	GetNative().copyBufferToImage(SrcBuffer->GetNative(), DstImage->GetNative(), vk::ImageLayout::eTransferDstOptimal, 1u, &CopyRegion);
 
-	Barrier.AddImageLayoutTransition(ERHIDeviceQueue::Graphics, DstQueue, DstImage->GetNative(), vk::ImageLayout::eTransferDstOptimal, ::GetImageLayout(Texture->GetState()), SubresourceRange)
+	Barrier.AddImageLayoutTransition(DstQueue, ERHIDeviceQueue::Graphics, DstImage->GetNative(), vk::ImageLayout::eTransferDstOptimal, ::GetImageLayout(Texture->GetState()), SubresourceRange)
 		.Submit(this);
 }
 
 void VulkanCommandBuffer::WriteTexture(const RHITexture* Texture, const RHIBuffer* StagingBuffer, size_t Size, size_t SrcOffset)
 {
-	assert(Texture && StagingBuffer && Size && SrcOffset < Size);
+	assert(Texture && StagingBuffer && Size);
 	assert(!IsInsideRenderPass());
 
 	auto SrcBuffer = Cast<VulkanBuffer>(StagingBuffer);
@@ -636,6 +664,9 @@ void VulkanCommandBuffer::WriteTexture(const RHITexture* Texture, const RHIBuffe
 	std::vector<vk::BufferImageCopy> CopyRegions;
 	CopyRegions.reserve(Texture->GetNumArrayLayer() * Texture->GetNumMipLevel());
 
+	/// The staging data is packed layer by layer, mip 0 first within each layer.
+	size_t BufferOffset = SrcOffset;
+
 	for (uint32_t ArrayLayer = 0u; ArrayLayer < Texture->GetNumArrayLayer(); ++ArrayLayer)
 	{
 		for (uint32_t MipLevel = 0u; MipLevel < Texture->GetNumMipLevel(); ++MipLevel)
@@ -646,28 +677,89 @@ void VulkanCommandBuffer::WriteTexture(const RHITexture* Texture, const RHIBuffe
 			auto FormatAttributes = RHI::GetFormatAttributes(MipWidth, MipHeight, Texture->GetFormat());
 
 			CopyRegions.emplace_back(vk::BufferImageCopy(
-				0u,
+				BufferOffset,
 				FormatAttributes.NumCols * FormatAttributes.BlockSize,
 				FormatAttributes.NumRows * FormatAttributes.BlockSize,
 				vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, MipLevel, ArrayLayer, 1u),
 				vk::Offset3D(0, 0, 0),
 				vk::Extent3D(MipWidth, MipHeight, MipDepth)));
+
+			BufferOffset += FormatAttributes.SlicePitch * MipDepth;
 		}
 	}
 
 	vk::ImageSubresourceRange SubresourceRange(vk::ImageAspectFlagBits::eColor, 0u, VK_REMAINING_MIP_LEVELS, 0u, VK_REMAINING_ARRAY_LAYERS);
 	ERHIDeviceQueue DstQueue = GetDevice().GetCapabilities().SupportsTransferQueue ? ERHIDeviceQueue::Transfer : ERHIDeviceQueue::Graphics;
 
+	/// Copied on the transfer queue, the image is released to the graphics queue afterwards, see RHIUploadManager::AcquireUploadedTexture.
 	VulkanPipelineBarrier Barrier(GetDevice());
-	Barrier.AddImageLayoutTransition(ERHIDeviceQueue::Graphics, DstQueue, DstImage->GetNative(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, SubresourceRange)
+	Barrier.AddImageLayoutTransition(DstQueue, DstQueue, DstImage->GetNative(), vk::ImageLayout::eUndefined, vk::ImageLayout::eTransferDstOptimal, SubresourceRange)
 		.Submit(this);
 
 	GetNative().copyBufferToImage(SrcBuffer->GetNative(), DstImage->GetNative(), vk::ImageLayout::eTransferDstOptimal, CopyRegions);
 
-	Barrier.AddImageLayoutTransition(ERHIDeviceQueue::Graphics, DstQueue, DstImage->GetNative(), vk::ImageLayout::eTransferDstOptimal, ::GetImageLayout(Texture->GetState()), SubresourceRange)
+	Barrier.AddImageLayoutTransition(DstQueue, ERHIDeviceQueue::Graphics, DstImage->GetNative(), vk::ImageLayout::eTransferDstOptimal, ::GetImageLayout(Texture->GetState()), SubresourceRange)
 		.Submit(this);
 }
 
+void VulkanCommandBuffer::Transition(const RHITransition* Transitions, uint32_t NumTransitions)
+{
+	assert(!IsInsideRenderPass());
+
+	VulkanPipelineBarrier Barrier(GetDevice());
+
+	for (uint32_t Index = 0u; Index < NumTransitions; ++Index)
+	{
+		const auto& Transition = Transitions[Index];
+
+		/// The device reports no split barriers, so the graph plans none on the same queue. Should one come anyway, the whole barrier goes
+		/// with the end. Between queues both halves count, the queue family ownership transfer needs a release and an acquire.
+		const bool CrossQueue = Transition.SrcQueue != Transition.DstQueue;
+		if (EnumHasAnyFlags(Transition.Flags, ERHITransitionFlags::BeginOnly) && !CrossQueue)
+		{
+			continue;
+		}
+
+		VkQueueTransfer QueueTransfer;
+		if (CrossQueue)
+		{
+			QueueTransfer.SrcQueue = Transition.SrcQueue;
+			QueueTransfer.DstQueue = Transition.DstQueue;
+			QueueTransfer.Acquire = !EnumHasAnyFlags(Transition.Flags, ERHITransitionFlags::BeginOnly);
+		}
+
+		if (Transition.Texture)
+		{
+			auto Image = Cast<VulkanTexture>(Transition.Texture);
+			assert(Image);
+
+			const auto Format = Transition.Texture->GetFormat();
+			vk::ImageAspectFlags AspectFlags = RHI::IsDepthStencil(Format) ? (vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil) :
+				(RHI::IsDepth(Format) ? vk::ImageAspectFlagBits::eDepth : vk::ImageAspectFlagBits::eColor);
+
+			const auto& Subresource = Transition.Subresource;
+			vk::ImageSubresourceRange SubresourceRange(
+				AspectFlags,
+				Subresource.BaseMipLevel,
+				Subresource.NumMips == RHISubresource::AllMipLevels ? VK_REMAINING_MIP_LEVELS : Subresource.NumMips,
+				Subresource.BaseArrayLayer,
+				Subresource.NumLayers == RHISubresource::AllArrayLayers ? VK_REMAINING_ARRAY_LAYERS : Subresource.NumLayers);
+
+			Barrier.AddImageTransition(Image->GetNative(), Transition.SrcState, Transition.DstState, SubresourceRange,
+				EnumHasAnyFlags(Transition.Flags, ERHITransitionFlags::Discard), QueueTransfer);
+		}
+		else if (Transition.Buffer)
+		{
+			auto Buffer = Cast<VulkanBuffer>(Transition.Buffer);
+			assert(Buffer);
+
+			Barrier.AddBufferTransition(Buffer->GetNative(), Transition.SrcState, Transition.DstState, QueueTransfer);
+		}
+	}
+
+	Barrier.Submit(this);
+}
+
 //void VulkanCommandBuffer::SetPolygonMode(EPolygonMode Mode)
 //{
 //#if VK_EXT_extended_dynamic_state
@@ -686,6 +778,20 @@ void VulkanCommandBuffer::WriteTexture(const RHITexture* Texture, const RHIBuffe
 //#endif
 //}
 
+void VulkanCommandBuffer::ExecuteSecondaryCommands(RHICommandBuffer* const* CommandBuffers, uint32_t NumCommandBuffers)
+{
+	/// Every secondary command buffer comes from a pool of the same queue family, is ended and recorded outside of render pass instances.
+	assert(IsRecording());
+
+	std::vector<vk::CommandBuffer> NativeCommandBuffers(NumCommandBuffers);
+	for (uint32_t Index = 0u; Index < NumCommandBuffers; ++Index)
+	{
+		NativeCommandBuffers[Index] = static_cast<const VulkanCommandBuffer*>(CommandBuffers[Index])->GetNative();
+	}
+
+	GetNative().executeCommands(NumCommandBuffers, NativeCommandBuffers.data());
+}
+
 //void VulkanCommandBuffer::ExecuteSecondaryCommands(const std::vector<std::shared_ptr<VulkanCommandBuffer>>& Commands)
 //{
 //	/*********************************************************************************************************************
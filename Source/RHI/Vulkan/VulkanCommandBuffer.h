@@ -56,6 +56,8 @@ public:
 	void WriteTexture(const RHITexture* Texture, const RHIBuffer* StagingBuffer, size_t Size, uint32_t ArrayLayer, uint32_t MipLevel, size_t SrcOffset) override final;
 	void WriteTexture(const RHITexture* Texture, const RHIBuffer* StagingBuffer, size_t Size, size_t SrcOffset) override final;
 
+	void Transition(const RHITransition* Transitions, uint32_t NumTransitions) override final;
+
 	void SetViewport(const RHIViewport& Viewport) override final;
 	void SetViewports(const RHIViewport* Viewports, uint32_t NumViewports) override final;
 
@@ -65,13 +67,20 @@ public:
 	const VulkanFence& GetFence() { return m_Fence; }
 	const std::vector<VulkanSemaphore*> GetWaitSemaphores() const { return m_WaitSemaphores; }
 	const std::vector<vk::PipelineStageFlags>& GetWaitDstStageFlags() const { return m_WaitDstStageFlags; }
+	const std::vector<uint64_t>& GetWaitValues() const { return m_WaitValues; }
+
+	/// The commands wait for Semaphore before the stages of StageFlags execute, for Value if it is a timeline semaphore. Until Reset.
+	void AddWaitSemaphore(VulkanSemaphore* Semaphore, vk::PipelineStageFlags StageFlags, uint64_t Value = 0u);
 protected:
 	friend class VulkanCommandListContext;
 
 	void RefreshStatus() override final;
+
+	void ExecuteSecondaryCommands(RHICommandBuffer* const* CommandBuffers, uint32_t NumCommandBuffers) override final;
 private:
 	class VulkanCommandPool& m_Pool;
 	VulkanFence m_Fence;
 	std::vector<VulkanSemaphore*> m_WaitSemaphores;
 	std::vector<vk::PipelineStageFlags> m_WaitDstStageFlags;
+	std::vector<uint64_t> m_WaitValues;
 };
\ No newline at end of file
@@ -7,6 +7,7 @@ VulkanCommandListContext::VulkanCommandListContext(const VulkanDevice& Device, V
 	, m_DescriptorPool(new VulkanDescriptorPool(Device))
 	, m_Queue(Queue)
 	, m_Device(Device)
+	, m_Timeline(Device)
 {
 	GetGraphicsCommandBuffer();
 }
@@ -49,6 +50,43 @@ void VulkanCommandListContext::SubmitUploadCommandBuffer(RHICommandBuffer* Uploa
 	//}
 }
 
+void VulkanCommandListContext::SubmitGraphics(uint64_t SignalValue)
+{
+	auto CommandBuffer = static_cast<VulkanCommandBuffer*>(GetGraphicsCommandBuffer());
+	CommandBuffer->End();
+
+	m_Queue.Submit(CommandBuffer, SignalValue ? 1u : 0u, SignalValue ? &m_Timeline : nullptr, SignalValue ? &SignalValue : nullptr);
+	CommandBuffer->SetStatus(RHICommandBuffer::EStatus::Submitted);
+
+	std::lock_guard Locker(m_PrimaryCommandBufferList.Lock);
+	m_PrimaryCommandBufferList.Graphics = nullptr;
+}
+
+void VulkanCommandListContext::SignalTimeline(uint64_t Value)
+{
+	assert(Value > m_TimelineValue.load(std::memory_order_relaxed));
+
+	SubmitGraphics(Value);
+	m_TimelineValue.store(Value, std::memory_order_release);
+}
+
+void VulkanCommandListContext::WaitTimeline(RHICommandListContext& Other, uint64_t Value)
+{
+	auto& OtherTimeline = static_cast<VulkanCommandListContext&>(Other).m_Timeline;
+
+	if (m_PrimaryCommandBufferList.Graphics)
+	{
+		SubmitGraphics(0u);
+	}
+
+	static_cast<VulkanCommandBuffer*>(GetGraphicsCommandBuffer())->AddWaitSemaphore(&OtherTimeline, vk::PipelineStageFlagBits::eAllCommands, Value);
+}
+
+RHICommandBufferPoolPtr VulkanCommandListContext::CreateCommandBufferPool()
+{
+	return std::make_shared<VulkanCommandBufferPool>(m_Device, m_Queue.GetFamilyIndex());
+}
+
 VulkanDescriptorPool& VulkanCommandListContext::AcquireDescriptorPool()
 {
 	if (m_DescriptorPool->IsFull())
@@ -12,16 +12,29 @@ public:
 	void SubmitGraphicsCommandBuffer() override final;
 	void SubmitUploadCommandBuffer(RHICommandBuffer* UploadCommandBuffer) override final;
 
+	uint64_t GetTimelineValue() const override final { return m_TimelineValue.load(std::memory_order_acquire); }
+	void SignalTimeline(uint64_t Value) override final;
+	void WaitTimeline(RHICommandListContext& Other, uint64_t Value) override final;
+
 	VulkanDescriptorPool& AcquireDescriptorPool();
 protected:
 	RHICommandBufferPtr AllocateCommandBuffer(ERHICommandBufferLevel Level) override final
 	{
 		return m_Pool.AllocateCommandBuffer(Level);
 	}
+
+	RHICommandBufferPoolPtr CreateCommandBufferPool() override final;
 private:
+	/// The next graphics command buffer starts from scratch.
+	void SubmitGraphics(uint64_t SignalValue);
+
 	VulkanCommandPool m_Pool;
 	std::vector<std::unique_ptr<VulkanDescriptorPool>> m_FulledDescriptorPools;
 	std::unique_ptr<VulkanDescriptorPool> m_DescriptorPool;
 	class VulkanQueue& m_Queue;
 	const class VulkanDevice& m_Device;
+
+	/// A timeline semaphore when the device supports them.
+	VulkanSemaphore m_Timeline;
+	std::atomic<uint64_t> m_TimelineValue = 0u;
 };
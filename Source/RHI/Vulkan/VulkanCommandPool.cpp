@@ -21,9 +21,10 @@ VulkanCommandPool::VulkanCommandPool(const VulkanDevice& Device, uint32_t QueueF
 			If the protected memory feature is not enabled, the VK_COMMAND_POOL_CREATE_PROTECTED_BIT bit of flags must not be set.
 	**************************/
 
+	/// Command buffers are reset one by one once their submission completed, see VulkanCommandBuffer::Reset.
 	vk::CommandPoolCreateInfo CreateInfo;
 	CreateInfo.setQueueFamilyIndex(QueueFamilyIndex)
-		.setFlags(vk::CommandPoolCreateFlags());
+		.setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer);
 
 	VERIFY_VK(GetNativeDevice().createCommandPool(&CreateInfo, VK_ALLOCATION_CALLBACKS, &m_Native));
 }
@@ -16,3 +16,20 @@ public:
 
 	void Free(std::shared_ptr<VulkanCommandBuffer>& CommandBuffer);
 };
+
+/// Per thread pool of RHICommandListContext, command buffers of a vk::CommandPool must only be recorded on one thread at a time.
+class VulkanCommandBufferPool final : public RHICommandBufferPool
+{
+public:
+	VulkanCommandBufferPool(const class VulkanDevice& Device, uint32_t QueueFamilyIndex)
+		: m_Pool(Device, QueueFamilyIndex)
+	{
+	}
+protected:
+	RHICommandBufferPtr AllocateCommandBuffer(ERHICommandBufferLevel Level) override final
+	{
+		return m_Pool.AllocateCommandBuffer(Level);
+	}
+private:
+	VulkanCommandPool m_Pool;
+};
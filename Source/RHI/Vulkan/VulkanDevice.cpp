@@ -366,6 +366,10 @@ void VulkanDevice::SetupCapabilities()
 	m_Capabilities.MaxResourcesPerStage = m_PhysicalDeviceLimits.maxPerStageResources;
 	m_Capabilities.MaxDescriptorSets = m_PhysicalDeviceLimits.maxBoundDescriptorSets;
 	m_Capabilities.MaxSamplerAnisotropy = m_PhysicalDeviceLimits.maxSamplerAnisotropy;
+	m_Capabilities.SupportsTimelineSemaphore = GetExtensionSettings().TimelineSemaphore;
+
+	/// Split barriers would take events, which cost more than they save for the few passes in between.
+	m_Capabilities.SupportsSplitBarriers = false;
 }
 
 void VulkanDevice::WaitIdle() const
@@ -183,6 +183,7 @@ NAMESPACE_END(RHI)
 #include "RHI/Vulkan/VulkanQueue.h"
 #include "RHI/Vulkan/VulkanCommandBuffer.h"
 #include "RHI/Vulkan/VulkanDevice.h"
+#include "RHI/Vulkan/VulkanLayerExtensions.h"
 
 VulkanQueue::VulkanQueue(const VulkanDevice& Device, ERHIDeviceQueue QueueType, uint32_t FamilyIndex)
 	: VkDeviceResource(Device)
@@ -192,7 +193,7 @@ VulkanQueue::VulkanQueue(const VulkanDevice& Device, ERHIDeviceQueue QueueType,
 	GetNativeDevice().getQueue(FamilyIndex, 0u, &m_Native);
 }
 
-void VulkanQueue::Submit(VulkanCommandBuffer* CommandBuffer, uint32_t NumSignalSemaphores, VulkanSemaphore* SignalSemaphores) const
+void VulkanQueue::Submit(VulkanCommandBuffer* CommandBuffer, uint32_t NumSignalSemaphores, VulkanSemaphore* SignalSemaphores, const uint64_t* SignalValues) const
 {
 	assert(CommandBuffer);
 	assert((NumSignalSemaphores == 0u && !SignalSemaphores) || (NumSignalSemaphores > 0u && SignalSemaphores));
@@ -217,6 +218,20 @@ void VulkanQueue::Submit(VulkanCommandBuffer* CommandBuffer, uint32_t NumSignalS
 		.setWaitSemaphores(WaitSemaphores)
 		.setWaitDstStageMask(CommandBuffer->GetWaitDstStageFlags());
 
+	std::vector<uint64_t> Values(NumSignalSemaphores, 0u);
+	if (SignalValues)
+	{
+		std::copy(SignalValues, SignalValues + NumSignalSemaphores, Values.begin());
+	}
+
+	vk::TimelineSemaphoreSubmitInfo TimelineSemaphoreSubmitInfo;
+	if (GetDevice().GetExtensionSettings().TimelineSemaphore)
+	{
+		TimelineSemaphoreSubmitInfo.setWaitSemaphoreValues(CommandBuffer->GetWaitValues())
+			.setSignalSemaphoreValues(Values);
+		SetPNext(SubmitInfo, TimelineSemaphoreSubmitInfo);
+	}
+
 	VERIFY_VK(GetNative().submit(1u, &SubmitInfo, CommandBuffer->GetFence().GetNative()));
 }
 
@@ -12,7 +12,8 @@ public:
 	const uint32_t GetFamilyIndex() const { return m_FamilyIndex; }
 	const ERHIDeviceQueue GetType() const { return m_Type; }
 
-	void Submit(class VulkanCommandBuffer* CommandBuffer, uint32_t NumSignalSemaphores, class VulkanSemaphore* SignalSemaphores) const;
+	/// SignalValues, one per signal semaphore, are signaled on timeline semaphores and ignored for binary ones.
+	void Submit(class VulkanCommandBuffer* CommandBuffer, uint32_t NumSignalSemaphores, class VulkanSemaphore* SignalSemaphores, const uint64_t* SignalValues = nullptr) const;
 
 	void WaitIdle() const;
 protected:
@@ -97,7 +97,14 @@ VulkanTexture::VulkanTexture(const VulkanDevice& Device, const RHITextureDesc& D
 
 		if (Desc.BulkData && Desc.BulkData->IsValid())
 		{
-			RHIUploadManager::Get().QueueUploadTexture(this, Desc.BulkData->GetRawData(), Desc.BulkData->GetSize(), Desc.BulkData->GetOffset());
+			if (Desc.SubresourceOffsets.empty())
+			{
+				RHIUploadManager::Get().QueueUploadTexture(this, Desc.BulkData->GetRawData(), Desc.BulkData->GetSize(), Desc.BulkData->GetOffset());
+			}
+			else
+			{
+				RHIUploadManager::Get().QueueUploadTexture(this, Desc.BulkData->GetRawData(), Desc.SubresourceOffsets);
+			}
 		}
 	}
 
@@ -3,15 +3,21 @@
 #include "Application/Window.h"
 #include "RHI/Vulkan/VulkanDevice.h"
 #include "RHI/RHISwapchain.h"
+#include "RHI/RHICommandListContext.h"
 #include "Services/AssetDatabase.h"
 #include "Services/ShaderLibrary.h"
 #include "Profile/CpuTimer.h"
 #include "Profile/Stats.h"
 #include "OS/OS.h"
 #include "Async/Task.h"
+#include "Async/AsyncIO.h"
+#include "Asset/VirtualFileSystem.h"
+#include "Asset/DerivedDataCache.h"
 #include "Scene/Scene.h"
 #include "Rendering/RenderGraph/RenderGraph.h"
+#include "Rendering/RenderGraph/RenderTargetPool.h"
 #include "Rendering/SceneRenders/SceneRenderer.h"
+#include "Rendering/TextureStreamingManager.h"
 
 BaseApplication* GApplication = nullptr;
 RHIDevice* GRenderDevice = nullptr;
@@ -49,6 +55,8 @@ bool BaseApplication::InitializeRHI()
 
 	GRenderDevice = m_RenderDevice.get();
 
+	RDGRenderTargetPool::Create(*m_RenderDevice);
+
 	return true;
 }
 
@@ -193,12 +201,34 @@ void BaseApplication::RenderScene(const Scene& InScene)
 {
 	if (InScene.IsReady())
 	{
-		RDGRenderGraph RenderGraph(m_Settings->GetRenderSettings());
+		if (!m_RenderGraph)
+		{
+			m_RenderGraph = std::make_unique<RDGRenderGraph>(m_Settings->GetRenderSettings(), RDGRenderTargetPool::Get());
+			m_SceneRenderer = SceneRenderer::Create(m_Settings->GetRenderSettings());
+		}
+
+		auto& RenderGraph = *m_RenderGraph;
 		RDGSceneViewInfo SceneViewInfo(RenderGraph, *m_ViewportClient, InScene);
 
-		std::unique_ptr<SceneRenderer> Renderer = SceneRenderer::Create(m_Settings->GetRenderSettings());
+		std::vector<TextureStreamingView> StreamingViews;
+		for (const auto& View : SceneViewInfo.Views)
+		{
+			if (View && View->GetCamera())
+			{
+				StreamingViews.emplace_back(TextureStreamingView::Create(*View->GetCamera(), static_cast<float>(SceneViewInfo.FinalViewSize.y)));
+			}
+		}
+		TextureStreamingManager::Get().Update(InScene, StreamingViews);
+
+		m_SceneRenderer->Render(RenderGraph, SceneViewInfo);
+
+		RenderGraph.Execute(*GetRenderDevice().GetImmediateCommandListContext(ERHIDeviceQueue::Graphics),
+			GetRenderDevice().GetImmediateCommandListContext(ERHIDeviceQueue::Compute));
+
+		/// The passes capture this frame's views, they must not outlive it.
+		RenderGraph.Reset();
 
-		Renderer->Render(RenderGraph, SceneViewInfo);
+		RDGRenderTargetPool::Get().Tick();
 	}
 }
 
@@ -214,6 +244,9 @@ void BaseApplication::Run()
 	LOG_INFO(LogDefault, "Mount working directory to \"{}\".", OS::GetWorkingDirectory().string());
 
 	TFTask::Initialize();
+	AsyncIO::Get().Initialize();
+	VirtualFileSystem::Get().Initialize();
+	DerivedDataCache::Get().Initialize();
 	AssetDatabase::Get().Initialize();
 	Stats::Get().Initialize();
 	ShaderLibrary::Get().Initialize();
@@ -254,8 +287,12 @@ void BaseApplication::Run()
 
 	Finalize();
 
+	TextureStreamingManager::Get().Finalize();
 	ShaderLibrary::Get().Finalize();
 	AssetDatabase::Get().Finalize();
+	DerivedDataCache::Get().Finalize();
+	VirtualFileSystem::Get().Finalize();
+	AsyncIO::Get().Finalize();
 	TFTask::Finalize();
 	Stats::Get().Finalize();
 
@@ -266,6 +303,9 @@ void BaseApplication::FinalizeRHI()
 {
 	//ShaderLibrary::Destroy();
 	//RHIUploadManager::Destroy();
+	m_SceneRenderer.reset();
+	m_RenderGraph.reset();
+	RDGRenderTargetPool::Destroy();
 
 	m_RenderDevice.reset();
 }
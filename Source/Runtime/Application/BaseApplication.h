@@ -66,6 +66,10 @@ protected:
 	std::unique_ptr<class RHIDevice> m_RenderDevice;
 	std::unique_ptr<class RHIViewportClient> m_ViewportClient;
 
+	/// Kept across frames, so frames of the same shape reuse the compiled graph.
+	std::unique_ptr<class RDGRenderGraph> m_RenderGraph;
+	std::unique_ptr<class SceneRenderer> m_SceneRenderer;
+
 	KeyModifiers m_KeyModifiers;
 	std::vector<class MessageHandler*> m_MessageHandlers;
 
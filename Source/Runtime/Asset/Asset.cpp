@@ -1,19 +1,46 @@
 #include "Asset/Asset.h"
 #include "Services/AssetDatabase.h"
+#include "Asset/VirtualFileSystem.h"
+#include "Async/AsyncIO.h"
 
 DEFINE_LOG_CATEGORY(LogAsset);
 
 std::shared_ptr<DataBlock> Asset::LoadData(bool IsBinary) const
 {
-	if (!std::filesystem::exists(GetPath()))
+	/// Text mode translates line endings, the raw reads of AsyncIO and pack archives do not.
+	if (!IsBinary && VirtualFileSystem::Get().IsLooseFile(GetPath()))
 	{
-		return nullptr;
+		if (!std::filesystem::exists(GetPath()))
+		{
+			return nullptr;
+		}
+
+		auto Block = std::make_shared<DataBlock>(std::filesystem::file_size(GetPath()));
+		std::ifstream FileStream(GetPath(), std::ios::in);
+		FileStream.read(reinterpret_cast<char*>(Block->Data.get()), Block->Size);
+		FileStream.close();
+
+		/// Text mode may read less than the file size, the hash has to match File::ComputeContentHash of the file.
+		SetContentHash(ComputeContentHash(GetPath()));
+
+		return Block;
+	}
+
+	std::shared_ptr<DataBlock> Block;
+	if (auto Read = std::move(m_PendingRead))
+	{
+		Block = Read->Wait() ? Read->TakeData() : nullptr;
+	}
+	else
+	{
+		Block = VirtualFileSystem::Get().ReadFile(GetPath());
 	}
 
-	auto Block = std::make_shared<DataBlock>(std::filesystem::file_size(GetPath()));
-	std::ifstream FileStream(GetPath(), IsBinary ? std::ios::in | std::ios::binary : std::ios::in);
-	FileStream.read(reinterpret_cast<char*>(Block->Data.get()), Block->Size);
-	FileStream.close();
+	/// The baseline IsDirty compares with.
+	if (Block)
+	{
+		SetContentHash(XXHash64(Block->GetRawData(), Block->GetSize()));
+	}
 
 	return Block;
 }
@@ -33,7 +60,24 @@ void AssetLoadRequest::SetAssetStatus(Asset::EStatus Status)
 	assert(Target);
 
 	Target->SetStatus(Status);
+	InvokeAssetStatusCallback(Status);
+}
+
+bool AssetLoadRequest::TransitionAssetStatus(Asset::EStatus Expected, Asset::EStatus Desired)
+{
+	assert(Target);
+
+	if (!Target->CompareExchangeStatus(Expected, Desired))
+	{
+		return false;
+	}
 
+	InvokeAssetStatusCallback(Desired);
+	return true;
+}
+
+void AssetLoadRequest::InvokeAssetStatusCallback(Asset::EStatus Status)
+{
 	switch (Status)
 	{
 	case Asset::EStatus::Loading:
@@ -1,66 +1,9 @@
 #pragma once
 
 #include "Asset/File.h"
+#include "Asset/DataBlock.h"
 #include "Services/SpdlogService.h"
 
-struct DataBlock
-{
-	size_t Size = 0u;
-	size_t Offset = 0u;
-	std::shared_ptr<std::byte> Data;
-
-	DataBlock() = default;
-
-	DataBlock(size_t InSize, const void* InData = nullptr, size_t InOffset = 0u)
-		: Size(InSize)
-		, Offset(InOffset)
-		, Data(new std::byte[InSize + InOffset]())
-	{
-		assert(Offset < Size);
-
-		if (InData)
-		{
-			VERIFY(memcpy_s(Data.get() + Offset, InSize, InData, InSize) == 0);
-		}
-	}
-	
-	inline bool IsValid() const { return Size && Data; }
-
-	inline void Reset()
-	{
-		Size = Offset = 0u;
-		Data.reset();
-	}
-
-	inline size_t GetSize() const { return Size; }
-	inline size_t GetOffset() const { return Offset; }
-	inline std::byte* GetRawData() const { return Data.get(); }
-
-	template<class Archive>
-	void load(Archive& Ar)
-	{
-		Ar(
-			CEREAL_NVP(Size),
-			CEREAL_NVP(Offset)
-		);
-
-		Data.reset(new std::byte[Size]());
-
-		Ar.loadBinaryValue(Data.get() + Offset, Size, "Data");
-	}
-
-	template<class Archive>
-	void save(Archive& Ar) const
-	{
-		Ar(
-			CEREAL_NVP(Size),
-			CEREAL_NVP(Offset)
-		);
-
-		Ar.saveBinaryValue(Data.get() + Offset, Size, "Data");
-	}
-};
-
 class Asset : public File
 {
 public:
@@ -78,7 +21,13 @@ public:
 
 	inline bool IsReady(std::memory_order Order = std::memory_order_relaxed) const { return GetStatus(Order) == EStatus::Ready; }
 	inline bool IsLoading() const { return GetStatus() == EStatus::Loading; }
+	inline bool IsCanceled(std::memory_order Order = std::memory_order_relaxed) const { return GetStatus(Order) == EStatus::Canceled; }
 
+	/// Bytes this asset keeps resident in CPU memory, the asset database charges it against the memory budget once loaded.
+	virtual size_t GetMemorySize() const { return 0u; }
+
+	/// Reads through the virtual file system, loose files with AsyncIO. If the asset database already started the read when it scheduled
+	/// the load this only waits for it.
 	std::shared_ptr<DataBlock> LoadData(bool IsBinary = true) const;
 
 	template<class Archive>
@@ -90,14 +39,26 @@ public:
 	}
 protected:
 	friend class AssetLoader;
+	friend class AssetDatabase;
 	friend struct AssetLoadRequest;
 
 	inline EStatus GetStatus(std::memory_order Order = std::memory_order_relaxed) const { return m_Status.load(Order); }
 	inline void SetStatus(EStatus Status) { m_Status.store(Status, std::memory_order_release); }
 
+	/// Only moves on if nobody changed the status in between, e.g. a concurrent CancelLoad. Expected receives the current status on failure.
+	inline bool CompareExchangeStatus(EStatus& Expected, EStatus Desired) { return m_Status.compare_exchange_strong(Expected, Desired, std::memory_order_acq_rel, std::memory_order_acquire); }
+
 	std::atomic<EStatus> m_Status{ EStatus::None };
+
+	/// Set before the load task is dispatched, taken by LoadData on the loading thread.
+	mutable std::shared_ptr<class AsyncReadHandle> m_PendingRead;
 };
 
+/// Strong handles keep an asset resident, the asset database only evicts assets nobody else holds a strong handle to.
+/// Weak handles observe an asset without pinning it.
+using AssetHandle = std::shared_ptr<Asset>;
+using WeakAssetHandle = std::weak_ptr<Asset>;
+
 struct AssetLoadRequest
 {
 	using AssetLoadCallback = std::function<void(Asset&)>;
@@ -107,11 +68,16 @@ struct AssetLoadRequest
 	bool Async = true;
 	std::shared_ptr<Asset> Target;
 
+	/// Loader specific import settings, e.g. the ETextureUsage of a texture. The loader applies them when it creates the asset, before any
+	/// load path runs. Unset takes the settings the path was last requested with, a cached asset loaded with other settings is reloaded.
+	std::optional<uint32_t> Settings;
+
 	AssetLoadCallback OnLoading;
 	AssetLoadCallback OnLoaded;
 	AssetLoadCallback OnLoadFailed;
 	AssetLoadCallback OnCanceled;
 	AssetLoadCallback OnUnload;
+	AssetLoadCallback OnReloaded;
 
 	bool Cancel();
 	bool Unload();
@@ -127,6 +93,11 @@ protected:
 	}
 
 	void SetAssetStatus(Asset::EStatus Status);
+
+	/// Compare exchange of the target's status, the callback of Desired is only invoked if the status changed.
+	bool TransitionAssetStatus(Asset::EStatus Expected, Asset::EStatus Desired);
+
+	void InvokeAssetStatusCallback(Asset::EStatus Status);
 };
 using AssetLoadRequests = std::vector<AssetLoadRequest>;
 
@@ -146,10 +117,13 @@ public:
 	}
 
 	virtual bool Load(Asset& Target) = 0;
+
+	/// Loaders which read the whole asset file through Asset::LoadData, the database starts the read as soon as it schedules the load.
+	virtual bool PrefetchData() const { return false; }
 protected:
 	friend class AssetDatabase;
 
-	virtual std::shared_ptr<Asset> CreateAsset(const std::filesystem::path& Path) = 0;
+	virtual std::shared_ptr<Asset> CreateAsset(const std::filesystem::path& Path, uint32_t Settings) = 0;
 private:
 	std::vector<std::string_view> m_SupportedFormats;
 };
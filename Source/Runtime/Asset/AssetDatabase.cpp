@@ -3,6 +3,14 @@
 #include "Asset/AssetLoaders/TextureLoader.h"
 #include "Asset/AssetLoaders/AssimpSceneLoader.h"
 #include "Async/Task.h"
+#include "Async/AsyncIO.h"
+#include "Asset/VirtualFileSystem.h"
+#include "Core/ConsoleVariable.h"
+
+ConsoleVariable<uint32_t> CVarAssetMemoryBudget(
+	"asset.memory_budget",
+	"Budget of resident asset memory in megabytes, unreferenced assets are evicted in least recently used order beyond it.",
+	1024u);
 
 void AssetDatabase::Initialize()
 {
@@ -15,6 +23,11 @@ void AssetDatabase::CreateAssetLoaders()
 	m_AssetLoaders.emplace_back(std::make_unique<AssimpSceneLoader>());
 }
 
+void AssetDatabase::RegisterAssetLoader(std::unique_ptr<AssetLoader>&& Loader)
+{
+	m_AssetLoaders.emplace_back(std::move(Loader));
+}
+
 AssetLoader* AssetDatabase::FindAssetLoader(const std::string& Extension)
 {
 	for (auto& Loader : m_AssetLoaders)
@@ -36,87 +49,386 @@ void AssetDatabase::RequestLoad(AssetLoadRequests& Requests)
 	}
 }
 
-void AssetDatabase::LoadAssetFunc(AssetLoader& Loader, AssetLoadRequest& Request)
+void AssetDatabase::LoadAssetFunc(AssetLoader& Loader, AssetLoadRequest& Request, const std::filesystem::path& Path)
 {
-	Request.SetAssetStatus(Asset::EStatus::Loading);
+	/// CancelLoad may run at any point, every step below only moves the status on if it was not canceled in between.
+	if (!Request.TransitionAssetStatus(Asset::EStatus::None, Asset::EStatus::Loading))
+	{
+		/// Canceled before a worker picked it up.
+		Request.Target->m_PendingRead.reset();
+		Request.InvokeAssetStatusCallback(Asset::EStatus::Canceled);
+		return;
+	}
+
+	const bool Loaded = Loader.Load(*Request.Target);
+
+	/// Loaders that bail out before reading leave the prefetched data behind.
+	Request.Target->m_PendingRead.reset();
 
-	if (Loader.Load(*Request.Target))
+	if (!Request.TransitionAssetStatus(Asset::EStatus::Loading, Loaded ? Asset::EStatus::Ready : Asset::EStatus::LoadFailed))
 	{
-		Request.SetAssetStatus(Asset::EStatus::Ready);
+		Request.InvokeAssetStatusCallback(Asset::EStatus::Canceled);
+		return;
 	}
-	else
+
+	if (Loaded)
 	{
-		Request.SetAssetStatus(Asset::EStatus::LoadFailed);
+		OnAssetLoaded(Path, Request.Target);
 	}
 }
 
 void AssetDatabase::ProcessAssetLoadRequest(AssetLoadRequest& Request)
 {
 	std::filesystem::path UnifiedPath = GetUnifiedAssetPath(Request.Path);
-	if (!std::filesystem::exists(UnifiedPath))
+	if (!VirtualFileSystem::Get().Exists(UnifiedPath))
 	{
 		LOG_ERROR(LogAsset, "The target asset \"{}\" is not exists.", Request.Path);
 		return;
 	}
 
 	std::string Extension = UnifiedPath.extension().string();
-	if (auto Loader = FindAssetLoader(Extension))
+	auto Loader = FindAssetLoader(Extension);
+	if (!Loader)
+	{
+		LOG_ERROR(LogAsset, "The target asset \"{}\" is not supported yet.", Request.Path);
+		return;
+	}
+
+	ScheduleContext Context;
+	if (Request.ForceReload)
+	{
+		Context.ForceReload.insert(UnifiedPath);
+	}
+
+	std::shared_ptr<TFTask> SyncTask;
+
 	{
-		bool NeedRestartTask = false;
 		std::lock_guard Locker(m_Lock);
-		auto It = m_AssetLoadTasks.find(UnifiedPath);
-		if (It == m_AssetLoadTasks.end())
+
+		LoadTaskList WaitFor;
+		ScheduleLoad(UnifiedPath, Request, Context, WaitFor);
+
+		auto& LoadTask = m_AssetLoadTasks.at(UnifiedPath);
+		Request.Target = LoadTask.GetTarget();
+
+		for (auto& Task : Context.NewTasks)
 		{
-			Request.Target = Loader->CreateAsset(UnifiedPath);
+			Task->Trigger();
+		}
 
-			auto Task = std::make_shared<TFTask>(String::Format("LoadAsset:%s", UnifiedPath.filename().string().c_str()),
-				[Loader, &Request, this]()
-				{
-					LoadAssetFunc(*Loader, Request);
-				});
+		/// Synchronous loads run as a task like any other, so others requesting the asset meanwhile see the load in flight and wait for
+		/// it instead of starting their own. Only the request which started the load waits on it, a task is waited for once.
+		const bool Scheduled = !Context.NewTasks.empty() && Context.NewTasks.back() == LoadTask.Task;
+		if (!Request.Async && Scheduled)
+		{
+			SyncTask = LoadTask.Task;
+		}
+	}
+
+	if (SyncTask)
+	{
+		SyncTask->Wait();
+	}
+}
+
+void AssetDatabase::ScheduleLoad(const std::filesystem::path& Path, const AssetLoadRequest& Request, ScheduleContext& Context, LoadTaskList& OutWaitFor)
+{
+	if (auto It = Context.Scheduled.find(Path); It != Context.Scheduled.end())
+	{
+		OutWaitFor.insert(OutWaitFor.end(), It->second.begin(), It->second.end());
+		return;
+	}
+
+	/// Node based map, the reference survives the insertions of the recursion below.
+	auto& WaitFor = Context.Scheduled[Path];
+
+	LoadTaskList Prerequisites;
+	for (const auto& Dependency : GetDependenciesLocked(Path))
+	{
+		AssetLoadRequest DependencyRequest;
+		DependencyRequest.Path = Dependency.string();
+		ScheduleLoad(Dependency, DependencyRequest, Context, Prerequisites);
+	}
+
+	auto Loader = FindAssetLoader(Path.extension().string());
+	if (!Loader || !VirtualFileSystem::Get().Exists(Path))
+	{
+		/// Nothing the database can load (e.g. serializable assets loaded by their owners), dependents wait on what this one depends on.
+		WaitFor = std::move(Prerequisites);
+		OutWaitFor.insert(OutWaitFor.end(), WaitFor.begin(), WaitFor.end());
+		return;
+	}
+
+	AssetLoadRequest LoadRequest = Request;
+
+	/// Dependency loads and reloads come without settings, they keep the ones the asset was requested with.
+	if (!LoadRequest.Settings)
+	{
+		if (auto SettingsIt = m_AssetSettings.find(Path); SettingsIt != m_AssetSettings.end())
+		{
+			LoadRequest.Settings = SettingsIt->second;
+		}
+	}
 
-			It = m_AssetLoadTasks.emplace(std::move(UnifiedPath), AssetLoadTask{ std::move(Task), Request.Target }).first;
+	auto It = m_AssetLoadTasks.find(Path);
+	if (It != m_AssetLoadTasks.end())
+	{
+		auto& LoadTask = It->second;
+		const auto Status = LoadTask.GetTarget()->GetStatus(std::memory_order_acquire);
+		const bool Reloadable = Status == Asset::EStatus::Canceled || Status == Asset::EStatus::LoadFailed;
+
+		/// Compared with the settings the cached asset was created with, not the ones last asked for.
+		const bool SettingsChanged = LoadRequest.Settings && *LoadRequest.Settings != LoadTask.Request->Settings.value_or(0u);
+		const bool Forced = Context.ForceReload.find(Path) != Context.ForceReload.end() || SettingsChanged;
+
+		if (SettingsChanged)
+		{
+			LOG_WARNING(LogAsset, "Asset \"{}\" is requested with other settings than it was loaded with, it {}.",
+				Path.string(), IsLoadTaskBusy(LoadTask) ? "keeps the settings of the load in flight" : "is reloaded");
 		}
-		else
+
+		if (IsLoadTaskBusy(LoadTask) || (!Forced && !Reloadable))
 		{
-			if (Request.ForceReload)
+			if (LoadTask.Resident)
 			{
-				It->second.Target = Loader->CreateAsset(UnifiedPath);
-				NeedRestartTask = true;
+				m_LRUList.splice(m_LRUList.begin(), m_LRUList, LoadTask.LRUNode);
 			}
-			else
+
+			/// A load in flight can not be restarted, dependents wait for it instead.
+			if (IsLoadTaskBusy(LoadTask))
 			{
-				Request.Target = It->second.Target;
-				return;
+				WaitFor.push_back(LoadTask.Task);
 			}
+
+			OutWaitFor.insert(OutWaitFor.end(), WaitFor.begin(), WaitFor.end());
+			return;
 		}
 
-		if (Request.Async)
+		if (Context.Invalidation)
 		{
-			NeedRestartTask ? It->second.Task->Restart() : It->second.Task->Trigger();
+			/// Keep the callbacks of whoever loaded it, but report the reload through OnReloaded.
+			LoadRequest = *LoadTask.Request;
+			LoadRequest.OnLoaded = LoadRequest.OnReloaded;
 		}
-		else
+
+		ReleaseResident(LoadTask);
+	}
+
+	/// Only a load that actually starts decides the settings, a request joining the load in flight leaves them alone.
+	if (LoadRequest.Settings)
+	{
+		m_AssetSettings[Path] = *LoadRequest.Settings;
+	}
+
+	auto NewRequest = std::make_shared<AssetLoadRequest>(std::move(LoadRequest));
+	NewRequest->Target = Loader->CreateAsset(Path, NewRequest->Settings.value_or(0u));
+
+	/// The read runs while the task waits for its prerequisites and a worker, by the time the loader asks for the data it is mostly there.
+	std::shared_ptr<AsyncReadHandle> Read;
+	/// Packed files decompress on the workers once the loader asks for them.
+	if (Loader->PrefetchData() && VirtualFileSystem::Get().IsLooseFile(Path))
+	{
+		Read = AsyncIO::Get().ReadFile(Path, NewRequest->Async ? TFTask::EPriority::Normal : TFTask::EPriority::High);
+		NewRequest->Target->m_PendingRead = Read;
+	}
+
+	/// A fresh task per load, so no task ever keeps pointers to prerequisites of an earlier load.
+	auto Task = std::make_shared<TFTask>(String::Format("LoadAsset:%s", Path.filename().string().c_str()),
+		[Loader, NewRequest, Path, this]()
 		{
-			LoadAssetFunc(*Loader, Request);
+			LoadAssetFunc(*Loader, *NewRequest, Path);
+		},
+		TFTask::EThread::WorkerThread,
+		NewRequest->Async ? TFTask::EPriority::Normal : TFTask::EPriority::High);
+
+	for (auto& Prerequisite : Prerequisites)
+	{
+		Task->AddPrerequisite(*Prerequisite);
+	}
+
+	auto& LoadTask = m_AssetLoadTasks[Path];
+	LoadTask.Task = Task;
+	LoadTask.Request = std::move(NewRequest);
+	LoadTask.Read = std::move(Read);
+
+	Context.NewTasks.push_back(Task);
+	WaitFor.push_back(Task);
+	OutWaitFor.push_back(std::move(Task));
+}
+
+void AssetDatabase::OnAssetLoaded(const std::filesystem::path& Path, const AssetHandle& Target)
+{
+	std::lock_guard Locker(m_Lock);
+
+	auto It = m_AssetLoadTasks.find(Path);
+	if (It == m_AssetLoadTasks.end() || It->second.GetTarget() != Target)
+	{
+		/// Unloaded or replaced by a forced reload while loading.
+		return;
+	}
+
+	It->second.Read.reset();
+
+	ReleaseResident(It->second);
+	MakeResident(Path, It->second);
+
+	EvictUnreferencedAssetsLocked(static_cast<size_t>(CVarAssetMemoryBudget.Get()) * Megabyte);
+}
+
+void AssetDatabase::MakeResident(const std::filesystem::path& Path, AssetLoadTask& LoadTask)
+{
+	assert(!LoadTask.Resident);
+
+	LoadTask.MemorySize = LoadTask.GetTarget()->GetMemorySize();
+	LoadTask.Resident = true;
+
+	m_LRUList.push_front(Path);
+	LoadTask.LRUNode = m_LRUList.begin();
+
+	auto& Stats = m_MemoryStats[std::type_index(typeid(*LoadTask.GetTarget()))];
+	if (Stats.TypeName.empty())
+	{
+		Stats.TypeName = typeid(*LoadTask.GetTarget()).name();
+	}
+	Stats.ResidentBytes += LoadTask.MemorySize;
+	++Stats.NumResident;
+
+	m_ResidentBytes += LoadTask.MemorySize;
+}
+
+void AssetDatabase::ReleaseResident(AssetLoadTask& LoadTask)
+{
+	if (!LoadTask.Resident)
+	{
+		return;
+	}
+
+	auto& Stats = m_MemoryStats[std::type_index(typeid(*LoadTask.GetTarget()))];
+	assert(Stats.ResidentBytes >= LoadTask.MemorySize && Stats.NumResident > 0u);
+	Stats.ResidentBytes -= LoadTask.MemorySize;
+	--Stats.NumResident;
+
+	m_ResidentBytes -= LoadTask.MemorySize;
+	m_LRUList.erase(LoadTask.LRUNode);
+
+	LoadTask.MemorySize = 0u;
+	LoadTask.Resident = false;
+}
+
+bool AssetDatabase::IsLoadTaskBusy(const AssetLoadTask& LoadTask)
+{
+	return LoadTask.Task->IsDispatched() && !LoadTask.Task->IsCompleted();
+}
+
+void AssetDatabase::EvictUnreferencedAssets(size_t BudgetBytes)
+{
+	std::lock_guard Locker(m_Lock);
+	EvictUnreferencedAssetsLocked(BudgetBytes);
+}
+
+void AssetDatabase::RefreshMemorySizesLocked()
+{
+	for (auto& [Path, LoadTask] : m_AssetLoadTasks)
+	{
+		if (!LoadTask.Resident)
+		{
+			continue;
+		}
+
+		const size_t MemorySize = LoadTask.GetTarget()->GetMemorySize();
+		if (MemorySize != LoadTask.MemorySize)
+		{
+			auto& Stats = m_MemoryStats[std::type_index(typeid(*LoadTask.GetTarget()))];
+			Stats.ResidentBytes = Stats.ResidentBytes - LoadTask.MemorySize + MemorySize;
+			m_ResidentBytes = m_ResidentBytes - LoadTask.MemorySize + MemorySize;
+			LoadTask.MemorySize = MemorySize;
 		}
 	}
-	else
+}
+
+void AssetDatabase::EvictUnreferencedAssetsLocked(size_t BudgetBytes)
+{
+	RefreshMemorySizesLocked();
+
+	auto Node = m_LRUList.end();
+	while (m_ResidentBytes > BudgetBytes && Node != m_LRUList.begin())
 	{
-		LOG_ERROR(LogAsset, "The target asset \"{}\" is not supported yet.", Request.Path);
+		--Node;
+
+		auto It = m_AssetLoadTasks.find(*Node);
+		assert(It != m_AssetLoadTasks.end());
+
+		auto& LoadTask = It->second;
+
+		/// The cache itself holds one reference, anything above that is an outstanding strong handle.
+		if (LoadTask.GetTarget().use_count() > 1 || IsLoadTaskBusy(LoadTask))
+		{
+			continue;
+		}
+
+		LOG_DEBUG(LogAsset, "Evict asset \"{}\", {} bytes.", It->first.string(), LoadTask.MemorySize);
+
+		++Node;
+		ReleaseResident(LoadTask);
+		LoadTask.GetTarget()->SetStatus(Asset::EStatus::Unload);
+		m_AssetLoadTasks.erase(It);
 	}
 }
 
+AssetHandle AssetDatabase::FindAsset(const std::filesystem::path& Path)
+{
+	std::lock_guard Locker(m_Lock);
+
+	auto It = m_AssetLoadTasks.find(Path);
+	if (It == m_AssetLoadTasks.end())
+	{
+		return nullptr;
+	}
+
+	if (It->second.Resident)
+	{
+		m_LRUList.splice(m_LRUList.begin(), m_LRUList, It->second.LRUNode);
+	}
+
+	return It->second.GetTarget();
+}
+
+std::vector<AssetDatabase::AssetMemoryStats> AssetDatabase::GetMemoryStats() const
+{
+	std::lock_guard Locker(m_Lock);
+
+	std::vector<AssetMemoryStats> Stats;
+	Stats.reserve(m_MemoryStats.size());
+	for (const auto& [Type, TypeStats] : m_MemoryStats)
+	{
+		Stats.push_back(TypeStats);
+	}
+
+	return Stats;
+}
+
+size_t AssetDatabase::GetResidentBytes() const
+{
+	std::lock_guard Locker(m_Lock);
+	return m_ResidentBytes;
+}
+
 bool AssetDatabase::Unload(const std::filesystem::path& Path)
 {
 	std::lock_guard Locker(m_Lock);
 
 	auto It = m_AssetLoadTasks.find(Path);
-	if (It != m_AssetLoadTasks.end())
+	if (It == m_AssetLoadTasks.end() || IsLoadTaskBusy(It->second))
 	{
-		return true;
+		return false;
 	}
 
-	return false;
+	/// Outstanding strong handles keep the asset alive, it is just no longer cached.
+	ReleaseResident(It->second);
+	It->second.GetTarget()->SetStatus(Asset::EStatus::Unload);
+	m_AssetLoadTasks.erase(It);
+
+	return true;
 }
 
 bool AssetDatabase::CancelLoad(const std::filesystem::path& Path)
@@ -124,12 +436,217 @@ bool AssetDatabase::CancelLoad(const std::filesystem::path& Path)
 	std::lock_guard Locker(m_Lock);
 
 	auto It = m_AssetLoadTasks.find(Path);
-	if (It != m_AssetLoadTasks.end())
+	if (It == m_AssetLoadTasks.end())
+	{
+		return false;
+	}
+
+	/// Loaders are not interruptible, a load in flight still runs to the end but its result is dropped.
+	/// The loading thread switches the status with a compare exchange as well, so exactly one of both wins.
+	auto& Target = *It->second.GetTarget();
+	auto Status = Target.GetStatus(std::memory_order_acquire);
+	do
+	{
+		if (Status != Asset::EStatus::None && Status != Asset::EStatus::Loading)
+		{
+			return false;
+		}
+	} while (!Target.CompareExchangeStatus(Status, Asset::EStatus::Canceled));
+
+	if (It->second.Read)
+	{
+		It->second.Read->Cancel();
+		It->second.Read.reset();
+	}
+	return true;
+}
+
+DirectedAcyclicGraph::NodeID AssetDatabase::FindOrAddDependencyNode(const std::filesystem::path& Path)
+{
+	auto It = m_DependencyNodes.find(Path);
+	if (It != m_DependencyNodes.end())
+	{
+		return It->second;
+	}
+
+	auto ID = m_DependencyGraph.AddNode();
+	m_DependencyNodes.emplace(Path, ID);
+	m_DependencyPaths.emplace(ID, Path);
+	return ID;
+}
+
+bool AssetDatabase::AddDependency(const std::filesystem::path& Dependent, const std::filesystem::path& Dependency)
+{
+	auto DependentPath = GetUnifiedAssetPath(Dependent);
+	auto DependencyPath = GetUnifiedAssetPath(Dependency);
+	if (DependentPath == DependencyPath)
+	{
+		return false;
+	}
+
+	std::lock_guard Locker(m_Lock);
+
+	for (const auto& Path : GetDependentsLocked(DependentPath, true))
+	{
+		if (Path == DependencyPath)
+		{
+			LOG_ERROR(LogAsset, "Asset \"{}\" can not depend on \"{}\", it would form a cycle.", DependentPath.string(), DependencyPath.string());
+			return false;
+		}
+	}
+
+	auto Src = FindOrAddDependencyNode(DependencyPath);
+	auto Dst = FindOrAddDependencyNode(DependentPath);
+
+	for (const auto& EdgeID : m_DependencyGraph.GetNode(Src)->GetOutputEdges())
+	{
+		if (m_DependencyGraph.GetEdge(EdgeID)->GetDestinationNode() == Dst)
+		{
+			return true;
+		}
+	}
+
+	return m_DependencyGraph.AddEdge(Src, Dst).IsValid();
+}
+
+void AssetDatabase::RemoveDependencies(const std::filesystem::path& Dependent)
+{
+	std::lock_guard Locker(m_Lock);
+
+	auto It = m_DependencyNodes.find(GetUnifiedAssetPath(Dependent));
+	if (It == m_DependencyNodes.end())
+	{
+		return;
+	}
+
+	auto InputEdges = m_DependencyGraph.GetNode(It->second)->GetInputEdges();
+	for (const auto& EdgeID : InputEdges)
 	{
-		return true;
+		m_DependencyGraph.RemoveEdge(EdgeID);
 	}
+}
+
+std::vector<std::filesystem::path> AssetDatabase::GetDependencies(const std::filesystem::path& Path) const
+{
+	std::lock_guard Locker(m_Lock);
+	return GetDependenciesLocked(GetUnifiedAssetPath(Path));
+}
+
+std::vector<std::filesystem::path> AssetDatabase::GetDependents(const std::filesystem::path& Path, bool Transitive) const
+{
+	std::lock_guard Locker(m_Lock);
+	return GetDependentsLocked(GetUnifiedAssetPath(Path), Transitive);
+}
+
+std::vector<std::filesystem::path> AssetDatabase::GetDependenciesLocked(const std::filesystem::path& Path) const
+{
+	std::vector<std::filesystem::path> Dependencies;
+
+	auto It = m_DependencyNodes.find(Path);
+	if (It != m_DependencyNodes.end())
+	{
+		for (const auto& EdgeID : m_DependencyGraph.GetNode(It->second)->GetInputEdges())
+		{
+			Dependencies.push_back(m_DependencyPaths.at(m_DependencyGraph.GetEdge(EdgeID)->GetSourceNode()));
+		}
+	}
+
+	return Dependencies;
+}
+
+std::vector<std::filesystem::path> AssetDatabase::GetDependentsLocked(const std::filesystem::path& Path, bool Transitive) const
+{
+	std::vector<std::filesystem::path> Dependents;
+
+	auto It = m_DependencyNodes.find(Path);
+	if (It == m_DependencyNodes.end())
+	{
+		return Dependents;
+	}
+
+	/// Breadth first, so direct dependents come before the ones further up.
+	std::unordered_set<DirectedAcyclicGraph::NodeID> Visited{ It->second };
+	std::queue<DirectedAcyclicGraph::NodeID> Pending;
+	Pending.push(It->second);
+
+	while (!Pending.empty())
+	{
+		auto ID = Pending.front();
+		Pending.pop();
 
-	return false;
+		for (const auto& EdgeID : m_DependencyGraph.GetNode(ID)->GetOutputEdges())
+		{
+			auto DependentID = m_DependencyGraph.GetEdge(EdgeID)->GetDestinationNode();
+			if (Visited.insert(DependentID).second)
+			{
+				Dependents.push_back(m_DependencyPaths.at(DependentID));
+				if (Transitive)
+				{
+					Pending.push(DependentID);
+				}
+			}
+		}
+	}
+
+	return Dependents;
+}
+
+void AssetDatabase::Invalidate(const std::filesystem::path& Path)
+{
+	auto UnifiedPath = GetUnifiedAssetPath(Path);
+
+	std::lock_guard Locker(m_Lock);
+
+	std::vector<std::filesystem::path> Targets{ UnifiedPath };
+	auto Dependents = GetDependentsLocked(UnifiedPath, true);
+	Targets.insert(Targets.end(), Dependents.begin(), Dependents.end());
+
+	ScheduleContext Context;
+	Context.Invalidation = true;
+	Context.ForceReload.insert(Targets.begin(), Targets.end());
+
+	for (const auto& Target : Targets)
+	{
+		/// Assets nobody loaded stay unloaded.
+		if (m_AssetLoadTasks.find(Target) == m_AssetLoadTasks.end())
+		{
+			continue;
+		}
+
+		AssetLoadRequest Request;
+		Request.Path = Target.string();
+
+		LoadTaskList WaitFor;
+		ScheduleLoad(Target, Request, Context, WaitFor);
+	}
+
+	LOG_INFO(LogAsset, "Asset \"{}\" changed, reloading {} assets.", UnifiedPath.string(), Context.NewTasks.size());
+
+	for (auto& Task : Context.NewTasks)
+	{
+		Task->Trigger();
+	}
+}
+
+void AssetDatabase::ReloadModifiedAssets()
+{
+	std::vector<std::filesystem::path> ModifiedAssets;
+
+	{
+		std::lock_guard Locker(m_Lock);
+		for (const auto& [Path, LoadTask] : m_AssetLoadTasks)
+		{
+			if (LoadTask.Resident && LoadTask.GetTarget()->IsDirty())
+			{
+				ModifiedAssets.push_back(Path);
+			}
+		}
+	}
+
+	for (const auto& Path : ModifiedAssets)
+	{
+		Invalidate(Path);
+	}
 }
 
 void AssetDatabase::Finalize()
@@ -137,12 +654,20 @@ void AssetDatabase::Finalize()
 	for (auto& It : m_AssetLoadTasks)
 	{
 		auto& Task = It.second.Task;
-		if (!Task->IsCompleted())
+		if (IsLoadTaskBusy(It.second))
 		{
 			Task->Wait();
 		}
 	}
 
 	m_AssetLoadTasks.clear();
+	m_AssetSettings.clear();
+	m_LRUList.clear();
+	m_MemoryStats.clear();
+	m_ResidentBytes = 0u;
 	m_AssetLoaders.clear();
-}
\ No newline at end of file
+
+	m_DependencyGraph = DirectedAcyclicGraph();
+	m_DependencyNodes.clear();
+	m_DependencyPaths.clear();
+}
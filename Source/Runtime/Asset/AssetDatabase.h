@@ -2,7 +2,10 @@
 
 #include "Core/Module.h"
 #include "Core/StringUtils.h"
+#include "Core/DirectedAcyclicGraph.h"
 #include "Asset/Asset.h"
+#include <list>
+#include <typeindex>
 
 class AssetDatabase : public IService<AssetDatabase>
 {
@@ -12,12 +15,14 @@ public:
 
 	inline void RequestLoad(AssetLoadRequest& Request)
 	{
-		AssetLoadRequests Requests{ Request };
-		RequestLoad(Request);
+		ProcessAssetLoadRequest(Request);
 	}
 
 	void RequestLoad(AssetLoadRequests& Requests);
 
+	/// Loaders are asked in registration order, the first one supporting the extension loads the asset. Register before requesting loads.
+	void RegisterAssetLoader(std::unique_ptr<AssetLoader>&& Loader);
+
 	inline bool Unload(const AssetLoadRequest& Request)
 	{
 		return Unload(GetUnifiedAssetPath(Request.Path));
@@ -31,11 +36,56 @@ public:
 	bool Unload(const std::filesystem::path& Path);
 
 	bool CancelLoad(const std::filesystem::path& Path);
+
+	/// Returns the cached asset and marks it as most recently used, nullptr if it is not in the cache.
+	AssetHandle FindAsset(const std::filesystem::path& Path);
+
+	struct AssetMemoryStats
+	{
+		std::string TypeName;
+		size_t ResidentBytes = 0u;
+		uint32_t NumResident = 0u;
+	};
+
+	std::vector<AssetMemoryStats> GetMemoryStats() const;
+
+	size_t GetResidentBytes() const;
+
+	/// Evicts unreferenced assets in least recently used order until the resident bytes fit into the budget.
+	void EvictUnreferencedAssets(size_t BudgetBytes);
+
+	/// Records that Dependent needs Dependency, e.g. scene -> material -> texture. Loading Dependent schedules its dependencies first,
+	/// the load tasks of independent dependencies run in parallel. Edges that would close a cycle are rejected.
+	bool AddDependency(const std::filesystem::path& Dependent, const std::filesystem::path& Dependency);
+	void RemoveDependencies(const std::filesystem::path& Dependent);
+
+	std::vector<std::filesystem::path> GetDependencies(const std::filesystem::path& Path) const;
+	std::vector<std::filesystem::path> GetDependents(const std::filesystem::path& Path, bool Transitive = true) const;
+
+	/// Reloads Path and every cached asset that depends on it directly or transitively, dependencies before dependents.
+	/// Reloaded assets invoke AssetLoadRequest::OnReloaded of the request that loaded them first.
+	void Invalidate(const std::filesystem::path& Path);
+
+	/// Invalidates every cached asset whose file changed on disk since it was loaded.
+	void ReloadModifiedAssets();
 private:
+	using LRUList = std::list<std::filesystem::path>;
+
 	struct AssetLoadTask
 	{
 		std::shared_ptr<class TFTask> Task;
-		std::shared_ptr<Asset> Target;
+
+		/// Copy of the request that created the task, its Target is the only reference the database holds to the asset.
+		std::shared_ptr<AssetLoadRequest> Request;
+
+		/// File read started at schedule time for loaders that prefetch their data, canceled together with the load.
+		std::shared_ptr<class AsyncReadHandle> Read;
+
+		size_t MemorySize = 0u;
+		bool Resident = false;
+		LRUList::iterator LRUNode;
+
+		inline const AssetHandle& GetTarget() const { return Request->Target; }
 	};
 
 	inline static std::filesystem::path GetUnifiedAssetPath(const std::string& Path, bool Lowercase = false)
@@ -51,11 +101,57 @@ private:
 
 	void ProcessAssetLoadRequest(AssetLoadRequest& Request);
 
-	static void LoadAssetFunc(AssetLoader& Loader, AssetLoadRequest& Request);
+	using LoadTaskList = std::vector<std::shared_ptr<class TFTask>>;
+
+	struct ScheduleContext
+	{
+		bool Invalidation = false;
+		std::unordered_set<std::filesystem::path> ForceReload;
+		std::unordered_map<std::filesystem::path, LoadTaskList> Scheduled;
+		LoadTaskList NewTasks;
+	};
+
+	/// Creates the load task of Path and of its missing dependencies, OutWaitFor receives what a dependent has to wait for. Caller holds m_Lock.
+	void ScheduleLoad(const std::filesystem::path& Path, const AssetLoadRequest& Request, ScheduleContext& Context, LoadTaskList& OutWaitFor);
+
+	DirectedAcyclicGraph::NodeID FindOrAddDependencyNode(const std::filesystem::path& Path);
+	std::vector<std::filesystem::path> GetDependenciesLocked(const std::filesystem::path& Path) const;
+	std::vector<std::filesystem::path> GetDependentsLocked(const std::filesystem::path& Path, bool Transitive) const;
+
+	void LoadAssetFunc(AssetLoader& Loader, AssetLoadRequest& Request, const std::filesystem::path& Path);
+
+	static std::filesystem::path GetUnifiedAssetPath(const std::filesystem::path& Path)
+	{
+		return GetUnifiedAssetPath(Path.string());
+	}
+
+	void OnAssetLoaded(const std::filesystem::path& Path, const AssetHandle& Target);
+
+	void MakeResident(const std::filesystem::path& Path, AssetLoadTask& LoadTask);
+	void ReleaseResident(AssetLoadTask& LoadTask);
+	void EvictUnreferencedAssetsLocked(size_t BudgetBytes);
+
+	/// Resident assets can grow or shrink after their load, e.g. skinning buffers allocated on first use, so they are measured again before every eviction.
+	void RefreshMemorySizesLocked();
+
+	static bool IsLoadTaskBusy(const AssetLoadTask& LoadTask);
 
 	std::unordered_map<std::filesystem::path, AssetLoadTask> m_AssetLoadTasks;
+
+	/// Settings each path was last requested with, see AssetLoadRequest::Settings.
+	std::unordered_map<std::filesystem::path, uint32_t> m_AssetSettings;
 	std::vector<std::unique_ptr<AssetLoader>> m_AssetLoaders;
 
-	std::mutex m_Lock;
+	/// Front is the most recently used.
+	LRUList m_LRUList;
+	std::unordered_map<std::type_index, AssetMemoryStats> m_MemoryStats;
+	size_t m_ResidentBytes = 0u;
+
+	/// Edges point from a dependency to its dependents.
+	DirectedAcyclicGraph m_DependencyGraph;
+	std::unordered_map<std::filesystem::path, DirectedAcyclicGraph::NodeID> m_DependencyNodes;
+	std::unordered_map<DirectedAcyclicGraph::NodeID, std::filesystem::path> m_DependencyPaths;
+
+	mutable std::mutex m_Lock;
 };
 
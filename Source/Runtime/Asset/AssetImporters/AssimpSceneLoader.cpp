@@ -6,9 +6,18 @@
 #include "Profile/CpuTimer.h"
 
 #include "Scene/Components/StaticMesh.h"
+#include "Scene/Components/Skeleton.h"
 #include "Scene/Components/TransformComponent.h"
 #include "Scene/Components/StaticMeshComponent.h"
+#include "Scene/Components/SkeletalMeshComponent.h"
+#include "Scene/Components/AnimatorComponent.h"
 #include "Asset/Material.h"
+#include "Asset/AssetLoaders/CookedScene.h"
+#include "Asset/AssetLoaders/MeshOptimizer.h"
+#include "Asset/AssetLoaders/MeshQuantizer.h"
+#include "Asset/VirtualFileSystem.h"
+#include "Core/ConsoleVariable.h"
+#include "Async/Task.h"
 
 #pragma warning(push)
 #pragma warning(disable:4819)
@@ -19,6 +28,8 @@
 #include <assimp/GltfMaterial.h>
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/DefaultIOSystem.h>
+#include <assimp/IOStream.hpp>
 #pragma warning(pop)
 
 class AssimpProgressHandler : public Assimp::ProgressHandler
@@ -47,6 +58,141 @@ private:
 	const std::filesystem::path& m_AssetPath;
 };
 
+ConsoleVariable<bool> CVarUseCookedScene(
+	"asset.use_cooked_scene",
+	"Load imported scenes from the cooked binary cache when it is up to date, and write the cache after an import.",
+	true);
+
+ConsoleVariable<bool> CVarOptimizeMesh(
+	"asset.optimize_mesh",
+	"Weld, vertex cache, overdraw and vertex fetch optimize meshes at import time.",
+	true);
+
+ConsoleVariable<bool> CVarVertexQuantization(
+	"asset.vertex_quantization",
+	"Store imported vertices as snorm16 positions, octahedral normals and tangents, half texcoords and unorm8 colors.",
+	false);
+
+ConsoleVariable<bool> CVarInterleaveVertices(
+	"asset.interleave_vertices",
+	"Store imported vertices as one interleaved stream instead of one stream per attribute.",
+	false);
+
+static VertexLayout GetImportVertexLayout()
+{
+	VertexLayout Layout;
+	if (CVarVertexQuantization.Get())
+	{
+		Layout.Position = EPositionFormat::SNorm16x4;
+		Layout.Direction = EDirectionFormat::Octahedral16;
+		Layout.Texcoord = ETexcoordFormat::Half2;
+		Layout.Color = EColorFormat::UNorm8x4;
+	}
+	Layout.Interleaved = CVarInterleaveVertices.Get();
+	return Layout;
+}
+
+/// Read only view of a file the virtual file system read into memory.
+class AssimpMemoryStream : public Assimp::IOStream
+{
+public:
+	AssimpMemoryStream(std::shared_ptr<DataBlock>&& Data)
+		: m_Data(std::move(Data))
+	{
+	}
+
+	size_t Read(void* Buffer, size_t Size, size_t Count) override final
+	{
+		if (Size == 0u)
+		{
+			return 0u;
+		}
+
+		Count = std::min(Count, (m_Data->GetSize() - m_Position) / Size);
+		memcpy(Buffer, m_Data->GetRawData() + m_Position, Size * Count);
+		m_Position += Size * Count;
+		return Count;
+	}
+
+	size_t Write(const void*, size_t, size_t) override final { return 0u; }
+
+	aiReturn Seek(size_t Offset, aiOrigin Origin) override final
+	{
+		size_t Position = 0u;
+		switch (Origin)
+		{
+		case aiOrigin_SET: Position = Offset; break;
+		case aiOrigin_CUR: Position = m_Position + Offset; break;
+		case aiOrigin_END:
+			if (Offset > m_Data->GetSize())
+			{
+				return aiReturn_FAILURE;
+			}
+			Position = m_Data->GetSize() - Offset;
+			break;
+		default: return aiReturn_FAILURE;
+		}
+
+		if (Position > m_Data->GetSize())
+		{
+			return aiReturn_FAILURE;
+		}
+
+		m_Position = Position;
+		return aiReturn_SUCCESS;
+	}
+
+	size_t Tell() const override final { return m_Position; }
+	size_t FileSize() const override final { return m_Data->GetSize(); }
+	void Flush() override final {}
+private:
+	std::shared_ptr<DataBlock> m_Data;
+	size_t m_Position = 0u;
+};
+
+/// Records every file the importer reads (.gltf + .bin, .obj + .mtl, ...), the cooked scene is keyed by all of them.
+/// Files inside mounted pack archives are read through the virtual file system, loose files and writes go to disk.
+class AssimpIOSystem : public Assimp::DefaultIOSystem
+{
+public:
+	bool Exists(const char* File) const override final
+	{
+		return VirtualFileSystem::Get().Exists(File);
+	}
+
+	Assimp::IOStream* Open(const char* File, const char* Mode) override final
+	{
+		const bool IsRead = Mode && std::strchr(Mode, 'w') == nullptr && std::strchr(Mode, 'a') == nullptr;
+
+		Assimp::IOStream* Stream = nullptr;
+		if (IsRead && !VirtualFileSystem::Get().IsLooseFile(File))
+		{
+			if (auto Data = VirtualFileSystem::Get().ReadFile(File))
+			{
+				Stream = new AssimpMemoryStream(std::move(Data));
+			}
+		}
+		else
+		{
+			Stream = Assimp::DefaultIOSystem::Open(File, Mode);
+		}
+
+		if (Stream && IsRead)
+		{
+			auto Path = std::filesystem::absolute(File).lexically_normal();
+			if (std::find(m_SourceFiles.begin(), m_SourceFiles.end(), Path) == m_SourceFiles.end())
+			{
+				m_SourceFiles.emplace_back(std::move(Path));
+			}
+		}
+		return Stream;
+	}
+
+	inline const std::vector<std::filesystem::path>& GetSourceFiles() const { return m_SourceFiles; }
+private:
+	std::vector<std::filesystem::path> m_SourceFiles;
+};
+
 class AssimpLogger : public Assimp::Logger
 {
 public:
@@ -116,7 +262,7 @@ AssimpSceneLoader::AssimpSceneLoader()
 	LOG_INFO(LogAsset, "Create assimp scene loader, use assimp @{}.{}.{}", aiGetVersionMajor(), aiGetVersionMinor(), aiGetVersionPatch());
 }
 
-std::shared_ptr<Asset> AssimpSceneLoader::CreateAsset(const std::filesystem::path& AssetPath)
+std::shared_ptr<Asset> AssimpSceneLoader::CreateAsset(const std::filesystem::path& AssetPath, uint32_t /*Settings*/)
 {
 	return std::make_shared<AssimpScene>(AssetPath);
 }
@@ -129,17 +275,44 @@ bool AssimpSceneLoader::Load(Asset& Target)
 
 	auto& Model = Cast<AssimpScene>(Target);
 
-	const uint32_t ProcessFlags = static_cast<uint32_t>(
+	const bool OptimizeMesh = CVarOptimizeMesh.Get();
+
+	uint32_t ProcessFlags = static_cast<uint32_t>(
 		aiProcessPreset_TargetRealtime_MaxQuality |
 		aiProcess_ConvertToLeftHanded |  /// Use DirectX's left-hand coordinate system
-		aiProcess_GenBoundingBoxes |
 		aiProcess_TransformUVCoords |
-		aiProcess_RemoveComponent);
+		aiProcess_RemoveComponent |
+		aiProcess_SplitByBoneCount);  /// Bone indices are stored as uint8, see SkinnedMesh::MaxPaletteBones
 
-	Assimp::Importer AssimpImporter;
+	if (OptimizeMesh)
+	{
+		/// Superseded by MeshOptimizer, which also orders for overdraw and vertex fetch.
+		ProcessFlags &= ~static_cast<uint32_t>(aiProcess_ImproveCacheLocality);
+	}
 
 	int32_t RemoveFlags = aiComponent::aiComponent_CAMERAS | aiComponent::aiComponent_LIGHTS;
+
+	const VertexLayout Layout = GetImportVertexLayout();
+	const uint64_t SettingsHash = ComputeHash(ProcessFlags, RemoveFlags, OptimizeMesh,
+		static_cast<uint32_t>(Layout.Position), static_cast<uint32_t>(Layout.Direction), static_cast<uint32_t>(Layout.Texcoord), static_cast<uint32_t>(Layout.Color), Layout.Interleaved);
+	const bool UseCooked = CVarUseCookedScene.Get();
+	const auto CookedKey = UseCooked ? CookedScene::GetKey(File::GetCachedContentHash(Model.GetPath()), SettingsHash) : DerivedDataKey();
+
+	if (UseCooked && CookedScene::Load(Model, CookedKey))
+	{
+#if _DEBUG
+		LOG_DEBUG(LogAsset, "Load cooked scene \"{}\" takes {:.2f} ms", Model.GetName(), Timer.GetElapsedMilliseconds());
+#endif
+		return true;
+	}
+
+	Assimp::Importer AssimpImporter;
 	AssimpImporter.SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS, RemoveFlags);
+	AssimpImporter.SetPropertyInteger(AI_CONFIG_PP_SBBC_MAX_BONES, static_cast<int32_t>(SkinnedMesh::MaxPaletteBones));
+
+	/// Owned by the importer.
+	auto IOSystem = new AssimpIOSystem();
+	AssimpImporter.SetIOHandler(IOSystem);
 
 #if _DEBUG
 	Assimp::DefaultLogger::set(new AssimpLogger());
@@ -150,11 +323,16 @@ bool AssimpSceneLoader::Load(Asset& Target)
 	{
 		if (AiScene->HasMeshes() && AiScene->mRootNode)
 		{
-			if (ProcessNode(AiScene, AiScene->mRootNode, nullptr, Model))
+			if (ProcessScene(AiScene, Model))
 			{
 #if _DEBUG
 				LOG_DEBUG(LogAsset, "Load assimp scene \"{}\" takes {:.2f} ms", Model.GetName(), Timer.GetElapsedMilliseconds());
 #endif
+				if (UseCooked && !CookedScene::Save(Model, CookedKey, IOSystem->GetSourceFiles()))
+				{
+					LOG_WARNING(LogAsset, "Failed to cook assimp scene \"{}\"", Model.GetName());
+				}
+
 				return true;
 			}
 
@@ -171,228 +349,509 @@ bool AssimpSceneLoader::Load(Asset& Target)
 	return false;
 }
 
-void AssimpSceneLoader::ProcessTransform(const aiNode* AiNode, TransformComponent& TransformComp)
+/// A mesh reference of a node, the mesh and material are assigned once every import task is done.
+/// Skinned meshes get a SkeletalMeshComponent, which also needs the world transform of the node.
+struct AssimpMeshInstance
 {
-	std::stack<const aiMatrix4x4*> RelativeTransforms;
-	auto Node = AiNode;
-	while (Node)
-	{
-		RelativeTransforms.push(&Node->mTransformation);
-		Node = Node->mParent;
-	}
+	uint32_t MeshIndex = 0u;
+	uint32_t MaterialIndex = 0u;
+	std::shared_ptr<StaticMeshComponent> StaticMeshComp;
+	std::shared_ptr<SkeletalMeshComponent> SkeletalMeshComp;
+	Math::Matrix WorldTransform;
+};
 
-	aiMatrix4x4 FinalTransform = *RelativeTransforms.top();
-	RelativeTransforms.pop();
-	while (!RelativeTransforms.empty())
-	{
-		FinalTransform *= *RelativeTransforms.top();
-		RelativeTransforms.pop();
-	}
+/// assimp matrices transform column vectors, Math::Matrix row vectors.
+static Math::Matrix ToMatrix(const aiMatrix4x4& Matrix)
+{
+	return Math::Matrix(
+		Matrix.a1, Matrix.b1, Matrix.c1, Matrix.d1,
+		Matrix.a2, Matrix.b2, Matrix.c2, Matrix.d2,
+		Matrix.a3, Matrix.b3, Matrix.c3, Matrix.d3,
+		Matrix.a4, Matrix.b4, Matrix.c4, Matrix.d4);
+}
 
+static void ProcessTransform(const aiMatrix4x4& WorldTransform, TransformComponent& TransformComp)
+{
 	aiVector3D Translation;
 	aiVector3D Scalling;
 	aiQuaternion Rotation;
-	FinalTransform.Decompose(Scalling, Rotation, Translation);
+	WorldTransform.Decompose(Scalling, Rotation, Translation);
 
 	TransformComp.SetTranslation(Translation.x, Translation.y, Translation.z)
 		.SetScale(Scalling.x, Scalling.y, Scalling.z)
 		.SetRotation(Rotation.x, Rotation.y, Rotation.z, Rotation.w);
 }
 
-bool AssimpSceneLoader::ProcessNode(const aiScene* AiScene, const aiNode* AiNode, const Entity* Parent, AssimpScene& Model)
+/// Channels are matched to skeleton bones by node name, channels of other nodes are dropped.
+static std::shared_ptr<AnimationClip> ProcessAnimation(const aiAnimation* AiAnimation, const Skeleton& SceneSkeleton)
 {
-	if (!AiNode)
+	const double TicksPerSecond = AiAnimation->mTicksPerSecond > 0.0 ? AiAnimation->mTicksPerSecond : 25.0;
+
+	RawAnimationClip Raw;
+	Raw.Name = AiAnimation->mName.C_Str();
+	Raw.Duration = static_cast<float>(AiAnimation->mDuration / TicksPerSecond);
+	Raw.Tracks.resize(SceneSkeleton.GetNumBones());
+
+	size_t NumKeys = 0u, RawSize = 0u;
+	for (uint32_t ChannelIndex = 0u; ChannelIndex < AiAnimation->mNumChannels; ++ChannelIndex)
 	{
-		return false;
-	}
+		const auto AiChannel = AiAnimation->mChannels[ChannelIndex];
+		const uint32_t Bone = SceneSkeleton.FindBone(AiChannel->mNodeName.C_Str());
+		if (Bone == ~0u)
+		{
+			continue;
+		}
 
-	static auto SetNodeName = [](Entity& Node) {
-		if (Node.GetName().Get().empty())
+		auto& Track = Raw.Tracks[Bone];
+		for (uint32_t Index = 0u; Index < AiChannel->mNumPositionKeys; ++Index)
 		{
-			Node.SetName(String::Format("node%d", Node.GetID().GetIndex()));
+			const auto& Key = AiChannel->mPositionKeys[Index];
+			Track.Translations.push_back({ static_cast<float>(Key.mTime / TicksPerSecond), Math::Vector3(Key.mValue.x, Key.mValue.y, Key.mValue.z) });
 		}
-	};
+		for (uint32_t Index = 0u; Index < AiChannel->mNumRotationKeys; ++Index)
+		{
+			const auto& Key = AiChannel->mRotationKeys[Index];
+			Track.Rotations.push_back({ static_cast<float>(Key.mTime / TicksPerSecond), Math::Quaternion(Key.mValue.x, Key.mValue.y, Key.mValue.z, Key.mValue.w) });
+		}
+		for (uint32_t Index = 0u; Index < AiChannel->mNumScalingKeys; ++Index)
+		{
+			const auto& Key = AiChannel->mScalingKeys[Index];
+			Track.Scales.push_back({ static_cast<float>(Key.mTime / TicksPerSecond), Math::Vector3(Key.mValue.x, Key.mValue.y, Key.mValue.z) });
+		}
+
+		NumKeys += Track.Translations.size() + Track.Rotations.size() + Track.Scales.size();
+		RawSize += Track.Translations.size() * sizeof(RawAnimationTrack::Key<Math::Vector3>) +
+			Track.Rotations.size() * sizeof(RawAnimationTrack::Key<Math::Quaternion>) +
+			Track.Scales.size() * sizeof(RawAnimationTrack::Key<Math::Vector3>);
+	}
+
+	auto Clip = AnimationClip::Compress(Raw);
 
-	auto& ParentNode = Model.AddEntity(Parent ? Parent->GetID() : EntityID(), AiNode->mName.C_Str());
+	LOG_DEBUG(LogAsset, "Compress animation \"{}\": {} keys, {} -> {} bytes",
+		Raw.Name, NumKeys, RawSize, Clip->GetSize());
 
-	if (AiNode == AiScene->mRootNode)
+	return Clip;
+}
+
+bool AssimpSceneLoader::ProcessNodes(const aiScene* AiScene, AssimpScene& Model, std::vector<AssimpMeshInstance>& OutInstances, std::shared_ptr<Skeleton>& OutSkeleton)
+{
+	struct NodeVisit
 	{
-		Model.SetRoot(ParentNode.GetID());
-	}
+		const aiNode* AiNode = nullptr;
+		size_t Parent = ~0ull;
+		aiMatrix4x4 WorldTransform;
+		EntityID ID;
+	};
+
+	/// Depth first with the children pushed in reverse, so Order is the pre-order of the recursive walk and parents always come before their children:
+	/// every world transform is one multiply away from an already resolved one.
+	std::vector<NodeVisit> Visits;
+	std::vector<size_t> Order;
+	std::vector<size_t> Pending{ 0u };
+	Visits.push_back(NodeVisit{ AiScene->mRootNode, ~0ull, AiScene->mRootNode->mTransformation });
 
-	for (uint32_t Index = 0u; Index < AiNode->mNumMeshes; ++Index)
+	size_t NumEntity = 0u;
+	while (!Pending.empty())
 	{
-		const auto MeshIndex = AiNode->mMeshes[Index];
-		const auto AiMesh = AiScene->mMeshes[MeshIndex];
+		const size_t VisitIndex = Pending.back();
+		Pending.pop_back();
 
-		if (AiMesh->HasBones())
+		const aiNode* AiNode = Visits[VisitIndex].AiNode;
+		if (!AiNode)
 		{
-			LOG_ERROR(LogAsset, "Not supported skeletal mesh yet!");
-			continue;
+			return false;
 		}
 
-		auto& ChildNode = Model.AddChild(ParentNode, AiMesh->mName.C_Str());
-		SetNodeName(ChildNode);
+		Order.push_back(VisitIndex);
+		NumEntity += 1u + AiNode->mNumMeshes;
 
-		auto TransformComp = ChildNode.AddComponent<TransformComponent>();
-		auto StaticMeshComp = ChildNode.AddComponent<StaticMeshComponent>();
+		for (uint32_t Index = AiNode->mNumChildren; Index > 0u; --Index)
+		{
+			const aiNode* AiChild = AiNode->mChildren[Index - 1u];
+			Pending.push_back(Visits.size());
+			Visits.push_back(NodeVisit{ AiChild, VisitIndex, AiChild ? Visits[VisitIndex].WorldTransform * AiChild->mTransformation : aiMatrix4x4() });
+		}
+	}
 
-		ProcessTransform(AiNode, *TransformComp);
-		ProcessMesh(AiScene, MeshIndex, *StaticMeshComp);
-		ProcessMaterial(AiScene, Model, AiMesh->mMaterialIndex, *StaticMeshComp);
+	/// One skeleton per scene: the nodes any bone refers to plus all of their ancestors, so a bone's global pose is its world transform.
+	std::unordered_set<std::string> BoneNames;
+	for (uint32_t MeshIndex = 0u; MeshIndex < AiScene->mNumMeshes; ++MeshIndex)
+	{
+		const auto AiMesh = AiScene->mMeshes[MeshIndex];
+		for (uint32_t BoneIndex = 0u; AiMesh && BoneIndex < AiMesh->mNumBones; ++BoneIndex)
+		{
+			BoneNames.emplace(AiMesh->mBones[BoneIndex]->mName.C_Str());
+		}
 	}
 
-	if (AiNode->mNumChildren == 0u)
+	if (!BoneNames.empty())
 	{
-		return true;
+		std::vector<uint32_t> BoneIndices(Visits.size(), ~0u);
+		std::vector<bool> IsBone(Visits.size(), false);
+		for (size_t VisitIndex = 0u; VisitIndex < Visits.size(); ++VisitIndex)
+		{
+			if (BoneNames.count(Visits[VisitIndex].AiNode->mName.C_Str()))
+			{
+				for (size_t Ancestor = VisitIndex; Ancestor != ~0ull && !IsBone[Ancestor]; Ancestor = Visits[Ancestor].Parent)
+				{
+					IsBone[Ancestor] = true;
+				}
+			}
+		}
+
+		OutSkeleton = std::make_shared<Skeleton>();
+		for (const size_t VisitIndex : Order)
+		{
+			if (IsBone[VisitIndex])
+			{
+				const auto& Visit = Visits[VisitIndex];
+				BoneIndices[VisitIndex] = OutSkeleton->AddBone(
+					std::string(Visit.AiNode->mName.C_Str()),
+					Visit.Parent == ~0ull ? ~0u : BoneIndices[Visit.Parent],
+					ToMatrix(Visit.AiNode->mTransformation));
+			}
+		}
 	}
 
-	for (uint32_t NodeIndex = 0u; NodeIndex < AiNode->mNumChildren; ++NodeIndex)
+	/// Entities and their components refer to each other by address, so the storage must not move while the hierarchy is built.
+	Model.m_Entities.reserve(Model.m_Entities.size() + NumEntity);
+
+	for (const size_t VisitIndex : Order)
 	{
-		if (!ProcessNode(AiScene, AiNode->mChildren[NodeIndex], &ParentNode, Model))
+		auto& Visit = Visits[VisitIndex];
+		const aiNode* AiNode = Visit.AiNode;
+
+		auto& Node = Model.AddEntity(Visit.Parent == ~0ull ? EntityID() : Visits[Visit.Parent].ID, std::string(AiNode->mName.C_Str()));
+		Visit.ID = Node.GetID();
+
+		if (AiNode == AiScene->mRootNode)
 		{
-			return false;
+			Model.SetRoot(Visit.ID);
+		}
+
+		for (uint32_t Index = 0u; Index < AiNode->mNumMeshes; ++Index)
+		{
+			const auto MeshIndex = AiNode->mMeshes[Index];
+			const auto AiMesh = AiScene->mMeshes[MeshIndex];
+
+			auto& ChildNode = Model.AddChild(Visit.ID, std::string(AiMesh->mName.C_Str()));
+			if (ChildNode.GetName().Get().empty())
+			{
+				ChildNode.SetName(String::Format("node%d", ChildNode.GetID().GetIndex()));
+			}
+
+			ProcessTransform(Visit.WorldTransform, *ChildNode.AddComponent<TransformComponent>());
+
+			auto& Instance = OutInstances.emplace_back();
+			Instance.MeshIndex = MeshIndex;
+			Instance.MaterialIndex = AiMesh->mMaterialIndex;
+			Instance.WorldTransform = ToMatrix(Visit.WorldTransform);
+			if (AiMesh->HasBones())
+			{
+				Instance.SkeletalMeshComp = ChildNode.AddComponent<SkeletalMeshComponent>();
+				Instance.StaticMeshComp = Instance.SkeletalMeshComp;
+			}
+			else
+			{
+				Instance.StaticMeshComp = ChildNode.AddComponent<StaticMeshComponent>();
+			}
 		}
 	}
 
 	return true;
 }
 
-void AssimpSceneLoader::ProcessMaterial(const aiScene* AiScene, const AssimpScene& Model, uint32_t MaterialIndex, StaticMeshComponent& StaticMeshComp)
+bool AssimpSceneLoader::ProcessScene(const aiScene* AiScene, AssimpScene& Model)
 {
-	if (!AiScene->HasMaterials())
+#if _DEBUG
+	CpuTimer Timer;
+#endif
+
+	std::vector<AssimpMeshInstance> Instances;
+	std::shared_ptr<Skeleton> SceneSkeleton;
+	if (!ProcessNodes(AiScene, Model, Instances, SceneSkeleton))
 	{
-		return;
+		return false;
 	}
 
-	if (auto AiMaterial = AiScene->mMaterials[MaterialIndex])
+#if _DEBUG
+	const float HierarchyTime = Timer.GetElapsedMilliseconds();
+#endif
+
+	struct ImportedMesh
 	{
-		aiString Name;
-		AiMaterial->Get(AI_MATKEY_NAME, Name);
+		uint32_t MeshIndex = 0u;
+		std::string Name;
+		BoxSphereBounds Bounds;
+		std::shared_ptr<StaticMesh> Mesh;
+	};
+
+	struct ImportedMaterial
+	{
+		uint32_t MaterialIndex = 0u;
+		std::filesystem::path Path;
+		std::shared_ptr<MaterialProperty> Property;
+	};
 
-		auto Path = (Paths::MaterialPath() / Model.GetStem() / Name.C_Str()).replace_extension(MaterialProperty::GetExtension());
-		const bool FileExists = std::filesystem::exists(Path);
-		auto Property = MaterialProperty::Load(Path);
-		StaticMeshComp.SetMaterialProperty(Property);
+	/// Every mesh and material is imported once however many nodes refer to it, materials are keyed by path since that is what they are saved to.
+	std::vector<ImportedMesh> Meshes;
+	std::vector<uint32_t> MeshSlots(AiScene->mNumMeshes, ~0u);
+	std::vector<ImportedMaterial> Materials;
+	std::vector<uint32_t> MaterialSlots(AiScene->mNumMaterials, ~0u);
+	std::unordered_map<std::string, uint32_t> MaterialPaths;
 
-		if (FileExists)
+	for (const auto& Instance : Instances)
+	{
+		if (MeshSlots[Instance.MeshIndex] == ~0u)
 		{
-			return;
+			MeshSlots[Instance.MeshIndex] = static_cast<uint32_t>(Meshes.size());
+
+			const auto AiMesh = AiScene->mMeshes[Instance.MeshIndex];
+			auto& Mesh = Meshes.emplace_back();
+			Mesh.MeshIndex = Instance.MeshIndex;
+			Mesh.Name = AiMesh->mName.length == 0u ? String::Format("mesh%d", Instance.MeshIndex) : AiMesh->mName.C_Str();
 		}
 
-		aiString AlphaMode;
-		if (AiMaterial->Get(AI_MATKEY_GLTF_ALPHAMODE, AlphaMode) == AI_SUCCESS)
+		if (AiScene->HasMaterials() && Instance.MaterialIndex < AiScene->mNumMaterials && MaterialSlots[Instance.MaterialIndex] == ~0u && AiScene->mMaterials[Instance.MaterialIndex])
 		{
-			if (AlphaMode == aiString("OPAQUE"))
+			auto Path = GetMaterialPath(AiScene->mMaterials[Instance.MaterialIndex], Model);
+			auto It = MaterialPaths.find(Path.generic_string());
+			if (It == MaterialPaths.end())
 			{
-				Property->BlendMode = EBlendMode::Opaque;
+				It = MaterialPaths.emplace(Path.generic_string(), static_cast<uint32_t>(Materials.size())).first;
+				Materials.push_back(ImportedMaterial{ Instance.MaterialIndex, std::move(Path) });
 			}
-			else if (AlphaMode == aiString("MASK"))
+			MaterialSlots[Instance.MaterialIndex] = It->second;
+		}
+	}
+
+	std::vector<std::shared_ptr<AnimationClip>> Clips(SceneSkeleton ? AiScene->mNumAnimations : 0u);
+
+	/// All sets run side by side, a task only touches its own slot and the assimp scene is read only by now.
+	/// The loader itself runs on a worker, it helps with the flow instead of blocking on it.
+	tf::Taskflow Flow;
+	Flow.for_each(Meshes.begin(), Meshes.end(), [this, AiScene, &SceneSkeleton](ImportedMesh& Mesh) {
+		Mesh.Mesh = ProcessMesh(AiScene, Mesh.MeshIndex, Mesh.Name, SceneSkeleton, Mesh.Bounds);
+	});
+	Flow.for_each(Materials.begin(), Materials.end(), [this, AiScene, &Model](ImportedMaterial& Material) {
+		Material.Property = ProcessMaterial(AiScene->mMaterials[Material.MaterialIndex], Model, Material.Path);
+	});
+	Flow.for_each(Clips.begin(), Clips.end(), [AiScene, &Clips, &SceneSkeleton](std::shared_ptr<AnimationClip>& Clip) {
+		Clip = ProcessAnimation(AiScene->mAnimations[&Clip - Clips.data()], *SceneSkeleton);
+	});
+	TFTask::CorunTaskFlow(Flow);
+
+	std::vector<SkeletalMeshComponent*> SkeletalMeshComps;
+	for (auto& Instance : Instances)
+	{
+		auto& Mesh = Meshes[MeshSlots[Instance.MeshIndex]];
+		Instance.StaticMeshComp->SetName(std::string(Mesh.Name));
+
+		if (Mesh.Mesh)
+		{
+			Instance.StaticMeshComp->SetWorldTransform(Instance.WorldTransform);
+			Instance.StaticMeshComp->SetLocalBounds(Mesh.Bounds);
+			if (Instance.SkeletalMeshComp)
 			{
-				Property->BlendMode = EBlendMode::Masked;
+				Instance.SkeletalMeshComp->SetSkinnedMesh(std::static_pointer_cast<SkinnedMesh>(Mesh.Mesh));
+				Instance.SkeletalMeshComp->SetMeshTransform(Instance.WorldTransform);
+				SkeletalMeshComps.push_back(Instance.SkeletalMeshComp.get());
 			}
-			else if (AlphaMode == aiString("BLEND"))
+			else
 			{
-				Property->BlendMode = EBlendMode::Translucent;
+				Instance.StaticMeshComp->SetMesh(Mesh.Mesh);
 			}
 		}
 
-		aiShadingMode ShadingMode = aiShadingMode_Unlit;
-		AiMaterial->Get(AI_MATKEY_SHADING_MODEL, ShadingMode);
+		if (Instance.MaterialIndex < MaterialSlots.size() && MaterialSlots[Instance.MaterialIndex] != ~0u)
+		{
+			Instance.StaticMeshComp->SetMaterialProperty(Materials[MaterialSlots[Instance.MaterialIndex]].Property);
+		}
+	}
 
-		Property->Name.assign(Name.C_Str());
+	/// The scene's animations play on one animator at the root, the first one starts looping right away.
+	if (!Clips.empty() && !SkeletalMeshComps.empty())
+	{
+		auto Animator = Model.GetRoot()->AddComponent<AnimatorComponent>();
+		Animator->SetSkeleton(SceneSkeleton);
 
-#define GET_COLOR_FACTOR(Key, Target) { aiColor4D Factor(1.0f, 1.0f, 1.0f, 1.0f); AiMaterial->Get(Key, Factor); Target = Math::Color(Factor.r, Factor.g, Factor.b, Factor.a); }
-#define GET_FACTOR(Key, Target) { ai_real Factor = 1.0f; AiMaterial->Get(Key, Factor); Target = Factor; }
+		for (auto& Clip : Clips)
+		{
+			Animator->AddClip(Clip);
+		}
 
-		GET_COLOR_FACTOR(AI_MATKEY_BASE_COLOR, Property->Factors.BaseColor);
-		GET_COLOR_FACTOR(AI_MATKEY_COLOR_DIFFUSE, Property->Factors.DiffuseColor);
-		GET_COLOR_FACTOR(AI_MATKEY_COLOR_SPECULAR, Property->Factors.SpecularColor);
-		GET_COLOR_FACTOR(AI_MATKEY_COLOR_EMISSIVE, Property->Factors.EmissiveColor);
-		GET_COLOR_FACTOR(AI_MATKEY_COLOR_TRANSPARENT, Property->Factors.TransparentColor);
-		GET_COLOR_FACTOR(AI_MATKEY_COLOR_REFLECTIVE, Property->Factors.ReflectiveColor);
-
-		GET_FACTOR(AI_MATKEY_METALLIC_FACTOR, Property->Factors.Metalness);
-		GET_FACTOR(AI_MATKEY_ROUGHNESS_FACTOR, Property->Factors.Roughness);
-		GET_FACTOR(AI_MATKEY_GLOSSINESS_FACTOR, Property->Factors.Glossiness);
-		GET_FACTOR(AI_MATKEY_SPECULAR_FACTOR, Property->Factors.Specular);
-		GET_FACTOR(AI_MATKEY_OPACITY, Property->Factors.Opacity);
-		GET_FACTOR(AI_MATKEY_SHININESS, Property->Factors.Shininess);
-
-		AiMaterial->Get(AI_MATKEY_GLTF_ALPHACUTOFF, Property->AlphaCutoff);
-		AiMaterial->Get(AI_MATKEY_TWOSIDED, Property->DoubleSided);
-#undef GET_COLOR_FACTOR
-#undef GET_FACTOR
+		for (auto& Instance : Instances)
+		{
+			if (Instance.SkeletalMeshComp && Instance.SkeletalMeshComp->HasSkinnedMesh())
+			{
+				Animator->AddTarget(Instance.SkeletalMeshComp);
+			}
+		}
+
+		Animator->SetBlendTree(std::make_unique<AnimationClipNode>(Clips.front()));
+	}
 
-		switch (ShadingMode)
+#if _DEBUG
+	/// Skinning with the bind pose must give back the imported vertices, anything else means the bone or mesh transforms disagree.
+	TFTask::CorunParallelFor(SkeletalMeshComps.begin(), SkeletalMeshComps.end(), [](SkeletalMeshComponent* SkeletalMeshComp) {
+		SkeletalMeshComp->Skin();
+	});
+	for (const auto SkeletalMeshComp : SkeletalMeshComps)
+	{
+		const auto& Positions = SkeletalMeshComp->GetSkinnedPositions();
+		const auto Data = SkeletalMeshComp->GetSkinnedMesh().GetData();
+
+		float MaxDeviation = 0.0f;
+		for (uint32_t Index = 0u; Index < Data->GetNumVertex(); ++Index)
 		{
-		case aiShadingMode_Flat:
-		case aiShadingMode_Gouraud:
-		case aiShadingMode_Phong:
-		case aiShadingMode_Blinn:
-			Property->ShadingMode = EShadingMode::BlinnPhong;
-			break;
-		case aiShadingMode_Toon:
-			Property->ShadingMode = EShadingMode::Toon;
-			break;
-		case aiShadingMode_OrenNayar:
-		case aiShadingMode_Minnaert:
-		case aiShadingMode_CookTorrance:
-		case aiShadingMode_Fresnel:
-		case aiShadingMode_PBR_BRDF:
-			Property->ShadingMode = EShadingMode::StandardPBR;
-			break;
-		case aiShadingMode_NoShading:
-			Property->ShadingMode = EShadingMode::Unlit;
-			break;
+			MaxDeviation = std::max(MaxDeviation, (Positions[Index] - Data->GetElement<Math::Vector3>(EVertexElement::Position, Index)).Length());
+		}
+
+		const float Tolerance = 1e-3f * std::max(SkeletalMeshComp->GetLocalBounds().GetSphere().GetRadius(), 1.0f);
+		if (MaxDeviation > Tolerance)
+		{
+			LOG_WARNING(LogAsset, "Skinned mesh \"{}\" deviates {} from its bind pose", SkeletalMeshComp->GetName().Get(), MaxDeviation);
 		}
+	}
+#endif
+
+#if _DEBUG
+	LOG_DEBUG(LogAsset, "Process assimp scene \"{}\": {} entities, {} meshes, {} materials on {} workers, hierarchy {:.2f} ms, meshes and materials {:.2f} ms",
+		Model.GetName(), Model.GetNumEntity(), Meshes.size(), Materials.size(), TFTask::GetNumWorkerThreads(), HierarchyTime, Timer.GetElapsedMilliseconds() - HierarchyTime);
+#endif
+
+	return true;
+}
+
+std::filesystem::path AssimpSceneLoader::GetMaterialPath(const aiMaterial* AiMaterial, const AssimpScene& Model)
+{
+	aiString Name;
+	AiMaterial->Get(AI_MATKEY_NAME, Name);
+
+	return (Paths::MaterialPath() / Model.GetStem() / Name.C_Str()).replace_extension(MaterialProperty::GetExtension());
+}
+
+std::shared_ptr<MaterialProperty> AssimpSceneLoader::ProcessMaterial(const aiMaterial* AiMaterial, const AssimpScene& Model, const std::filesystem::path& Path)
+{
+	aiString Name;
+	AiMaterial->Get(AI_MATKEY_NAME, Name);
+
+	AssetDatabase::Get().AddDependency(Model.GetPath(), Path);
+
+	const bool FileExists = std::filesystem::exists(Path);
+	auto Property = MaterialProperty::Load(Path);
 
+	/// Textures are not saved with the material, an existing file still resolves them from the source scene.
+	if (FileExists)
+	{
 		ProcessTextures(AiMaterial, *Property, Model.GetPath().parent_path());
+		return Property;
+	}
+
+	aiString AlphaMode;
+	if (AiMaterial->Get(AI_MATKEY_GLTF_ALPHAMODE, AlphaMode) == AI_SUCCESS)
+	{
+		if (AlphaMode == aiString("OPAQUE"))
+		{
+			Property->BlendMode = EBlendMode::Opaque;
+		}
+		else if (AlphaMode == aiString("MASK"))
+		{
+			Property->BlendMode = EBlendMode::Masked;
+		}
+		else if (AlphaMode == aiString("BLEND"))
+		{
+			Property->BlendMode = EBlendMode::Translucent;
+		}
+	}
+
+	aiShadingMode ShadingMode = aiShadingMode_Unlit;
+	AiMaterial->Get(AI_MATKEY_SHADING_MODEL, ShadingMode);
+
+	Property->Name.assign(Name.C_Str());
+
+#define GET_COLOR_FACTOR(Key, Target) { aiColor4D Factor(1.0f, 1.0f, 1.0f, 1.0f); AiMaterial->Get(Key, Factor); Target = Math::Color(Factor.r, Factor.g, Factor.b, Factor.a); }
+#define GET_FACTOR(Key, Target) { ai_real Factor = 1.0f; AiMaterial->Get(Key, Factor); Target = Factor; }
+
+	GET_COLOR_FACTOR(AI_MATKEY_BASE_COLOR, Property->Factors.BaseColor);
+	GET_COLOR_FACTOR(AI_MATKEY_COLOR_DIFFUSE, Property->Factors.DiffuseColor);
+	GET_COLOR_FACTOR(AI_MATKEY_COLOR_SPECULAR, Property->Factors.SpecularColor);
+	GET_COLOR_FACTOR(AI_MATKEY_COLOR_EMISSIVE, Property->Factors.EmissiveColor);
+	GET_COLOR_FACTOR(AI_MATKEY_COLOR_TRANSPARENT, Property->Factors.TransparentColor);
+	GET_COLOR_FACTOR(AI_MATKEY_COLOR_REFLECTIVE, Property->Factors.ReflectiveColor);
+
+	GET_FACTOR(AI_MATKEY_METALLIC_FACTOR, Property->Factors.Metalness);
+	GET_FACTOR(AI_MATKEY_ROUGHNESS_FACTOR, Property->Factors.Roughness);
+	GET_FACTOR(AI_MATKEY_GLOSSINESS_FACTOR, Property->Factors.Glossiness);
+	GET_FACTOR(AI_MATKEY_SPECULAR_FACTOR, Property->Factors.Specular);
+	GET_FACTOR(AI_MATKEY_OPACITY, Property->Factors.Opacity);
+	GET_FACTOR(AI_MATKEY_SHININESS, Property->Factors.Shininess);
+
+	AiMaterial->Get(AI_MATKEY_GLTF_ALPHACUTOFF, Property->AlphaCutoff);
+	AiMaterial->Get(AI_MATKEY_TWOSIDED, Property->DoubleSided);
+#undef GET_COLOR_FACTOR
+#undef GET_FACTOR
 
-		Property->Save(true, Path);
+	switch (ShadingMode)
+	{
+	case aiShadingMode_Flat:
+	case aiShadingMode_Gouraud:
+	case aiShadingMode_Phong:
+	case aiShadingMode_Blinn:
+		Property->ShadingMode = EShadingMode::BlinnPhong;
+		break;
+	case aiShadingMode_Toon:
+		Property->ShadingMode = EShadingMode::Toon;
+		break;
+	case aiShadingMode_OrenNayar:
+	case aiShadingMode_Minnaert:
+	case aiShadingMode_CookTorrance:
+	case aiShadingMode_Fresnel:
+	case aiShadingMode_PBR_BRDF:
+		Property->ShadingMode = EShadingMode::StandardPBR;
+		break;
+	case aiShadingMode_NoShading:
+		Property->ShadingMode = EShadingMode::Unlit;
+		break;
 	}
+
+	ProcessTextures(AiMaterial, *Property, Model.GetPath().parent_path());
+
+	Property->Save(true, Path);
+
+	return Property;
 }
 
-void AssimpSceneLoader::ProcessMesh(const aiScene* AiScene, uint32_t MeshIndex, StaticMeshComponent& StaticMeshComp)
+std::shared_ptr<StaticMesh> AssimpSceneLoader::ProcessMesh(const aiScene* AiScene, uint32_t MeshIndex, const std::string& Name, const std::shared_ptr<Skeleton>& SceneSkeleton, BoxSphereBounds& OutBounds)
 {
 	const auto AiMesh = AiScene->mMeshes[MeshIndex];
 
 	if (!AiMesh)
 	{
 		LOG_ERROR(LogAsset, "Detected invalid mesh!");
-		return;
+		return nullptr;
 	}
 	if (!AiMesh->HasPositions())
 	{
 		LOG_ERROR(LogAsset, "The mesh \"{}\" has no vertices data!", AiMesh->mName.C_Str());
-		return;
+		return nullptr;
 	}
 	if (!AiMesh->HasNormals())
 	{
 		LOG_WARNING(LogAsset, "The mesh \"{}\" has no normals!", AiMesh->mName.C_Str());
-		return;
+		return nullptr;
 	}
 	if (!AiMesh->HasFaces())
 	{
 		LOG_ERROR(LogAsset, "The mesh \"{}\" has no indices data!", AiMesh->mName.C_Str());
-		return;
+		return nullptr;
 	}
 	if (AiMesh->mPrimitiveTypes != aiPrimitiveType_TRIANGLE)
 	{
 		LOG_ERROR(LogAsset, "The mesh \"{}\" has unsupported primitive type!", AiMesh->mName.C_Str());
-		return;
+		return nullptr;
 	}
 
-	auto Center = (AiMesh->mAABB.mMax + AiMesh->mAABB.mMin) * 0.5f;
-	auto Extents = (AiMesh->mAABB.mMax - AiMesh->mAABB.mMin) * 0.5f;
-	auto Radius = std::max<ai_real>(std::max<ai_real>(Extents.x, Extents.y), Extents.z);
-
-	BoxSphereBounds Bounds(Math::Vector3(Center.x, Center.y, Center.z), Math::Vector3(Extents.x, Extents.y, Extents.z), Radius);
-	StaticMeshComp.SetBounds(Bounds);
-
-	auto Name = AiMesh->mName.Empty() ? String::Format("mesh%d", MeshIndex) : AiMesh->mName.C_Str();
-	StaticMeshComp.SetName(std::move(Name));
-
 	MeshData Data(
 		AiMesh->mNumVertices,
 		AiMesh->mNumFaces * 3u,
@@ -402,6 +861,7 @@ void AssimpSceneLoader::ProcessMesh(const aiScene* AiScene, uint32_t MeshIndex,
 		AiMesh->HasTextureCoords(0u),
 		AiMesh->HasTextureCoords(1u),
 		AiMesh->HasVertexColors(0u),
+		AiMesh->HasBones(),
 		ERHIPrimitiveTopology::TriangleList);
 
 	for (uint32_t FaceIndex = 0u; FaceIndex < AiMesh->mNumFaces; ++FaceIndex)
@@ -433,12 +893,12 @@ void AssimpSceneLoader::ProcessMesh(const aiScene* AiScene, uint32_t MeshIndex,
 		if (AiMesh->HasTextureCoords(0u))
 		{
 			const auto& UV = AiMesh->mTextureCoords[0u][VertexIndex];
-			Data.SetUV0(VertexIndex, Math::Vector3(UV.x, UV.y, UV.z));
+			Data.SetUV0(VertexIndex, Math::Vector2(UV.x, UV.y));
 		}
-		if (AiMesh->HasTextureCoords(1))
+		if (AiMesh->HasTextureCoords(1u))
 		{
 			const auto& UV = AiMesh->mTextureCoords[1u][VertexIndex];
-			Data.SetUV0(VertexIndex, Math::Vector3(UV.x, UV.y, UV.z));
+			Data.SetUV1(VertexIndex, Math::Vector2(UV.x, UV.y));
 		}
 
 		if (AiMesh->HasVertexColors(0u))
@@ -450,19 +910,115 @@ void AssimpSceneLoader::ProcessMesh(const aiScene* AiScene, uint32_t MeshIndex,
 
 	if (AiMesh->HasBones())
 	{
-		assert(false);
+		if (!SceneSkeleton || AiMesh->mNumBones > SkinnedMesh::MaxPaletteBones)
+		{
+			LOG_ERROR(LogAsset, "The skinned mesh \"{}\" has {} bones, more than a palette can hold!", Name, AiMesh->mNumBones);
+			return nullptr;
+		}
+
+		struct Influence
+		{
+			float Weight = 0.0f;
+			uint8_t Bone = 0u;
+		};
+
+		/// The four largest influences per vertex sorted largest first, as SetSkin expects.
+		std::vector<std::array<Influence, 4u>> Influences(AiMesh->mNumVertices);
+		for (uint32_t BoneIndex = 0u; BoneIndex < AiMesh->mNumBones; ++BoneIndex)
+		{
+			const auto AiBone = AiMesh->mBones[BoneIndex];
+			for (uint32_t WeightIndex = 0u; WeightIndex < AiBone->mNumWeights; ++WeightIndex)
+			{
+				const auto& AiWeight = AiBone->mWeights[WeightIndex];
+				auto& Slots = Influences[AiWeight.mVertexId];
+
+				Influence Inserted{ AiWeight.mWeight, static_cast<uint8_t>(BoneIndex) };
+				for (auto& Slot : Slots)
+				{
+					if (Inserted.Weight > Slot.Weight)
+					{
+						std::swap(Inserted, Slot);
+					}
+				}
+			}
+		}
+
+		for (uint32_t VertexIndex = 0u; VertexIndex < AiMesh->mNumVertices; ++VertexIndex)
+		{
+			const auto& Slots = Influences[VertexIndex];
+			const float Sum = Slots[0].Weight + Slots[1].Weight + Slots[2].Weight + Slots[3].Weight;
+			const float InvSum = Sum > 0.0f ? 1.0f / Sum : 0.0f;
+
+			Data.SetSkin(VertexIndex,
+				std::array<uint8_t, 4u>{ Slots[0].Bone, Slots[1].Bone, Slots[2].Bone, Slots[3].Bone },
+				std::array<float, 4u>{ Slots[0].Weight * InvSum, Slots[1].Weight * InvSum, Slots[2].Weight * InvSum, Slots[3].Weight * InvSum });
+		}
 	}
-	else
+
+	if (CVarOptimizeMesh.Get())
 	{
-		auto Mesh = std::make_shared<StaticMesh>(Data);
-		StaticMeshComp.SetMesh(Mesh);
+		MeshOptimizationStatistics Statistics;
+		Data = MeshOptimizer::Optimize(Data, &Statistics);
+
+		LOG_DEBUG(LogAsset, "Optimize mesh \"{}\": vertices {} -> {}, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+			Name,
+			Statistics.NumVertexBefore, Statistics.NumVertexAfter,
+			Statistics.Before.ACMR, Statistics.After.ACMR,
+			Statistics.Before.ATVR, Statistics.After.ATVR);
+	}
+
+	/// Meshes are processed in parallel already, splitting the bounds reduction further only adds overhead.
+	OutBounds = Data.ComputeBounds(false);
+
+	/// CPU skinning reads full precision positions and normals, skinned meshes keep the default layout.
+	const VertexLayout Layout = GetImportVertexLayout();
+	if (Layout != Data.GetVertexLayout() && !AiMesh->HasBones())
+	{
+		MeshData Quantized = MeshQuantizer::Quantize(Data, Layout);
+
+		LOG_DEBUG(LogAsset, "Quantize mesh \"{}\": vertex size {} -> {} bytes, vertices data {} -> {} bytes",
+			Name,
+			Data.GetVertexSize(), Quantized.GetVertexSize(),
+			Data.GetVerticesDataSize(), Quantized.GetVerticesDataSize());
+
+#if _DEBUG
+		const auto Error = MeshQuantizer::MeasureError(Data, Quantized);
+		const auto Bounds = MeshQuantizer::GetErrorBounds(Data, Layout);
+		if (!Error.IsWithin(Bounds))
+		{
+			LOG_WARNING(LogAsset, "Quantized mesh \"{}\" exceeds the error bounds: position {} / {}, normal {} / {}, tangent {} / {}, uv0 {} / {}, uv1 {} / {}, color {} / {}",
+				Name,
+				Error.Position, Bounds.Position, Error.Normal, Bounds.Normal, Error.Tangent, Bounds.Tangent,
+				Error.UV0, Bounds.UV0, Error.UV1, Bounds.UV1, Error.Color, Bounds.Color);
+		}
+#endif
+
+		Data = std::move(Quantized);
 	}
+
+	if (AiMesh->HasBones())
+	{
+		auto Mesh = std::make_shared<SkinnedMesh>(Data, SceneSkeleton);
+		for (uint32_t BoneIndex = 0u; BoneIndex < AiMesh->mNumBones; ++BoneIndex)
+		{
+			const auto AiBone = AiMesh->mBones[BoneIndex];
+			const uint32_t SkeletonBone = SceneSkeleton->FindBone(AiBone->mName.C_Str());
+			if (SkeletonBone == ~0u)
+			{
+				LOG_ERROR(LogAsset, "The bone \"{}\" of skinned mesh \"{}\" has no node!", AiBone->mName.C_Str(), Name);
+				return nullptr;
+			}
+
+			Mesh->AddPaletteBone(SkeletonBone, ToMatrix(AiBone->mOffsetMatrix));
+		}
+		return Mesh;
+	}
+
+	return std::make_shared<StaticMesh>(Data);
 }
 
 void AssimpSceneLoader::ProcessTextures(const aiMaterial* AiMaterial, MaterialProperty& Material, const std::filesystem::path& RootPath)
 {
-	std::unordered_map<std::filesystem::path, std::shared_ptr<Texture>> Textures;
-
 	for (uint32_t Index = aiTextureType_DIFFUSE; Index < aiTextureType_TRANSMISSION; ++Index)
 	{
 		auto AiType = static_cast<aiTextureType>(Index);
@@ -486,16 +1042,7 @@ void AssimpSceneLoader::ProcessTextures(const aiMaterial* AiMaterial, MaterialPr
 		auto Type = GetTextureType(AiType);
 		if (Type != MaterialProperty::ETextureType::Num)
 		{
-			auto It = Textures.find(Path);
-			if (It == Textures.end())
-			{
-				Material.Textures[Type].reset(new Texture(Path));
-				Textures.emplace(Path, Material.Textures[Type]).first;
-			}
-			else
-			{
-				Material.Textures[Type] = It->second;
-			}
+			Material.SetTexture(Type, Path);
 		}
 	}
 }
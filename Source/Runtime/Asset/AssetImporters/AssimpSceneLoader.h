@@ -9,12 +9,14 @@ public:
 
 	bool Load(Asset& Target) override final;
 protected:
-	std::shared_ptr<Asset> CreateAsset(const std::filesystem::path& Path) override final;
+	std::shared_ptr<Asset> CreateAsset(const std::filesystem::path& Path, uint32_t Settings) override final;
 
-	void ProcessTransform(const struct aiNode* AiNode, class TransformComponent& TransformComp);
-	bool ProcessNode(const struct aiScene* AiScene, const struct aiNode* AiNode, const class Entity* Parent, struct AssimpScene& Model);
+	bool ProcessNodes(const struct aiScene* AiScene, struct AssimpScene& Model, std::vector<struct AssimpMeshInstance>& OutInstances, std::shared_ptr<class Skeleton>& OutSkeleton);
+	bool ProcessScene(const struct aiScene* AiScene, struct AssimpScene& Model);
 	void ProcessTextures(const struct aiMaterial* AiMaterial, struct MaterialProperty& Material, const std::filesystem::path& RootPath);
 
-	void ProcessMaterial(const struct aiScene* AiScene, const struct AssimpScene& Model, uint32_t MaterialIndex, class StaticMeshComponent& StaticMeshComp);
-	void ProcessMesh(const struct aiScene* AiScene, uint32_t MeshIndex, class StaticMeshComponent& StaticMeshComp);
+	std::shared_ptr<struct MaterialProperty> ProcessMaterial(const struct aiMaterial* AiMaterial, const struct AssimpScene& Model, const std::filesystem::path& Path);
+	std::shared_ptr<class StaticMesh> ProcessMesh(const struct aiScene* AiScene, uint32_t MeshIndex, const std::string& Name, const std::shared_ptr<class Skeleton>& SceneSkeleton, class BoxSphereBounds& OutBounds);
+
+	static std::filesystem::path GetMaterialPath(const struct aiMaterial* AiMaterial, const struct AssimpScene& Model);
 };
\ No newline at end of file
@@ -0,0 +1,587 @@
+#include "Asset/AssetLoaders/CookedScene.h"
+#include "Asset/MappedFile.h"
+#include "Asset/Material.h"
+#include "Scene/Scene.h"
+#include "Scene/Components/StaticMesh.h"
+#include "Scene/Components/TransformComponent.h"
+#include "Scene/Components/StaticMeshComponent.h"
+#include "Scene/Components/SkeletalMeshComponent.h"
+#include "Services/AssetDatabase.h"
+#include "Services/SpdLogService.h"
+
+/// On disk layout: header, source file table, entity table, mesh table, material table, string pool, then the mesh blobs.
+/// All offsets are relative to the start of their section, string references are offsets into the pool.
+static constexpr uint32_t CookedNullIndex = ~0u;
+
+/// The mapping is page aligned, blobs at this alignment are adopted as DataBlocks as they are.
+static constexpr size_t CookedBlobAlignment = DataBlock::DefaultAlignment;
+
+struct CookedHeader
+{
+	uint32_t Magic = 0u;
+	uint32_t Version = 0u;
+	uint64_t SettingsHash = 0u;
+	uint64_t SourceHash = 0u;
+	uint64_t FileSize = 0u;
+
+	uint32_t NumSourceFiles = 0u;
+	uint32_t NumEntities = 0u;
+	uint32_t NumMeshes = 0u;
+	uint32_t Root = CookedNullIndex;
+	uint32_t NumMaterials = 0u;
+	uint32_t Padding = 0u;
+
+	uint64_t SourceFilesOffset = 0u;
+	uint64_t EntitiesOffset = 0u;
+	uint64_t MeshesOffset = 0u;
+	uint64_t MaterialsOffset = 0u;
+	uint64_t StringsOffset = 0u;
+	uint64_t StringsSize = 0u;
+	uint64_t BlobsOffset = 0u;
+	uint64_t BlobsSize = 0u;
+};
+
+struct CookedSourceFile
+{
+	uint32_t Path = CookedNullIndex;
+	uint32_t Padding = 0u;
+	uint64_t Size = 0u;
+	int64_t LastWriteTime = 0;
+};
+
+struct CookedEntity
+{
+	enum EFlags : uint32_t
+	{
+		HasTransform = 1 << 0,
+		Visible = 1 << 1,
+	};
+
+	uint32_t Name = CookedNullIndex;
+	uint32_t Parent = CookedNullIndex;
+	uint32_t Child = CookedNullIndex;
+	uint32_t Sibling = CookedNullIndex;
+	uint32_t Flags = 0u;
+
+	uint32_t Mesh = CookedNullIndex;
+	uint32_t MeshName = CookedNullIndex;
+	uint32_t Material = CookedNullIndex; /// Index into the material table
+
+	float Translation[3u]{};
+	float Scale[3u]{};
+	float Rotation[4u]{};
+
+	float BoundsOrigin[3u]{};
+	float BoundsExtents[3u]{};
+	float BoundsSphereCenter[3u]{};
+	float BoundsRadius = 0.0f;
+};
+
+struct CookedMesh
+{
+	uint32_t NumVertex = 0u;
+	uint32_t NumIndex = 0u;
+	uint32_t NumPrimitive = 0u;
+	uint8_t Attributes = 0u;
+	uint8_t IndexFormat = 0u;
+	uint8_t PrimitiveTopology = 0u;
+	uint8_t Interleaved = 0u;
+
+	uint8_t PositionFormat = 0u;
+	uint8_t DirectionFormat = 0u;
+	uint8_t TexcoordFormat = 0u;
+	uint8_t ColorFormat = 0u;
+
+	float PositionScale[3u]{};
+	float PositionBias[3u]{};
+	uint32_t Padding = 0u;
+
+	uint64_t VerticesOffset = 0u;
+	uint64_t VerticesSize = 0u;
+	uint64_t IndicesOffset = 0u;
+	uint64_t IndicesSize = 0u;
+};
+
+/// Materials live in their own files, only the reference is cooked. Their textures are not saved with them, so the texture files
+/// the import resolved are cooked along, relative to the directory of the scene like the source files.
+struct CookedMaterial
+{
+	uint32_t Path = CookedNullIndex;
+	uint32_t Textures[static_cast<size_t>(MaterialProperty::ETextureType::Num)];
+};
+
+/// Source paths are relative to the directory of the scene, a copied or moved scene with its dependencies still matches.
+/// Combines the per file content hashes, which are cached for the process, so a reimport or reload does not read the files again.
+static bool ComputeSourceHash(const std::filesystem::path& BasePath, const std::vector<std::string>& SourceFiles, uint64_t& OutHash)
+{
+	OutHash = XXHash64(nullptr, 0u);
+
+	for (const auto& SourceFile : SourceFiles)
+	{
+		OutHash = XXHash64(SourceFile.data(), SourceFile.size(), OutHash);
+
+		const uint64_t ContentHash = File::GetCachedContentHash(BasePath / SourceFile);
+		if (ContentHash == 0u)
+		{
+			return false;
+		}
+		OutHash = XXHash64(&ContentHash, sizeof(ContentHash), OutHash);
+	}
+
+	return true;
+}
+
+static std::string GetSourcePath(const std::filesystem::path& BasePath, const std::filesystem::path& SourceFile)
+{
+	std::error_code ErrorCode;
+	auto RelativePath = std::filesystem::relative(SourceFile, BasePath, ErrorCode);
+	return (ErrorCode || RelativePath.empty() ? SourceFile : RelativePath).generic_string();
+}
+
+/// Bytes per index of a cooked index format, 0 for formats this build does not know.
+static uint32_t GetIndexSize(uint8_t IndexFormat)
+{
+	switch (static_cast<ERHIIndexFormat>(IndexFormat))
+	{
+	case ERHIIndexFormat::UInt16:
+		return sizeof(uint16_t);
+	case ERHIIndexFormat::UInt32:
+		return sizeof(uint32_t);
+	default:
+		return 0u;
+	}
+}
+
+static bool IsValidLayout(const CookedMesh& Mesh)
+{
+	return Mesh.PositionFormat <= static_cast<uint8_t>(EPositionFormat::SNorm16x4) &&
+		Mesh.DirectionFormat <= static_cast<uint8_t>(EDirectionFormat::Octahedral16) &&
+		Mesh.TexcoordFormat <= static_cast<uint8_t>(ETexcoordFormat::Half2) &&
+		Mesh.ColorFormat <= static_cast<uint8_t>(EColorFormat::UNorm8x4) &&
+		Mesh.Interleaved <= 1u;
+}
+
+static MeshProperty MakeMeshProperty(const CookedMesh& Mesh)
+{
+	auto Attributes = static_cast<EVertexAttributes>(Mesh.Attributes);
+	auto HasAttribute = [Attributes](EVertexAttributes Attribute) {
+		return (Attributes & Attribute) == Attribute;
+	};
+
+	VertexLayout Layout;
+	Layout.Position = static_cast<EPositionFormat>(Mesh.PositionFormat);
+	Layout.Direction = static_cast<EDirectionFormat>(Mesh.DirectionFormat);
+	Layout.Texcoord = static_cast<ETexcoordFormat>(Mesh.TexcoordFormat);
+	Layout.Color = static_cast<EColorFormat>(Mesh.ColorFormat);
+	Layout.Interleaved = Mesh.Interleaved != 0u;
+
+	MeshProperty Property(
+		Mesh.NumVertex,
+		Mesh.NumIndex,
+		Mesh.NumPrimitive,
+		HasAttribute(EVertexAttributes::Normal),
+		HasAttribute(EVertexAttributes::Tangent),
+		HasAttribute(EVertexAttributes::UV0),
+		HasAttribute(EVertexAttributes::UV1),
+		HasAttribute(EVertexAttributes::Color),
+		HasAttribute(EVertexAttributes::Skin),
+		static_cast<ERHIIndexFormat>(Mesh.IndexFormat),
+		static_cast<ERHIPrimitiveTopology>(Mesh.PrimitiveTopology),
+		Layout);
+	Property.SetPositionDequantization(
+		Math::Vector3(Mesh.PositionScale[0], Mesh.PositionScale[1], Mesh.PositionScale[2]),
+		Math::Vector3(Mesh.PositionBias[0], Mesh.PositionBias[1], Mesh.PositionBias[2]));
+
+	return Property;
+}
+
+DerivedDataKey CookedScene::GetKey(uint64_t SourceHash, uint64_t SettingsHash)
+{
+	return DerivedDataKey{ "Scene", Version, SourceHash, SettingsHash };
+}
+
+bool CookedScene::Save(AssimpScene& Model, const DerivedDataKey& Key, const std::vector<std::filesystem::path>& SourceFiles)
+{
+	CookedHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.SettingsHash = Key.SettingsHash;
+
+	const auto BasePath = Model.GetPath().parent_path();
+
+	std::vector<char> Strings;
+	auto AddString = [&Strings](std::string_view Value) {
+		const uint32_t Offset = static_cast<uint32_t>(Strings.size());
+		Strings.insert(Strings.end(), Value.begin(), Value.end());
+		Strings.push_back('\0');
+		return Offset;
+	};
+
+	std::vector<std::string> SourcePaths;
+	std::vector<CookedSourceFile> CookedSourceFiles;
+	for (const auto& SourceFile : SourceFiles)
+	{
+		auto& SourcePath = SourcePaths.emplace_back(GetSourcePath(BasePath, SourceFile));
+		auto& CookedSource = CookedSourceFiles.emplace_back();
+		CookedSource.Path = AddString(SourcePath);
+		CookedSource.Size = File::GetSize(SourceFile);
+		CookedSource.LastWriteTime = static_cast<int64_t>(File::GetLastWriteTime(SourceFile));
+	}
+
+	if (!ComputeSourceHash(BasePath, SourcePaths, Header.SourceHash))
+	{
+		return false;
+	}
+
+	std::vector<std::byte> Blobs;
+	auto AddBlob = [&Blobs](const DataBlock& Block) {
+		const size_t Offset = Align(Blobs.size(), CookedBlobAlignment);
+		Blobs.resize(Offset + Block.Size);
+		memcpy(Blobs.data() + Offset, Block.Data.get(), Block.Size);
+		return static_cast<uint64_t>(Offset);
+	};
+
+	std::vector<CookedEntity> Entities(Model.GetNumEntity());
+	std::vector<CookedMesh> Meshes;
+	std::unordered_map<const MeshData*, uint32_t> MeshIndices;
+	std::vector<CookedMaterial> Materials;
+	std::unordered_map<const MaterialProperty*, uint32_t> MaterialIndices;
+
+	for (uint32_t Index = 0u; Index < Model.GetNumEntity(); ++Index)
+	{
+		auto Node = Model.GetEntity(EntityID(Index));
+		if (!Node)
+		{
+			return false;
+		}
+
+		if (Node->GetComponent<SkeletalMeshComponent>())
+		{
+			/// Skeletons and skin palettes have no cooked representation yet, such scenes are always imported.
+			LOG_WARNING(LogAsset, "Skip cooking scene \"{}\" with skinned meshes, it is imported from the source on every load", Model.GetName());
+			return true;
+		}
+
+		auto& Cooked = Entities[Index];
+		Cooked.Name = AddString(Node->GetName().Get());
+		Cooked.Parent = Node->HasParent() ? Node->GetParent().GetIndex() : CookedNullIndex;
+		Cooked.Child = Node->HasChild() ? Node->GetChild().GetIndex() : CookedNullIndex;
+		Cooked.Sibling = Node->HasSibling() ? Node->GetSibling().GetIndex() : CookedNullIndex;
+		Cooked.Flags = Node->IsVisible() ? CookedEntity::Visible : 0u;
+
+		if (auto TransformComp = Node->GetComponent<TransformComponent>())
+		{
+			const auto Translation = TransformComp->GetTranslation();
+			const auto Scale = TransformComp->GetScalling();
+			const auto Rotation = TransformComp->GetRotation();
+
+			Cooked.Flags |= CookedEntity::HasTransform;
+			memcpy(Cooked.Translation, &Translation, sizeof(Cooked.Translation));
+			memcpy(Cooked.Scale, &Scale, sizeof(Cooked.Scale));
+			memcpy(Cooked.Rotation, &Rotation, sizeof(Cooked.Rotation));
+		}
+
+		auto StaticMeshComp = Node->GetComponent<StaticMeshComponent>();
+		if (StaticMeshComp && StaticMeshComp->HasMesh())
+		{
+			auto Data = StaticMeshComp->GetMesh().GetData();
+			if (!Data)
+			{
+				return false;
+			}
+
+			auto It = MeshIndices.find(Data);
+			if (It == MeshIndices.end())
+			{
+				auto& Mesh = Meshes.emplace_back();
+				Mesh.NumVertex = Data->GetNumVertex();
+				Mesh.NumIndex = Data->GetNumIndex();
+				Mesh.NumPrimitive = Data->GetNumPrimitive();
+				Mesh.Attributes = static_cast<uint8_t>(Data->GetVertexAttributes());
+				Mesh.IndexFormat = static_cast<uint8_t>(Data->GetIndexFormat());
+				Mesh.PrimitiveTopology = static_cast<uint8_t>(Data->GetPrimitiveTopology());
+				Mesh.Interleaved = Data->IsInterleaved() ? 1u : 0u;
+				Mesh.PositionFormat = static_cast<uint8_t>(Data->GetVertexLayout().Position);
+				Mesh.DirectionFormat = static_cast<uint8_t>(Data->GetVertexLayout().Direction);
+				Mesh.TexcoordFormat = static_cast<uint8_t>(Data->GetVertexLayout().Texcoord);
+				Mesh.ColorFormat = static_cast<uint8_t>(Data->GetVertexLayout().Color);
+				memcpy(Mesh.PositionScale, &Data->GetPositionScale(), sizeof(Mesh.PositionScale));
+				memcpy(Mesh.PositionBias, &Data->GetPositionBias(), sizeof(Mesh.PositionBias));
+				Mesh.VerticesOffset = AddBlob(Data->VerticesData);
+				Mesh.VerticesSize = Data->VerticesData.Size;
+				Mesh.IndicesOffset = AddBlob(Data->IndicesData);
+				Mesh.IndicesSize = Data->IndicesData.Size;
+
+				It = MeshIndices.emplace(Data, static_cast<uint32_t>(Meshes.size() - 1u)).first;
+			}
+
+			const auto& Bounds = StaticMeshComp->GetLocalBounds();
+			Cooked.Mesh = It->second;
+			Cooked.MeshName = AddString(StaticMeshComp->GetName().Get());
+			Cooked.BoundsRadius = Bounds.GetSphere().GetRadius();
+			memcpy(Cooked.BoundsOrigin, &Bounds.GetOrigin(), sizeof(Cooked.BoundsOrigin));
+			memcpy(Cooked.BoundsExtents, &Bounds.GetExtents(), sizeof(Cooked.BoundsExtents));
+			memcpy(Cooked.BoundsSphereCenter, &Bounds.GetSphere().GetCenter(), sizeof(Cooked.BoundsSphereCenter));
+
+			if (StaticMeshComp->HasMaterialProperty())
+			{
+				const auto& Property = StaticMeshComp->GetMaterialProperty();
+
+				auto MaterialIt = MaterialIndices.find(&Property);
+				if (MaterialIt == MaterialIndices.end())
+				{
+					auto& Material = Materials.emplace_back();
+					Material.Path = AddString(GetSourcePath(BasePath, Property.GetPath()));
+					for (size_t Type = 0u; Type < Property.TexturePaths.size(); ++Type)
+					{
+						Material.Textures[Type] = Property.TexturePaths[Type].empty() ? CookedNullIndex : AddString(GetSourcePath(BasePath, Property.TexturePaths[Type]));
+					}
+
+					MaterialIt = MaterialIndices.emplace(&Property, static_cast<uint32_t>(Materials.size() - 1u)).first;
+				}
+
+				Cooked.Material = MaterialIt->second;
+			}
+		}
+	}
+
+	Header.NumSourceFiles = static_cast<uint32_t>(CookedSourceFiles.size());
+	Header.NumEntities = static_cast<uint32_t>(Entities.size());
+	Header.NumMeshes = static_cast<uint32_t>(Meshes.size());
+	Header.NumMaterials = static_cast<uint32_t>(Materials.size());
+	Header.Root = Model.GetRoot() ? Model.GetRoot()->GetID().GetIndex() : CookedNullIndex;
+
+	Header.SourceFilesOffset = sizeof(CookedHeader);
+	Header.EntitiesOffset = Header.SourceFilesOffset + sizeof(CookedSourceFile) * CookedSourceFiles.size();
+	Header.MeshesOffset = Header.EntitiesOffset + sizeof(CookedEntity) * Entities.size();
+	Header.MaterialsOffset = Header.MeshesOffset + sizeof(CookedMesh) * Meshes.size();
+	Header.StringsOffset = Header.MaterialsOffset + sizeof(CookedMaterial) * Materials.size();
+	Header.StringsSize = Strings.size();
+	Header.BlobsOffset = Align<uint64_t>(Header.StringsOffset + Header.StringsSize, CookedBlobAlignment);
+	Header.BlobsSize = Blobs.size();
+	Header.FileSize = Header.BlobsOffset + Header.BlobsSize;
+
+	return DerivedDataCache::Get().Store(Key, [&](std::ostream& Stream) {
+		const char Zeros[CookedBlobAlignment]{};
+
+		Stream.write(reinterpret_cast<const char*>(&Header), sizeof(CookedHeader));
+		Stream.write(reinterpret_cast<const char*>(CookedSourceFiles.data()), sizeof(CookedSourceFile) * CookedSourceFiles.size());
+		Stream.write(reinterpret_cast<const char*>(Entities.data()), sizeof(CookedEntity) * Entities.size());
+		Stream.write(reinterpret_cast<const char*>(Meshes.data()), sizeof(CookedMesh) * Meshes.size());
+		Stream.write(reinterpret_cast<const char*>(Materials.data()), sizeof(CookedMaterial) * Materials.size());
+		Stream.write(Strings.data(), Strings.size());
+		Stream.write(Zeros, Header.BlobsOffset - Header.StringsOffset - Header.StringsSize);
+		Stream.write(reinterpret_cast<const char*>(Blobs.data()), Blobs.size());
+		return true;
+	});
+}
+
+bool CookedScene::Load(AssimpScene& Model, const DerivedDataKey& Key)
+{
+	if (!Model.IsEmpty())
+	{
+		return false;
+	}
+
+	auto Mapped = DerivedDataCache::Get().Load(Key);
+	if (!Mapped || Mapped->GetSize() < sizeof(CookedHeader))
+	{
+		return false;
+	}
+
+	const std::byte* Base = Mapped->GetData();
+	const auto& Header = *reinterpret_cast<const CookedHeader*>(Base);
+
+	if (Header.Magic != Magic || Header.Version != Version || Header.SettingsHash != Key.SettingsHash || Header.FileSize != Mapped->GetSize())
+	{
+		return false;
+	}
+
+	auto IsInRange = [&Mapped](uint64_t Offset, uint64_t Size) {
+		return Offset <= Mapped->GetSize() && Size <= Mapped->GetSize() - Offset;
+	};
+
+	if (!IsInRange(Header.SourceFilesOffset, sizeof(CookedSourceFile) * static_cast<uint64_t>(Header.NumSourceFiles)) ||
+		!IsInRange(Header.EntitiesOffset, sizeof(CookedEntity) * static_cast<uint64_t>(Header.NumEntities)) ||
+		!IsInRange(Header.MeshesOffset, sizeof(CookedMesh) * static_cast<uint64_t>(Header.NumMeshes)) ||
+		!IsInRange(Header.MaterialsOffset, sizeof(CookedMaterial) * static_cast<uint64_t>(Header.NumMaterials)) ||
+		!IsInRange(Header.StringsOffset, Header.StringsSize) ||
+		!IsInRange(Header.BlobsOffset, Header.BlobsSize) ||
+		Header.StringsSize == 0u ||
+		Header.BlobsOffset % CookedBlobAlignment != 0u)
+	{
+		return false;
+	}
+
+	auto SourceFiles = reinterpret_cast<const CookedSourceFile*>(Base + Header.SourceFilesOffset);
+	auto Entities = reinterpret_cast<const CookedEntity*>(Base + Header.EntitiesOffset);
+	auto Meshes = reinterpret_cast<const CookedMesh*>(Base + Header.MeshesOffset);
+	auto CookedMaterials = reinterpret_cast<const CookedMaterial*>(Base + Header.MaterialsOffset);
+	auto Strings = reinterpret_cast<const char*>(Base + Header.StringsOffset);
+
+	if (Strings[Header.StringsSize - 1u] != '\0')
+	{
+		return false;
+	}
+
+	auto GetString = [&Header, Strings](uint32_t Offset) {
+		return Offset < Header.StringsSize ? std::string_view(Strings + Offset) : std::string_view();
+	};
+
+	/// The key covers the main file only, the other files the import read are checked here. A changed size fails right away,
+	/// the content is only hashed if a last write time changed too, e.g. a checkout touching files without changing them.
+	const auto BasePath = Model.GetPath().parent_path();
+	std::vector<std::string> SourcePaths(Header.NumSourceFiles);
+	bool Touched = false;
+	for (uint32_t Index = 0u; Index < Header.NumSourceFiles; ++Index)
+	{
+		SourcePaths[Index] = GetString(SourceFiles[Index].Path);
+		const auto SourcePath = BasePath / SourcePaths[Index];
+		if (!std::filesystem::exists(SourcePath) || File::GetSize(SourcePath) != SourceFiles[Index].Size)
+		{
+			return false;
+		}
+
+		Touched |= static_cast<int64_t>(File::GetLastWriteTime(SourcePath)) != SourceFiles[Index].LastWriteTime;
+	}
+
+	uint64_t SourceHash = 0u;
+	if (Touched && (!ComputeSourceHash(BasePath, SourcePaths, SourceHash) || SourceHash != Header.SourceHash))
+	{
+		return false;
+	}
+
+	for (uint32_t Index = 0u; Index < Header.NumMeshes; ++Index)
+	{
+		const auto& Mesh = Meshes[Index];
+		if (!IsValidLayout(Mesh))
+		{
+			return false;
+		}
+
+		const auto Property = MakeMeshProperty(Mesh);
+
+		const uint32_t IndexSize = GetIndexSize(Mesh.IndexFormat);
+		if (IndexSize == 0u ||
+			Mesh.VerticesSize != Property.GetVerticesDataSize() ||
+			Mesh.IndicesSize != static_cast<uint64_t>(Mesh.NumIndex) * IndexSize ||
+			Mesh.VerticesOffset % CookedBlobAlignment != 0u ||
+			Mesh.IndicesOffset % CookedBlobAlignment != 0u ||
+			!IsInRange(Header.BlobsOffset + Mesh.VerticesOffset, Mesh.VerticesSize) ||
+			!IsInRange(Header.BlobsOffset + Mesh.IndicesOffset, Mesh.IndicesSize))
+		{
+			return false;
+		}
+	}
+
+	for (uint32_t Index = 0u; Index < Header.NumMaterials; ++Index)
+	{
+		if (!std::filesystem::exists(GetString(CookedMaterials[Index].Path)))
+		{
+			return false;
+		}
+	}
+
+	for (uint32_t Index = 0u; Index < Header.NumEntities; ++Index)
+	{
+		const auto& Cooked = Entities[Index];
+		if ((Cooked.Parent != CookedNullIndex && Cooked.Parent >= Header.NumEntities) ||
+			(Cooked.Child != CookedNullIndex && Cooked.Child >= Header.NumEntities) ||
+			(Cooked.Sibling != CookedNullIndex && Cooked.Sibling >= Header.NumEntities) ||
+			(Cooked.Mesh != CookedNullIndex && Cooked.Mesh >= Header.NumMeshes) ||
+			(Cooked.Material != CookedNullIndex && Cooked.Material >= Header.NumMaterials))
+		{
+			return false;
+		}
+	}
+
+	/// Everything is validated, from here on the model is built and loading can not fail anymore.
+	std::vector<std::shared_ptr<StaticMesh>> StaticMeshes(Header.NumMeshes);
+	for (uint32_t Index = 0u; Index < Header.NumMeshes; ++Index)
+	{
+		const auto& Mesh = Meshes[Index];
+
+		DataBlock Vertices(Mapped->GetSharedData(Mapped, Header.BlobsOffset + Mesh.VerticesOffset), Mesh.VerticesSize);
+		DataBlock Indices(Mapped->GetSharedData(Mapped, Header.BlobsOffset + Mesh.IndicesOffset), Mesh.IndicesSize);
+
+		StaticMeshes[Index] = std::make_shared<StaticMesh>(MeshData(MakeMeshProperty(Mesh), std::move(Vertices), std::move(Indices)));
+	}
+
+	std::vector<std::shared_ptr<MaterialProperty>> Materials(Header.NumMaterials);
+
+	for (uint32_t Index = 0u; Index < Header.NumEntities; ++Index)
+	{
+		const auto& Cooked = Entities[Index];
+
+		auto& Node = Model.AddEntity(Cooked.Parent != CookedNullIndex ? EntityID(Cooked.Parent) : EntityID(), std::string(GetString(Cooked.Name)));
+		Node.SetVisible((Cooked.Flags & CookedEntity::Visible) != 0u);
+		if (Cooked.Child != CookedNullIndex)
+		{
+			Node.SetChild(EntityID(Cooked.Child));
+		}
+		if (Cooked.Sibling != CookedNullIndex)
+		{
+			Node.SetSibling(EntityID(Cooked.Sibling));
+		}
+
+		std::shared_ptr<TransformComponent> TransformComp;
+		if (Cooked.Flags & CookedEntity::HasTransform)
+		{
+			TransformComp = Node.AddComponent<TransformComponent>();
+			TransformComp->SetTranslation(Cooked.Translation[0], Cooked.Translation[1], Cooked.Translation[2])
+				.SetScale(Cooked.Scale[0], Cooked.Scale[1], Cooked.Scale[2])
+				.SetRotation(Cooked.Rotation[0], Cooked.Rotation[1], Cooked.Rotation[2], Cooked.Rotation[3]);
+		}
+
+		if (Cooked.Mesh != CookedNullIndex)
+		{
+			auto StaticMeshComp = Node.AddComponent<StaticMeshComponent>();
+			StaticMeshComp->SetName(std::string(GetString(Cooked.MeshName)));
+			if (TransformComp)
+			{
+				StaticMeshComp->SetWorldTransform(TransformComp->GetMatrix());
+			}
+			StaticMeshComp->SetLocalBounds(BoxSphereBounds(
+				Math::Vector3(Cooked.BoundsOrigin[0], Cooked.BoundsOrigin[1], Cooked.BoundsOrigin[2]),
+				Math::Vector3(Cooked.BoundsExtents[0], Cooked.BoundsExtents[1], Cooked.BoundsExtents[2]),
+				Math::Vector3(Cooked.BoundsSphereCenter[0], Cooked.BoundsSphereCenter[1], Cooked.BoundsSphereCenter[2]),
+				Cooked.BoundsRadius));
+			StaticMeshComp->SetMesh(StaticMeshes[Cooked.Mesh]);
+
+			if (Cooked.Material != CookedNullIndex)
+			{
+				auto& Material = Materials[Cooked.Material];
+				if (!Material)
+				{
+					const auto& CookedMaterial = CookedMaterials[Cooked.Material];
+
+					Material = MaterialProperty::Load(BasePath / GetString(CookedMaterial.Path));
+					AssetDatabase::Get().AddDependency(Model.GetPath(), Material->GetPath());
+
+					/// Same as the import, the texture edges keep hot reload working for scenes loaded from the cache.
+					for (size_t Type = 0u; Type < Material->Textures.size(); ++Type)
+					{
+						if (CookedMaterial.Textures[Type] == CookedNullIndex)
+						{
+							continue;
+						}
+
+						const auto TexturePath = BasePath / GetString(CookedMaterial.Textures[Type]);
+						if (std::filesystem::exists(TexturePath))
+						{
+							Material->SetTexture(static_cast<MaterialProperty::ETextureType>(Type), TexturePath);
+						}
+					}
+				}
+				StaticMeshComp->SetMaterialProperty(Material);
+			}
+		}
+	}
+
+	if (Header.Root != CookedNullIndex && Header.Root < Header.NumEntities)
+	{
+		Model.SetRoot(EntityID(Header.Root));
+	}
+
+	return true;
+}
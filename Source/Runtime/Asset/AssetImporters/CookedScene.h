@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Asset/Asset.h"
+#include "Asset/DerivedDataCache.h"
+
+/// Binary snapshot of an imported scene: entity hierarchy, transforms, material references and ready to use MeshData blocks.
+/// Lives in the derived data cache keyed by the content hash of the main scene file plus a hash of the import settings, the content hash
+/// of every other file the importer read is validated on load. Loading memory maps the entry and hands out views into the mapping,
+/// so mesh data is only paged in when first touched.
+class CookedScene
+{
+public:
+	static constexpr uint32_t Magic = 0x534B4352u; /// "RCKS"
+	static constexpr uint32_t Version = 8u;
+
+	/// SourceHash is the XXHash64 of the main scene file content.
+	static DerivedDataKey GetKey(uint64_t SourceHash, uint64_t SettingsHash);
+
+	/// SourceFiles are all files the import read, the main file included.
+	static bool Save(struct AssimpScene& Model, const DerivedDataKey& Key, const std::vector<std::filesystem::path>& SourceFiles);
+
+	/// Fails without touching Model if there is no valid entry for Key or any source file changed.
+	static bool Load(struct AssimpScene& Model, const DerivedDataKey& Key);
+};
@@ -0,0 +1,106 @@
+#include "Asset/AssetLoaders/CookedTexture.h"
+
+/// Mip data is aligned for block copies, the header pads up to it.
+static constexpr size_t CookedMipDataAlignment = 256u;
+
+struct CookedTextureHeader
+{
+	uint32_t Magic = 0u;
+	uint32_t Version = 0u;
+	uint64_t SettingsHash = 0u;
+	uint64_t SourceHash = 0u;
+	uint64_t FileSize = 0u;
+
+	uint32_t Width = 0u;
+	uint32_t Height = 0u;
+	uint32_t NumMips = 0u;
+	uint32_t Format = 0u;
+
+	uint64_t DataOffset = 0u;
+	uint64_t DataSize = 0u;
+};
+
+static size_t GetMipChainSize(uint32_t Width, uint32_t Height, uint32_t NumMips, ERHIFormat Format)
+{
+	size_t Size = 0u;
+	for (uint32_t Mip = 0u; Mip < NumMips; ++Mip)
+	{
+		Size += RHI::GetFormatAttributes(std::max(Width >> Mip, 1u), std::max(Height >> Mip, 1u), Format).SlicePitch;
+	}
+	return Size;
+}
+
+DerivedDataKey CookedTexture::GetKey(uint64_t SourceHash, uint64_t SettingsHash)
+{
+	return DerivedDataKey{ "Texture", Version, SourceHash, SettingsHash };
+}
+
+size_t CookedTexture::Save(const RHITextureDesc& Desc, const DerivedDataKey& Key)
+{
+	if (!Desc.BulkData || Desc.BulkData->GetSize() != GetMipChainSize(Desc.Width, Desc.Height, Desc.NumMipLevel, Desc.Format))
+	{
+		return 0u;
+	}
+
+	CookedTextureHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.SettingsHash = Key.SettingsHash;
+	Header.SourceHash = Key.ContentHash;
+	Header.Width = Desc.Width;
+	Header.Height = Desc.Height;
+	Header.NumMips = Desc.NumMipLevel;
+	Header.Format = static_cast<uint32_t>(Desc.Format);
+	Header.DataOffset = Align<uint64_t>(sizeof(CookedTextureHeader), CookedMipDataAlignment);
+	Header.DataSize = Desc.BulkData->GetSize();
+	Header.FileSize = Header.DataOffset + Header.DataSize;
+
+	const bool Stored = DerivedDataCache::Get().Store(Key, [&Header, &Desc](std::ostream& Stream) {
+		const char Zeros[CookedMipDataAlignment]{};
+
+		Stream.write(reinterpret_cast<const char*>(&Header), sizeof(CookedTextureHeader));
+		Stream.write(Zeros, Header.DataOffset - sizeof(CookedTextureHeader));
+		Stream.write(reinterpret_cast<const char*>(Desc.BulkData->GetRawData()), Header.DataSize);
+		return true;
+	});
+
+	return Stored ? Header.DataOffset : 0u;
+}
+
+bool CookedTexture::Load(RHITextureDesc& Desc, const DerivedDataKey& Key, size_t& OutDataOffset)
+{
+	auto Mapped = DerivedDataCache::Get().Load(Key);
+	if (!Mapped || Mapped->GetSize() < sizeof(CookedTextureHeader))
+	{
+		return false;
+	}
+
+	const auto& Header = *reinterpret_cast<const CookedTextureHeader*>(Mapped->GetData());
+
+	if (Header.Magic != Magic ||
+		Header.Version != Version ||
+		Header.SettingsHash != Key.SettingsHash ||
+		Header.SourceHash != Key.ContentHash ||
+		Header.FileSize != Mapped->GetSize() ||
+		Header.Width == 0u || Header.Height == 0u || Header.NumMips == 0u || Header.NumMips > 32u ||
+		Header.Format == static_cast<uint32_t>(ERHIFormat::Unknown) ||
+		Header.Format >= magic_enum::enum_count<ERHIFormat>() ||
+		Header.DataOffset < sizeof(CookedTextureHeader) ||
+		Header.DataOffset > Mapped->GetSize() ||
+		Header.DataSize != Mapped->GetSize() - Header.DataOffset ||
+		Header.DataSize != GetMipChainSize(Header.Width, Header.Height, Header.NumMips, static_cast<ERHIFormat>(Header.Format)))
+	{
+		return false;
+	}
+
+	auto MipData = std::make_shared<DataBlock>(Mapped->GetSharedData(Mapped, Header.DataOffset), Header.DataSize);
+
+	Desc.SetWidth(Header.Width)
+		.SetHeight(Header.Height)
+		.SetNumMipLevel(Header.NumMips)
+		.SetFormat(static_cast<ERHIFormat>(Header.Format))
+		.SetBulkData(std::move(MipData));
+	OutDataOffset = Header.DataOffset;
+
+	return true;
+}
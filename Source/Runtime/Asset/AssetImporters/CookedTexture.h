@@ -0,0 +1,25 @@
+#pragma once
+
+#include "RHI/RHITexture.h"
+#include "Asset/DerivedDataCache.h"
+
+/// Processed mip chain of an imported image, ready to upload. Lives in the derived data cache keyed by the content hash of the source
+/// image and a hash of the processing settings, loading memory maps it and the bulk data points into the mapping. The mip data is also
+/// where streamed mips are read from, so it starts at a fixed offset and holds the mips back to back, mip 0 first.
+class CookedTexture
+{
+public:
+	static constexpr uint32_t Magic = 0x544B4352u; /// "RCKT"
+	static constexpr uint32_t Version = 2u;
+
+	/// SourceHash is the XXHash64 of the source image content.
+	static DerivedDataKey GetKey(uint64_t SourceHash, uint64_t SettingsHash);
+
+	/// Desc holds the processed size, format, mip count and bulk data.
+	/// Returns the offset of the mip data in the file, 0 on failure.
+	static size_t Save(const RHITextureDesc& Desc, const DerivedDataKey& Key);
+
+	/// Fails without touching Desc if there is no valid entry for Key.
+	/// On success OutDataOffset receives the offset of the mip data in the file.
+	static bool Load(RHITextureDesc& Desc, const DerivedDataKey& Key, size_t& OutDataOffset);
+};
@@ -0,0 +1,498 @@
+#include "Asset/AssetLoaders/MeshOptimizer.h"
+
+struct VertexStream
+{
+	size_t Offset = 0u;
+	size_t Stride = 0u;
+	size_t Size = 0u;
+};
+
+static std::vector<VertexStream> GetVertexStreams(const MeshData& Data)
+{
+	std::vector<VertexStream> Streams;
+
+	for (uint32_t Index = 0u; Index < static_cast<uint32_t>(EVertexElement::Num); ++Index)
+	{
+		const EVertexElement Element = static_cast<EVertexElement>(Index);
+		if (Data.HasElement(Element))
+		{
+			Streams.push_back(VertexStream{ Data.GetElementOffset(Element), Data.GetElementStride(Element), Data.GetElementSize(Element) });
+		}
+	}
+
+	return Streams;
+}
+
+static std::vector<uint32_t> GetIndices(const MeshData& Data)
+{
+	std::vector<uint32_t> Indices(Data.GetNumIndex());
+
+	if (Data.GetIndexFormat() == ERHIIndexFormat::UInt16)
+	{
+		auto Source = reinterpret_cast<const uint16_t*>(Data.IndicesData.Data.get());
+		std::copy(Source, Source + Indices.size(), Indices.begin());
+	}
+	else
+	{
+		auto Source = reinterpret_cast<const uint32_t*>(Data.IndicesData.Data.get());
+		std::copy(Source, Source + Indices.size(), Indices.begin());
+	}
+
+	return Indices;
+}
+
+/// FIFO cache where a vertex is resident while fewer than CacheSize misses happened since it was loaded.
+class VertexCacheSimulator
+{
+public:
+	VertexCacheSimulator(size_t NumVertex, uint32_t CacheSize)
+		: m_Timestamps(NumVertex, 0u)
+		, m_CacheSize(CacheSize)
+		, m_Timestamp(CacheSize + 1u)
+	{
+	}
+
+	inline bool Access(uint32_t Index)
+	{
+		if (m_Timestamp - m_Timestamps[Index] > m_CacheSize)
+		{
+			m_Timestamps[Index] = m_Timestamp++;
+			return true;
+		}
+		return false;
+	}
+
+	inline uint32_t GetAge(uint32_t Index) const { return m_Timestamp - m_Timestamps[Index]; }
+private:
+	std::vector<uint32_t> m_Timestamps;
+	uint32_t m_CacheSize;
+	uint32_t m_Timestamp;
+};
+
+VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const uint32_t* Indices, size_t NumIndex, size_t NumVertex, uint32_t CacheSize)
+{
+	VertexCacheStatistics Statistics;
+	if (NumIndex < 3u || NumVertex == 0u)
+	{
+		return Statistics;
+	}
+
+	VertexCacheSimulator Cache(NumVertex, CacheSize);
+	std::vector<bool> Referenced(NumVertex, false);
+	size_t NumReferenced = 0u;
+
+	for (size_t Index = 0u; Index < NumIndex; ++Index)
+	{
+		const uint32_t Vertex = Indices[Index];
+		assert(Vertex < NumVertex);
+
+		if (Cache.Access(Vertex))
+		{
+			++Statistics.NumTransformedVertex;
+		}
+
+		if (!Referenced[Vertex])
+		{
+			Referenced[Vertex] = true;
+			++NumReferenced;
+		}
+	}
+
+	Statistics.ACMR = static_cast<float>(Statistics.NumTransformedVertex) / static_cast<float>(NumIndex / 3u);
+	Statistics.ATVR = static_cast<float>(Statistics.NumTransformedVertex) / static_cast<float>(NumReferenced);
+	return Statistics;
+}
+
+size_t MeshOptimizer::GenerateWeldRemap(const MeshData& Data, uint32_t* Remap)
+{
+	const auto Streams = GetVertexStreams(Data);
+	const std::byte* Vertices = Data.VerticesData.Data.get();
+
+	auto HashVertex = [&Streams, Vertices](uint32_t Index) {
+		uint64_t Hash = FnvHash(nullptr, 0u);
+		for (const auto& Stream : Streams)
+		{
+			Hash = FnvHash(Vertices + Stream.Offset + Index * Stream.Stride, Stream.Size, Hash);
+		}
+		return Hash;
+	};
+
+	auto IsIdentical = [&Streams, Vertices](uint32_t Left, uint32_t Right) {
+		for (const auto& Stream : Streams)
+		{
+			if (memcmp(Vertices + Stream.Offset + Left * Stream.Stride, Vertices + Stream.Offset + Right * Stream.Stride, Stream.Size) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	/// A hash collision between different vertices just keeps both, welding stays exact.
+	std::unordered_map<uint64_t, uint32_t> FirstVertices;
+	FirstVertices.reserve(Data.GetNumVertex());
+
+	size_t NumUnique = 0u;
+	for (uint32_t Index = 0u; Index < Data.GetNumVertex(); ++Index)
+	{
+		auto [It, Inserted] = FirstVertices.try_emplace(HashVertex(Index), Index);
+		if (Inserted || !IsIdentical(It->second, Index))
+		{
+			Remap[Index] = Index;
+			++NumUnique;
+		}
+		else
+		{
+			Remap[Index] = It->second;
+		}
+	}
+
+	return NumUnique;
+}
+
+void MeshOptimizer::OptimizeVertexCache(uint32_t* Indices, size_t NumIndex, size_t NumVertex, uint32_t CacheSize)
+{
+	assert(NumIndex % 3u == 0u);
+
+	const size_t NumTriangle = NumIndex / 3u;
+	if (NumTriangle < 2u)
+	{
+		return;
+	}
+
+	/// Vertex -> triangle adjacency, LiveTriangles counts the triangles of a vertex not emitted yet.
+	std::vector<uint32_t> LiveTriangles(NumVertex, 0u);
+	for (size_t Index = 0u; Index < NumIndex; ++Index)
+	{
+		++LiveTriangles[Indices[Index]];
+	}
+
+	std::vector<uint32_t> Offsets(NumVertex + 1u, 0u);
+	for (size_t Vertex = 0u; Vertex < NumVertex; ++Vertex)
+	{
+		Offsets[Vertex + 1u] = Offsets[Vertex] + LiveTriangles[Vertex];
+	}
+
+	std::vector<uint32_t> Adjacency(NumIndex);
+	{
+		std::vector<uint32_t> Cursors(Offsets.begin(), Offsets.end() - 1);
+		for (size_t Index = 0u; Index < NumIndex; ++Index)
+		{
+			Adjacency[Cursors[Indices[Index]]++] = static_cast<uint32_t>(Index / 3u);
+		}
+	}
+
+	VertexCacheSimulator Cache(NumVertex, CacheSize);
+	std::vector<bool> Emitted(NumTriangle, false);
+	std::vector<uint32_t> DeadEnds;
+	std::vector<uint32_t> Candidates;
+	std::vector<uint32_t> Output;
+
+	DeadEnds.reserve(NumIndex);
+	Output.reserve(NumIndex);
+
+	size_t ScanCursor = 0u;
+
+	/// Falls back to recently used vertices first, then to the next vertex in input order that still has triangles.
+	auto SkipDeadEnd = [&]() -> uint32_t {
+		while (!DeadEnds.empty())
+		{
+			const uint32_t Vertex = DeadEnds.back();
+			DeadEnds.pop_back();
+			if (LiveTriangles[Vertex] > 0u)
+			{
+				return Vertex;
+			}
+		}
+
+		for (; ScanCursor < NumVertex; ++ScanCursor)
+		{
+			if (LiveTriangles[ScanCursor] > 0u)
+			{
+				return static_cast<uint32_t>(ScanCursor);
+			}
+		}
+
+		return ~0u;
+	};
+
+	uint32_t Fanning = SkipDeadEnd();
+	while (Fanning != ~0u)
+	{
+		Candidates.clear();
+
+		for (uint32_t Slot = Offsets[Fanning]; Slot < Offsets[Fanning + 1u]; ++Slot)
+		{
+			const uint32_t Triangle = Adjacency[Slot];
+			if (Emitted[Triangle])
+			{
+				continue;
+			}
+
+			for (uint32_t Corner = 0u; Corner < 3u; ++Corner)
+			{
+				const uint32_t Vertex = Indices[Triangle * 3u + Corner];
+				Output.push_back(Vertex);
+				DeadEnds.push_back(Vertex);
+				Candidates.push_back(Vertex);
+				--LiveTriangles[Vertex];
+				Cache.Access(Vertex);
+			}
+
+			Emitted[Triangle] = true;
+		}
+
+		/// Prefer the oldest candidate that is still guaranteed to be in the cache once all its remaining triangles are emitted.
+		uint32_t Next = ~0u;
+		int64_t BestPriority = -1;
+		for (const uint32_t Vertex : Candidates)
+		{
+			if (LiveTriangles[Vertex] == 0u)
+			{
+				continue;
+			}
+
+			int64_t Priority = 0;
+			const int64_t Age = Cache.GetAge(Vertex);
+			if (Age + 2 * static_cast<int64_t>(LiveTriangles[Vertex]) <= static_cast<int64_t>(CacheSize))
+			{
+				Priority = Age;
+			}
+
+			if (Priority > BestPriority)
+			{
+				BestPriority = Priority;
+				Next = Vertex;
+			}
+		}
+
+		Fanning = Next != ~0u ? Next : SkipDeadEnd();
+	}
+
+	assert(Output.size() == NumIndex);
+	std::copy(Output.begin(), Output.end(), Indices);
+}
+
+void MeshOptimizer::OptimizeOverdraw(uint32_t* Indices, size_t NumIndex, const Math::Vector3* Positions, size_t NumVertex, uint32_t CacheSize, float Threshold)
+{
+	assert(NumIndex % 3u == 0u);
+
+	const size_t NumTriangle = NumIndex / 3u;
+	if (NumTriangle < 2u)
+	{
+		return;
+	}
+
+	const float MeshACMR = AnalyzeVertexCache(Indices, NumIndex, NumVertex, CacheSize).ACMR;
+
+	/// Hard boundaries are where all three vertices miss, the cache was effectively flushed and moving the cluster costs nothing.
+	/// Inside a hard cluster a soft boundary is placed once the running ACMR is within Threshold of the whole mesh, clusters shorter
+	/// than the cache are never split since refilling the cache after the move would dominate.
+	std::vector<uint32_t> ClusterStarts;
+	{
+		VertexCacheSimulator Cache(NumVertex, CacheSize);
+		uint32_t ClusterMisses = 0u;
+		uint32_t ClusterTriangles = 0u;
+
+		for (uint32_t Triangle = 0u; Triangle < NumTriangle; ++Triangle)
+		{
+			uint32_t Misses = 0u;
+			for (uint32_t Corner = 0u; Corner < 3u; ++Corner)
+			{
+				Misses += Cache.Access(Indices[Triangle * 3u + Corner]) ? 1u : 0u;
+			}
+
+			const bool HardBoundary = Triangle == 0u || Misses == 3u;
+			const bool SoftBoundary = ClusterTriangles >= CacheSize && static_cast<float>(ClusterMisses) <= Threshold * MeshACMR * static_cast<float>(ClusterTriangles);
+			if (HardBoundary || SoftBoundary)
+			{
+				ClusterStarts.push_back(Triangle);
+				ClusterMisses = 0u;
+				ClusterTriangles = 0u;
+			}
+
+			ClusterMisses += Misses;
+			++ClusterTriangles;
+		}
+	}
+
+	if (ClusterStarts.size() < 2u)
+	{
+		return;
+	}
+
+	struct Cluster
+	{
+		uint32_t First = 0u;
+		uint32_t Count = 0u;
+		float SortKey = 0.0f;
+	};
+
+	auto GetTriangle = [Indices, Positions](uint32_t Triangle, Math::Vector3& OutCentroid, Math::Vector3& OutNormal) {
+		const auto& P0 = Positions[Indices[Triangle * 3u + 0u]];
+		const auto& P1 = Positions[Indices[Triangle * 3u + 1u]];
+		const auto& P2 = Positions[Indices[Triangle * 3u + 2u]];
+
+		/// Unnormalized, its length is twice the area, which area weights the sums below.
+		OutNormal = Math::Cross(P1 - P0, P2 - P0);
+		OutCentroid = (P0 + P1 + P2) * (1.0f / 3.0f);
+	};
+
+	Math::Vector3 MeshCentroid(0.0f);
+	float MeshArea = 0.0f;
+	for (uint32_t Triangle = 0u; Triangle < NumTriangle; ++Triangle)
+	{
+		Math::Vector3 Centroid, Normal;
+		GetTriangle(Triangle, Centroid, Normal);
+
+		const float Area = std::sqrt(Math::Dot(Normal, Normal));
+		MeshCentroid = MeshCentroid + Centroid * Area;
+		MeshArea += Area;
+	}
+	MeshCentroid = MeshArea > 0.0f ? MeshCentroid * (1.0f / MeshArea) : MeshCentroid;
+
+	std::vector<Cluster> Clusters(ClusterStarts.size());
+	for (size_t Index = 0u; Index < Clusters.size(); ++Index)
+	{
+		auto& Target = Clusters[Index];
+		Target.First = ClusterStarts[Index];
+		Target.Count = (Index + 1u < ClusterStarts.size() ? ClusterStarts[Index + 1u] : static_cast<uint32_t>(NumTriangle)) - Target.First;
+
+		Math::Vector3 ClusterCentroid(0.0f);
+		Math::Vector3 ClusterNormal(0.0f);
+		float ClusterArea = 0.0f;
+		for (uint32_t Triangle = Target.First; Triangle < Target.First + Target.Count; ++Triangle)
+		{
+			Math::Vector3 Centroid, Normal;
+			GetTriangle(Triangle, Centroid, Normal);
+
+			const float Area = std::sqrt(Math::Dot(Normal, Normal));
+			ClusterCentroid = ClusterCentroid + Centroid * Area;
+			ClusterNormal = ClusterNormal + Normal;
+			ClusterArea += Area;
+		}
+
+		if (ClusterArea > 0.0f)
+		{
+			ClusterCentroid = ClusterCentroid * (1.0f / ClusterArea);
+		}
+
+		/// Clusters far out along their own facing direction occlude the rest of the mesh, draw them first.
+		const float NormalLength = std::sqrt(Math::Dot(ClusterNormal, ClusterNormal));
+		Target.SortKey = NormalLength > 0.0f ? Math::Dot(ClusterCentroid - MeshCentroid, ClusterNormal) / NormalLength : 0.0f;
+	}
+
+	std::stable_sort(Clusters.begin(), Clusters.end(), [](const Cluster& Left, const Cluster& Right) {
+		return Left.SortKey > Right.SortKey;
+	});
+
+	std::vector<uint32_t> Output;
+	Output.reserve(NumIndex);
+	for (const auto& Target : Clusters)
+	{
+		Output.insert(Output.end(), Indices + Target.First * 3u, Indices + (Target.First + Target.Count) * 3u);
+	}
+
+	std::copy(Output.begin(), Output.end(), Indices);
+}
+
+size_t MeshOptimizer::GenerateVertexFetchRemap(const uint32_t* Indices, size_t NumIndex, size_t NumVertex, uint32_t* Remap)
+{
+	std::fill(Remap, Remap + NumVertex, ~0u);
+
+	uint32_t NextVertex = 0u;
+	for (size_t Index = 0u; Index < NumIndex; ++Index)
+	{
+		const uint32_t Vertex = Indices[Index];
+		assert(Vertex < NumVertex);
+
+		if (Remap[Vertex] == ~0u)
+		{
+			Remap[Vertex] = NextVertex++;
+		}
+	}
+
+	return NextVertex;
+}
+
+MeshData MeshOptimizer::Optimize(const MeshData& Data, MeshOptimizationStatistics* Statistics)
+{
+	const size_t NumVertex = Data.GetNumVertex();
+	const size_t NumIndex = Data.GetNumIndex();
+
+	if (Data.GetPrimitiveTopology() != ERHIPrimitiveTopology::TriangleList || NumIndex < 3u || NumIndex % 3u != 0u)
+	{
+		return Data;
+	}
+
+	auto Indices = GetIndices(Data);
+
+	if (Statistics)
+	{
+		Statistics->NumVertexBefore = static_cast<uint32_t>(NumVertex);
+		Statistics->Before = AnalyzeVertexCache(Indices.data(), NumIndex, NumVertex);
+	}
+
+	std::vector<uint32_t> Remap(NumVertex);
+	GenerateWeldRemap(Data, Remap.data());
+	for (auto& Index : Indices)
+	{
+		Index = Remap[Index];
+	}
+
+	OptimizeVertexCache(Indices.data(), NumIndex, NumVertex);
+	OptimizeOverdraw(Indices.data(), NumIndex, Data.GetPositions(), NumVertex);
+
+	const size_t NumUnique = GenerateVertexFetchRemap(Indices.data(), NumIndex, NumVertex, Remap.data());
+
+	MeshData Optimized(
+		static_cast<uint32_t>(NumUnique),
+		static_cast<uint32_t>(NumIndex),
+		Data.GetNumPrimitive(),
+		Data.HasNormal(),
+		Data.HasTangent(),
+		Data.HasUV0(),
+		Data.HasUV1(),
+		Data.HasColor(),
+		Data.HasSkin(),
+		Data.GetPrimitiveTopology(),
+		Data.GetVertexLayout());
+	Optimized.SetPositionDequantization(Data.GetPositionScale(), Data.GetPositionBias());
+
+	const auto SourceStreams = GetVertexStreams(Data);
+	const auto TargetStreams = GetVertexStreams(Optimized);
+	assert(SourceStreams.size() == TargetStreams.size());
+
+	const std::byte* Source = Data.VerticesData.Data.get();
+	std::byte* Target = Optimized.VerticesData.Data.get();
+	for (size_t Stream = 0u; Stream < SourceStreams.size(); ++Stream)
+	{
+		const auto& From = SourceStreams[Stream];
+		const auto& To = TargetStreams[Stream];
+		for (size_t Vertex = 0u; Vertex < NumVertex; ++Vertex)
+		{
+			if (Remap[Vertex] != ~0u)
+			{
+				memcpy(Target + To.Offset + Remap[Vertex] * To.Stride, Source + From.Offset + Vertex * From.Stride, From.Size);
+			}
+		}
+	}
+
+	for (auto& Index : Indices)
+	{
+		Index = Remap[Index];
+	}
+
+	for (uint32_t Face = 0u; Face < NumIndex / 3u; ++Face)
+	{
+		Optimized.SetFace(Face, Indices[Face * 3u + 0u], Indices[Face * 3u + 1u], Indices[Face * 3u + 2u]);
+	}
+
+	if (Statistics)
+	{
+		Statistics->NumVertexAfter = static_cast<uint32_t>(NumUnique);
+		Statistics->After = AnalyzeVertexCache(Indices.data(), NumIndex, NumUnique);
+	}
+
+	return Optimized;
+}
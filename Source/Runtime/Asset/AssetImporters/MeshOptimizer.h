@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Scene/Components/StaticMesh.h"
+
+/// Post-transform vertex cache statistics from a FIFO cache simulation.
+struct VertexCacheStatistics
+{
+	uint32_t NumTransformedVertex = 0u;
+
+	/// Average cache miss ratio, transformed vertices per triangle. 0.5 is the lower bound for a regular grid, 3.0 means no reuse at all.
+	float ACMR = 0.0f;
+
+	/// Average transform to vertex ratio, transformed vertices per referenced vertex. 1.0 is optimal.
+	float ATVR = 0.0f;
+};
+
+struct MeshOptimizationStatistics
+{
+	uint32_t NumVertexBefore = 0u;
+	uint32_t NumVertexAfter = 0u;
+
+	VertexCacheStatistics Before;
+	VertexCacheStatistics After;
+};
+
+/// CPU triangle list optimizations, run once at import time.
+/// Vertex cache ordering is Tipsify (Sander et al. 2007, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"),
+/// overdraw ordering sorts the resulting clusters front to back from the outside in, so everything stays linear in the triangle count.
+class MeshOptimizer
+{
+public:
+	static constexpr uint32_t DefaultCacheSize = 16u;
+
+	/// Clusters are allowed to get this much worse than the cache optimized ACMR to get more freedom for overdraw sorting.
+	static constexpr float DefaultOverdrawThreshold = 1.05f;
+
+	static VertexCacheStatistics AnalyzeVertexCache(const uint32_t* Indices, size_t NumIndex, size_t NumVertex, uint32_t CacheSize = DefaultCacheSize);
+
+	/// Fills Remap with the index of the first bitwise identical vertex, i.e. Remap[Index] <= Index. Returns the number of unique vertices.
+	static size_t GenerateWeldRemap(const MeshData& Data, uint32_t* Remap);
+
+	/// Reorders triangles in place for post-transform vertex cache reuse.
+	static void OptimizeVertexCache(uint32_t* Indices, size_t NumIndex, size_t NumVertex, uint32_t CacheSize = DefaultCacheSize);
+
+	/// Reorders the clusters of a vertex cache optimized index list to reduce overdraw, the order inside clusters is kept.
+	static void OptimizeOverdraw(uint32_t* Indices, size_t NumIndex, const Math::Vector3* Positions, size_t NumVertex, uint32_t CacheSize = DefaultCacheSize, float Threshold = DefaultOverdrawThreshold);
+
+	/// Fills Remap[OldIndex] = NewIndex in order of first use, unreferenced vertices get ~0u. Returns the number of referenced vertices.
+	static size_t GenerateVertexFetchRemap(const uint32_t* Indices, size_t NumIndex, size_t NumVertex, uint32_t* Remap);
+
+	/// Welds, cache orders, overdraw orders and fetch orders a triangle list. Other topologies are returned unchanged.
+	/// Expects full precision positions in their own stream, i.e. runs before MeshQuantizer.
+	static MeshData Optimize(const MeshData& Data, MeshOptimizationStatistics* Statistics = nullptr);
+};
@@ -0,0 +1,396 @@
+#include "Asset/AssetLoaders/MeshQuantizer.h"
+#include "Core/Math/Quantization.h"
+
+static float Distance(const Math::Vector3& Left, const Math::Vector3& Right)
+{
+	const float X = Left.x - Right.x;
+	const float Y = Left.y - Right.y;
+	const float Z = Left.z - Right.z;
+	return std::sqrt(X * X + Y * Y + Z * Z);
+}
+
+static Math::Vector3 Cross(const Math::Vector3& Left, const Math::Vector3& Right)
+{
+	return Math::Vector3(
+		Left.y * Right.z - Left.z * Right.y,
+		Left.z * Right.x - Left.x * Right.z,
+		Left.x * Right.y - Left.y * Right.x);
+}
+
+/// Degenerate directions map to +Z rather than NaN.
+static Math::Vector3 Normalize(const Math::Vector3& Direction)
+{
+	const float Length = std::sqrt(Direction.x * Direction.x + Direction.y * Direction.y + Direction.z * Direction.z);
+	return Length > 1e-12f ? Math::Vector3(Direction.x / Length, Direction.y / Length, Direction.z / Length) : Math::Vector3(0.0f, 0.0f, 1.0f);
+}
+
+static void EncodeDirection(MeshData& Data, EVertexElement Element, uint32_t Index, const Math::Vector3& Direction, float Handedness)
+{
+	if (Data.GetVertexLayout().Direction == EDirectionFormat::Float3)
+	{
+		Data.SetElement(Element, Index, Direction);
+		return;
+	}
+
+	const Math::Vector2 Encoded = Math::OctahedralEncode(Normalize(Direction));
+	if (Element == EVertexElement::Normal)
+	{
+		const std::array<int16_t, 2u> Value{ Math::QuantizeSNorm16(Encoded.x), Math::QuantizeSNorm16(Encoded.y) };
+		Data.SetElement(Element, Index, Value);
+	}
+	else
+	{
+		const std::array<int16_t, 4u> Value{ Math::QuantizeSNorm16(Encoded.x), Math::QuantizeSNorm16(Encoded.y), Math::QuantizeSNorm16(Handedness), 0 };
+		Data.SetElement(Element, Index, Value);
+	}
+}
+
+static void EncodeUV(MeshData& Data, EVertexElement Element, uint32_t Index, const Math::Vector2& UV)
+{
+	if (Data.GetVertexLayout().Texcoord == ETexcoordFormat::Float2)
+	{
+		Data.SetElement(Element, Index, UV);
+	}
+	else
+	{
+		const std::array<uint16_t, 2u> Value{ Math::FloatToHalf(UV.x), Math::FloatToHalf(UV.y) };
+		Data.SetElement(Element, Index, Value);
+	}
+}
+
+MeshData MeshQuantizer::Quantize(const MeshData& Data, const VertexLayout& Layout)
+{
+	const uint32_t NumVertex = Data.GetNumVertex();
+
+	MeshData Result(
+		NumVertex,
+		Data.GetNumIndex(),
+		Data.GetNumPrimitive(),
+		Data.HasNormal(),
+		Data.HasTangent(),
+		Data.HasUV0(),
+		Data.HasUV1(),
+		Data.HasColor(),
+		Data.HasSkin(),
+		Data.GetPrimitiveTopology(),
+		Layout);
+
+	if (Result.GetIndexFormat() == Data.GetIndexFormat())
+	{
+		memcpy(Result.IndicesData.Data.get(), Data.IndicesData.Data.get(), Data.GetIndexDataSize());
+	}
+	else
+	{
+		for (uint32_t Index = 0u; Index < Data.GetNumIndex(); ++Index)
+		{
+			const uint32_t Value = Data.GetIndexFormat() == ERHIIndexFormat::UInt16 ?
+				reinterpret_cast<const uint16_t*>(Data.IndicesData.Data.get())[Index] :
+				reinterpret_cast<const uint32_t*>(Data.IndicesData.Data.get())[Index];
+
+			if (Result.GetIndexFormat() == ERHIIndexFormat::UInt16)
+			{
+				reinterpret_cast<uint16_t*>(Result.IndicesData.Data.get())[Index] = static_cast<uint16_t>(Value);
+			}
+			else
+			{
+				reinterpret_cast<uint32_t*>(Result.IndicesData.Data.get())[Index] = Value;
+			}
+		}
+	}
+
+	std::vector<Math::Vector3> Positions(NumVertex);
+	Math::Vector3 Min(std::numeric_limits<float>::max());
+	Math::Vector3 Max(std::numeric_limits<float>::lowest());
+	for (uint32_t Index = 0u; Index < NumVertex; ++Index)
+	{
+		Positions[Index] = DecodePosition(Data, Index);
+		Min = Math::Vector3(std::min(Min.x, Positions[Index].x), std::min(Min.y, Positions[Index].y), std::min(Min.z, Positions[Index].z));
+		Max = Math::Vector3(std::max(Max.x, Positions[Index].x), std::max(Max.y, Positions[Index].y), std::max(Max.z, Positions[Index].z));
+	}
+
+	if (Layout.Position != EPositionFormat::Float3)
+	{
+		/// Flat axes keep a unit scale so encoding never divides by zero, every coordinate on them is the bias.
+		auto GetScale = [](float Extent) { return Extent > 0.0f ? Extent : 1.0f; };
+		const Math::Vector3 Scale(GetScale((Max.x - Min.x) * 0.5f), GetScale((Max.y - Min.y) * 0.5f), GetScale((Max.z - Min.z) * 0.5f));
+		const Math::Vector3 Bias((Max.x + Min.x) * 0.5f, (Max.y + Min.y) * 0.5f, (Max.z + Min.z) * 0.5f);
+		Result.SetPositionDequantization(Scale, Bias);
+	}
+
+	const Math::Vector3& Scale = Result.GetPositionScale();
+	const Math::Vector3& Bias = Result.GetPositionBias();
+
+	for (uint32_t Index = 0u; Index < NumVertex; ++Index)
+	{
+		const Math::Vector3& Position = Positions[Index];
+		switch (Layout.Position)
+		{
+		case EPositionFormat::Float3:
+			Result.SetElement(EVertexElement::Position, Index, Position);
+			break;
+		case EPositionFormat::Half4:
+		{
+			const std::array<uint16_t, 4u> Value{
+				Math::FloatToHalf((Position.x - Bias.x) / Scale.x),
+				Math::FloatToHalf((Position.y - Bias.y) / Scale.y),
+				Math::FloatToHalf((Position.z - Bias.z) / Scale.z),
+				0u };
+			Result.SetElement(EVertexElement::Position, Index, Value);
+			break;
+		}
+		case EPositionFormat::SNorm16x4:
+		{
+			const std::array<int16_t, 4u> Value{
+				Math::QuantizeSNorm16((Position.x - Bias.x) / Scale.x),
+				Math::QuantizeSNorm16((Position.y - Bias.y) / Scale.y),
+				Math::QuantizeSNorm16((Position.z - Bias.z) / Scale.z),
+				0 };
+			Result.SetElement(EVertexElement::Position, Index, Value);
+			break;
+		}
+		}
+
+		if (Data.HasNormal())
+		{
+			EncodeDirection(Result, EVertexElement::Normal, Index, DecodeNormal(Data, Index), 0.0f);
+		}
+
+		if (Data.HasTangent())
+		{
+			const Math::Vector4 Tangent = DecodeTangent(Data, Index);
+			const Math::Vector3 TangentXYZ(Tangent.x, Tangent.y, Tangent.z);
+			EncodeDirection(Result, EVertexElement::Tangent, Index, TangentXYZ, Tangent.w);
+
+			if (Result.HasElement(EVertexElement::BiTangent))
+			{
+				Result.SetElement(EVertexElement::BiTangent, Index, DecodeBiTangent(Data, Index));
+			}
+		}
+
+		if (Data.HasUV0())
+		{
+			EncodeUV(Result, EVertexElement::UV0, Index, DecodeUV(Data, EVertexElement::UV0, Index));
+		}
+		if (Data.HasUV1())
+		{
+			EncodeUV(Result, EVertexElement::UV1, Index, DecodeUV(Data, EVertexElement::UV1, Index));
+		}
+
+		if (Data.HasColor())
+		{
+			const Math::Color Color = DecodeColor(Data, Index);
+			if (Layout.Color == EColorFormat::Float4)
+			{
+				Result.SetElement(EVertexElement::Color, Index, Color);
+			}
+			else
+			{
+				const std::array<uint8_t, 4u> Value{ Math::QuantizeUNorm8(Color.x), Math::QuantizeUNorm8(Color.y), Math::QuantizeUNorm8(Color.z), Math::QuantizeUNorm8(Color.w) };
+				Result.SetElement(EVertexElement::Color, Index, Value);
+			}
+		}
+
+		if (Data.HasSkin())
+		{
+			/// Already compact, copied as is.
+			memcpy(Result.GetElementData(EVertexElement::BoneIndices, Index), Data.GetElementData(EVertexElement::BoneIndices, Index), Data.GetElementSize(EVertexElement::BoneIndices));
+			memcpy(Result.GetElementData(EVertexElement::BoneWeights, Index), Data.GetElementData(EVertexElement::BoneWeights, Index), Data.GetElementSize(EVertexElement::BoneWeights));
+		}
+	}
+
+	return Result;
+}
+
+Math::Vector3 MeshQuantizer::DecodePosition(const MeshData& Data, uint32_t Index)
+{
+	return Data.GetPosition(Index);
+}
+
+Math::Vector3 MeshQuantizer::DecodeNormal(const MeshData& Data, uint32_t Index)
+{
+	if (Data.GetVertexLayout().Direction == EDirectionFormat::Float3)
+	{
+		return Data.GetElement<Math::Vector3>(EVertexElement::Normal, Index);
+	}
+
+	const auto Value = Data.GetElement<std::array<int16_t, 2u>>(EVertexElement::Normal, Index);
+	return Math::OctahedralDecode(Math::Vector2(Math::DequantizeSNorm16(Value[0]), Math::DequantizeSNorm16(Value[1])));
+}
+
+Math::Vector4 MeshQuantizer::DecodeTangent(const MeshData& Data, uint32_t Index)
+{
+	if (Data.GetVertexLayout().Direction == EDirectionFormat::Float3)
+	{
+		const Math::Vector3 Tangent = Data.GetElement<Math::Vector3>(EVertexElement::Tangent, Index);
+		if (!Data.HasNormal())
+		{
+			return Math::Vector4(Tangent, 1.0f);
+		}
+
+		/// Handedness of the stored frame, so cross(Normal, Tangent) * w points the same way as the stored bitangent.
+		const Math::Vector3 BiTangent = Data.GetElement<Math::Vector3>(EVertexElement::BiTangent, Index);
+		const Math::Vector3 Reconstructed = Cross(DecodeNormal(Data, Index), Tangent);
+		const float Dot = Reconstructed.x * BiTangent.x + Reconstructed.y * BiTangent.y + Reconstructed.z * BiTangent.z;
+		return Math::Vector4(Tangent, Dot < 0.0f ? -1.0f : 1.0f);
+	}
+
+	const auto Value = Data.GetElement<std::array<int16_t, 4u>>(EVertexElement::Tangent, Index);
+	const Math::Vector3 Tangent = Math::OctahedralDecode(Math::Vector2(Math::DequantizeSNorm16(Value[0]), Math::DequantizeSNorm16(Value[1])));
+	return Math::Vector4(Tangent, Value[2] < 0 ? -1.0f : 1.0f);
+}
+
+Math::Vector3 MeshQuantizer::DecodeBiTangent(const MeshData& Data, uint32_t Index)
+{
+	if (Data.HasElement(EVertexElement::BiTangent))
+	{
+		return Data.GetElement<Math::Vector3>(EVertexElement::BiTangent, Index);
+	}
+
+	const Math::Vector4 Tangent = DecodeTangent(Data, Index);
+	const Math::Vector3 Normal = Data.HasNormal() ? DecodeNormal(Data, Index) : Math::Vector3(0.0f, 0.0f, 1.0f);
+	const Math::Vector3 BiTangent = Cross(Normal, Math::Vector3(Tangent.x, Tangent.y, Tangent.z));
+	return Math::Vector3(BiTangent.x * Tangent.w, BiTangent.y * Tangent.w, BiTangent.z * Tangent.w);
+}
+
+Math::Vector2 MeshQuantizer::DecodeUV(const MeshData& Data, EVertexElement Element, uint32_t Index)
+{
+	assert(Element == EVertexElement::UV0 || Element == EVertexElement::UV1);
+
+	if (Data.GetVertexLayout().Texcoord == ETexcoordFormat::Float2)
+	{
+		return Data.GetElement<Math::Vector2>(Element, Index);
+	}
+
+	const auto Value = Data.GetElement<std::array<uint16_t, 2u>>(Element, Index);
+	return Math::Vector2(Math::HalfToFloat(Value[0]), Math::HalfToFloat(Value[1]));
+}
+
+Math::Color MeshQuantizer::DecodeColor(const MeshData& Data, uint32_t Index)
+{
+	if (Data.GetVertexLayout().Color == EColorFormat::Float4)
+	{
+		return Data.GetElement<Math::Color>(EVertexElement::Color, Index);
+	}
+
+	const auto Value = Data.GetElement<std::array<uint8_t, 4u>>(EVertexElement::Color, Index);
+	return Math::Color(Math::DequantizeUNorm8(Value[0]), Math::DequantizeUNorm8(Value[1]), Math::DequantizeUNorm8(Value[2]), Math::DequantizeUNorm8(Value[3]));
+}
+
+VertexQuantizationError MeshQuantizer::MeasureError(const MeshData& Source, const MeshData& Quantized)
+{
+	assert(Source.GetNumVertex() == Quantized.GetNumVertex() && Source.GetVertexAttributes() == Quantized.GetVertexAttributes());
+
+	VertexQuantizationError Error;
+	for (uint32_t Index = 0u; Index < Source.GetNumVertex(); ++Index)
+	{
+		Error.Position = std::max(Error.Position, Distance(DecodePosition(Source, Index), DecodePosition(Quantized, Index)));
+
+		if (Source.HasNormal())
+		{
+			Error.Normal = std::max(Error.Normal, Distance(Normalize(DecodeNormal(Source, Index)), Normalize(DecodeNormal(Quantized, Index))));
+		}
+
+		if (Source.HasTangent())
+		{
+			const Math::Vector4 Expected = DecodeTangent(Source, Index);
+			const Math::Vector4 Actual = DecodeTangent(Quantized, Index);
+			Error.Tangent = std::max(Error.Tangent, Distance(Normalize(Math::Vector3(Expected.x, Expected.y, Expected.z)), Normalize(Math::Vector3(Actual.x, Actual.y, Actual.z))));
+		}
+
+		auto MeasureUV = [&Source, &Quantized, Index](EVertexElement Element, float& Target) {
+			const Math::Vector2 Expected = DecodeUV(Source, Element, Index);
+			const Math::Vector2 Actual = DecodeUV(Quantized, Element, Index);
+			Target = std::max(Target, std::max(std::fabs(Expected.x - Actual.x), std::fabs(Expected.y - Actual.y)));
+		};
+		if (Source.HasUV0())
+		{
+			MeasureUV(EVertexElement::UV0, Error.UV0);
+		}
+		if (Source.HasUV1())
+		{
+			MeasureUV(EVertexElement::UV1, Error.UV1);
+		}
+
+		if (Source.HasColor())
+		{
+			const Math::Color Expected = DecodeColor(Source, Index);
+			const Math::Color Actual = DecodeColor(Quantized, Index);
+			Error.Color = std::max({ Error.Color, std::fabs(Expected.x - Actual.x), std::fabs(Expected.y - Actual.y), std::fabs(Expected.z - Actual.z), std::fabs(Expected.w - Actual.w) });
+		}
+	}
+
+	return Error;
+}
+
+VertexQuantizationError MeshQuantizer::GetErrorBounds(const MeshData& Source, const VertexLayout& Layout)
+{
+	/// Rounding of the float math around the conversions, relative to the largest magnitude involved.
+	static constexpr float Slack = 8.0f * std::numeric_limits<float>::epsilon();
+	static const float Sqrt3 = std::sqrt(3.0f);
+
+	Math::Vector3 Min(std::numeric_limits<float>::max());
+	Math::Vector3 Max(std::numeric_limits<float>::lowest());
+	float MaxAbsUV0 = 0.0f, MaxAbsUV1 = 0.0f, MaxColorOverflow = 0.0f;
+
+	for (uint32_t Index = 0u; Index < Source.GetNumVertex(); ++Index)
+	{
+		const Math::Vector3 Position = DecodePosition(Source, Index);
+		Min = Math::Vector3(std::min(Min.x, Position.x), std::min(Min.y, Position.y), std::min(Min.z, Position.z));
+		Max = Math::Vector3(std::max(Max.x, Position.x), std::max(Max.y, Position.y), std::max(Max.z, Position.z));
+
+		if (Source.HasUV0())
+		{
+			const Math::Vector2 UV = DecodeUV(Source, EVertexElement::UV0, Index);
+			MaxAbsUV0 = std::max({ MaxAbsUV0, std::fabs(UV.x), std::fabs(UV.y) });
+		}
+		if (Source.HasUV1())
+		{
+			const Math::Vector2 UV = DecodeUV(Source, EVertexElement::UV1, Index);
+			MaxAbsUV1 = std::max({ MaxAbsUV1, std::fabs(UV.x), std::fabs(UV.y) });
+		}
+		if (Source.HasColor())
+		{
+			/// unorm8 clamps, anything outside [0, 1] is lost on top of the rounding.
+			const Math::Color Color = DecodeColor(Source, Index);
+			for (float Channel : { Color.x, Color.y, Color.z, Color.w })
+			{
+				MaxColorOverflow = std::max(MaxColorOverflow, std::max(Channel - 1.0f, -Channel));
+			}
+		}
+	}
+
+	const float MaxExtent = std::max({ Max.x - Min.x, Max.y - Min.y, Max.z - Min.z }) * 0.5f;
+	const float MaxMagnitude = std::max({ std::fabs(Min.x), std::fabs(Min.y), std::fabs(Min.z), std::fabs(Max.x), std::fabs(Max.y), std::fabs(Max.z) });
+
+	VertexQuantizationError Bounds;
+	switch (Layout.Position)
+	{
+	case EPositionFormat::Float3:
+		Bounds.Position = 0.0f;
+		break;
+	case EPositionFormat::Half4:
+		/// Encoded values lie in [-1, 1], where half rounding is off by at most 2^-12.
+		Bounds.Position = Sqrt3 * MaxExtent / 4096.0f;
+		break;
+	case EPositionFormat::SNorm16x4:
+		Bounds.Position = Sqrt3 * MaxExtent * 0.5f / 32767.0f;
+		break;
+	}
+	Bounds.Position += Sqrt3 * Slack * (MaxMagnitude + MaxExtent);
+
+	/// Octahedral snorm16 is off by at most 3 / 32767 over the sphere, the float layout only normalizes.
+	const float DirectionBound = (Layout.Direction == EDirectionFormat::Octahedral16 ? 3.0f / 32767.0f : 0.0f) + Slack;
+	Bounds.Normal = DirectionBound;
+	Bounds.Tangent = DirectionBound;
+
+	/// Half keeps 11 significant bits, subnormals below 2^-14 have an absolute step of 2^-24.
+	auto GetUVBound = [&Layout](float MaxAbsUV) {
+		return Layout.Texcoord == ETexcoordFormat::Half2 ? MaxAbsUV / 2048.0f + 1.0f / 33554432.0f : 0.0f;
+	};
+	Bounds.UV0 = GetUVBound(MaxAbsUV0);
+	Bounds.UV1 = GetUVBound(MaxAbsUV1);
+
+	Bounds.Color = Layout.Color == EColorFormat::UNorm8x4 ? 0.5f / 255.0f + MaxColorOverflow + Slack : 0.0f;
+
+	return Bounds;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Scene/Components/StaticMesh.h"
+
+/// Largest per vertex difference between a mesh and its quantized copy, positions and directions as euclidean distance, texcoords and colors per channel.
+/// Directions are compared after normalizing the source. Octahedral layouts rebuild the bitangent from the normal and tangent,
+/// which is exact for orthonormal frames only, so it has no bound of its own.
+struct VertexQuantizationError
+{
+	float Position = 0.0f;
+	float Normal = 0.0f;
+	float Tangent = 0.0f;
+	float UV0 = 0.0f;
+	float UV1 = 0.0f;
+	float Color = 0.0f;
+
+	inline bool IsWithin(const VertexQuantizationError& Bounds) const
+	{
+		return Position <= Bounds.Position && Normal <= Bounds.Normal && Tangent <= Bounds.Tangent &&
+			UV0 <= Bounds.UV0 && UV1 <= Bounds.UV1 && Color <= Bounds.Color;
+	}
+};
+
+/// Converts MeshData between vertex layouts, see VertexLayout for the formats and their precision.
+class MeshQuantizer
+{
+public:
+	/// Any layout to any layout, quantized sources are decoded first. Positions are renormalized to the mesh bounds when the target quantizes them.
+	static MeshData Quantize(const MeshData& Data, const VertexLayout& Layout);
+
+	static Math::Vector3 DecodePosition(const MeshData& Data, uint32_t Index);
+	static Math::Vector3 DecodeNormal(const MeshData& Data, uint32_t Index);
+
+	/// The w component is the bitangent handedness, +1 or -1.
+	static Math::Vector4 DecodeTangent(const MeshData& Data, uint32_t Index);
+	static Math::Vector3 DecodeBiTangent(const MeshData& Data, uint32_t Index);
+	static Math::Vector2 DecodeUV(const MeshData& Data, EVertexElement Element, uint32_t Index);
+	static Math::Color DecodeColor(const MeshData& Data, uint32_t Index);
+
+	/// Both meshes must have the same vertex count and attributes.
+	static VertexQuantizationError MeasureError(const MeshData& Source, const MeshData& Quantized);
+
+	/// Analytic worst case error of quantizing Source into Layout, MeasureError never exceeds it.
+	static VertexQuantizationError GetErrorBounds(const MeshData& Source, const VertexLayout& Layout);
+};
@@ -0,0 +1,830 @@
+#include "Asset/AssetLoaders/TextureCompressor.h"
+#include "Async/Task.h"
+#include <DirectXMath.h>
+#include <numeric>
+
+using namespace DirectX;
+
+static constexpr uint32_t BC7Weights[16u] = { 0u, 4u, 9u, 13u, 17u, 21u, 26u, 30u, 34u, 38u, 43u, 47u, 51u, 55u, 60u, 64u };
+
+class BlockBitWriter
+{
+public:
+	BlockBitWriter(uint8_t* Block)
+		: m_Block(Block)
+	{
+	}
+
+	void Write(uint32_t Value, uint32_t NumBits)
+	{
+		for (uint32_t Bit = 0u; Bit < NumBits; ++Bit, ++m_Offset)
+		{
+			if ((Value >> Bit) & 1u)
+			{
+				m_Block[m_Offset >> 3u] |= static_cast<uint8_t>(1u << (m_Offset & 7u));
+			}
+		}
+	}
+private:
+	uint8_t* m_Block;
+	uint32_t m_Offset = 0u;
+};
+
+class BlockBitReader
+{
+public:
+	BlockBitReader(const uint8_t* Block)
+		: m_Block(Block)
+	{
+	}
+
+	uint32_t Read(uint32_t NumBits)
+	{
+		uint32_t Value = 0u;
+		for (uint32_t Bit = 0u; Bit < NumBits; ++Bit, ++m_Offset)
+		{
+			Value |= ((m_Block[m_Offset >> 3u] >> (m_Offset & 7u)) & 1u) << Bit;
+		}
+		return Value;
+	}
+private:
+	const uint8_t* m_Block;
+	uint32_t m_Offset = 0u;
+};
+
+static void LoadTexels(const uint8_t* Texels, XMVECTOR* OutTexels, bool WithAlpha)
+{
+	for (uint32_t Index = 0u; Index < TextureCompressor::NumBlockTexels; ++Index)
+	{
+		const uint8_t* Texel = Texels + Index * 4u;
+		OutTexels[Index] = XMVectorSet(Texel[0], Texel[1], Texel[2], WithAlpha ? Texel[3] : 0.0f);
+	}
+}
+
+/// Mean and dominant direction of the texels, by power iteration on their covariance.
+static void FitPrincipalAxis(const XMVECTOR* Texels, XMVECTOR& OutMean, XMVECTOR& OutAxis)
+{
+	XMVECTOR Sum = XMVectorZero();
+	XMVECTOR Min = Texels[0];
+	XMVECTOR Max = Texels[0];
+	for (uint32_t Index = 0u; Index < TextureCompressor::NumBlockTexels; ++Index)
+	{
+		Sum = XMVectorAdd(Sum, Texels[Index]);
+		Min = XMVectorMin(Min, Texels[Index]);
+		Max = XMVectorMax(Max, Texels[Index]);
+	}
+	OutMean = XMVectorScale(Sum, 1.0f / TextureCompressor::NumBlockTexels);
+
+	XMVECTOR Covariance[4u] = { XMVectorZero(), XMVectorZero(), XMVectorZero(), XMVectorZero() };
+	for (uint32_t Index = 0u; Index < TextureCompressor::NumBlockTexels; ++Index)
+	{
+		const XMVECTOR Delta = XMVectorSubtract(Texels[Index], OutMean);
+		Covariance[0u] = XMVectorMultiplyAdd(XMVectorSplatX(Delta), Delta, Covariance[0u]);
+		Covariance[1u] = XMVectorMultiplyAdd(XMVectorSplatY(Delta), Delta, Covariance[1u]);
+		Covariance[2u] = XMVectorMultiplyAdd(XMVectorSplatZ(Delta), Delta, Covariance[2u]);
+		Covariance[3u] = XMVectorMultiplyAdd(XMVectorSplatW(Delta), Delta, Covariance[3u]);
+	}
+
+	/// The bounding box diagonal is a good first guess and converges in a few steps.
+	OutAxis = XMVectorSubtract(Max, Min);
+	if (XMVectorGetX(XMVector4LengthSq(OutAxis)) < 1e-6f)
+	{
+		OutAxis = XMVectorZero();
+		return;
+	}
+
+	for (uint32_t Iteration = 0u; Iteration < 8u; ++Iteration)
+	{
+		XMVECTOR Next = XMVectorMultiply(Covariance[0u], XMVectorSplatX(OutAxis));
+		Next = XMVectorMultiplyAdd(Covariance[1u], XMVectorSplatY(OutAxis), Next);
+		Next = XMVectorMultiplyAdd(Covariance[2u], XMVectorSplatZ(OutAxis), Next);
+		Next = XMVectorMultiplyAdd(Covariance[3u], XMVectorSplatW(OutAxis), Next);
+
+		if (XMVectorGetX(XMVector4LengthSq(Next)) < 1e-12f)
+		{
+			break;
+		}
+		OutAxis = XMVector4Normalize(Next);
+	}
+	OutAxis = XMVector4Normalize(OutAxis);
+}
+
+/// Endpoints spanning the projections of the texels onto the principal axis.
+static void FitEndpoints(const XMVECTOR* Texels, XMVECTOR& OutLow, XMVECTOR& OutHigh)
+{
+	XMVECTOR Mean, Axis;
+	FitPrincipalAxis(Texels, Mean, Axis);
+
+	float MinT = std::numeric_limits<float>::max();
+	float MaxT = std::numeric_limits<float>::lowest();
+	for (uint32_t Index = 0u; Index < TextureCompressor::NumBlockTexels; ++Index)
+	{
+		const float T = XMVectorGetX(XMVector4Dot(XMVectorSubtract(Texels[Index], Mean), Axis));
+		MinT = std::min(MinT, T);
+		MaxT = std::max(MaxT, T);
+	}
+
+	OutLow = XMVectorMultiplyAdd(Axis, XMVectorReplicate(MinT), Mean);
+	OutHigh = XMVectorMultiplyAdd(Axis, XMVectorReplicate(MaxT), Mean);
+}
+
+/// Least squares endpoints for fixed interpolation weights, Weights[i] is how much of High texel i takes.
+static bool RefineEndpoints(const XMVECTOR* Texels, const float* Weights, XMVECTOR& OutLow, XMVECTOR& OutHigh)
+{
+	float A11 = 0.0f, A12 = 0.0f, A22 = 0.0f;
+	XMVECTOR RhsLow = XMVectorZero();
+	XMVECTOR RhsHigh = XMVectorZero();
+
+	for (uint32_t Index = 0u; Index < TextureCompressor::NumBlockTexels; ++Index)
+	{
+		const float High = Weights[Index];
+		const float Low = 1.0f - High;
+
+		A11 += Low * Low;
+		A12 += Low * High;
+		A22 += High * High;
+		RhsLow = XMVectorMultiplyAdd(Texels[Index], XMVectorReplicate(Low), RhsLow);
+		RhsHigh = XMVectorMultiplyAdd(Texels[Index], XMVectorReplicate(High), RhsHigh);
+	}
+
+	const float Determinant = A11 * A22 - A12 * A12;
+	if (std::fabsf(Determinant) < 1e-6f)
+	{
+		return false;
+	}
+
+	const float InvDeterminant = 1.0f / Determinant;
+	OutLow = XMVectorScale(XMVectorSubtract(XMVectorScale(RhsLow, A22), XMVectorScale(RhsHigh, A12)), InvDeterminant);
+	OutHigh = XMVectorScale(XMVectorSubtract(XMVectorScale(RhsHigh, A11), XMVectorScale(RhsLow, A12)), InvDeterminant);
+
+	return true;
+}
+
+static uint16_t PackRGB565(FXMVECTOR Color)
+{
+	XMFLOAT4 Clamped;
+	XMStoreFloat4(&Clamped, XMVectorClamp(Color, XMVectorZero(), XMVectorReplicate(255.0f)));
+
+	const uint32_t R = static_cast<uint32_t>(Clamped.x * 31.0f / 255.0f + 0.5f);
+	const uint32_t G = static_cast<uint32_t>(Clamped.y * 63.0f / 255.0f + 0.5f);
+	const uint32_t B = static_cast<uint32_t>(Clamped.z * 31.0f / 255.0f + 0.5f);
+
+	return static_cast<uint16_t>((R << 11u) | (G << 5u) | B);
+}
+
+static XMVECTOR UnpackRGB565(uint16_t Color)
+{
+	const uint32_t R = (Color >> 11u) & 31u;
+	const uint32_t G = (Color >> 5u) & 63u;
+	const uint32_t B = Color & 31u;
+
+	return XMVectorSet(static_cast<float>((R << 3u) | (R >> 2u)), static_cast<float>((G << 2u) | (G >> 4u)), static_cast<float>((B << 3u) | (B >> 2u)), 0.0f);
+}
+
+/// Palette of a BC1 block in four color mode, equal endpoints only use the first entry.
+static void GetBC1Palette(uint16_t Color0, uint16_t Color1, XMVECTOR* OutPalette)
+{
+	OutPalette[0u] = UnpackRGB565(Color0);
+	OutPalette[1u] = UnpackRGB565(Color1);
+
+	if (Color0 > Color1)
+	{
+		OutPalette[2u] = XMVectorScale(XMVectorAdd(XMVectorScale(OutPalette[0u], 2.0f), OutPalette[1u]), 1.0f / 3.0f);
+		OutPalette[3u] = XMVectorScale(XMVectorAdd(OutPalette[0u], XMVectorScale(OutPalette[1u], 2.0f)), 1.0f / 3.0f);
+	}
+	else
+	{
+		OutPalette[2u] = XMVectorScale(XMVectorAdd(OutPalette[0u], OutPalette[1u]), 0.5f);
+		OutPalette[3u] = XMVectorZero();
+	}
+}
+
+static float SelectBC1Indices(const XMVECTOR* Texels, uint16_t Color0, uint16_t Color1, uint32_t& OutIndices)
+{
+	OutIndices = 0u;
+
+	XMVECTOR Palette[4u];
+	GetBC1Palette(Color0, Color1, Palette);
+
+	const uint32_t NumColors = Color0 > Color1 ? 4u : 1u;
+	float Error = 0.0f;
+
+	for (uint32_t Index = 0u; Index < TextureCompressor::NumBlockTexels; ++Index)
+	{
+		uint32_t Best = 0u;
+		float BestError = std::numeric_limits<float>::max();
+		for (uint32_t Entry = 0u; Entry < NumColors; ++Entry)
+		{
+			const float EntryError = XMVectorGetX(XMVector3LengthSq(XMVectorSubtract(Texels[Index], Palette[Entry])));
+			if (EntryError < BestError)
+			{
+				BestError = EntryError;
+				Best = Entry;
+			}
+		}
+
+		OutIndices |= Best << (Index * 2u);
+		Error += BestError;
+	}
+
+	return Error;
+}
+
+static float EncodeBC1Endpoints(const XMVECTOR* Texels, FXMVECTOR High, FXMVECTOR Low, uint16_t& OutColor0, uint16_t& OutColor1, uint32_t& OutIndices)
+{
+	OutColor0 = PackRGB565(High);
+	OutColor1 = PackRGB565(Low);
+	if (OutColor0 < OutColor1)
+	{
+		std::swap(OutColor0, OutColor1);
+	}
+
+	return SelectBC1Indices(Texels, OutColor0, OutColor1, OutIndices);
+}
+
+void TextureCompressor::EncodeBC1(const uint8_t* Texels, uint8_t* Block)
+{
+	XMVECTOR Colors[NumBlockTexels];
+	LoadTexels(Texels, Colors, false);
+
+	XMVECTOR Low, High;
+	FitEndpoints(Colors, Low, High);
+
+	/// Pulling the endpoints in by a sixteenth of the range lowers the error of the interpolated entries.
+	const XMVECTOR Inset = XMVectorScale(XMVectorSubtract(High, Low), 1.0f / 16.0f);
+	High = XMVectorSubtract(High, Inset);
+	Low = XMVectorAdd(Low, Inset);
+
+	uint16_t Color0, Color1;
+	uint32_t Indices;
+	float Error = EncodeBC1Endpoints(Colors, High, Low, Color0, Color1, Indices);
+
+	if (Color0 != Color1)
+	{
+		static constexpr float IndexWeights[4u] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+		float Weights[NumBlockTexels];
+		for (uint32_t Index = 0u; Index < NumBlockTexels; ++Index)
+		{
+			Weights[Index] = IndexWeights[(Indices >> (Index * 2u)) & 3u];
+		}
+
+		/// Weights are towards Color1.
+		XMVECTOR Refined0, Refined1;
+		if (RefineEndpoints(Colors, Weights, Refined0, Refined1))
+		{
+			uint16_t RefinedColor0, RefinedColor1;
+			uint32_t RefinedIndices;
+			if (EncodeBC1Endpoints(Colors, Refined0, Refined1, RefinedColor0, RefinedColor1, RefinedIndices) < Error)
+			{
+				Color0 = RefinedColor0;
+				Color1 = RefinedColor1;
+				Indices = RefinedIndices;
+			}
+		}
+	}
+
+	Block[0u] = static_cast<uint8_t>(Color0 & 0xFFu);
+	Block[1u] = static_cast<uint8_t>(Color0 >> 8u);
+	Block[2u] = static_cast<uint8_t>(Color1 & 0xFFu);
+	Block[3u] = static_cast<uint8_t>(Color1 >> 8u);
+	VERIFY(memcpy_s(Block + 4u, sizeof(uint32_t), &Indices, sizeof(uint32_t)) == 0);
+}
+
+void TextureCompressor::DecodeBC1(const uint8_t* Block, uint8_t* Texels)
+{
+	const uint16_t Color0 = static_cast<uint16_t>(Block[0u] | (Block[1u] << 8u));
+	const uint16_t Color1 = static_cast<uint16_t>(Block[2u] | (Block[3u] << 8u));
+
+	uint32_t Indices;
+	VERIFY(memcpy_s(&Indices, sizeof(uint32_t), Block + 4u, sizeof(uint32_t)) == 0);
+
+	XMVECTOR Palette[4u];
+	GetBC1Palette(Color0, Color1, Palette);
+
+	for (uint32_t Index = 0u; Index < NumBlockTexels; ++Index)
+	{
+		XMFLOAT4 Color;
+		XMStoreFloat4(&Color, XMVectorRound(Palette[(Indices >> (Index * 2u)) & 3u]));
+
+		uint8_t* Texel = Texels + Index * 4u;
+		Texel[0u] = static_cast<uint8_t>(Color.x);
+		Texel[1u] = static_cast<uint8_t>(Color.y);
+		Texel[2u] = static_cast<uint8_t>(Color.z);
+		Texel[3u] = 255u;
+	}
+}
+
+/// Palette of a BC4 block, eight interpolated values if Value0 > Value1, else six plus 0 and 255.
+static void GetBC4Palette(uint8_t Value0, uint8_t Value1, uint8_t* OutPalette)
+{
+	OutPalette[0u] = Value0;
+	OutPalette[1u] = Value1;
+
+	if (Value0 > Value1)
+	{
+		for (uint32_t Index = 1u; Index < 7u; ++Index)
+		{
+			OutPalette[Index + 1u] = static_cast<uint8_t>(((7u - Index) * Value0 + Index * Value1 + 3u) / 7u);
+		}
+	}
+	else
+	{
+		for (uint32_t Index = 1u; Index < 5u; ++Index)
+		{
+			OutPalette[Index + 1u] = static_cast<uint8_t>(((5u - Index) * Value0 + Index * Value1 + 2u) / 5u);
+		}
+		OutPalette[6u] = 0u;
+		OutPalette[7u] = 255u;
+	}
+}
+
+static uint32_t SelectBC4Indices(const uint8_t* Values, uint8_t Value0, uint8_t Value1, uint64_t& OutIndices)
+{
+	uint8_t Palette[8u];
+	GetBC4Palette(Value0, Value1, Palette);
+
+	OutIndices = 0u;
+	uint32_t Error = 0u;
+
+	for (uint32_t Index = 0u; Index < TextureCompressor::NumBlockTexels; ++Index)
+	{
+		uint32_t Best = 0u;
+		uint32_t BestError = std::numeric_limits<uint32_t>::max();
+		for (uint32_t Entry = 0u; Entry < 8u; ++Entry)
+		{
+			const int32_t Delta = static_cast<int32_t>(Values[Index]) - Palette[Entry];
+			const uint32_t EntryError = static_cast<uint32_t>(Delta * Delta);
+			if (EntryError < BestError)
+			{
+				BestError = EntryError;
+				Best = Entry;
+			}
+		}
+
+		OutIndices |= static_cast<uint64_t>(Best) << (Index * 3u);
+		Error += BestError;
+	}
+
+	return Error;
+}
+
+void TextureCompressor::EncodeBC4(const uint8_t* Texels, uint32_t Channel, uint8_t* Block)
+{
+	uint8_t Values[NumBlockTexels];
+	uint8_t Min = 255u, Max = 0u;
+	uint8_t InnerMin = 255u, InnerMax = 0u;
+
+	for (uint32_t Index = 0u; Index < NumBlockTexels; ++Index)
+	{
+		Values[Index] = Texels[Index * 4u + Channel];
+		Min = std::min(Min, Values[Index]);
+		Max = std::max(Max, Values[Index]);
+
+		if (Values[Index] != 0u && Values[Index] != 255u)
+		{
+			InnerMin = std::min(InnerMin, Values[Index]);
+			InnerMax = std::max(InnerMax, Values[Index]);
+		}
+	}
+
+	uint8_t Value0 = Max, Value1 = Min;
+	uint64_t Indices = 0u;
+	uint32_t Error = Max == Min ? 0u : SelectBC4Indices(Values, Value0, Value1, Indices);
+
+	/// Blocks touching 0 or 255 may do better with the six value mode, which has both extremes for free.
+	if (Error && (Min == 0u || Max == 255u))
+	{
+		if (InnerMin > InnerMax)
+		{
+			InnerMin = InnerMax = Min == 0u ? 0u : 255u;
+		}
+
+		uint64_t InnerIndices;
+		const uint32_t InnerError = SelectBC4Indices(Values, InnerMin, InnerMax, InnerIndices);
+		if (InnerError < Error)
+		{
+			Value0 = InnerMin;
+			Value1 = InnerMax;
+			Indices = InnerIndices;
+		}
+	}
+
+	Block[0u] = Value0;
+	Block[1u] = Value1;
+	for (uint32_t Byte = 0u; Byte < 6u; ++Byte)
+	{
+		Block[Byte + 2u] = static_cast<uint8_t>((Indices >> (Byte * 8u)) & 0xFFu);
+	}
+}
+
+void TextureCompressor::DecodeBC4(const uint8_t* Block, uint32_t Channel, uint8_t* Texels)
+{
+	uint8_t Palette[8u];
+	GetBC4Palette(Block[0u], Block[1u], Palette);
+
+	uint64_t Indices = 0u;
+	for (uint32_t Byte = 0u; Byte < 6u; ++Byte)
+	{
+		Indices |= static_cast<uint64_t>(Block[Byte + 2u]) << (Byte * 8u);
+	}
+
+	for (uint32_t Index = 0u; Index < NumBlockTexels; ++Index)
+	{
+		Texels[Index * 4u + Channel] = Palette[(Indices >> (Index * 3u)) & 7u];
+	}
+}
+
+void TextureCompressor::EncodeBC3(const uint8_t* Texels, uint8_t* Block)
+{
+	EncodeBC4(Texels, 3u, Block);
+	EncodeBC1(Texels, Block + 8u);
+}
+
+void TextureCompressor::DecodeBC3(const uint8_t* Block, uint8_t* Texels)
+{
+	DecodeBC1(Block + 8u, Texels);
+	DecodeBC4(Block, 3u, Texels);
+}
+
+void TextureCompressor::EncodeBC5(const uint8_t* Texels, uint8_t* Block)
+{
+	EncodeBC4(Texels, 0u, Block);
+	EncodeBC4(Texels, 1u, Block + 8u);
+}
+
+void TextureCompressor::DecodeBC5(const uint8_t* Block, uint8_t* Texels)
+{
+	for (uint32_t Index = 0u; Index < NumBlockTexels; ++Index)
+	{
+		Texels[Index * 4u + 2u] = 0u;
+		Texels[Index * 4u + 3u] = 255u;
+	}
+
+	DecodeBC4(Block, 0u, Texels);
+	DecodeBC4(Block + 8u, 1u, Texels);
+}
+
+struct BC7Endpoint
+{
+	uint8_t Values[4u] = {};
+	uint8_t PBit = 0u;
+
+	inline XMVECTOR Get() const
+	{
+		return XMVectorSet(
+			static_cast<float>((Values[0u] << 1u) | PBit),
+			static_cast<float>((Values[1u] << 1u) | PBit),
+			static_cast<float>((Values[2u] << 1u) | PBit),
+			static_cast<float>((Values[3u] << 1u) | PBit));
+	}
+};
+
+/// 7 bits per channel plus a p-bit shared by the channels, both p-bits are tried.
+static BC7Endpoint QuantizeBC7Endpoint(FXMVECTOR Endpoint)
+{
+	XMFLOAT4 Clamped;
+	XMStoreFloat4(&Clamped, XMVectorClamp(Endpoint, XMVectorZero(), XMVectorReplicate(255.0f)));
+	const float Channels[4u] = { Clamped.x, Clamped.y, Clamped.z, Clamped.w };
+
+	BC7Endpoint Best;
+	float BestError = std::numeric_limits<float>::max();
+
+	for (uint8_t PBit = 0u; PBit < 2u; ++PBit)
+	{
+		BC7Endpoint Candidate;
+		Candidate.PBit = PBit;
+
+		float Error = 0.0f;
+		for (uint32_t Channel = 0u; Channel < 4u; ++Channel)
+		{
+			const float Quantized = std::clamp(std::roundf((Channels[Channel] - PBit) * 0.5f), 0.0f, 127.0f);
+			Candidate.Values[Channel] = static_cast<uint8_t>(Quantized);
+
+			const float Delta = Quantized * 2.0f + PBit - Channels[Channel];
+			Error += Delta * Delta;
+		}
+
+		if (Error < BestError)
+		{
+			BestError = Error;
+			Best = Candidate;
+		}
+	}
+
+	return Best;
+}
+
+static void GetBC7Palette(const BC7Endpoint& Endpoint0, const BC7Endpoint& Endpoint1, XMVECTOR* OutPalette)
+{
+	const XMVECTOR Value0 = Endpoint0.Get();
+	const XMVECTOR Value1 = Endpoint1.Get();
+
+	for (uint32_t Index = 0u; Index < 16u; ++Index)
+	{
+		const XMVECTOR Blended = XMVectorAdd(XMVectorScale(Value0, static_cast<float>(64u - BC7Weights[Index])), XMVectorScale(Value1, static_cast<float>(BC7Weights[Index])));
+		OutPalette[Index] = XMVectorFloor(XMVectorScale(XMVectorAdd(Blended, XMVectorReplicate(32.0f)), 1.0f / 64.0f));
+	}
+}
+
+static float SelectBC7Indices(const XMVECTOR* Texels, const BC7Endpoint& Endpoint0, const BC7Endpoint& Endpoint1, uint8_t* OutIndices)
+{
+	XMVECTOR Palette[16u];
+	GetBC7Palette(Endpoint0, Endpoint1, Palette);
+
+	float Error = 0.0f;
+	for (uint32_t Index = 0u; Index < TextureCompressor::NumBlockTexels; ++Index)
+	{
+		uint8_t Best = 0u;
+		float BestError = std::numeric_limits<float>::max();
+		for (uint8_t Entry = 0u; Entry < 16u; ++Entry)
+		{
+			const float EntryError = XMVectorGetX(XMVector4LengthSq(XMVectorSubtract(Texels[Index], Palette[Entry])));
+			if (EntryError < BestError)
+			{
+				BestError = EntryError;
+				Best = Entry;
+			}
+		}
+
+		OutIndices[Index] = Best;
+		Error += BestError;
+	}
+
+	return Error;
+}
+
+void TextureCompressor::EncodeBC7(const uint8_t* Texels, uint8_t* Block)
+{
+	XMVECTOR Colors[NumBlockTexels];
+	LoadTexels(Texels, Colors, true);
+
+	XMVECTOR Low, High;
+	FitEndpoints(Colors, Low, High);
+
+	BC7Endpoint Endpoint0 = QuantizeBC7Endpoint(Low);
+	BC7Endpoint Endpoint1 = QuantizeBC7Endpoint(High);
+
+	uint8_t Indices[NumBlockTexels];
+	float Error = SelectBC7Indices(Colors, Endpoint0, Endpoint1, Indices);
+
+	if (Error > 0.0f)
+	{
+		float Weights[NumBlockTexels];
+		for (uint32_t Index = 0u; Index < NumBlockTexels; ++Index)
+		{
+			Weights[Index] = BC7Weights[Indices[Index]] / 64.0f;
+		}
+
+		XMVECTOR RefinedLow, RefinedHigh;
+		if (RefineEndpoints(Colors, Weights, RefinedLow, RefinedHigh))
+		{
+			const BC7Endpoint Refined0 = QuantizeBC7Endpoint(RefinedLow);
+			const BC7Endpoint Refined1 = QuantizeBC7Endpoint(RefinedHigh);
+
+			uint8_t RefinedIndices[NumBlockTexels];
+			if (SelectBC7Indices(Colors, Refined0, Refined1, RefinedIndices) < Error)
+			{
+				Endpoint0 = Refined0;
+				Endpoint1 = Refined1;
+				VERIFY(memcpy_s(Indices, sizeof(Indices), RefinedIndices, sizeof(RefinedIndices)) == 0);
+			}
+		}
+	}
+
+	/// The anchor index drops its top bit, so texel 0 has to pick from the first half of the palette.
+	if (Indices[0u] & 8u)
+	{
+		std::swap(Endpoint0, Endpoint1);
+		for (uint32_t Index = 0u; Index < NumBlockTexels; ++Index)
+		{
+			Indices[Index] = 15u - Indices[Index];
+		}
+	}
+
+	memset(Block, 0, 16u);
+
+	BlockBitWriter Writer(Block);
+	Writer.Write(1u << 6u, 7u);
+	for (uint32_t Channel = 0u; Channel < 4u; ++Channel)
+	{
+		Writer.Write(Endpoint0.Values[Channel], 7u);
+		Writer.Write(Endpoint1.Values[Channel], 7u);
+	}
+	Writer.Write(Endpoint0.PBit, 1u);
+	Writer.Write(Endpoint1.PBit, 1u);
+
+	for (uint32_t Index = 0u; Index < NumBlockTexels; ++Index)
+	{
+		Writer.Write(Indices[Index], Index == 0u ? 3u : 4u);
+	}
+}
+
+void TextureCompressor::DecodeBC7(const uint8_t* Block, uint8_t* Texels)
+{
+	if ((Block[0u] & 0x7Fu) != 0x40u)
+	{
+		memset(Texels, 0, NumBlockTexels * 4u);
+		return;
+	}
+
+	BlockBitReader Reader(Block);
+	Reader.Read(7u);
+
+	BC7Endpoint Endpoint0, Endpoint1;
+	for (uint32_t Channel = 0u; Channel < 4u; ++Channel)
+	{
+		Endpoint0.Values[Channel] = static_cast<uint8_t>(Reader.Read(7u));
+		Endpoint1.Values[Channel] = static_cast<uint8_t>(Reader.Read(7u));
+	}
+	Endpoint0.PBit = static_cast<uint8_t>(Reader.Read(1u));
+	Endpoint1.PBit = static_cast<uint8_t>(Reader.Read(1u));
+
+	XMVECTOR Palette[16u];
+	GetBC7Palette(Endpoint0, Endpoint1, Palette);
+
+	for (uint32_t Index = 0u; Index < NumBlockTexels; ++Index)
+	{
+		XMFLOAT4 Color;
+		XMStoreFloat4(&Color, Palette[Reader.Read(Index == 0u ? 3u : 4u)]);
+
+		uint8_t* Texel = Texels + Index * 4u;
+		Texel[0u] = static_cast<uint8_t>(Color.x);
+		Texel[1u] = static_cast<uint8_t>(Color.y);
+		Texel[2u] = static_cast<uint8_t>(Color.z);
+		Texel[3u] = static_cast<uint8_t>(Color.w);
+	}
+}
+
+bool TextureCompressor::IsSupportedFormat(ERHIFormat Format)
+{
+	return GetBlockSize(Format) != 0u;
+}
+
+uint32_t TextureCompressor::GetBlockSize(ERHIFormat Format)
+{
+	switch (Format)
+	{
+	case ERHIFormat::BC1_UNorm:
+	case ERHIFormat::BC1_UNorm_SRGB:
+	case ERHIFormat::BC4_UNorm:
+		return 8u;
+	case ERHIFormat::BC3_UNorm:
+	case ERHIFormat::BC3_UNorm_SRGB:
+	case ERHIFormat::BC5_UNorm:
+	case ERHIFormat::BC7_UNorm:
+	case ERHIFormat::BC7_UNorm_SRGB:
+		return 16u;
+	default:
+		return 0u;
+	}
+}
+
+static void EncodeBlock(const uint8_t* Texels, ERHIFormat Format, uint8_t* Block)
+{
+	switch (Format)
+	{
+	case ERHIFormat::BC1_UNorm:
+	case ERHIFormat::BC1_UNorm_SRGB:
+		TextureCompressor::EncodeBC1(Texels, Block);
+		break;
+	case ERHIFormat::BC3_UNorm:
+	case ERHIFormat::BC3_UNorm_SRGB:
+		TextureCompressor::EncodeBC3(Texels, Block);
+		break;
+	case ERHIFormat::BC4_UNorm:
+		TextureCompressor::EncodeBC4(Texels, 0u, Block);
+		break;
+	case ERHIFormat::BC5_UNorm:
+		TextureCompressor::EncodeBC5(Texels, Block);
+		break;
+	case ERHIFormat::BC7_UNorm:
+	case ERHIFormat::BC7_UNorm_SRGB:
+		TextureCompressor::EncodeBC7(Texels, Block);
+		break;
+	default:
+		assert(false);
+		break;
+	}
+}
+
+static void DecodeBlock(const uint8_t* Block, ERHIFormat Format, uint8_t* Texels)
+{
+	switch (Format)
+	{
+	case ERHIFormat::BC1_UNorm:
+	case ERHIFormat::BC1_UNorm_SRGB:
+		TextureCompressor::DecodeBC1(Block, Texels);
+		break;
+	case ERHIFormat::BC3_UNorm:
+	case ERHIFormat::BC3_UNorm_SRGB:
+		TextureCompressor::DecodeBC3(Block, Texels);
+		break;
+	case ERHIFormat::BC4_UNorm:
+		for (uint32_t Index = 0u; Index < TextureCompressor::NumBlockTexels; ++Index)
+		{
+			Texels[Index * 4u + 1u] = Texels[Index * 4u + 2u] = 0u;
+			Texels[Index * 4u + 3u] = 255u;
+		}
+		TextureCompressor::DecodeBC4(Block, 0u, Texels);
+		break;
+	case ERHIFormat::BC5_UNorm:
+		TextureCompressor::DecodeBC5(Block, Texels);
+		break;
+	case ERHIFormat::BC7_UNorm:
+	case ERHIFormat::BC7_UNorm_SRGB:
+		TextureCompressor::DecodeBC7(Block, Texels);
+		break;
+	default:
+		assert(false);
+		break;
+	}
+}
+
+void TextureCompressor::Compress(const uint8_t* Texels, uint32_t Width, uint32_t Height, ERHIFormat Format, std::byte* Out)
+{
+	assert(IsSupportedFormat(Format) && Width && Height);
+
+	const uint32_t BlockSize = GetBlockSize(Format);
+	const uint32_t NumBlocksX = (Width + BlockDimension - 1u) / BlockDimension;
+	const uint32_t NumBlocksY = (Height + BlockDimension - 1u) / BlockDimension;
+
+	std::vector<uint32_t> BlockRows(NumBlocksY);
+	std::iota(BlockRows.begin(), BlockRows.end(), 0u);
+
+	TFTask::CorunParallelFor(BlockRows.begin(), BlockRows.end(), [=](uint32_t BlockY) {
+		uint8_t BlockTexels[NumBlockTexels * 4u];
+
+		for (uint32_t BlockX = 0u; BlockX < NumBlocksX; ++BlockX)
+		{
+			for (uint32_t Y = 0u; Y < BlockDimension; ++Y)
+			{
+				const uint32_t SourceY = std::min(BlockY * BlockDimension + Y, Height - 1u);
+				for (uint32_t X = 0u; X < BlockDimension; ++X)
+				{
+					const uint32_t SourceX = std::min(BlockX * BlockDimension + X, Width - 1u);
+					VERIFY(memcpy_s(BlockTexels + (Y * BlockDimension + X) * 4u, 4u, Texels + (static_cast<size_t>(SourceY) * Width + SourceX) * 4u, 4u) == 0);
+				}
+			}
+
+			EncodeBlock(BlockTexels, Format, reinterpret_cast<uint8_t*>(Out) + (static_cast<size_t>(BlockY) * NumBlocksX + BlockX) * BlockSize);
+		}
+	});
+}
+
+void TextureCompressor::Decompress(const std::byte* Blocks, uint32_t Width, uint32_t Height, ERHIFormat Format, uint8_t* OutTexels)
+{
+	assert(IsSupportedFormat(Format) && Width && Height);
+
+	const uint32_t BlockSize = GetBlockSize(Format);
+	const uint32_t NumBlocksX = (Width + BlockDimension - 1u) / BlockDimension;
+	const uint32_t NumBlocksY = (Height + BlockDimension - 1u) / BlockDimension;
+
+	uint8_t BlockTexels[NumBlockTexels * 4u];
+
+	for (uint32_t BlockY = 0u; BlockY < NumBlocksY; ++BlockY)
+	{
+		for (uint32_t BlockX = 0u; BlockX < NumBlocksX; ++BlockX)
+		{
+			DecodeBlock(reinterpret_cast<const uint8_t*>(Blocks) + (static_cast<size_t>(BlockY) * NumBlocksX + BlockX) * BlockSize, Format, BlockTexels);
+
+			for (uint32_t Y = 0u; Y < BlockDimension && BlockY * BlockDimension + Y < Height; ++Y)
+			{
+				for (uint32_t X = 0u; X < BlockDimension && BlockX * BlockDimension + X < Width; ++X)
+				{
+					const size_t Target = (static_cast<size_t>(BlockY * BlockDimension + Y) * Width + BlockX * BlockDimension + X) * 4u;
+					VERIFY(memcpy_s(OutTexels + Target, 4u, BlockTexels + (Y * BlockDimension + X) * 4u, 4u) == 0);
+				}
+			}
+		}
+	}
+}
+
+float TextureCompressor::ComputePSNR(const uint8_t* Reference, const uint8_t* Test, size_t NumTexels, uint32_t ChannelMask)
+{
+	uint64_t SquaredError = 0u;
+	uint32_t NumChannels = 0u;
+
+	for (uint32_t Channel = 0u; Channel < 4u; ++Channel)
+	{
+		if ((ChannelMask & (1u << Channel)) == 0u)
+		{
+			continue;
+		}
+
+		++NumChannels;
+		for (size_t Index = 0u; Index < NumTexels; ++Index)
+		{
+			const int32_t Delta = static_cast<int32_t>(Reference[Index * 4u + Channel]) - Test[Index * 4u + Channel];
+			SquaredError += static_cast<uint64_t>(Delta * Delta);
+		}
+	}
+
+	if (SquaredError == 0u || NumChannels == 0u)
+	{
+		return std::numeric_limits<float>::infinity();
+	}
+
+	const double MeanSquaredError = static_cast<double>(SquaredError) / (static_cast<double>(NumTexels) * NumChannels);
+	return static_cast<float>(10.0 * std::log10(255.0 * 255.0 / MeanSquaredError));
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "RHI/RHIFormat.h"
+
+/// Block compression of 8 bit RGBA images. Blocks are 4x4 texels, row major, four bytes per texel.
+/// BC1 and BC7 fit endpoints along the principal axis of the block colors and refine them with one least squares pass,
+/// BC7 only emits mode 6, a single subset with 7.7.7.7 endpoints, p-bits and 4 bit indices, which suits smooth content best.
+class TextureCompressor
+{
+public:
+	static constexpr uint32_t BlockDimension = 4u;
+	static constexpr uint32_t NumBlockTexels = BlockDimension * BlockDimension;
+
+	static bool IsSupportedFormat(ERHIFormat Format);
+
+	/// Bytes of one compressed block.
+	static uint32_t GetBlockSize(ERHIFormat Format);
+
+	/// Compresses a Width x Height RGBA8 image, block rows are encoded in parallel. Partial edge blocks repeat the last texel.
+	/// Out receives GetFormatAttributes(Width, Height, Format).SlicePitch bytes.
+	static void Compress(const uint8_t* Texels, uint32_t Width, uint32_t Height, ERHIFormat Format, std::byte* Out);
+
+	/// Inverse of Compress, channels the format does not store decode as 0, alpha as 255.
+	static void Decompress(const std::byte* Blocks, uint32_t Width, uint32_t Height, ERHIFormat Format, uint8_t* OutTexels);
+
+	/// Peak signal to noise ratio in dB over the channels set in ChannelMask, bit 0 is red. Identical images return infinity.
+	static float ComputePSNR(const uint8_t* Reference, const uint8_t* Test, size_t NumTexels, uint32_t ChannelMask = 0xFu);
+
+	static void EncodeBC1(const uint8_t* Texels, uint8_t* Block);
+	static void EncodeBC3(const uint8_t* Texels, uint8_t* Block);
+	static void EncodeBC7(const uint8_t* Texels, uint8_t* Block);
+
+	/// Encodes channel Channel of the texels.
+	static void EncodeBC4(const uint8_t* Texels, uint32_t Channel, uint8_t* Block);
+	static void EncodeBC5(const uint8_t* Texels, uint8_t* Block);
+
+	static void DecodeBC1(const uint8_t* Block, uint8_t* Texels);
+	static void DecodeBC3(const uint8_t* Block, uint8_t* Texels);
+	static void DecodeBC4(const uint8_t* Block, uint32_t Channel, uint8_t* Texels);
+	static void DecodeBC5(const uint8_t* Block, uint8_t* Texels);
+
+	/// Mode 6 blocks only, other modes decode as transparent black.
+	static void DecodeBC7(const uint8_t* Block, uint8_t* Texels);
+};
@@ -1,6 +1,12 @@
 #include "Asset/AssetLoaders/TextureLoader.h"
+#include "Asset/AssetLoaders/TextureProcessor.h"
+#include "Asset/AssetLoaders/TextureCompressor.h"
+#include "Asset/AssetLoaders/CookedTexture.h"
+#include "Asset/VirtualFileSystem.h"
 #include "Asset/Texture.h"
 #include "Services/SpdLogService.h"
+#include "Core/ConsoleVariable.h"
+#include "Profile/CpuTimer.h"
 
 #include <Asset/DDS.h>
 #include <dxgiformat.h>
@@ -9,6 +15,66 @@
 #include <Submodules/stb/stb_image.h>
 #pragma warning(default:4244)
 
+ConsoleVariable<uint32_t> CVarTextureStreamingTailMipSize(
+	"r.streaming.tail_mip_size",
+	"Mips up to this size are always resident, larger mips of 2D textures are streamed on demand.",
+	64u);
+
+ConsoleVariable<bool> CVarTextureCompression(
+	"asset.texture_compression",
+	"Block compress imported images, BC1/BC3/BC7 for color, BC4 for masks and BC5 for normal maps.",
+	true);
+
+ConsoleVariable<bool> CVarTextureBC7(
+	"asset.texture_bc7",
+	"Compress color images to BC7 instead of BC1 or BC3.",
+	true);
+
+ConsoleVariable<uint32_t> CVarTextureMipFilter(
+	"asset.texture_mip_filter",
+	"Filter of generated mips, 0 is box and 1 is Kaiser.",
+	1u);
+
+ConsoleVariable<bool> CVarUseCookedTexture(
+	"asset.use_cooked_texture",
+	"Load processed images from the cooked texture cache when it is up to date, and write the cache after processing.",
+	true);
+
+ConsoleVariable<bool> CVarTextureLogQuality(
+	"asset.texture_log_quality",
+	"Log the PSNR of the top mip and the encoding throughput of every processed image.",
+	false);
+
+/// KTX 2.0 header and index, followed by one level index entry per mip. Data of supercompressed files is not block data.
+struct KTX2Header
+{
+	uint8_t Identifier[12u];
+	uint32_t VkFormat;
+	uint32_t TypeSize;
+	uint32_t PixelWidth;
+	uint32_t PixelHeight;
+	uint32_t PixelDepth;
+	uint32_t LayerCount;
+	uint32_t FaceCount;
+	uint32_t LevelCount;
+	uint32_t SupercompressionScheme;
+
+	uint32_t DFDByteOffset;
+	uint32_t DFDByteLength;
+	uint32_t KVDByteOffset;
+	uint32_t KVDByteLength;
+	uint64_t SGDByteOffset;
+	uint64_t SGDByteLength;
+};
+static_assert(sizeof(KTX2Header) == 80u);
+
+struct KTX2LevelIndex
+{
+	uint64_t ByteOffset;
+	uint64_t ByteLength;
+	uint64_t UncompressedByteLength;
+};
+
 static DXGI_FORMAT GetDXGIFormat(const DirectX::DDS_PIXELFORMAT& PixelFormat)
 {
 #define GET_FORMAT_BITMASK(R, G, B, A, Format) \
@@ -132,15 +198,19 @@ TextureLoader::TextureLoader()
 		".tga",
 		".psd",
 		".hdr",
-		GetDDSExtension()
+		GetDDSExtension(),
+		GetKTX2Extension()
 	})
 {
 	LOG_INFO(LogAsset, "Use stb_image @2.3");
 }
 
-std::shared_ptr<Asset> TextureLoader::CreateAsset(const std::filesystem::path& Path)
+std::shared_ptr<Asset> TextureLoader::CreateAsset(const std::filesystem::path& Path, uint32_t Settings)
 {
-	return std::make_shared<Texture>(Path);
+	/// The usage picks the processing settings, and with them the derived data key.
+	auto Image = std::make_shared<Texture>(Path);
+	Image->SetUsage(static_cast<ETextureUsage>(Settings));
+	return Image;
 }
 
 bool TextureLoader::Load(Asset& Target)
@@ -148,18 +218,100 @@ bool TextureLoader::Load(Asset& Target)
 	auto& Image = Cast<Texture>(Target);
 	Image.GetDesc().SetBulkData(Image.LoadData());
 
-	return IsDDSTexture(Target.GetExtension()) ? LoadDDS(Image) : LoadStb(Image);
+	if (IsDDSTexture(Target.GetExtension()))
+	{
+		return LoadDDS(Image);
+	}
+	else if (IsKTX2Texture(Target.GetExtension()))
+	{
+		return LoadKTX2(Image);
+	}
+
+	return LoadStb(Image);
+}
+
+static TextureProcessingSettings GetProcessingSettings(ETextureUsage Usage)
+{
+	TextureProcessingSettings Settings;
+	Settings.Usage = Usage;
+	Settings.MipFilter = CVarTextureMipFilter.Get() == 0u ? EMipFilter::Box : EMipFilter::Kaiser;
+	Settings.Compress = CVarTextureCompression.Get();
+	Settings.UseBC7 = CVarTextureBC7.Get();
+	return Settings;
+}
+
+/// Throughput is in megabytes of RGBA8 input over all mips, the PSNR compares the decoded top mip to its uncompressed texels.
+static void LogQuality(const Texture& Image, const std::vector<TextureImage>& Mips, bool SRGB, float EncodeSeconds)
+{
+	size_t NumTexels = 0u;
+	for (const auto& Mip : Mips)
+	{
+		NumTexels += Mip.GetNumTexels();
+	}
+
+	const auto& TopMip = Mips[0];
+	const float Throughput = EncodeSeconds > 0.0f ? NumTexels * 4.0f / (1024.0f * 1024.0f) / EncodeSeconds : 0.0f;
+
+	if (!TextureCompressor::IsSupportedFormat(Image.GetFormat()))
+	{
+		LOG_INFO(LogAsset, "Processed texture \"{}\" to {}, {:.1f} MB/s", Image.GetName(), magic_enum::enum_name(Image.GetFormat()), Throughput);
+		return;
+	}
+
+	std::vector<uint8_t> Reference(TopMip.GetNumTexels() * 4u);
+	std::vector<uint8_t> Decoded(Reference.size());
+	TextureProcessor::ToRGBA8(TopMip, SRGB, Reference.data());
+	TextureCompressor::Decompress(Image.GetBulkData().GetRawData(), TopMip.Width, TopMip.Height, Image.GetFormat(), Decoded.data());
+
+	uint32_t ChannelMask = 0xFu;
+	switch (Image.GetFormat())
+	{
+	case ERHIFormat::BC1_UNorm:
+	case ERHIFormat::BC1_UNorm_SRGB:
+		ChannelMask = 0x7u;
+		break;
+	case ERHIFormat::BC4_UNorm:
+		ChannelMask = 0x1u;
+		break;
+	case ERHIFormat::BC5_UNorm:
+		ChannelMask = 0x3u;
+		break;
+	}
 
+	LOG_INFO(LogAsset, "Processed texture \"{}\" to {}, PSNR {:.2f} dB, {:.1f} MB/s", Image.GetName(), magic_enum::enum_name(Image.GetFormat()),
+		TextureCompressor::ComputePSNR(Reference.data(), Decoded.data(), TopMip.GetNumTexels(), ChannelMask), Throughput);
 }
 
 bool TextureLoader::LoadStb(Texture& Image)
 {
 	auto& Desc = Image.GetDesc();
 
-	auto const DataSize = static_cast<int32_t>(Desc.BulkData->GetSize());
-	auto Data = reinterpret_cast<const stbi_uc*>(Desc.BulkData->GetRawData());
+	/// Keep the raw file alive until the processed data replaces it.
+	auto Source = Desc.BulkData;
+	auto const DataSize = static_cast<int32_t>(Source->GetSize());
+	auto Data = reinterpret_cast<const stbi_uc*>(Source->GetRawData());
 
-	int32_t Width = 0, Height = 0, Channels = 0, OriginalChannels = STBI_default;
+	const auto Settings = GetProcessingSettings(Image.GetUsage());
+	const uint64_t SettingsHash = ComputeHash(Settings.Usage, Settings.MipFilter, Settings.GenerateMips, Settings.Compress, Settings.UseBC7);
+	const auto CookedKey = CookedTexture::GetKey(Image.GetContentHash(), SettingsHash);
+	const auto CookedPath = DerivedDataCache::Get().GetPath(CookedKey);
+	const bool UseCooked = CVarUseCookedTexture.Get();
+
+	Desc.SetDepth(1u)
+		.SetNumArrayLayer(1u)
+		.SetDimension(ERHITextureDimension::T_2D)
+		.SetUsages(ERHIBufferUsageFlags::ShaderResource)
+		.SetPermanentState(ERHIResourceState::ShaderResource)
+		.SetName(Image.GetName());
+
+	size_t MipDataOffset = 0u;
+	if (UseCooked && CookedTexture::Load(Desc, CookedKey, MipDataOffset))
+	{
+		Image.InitializeMips(CookedPath, MipDataOffset, CVarTextureStreamingTailMipSize.Get());
+		return true;
+	}
+
+	int32_t Width = 0, Height = 0, OriginalChannels = STBI_default;
 
 	if (!stbi_info_from_memory(Data, DataSize, &Width, &Height, &OriginalChannels))
 	{
@@ -167,91 +319,212 @@ bool TextureLoader::LoadStb(Texture& Image)
 		return false;
 	}
 
-	stbi_uc* Bitmap = nullptr;
-	bool IsHDR = stbi_is_hdr_from_memory(Data, DataSize);
-	Channels = OriginalChannels == STBI_rgb ? STBI_rgb_alpha : OriginalChannels;
+	/// Always expand to four channels, the GPU formats have no three channel variants and grey images become grey RGB.
+	const bool IsHDR = stbi_is_hdr_from_memory(Data, DataSize);
+	const bool SRGB = !IsHDR && Settings.Usage == ETextureUsage::Color;
+	bool HasAlpha = false;
 
+	TextureImage TopMip;
 	if (IsHDR)
 	{
-		if (auto Pixels = stbi_loadf_from_memory(Data, DataSize, &Width, &Height, &OriginalChannels, Channels))
+		auto Pixels = stbi_loadf_from_memory(Data, DataSize, &Width, &Height, &OriginalChannels, STBI_rgb_alpha);
+		if (Pixels)
 		{
-			Bitmap = reinterpret_cast<stbi_uc*>(Pixels);
+			TopMip = TextureProcessor::FromRGBA32F(Pixels, Width, Height);
+			stbi_image_free(Pixels);
 		}
 	}
 	else
 	{
-		Bitmap = stbi_load_from_memory(Data, DataSize, &Width, &Height, &OriginalChannels, Channels);
+		auto Pixels = stbi_load_from_memory(Data, DataSize, &Width, &Height, &OriginalChannels, STBI_rgb_alpha);
+		if (Pixels)
+		{
+			if (OriginalChannels == STBI_grey_alpha || OriginalChannels == STBI_rgb_alpha)
+			{
+				for (size_t Index = 3u; Index < static_cast<size_t>(Width) * Height * 4u && !HasAlpha; Index += 4u)
+				{
+					HasAlpha = Pixels[Index] != 255u;
+				}
+			}
+
+			TopMip = TextureProcessor::FromRGBA8(Pixels, Width, Height, SRGB);
+			stbi_image_free(Pixels);
+		}
 	}
 
-	if (!Bitmap)
+	if (TopMip.Pixels.empty())
 	{
 		LOG_ERROR(LogAsset, "Failed to load image \"{}\": {}", Image.GetPath().string(), stbi_failure_reason());
 		return false;
 	}
 
+	const ERHIFormat Format = TextureProcessor::GetTargetFormat(Settings, TopMip.Width, TopMip.Height, IsHDR, HasAlpha);
+
+	std::vector<TextureImage> Mips;
+	if (Settings.GenerateMips)
+	{
+		Mips = TextureProcessor::GenerateMips(std::move(TopMip), Settings.MipFilter, Settings.Usage == ETextureUsage::Normal);
+	}
+	else
+	{
+		Mips.emplace_back(std::move(TopMip));
+	}
+
+	CpuTimer Timer;
 	Desc.SetWidth(Width)
 		.SetHeight(Height)
-		.SetDimension(ERHITextureDimension::T_2D)
-		.SetFormat(Desc.IsLinear ? ERHIFormat::RGBA8_UNorm : ERHIFormat::RGBA8_UNorm_SRGB)
-		.SetUsages(ERHIBufferUsageFlags::ShaderResource)
-		.SetPermanentState(ERHIResourceState::ShaderResource)
-		.SetName(Image.GetName());
+		.SetNumMipLevel(static_cast<uint32_t>(Mips.size()))
+		.SetFormat(Format)
+		.SetBulkData(TextureProcessor::Encode(Mips, Format, SRGB));
+
+	if (CVarTextureLogQuality.Get())
+	{
+		LogQuality(Image, Mips, SRGB, Timer.GetElapsedSeconds());
+	}
+
+	/// Without the cache there is no file to stream mips from, every mip stays resident.
+	MipDataOffset = UseCooked ? CookedTexture::Save(Desc, CookedKey) : 0u;
+	Image.InitializeMips(MipDataOffset ? CookedPath : std::filesystem::path(), MipDataOffset, CVarTextureStreamingTailMipSize.Get());
 
 	return true;
 }
 
+/// Resource limits every backend supports. Headers are checked against them before any size is derived from the header fields.
+static bool IsWithinTextureLimits(const RHITextureDesc& Desc)
+{
+	if (Desc.Width == 0u || Desc.Height == 0u || Desc.Depth == 0u || Desc.NumArrayLayer == 0u ||
+		Desc.NumMipLevel == 0u || Desc.NumMipLevel > D3D11_REQ_MIP_LEVELS)
+	{
+		return false;
+	}
+
+	switch (Desc.Dimension)
+	{
+	case ERHITextureDimension::T_1D:
+	case ERHITextureDimension::T_1D_Array:
+		return Desc.NumArrayLayer <= D3D11_REQ_TEXTURE1D_ARRAY_AXIS_DIMENSION &&
+			Desc.Width <= D3D11_REQ_TEXTURE1D_U_DIMENSION &&
+			Desc.Height == 1u &&
+			Desc.Depth == 1u;
+	case ERHITextureDimension::T_2D:
+	case ERHITextureDimension::T_2D_Array:
+		return Desc.NumArrayLayer <= D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION &&
+			Desc.Width <= D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION &&
+			Desc.Height <= D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION &&
+			Desc.Depth == 1u;
+	case ERHITextureDimension::T_Cube:
+	case ERHITextureDimension::T_Cube_Array:
+		return Desc.NumArrayLayer <= D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION &&
+			Desc.NumArrayLayer % 6u == 0u &&
+			Desc.Width <= D3D11_REQ_TEXTURECUBE_DIMENSION &&
+			Desc.Height == Desc.Width &&
+			Desc.Depth == 1u;
+	case ERHITextureDimension::T_3D:
+		return Desc.NumArrayLayer == 1u &&
+			Desc.Width <= D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION &&
+			Desc.Height <= D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION &&
+			Desc.Depth <= D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION;
+	default:
+		return false;
+	}
+}
+
+/// Subresources are packed layer by layer, each layer holds the full mip chain and each mip all of its depth slices.
+/// Fails if the size does not fit into size_t, e.g. for 32 bit builds.
+static bool GetPackedSubresourcesSize(const RHITextureDesc& Desc, size_t& OutSize)
+{
+	constexpr size_t MaxSize = std::numeric_limits<size_t>::max();
+
+	size_t LayerSize = 0u;
+	for (uint32_t Mip = 0u; Mip < Desc.NumMipLevel; ++Mip)
+	{
+		const uint32_t Width = std::max(Desc.Width >> Mip, 1u);
+		const uint32_t Height = std::max(Desc.Height >> Mip, 1u);
+		const uint32_t Depth = std::max(Desc.Depth >> Mip, 1u);
+		const size_t SlicePitch = RHI::GetFormatAttributes(Width, Height, Desc.Format).SlicePitch;
+
+		if (SlicePitch > MaxSize / Depth || SlicePitch * Depth > MaxSize - LayerSize)
+		{
+			return false;
+		}
+		LayerSize += SlicePitch * Depth;
+	}
+
+	if (LayerSize > MaxSize / Desc.NumArrayLayer)
+	{
+		return false;
+	}
+
+	OutSize = LayerSize * Desc.NumArrayLayer;
+	return true;
+}
+
+/// Bulk data viewing a range of the loaded file, it keeps the whole file alive.
+static std::shared_ptr<DataBlock> MakeFileView(const std::shared_ptr<DataBlock>& File, size_t Offset, size_t Size)
+{
+	return std::make_shared<DataBlock>(File->Slice(Offset, Size));
+}
+
 bool TextureLoader::LoadDDS(Texture& Image)
 {
 	auto& Desc = Image.GetDesc();
+	auto File = Desc.BulkData;
 
-	auto const DataSize = static_cast<int32_t>(Desc.BulkData->GetSize());
-	auto Data = reinterpret_cast<const uint8_t*>(Desc.BulkData->GetRawData());
+	const size_t DataSize = File->GetSize();
+	auto Data = reinterpret_cast<const uint8_t*>(File->GetRawData());
 
-	assert(DataSize >= (sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER)));
-	assert(*reinterpret_cast<const uint32_t*>(Data) == DirectX::DDS_MAGIC);
+	if (DataSize < sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER) || *reinterpret_cast<const uint32_t*>(Data) != DirectX::DDS_MAGIC)
+	{
+		LOG_ERROR(LogAsset, "\"{}\" is not a DDS file", Image.GetPath().string());
+		return false;
+	}
 
-	bool DXT10Header = false;
 	auto Header = reinterpret_cast<const DirectX::DDS_HEADER*>(Data + sizeof(uint32_t));
-	assert(Header->size == sizeof(DirectX::DDS_HEADER) && Header->ddspf.size == sizeof(DirectX::DDS_PIXELFORMAT));
-	if ((Header->ddspf.flags & DDS_FOURCC) && (Header->ddspf.fourCC == MAKEFOURCC('D', 'X', '1', '0')))
+	if (Header->size != sizeof(DirectX::DDS_HEADER) || Header->ddspf.size != sizeof(DirectX::DDS_PIXELFORMAT))
+	{
+		LOG_ERROR(LogAsset, "Corrupted header of DDS file \"{}\"", Image.GetPath().string());
+		return false;
+	}
+
+	const bool DXT10Header = (Header->ddspf.flags & DDS_FOURCC) && (Header->ddspf.fourCC == MAKEFOURCC('D', 'X', '1', '0'));
+	if (DXT10Header && DataSize < sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER) + sizeof(DirectX::DDS_HEADER_DXT10))
 	{
-		assert(DataSize >= (sizeof(DirectX::DDS_HEADER) + sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER_DXT10)));
-		DXT10Header = true;
+		LOG_ERROR(LogAsset, "Corrupted header of DDS file \"{}\"", Image.GetPath().string());
+		return false;
 	}
 
-	auto Offset = sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER) + (DXT10Header ? sizeof(DirectX::DDS_HEADER_DXT10) : 0u);
-	auto BitSize = DataSize - Offset;
-	auto BitData = Data + Offset;
-	bool Cubemap = false;
+	const size_t Offset = sizeof(uint32_t) + sizeof(DirectX::DDS_HEADER) + (DXT10Header ? sizeof(DirectX::DDS_HEADER_DXT10) : 0u);
 
 	Desc.SetWidth(Header->width)
-		.SetHeight(Header->height)
+		.SetHeight(Header->height == 0u ? 1u : Header->height)
 		.SetDepth(Header->depth == 0u ? 1u : Header->depth)
 		.SetNumMipLevel(Header->mipMapCount == 0u ? 1u : Header->mipMapCount)
+		.SetNumArrayLayer(1u)
 		.SetUsages(ERHIBufferUsageFlags::ShaderResource)
 		.SetPermanentState(ERHIResourceState::ShaderResource)
-		.SetBulkData(BitSize, BitData);
-	assert(Desc.NumMipLevel <= D3D11_REQ_MIP_LEVELS);
+		.SetName(Image.GetName());
 
 	if (DXT10Header)
 	{
 		auto DXTHeader = reinterpret_cast<const DirectX::DDS_HEADER_DXT10*>(reinterpret_cast<const uint8_t*>(Header) + sizeof(DirectX::DDS_HEADER));
-		assert(DXTHeader && DXTHeader->arraySize);
+		/// Cubemaps multiply the array size by 6, it is bounded before.
+		if (DXTHeader->arraySize == 0u ||
+			DXTHeader->arraySize > D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION ||
+			DXTHeader->dxgiFormat == DXGI_FORMAT_AI44 ||
+			DXTHeader->dxgiFormat == DXGI_FORMAT_IA44 ||
+			DXTHeader->dxgiFormat == DXGI_FORMAT_P8 ||
+			DXTHeader->dxgiFormat == DXGI_FORMAT_A8P8)
+		{
+			LOG_ERROR(LogAsset, "Unsupported DX10 header of DDS file \"{}\"", Image.GetPath().string());
+			return false;
+		}
 
-		Desc.SetNumArrayLayer(DXTHeader->arraySize);
-		assert(DXTHeader->dxgiFormat != DXGI_FORMAT_AI44 &&
-			DXTHeader->dxgiFormat != DXGI_FORMAT_IA44 &&
-			DXTHeader->dxgiFormat != DXGI_FORMAT_P8 &&
-			DXTHeader->dxgiFormat != DXGI_FORMAT_A8P8);
+		Desc.SetNumArrayLayer(DXTHeader->arraySize)
+			.SetFormat(RHI::GetRHIFormat(DXTHeader->dxgiFormat));
 
-		Desc.SetFormat(RHI::GetRHIFormat(DXTHeader->dxgiFormat));
 		switch (DXTHeader->resourceDimension)
 		{
 		case D3D11_RESOURCE_DIMENSION_TEXTURE1D:
-			if (Header->flags & DDS_HEIGHT)
-			{
-				assert(Desc.Height == 1u);
-			}
 			Desc.SetHeight(1u)
 				.SetDepth(1u)
 				.SetDimension(Desc.NumArrayLayer > 1u ? ERHITextureDimension::T_1D_Array : ERHITextureDimension::T_1D);
@@ -261,7 +534,6 @@ bool TextureLoader::LoadDDS(Texture& Image)
 			{
 				Desc.SetDimension(Desc.NumArrayLayer > 1u ? ERHITextureDimension::T_Cube_Array : ERHITextureDimension::T_Cube)
 					.SetNumArrayLayer(Desc.NumArrayLayer * 6u);
-				Cubemap = true;
 			}
 			else
 			{
@@ -270,12 +542,16 @@ bool TextureLoader::LoadDDS(Texture& Image)
 			Desc.SetDepth(1u);
 			break;
 		case D3D11_RESOURCE_DIMENSION_TEXTURE3D:
-			assert(Header->flags & DDS_HEADER_FLAGS_VOLUME);
+			if (!(Header->flags & DDS_HEADER_FLAGS_VOLUME) || Desc.NumArrayLayer != 1u)
+			{
+				LOG_ERROR(LogAsset, "Corrupted volume texture in DDS file \"{}\"", Image.GetPath().string());
+				return false;
+			}
 			Desc.SetDimension(ERHITextureDimension::T_3D);
 			break;
-		case D3D11_RESOURCE_DIMENSION_BUFFER:
-			Desc.SetDimension(ERHITextureDimension::Buffer);
-			break;
+		default:
+			LOG_ERROR(LogAsset, "Unsupported resource dimension of DDS file \"{}\"", Image.GetPath().string());
+			return false;
 		}
 	}
 	else
@@ -286,46 +562,169 @@ bool TextureLoader::LoadDDS(Texture& Image)
 		{
 			Desc.SetDimension(ERHITextureDimension::T_3D);
 		}
-		else
+		else if (Header->caps2 & DDS_CUBEMAP)
 		{
-			if (Header->caps2 & DDS_CUBEMAP)
-			{
-				assert((Header->caps2 & DDS_CUBEMAP_ALLFACES) == DDS_CUBEMAP_ALLFACES);
-				Cubemap = true;
-				Desc.SetDimension(ERHITextureDimension::T_Cube)
-					.SetNumArrayLayer(Desc.NumArrayLayer * 6u);
-			}
-			else
+			/// Legacy headers can describe a subset of the faces, which has no GPU equivalent.
+			if ((Header->caps2 & DDS_CUBEMAP_ALLFACES) != DDS_CUBEMAP_ALLFACES)
 			{
-				Desc.SetDimension(Desc.NumArrayLayer > 1u ? ERHITextureDimension::T_2D_Array : ERHITextureDimension::T_2D);
+				LOG_ERROR(LogAsset, "Partial cubemap in DDS file \"{}\" is not supported", Image.GetPath().string());
+				return false;
 			}
+
+			Desc.SetDimension(ERHITextureDimension::T_Cube)
+				.SetDepth(1u)
+				.SetNumArrayLayer(6u);
+		}
+		else
+		{
+			Desc.SetDimension(ERHITextureDimension::T_2D)
+				.SetDepth(1u);
 		}
 	}
 
-	switch (Desc.Dimension)
+	if (Desc.Format == ERHIFormat::Unknown)
 	{
-	case ERHITextureDimension::T_2D:
-	case ERHITextureDimension::T_2D_Array:
-		assert(
-			Desc.NumArrayLayer <= D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION &&
-			Desc.Width <= D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION &&
-			Desc.Height <= D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION);
-		break;
-	case ERHITextureDimension::T_Cube:
-	case ERHITextureDimension::T_Cube_Array:
-		assert(
-			Desc.NumArrayLayer <= D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION &&
-			Desc.Width <= D3D11_REQ_TEXTURECUBE_DIMENSION &&
-			Desc.Height <= D3D11_REQ_TEXTURECUBE_DIMENSION);
-		break;
-	case ERHITextureDimension::T_3D:
-		assert(
-			Desc.NumArrayLayer == 1u &&
-			Desc.Width <= D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION &&
-			Desc.Height <= D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION &&
-			Desc.Depth <= D3D11_REQ_TEXTURE3D_U_V_OR_W_DIMENSION);
-		break;
+		LOG_ERROR(LogAsset, "Unsupported pixel format of DDS file \"{}\"", Image.GetPath().string());
+		return false;
+	}
+
+	if (!IsWithinTextureLimits(Desc))
+	{
+		LOG_ERROR(LogAsset, "DDS file \"{}\" exceeds the texture limits, {}x{}x{} with {} mips and {} layers", Image.GetPath().string(),
+			Desc.Width, Desc.Height, Desc.Depth, Desc.NumMipLevel, Desc.NumArrayLayer);
+		return false;
+	}
+
+	/// DDS stores the subresources in the packed order the upload expects, the bulk data is a view of the file.
+	size_t PixelsSize = 0u;
+	if (!GetPackedSubresourcesSize(Desc, PixelsSize) || PixelsSize > DataSize - Offset)
+	{
+		LOG_ERROR(LogAsset, "DDS file \"{}\" is truncated", Image.GetPath().string());
+		return false;
+	}
+
+	Desc.SetBulkData(MakeFileView(File, Offset, PixelsSize));
+
+	/// Mips stream from a memory mapping of the file, which a packed file does not have.
+	const bool Streamable = VirtualFileSystem::Get().IsLooseFile(Image.GetPath());
+	Image.InitializeMips(Streamable ? Image.GetPath() : std::filesystem::path(), Offset, CVarTextureStreamingTailMipSize.Get());
+
+	return true;
+}
+
+bool TextureLoader::LoadKTX2(Texture& Image)
+{
+	static constexpr uint8_t Identifier[12u] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+	auto& Desc = Image.GetDesc();
+	const size_t DataSize = Desc.BulkData->GetSize();
+	auto Data = reinterpret_cast<const uint8_t*>(Desc.BulkData->GetRawData());
+
+	if (DataSize < sizeof(KTX2Header) || memcmp(Data, Identifier, sizeof(Identifier)) != 0)
+	{
+		LOG_ERROR(LogAsset, "\"{}\" is not a KTX2 file", Image.GetPath().string());
+		return false;
+	}
+
+	const auto& Header = *reinterpret_cast<const KTX2Header*>(Data);
+	if (Header.SupercompressionScheme != 0u)
+	{
+		LOG_ERROR(LogAsset, "Supercompressed KTX2 file \"{}\" is not supported", Image.GetPath().string());
+		return false;
+	}
+
+	const ERHIFormat Format = Header.VkFormat != VK_FORMAT_UNDEFINED ? RHI::GetRHIFormat(static_cast<vk::Format>(Header.VkFormat)) : ERHIFormat::Unknown;
+	if (Format == ERHIFormat::Unknown)
+	{
+		LOG_ERROR(LogAsset, "Unsupported format {} of KTX2 file \"{}\"", Header.VkFormat, Image.GetPath().string());
+		return false;
+	}
+
+	const bool IsCube = Header.FaceCount == 6u;
+	if (Header.PixelWidth == 0u ||
+		Header.LayerCount > D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION ||
+		(Header.FaceCount != 1u && !IsCube) ||
+		(IsCube && (Header.PixelDepth != 0u || Header.PixelHeight != Header.PixelWidth)) ||
+		(Header.PixelDepth != 0u && (Header.PixelHeight == 0u || Header.LayerCount != 0u)))
+	{
+		LOG_ERROR(LogAsset, "Corrupted header of KTX2 file \"{}\"", Image.GetPath().string());
+		return false;
+	}
+
+	/// A level count of 0 asks the loader to generate mips, only the top level is stored.
+	const uint32_t NumLevels = std::max(Header.LevelCount, 1u);
+	const uint32_t NumLayers = std::max(Header.LayerCount, 1u) * Header.FaceCount;
+	if (NumLevels > D3D11_REQ_MIP_LEVELS || DataSize < sizeof(KTX2Header) + sizeof(KTX2LevelIndex) * NumLevels)
+	{
+		LOG_ERROR(LogAsset, "Corrupted level index of KTX2 file \"{}\"", Image.GetPath().string());
+		return false;
 	}
 
-	return false;
-}
\ No newline at end of file
+	ERHITextureDimension Dimension = ERHITextureDimension::T_2D;
+	if (Header.PixelDepth != 0u)
+	{
+		Dimension = ERHITextureDimension::T_3D;
+	}
+	else if (Header.PixelHeight == 0u)
+	{
+		Dimension = Header.LayerCount ? ERHITextureDimension::T_1D_Array : ERHITextureDimension::T_1D;
+	}
+	else if (IsCube)
+	{
+		Dimension = Header.LayerCount ? ERHITextureDimension::T_Cube_Array : ERHITextureDimension::T_Cube;
+	}
+	else if (Header.LayerCount)
+	{
+		Dimension = ERHITextureDimension::T_2D_Array;
+	}
+
+	Desc.SetWidth(Header.PixelWidth)
+		.SetHeight(std::max(Header.PixelHeight, 1u))
+		.SetDepth(std::max(Header.PixelDepth, 1u))
+		.SetNumMipLevel(NumLevels)
+		.SetNumArrayLayer(NumLayers)
+		.SetFormat(Format)
+		.SetDimension(Dimension)
+		.SetUsages(ERHIBufferUsageFlags::ShaderResource)
+		.SetPermanentState(ERHIResourceState::ShaderResource)
+		.SetName(Image.GetName());
+
+	if (!IsWithinTextureLimits(Desc))
+	{
+		LOG_ERROR(LogAsset, "KTX2 file \"{}\" exceeds the texture limits, {}x{}x{} with {} mips and {} layers", Image.GetPath().string(),
+			Desc.Width, Desc.Height, Desc.Depth, Desc.NumMipLevel, Desc.NumArrayLayer);
+		return false;
+	}
+
+	/// Every level holds its layers and faces back to back, each with all of its depth slices. The offsets point straight into
+	/// the file, which stays the bulk data.
+	auto Levels = reinterpret_cast<const KTX2LevelIndex*>(Data + sizeof(KTX2Header));
+	std::vector<size_t> SubresourceOffsets(static_cast<size_t>(NumLayers) * NumLevels);
+
+	for (uint32_t Level = 0u; Level < NumLevels; ++Level)
+	{
+		const uint32_t Width = std::max(Desc.Width >> Level, 1u);
+		const uint32_t Height = std::max(Desc.Height >> Level, 1u);
+		const uint32_t Depth = std::max(Desc.Depth >> Level, 1u);
+		const size_t ImageSize = RHI::GetFormatAttributes(Width, Height, Format).SlicePitch * Depth;
+
+		const auto& LevelIndex = Levels[Level];
+		if (LevelIndex.ByteLength < ImageSize * NumLayers || LevelIndex.ByteOffset > DataSize || LevelIndex.ByteLength > DataSize - LevelIndex.ByteOffset)
+		{
+			LOG_ERROR(LogAsset, "KTX2 file \"{}\" is truncated", Image.GetPath().string());
+			return false;
+		}
+
+		for (uint32_t Layer = 0u; Layer < NumLayers; ++Layer)
+		{
+			SubresourceOffsets[static_cast<size_t>(Layer) * NumLevels + Level] = static_cast<size_t>(LevelIndex.ByteOffset) + ImageSize * Layer;
+		}
+	}
+
+	Desc.SetSubresourceOffsets(std::move(SubresourceOffsets));
+
+	/// Levels are stored smallest first and interleave the layers, such textures keep every mip resident.
+	Image.InitializeMips(std::filesystem::path(), 0u, CVarTextureStreamingTailMipSize.Get());
+
+	return true;
+}
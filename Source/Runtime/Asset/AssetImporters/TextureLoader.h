@@ -8,16 +8,25 @@ public:
 	TextureLoader();
 
 	bool Load(Asset& Target) override final;
+
+	bool PrefetchData() const override final { return true; }
 protected:
 	static constexpr std::string_view GetDDSExtension() { return ".dds"; }
+	static constexpr std::string_view GetKTX2Extension() { return ".ktx2"; }
 
 	inline bool IsDDSTexture(const std::string& Extension)
 	{
-		return _stricmp(Extension.c_str(), GetDDSExtension().data());
+		return _stricmp(Extension.c_str(), GetDDSExtension().data()) == 0;
+	}
+
+	inline bool IsKTX2Texture(const std::string& Extension)
+	{
+		return _stricmp(Extension.c_str(), GetKTX2Extension().data()) == 0;
 	}
 
-	std::shared_ptr<Asset> CreateAsset(const std::filesystem::path& Path) override final;
+	std::shared_ptr<Asset> CreateAsset(const std::filesystem::path& Path, uint32_t Settings) override final;
 
 	bool LoadStb(class Texture& Image);
 	bool LoadDDS(class Texture& Image);
+	bool LoadKTX2(class Texture& Image);
 };
@@ -0,0 +1,345 @@
+#include "Asset/AssetLoaders/TextureProcessor.h"
+#include "Asset/AssetLoaders/TextureCompressor.h"
+#include "Core/Math/Quantization.h"
+#include "Async/Task.h"
+#include <DirectXMath.h>
+#include <numeric>
+
+using namespace DirectX;
+
+static constexpr float KaiserWidth = 3.0f;
+static constexpr float KaiserAlpha = 4.0f;
+
+/// Source texels contributing to one destination texel, starting at First. Indices wrap around the image.
+struct FilterTaps
+{
+	int32_t First = 0;
+	std::vector<float> Weights;
+};
+
+static float BesselI0(float X)
+{
+	const float HalfX = X * 0.5f;
+
+	float Sum = 1.0f;
+	float Term = 1.0f;
+	for (uint32_t K = 1u; K < 32u && Term > Sum * 1e-8f; ++K)
+	{
+		Term *= (HalfX / K) * (HalfX / K);
+		Sum += Term;
+	}
+
+	return Sum;
+}
+
+static float EvaluateKaiser(float X)
+{
+	const float Ratio = X / KaiserWidth;
+	if (std::fabs(Ratio) >= 1.0f)
+	{
+		return 0.0f;
+	}
+
+	const float Sinc = std::fabs(X) < 1e-5f ? 1.0f : std::sinf(XM_PI * X) / (XM_PI * X);
+	return Sinc * BesselI0(KaiserAlpha * std::sqrtf(1.0f - Ratio * Ratio)) / BesselI0(KaiserAlpha);
+}
+
+static std::vector<FilterTaps> ComputeFilterTaps(uint32_t InSize, uint32_t OutSize, EMipFilter Filter)
+{
+	const float Scale = static_cast<float>(InSize) / OutSize;
+
+	std::vector<FilterTaps> Taps(OutSize);
+	for (uint32_t Out = 0u; Out < OutSize; ++Out)
+	{
+		auto& Tap = Taps[Out];
+		float Sum = 0.0f;
+
+		if (Filter == EMipFilter::Box)
+		{
+			/// Weights are the coverage of each source texel by the destination footprint.
+			const float Begin = Out * Scale;
+			const float End = Begin + Scale;
+
+			Tap.First = static_cast<int32_t>(std::floorf(Begin));
+			for (int32_t Index = Tap.First; static_cast<float>(Index) < End; ++Index)
+			{
+				const float Weight = std::min(Index + 1.0f, End) - std::max(static_cast<float>(Index), Begin);
+				Tap.Weights.push_back(Weight);
+				Sum += Weight;
+			}
+		}
+		else
+		{
+			/// The kernel is stretched by the scale, so it stays a low pass filter for the destination rate.
+			const float Center = (Out + 0.5f) * Scale;
+			const float Support = KaiserWidth * Scale;
+
+			Tap.First = static_cast<int32_t>(std::floorf(Center - Support));
+			const int32_t Last = static_cast<int32_t>(std::ceilf(Center + Support));
+			for (int32_t Index = Tap.First; Index <= Last; ++Index)
+			{
+				const float Weight = EvaluateKaiser((Index + 0.5f - Center) / Scale);
+				Tap.Weights.push_back(Weight);
+				Sum += Weight;
+			}
+		}
+
+		for (auto& Weight : Tap.Weights)
+		{
+			Weight /= Sum;
+		}
+	}
+
+	return Taps;
+}
+
+static inline uint32_t WrapIndex(int32_t Index, uint32_t Size)
+{
+	const int32_t Wrapped = Index % static_cast<int32_t>(Size);
+	return static_cast<uint32_t>(Wrapped < 0 ? Wrapped + static_cast<int32_t>(Size) : Wrapped);
+}
+
+static inline XMVECTOR LoadTexel(const std::vector<float>& Pixels, size_t Index)
+{
+	return XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(Pixels.data() + Index * 4u));
+}
+
+static inline void StoreTexel(std::vector<float>& Pixels, size_t Index, FXMVECTOR Value)
+{
+	XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(Pixels.data() + Index * 4u), Value);
+}
+
+/// Horizontal pass into a Width x Image.Height intermediate, then the vertical pass, both parallel over rows.
+static TextureImage Resample(const TextureImage& Image, uint32_t Width, uint32_t Height, EMipFilter Filter)
+{
+	const auto TapsX = ComputeFilterTaps(Image.Width, Width, Filter);
+	const auto TapsY = ComputeFilterTaps(Image.Height, Height, Filter);
+
+	std::vector<float> Horizontal(static_cast<size_t>(Width) * Image.Height * 4u);
+
+	std::vector<uint32_t> Rows(Image.Height);
+	std::iota(Rows.begin(), Rows.end(), 0u);
+
+	TFTask::CorunParallelFor(Rows.begin(), Rows.end(), [&Image, &Horizontal, &TapsX, Width](uint32_t Y) {
+		const size_t SourceRow = static_cast<size_t>(Y) * Image.Width;
+
+		for (uint32_t X = 0u; X < Width; ++X)
+		{
+			const auto& Tap = TapsX[X];
+
+			XMVECTOR Sum = XMVectorZero();
+			for (size_t Index = 0u; Index < Tap.Weights.size(); ++Index)
+			{
+				const uint32_t SourceX = WrapIndex(Tap.First + static_cast<int32_t>(Index), Image.Width);
+				Sum = XMVectorMultiplyAdd(LoadTexel(Image.Pixels, SourceRow + SourceX), XMVectorReplicate(Tap.Weights[Index]), Sum);
+			}
+
+			StoreTexel(Horizontal, static_cast<size_t>(Y) * Width + X, Sum);
+		}
+	});
+
+	TextureImage Result;
+	Result.Width = Width;
+	Result.Height = Height;
+	Result.Pixels.resize(static_cast<size_t>(Width) * Height * 4u);
+
+	Rows.resize(Height);
+	std::iota(Rows.begin(), Rows.end(), 0u);
+
+	TFTask::CorunParallelFor(Rows.begin(), Rows.end(), [&Image, &Horizontal, &TapsY, &Result](uint32_t Y) {
+		const auto& Tap = TapsY[Y];
+
+		for (uint32_t X = 0u; X < Result.Width; ++X)
+		{
+			XMVECTOR Sum = XMVectorZero();
+			for (size_t Index = 0u; Index < Tap.Weights.size(); ++Index)
+			{
+				const uint32_t SourceY = WrapIndex(Tap.First + static_cast<int32_t>(Index), Image.Height);
+				Sum = XMVectorMultiplyAdd(LoadTexel(Horizontal, static_cast<size_t>(SourceY) * Result.Width + X), XMVectorReplicate(Tap.Weights[Index]), Sum);
+			}
+
+			StoreTexel(Result.Pixels, static_cast<size_t>(Y) * Result.Width + X, Sum);
+		}
+	});
+
+	return Result;
+}
+
+/// Filtering shortens the averaged normals, the alpha channel is left alone.
+static void NormalizeNormals(TextureImage& Image)
+{
+	const XMVECTOR Up = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
+
+	for (size_t Index = 0u; Index < Image.GetNumTexels(); ++Index)
+	{
+		const XMVECTOR Texel = LoadTexel(Image.Pixels, Index);
+
+		XMVECTOR Normal = XMVectorMultiplyAdd(Texel, XMVectorReplicate(2.0f), XMVectorReplicate(-1.0f));
+		Normal = XMVectorGetX(XMVector3LengthSq(Normal)) > 1e-8f ? XMVector3Normalize(Normal) : Up;
+		Normal = XMVectorMultiplyAdd(Normal, XMVectorReplicate(0.5f), XMVectorReplicate(0.5f));
+
+		StoreTexel(Image.Pixels, Index, XMVectorSelect(Texel, Normal, g_XMSelect1110));
+	}
+}
+
+TextureImage TextureProcessor::FromRGBA8(const uint8_t* Texels, uint32_t Width, uint32_t Height, bool SRGB)
+{
+	static const auto SRGBToLinear = []() {
+		std::array<float, 256u> Table;
+		for (uint32_t Value = 0u; Value < 256u; ++Value)
+		{
+			const float Color = Value / 255.0f;
+			Table[Value] = Color <= 0.04045f ? Color / 12.92f : std::powf((Color + 0.055f) / 1.055f, 2.4f);
+		}
+		return Table;
+	}();
+
+	TextureImage Image;
+	Image.Width = Width;
+	Image.Height = Height;
+	Image.Pixels.resize(Image.GetNumTexels() * 4u);
+
+	for (size_t Index = 0u; Index < Image.Pixels.size(); ++Index)
+	{
+		const bool IsAlpha = (Index & 3u) == 3u;
+		Image.Pixels[Index] = SRGB && !IsAlpha ? SRGBToLinear[Texels[Index]] : Math::DequantizeUNorm8(Texels[Index]);
+	}
+
+	return Image;
+}
+
+TextureImage TextureProcessor::FromRGBA32F(const float* Texels, uint32_t Width, uint32_t Height)
+{
+	TextureImage Image;
+	Image.Width = Width;
+	Image.Height = Height;
+	Image.Pixels.assign(Texels, Texels + Image.GetNumTexels() * 4u);
+
+	return Image;
+}
+
+void TextureProcessor::ToRGBA8(const TextureImage& Image, bool SRGB, uint8_t* OutTexels)
+{
+	for (size_t Index = 0u; Index < Image.GetNumTexels(); ++Index)
+	{
+		XMVECTOR Texel = XMVectorSaturate(LoadTexel(Image.Pixels, Index));
+		if (SRGB)
+		{
+			Texel = XMColorRGBToSRGB(Texel);
+		}
+
+		XMFLOAT4 Color;
+		XMStoreFloat4(&Color, Texel);
+
+		uint8_t* Out = OutTexels + Index * 4u;
+		Out[0u] = Math::QuantizeUNorm8(Color.x);
+		Out[1u] = Math::QuantizeUNorm8(Color.y);
+		Out[2u] = Math::QuantizeUNorm8(Color.z);
+		Out[3u] = Math::QuantizeUNorm8(Color.w);
+	}
+}
+
+std::vector<TextureImage> TextureProcessor::GenerateMips(TextureImage&& Image, EMipFilter Filter, bool NormalMap)
+{
+	if (NormalMap)
+	{
+		NormalizeNormals(Image);
+	}
+
+	std::vector<TextureImage> Mips;
+	Mips.emplace_back(std::move(Image));
+
+	while (Mips.back().Width > 1u || Mips.back().Height > 1u)
+	{
+		const auto& Previous = Mips.back();
+		auto Mip = Resample(Previous, std::max(Previous.Width >> 1u, 1u), std::max(Previous.Height >> 1u, 1u), Filter);
+
+		if (NormalMap)
+		{
+			NormalizeNormals(Mip);
+		}
+
+		Mips.emplace_back(std::move(Mip));
+	}
+
+	return Mips;
+}
+
+ERHIFormat TextureProcessor::GetTargetFormat(const TextureProcessingSettings& Settings, uint32_t Width, uint32_t Height, bool IsHDR, bool HasAlpha)
+{
+	/// BC6H is not implemented, HDR images keep half precision.
+	if (IsHDR)
+	{
+		return ERHIFormat::RGBA16_Float;
+	}
+
+	const bool SRGB = Settings.Usage == ETextureUsage::Color;
+	const bool Compress = Settings.Compress &&
+		Width % TextureCompressor::BlockDimension == 0u &&
+		Height % TextureCompressor::BlockDimension == 0u;
+
+	if (!Compress)
+	{
+		return SRGB ? ERHIFormat::RGBA8_UNorm_SRGB : ERHIFormat::RGBA8_UNorm;
+	}
+
+	switch (Settings.Usage)
+	{
+	case ETextureUsage::Normal:
+		return ERHIFormat::BC5_UNorm;
+	case ETextureUsage::Mask:
+		return ERHIFormat::BC4_UNorm;
+	default:
+	{
+		const ERHIFormat Format = Settings.UseBC7 ? ERHIFormat::BC7_UNorm : (HasAlpha ? ERHIFormat::BC3_UNorm : ERHIFormat::BC1_UNorm);
+		return SRGB ? RHI::GetSRGBFormat(Format) : Format;
+	}
+	}
+}
+
+std::shared_ptr<DataBlock> TextureProcessor::Encode(const std::vector<TextureImage>& Mips, ERHIFormat Format, bool SRGB)
+{
+	assert(!Mips.empty());
+
+	size_t Size = 0u;
+	for (const auto& Mip : Mips)
+	{
+		Size += RHI::GetFormatAttributes(Mip.Width, Mip.Height, Format).SlicePitch;
+	}
+
+	auto Block = std::make_shared<DataBlock>(DataBlock::CreateUninitialized(Size));
+	std::byte* Out = Block->GetRawData();
+
+	std::vector<uint8_t> Texels;
+	for (const auto& Mip : Mips)
+	{
+		const size_t MipSize = RHI::GetFormatAttributes(Mip.Width, Mip.Height, Format).SlicePitch;
+
+		if (Format == ERHIFormat::RGBA16_Float)
+		{
+			auto Halfs = reinterpret_cast<uint16_t*>(Out);
+			for (size_t Index = 0u; Index < Mip.Pixels.size(); ++Index)
+			{
+				Halfs[Index] = Math::FloatToHalf(Mip.Pixels[Index]);
+			}
+		}
+		else
+		{
+			Texels.resize(Mip.GetNumTexels() * 4u);
+			ToRGBA8(Mip, SRGB, Texels.data());
+
+			if (TextureCompressor::IsSupportedFormat(Format))
+			{
+				TextureCompressor::Compress(Texels.data(), Mip.Width, Mip.Height, Format, Out);
+			}
+			else
+			{
+				VERIFY(memcpy_s(Out, MipSize, Texels.data(), Texels.size()) == 0);
+			}
+		}
+
+		Out += MipSize;
+	}
+
+	return Block;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Asset/Texture.h"
+
+enum class EMipFilter : uint8_t
+{
+	Box,
+	Kaiser
+};
+
+struct TextureProcessingSettings
+{
+	ETextureUsage Usage = ETextureUsage::Color;
+	EMipFilter MipFilter = EMipFilter::Kaiser;
+	bool GenerateMips = true;
+	bool Compress = true;
+	bool UseBC7 = true;
+};
+
+/// Linear RGBA float texels, row major.
+struct TextureImage
+{
+	uint32_t Width = 0u;
+	uint32_t Height = 0u;
+	std::vector<float> Pixels;
+
+	inline size_t GetNumTexels() const { return static_cast<size_t>(Width) * Height; }
+};
+
+/// Import time processing of decoded images: mip chain generation in linear space and encoding into the GPU format.
+/// Mips are resampled from the previous level with a separable filter and wrap addressing, the Kaiser filter is a windowed sinc
+/// (width 3, alpha 4) which keeps distant mips sharper than the box filter without visible ringing.
+class TextureProcessor
+{
+public:
+	/// sRGB texels are decoded to linear, so filtering is gamma correct.
+	static TextureImage FromRGBA8(const uint8_t* Texels, uint32_t Width, uint32_t Height, bool SRGB);
+	static TextureImage FromRGBA32F(const float* Texels, uint32_t Width, uint32_t Height);
+
+	/// Inverse of FromRGBA8, out of range values are clamped.
+	static void ToRGBA8(const TextureImage& Image, bool SRGB, uint8_t* OutTexels);
+
+	/// Full chain down to 1x1, mip 0 first. Normal maps hold unit vectors scaled to [0, 1] and are renormalized on every level.
+	static std::vector<TextureImage> GenerateMips(TextureImage&& Image, EMipFilter Filter, bool NormalMap);
+
+	/// Block compression needs the top mip to be a multiple of the block size, other images stay uncompressed.
+	static ERHIFormat GetTargetFormat(const TextureProcessingSettings& Settings, uint32_t Width, uint32_t Height, bool IsHDR, bool HasAlpha);
+
+	/// All mips encoded into Format, mip 0 first and back to back, which is the layout the texture streaming expects.
+	static std::shared_ptr<DataBlock> Encode(const std::vector<TextureImage>& Mips, ERHIFormat Format, bool SRGB);
+};
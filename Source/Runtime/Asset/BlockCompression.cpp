@@ -0,0 +1,320 @@
+#include "Asset/BlockCompression.h"
+
+#if USE_ZSTD
+	#include <zstd.h>
+#endif
+
+namespace LZ4
+{
+	static constexpr size_t MinMatch = 4u;
+
+	/// The last sequence is literals only and at least this long.
+	static constexpr size_t LastLiterals = 5u;
+
+	/// The last match starts at least this far from the end of the block.
+	static constexpr size_t MatchFindLimit = 12u;
+
+	static constexpr size_t MaxDistance = 65535u;
+	static constexpr uint32_t HashLog = 16u;
+
+	inline uint32_t Read32(const uint8_t* Data)
+	{
+		uint32_t Value;
+		memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+
+	inline uint32_t Hash(uint32_t Sequence)
+	{
+		return (Sequence * 2654435761u) >> (32u - HashLog);
+	}
+
+	inline size_t GetCompressBound(size_t SrcSize)
+	{
+		return SrcSize + SrcSize / 255u + 16u;
+	}
+
+	static uint8_t* WriteLength(uint8_t* Out, size_t Length)
+	{
+		for (; Length >= 255u; Length -= 255u)
+		{
+			*Out++ = 255u;
+		}
+		*Out++ = static_cast<uint8_t>(Length);
+		return Out;
+	}
+
+	/// MatchLength 0 writes the trailing literals only sequence.
+	static uint8_t* WriteSequence(uint8_t* Out, const uint8_t* OutEnd, const uint8_t* Literals, size_t NumLiterals, size_t MatchLength, size_t Distance)
+	{
+		const size_t MaxSize = 1u + NumLiterals + NumLiterals / 255u + 1u + (MatchLength ? 2u + MatchLength / 255u + 1u : 0u);
+		if (MaxSize > static_cast<size_t>(OutEnd - Out))
+		{
+			return nullptr;
+		}
+
+		uint8_t* Token = Out++;
+		*Token = static_cast<uint8_t>(std::min<size_t>(NumLiterals, 15u) << 4u);
+		if (NumLiterals >= 15u)
+		{
+			Out = WriteLength(Out, NumLiterals - 15u);
+		}
+
+		memcpy(Out, Literals, NumLiterals);
+		Out += NumLiterals;
+
+		if (MatchLength)
+		{
+			*Out++ = static_cast<uint8_t>(Distance & 0xFFu);
+			*Out++ = static_cast<uint8_t>(Distance >> 8u);
+
+			const size_t Length = MatchLength - MinMatch;
+			*Token |= static_cast<uint8_t>(std::min<size_t>(Length, 15u));
+			if (Length >= 15u)
+			{
+				Out = WriteLength(Out, Length - 15u);
+			}
+		}
+
+		return Out;
+	}
+
+	/// Greedy single probe hash chain, the same trade off as the fast mode of the reference implementation.
+	static size_t Compress(const uint8_t* Src, size_t SrcSize, uint8_t* Dst, size_t DstCapacity)
+	{
+		const uint8_t* End = Src + SrcSize;
+		const uint8_t* Anchor = Src;
+
+		uint8_t* Out = Dst;
+		const uint8_t* OutEnd = Dst + DstCapacity;
+
+		if (SrcSize > MatchFindLimit)
+		{
+			const uint8_t* MatchLimit = End - LastLiterals;
+			const uint8_t* SearchEnd = End - MatchFindLimit;
+
+			/// Positions are only hints, every candidate is compared before it is used.
+			std::vector<uint32_t> HashTable(1u << HashLog, 0u);
+
+			const uint8_t* Current = Src;
+			while (Current <= SearchEnd)
+			{
+				const uint32_t Sequence = Read32(Current);
+				const uint32_t HashValue = Hash(Sequence);
+
+				const uint8_t* Match = Src + HashTable[HashValue];
+				HashTable[HashValue] = static_cast<uint32_t>(Current - Src);
+
+				if (Match >= Current || static_cast<size_t>(Current - Match) > MaxDistance || Read32(Match) != Sequence)
+				{
+					++Current;
+					continue;
+				}
+
+				while (Current > Anchor && Match > Src && Current[-1] == Match[-1])
+				{
+					--Current;
+					--Match;
+				}
+
+				const uint8_t* MatchEnd = Current + MinMatch;
+				const uint8_t* Reference = Match + MinMatch;
+				while (MatchEnd < MatchLimit && *MatchEnd == *Reference)
+				{
+					++MatchEnd;
+					++Reference;
+				}
+
+				Out = WriteSequence(Out, OutEnd, Anchor, static_cast<size_t>(Current - Anchor), static_cast<size_t>(MatchEnd - Current), static_cast<size_t>(Current - Match));
+				if (!Out)
+				{
+					return 0u;
+				}
+
+				Current = Anchor = MatchEnd;
+
+				if (Current <= SearchEnd)
+				{
+					HashTable[Hash(Read32(Current - 2))] = static_cast<uint32_t>(Current - 2 - Src);
+				}
+			}
+		}
+
+		Out = WriteSequence(Out, OutEnd, Anchor, static_cast<size_t>(End - Anchor), 0u, 0u);
+		return Out ? static_cast<size_t>(Out - Dst) : 0u;
+	}
+
+	static bool ReadLength(const uint8_t*& In, const uint8_t* InEnd, size_t& Length)
+	{
+		uint8_t Byte = 0u;
+		do
+		{
+			if (In >= InEnd)
+			{
+				return false;
+			}
+
+			Byte = *In++;
+			Length += Byte;
+		} while (Byte == 255u);
+
+		return true;
+	}
+
+	static bool Decompress(const uint8_t* Src, size_t SrcSize, uint8_t* Dst, size_t DstSize)
+	{
+		const uint8_t* In = Src;
+		const uint8_t* InEnd = Src + SrcSize;
+
+		uint8_t* Out = Dst;
+		uint8_t* OutEnd = Dst + DstSize;
+
+		while (In < InEnd)
+		{
+			const uint8_t Token = *In++;
+
+			size_t NumLiterals = Token >> 4u;
+			if (NumLiterals == 15u && !ReadLength(In, InEnd, NumLiterals))
+			{
+				return false;
+			}
+
+			if (NumLiterals > static_cast<size_t>(InEnd - In) || NumLiterals > static_cast<size_t>(OutEnd - Out))
+			{
+				return false;
+			}
+
+			memcpy(Out, In, NumLiterals);
+			In += NumLiterals;
+			Out += NumLiterals;
+
+			/// The last sequence has no match.
+			if (In == InEnd)
+			{
+				break;
+			}
+
+			if (InEnd - In < 2)
+			{
+				return false;
+			}
+
+			const size_t Distance = static_cast<size_t>(In[0]) | (static_cast<size_t>(In[1]) << 8u);
+			In += 2;
+
+			if (Distance == 0u || Distance > static_cast<size_t>(Out - Dst))
+			{
+				return false;
+			}
+
+			size_t MatchLength = Token & 15u;
+			if (MatchLength == 15u && !ReadLength(In, InEnd, MatchLength))
+			{
+				return false;
+			}
+			MatchLength += MinMatch;
+
+			if (MatchLength > static_cast<size_t>(OutEnd - Out))
+			{
+				return false;
+			}
+
+			/// Matches may overlap the bytes they produce, e.g. runs of a single byte with a distance of 1.
+			const uint8_t* Match = Out - Distance;
+			if (Distance >= MatchLength)
+			{
+				memcpy(Out, Match, MatchLength);
+			}
+			else
+			{
+				for (size_t Index = 0u; Index < MatchLength; ++Index)
+				{
+					Out[Index] = Match[Index];
+				}
+			}
+			Out += MatchLength;
+		}
+
+		return Out == OutEnd;
+	}
+}
+
+bool BlockCompression::IsSupported(ECompressionMethod Method)
+{
+	switch (Method)
+	{
+	case ECompressionMethod::None:
+	case ECompressionMethod::LZ4:
+		return true;
+	case ECompressionMethod::Zstd:
+#if USE_ZSTD
+		return true;
+#else
+		return false;
+#endif
+	default:
+		return false;
+	}
+}
+
+size_t BlockCompression::GetCompressBound(ECompressionMethod Method, size_t SrcSize)
+{
+	switch (Method)
+	{
+	case ECompressionMethod::LZ4:
+		return LZ4::GetCompressBound(SrcSize);
+#if USE_ZSTD
+	case ECompressionMethod::Zstd:
+		return ZSTD_compressBound(SrcSize);
+#endif
+	default:
+		return SrcSize;
+	}
+}
+
+size_t BlockCompression::Compress(ECompressionMethod Method, const void* Src, size_t SrcSize, void* Dst, size_t DstCapacity)
+{
+	switch (Method)
+	{
+	case ECompressionMethod::None:
+		if (SrcSize > DstCapacity)
+		{
+			return 0u;
+		}
+		memcpy(Dst, Src, SrcSize);
+		return SrcSize;
+	case ECompressionMethod::LZ4:
+		return LZ4::Compress(reinterpret_cast<const uint8_t*>(Src), SrcSize, reinterpret_cast<uint8_t*>(Dst), DstCapacity);
+#if USE_ZSTD
+	case ECompressionMethod::Zstd:
+	{
+		const size_t Size = ZSTD_compress(Dst, DstCapacity, Src, SrcSize, ZSTD_CLEVEL_DEFAULT);
+		return ZSTD_isError(Size) ? 0u : Size;
+	}
+#endif
+	default:
+		return 0u;
+	}
+}
+
+bool BlockCompression::Decompress(ECompressionMethod Method, const void* Src, size_t SrcSize, void* Dst, size_t DstSize)
+{
+	switch (Method)
+	{
+	case ECompressionMethod::None:
+		if (SrcSize != DstSize)
+		{
+			return false;
+		}
+		memcpy(Dst, Src, SrcSize);
+		return true;
+	case ECompressionMethod::LZ4:
+		return LZ4::Decompress(reinterpret_cast<const uint8_t*>(Src), SrcSize, reinterpret_cast<uint8_t*>(Dst), DstSize);
+#if USE_ZSTD
+	case ECompressionMethod::Zstd:
+		return ZSTD_decompress(Dst, DstSize, Src, SrcSize) == DstSize;
+#endif
+	default:
+		return false;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Core/Definitions.h"
+
+enum class ECompressionMethod : uint8_t
+{
+	None,
+	LZ4,
+	Zstd
+};
+
+/// Single shot compression of independent blocks, every block decompresses on its own. LZ4 writes the plain LZ4 block format without
+/// a frame. Zstd is only available if the library was found at configure time (USE_ZSTD).
+class BlockCompression
+{
+public:
+	static bool IsSupported(ECompressionMethod Method);
+
+	/// Worst case compressed size of SrcSize bytes.
+	static size_t GetCompressBound(ECompressionMethod Method, size_t SrcSize);
+
+	/// Returns the compressed size, 0 if the data does not fit into DstCapacity or the method is not supported.
+	static size_t Compress(ECompressionMethod Method, const void* Src, size_t SrcSize, void* Dst, size_t DstCapacity);
+
+	/// Fails on corrupt input and if the data does not decompress to exactly DstSize bytes.
+	static bool Decompress(ECompressionMethod Method, const void* Src, size_t SrcSize, void* Dst, size_t DstSize);
+};
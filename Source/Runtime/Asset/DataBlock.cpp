@@ -0,0 +1,123 @@
+#include "Asset/DataBlock.h"
+
+#if defined(PLATFORM_WIN32)
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+#endif
+
+/// Every platform maps at least this aligned.
+static constexpr size_t MinPageSize = 4096u;
+
+HeapDataAllocator& HeapDataAllocator::Get()
+{
+	static HeapDataAllocator Instance;
+	return Instance;
+}
+
+std::shared_ptr<std::byte> HeapDataAllocator::Allocate(size_t Size, size_t Alignment)
+{
+	assert(IsPowerOfTwo(Alignment));
+
+	if (!Size)
+	{
+		return nullptr;
+	}
+
+	auto Memory = reinterpret_cast<std::byte*>(::operator new(Size, std::align_val_t(Alignment), std::nothrow));
+	if (!Memory)
+	{
+		return nullptr;
+	}
+
+	return std::shared_ptr<std::byte>(Memory, [Alignment](std::byte* Memory) {
+		::operator delete(Memory, std::align_val_t(Alignment));
+	});
+}
+
+std::shared_ptr<std::byte> ArenaDataAllocator::Allocate(size_t Size, size_t Alignment)
+{
+	assert(IsPowerOfTwo(Alignment));
+
+	if (!Size)
+	{
+		return nullptr;
+	}
+
+	/// Blocks of half a chunk and more would waste most of it, they get their own allocation.
+	if (Size > m_ChunkSize / 2u)
+	{
+		return m_Backing.Allocate(Size, Alignment);
+	}
+
+	std::lock_guard Locker(m_Lock);
+
+	auto Base = reinterpret_cast<uintptr_t>(m_Chunk.get());
+	size_t Offset = Align<uintptr_t>(Base + m_ChunkOffset, Alignment) - Base;
+
+	if (!m_Chunk || Offset + Size > m_ChunkCapacity)
+	{
+		m_Chunk = m_Backing.Allocate(m_ChunkSize, std::max(Alignment, DataBlock::DefaultAlignment));
+		if (!m_Chunk)
+		{
+			m_ChunkCapacity = m_ChunkOffset = 0u;
+			return nullptr;
+		}
+
+		m_ChunkCapacity = m_ChunkSize;
+		Offset = 0u;
+	}
+
+	m_ChunkOffset = Offset + Size;
+	return std::shared_ptr<std::byte>(m_Chunk, m_Chunk.get() + Offset);
+}
+
+void ArenaDataAllocator::Reset()
+{
+	std::lock_guard Locker(m_Lock);
+	m_Chunk.reset();
+	m_ChunkCapacity = m_ChunkOffset = 0u;
+}
+
+VirtualMemoryDataAllocator& VirtualMemoryDataAllocator::Get()
+{
+	static VirtualMemoryDataAllocator Instance;
+	return Instance;
+}
+
+std::shared_ptr<std::byte> VirtualMemoryDataAllocator::Allocate(size_t Size, size_t Alignment)
+{
+	assert(IsPowerOfTwo(Alignment));
+
+	if (!Size)
+	{
+		return nullptr;
+	}
+
+	if (Alignment > MinPageSize)
+	{
+		return HeapDataAllocator::Get().Allocate(Size, Alignment);
+	}
+
+#if defined(PLATFORM_WIN32)
+	auto Memory = reinterpret_cast<std::byte*>(::VirtualAlloc(nullptr, Size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+	if (!Memory)
+	{
+		return nullptr;
+	}
+
+	return std::shared_ptr<std::byte>(Memory, [](std::byte* Memory) {
+		::VirtualFree(Memory, 0u, MEM_RELEASE);
+	});
+#else
+	void* Memory = ::mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (Memory == MAP_FAILED)
+	{
+		return nullptr;
+	}
+
+	return std::shared_ptr<std::byte>(reinterpret_cast<std::byte*>(Memory), [Size](std::byte* Memory) {
+		::munmap(Memory, Size);
+	});
+#endif
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Core/Definitions.h"
+#include "Core/Cereal.h"
+
+/// Source of DataBlock storage. The returned pointer owns the allocation: it, and every alias of it, keeps the memory alive.
+class DataAllocator
+{
+public:
+	virtual ~DataAllocator() = default;
+
+	/// Null on failure. Alignment is a power of two.
+	virtual std::shared_ptr<std::byte> Allocate(size_t Size, size_t Alignment) = 0;
+};
+
+/// Aligned heap memory.
+class HeapDataAllocator final : public DataAllocator
+{
+public:
+	static HeapDataAllocator& Get();
+
+	std::shared_ptr<std::byte> Allocate(size_t Size, size_t Alignment) override final;
+};
+
+/// Bump allocates out of chunks of a backing allocator. Allocations are not freed one by one, a chunk goes back to the backing
+/// allocator once the arena moved on to the next one and every block in it is gone. Suits many small blocks living and dying
+/// together, like the meshes of one imported scene.
+class ArenaDataAllocator final : public DataAllocator
+{
+public:
+	ArenaDataAllocator(size_t ChunkSize = 4u * Megabyte, DataAllocator& Backing = HeapDataAllocator::Get())
+		: m_ChunkSize(ChunkSize)
+		, m_Backing(Backing)
+	{
+	}
+
+	std::shared_ptr<std::byte> Allocate(size_t Size, size_t Alignment) override final;
+
+	/// Starts a new chunk with the next allocation, the current one is released with its last block.
+	void Reset();
+private:
+	size_t m_ChunkSize;
+	DataAllocator& m_Backing;
+
+	std::mutex m_Lock;
+	std::shared_ptr<std::byte> m_Chunk;
+	size_t m_ChunkCapacity = 0u;
+	size_t m_ChunkOffset = 0u;
+};
+
+/// Anonymous memory mappings straight from the OS: page aligned, zero filled on first touch and returned to the OS on release instead
+/// of staying in the heap. Suits large transient blocks like whole files being loaded.
+class VirtualMemoryDataAllocator final : public DataAllocator
+{
+public:
+	static VirtualMemoryDataAllocator& Get();
+
+	std::shared_ptr<std::byte> Allocate(size_t Size, size_t Alignment) override final;
+};
+
+/// Reference counted view of bytes. Copies and slices share the storage, nothing is copied until Clone is asked for. Data points at the
+/// first byte of the view, so a view of a memory mapped file or of another block is just an alias of its storage.
+struct DataBlock
+{
+	/// Wide enough for any SIMD load and for cache line aligned GPU uploads.
+	static constexpr size_t DefaultAlignment = 64u;
+
+	size_t Size = 0u;
+	std::shared_ptr<std::byte> Data;
+
+	DataBlock() = default;
+
+	/// Zero filled unless InData is given, which is copied in.
+	DataBlock(size_t InSize, const void* InData = nullptr, size_t Alignment = DefaultAlignment, DataAllocator* Allocator = nullptr)
+		: Size(InSize)
+		, Data((Allocator ? *Allocator : HeapDataAllocator::Get()).Allocate(InSize, Alignment))
+	{
+		assert(Data || !InSize);
+
+		if (InData)
+		{
+			VERIFY(memcpy_s(Data.get(), InSize, InData, InSize) == 0);
+		}
+		else if (InSize)
+		{
+			memset(Data.get(), 0, InSize);
+		}
+	}
+
+	/// Adopts storage owned elsewhere, e.g. MappedFile::GetSharedData.
+	DataBlock(std::shared_ptr<std::byte> Storage, size_t InSize)
+		: Size(InSize)
+		, Data(std::move(Storage))
+	{
+	}
+
+	/// For blocks which are written over completely right away, file reads and the like.
+	static DataBlock CreateUninitialized(size_t Size, size_t Alignment = DefaultAlignment, DataAllocator* Allocator = nullptr)
+	{
+		return DataBlock((Allocator ? *Allocator : HeapDataAllocator::Get()).Allocate(Size, Alignment), Size);
+	}
+
+	inline bool IsValid() const { return Size && Data; }
+
+	inline void Reset()
+	{
+		Size = 0u;
+		Data.reset();
+	}
+
+	inline size_t GetSize() const { return Size; }
+	inline std::byte* GetRawData() const { return Data.get(); }
+
+	inline bool IsAligned(size_t Alignment) const { return (reinterpret_cast<uintptr_t>(Data.get()) & (Alignment - 1u)) == 0u; }
+
+	/// [Offset, Offset + InSize) of this block, sharing its storage.
+	inline DataBlock Slice(size_t Offset, size_t InSize) const
+	{
+		assert(Offset <= Size && InSize <= Size - Offset);
+		return DataBlock(std::shared_ptr<std::byte>(Data, Data.get() + Offset), InSize);
+	}
+
+	/// Deep copy into new storage.
+	inline DataBlock Clone(size_t Alignment = DefaultAlignment, DataAllocator* Allocator = nullptr) const
+	{
+		return IsValid() ? DataBlock(Size, Data.get(), Alignment, Allocator) : DataBlock();
+	}
+
+	/// Binary archives read the bytes straight into the new block, text archives decode them from base64.
+	template<class Archive>
+	void load(Archive& Ar)
+	{
+		size_t NewSize = 0u;
+		Ar(
+			cereal::make_nvp("Size", NewSize)
+		);
+
+		*this = CreateUninitialized(NewSize);
+
+		if constexpr (cereal::traits::is_text_archive<Archive>::value)
+		{
+			Ar.loadBinaryValue(Data.get(), Size, "Data");
+		}
+		else
+		{
+			Ar(cereal::binary_data(Data.get(), Size));
+		}
+	}
+
+	template<class Archive>
+	void save(Archive& Ar) const
+	{
+		Ar(
+			CEREAL_NVP(Size)
+		);
+
+		if constexpr (cereal::traits::is_text_archive<Archive>::value)
+		{
+			Ar.saveBinaryValue(Data.get(), Size, "Data");
+		}
+		else
+		{
+			Ar(cereal::binary_data(Data.get(), Size));
+		}
+	}
+};
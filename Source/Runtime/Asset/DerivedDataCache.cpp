@@ -0,0 +1,228 @@
+#include "Asset/DerivedDataCache.h"
+#include "Asset/File.h"
+#include "Async/Task.h"
+#include "Core/ConsoleVariable.h"
+#include "Services/SpdLogService.h"
+#include "Paths.h"
+
+ConsoleVariable<uint32_t> CVarDDCMaxSize(
+	"ddc.max_size_mb",
+	"Size budget of the derived data cache in megabytes, the least recently used entries are deleted beyond it.",
+	8192u);
+
+/// Temp files older than this belong to writers that crashed.
+static constexpr auto OrphanedTempFileAge = std::chrono::hours(1);
+
+static uint64_t GetMaxSize()
+{
+	return static_cast<uint64_t>(CVarDDCMaxSize.Get()) * Megabyte;
+}
+
+std::string DerivedDataKey::ToString() const
+{
+	return String::Format("%016llx_%016llx_v%u",
+		static_cast<unsigned long long>(ContentHash),
+		static_cast<unsigned long long>(SettingsHash),
+		Version);
+}
+
+void DerivedDataCache::Initialize()
+{
+	std::error_code ErrorCode;
+	std::filesystem::create_directories(Paths::DerivedDataPath(), ErrorCode);
+
+	CollectGarbageAsync();
+}
+
+void DerivedDataCache::Finalize()
+{
+	std::lock_guard Locker(m_GarbageCollectionLock);
+	if (m_GarbageCollectionTask)
+	{
+		m_GarbageCollectionTask->Wait();
+		m_GarbageCollectionTask.reset();
+	}
+}
+
+std::filesystem::path DerivedDataCache::GetPath(const DerivedDataKey& Key) const
+{
+	assert(!Key.Bucket.empty());
+
+	/// Sharded by the leading content hash digits, directories stay small enough to list.
+	auto Name = Key.ToString();
+	auto Shard = Name.substr(0u, 2u);
+	Name += ".ddc";
+
+	return Paths::DerivedDataPath() / Key.Bucket / Shard / Name;
+}
+
+void DerivedDataCache::Touch(const std::filesystem::path& Path)
+{
+	std::error_code ErrorCode;
+	std::filesystem::last_write_time(Path, std::filesystem::file_time_type::clock::now(), ErrorCode);
+}
+
+void DerivedDataCache::Touch(const DerivedDataKey& Key)
+{
+	Touch(GetPath(Key));
+}
+
+std::shared_ptr<MappedFile> DerivedDataCache::Load(const DerivedDataKey& Key)
+{
+	const auto Path = GetPath(Key);
+
+	auto Mapped = MappedFile::Open(Path);
+	if (Mapped)
+	{
+		Touch(Path);
+	}
+
+	return Mapped;
+}
+
+bool DerivedDataCache::Store(const DerivedDataKey& Key, const std::function<bool(std::ostream&)>& Writer)
+{
+	const auto Path = GetPath(Key);
+
+	std::error_code ErrorCode;
+	std::filesystem::create_directories(Path.parent_path(), ErrorCode);
+
+	const auto TempPath = File::GetTempPath(Path);
+
+	{
+		std::ofstream FileStream(TempPath, std::ios::binary | std::ios::trunc);
+		if (!FileStream.is_open())
+		{
+			LOG_ERROR(LogAsset, "Failed to create derived data \"{}\".", TempPath.string());
+			return false;
+		}
+
+		if (!Writer(FileStream) || !FileStream.good())
+		{
+			FileStream.close();
+			std::filesystem::remove(TempPath, ErrorCode);
+			return false;
+		}
+	}
+
+	const uint64_t Size = std::filesystem::file_size(TempPath, ErrorCode);
+
+	std::filesystem::rename(TempPath, Path, ErrorCode);
+	if (ErrorCode)
+	{
+		std::filesystem::remove(TempPath, ErrorCode);
+
+		/// Replacing fails while another writer's entry is in use on some platforms, it holds the same data.
+		if (std::filesystem::exists(Path, ErrorCode))
+		{
+			return true;
+		}
+
+		LOG_ERROR(LogAsset, "Failed to store derived data \"{}\".", Path.string());
+		return false;
+	}
+
+	if (m_Size.fetch_add(Size, std::memory_order_relaxed) + Size > GetMaxSize())
+	{
+		CollectGarbageAsync();
+	}
+
+	return true;
+}
+
+bool DerivedDataCache::Store(const DerivedDataKey& Key, const void* Data, size_t Size)
+{
+	return Store(Key, [Data, Size](std::ostream& Stream) {
+		Stream.write(reinterpret_cast<const char*>(Data), Size);
+		return true;
+	});
+}
+
+void DerivedDataCache::CollectGarbage(uint64_t MaxSize)
+{
+	struct Entry
+	{
+		std::filesystem::path Path;
+		uint64_t Size = 0u;
+		std::filesystem::file_time_type LastUseTime;
+	};
+
+	const auto Now = std::filesystem::file_time_type::clock::now();
+
+	std::vector<Entry> Entries;
+	uint64_t TotalSize = 0u;
+
+	std::error_code ErrorCode;
+	for (const auto& DirectoryEntry : std::filesystem::recursive_directory_iterator(Paths::DerivedDataPath(), ErrorCode))
+	{
+		std::error_code EntryErrorCode;
+		if (!DirectoryEntry.is_regular_file(EntryErrorCode))
+		{
+			continue;
+		}
+
+		const auto LastWriteTime = DirectoryEntry.last_write_time(EntryErrorCode);
+		if (DirectoryEntry.path().extension() == ".tmp")
+		{
+			if (!EntryErrorCode && Now - LastWriteTime > OrphanedTempFileAge)
+			{
+				std::filesystem::remove(DirectoryEntry.path(), EntryErrorCode);
+			}
+			continue;
+		}
+
+		const uint64_t Size = DirectoryEntry.file_size(EntryErrorCode);
+		if (!EntryErrorCode)
+		{
+			Entries.push_back(Entry{ DirectoryEntry.path(), Size, LastWriteTime });
+			TotalSize += Size;
+		}
+	}
+
+	if (TotalSize > MaxSize)
+	{
+		/// Down to 90% of the budget, or every store right after would collect again.
+		const uint64_t TargetSize = MaxSize - MaxSize / 10u;
+		const uint64_t PreviousSize = TotalSize;
+		size_t NumDeleted = 0u;
+
+		std::sort(Entries.begin(), Entries.end(), [](const Entry& Left, const Entry& Right) {
+			return Left.LastUseTime < Right.LastUseTime;
+		});
+
+		for (const auto& Deletion : Entries)
+		{
+			if (TotalSize <= TargetSize)
+			{
+				break;
+			}
+
+			/// Entries mapped by a reader can not be deleted on some platforms, they are simply kept.
+			std::error_code RemoveErrorCode;
+			if (std::filesystem::remove(Deletion.Path, RemoveErrorCode))
+			{
+				TotalSize -= Deletion.Size;
+				++NumDeleted;
+			}
+		}
+
+		LOG_INFO(LogAsset, "Derived data cache collected {} entries, {:.2f} MB -> {:.2f} MB.", NumDeleted,
+			static_cast<double>(PreviousSize) / Megabyte, static_cast<double>(TotalSize) / Megabyte);
+	}
+
+	m_Size.store(TotalSize, std::memory_order_relaxed);
+}
+
+void DerivedDataCache::CollectGarbageAsync()
+{
+	if (m_CollectingGarbage.exchange(true, std::memory_order_acq_rel))
+	{
+		return;
+	}
+
+	std::lock_guard Locker(m_GarbageCollectionLock);
+	m_GarbageCollectionTask = TFTask::Launch("DerivedDataCache.CollectGarbage", [this]() {
+		CollectGarbage(GetMaxSize());
+		m_CollectingGarbage.store(false, std::memory_order_release);
+	}, TFTask::EThread::WorkerThread, TFTask::EPriority::Low);
+}
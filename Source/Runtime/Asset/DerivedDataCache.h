@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Core/Singleton.h"
+#include "Asset/MappedFile.h"
+
+/// Identifies a piece of derived data by what it was derived from: the content of the input, the version of the processor and the
+/// settings it ran with. Paths and timestamps are no part of it, so checkouts, copies and renames of the input still hit the cache.
+struct DerivedDataKey
+{
+	/// Kind of data, e.g. "Texture", also the directory the entries live in.
+	std::string_view Bucket;
+
+	/// Bumped whenever the processor output changes for the same input.
+	uint32_t Version = 0u;
+
+	/// XXHash64 of the input content, see File::ComputeContentHash.
+	uint64_t ContentHash = 0u;
+
+	uint64_t SettingsHash = 0u;
+
+	/// Stable across runs and platforms, the entry file name.
+	std::string ToString() const;
+};
+
+/// Local on disk store of derived data, one file per key under Paths::DerivedDataPath(), shared by every run on the machine.
+/// Entries are immutable once written: writers fill a temp file and rename it in, so readers never see half written data and concurrent
+/// writers of a key, whose data is the same by definition, race harmlessly. Every hit refreshes the timestamp of the entry and the
+/// garbage collection deletes the least recently used entries once the store grows past cvar ddc.max_size_mb.
+/// Readers that need an entry beyond Load keep its MappedFile alive instead of reopening the path: a collected entry stays readable
+/// through an open mapping, and platforms that refuse to delete mapped files simply keep it.
+class DerivedDataCache : public Singleton<DerivedDataCache>
+{
+public:
+	/// Measures the store and collects garbage in the background if it is over budget.
+	void Initialize();
+	void Finalize();
+
+	std::filesystem::path GetPath(const DerivedDataKey& Key) const;
+
+	/// Maps the entry, null on a miss.
+	std::shared_ptr<MappedFile> Load(const DerivedDataKey& Key);
+
+	/// Writer streams the data, returning false or leaving the stream bad discards the entry.
+	bool Store(const DerivedDataKey& Key, const std::function<bool(std::ostream&)>& Writer);
+	bool Store(const DerivedDataKey& Key, const void* Data, size_t Size);
+
+	/// Marks the entry as used, for entries read without Load.
+	void Touch(const DerivedDataKey& Key);
+
+	/// Deletes the least recently used entries until the store is at most MaxSize bytes large, and temp files orphaned by crashed writers.
+	void CollectGarbage(uint64_t MaxSize);
+protected:
+	ALLOW_ACCESS(DerivedDataCache);
+private:
+	static void Touch(const std::filesystem::path& Path);
+
+	void CollectGarbageAsync();
+
+	/// Approximate, exact after every garbage collection.
+	std::atomic<uint64_t> m_Size = 0u;
+	std::atomic<bool> m_CollectingGarbage = false;
+	std::mutex m_GarbageCollectionLock;
+	std::shared_ptr<class TFTask> m_GarbageCollectionTask;
+};
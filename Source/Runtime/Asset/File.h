@@ -2,6 +2,7 @@
 
 #include "Core/Definitions.h"
 #include "Core/Cereal.h"
+#include "Asset/MappedFile.h"
 
 class File
 {
@@ -36,11 +37,26 @@ public:
 		return m_LastWriteTime;
 	}
 
+	inline uint64_t GetContentHash() const { return m_ContentHash; }
+
+	/// The timestamp only decides whether the content is hashed again, a file touched by a checkout or a copy without changing is not dirty.
+	/// Until a content hash is known, e.g. before the first load, every timestamp change counts.
 	virtual bool IsDirty() const
 	{
 		std::time_t LastWriteTime = m_LastWriteTime;
-		GetLastWriteTime();
-		return m_LastWriteTime != LastWriteTime;
+		if (GetLastWriteTime() == LastWriteTime)
+		{
+			return false;
+		}
+
+		const uint64_t ContentHash = ComputeContentHash(m_Path);
+		if (m_ContentHash != 0u && ContentHash == m_ContentHash)
+		{
+			return false;
+		}
+
+		m_ContentHash = ContentHash;
+		return true;
 	}
 
 	template<class Archive>
@@ -70,7 +86,72 @@ public:
 		}
 		return 0u;
 	}
+
+	/// Unique sibling of Path to write into and rename over Path when done. Concurrent writers of one file, also from other processes,
+	/// never share a temp file, the last rename wins and readers only ever see complete files.
+	static std::filesystem::path GetTempPath(const std::filesystem::path& Path)
+	{
+		static const uint64_t ProcessSeed = (static_cast<uint64_t>(std::random_device()()) << 32u) | std::random_device()();
+		static std::atomic<uint64_t> Counter(0u);
+
+		auto TempPath = Path;
+		TempPath += "." + std::to_string(ProcessSeed + Counter.fetch_add(1u, std::memory_order_relaxed)) + ".tmp";
+		return TempPath;
+	}
+
+	/// XXHash64 of the file content, 0 if the file can not be read.
+	static uint64_t ComputeContentHash(const std::filesystem::path& Path)
+	{
+		if (auto Mapped = MappedFile::Open(Path))
+		{
+			return XXHash64(Mapped->GetData(), Mapped->GetSize());
+		}
+
+		/// Empty files can not be mapped.
+		std::error_code ErrorCode;
+		if (std::filesystem::is_regular_file(Path, ErrorCode) && std::filesystem::file_size(Path, ErrorCode) == 0u && !ErrorCode)
+		{
+			return XXHash64(nullptr, 0u);
+		}
+		return 0u;
+	}
+
+	/// ComputeContentHash behind a process wide cache, a file is only read again once its size or last write time changed.
+	static uint64_t GetCachedContentHash(const std::filesystem::path& Path)
+	{
+		struct CachedHash
+		{
+			size_t Size = 0u;
+			std::time_t LastWriteTime = 0;
+			uint64_t Hash = 0u;
+		};
+
+		static std::mutex Lock;
+		static std::unordered_map<std::filesystem::path, CachedHash> Cache;
+
+		const size_t Size = GetSize(Path);
+		const std::time_t LastWriteTime = GetLastWriteTime(Path);
+
+		{
+			std::lock_guard Locker(Lock);
+			auto It = Cache.find(Path);
+			if (It != Cache.end() && It->second.Size == Size && It->second.LastWriteTime == LastWriteTime)
+			{
+				return It->second.Hash;
+			}
+		}
+
+		const uint64_t Hash = ComputeContentHash(Path);
+		if (Hash != 0u)
+		{
+			std::lock_guard Locker(Lock);
+			Cache[Path] = CachedHash{ Size, LastWriteTime, Hash };
+		}
+		return Hash;
+	}
 protected:
+	inline void SetContentHash(uint64_t ContentHash) const { m_ContentHash = ContentHash; }
+
 	template<class T>
 	inline void SetPath(T&& Path)
 	{
@@ -120,4 +201,5 @@ private:
 	std::string m_Extension;
 
 	mutable std::time_t m_LastWriteTime = 0u;
+	mutable uint64_t m_ContentHash = 0u;
 };
\ No newline at end of file
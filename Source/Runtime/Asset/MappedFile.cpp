@@ -0,0 +1,94 @@
+#include "Asset/MappedFile.h"
+#include "Asset/Asset.h"
+#include "Services/SpdLogService.h"
+#include "OS/OS.h"
+
+#if defined(PLATFORM_WIN32)
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+std::shared_ptr<MappedFile> MappedFile::Open(const std::filesystem::path& Path)
+{
+	std::shared_ptr<MappedFile> Mapped(new MappedFile());
+
+#if defined(PLATFORM_WIN32)
+	Mapped->m_File = ::CreateFileW(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (Mapped->m_File == INVALID_HANDLE_VALUE)
+	{
+		Mapped->m_File = nullptr;
+		return nullptr;
+	}
+
+	::LARGE_INTEGER Size{};
+	if (!::GetFileSizeEx(Mapped->m_File, &Size) || Size.QuadPart == 0)
+	{
+		return nullptr;
+	}
+	Mapped->m_Size = static_cast<size_t>(Size.QuadPart);
+
+	Mapped->m_Mapping = ::CreateFileMappingW(Mapped->m_File, nullptr, PAGE_WRITECOPY, 0u, 0u, nullptr);
+	if (!Mapped->m_Mapping)
+	{
+		LOG_ERROR(LogAsset, "Failed to map file \"{}\": {}", Path.string(), OS::GetErrorMessage());
+		return nullptr;
+	}
+
+	Mapped->m_Data = reinterpret_cast<std::byte*>(::MapViewOfFile(Mapped->m_Mapping, FILE_MAP_COPY, 0u, 0u, 0u));
+#else
+	Mapped->m_File = ::open(Path.c_str(), O_RDONLY);
+	if (Mapped->m_File < 0)
+	{
+		return nullptr;
+	}
+
+	struct stat Stat{};
+	if (::fstat(Mapped->m_File, &Stat) != 0 || Stat.st_size == 0)
+	{
+		return nullptr;
+	}
+	Mapped->m_Size = static_cast<size_t>(Stat.st_size);
+
+	void* Data = ::mmap(nullptr, Mapped->m_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, Mapped->m_File, 0);
+	Mapped->m_Data = Data == MAP_FAILED ? nullptr : reinterpret_cast<std::byte*>(Data);
+#endif
+
+	if (!Mapped->m_Data)
+	{
+		LOG_ERROR(LogAsset, "Failed to map view of file \"{}\".", Path.string());
+		return nullptr;
+	}
+
+	return Mapped;
+}
+
+MappedFile::~MappedFile()
+{
+#if defined(PLATFORM_WIN32)
+	if (m_Data)
+	{
+		::UnmapViewOfFile(m_Data);
+	}
+	if (m_Mapping)
+	{
+		::CloseHandle(m_Mapping);
+	}
+	if (m_File)
+	{
+		::CloseHandle(m_File);
+	}
+#else
+	if (m_Data)
+	{
+		::munmap(m_Data, m_Size);
+	}
+	if (m_File >= 0)
+	{
+		::close(m_File);
+	}
+#endif
+}
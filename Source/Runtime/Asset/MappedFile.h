@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Core/Definitions.h"
+
+/// Copy on write view of a whole file. Pages are faulted in on first access, writes stay private to the process and never reach the file.
+class MappedFile
+{
+public:
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/// Returns null if the file does not exist, is empty or can not be mapped.
+	static std::shared_ptr<MappedFile> Open(const std::filesystem::path& Path);
+
+	inline std::byte* GetData() const { return m_Data; }
+	inline size_t GetSize() const { return m_Size; }
+
+	/// Shared pointer into the view which keeps the whole mapping alive.
+	inline std::shared_ptr<std::byte> GetSharedData(const std::shared_ptr<MappedFile>& Owner, size_t Offset) const
+	{
+		assert(Owner.get() == this && Offset <= m_Size);
+		return std::shared_ptr<std::byte>(Owner, m_Data + Offset);
+	}
+private:
+	MappedFile() = default;
+
+	std::byte* m_Data = nullptr;
+	size_t m_Size = 0u;
+
+#if defined(PLATFORM_WIN32)
+	void* m_File = nullptr;
+	void* m_Mapping = nullptr;
+#else
+	int32_t m_File = -1;
+#endif
+};
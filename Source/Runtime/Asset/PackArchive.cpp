@@ -0,0 +1,477 @@
+#include "Asset/PackArchive.h"
+#include "Asset/MappedFile.h"
+#include "Async/Task.h"
+#include "Core/ConsoleVariable.h"
+#include "Services/SpdLogService.h"
+#include <numeric>
+
+ConsoleVariable<bool> CVarVFSVerifyHashes(
+	"vfs.verify_hashes",
+	"Check the content hash of every file read from a pack archive.",
+	false);
+
+struct PackHeader
+{
+	uint32_t Magic = 0u;
+	uint32_t Version = 0u;
+	uint32_t BlockSize = 0u;
+	uint32_t NumEntries = 0u;
+	uint32_t NumBlocks = 0u;
+	uint32_t Padding = 0u;
+
+	uint64_t TocOffset = 0u;
+	uint64_t TocSize = 0u;
+	uint64_t TocHash = 0u;
+	uint64_t FileSize = 0u;
+};
+
+static_assert(sizeof(PackHeader) == 56u);
+static_assert(sizeof(PackArchive::Entry) == 40u);
+static_assert(sizeof(PackArchive::Block) == 16u);
+
+/// Files are read and compressed this many blocks at a time, packing does not need memory in proportion to the file size.
+static constexpr uint32_t PackBlocksPerBatch = 256u;
+static constexpr size_t PackBatchSize = static_cast<size_t>(PackBlocksPerBatch) * PackArchive::BlockSize;
+
+/// XXHash64 of the content batch by batch, every batch seeded with the hash of the ones before, so packing hashes while it streams.
+static uint64_t ComputeContentHash(const std::byte* Data, size_t Size, uint64_t Hash = 0u)
+{
+	for (size_t Offset = 0u; Offset < Size; Offset += PackBatchSize)
+	{
+		Hash = XXHash64(Data + Offset, std::min(PackBatchSize, Size - Offset), Hash);
+	}
+	return Hash;
+}
+
+static uint32_t GetNumBlocks(uint64_t Size)
+{
+	return static_cast<uint32_t>((Size + PackArchive::BlockSize - 1u) / PackArchive::BlockSize);
+}
+
+std::string PackArchive::NormalizePath(const std::filesystem::path& Path)
+{
+	auto Normalized = Path.lexically_normal().generic_string();
+
+	const size_t Begin = Normalized.find_first_not_of('/');
+	Normalized.erase(0u, Begin == std::string::npos ? Normalized.size() : Begin);
+
+	std::transform(Normalized.begin(), Normalized.end(), Normalized.begin(), [](char Char) {
+		return static_cast<char>(std::tolower(static_cast<unsigned char>(Char)));
+	});
+
+	return Normalized;
+}
+
+std::shared_ptr<PackArchive> PackArchive::Open(const std::filesystem::path& Path)
+{
+	auto File = MappedFile::Open(Path);
+	if (!File || File->GetSize() < sizeof(PackHeader))
+	{
+		return nullptr;
+	}
+
+	PackHeader Header;
+	memcpy(&Header, File->GetData(), sizeof(PackHeader));
+
+	if (Header.Magic != Magic ||
+		Header.Version != Version ||
+		Header.BlockSize != BlockSize ||
+		Header.FileSize != File->GetSize() ||
+		Header.TocOffset < sizeof(PackHeader) ||
+		Header.TocOffset > File->GetSize() ||
+		Header.TocSize != File->GetSize() - Header.TocOffset ||
+		static_cast<uint64_t>(Header.NumEntries) * sizeof(Entry) + static_cast<uint64_t>(Header.NumBlocks) * sizeof(Block) > Header.TocSize)
+	{
+		LOG_ERROR(LogAsset, "Invalid pack archive \"{}\".", Path.string());
+		return nullptr;
+	}
+
+	const std::byte* Toc = File->GetData() + Header.TocOffset;
+	if (XXHash64(Toc, Header.TocSize) != Header.TocHash)
+	{
+		LOG_ERROR(LogAsset, "Corrupt table of contents in pack archive \"{}\".", Path.string());
+		return nullptr;
+	}
+
+	std::shared_ptr<PackArchive> Archive(new PackArchive());
+	Archive->m_Path = Path;
+
+	const size_t EntriesSize = Header.NumEntries * sizeof(Entry);
+	const size_t BlocksSize = Header.NumBlocks * sizeof(Block);
+
+	Archive->m_Entries.resize(Header.NumEntries);
+	Archive->m_Blocks.resize(Header.NumBlocks);
+	Archive->m_Paths.resize(Header.TocSize - EntriesSize - BlocksSize);
+
+	memcpy(Archive->m_Entries.data(), Toc, EntriesSize);
+	memcpy(Archive->m_Blocks.data(), Toc + EntriesSize, BlocksSize);
+	memcpy(Archive->m_Paths.data(), Toc + EntriesSize + BlocksSize, Archive->m_Paths.size());
+
+	for (const auto& Target : Archive->m_Entries)
+	{
+		if (static_cast<uint64_t>(Target.FirstBlock) + Target.NumBlocks > Header.NumBlocks ||
+			Target.NumBlocks != GetNumBlocks(Target.Size) ||
+			static_cast<uint64_t>(Target.PathOffset) + Target.PathLength > Archive->m_Paths.size())
+		{
+			LOG_ERROR(LogAsset, "Invalid entry in pack archive \"{}\".", Path.string());
+			return nullptr;
+		}
+	}
+
+	/// FindEntry binary searches the entries.
+	if (!std::is_sorted(Archive->m_Entries.begin(), Archive->m_Entries.end(), [](const Entry& Lhs, const Entry& Rhs) { return Lhs.PathHash < Rhs.PathHash; }))
+	{
+		LOG_ERROR(LogAsset, "Unsorted table of contents in pack archive \"{}\".", Path.string());
+		return nullptr;
+	}
+
+	for (const auto& Source : Archive->m_Blocks)
+	{
+		if (Source.Offset < sizeof(PackHeader) ||
+			Source.Offset + Source.CompressedSize > Header.TocOffset ||
+			Source.CompressedSize > BlockCompression::GetCompressBound(Source.Method, BlockSize))
+		{
+			LOG_ERROR(LogAsset, "Invalid block in pack archive \"{}\".", Path.string());
+			return nullptr;
+		}
+
+		if (!BlockCompression::IsSupported(Source.Method))
+		{
+			LOG_ERROR(LogAsset, "Pack archive \"{}\" uses {} compression which this build does not support.", Path.string(), magic_enum::enum_name(Source.Method));
+			return nullptr;
+		}
+	}
+
+	Archive->m_File = std::move(File);
+	return Archive;
+}
+
+bool PackArchive::Build(const std::vector<PackSourceFile>& Files, const std::filesystem::path& OutputPath, ECompressionMethod Method)
+{
+	if (!BlockCompression::IsSupported(Method))
+	{
+		LOG_ERROR(LogAsset, "{} compression is not supported by this build.", magic_enum::enum_name(Method));
+		return false;
+	}
+
+	if (OutputPath.has_parent_path() && !std::filesystem::exists(OutputPath.parent_path()))
+	{
+		std::filesystem::create_directories(OutputPath.parent_path());
+	}
+
+	/// Write aside and swap in, a mounted archive is never replaced by a half written one.
+	auto TempPath = OutputPath;
+	TempPath += ".tmp";
+
+	/// Failed builds leave nothing behind, after the swap there is nothing left to remove.
+	struct TempFileRemover
+	{
+		const std::filesystem::path& Path;
+
+		~TempFileRemover()
+		{
+			std::error_code ErrorCode;
+			std::filesystem::remove(Path, ErrorCode);
+		}
+	} RemoveTempFile{ TempPath };
+
+	std::vector<Entry> Entries;
+	std::vector<Block> Blocks;
+	std::vector<char> Paths;
+	std::unordered_set<std::string> VirtualPaths;
+
+	PackHeader Header;
+	uint64_t TotalSize = 0u;
+
+	{
+		std::ofstream Stream(TempPath, std::ios::binary | std::ios::trunc);
+		if (!Stream.is_open())
+		{
+			LOG_ERROR(LogAsset, "Failed to create pack archive \"{}\".", TempPath.string());
+			return false;
+		}
+
+		Stream.write(reinterpret_cast<const char*>(&Header), sizeof(PackHeader));
+		uint64_t WriteOffset = sizeof(PackHeader);
+
+		const size_t CompressBound = BlockCompression::GetCompressBound(Method, BlockSize);
+
+		std::vector<std::byte> Uncompressed(PackBatchSize);
+		std::vector<std::byte> Compressed(PackBlocksPerBatch * CompressBound);
+		std::vector<size_t> CompressedSizes(PackBlocksPerBatch);
+
+		for (const auto& File : Files)
+		{
+			auto VirtualPath = NormalizePath(File.VirtualPath);
+			if (VirtualPath.empty() || !VirtualPaths.insert(VirtualPath).second)
+			{
+				LOG_ERROR(LogAsset, "Invalid or duplicate path \"{}\" in pack archive \"{}\".", File.VirtualPath, OutputPath.string());
+				return false;
+			}
+
+			std::error_code ErrorCode;
+			const uint64_t Size = std::filesystem::file_size(File.Path, ErrorCode);
+			std::ifstream Source(File.Path, std::ios::in | std::ios::binary);
+			if (ErrorCode || !Source.is_open())
+			{
+				LOG_ERROR(LogAsset, "Failed to open \"{}\".", File.Path.string());
+				return false;
+			}
+
+			if (Blocks.size() + GetNumBlocks(Size) > std::numeric_limits<uint32_t>::max() ||
+				Paths.size() + VirtualPath.size() > std::numeric_limits<uint32_t>::max())
+			{
+				LOG_ERROR(LogAsset, "Too many files for pack archive \"{}\".", OutputPath.string());
+				return false;
+			}
+
+			Entry NewEntry;
+			NewEntry.PathHash = FnvHash(VirtualPath.data(), VirtualPath.size());
+			NewEntry.ContentHash = 0u;
+			NewEntry.Size = Size;
+			NewEntry.FirstBlock = static_cast<uint32_t>(Blocks.size());
+			NewEntry.NumBlocks = GetNumBlocks(Size);
+			NewEntry.PathOffset = static_cast<uint32_t>(Paths.size());
+			NewEntry.PathLength = static_cast<uint32_t>(VirtualPath.size());
+			Paths.insert(Paths.end(), VirtualPath.begin(), VirtualPath.end());
+
+			for (uint64_t Remaining = Size; Remaining > 0u;)
+			{
+				const size_t BatchSize = static_cast<size_t>(std::min<uint64_t>(Remaining, Uncompressed.size()));
+				Source.read(reinterpret_cast<char*>(Uncompressed.data()), static_cast<std::streamsize>(BatchSize));
+				if (static_cast<size_t>(Source.gcount()) != BatchSize)
+				{
+					LOG_ERROR(LogAsset, "Failed to read \"{}\".", File.Path.string());
+					return false;
+				}
+
+				NewEntry.ContentHash = ComputeContentHash(Uncompressed.data(), BatchSize, NewEntry.ContentHash);
+
+				std::vector<uint32_t> BlockIndices(GetNumBlocks(BatchSize));
+				std::iota(BlockIndices.begin(), BlockIndices.end(), 0u);
+
+				auto GetBlockSize = [BatchSize](uint32_t Index) {
+					return std::min<size_t>(BlockSize, BatchSize - static_cast<size_t>(Index) * BlockSize);
+				};
+
+				if (Method != ECompressionMethod::None)
+				{
+					TFTask::ParallelFor(BlockIndices.begin(), BlockIndices.end(), [&](uint32_t Index) {
+						CompressedSizes[Index] = BlockCompression::Compress(Method, Uncompressed.data() + static_cast<size_t>(Index) * BlockSize,
+							GetBlockSize(Index), Compressed.data() + Index * CompressBound, CompressBound);
+					})->Wait();
+				}
+
+				for (auto Index : BlockIndices)
+				{
+					const size_t UncompressedSize = GetBlockSize(Index);
+
+					/// Incompressible blocks are stored as they are, they would only cost decompression time.
+					const bool Store = Method == ECompressionMethod::None || CompressedSizes[Index] == 0u || CompressedSizes[Index] >= UncompressedSize;
+
+					Block NewBlock;
+					NewBlock.Offset = WriteOffset;
+					NewBlock.Method = Store ? ECompressionMethod::None : Method;
+					NewBlock.CompressedSize = static_cast<uint32_t>(Store ? UncompressedSize : CompressedSizes[Index]);
+
+					const std::byte* Data = Store ? Uncompressed.data() + static_cast<size_t>(Index) * BlockSize : Compressed.data() + Index * CompressBound;
+					Stream.write(reinterpret_cast<const char*>(Data), NewBlock.CompressedSize);
+					WriteOffset += NewBlock.CompressedSize;
+
+					Blocks.push_back(NewBlock);
+				}
+
+				Remaining -= BatchSize;
+			}
+
+			TotalSize += Size;
+			Entries.push_back(NewEntry);
+		}
+
+		/// Sorted by path hash for binary search, ties by path so the archive does not depend on the input order.
+		std::sort(Entries.begin(), Entries.end(), [&Paths](const Entry& Lhs, const Entry& Rhs) {
+			if (Lhs.PathHash != Rhs.PathHash)
+			{
+				return Lhs.PathHash < Rhs.PathHash;
+			}
+			return std::string_view(Paths.data() + Lhs.PathOffset, Lhs.PathLength) < std::string_view(Paths.data() + Rhs.PathOffset, Rhs.PathLength);
+		});
+
+		const char Zeros[alignof(uint64_t)]{};
+		const uint64_t TocOffset = Align<uint64_t>(WriteOffset, alignof(uint64_t));
+		Stream.write(Zeros, static_cast<std::streamsize>(TocOffset - WriteOffset));
+
+		const size_t EntriesSize = Entries.size() * sizeof(Entry);
+		const size_t BlocksSize = Blocks.size() * sizeof(Block);
+
+		/// Hashed as one range, the way Open sees it.
+		std::vector<std::byte> Toc(EntriesSize + BlocksSize + Paths.size());
+		memcpy(Toc.data(), Entries.data(), EntriesSize);
+		memcpy(Toc.data() + EntriesSize, Blocks.data(), BlocksSize);
+		memcpy(Toc.data() + EntriesSize + BlocksSize, Paths.data(), Paths.size());
+		Stream.write(reinterpret_cast<const char*>(Toc.data()), static_cast<std::streamsize>(Toc.size()));
+
+		Header.Magic = Magic;
+		Header.Version = Version;
+		Header.BlockSize = BlockSize;
+		Header.NumEntries = static_cast<uint32_t>(Entries.size());
+		Header.NumBlocks = static_cast<uint32_t>(Blocks.size());
+		Header.TocOffset = TocOffset;
+		Header.TocSize = Toc.size();
+		Header.TocHash = XXHash64(Toc.data(), Toc.size());
+		Header.FileSize = Header.TocOffset + Header.TocSize;
+
+		Stream.seekp(0);
+		Stream.write(reinterpret_cast<const char*>(&Header), sizeof(PackHeader));
+
+		if (!Stream.good())
+		{
+			LOG_ERROR(LogAsset, "Failed to write pack archive \"{}\".", TempPath.string());
+			return false;
+		}
+	}
+
+	std::error_code ErrorCode;
+	std::filesystem::rename(TempPath, OutputPath, ErrorCode);
+	if (ErrorCode)
+	{
+		LOG_ERROR(LogAsset, "Failed to write pack archive \"{}\": {}", OutputPath.string(), ErrorCode.message());
+		return false;
+	}
+
+	LOG_INFO(LogAsset, "Packed {} files of {:.2f} MB into \"{}\", {:.2f} MB.", Entries.size(),
+		static_cast<double>(TotalSize) / Megabyte, OutputPath.string(), static_cast<double>(Header.FileSize) / Megabyte);
+
+	return true;
+}
+
+const PackArchive::Entry* PackArchive::FindEntry(const std::filesystem::path& VirtualPath) const
+{
+	const auto Normalized = NormalizePath(VirtualPath);
+	const uint64_t PathHash = FnvHash(Normalized.data(), Normalized.size());
+
+	auto It = std::lower_bound(m_Entries.begin(), m_Entries.end(), PathHash, [](const Entry& Target, uint64_t Hash) {
+		return Target.PathHash < Hash;
+	});
+
+	for (; It != m_Entries.end() && It->PathHash == PathHash; ++It)
+	{
+		if (GetEntryPath(*It) == Normalized)
+		{
+			return &(*It);
+		}
+	}
+
+	return nullptr;
+}
+
+bool PackArchive::ReadBlock(const Entry& Target, uint32_t BlockIndex, size_t Offset, size_t Size, std::byte* Buffer) const
+{
+	const auto& Source = m_Blocks[Target.FirstBlock + BlockIndex];
+	const size_t UncompressedSize = static_cast<size_t>(std::min<uint64_t>(BlockSize, Target.Size - static_cast<uint64_t>(BlockIndex) * BlockSize));
+	const std::byte* Data = m_File->GetData() + Source.Offset;
+
+	if (Offset == 0u && Size == UncompressedSize)
+	{
+		return BlockCompression::Decompress(Source.Method, Data, Source.CompressedSize, Buffer, Size);
+	}
+
+	if (Source.Method == ECompressionMethod::None)
+	{
+		if (Source.CompressedSize != UncompressedSize)
+		{
+			return false;
+		}
+
+		memcpy(Buffer, Data + Offset, Size);
+		return true;
+	}
+
+	/// Partially covered blocks still decompress as a whole.
+	std::vector<std::byte> Scratch(UncompressedSize);
+	if (!BlockCompression::Decompress(Source.Method, Data, Source.CompressedSize, Scratch.data(), UncompressedSize))
+	{
+		return false;
+	}
+
+	memcpy(Buffer, Scratch.data() + Offset, Size);
+	return true;
+}
+
+bool PackArchive::Read(const Entry& Target, size_t Offset, size_t Size, std::byte* Buffer) const
+{
+	if (Offset > Target.Size || Size > Target.Size - Offset)
+	{
+		return false;
+	}
+
+	if (Size == 0u)
+	{
+		return true;
+	}
+
+	auto ReadCoveredBlock = [this, &Target, Offset, Size, Buffer](uint32_t BlockIndex) {
+		const size_t BlockBegin = static_cast<size_t>(BlockIndex) * BlockSize;
+		const size_t Begin = std::max(Offset, BlockBegin);
+		const size_t End = std::min(Offset + Size, BlockBegin + BlockSize);
+		return ReadBlock(Target, BlockIndex, Begin - BlockBegin, End - Begin, Buffer + (Begin - Offset));
+	};
+
+	const uint32_t FirstBlock = static_cast<uint32_t>(Offset / BlockSize);
+	const uint32_t LastBlock = static_cast<uint32_t>((Offset + Size - 1u) / BlockSize);
+
+	bool Succeeded = true;
+	if (FirstBlock == LastBlock)
+	{
+		Succeeded = ReadCoveredBlock(FirstBlock);
+	}
+	else
+	{
+		std::vector<uint32_t> BlockIndices(LastBlock - FirstBlock + 1u);
+		std::iota(BlockIndices.begin(), BlockIndices.end(), FirstBlock);
+
+		std::atomic<bool> Failed{ false };
+		TFTask::ParallelFor(BlockIndices.begin(), BlockIndices.end(), [&ReadCoveredBlock, &Failed](uint32_t BlockIndex) {
+			if (!ReadCoveredBlock(BlockIndex))
+			{
+				Failed.store(true, std::memory_order_relaxed);
+			}
+		})->Wait();
+
+		Succeeded = !Failed.load(std::memory_order_relaxed);
+	}
+
+	if (!Succeeded)
+	{
+		LOG_ERROR(LogAsset, "Corrupt data of \"{}\" in pack archive \"{}\".", GetEntryPath(Target), m_Path.string());
+	}
+
+	return Succeeded;
+}
+
+std::shared_ptr<DataBlock> PackArchive::ReadFile(const Entry& Target) const
+{
+	if (Target.Size == 0u)
+	{
+		return std::make_shared<DataBlock>();
+	}
+
+	auto Data = std::make_shared<DataBlock>(DataBlock::CreateUninitialized(static_cast<size_t>(Target.Size)));
+	if (!Read(Target, 0u, Data->GetSize(), Data->GetRawData()))
+	{
+		return nullptr;
+	}
+
+	if (CVarVFSVerifyHashes.Get() && !VerifyContentHash(Target, *Data))
+	{
+		LOG_ERROR(LogAsset, "Content hash mismatch of \"{}\" in pack archive \"{}\".", GetEntryPath(Target), m_Path.string());
+		return nullptr;
+	}
+
+	return Data;
+}
+
+bool PackArchive::VerifyContentHash(const Entry& Target, const DataBlock& Data) const
+{
+	return Data.GetSize() == Target.Size && ComputeContentHash(Data.GetRawData(), Data.GetSize()) == Target.ContentHash;
+}
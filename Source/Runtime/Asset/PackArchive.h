@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Asset/Asset.h"
+#include "Asset/BlockCompression.h"
+
+struct PackSourceFile
+{
+	std::filesystem::path Path;
+
+	/// Path inside the archive, relative to where the archive gets mounted.
+	std::string VirtualPath;
+};
+
+/// Read only archive of many files in one. Every file is split into 64KB blocks which are compressed independently, so any range of a
+/// file is read by decompressing just the blocks covering it, and blocks of large reads decompress in parallel on the workers.
+/// Layout: header, block data, table of contents (entries sorted by path hash, block table, path strings). The archive is memory mapped,
+/// the table of contents is copied out on open and validated against its hash.
+class PackArchive
+{
+public:
+	static constexpr uint32_t Magic = 0x4B415052u; /// "RPAK"
+	static constexpr uint32_t Version = 2u;
+	static constexpr uint32_t BlockSize = 64u * 1024u;
+
+	static constexpr std::string_view GetExtension() { return ".pak"; }
+
+	struct Entry
+	{
+		uint64_t PathHash = 0u;
+		uint64_t ContentHash = 0u;
+		uint64_t Size = 0u;
+		uint32_t FirstBlock = 0u;
+		uint32_t NumBlocks = 0u;
+		uint32_t PathOffset = 0u;
+		uint32_t PathLength = 0u;
+	};
+
+	struct Block
+	{
+		uint64_t Offset = 0u;
+		uint32_t CompressedSize = 0u;
+		ECompressionMethod Method = ECompressionMethod::None;
+		uint8_t Padding[3]{};
+	};
+
+	/// Returns null if the file is missing, is no pack archive or fails validation.
+	static std::shared_ptr<PackArchive> Open(const std::filesystem::path& Path);
+
+	/// Packs Files into a new archive at OutputPath. Blocks that do not get smaller are stored uncompressed.
+	static bool Build(const std::vector<PackSourceFile>& Files, const std::filesystem::path& OutputPath, ECompressionMethod Method);
+
+	/// Archive paths are generic and lowercase, lookups are case insensitive.
+	static std::string NormalizePath(const std::filesystem::path& Path);
+
+	const Entry* FindEntry(const std::filesystem::path& VirtualPath) const;
+
+	inline const std::vector<Entry>& GetEntries() const { return m_Entries; }
+	inline std::string_view GetEntryPath(const Entry& Target) const { return std::string_view(m_Paths.data() + Target.PathOffset, Target.PathLength); }
+	inline const std::filesystem::path& GetPath() const { return m_Path; }
+
+	/// Reads [Offset, Offset + Size) of the entry into Buffer.
+	bool Read(const Entry& Target, size_t Offset, size_t Size, std::byte* Buffer) const;
+
+	/// The whole entry, the content hash is checked if vfs.verify_hashes is set.
+	std::shared_ptr<DataBlock> ReadFile(const Entry& Target) const;
+
+	bool VerifyContentHash(const Entry& Target, const DataBlock& Data) const;
+private:
+	PackArchive() = default;
+
+	bool ReadBlock(const Entry& Target, uint32_t BlockIndex, size_t Offset, size_t Size, std::byte* Buffer) const;
+
+	std::filesystem::path m_Path;
+	std::shared_ptr<class MappedFile> m_File;
+
+	std::vector<Entry> m_Entries;
+	std::vector<Block> m_Blocks;
+	std::vector<char> m_Paths;
+};
@@ -41,6 +41,8 @@ public:
 
 		FileStream.close();
 
+		SetContentHash(ComputeContentHash(GetPath()));
+
 		OnPostLoad();
 	}
 
@@ -65,22 +67,41 @@ public:
 			std::chrono::system_clock::time_point SerializeTimepoint = std::chrono::system_clock::now();
 			SetLastWriteTime(SerializeTimepoint);
 
-			std::ofstream FileStream(SavePath);
+			/// Write aside and swap in, readers and concurrent writers never see a half written file.
+			const auto TempPath = GetTempPath(SavePath);
+			std::ofstream FileStream(TempPath);
 			if (FileStream.is_open())
 			{
-				cereal::JSONOutputArchive Ar(FileStream);
-				Ar(
-					cereal::make_nvp(typeid(Type).name(), *static_cast<Type*>(this))
-				);
+				{
+					cereal::JSONOutputArchive Ar(FileStream);
+					Ar(
+						cereal::make_nvp(typeid(Type).name(), *static_cast<Type*>(this))
+					);
+				}
+
+				FileStream.close();
+
+				std::error_code ErrorCode;
+				std::filesystem::rename(TempPath, SavePath, ErrorCode);
+				if (ErrorCode)
+				{
+					//LOG_ERROR("Failed to save serializable asset: \"{}\", {}", SavePath.string());
+					std::filesystem::remove(TempPath, ErrorCode);
+					return;
+				}
 			}
 			else
 			{
 				//LOG_ERROR("Failed to save serializable asset: \"{}\", {}", SavePath.string());
+				return;
 			}
 
-			FileStream.close();
-
 			File::SetLastWriteTime(SavePath, SerializeTimepoint);
+
+			if (SavePath == GetPath())
+			{
+				SetContentHash(ComputeContentHash(SavePath));
+			}
 		}
 	}
 
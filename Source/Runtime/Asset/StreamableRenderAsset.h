@@ -2,11 +2,24 @@
 
 #include "Core/Definitions.h"
 
+/// Render asset whose mips are only partially resident. Mips are counted from the smallest one, so NumMips resident mips
+/// are the NumMips least detailed levels. Only one request is in flight at a time, StreamIn and StreamOut return false while
+/// the previous one is pending or when there is nothing to do.
 class StreamableRenderAsset
 {
 public:
-	virtual ~StreamableRenderAsset();
+	virtual ~StreamableRenderAsset() = default;
 
+	/// Asynchronously raises the resident mips to NumMips.
 	virtual bool StreamIn(uint32_t /*NumMips*/) { return false; }
+
+	/// Asynchronously drops the resident mips to NumMips.
 	virtual bool StreamOut(uint32_t /*NumMips*/) { return false; }
+
+	inline uint32_t GetNumResidentMips() const { return m_NumResidentMips.load(std::memory_order_acquire); }
+	inline uint32_t GetNumRequestedMips() const { return m_NumRequestedMips.load(std::memory_order_acquire); }
+	inline bool IsStreaming() const { return GetNumResidentMips() != GetNumRequestedMips(); }
+protected:
+	std::atomic<uint32_t> m_NumResidentMips = 0u;
+	std::atomic<uint32_t> m_NumRequestedMips = 0u;
 };
@@ -0,0 +1,223 @@
+#include "Asset/VirtualFileSystem.h"
+#include "Async/AsyncIO.h"
+#include "Core/ConsoleVariable.h"
+#include "Services/SpdLogService.h"
+#include "Paths.h"
+
+ConsoleVariable<bool> CVarVFSPreferLooseFiles(
+	"vfs.prefer_loose_files",
+	"Loose files in the asset directory shadow the files of pack archives, edited assets are picked up without repacking.",
+	true);
+
+void VirtualFileSystem::Initialize()
+{
+	const auto& AssetPath = Paths::AssetPath();
+
+	std::vector<std::filesystem::path> Archives;
+	std::error_code ErrorCode;
+	for (const auto& Entry : std::filesystem::directory_iterator(AssetPath, ErrorCode))
+	{
+		if (Entry.is_regular_file() && _stricmp(Entry.path().extension().string().c_str(), PackArchive::GetExtension().data()) == 0)
+		{
+			Archives.push_back(Entry.path());
+		}
+	}
+
+	/// Mounted in name order, so e.g. patch archives shadow the archives they patch by name.
+	std::sort(Archives.begin(), Archives.end());
+
+	if (!CVarVFSPreferLooseFiles.Get())
+	{
+		Mount(AssetPath, AssetPath);
+	}
+
+	for (const auto& Archive : Archives)
+	{
+		Mount(AssetPath, Archive);
+	}
+
+	if (CVarVFSPreferLooseFiles.Get())
+	{
+		Mount(AssetPath, AssetPath);
+	}
+}
+
+void VirtualFileSystem::Finalize()
+{
+	std::unique_lock Locker(m_Lock);
+	m_MountPoints.clear();
+}
+
+std::filesystem::path VirtualFileSystem::GetAbsolutePath(const std::filesystem::path& Path)
+{
+	std::error_code ErrorCode;
+	auto AbsolutePath = std::filesystem::absolute(Path, ErrorCode);
+	return ErrorCode ? Path.lexically_normal() : AbsolutePath.lexically_normal();
+}
+
+bool VirtualFileSystem::Mount(const std::filesystem::path& Root, const std::filesystem::path& Source)
+{
+	MountPoint NewMountPoint;
+	NewMountPoint.Root = GetAbsolutePath(Root);
+	NewMountPoint.Source = GetAbsolutePath(Source);
+
+	std::error_code ErrorCode;
+	if (!std::filesystem::is_directory(NewMountPoint.Source, ErrorCode))
+	{
+		NewMountPoint.Archive = PackArchive::Open(NewMountPoint.Source);
+		if (!NewMountPoint.Archive)
+		{
+			LOG_ERROR(LogAsset, "Failed to mount \"{}\".", Source.string());
+			return false;
+		}
+
+		LOG_INFO(LogAsset, "Mount pack archive \"{}\" with {} files to \"{}\".", Source.string(), NewMountPoint.Archive->GetEntries().size(), Root.string());
+	}
+	else
+	{
+		LOG_INFO(LogAsset, "Mount directory \"{}\" to \"{}\".", Source.string(), Root.string());
+	}
+
+	std::unique_lock Locker(m_Lock);
+	m_MountPoints.emplace_back(std::move(NewMountPoint));
+	return true;
+}
+
+bool VirtualFileSystem::Unmount(const std::filesystem::path& Source)
+{
+	const auto AbsolutePath = GetAbsolutePath(Source);
+
+	std::unique_lock Locker(m_Lock);
+
+	auto It = std::find_if(m_MountPoints.begin(), m_MountPoints.end(), [&AbsolutePath](const MountPoint& Mounted) {
+		return Mounted.Source == AbsolutePath;
+	});
+	if (It == m_MountPoints.end())
+	{
+		return false;
+	}
+
+	m_MountPoints.erase(It);
+	return true;
+}
+
+bool VirtualFileSystem::Resolve(const std::filesystem::path& Path, ResolvedPath& OutResolved) const
+{
+	const auto AbsolutePath = GetAbsolutePath(Path);
+	std::error_code ErrorCode;
+
+	{
+		std::shared_lock Locker(m_Lock);
+
+		for (auto It = m_MountPoints.rbegin(); It != m_MountPoints.rend(); ++It)
+		{
+			const auto RelativePath = AbsolutePath.lexically_relative(It->Root);
+			if (RelativePath.empty() || *RelativePath.begin() == "..")
+			{
+				continue;
+			}
+
+			if (It->Archive)
+			{
+				if (auto Entry = It->Archive->FindEntry(RelativePath))
+				{
+					OutResolved.Archive = It->Archive;
+					OutResolved.Entry = Entry;
+					return true;
+				}
+			}
+			else
+			{
+				auto LoosePath = It->Source / RelativePath;
+				if (std::filesystem::is_regular_file(LoosePath, ErrorCode))
+				{
+					OutResolved.LoosePath = std::move(LoosePath);
+					return true;
+				}
+			}
+		}
+	}
+
+	if (std::filesystem::is_regular_file(Path, ErrorCode))
+	{
+		OutResolved.LoosePath = Path;
+		return true;
+	}
+
+	return false;
+}
+
+bool VirtualFileSystem::Exists(const std::filesystem::path& Path) const
+{
+	ResolvedPath Resolved;
+	return Resolve(Path, Resolved);
+}
+
+bool VirtualFileSystem::IsLooseFile(const std::filesystem::path& Path) const
+{
+	ResolvedPath Resolved;
+	return !Resolve(Path, Resolved) || !Resolved.IsPacked();
+}
+
+size_t VirtualFileSystem::GetFileSize(const std::filesystem::path& Path) const
+{
+	ResolvedPath Resolved;
+	if (!Resolve(Path, Resolved))
+	{
+		return 0u;
+	}
+
+	if (Resolved.IsPacked())
+	{
+		return static_cast<size_t>(Resolved.Entry->Size);
+	}
+
+	std::error_code ErrorCode;
+	const auto Size = std::filesystem::file_size(Resolved.LoosePath, ErrorCode);
+	return ErrorCode ? 0u : static_cast<size_t>(Size);
+}
+
+std::shared_ptr<DataBlock> VirtualFileSystem::ReadFile(const std::filesystem::path& Path, TFTask::EPriority Priority) const
+{
+	ResolvedPath Resolved;
+	if (!Resolve(Path, Resolved))
+	{
+		return nullptr;
+	}
+
+	if (Resolved.IsPacked())
+	{
+		return Resolved.Archive->ReadFile(*Resolved.Entry);
+	}
+
+	auto Read = AsyncIO::Get().ReadFile(Resolved.LoosePath, Priority);
+	if (!Read || !Read->Wait())
+	{
+		return nullptr;
+	}
+
+	return Read->TakeData();
+}
+
+bool VirtualFileSystem::Read(const std::filesystem::path& Path, size_t Offset, size_t Size, std::byte* Buffer) const
+{
+	ResolvedPath Resolved;
+	if (!Resolve(Path, Resolved))
+	{
+		return false;
+	}
+
+	if (Resolved.IsPacked())
+	{
+		return Resolved.Archive->Read(*Resolved.Entry, Offset, Size, Buffer);
+	}
+
+	AsyncReadRequest Request;
+	Request.Path = std::move(Resolved.LoosePath);
+	Request.Offset = Offset;
+	Request.Size = Size;
+	Request.Buffer = Buffer;
+	Request.Priority = TFTask::EPriority::High;
+
+	return AsyncIO::Get().Read(std::move(Request))->Wait();
+}
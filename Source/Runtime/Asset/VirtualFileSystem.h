@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Asset/PackArchive.h"
+#include "Async/Task.h"
+#include "Core/Singleton.h"
+
+/// Resolves asset paths against mount points. A mount point maps a directory of loose files or a pack archive to a root path, paths
+/// below the root are looked up in the mounts from the most recent one on, so later mounts shadow earlier ones. Paths outside of every
+/// mount point, and paths no mount knows, resolve to the loose file on disk as if there was no file system layer.
+class VirtualFileSystem : public Singleton<VirtualFileSystem>
+{
+public:
+	/// Mounts the asset directory and the pack archives in it.
+	void Initialize();
+	void Finalize();
+
+	/// Source is a directory or a pack archive, Root the path its files appear under.
+	bool Mount(const std::filesystem::path& Root, const std::filesystem::path& Source);
+	bool Unmount(const std::filesystem::path& Source);
+
+	bool Exists(const std::filesystem::path& Path) const;
+
+	/// False if Path resolves into a pack archive. Anything that needs a real file (memory mapping, third party importers) has to check this.
+	bool IsLooseFile(const std::filesystem::path& Path) const;
+
+	/// Size of the file, 0 if it does not exist.
+	size_t GetFileSize(const std::filesystem::path& Path) const;
+
+	/// Loose files are read through AsyncIO, packed files decompress on the workers. Blocks until the data is there, nullptr on failure.
+	std::shared_ptr<DataBlock> ReadFile(const std::filesystem::path& Path, TFTask::EPriority Priority = TFTask::EPriority::High) const;
+
+	/// Reads [Offset, Offset + Size) of the file into Buffer.
+	bool Read(const std::filesystem::path& Path, size_t Offset, size_t Size, std::byte* Buffer) const;
+protected:
+	ALLOW_ACCESS(VirtualFileSystem);
+private:
+	struct MountPoint
+	{
+		std::filesystem::path Root;
+		std::filesystem::path Source;
+		std::shared_ptr<PackArchive> Archive;
+	};
+
+	struct ResolvedPath
+	{
+		std::filesystem::path LoosePath;
+
+		/// Keeps the archive alive while the entry is read, even if it gets unmounted meanwhile.
+		std::shared_ptr<PackArchive> Archive;
+		const PackArchive::Entry* Entry = nullptr;
+
+		inline bool IsPacked() const { return Entry != nullptr; }
+	};
+
+	static std::filesystem::path GetAbsolutePath(const std::filesystem::path& Path);
+
+	/// False if Path does not exist.
+	bool Resolve(const std::filesystem::path& Path, ResolvedPath& OutResolved) const;
+
+	/// Most recent mount last.
+	std::vector<MountPoint> m_MountPoints;
+	mutable std::shared_mutex m_Lock;
+};
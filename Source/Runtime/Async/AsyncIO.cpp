@@ -0,0 +1,662 @@
+#include "Async/AsyncIO.h"
+#include "Core/ConsoleVariable.h"
+#include "Services/SpdLogService.h"
+
+#if USE_IO_URING
+	#include <liburing.h>
+	#include <cerrno>
+	#include <cstring>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <sys/eventfd.h>
+#endif
+
+ConsoleVariable<bool> CVarIOUseIOUring(
+	"io.use_io_uring",
+	"Use io_uring for asynchronous file reads where it is available, dedicated I/O threads otherwise.",
+	true);
+
+ConsoleVariable<uint32_t> CVarIOQueueDepth(
+	"io.queue_depth",
+	"Maximum number of reads in flight on the io_uring backend.",
+	64u);
+
+ConsoleVariable<uint32_t> CVarIONumThreads(
+	"io.num_threads",
+	"Number of dedicated I/O threads of the thread pool backend.",
+	4u);
+
+/// The thread pool backend reads in chunks of this size, canceling a huge read does not wait for all of it.
+static constexpr size_t BlockingReadChunkSize = 4u * Megabyte;
+
+bool AsyncReadHandle::Wait()
+{
+	std::unique_lock Locker(m_Lock);
+	m_Done.wait(Locker, [this]() { return IsDone(); });
+	return GetStatus() == EStatus::Completed;
+}
+
+bool AsyncReadHandle::Cancel()
+{
+	return AsyncIO::Get().Cancel(*this);
+}
+
+void AsyncReadHandle::SetStatus(EStatus Status)
+{
+	{
+		std::lock_guard Locker(m_Lock);
+		m_Status.store(Status, std::memory_order_release);
+	}
+
+	if (IsDone())
+	{
+		m_Done.notify_all();
+	}
+}
+
+#if USE_IO_URING
+struct AsyncIO::IOUringContext
+{
+	static constexpr uint64_t WakeupUserData = ~0ull;
+	static constexpr uint64_t CancelUserData = ~0ull - 1u;
+
+	struct Slot
+	{
+		AsyncReadHandlePtr Handle;
+		int File = -1;
+		size_t BytesRead = 0u;
+		bool CancelSubmitted = false;
+	};
+
+	io_uring Ring{};
+	int WakeupEvent = -1;
+	std::vector<Slot> Slots;
+	std::vector<uint32_t> FreeSlots;
+
+	inline uint32_t GetNumInFlight() const { return static_cast<uint32_t>(Slots.size() - FreeSlots.size()); }
+
+	io_uring_sqe* GetSQE()
+	{
+		auto SQE = io_uring_get_sqe(&Ring);
+		if (!SQE)
+		{
+			/// Submission queue is full, flush it and retry.
+			io_uring_submit(&Ring);
+			SQE = io_uring_get_sqe(&Ring);
+		}
+
+		assert(SQE);
+		return SQE;
+	}
+
+	void ArmWakeup()
+	{
+		auto SQE = GetSQE();
+		io_uring_prep_poll_add(SQE, WakeupEvent, POLLIN);
+		io_uring_sqe_set_data(SQE, reinterpret_cast<void*>(static_cast<uintptr_t>(WakeupUserData)));
+	}
+
+	/// Reads whatever is left of the request, short reads come back here until everything is read.
+	void PrepareRead(uint32_t Index)
+	{
+		auto& Target = Slots[Index];
+		const auto& Request = Target.Handle->GetRequest();
+
+		auto SQE = GetSQE();
+		io_uring_prep_read(SQE, Target.File, Request.Buffer + Target.BytesRead,
+			static_cast<unsigned>(std::min<size_t>(Request.Size - Target.BytesRead, std::numeric_limits<int32_t>::max())),
+			Request.Offset + Target.BytesRead);
+		io_uring_sqe_set_data(SQE, reinterpret_cast<void*>(static_cast<uintptr_t>(Index)));
+	}
+
+	void PrepareCancel(uint32_t Index)
+	{
+		auto& Target = Slots[Index];
+		if (Target.CancelSubmitted)
+		{
+			return;
+		}
+
+		auto SQE = GetSQE();
+		io_uring_prep_cancel(SQE, reinterpret_cast<void*>(static_cast<uintptr_t>(Index)), 0);
+		io_uring_sqe_set_data(SQE, reinterpret_cast<void*>(static_cast<uintptr_t>(CancelUserData)));
+		Target.CancelSubmitted = true;
+	}
+};
+
+bool AsyncIO::CreateIOUring()
+{
+	auto Context = std::make_unique<IOUringContext>();
+
+	const uint32_t QueueDepth = std::max(CVarIOQueueDepth.Get(), 1u);
+
+	/// Room for a read and a cancel per slot plus the wakeup poll.
+	const int Result = io_uring_queue_init(QueueDepth * 2u + 1u, &Context->Ring, 0u);
+	if (Result < 0)
+	{
+		LOG_WARNING(LogAsset, "Failed to create io_uring: {}, fall back to I/O threads.", strerror(-Result));
+		return false;
+	}
+
+	Context->WakeupEvent = ::eventfd(0u, EFD_CLOEXEC);
+	if (Context->WakeupEvent < 0)
+	{
+		LOG_WARNING(LogAsset, "Failed to create io_uring wakeup event: {}, fall back to I/O threads.", strerror(errno));
+		io_uring_queue_exit(&Context->Ring);
+		return false;
+	}
+
+	Context->Slots.resize(QueueDepth);
+	Context->FreeSlots.resize(QueueDepth);
+	for (uint32_t Index = 0u; Index < QueueDepth; ++Index)
+	{
+		Context->FreeSlots[Index] = QueueDepth - Index - 1u;
+	}
+
+	m_IOUring = std::move(Context);
+	return true;
+}
+
+void AsyncIO::DestroyIOUring()
+{
+	if (m_IOUring)
+	{
+		io_uring_queue_exit(&m_IOUring->Ring);
+		::close(m_IOUring->WakeupEvent);
+		m_IOUring.reset();
+	}
+}
+
+void AsyncIO::IOUringWorker()
+{
+	auto& Context = *m_IOUring;
+
+	auto Release = [&Context](uint32_t Index, AsyncReadHandle::EStatus Status) {
+		auto& Target = Context.Slots[Index];
+		::close(Target.File);
+
+		FinishRead(*Target.Handle, Target.BytesRead, Status);
+
+		Target = IOUringContext::Slot();
+		Context.FreeSlots.push_back(Index);
+	};
+
+	auto OnCompletion = [&Context, &Release](uint64_t UserData, int Result) {
+		if (UserData == IOUringContext::WakeupUserData)
+		{
+			uint64_t Counter = 0u;
+			VERIFY(::read(Context.WakeupEvent, &Counter, sizeof(Counter)) == sizeof(Counter));
+			Context.ArmWakeup();
+			return;
+		}
+
+		if (UserData == IOUringContext::CancelUserData)
+		{
+			return;
+		}
+
+		const uint32_t Index = static_cast<uint32_t>(UserData);
+		auto& Target = Context.Slots[Index];
+		const auto& Request = Target.Handle->GetRequest();
+
+		if (Result == -EINTR || Result == -EAGAIN)
+		{
+			Context.PrepareRead(Index);
+			return;
+		}
+
+		if (Result < 0)
+		{
+			if (Result == -ECANCELED || Target.Handle->IsCancelRequested())
+			{
+				Release(Index, AsyncReadHandle::EStatus::Canceled);
+			}
+			else
+			{
+				LOG_ERROR(LogAsset, "Failed to read \"{}\": {}", Request.Path.string(), strerror(-Result));
+				Release(Index, AsyncReadHandle::EStatus::Failed);
+			}
+			return;
+		}
+
+		Target.BytesRead += static_cast<size_t>(Result);
+
+		if (Target.BytesRead == Request.Size)
+		{
+			Release(Index, AsyncReadHandle::EStatus::Completed);
+		}
+		else if (Result == 0)
+		{
+			LOG_ERROR(LogAsset, "Failed to read \"{}\": range [{}, {}) is past the end of the file.", Request.Path.string(), Request.Offset, Request.Offset + Request.Size);
+			Release(Index, AsyncReadHandle::EStatus::Failed);
+		}
+		else if (Target.Handle->IsCancelRequested())
+		{
+			Release(Index, AsyncReadHandle::EStatus::Canceled);
+		}
+		else
+		{
+			Context.PrepareRead(Index);
+		}
+	};
+
+	auto ReapCompletions = [&Context, &OnCompletion]() {
+		io_uring_cqe* CQE = nullptr;
+		const int Result = io_uring_wait_cqe(&Context.Ring, &CQE);
+		if (Result < 0)
+		{
+			if (Result != -EINTR && Result != -EAGAIN)
+			{
+				LOG_ERROR(LogAsset, "Failed to wait for io_uring completions: {}", strerror(-Result));
+			}
+			return;
+		}
+
+		uint32_t Head = 0u;
+		uint32_t NumCompletions = 0u;
+		io_uring_for_each_cqe(&Context.Ring, Head, CQE)
+		{
+			OnCompletion(reinterpret_cast<uintptr_t>(io_uring_cqe_get_data(CQE)), CQE->res);
+			++NumCompletions;
+		}
+		io_uring_cq_advance(&Context.Ring, NumCompletions);
+	};
+
+	Context.ArmWakeup();
+
+	std::vector<AsyncReadHandlePtr> Batch;
+	std::vector<uint64_t> CancelRequests;
+
+	while (true)
+	{
+		bool Exit = false;
+
+		{
+			std::lock_guard Locker(m_Lock);
+
+			Exit = m_Exit;
+			while (!Exit && Batch.size() < Context.FreeSlots.size())
+			{
+				auto Handle = PopPendingLocked();
+				if (!Handle)
+				{
+					break;
+				}
+
+				Handle->SetStatus(AsyncReadHandle::EStatus::InFlight);
+				Batch.emplace_back(std::move(Handle));
+			}
+
+			CancelRequests.swap(m_CancelRequests);
+		}
+
+		if (Exit)
+		{
+			break;
+		}
+
+		for (auto& Handle : Batch)
+		{
+			const auto& Request = Handle->GetRequest();
+
+			const int File = ::open(Request.Path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (File < 0)
+			{
+				LOG_ERROR(LogAsset, "Failed to open \"{}\": {}", Request.Path.string(), strerror(errno));
+				FinishRead(*Handle, 0u, AsyncReadHandle::EStatus::Failed);
+				continue;
+			}
+
+			const uint32_t Index = Context.FreeSlots.back();
+			Context.FreeSlots.pop_back();
+
+			auto& Target = Context.Slots[Index];
+			Target.Handle = std::move(Handle);
+			Target.File = File;
+
+			Context.PrepareRead(Index);
+		}
+		Batch.clear();
+
+		for (auto ID : CancelRequests)
+		{
+			for (uint32_t Index = 0u; Index < Context.Slots.size(); ++Index)
+			{
+				if (Context.Slots[Index].Handle && Context.Slots[Index].Handle->GetID() == ID)
+				{
+					Context.PrepareCancel(Index);
+					break;
+				}
+			}
+		}
+		CancelRequests.clear();
+
+		/// One system call for the whole batch, then sleep until a read completes or WakeupLocked() signals new work.
+		io_uring_submit(&Context.Ring);
+		ReapCompletions();
+	}
+
+	/// The buffers belong to the callers, nothing may still be written into them once this returns.
+	for (uint32_t Index = 0u; Index < Context.Slots.size(); ++Index)
+	{
+		if (Context.Slots[Index].Handle)
+		{
+			Context.Slots[Index].Handle->m_CancelRequested.store(true, std::memory_order_release);
+			Context.PrepareCancel(Index);
+		}
+	}
+
+	while (Context.GetNumInFlight() > 0u)
+	{
+		io_uring_submit(&Context.Ring);
+		ReapCompletions();
+	}
+}
+#endif
+
+AsyncIO::~AsyncIO()
+{
+	Finalize();
+}
+
+void AsyncIO::Initialize()
+{
+	std::lock_guard Locker(m_Lock);
+	StartLocked();
+}
+
+void AsyncIO::StartLocked()
+{
+	if (m_Running)
+	{
+		return;
+	}
+
+	m_Running = true;
+	m_Exit = false;
+
+#if USE_IO_URING
+	if (CVarIOUseIOUring.Get() && CreateIOUring())
+	{
+		m_UseIOUring = true;
+		m_Threads.emplace_back(&AsyncIO::IOUringWorker, this);
+
+		LOG_INFO(LogAsset, "Async I/O uses io_uring with queue depth {}.", m_IOUring->Slots.size());
+		return;
+	}
+#endif
+
+	const uint32_t NumThreads = std::max(CVarIONumThreads.Get(), 1u);
+	for (uint32_t Index = 0u; Index < NumThreads; ++Index)
+	{
+		m_Threads.emplace_back(&AsyncIO::ThreadPoolWorker, this);
+	}
+
+	LOG_INFO(LogAsset, "Async I/O uses {} I/O threads.", NumThreads);
+}
+
+void AsyncIO::Finalize()
+{
+	std::vector<std::thread> Threads;
+	std::vector<AsyncReadHandlePtr> Dropped;
+
+	{
+		std::lock_guard Locker(m_Lock);
+
+		if (!m_Running)
+		{
+			return;
+		}
+
+		m_Exit = true;
+		Threads = std::move(m_Threads);
+
+		for (auto& Queue : m_Pending)
+		{
+			Dropped.insert(Dropped.end(), Queue.begin(), Queue.end());
+			Queue.clear();
+		}
+
+		WakeupLocked();
+	}
+
+	for (auto& Handle : Dropped)
+	{
+		FinishRead(*Handle, 0u, AsyncReadHandle::EStatus::Canceled);
+	}
+
+	for (auto& Thread : Threads)
+	{
+		Thread.join();
+	}
+
+	std::lock_guard Locker(m_Lock);
+
+#if USE_IO_URING
+	DestroyIOUring();
+	m_CancelRequests.clear();
+#endif
+
+	m_UseIOUring = false;
+	m_Running = false;
+}
+
+AsyncReadHandlePtr AsyncIO::Read(AsyncReadRequest&& Request)
+{
+	auto Handle = std::make_shared<AsyncReadHandle>(std::move(Request));
+	Submit({ Handle });
+	return Handle;
+}
+
+std::vector<AsyncReadHandlePtr> AsyncIO::Read(std::vector<AsyncReadRequest>&& Requests)
+{
+	std::vector<AsyncReadHandlePtr> Handles;
+	Handles.reserve(Requests.size());
+
+	for (auto& Request : Requests)
+	{
+		Handles.emplace_back(std::make_shared<AsyncReadHandle>(std::move(Request)));
+	}
+
+	Submit(Handles);
+	return Handles;
+}
+
+AsyncReadHandlePtr AsyncIO::ReadFile(const std::filesystem::path& Path, TFTask::EPriority Priority)
+{
+	std::error_code ErrorCode;
+	const size_t Size = static_cast<size_t>(std::filesystem::file_size(Path, ErrorCode));
+	if (ErrorCode)
+	{
+		return nullptr;
+	}
+
+	auto Data = std::make_shared<DataBlock>(DataBlock::CreateUninitialized(Size));
+
+	AsyncReadRequest Request;
+	Request.Path = Path;
+	Request.Size = Size;
+	Request.Buffer = Data->GetRawData();
+	Request.Priority = Priority;
+
+	auto Handle = std::make_shared<AsyncReadHandle>(std::move(Request));
+	Handle->m_Data = std::move(Data);
+
+	Submit({ Handle });
+	return Handle;
+}
+
+void AsyncIO::Submit(const std::vector<AsyncReadHandlePtr>& Handles)
+{
+	std::vector<AsyncReadHandle*> Empty;
+
+	{
+		std::lock_guard Locker(m_Lock);
+
+		StartLocked();
+
+		for (auto& Handle : Handles)
+		{
+			const auto& Request = Handle->GetRequest();
+			if (Request.Size == 0u)
+			{
+				Empty.push_back(Handle.get());
+				continue;
+			}
+
+			assert(Request.Buffer);
+			m_Pending[static_cast<size_t>(Request.Priority)].push_back(Handle);
+		}
+
+		WakeupLocked();
+	}
+
+	for (auto Handle : Empty)
+	{
+		FinishRead(*Handle, 0u, AsyncReadHandle::EStatus::Completed);
+	}
+}
+
+bool AsyncIO::Cancel(AsyncReadHandle& Handle)
+{
+	{
+		std::lock_guard Locker(m_Lock);
+
+		if (Handle.IsDone())
+		{
+			return false;
+		}
+
+		Handle.m_CancelRequested.store(true, std::memory_order_release);
+
+		auto& Queue = m_Pending[static_cast<size_t>(Handle.GetRequest().Priority)];
+		auto It = std::find_if(Queue.begin(), Queue.end(), [&Handle](const AsyncReadHandlePtr& Pending) { return Pending.get() == &Handle; });
+		if (It == Queue.end())
+		{
+#if USE_IO_URING
+			if (m_UseIOUring)
+			{
+				m_CancelRequests.push_back(Handle.GetID());
+				WakeupLocked();
+			}
+#endif
+			/// In flight, the thread pool backend checks the flag between chunks.
+			return true;
+		}
+
+		Queue.erase(It);
+	}
+
+	FinishRead(Handle, 0u, AsyncReadHandle::EStatus::Canceled);
+	return true;
+}
+
+AsyncReadHandlePtr AsyncIO::PopPendingLocked()
+{
+	for (size_t Priority = NumPriorities; Priority-- > 0u;)
+	{
+		auto& Queue = m_Pending[Priority];
+		if (!Queue.empty())
+		{
+			auto Handle = std::move(Queue.front());
+			Queue.pop_front();
+			return Handle;
+		}
+	}
+
+	return nullptr;
+}
+
+void AsyncIO::WakeupLocked()
+{
+#if USE_IO_URING
+	if (m_UseIOUring && m_IOUring)
+	{
+		const uint64_t Counter = 1u;
+		VERIFY(::write(m_IOUring->WakeupEvent, &Counter, sizeof(Counter)) == sizeof(Counter));
+		return;
+	}
+#endif
+
+	m_PendingSignal.notify_all();
+}
+
+void AsyncIO::FinishRead(AsyncReadHandle& Handle, size_t BytesRead, AsyncReadHandle::EStatus Status)
+{
+	Handle.m_BytesRead = BytesRead;
+	if (Status != AsyncReadHandle::EStatus::Completed)
+	{
+		/// Nobody gets to see a partially read buffer.
+		Handle.m_Data.reset();
+	}
+
+	Handle.SetStatus(Status);
+}
+
+void AsyncIO::ThreadPoolWorker()
+{
+	while (true)
+	{
+		AsyncReadHandlePtr Handle;
+
+		{
+			std::unique_lock Locker(m_Lock);
+
+			while (!m_Exit && !(Handle = PopPendingLocked()))
+			{
+				m_PendingSignal.wait(Locker);
+			}
+
+			if (!Handle)
+			{
+				return;
+			}
+
+			Handle->SetStatus(AsyncReadHandle::EStatus::InFlight);
+		}
+
+		BlockingRead(*Handle);
+	}
+}
+
+void AsyncIO::BlockingRead(AsyncReadHandle& Handle)
+{
+	const auto& Request = Handle.GetRequest();
+
+	std::ifstream FileStream(Request.Path, std::ios::in | std::ios::binary);
+	if (!FileStream.is_open() || !FileStream.seekg(static_cast<std::streamoff>(Request.Offset)))
+	{
+		LOG_ERROR(LogAsset, "Failed to open \"{}\".", Request.Path.string());
+		FinishRead(Handle, 0u, AsyncReadHandle::EStatus::Failed);
+		return;
+	}
+
+	size_t BytesRead = 0u;
+	while (BytesRead < Request.Size)
+	{
+		if (Handle.IsCancelRequested())
+		{
+			FinishRead(Handle, BytesRead, AsyncReadHandle::EStatus::Canceled);
+			return;
+		}
+
+		const size_t Size = std::min(Request.Size - BytesRead, BlockingReadChunkSize);
+		FileStream.read(reinterpret_cast<char*>(Request.Buffer + BytesRead), static_cast<std::streamsize>(Size));
+		BytesRead += static_cast<size_t>(FileStream.gcount());
+
+		if (!FileStream)
+		{
+			break;
+		}
+	}
+
+	if (BytesRead != Request.Size)
+	{
+		LOG_ERROR(LogAsset, "Failed to read \"{}\": range [{}, {}) is past the end of the file.", Request.Path.string(), Request.Offset, Request.Offset + Request.Size);
+		FinishRead(Handle, BytesRead, AsyncReadHandle::EStatus::Failed);
+		return;
+	}
+
+	FinishRead(Handle, BytesRead, AsyncReadHandle::EStatus::Completed);
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Async/Task.h"
+#include "Asset/Asset.h"
+
+struct AsyncReadRequest
+{
+	std::filesystem::path Path;
+	size_t Offset = 0u;
+	size_t Size = 0u;
+
+	/// Caller owned, has to stay valid until the read is done.
+	std::byte* Buffer = nullptr;
+
+	TFTask::EPriority Priority = TFTask::EPriority::Normal;
+};
+
+class AsyncReadHandle : public NoneCopyable
+{
+public:
+	enum class EStatus : uint8_t
+	{
+		Pending,
+		InFlight,
+		Completed,
+		Failed,
+		Canceled
+	};
+
+	AsyncReadHandle(AsyncReadRequest&& Request)
+		: m_Request(std::move(Request))
+	{
+	}
+
+	inline EStatus GetStatus(std::memory_order Order = std::memory_order_acquire) const { return m_Status.load(Order); }
+	inline bool IsDone() const { return GetStatus() > EStatus::InFlight; }
+	inline bool IsCancelRequested() const { return m_CancelRequested.load(std::memory_order_acquire); }
+
+	inline const AsyncReadRequest& GetRequest() const { return m_Request; }
+
+	/// Unique for the lifetime of the process, unlike the address of the handle.
+	inline uint64_t GetID() const { return m_ID; }
+
+	/// Valid once the read is done.
+	inline size_t GetBytesRead() const { return m_BytesRead; }
+
+	/// Reads issued by AsyncIO::ReadFile own their buffer, the caller takes it over once the read completed.
+	inline std::shared_ptr<DataBlock> TakeData() { return std::move(m_Data); }
+
+	/// Blocks until the read is done, returns true if every requested byte was read.
+	bool Wait();
+
+	/// Pending reads are dropped right away, reads already in flight are canceled as soon as the backend gets to it.
+	/// Returns false if the read was done already.
+	bool Cancel();
+protected:
+	friend class AsyncIO;
+
+	void SetStatus(EStatus Status);
+private:
+	static inline std::atomic<uint64_t> s_NextID = 0u;
+	const uint64_t m_ID = s_NextID.fetch_add(1u, std::memory_order_relaxed);
+
+	AsyncReadRequest m_Request;
+	std::shared_ptr<DataBlock> m_Data;
+
+	std::atomic<EStatus> m_Status{ EStatus::Pending };
+	std::atomic<bool> m_CancelRequested{ false };
+	size_t m_BytesRead = 0u;
+
+	std::mutex m_Lock;
+	std::condition_variable m_Done;
+};
+using AsyncReadHandlePtr = std::shared_ptr<AsyncReadHandle>;
+
+/// Asynchronous ranged file reads into caller buffers. Requests are queued by priority and handed to the backend in batches,
+/// on Linux that is an io_uring instance driven by a single submission thread (USE_IO_URING, when liburing was found at configure
+/// time), elsewhere or if the ring can not be created a small pool of dedicated I/O threads issues blocking reads.
+/// Either way no task worker is parked on the disk, it only waits if it needs the data before the read is done.
+class AsyncIO : public Singleton<AsyncIO>
+{
+public:
+	void Initialize();
+	void Finalize();
+
+	AsyncReadHandlePtr Read(AsyncReadRequest&& Request);
+
+	/// Queued under a single lock and submitted to the kernel together.
+	std::vector<AsyncReadHandlePtr> Read(std::vector<AsyncReadRequest>&& Requests);
+
+	/// Reads the whole file into a new DataBlock, nullptr if the file does not exist.
+	AsyncReadHandlePtr ReadFile(const std::filesystem::path& Path, TFTask::EPriority Priority = TFTask::EPriority::Normal);
+
+	inline bool IsUsingIOUring() const { return m_UseIOUring; }
+protected:
+	ALLOW_ACCESS(AsyncIO);
+
+	friend class AsyncReadHandle;
+
+	~AsyncIO();
+
+	bool Cancel(AsyncReadHandle& Handle);
+private:
+	static constexpr size_t NumPriorities = static_cast<size_t>(TFTask::EPriority::Critical) + 1u;
+
+	void Submit(const std::vector<AsyncReadHandlePtr>& Handles);
+
+	/// Caller holds m_Lock for all of the *Locked functions.
+	void StartLocked();
+	void WakeupLocked();
+
+	/// Highest priority first, nullptr if nothing is pending.
+	AsyncReadHandlePtr PopPendingLocked();
+
+	static void FinishRead(AsyncReadHandle& Handle, size_t BytesRead, AsyncReadHandle::EStatus Status);
+
+	void ThreadPoolWorker();
+	void BlockingRead(AsyncReadHandle& Handle);
+
+	std::array<std::deque<AsyncReadHandlePtr>, NumPriorities> m_Pending;
+
+	std::mutex m_Lock;
+	std::condition_variable m_PendingSignal;
+	std::vector<std::thread> m_Threads;
+	bool m_Running = false;
+	bool m_Exit = false;
+	bool m_UseIOUring = false;
+
+#if USE_IO_URING
+	bool CreateIOUring();
+	void DestroyIOUring();
+	void IOUringWorker();
+
+	struct IOUringContext;
+	std::unique_ptr<IOUringContext> m_IOUring;
+
+	/// IDs of in flight reads that were asked to cancel, the ring thread turns them into cancel requests. A read that completed
+	/// meanwhile matches none of its slots, and a handle allocated at the same address has another ID.
+	std::vector<uint64_t> m_CancelRequests;
+#endif
+};
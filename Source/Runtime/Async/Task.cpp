@@ -180,6 +180,22 @@ TFTaskEventPtr TFTask::DispatchTaskFlow(tf::Taskflow&& Flow, EThread Thread, EPr
 	return nullptr;
 }
 
+void TFTask::CorunTaskFlow(tf::Taskflow& Flow, EThread Thread, EPriority Priority)
+{
+	if (auto Executor = TFExecutorManager::Get().GetExecutor(Thread, Priority))
+	{
+		/// Only a worker of the same executor can corun, anyone else has nothing to help with and just waits.
+		if (Executor->this_worker_id() >= 0)
+		{
+			Executor->corun(Flow);
+		}
+		else
+		{
+			Executor->run(Flow).wait();
+		}
+	}
+}
+
 uint32_t TFTask::GetNumWorkerThreads()
 {
 	static uint32_t s_NumWorkerThreads = 0u;
@@ -288,7 +304,13 @@ bool TFTask::Trigger()
 
 		for (auto Prerequisite : m_Prerequisites)
 		{
-			if (Prerequisite && Prerequisite->Trigger())
+			if (!Prerequisite)
+			{
+				continue;
+			}
+
+			/// Prerequisites dispatched by someone else earlier still have to be waited for.
+			if (Prerequisite->Trigger() || (Prerequisite->IsDispatched() && !Prerequisite->IsCompleted()))
 			{
 				if (auto LowLevelTask = Prerequisite->GetAsyncTask())
 				{
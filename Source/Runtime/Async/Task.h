@@ -202,6 +202,21 @@ public:
 		TFTaskFlow.sort(std::forward<Iterator>(Begin), std::forward<Iterator>(End), std::forward<LAMBDA>(Lambda));
 		return DispatchTaskFlow(std::move(TFTaskFlow), Thread, Priority);
 	}
+
+	/// Same as ParallelFor(...)->Wait(), but a worker of the target executor keeps running other tasks until the range is done instead of blocking.
+	template<class Iterator, class LAMBDA>
+	static void CorunParallelFor(Iterator&& Begin, Iterator&& End, LAMBDA&& Lambda, EThread Thread = EThread::WorkerThread, EPriority Priority = EPriority::Normal)
+	{
+		assert(Thread < EThread::Num);
+
+		tf::Taskflow TFTaskFlow;
+		TFTaskFlow.for_each(std::forward<Iterator>(Begin), std::forward<Iterator>(End), std::forward<LAMBDA>(Lambda));
+		CorunTaskFlow(TFTaskFlow, Thread, Priority);
+	}
+
+	/// Runs the flow to completion. Tasks that fan out from a worker (asset loads) must use this rather than waiting on an event,
+	/// a blocked worker cannot run the subtasks it waits for, with enough concurrent loads the pool starves or deadlocks.
+	static void CorunTaskFlow(tf::Taskflow& Flow, EThread Thread = EThread::WorkerThread, EPriority Priority = EPriority::Normal);
 protected:
 	static void InitializeThreadTags();
 
@@ -47,3 +47,105 @@ namespace Utils
 		return StringStream.str();
 	}
 }
+
+static constexpr uint64_t XXHashPrime1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t XXHashPrime2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t XXHashPrime3 = 0x165667B19E3779F9ull;
+static constexpr uint64_t XXHashPrime4 = 0x85EBCA77C2B2AE63ull;
+static constexpr uint64_t XXHashPrime5 = 0x27D4EB2F165667C5ull;
+
+static inline uint64_t XXHashRotateLeft(uint64_t Value, uint32_t Bits)
+{
+	return (Value << Bits) | (Value >> (64u - Bits));
+}
+
+static inline uint64_t XXHashRead64(const uint8_t* Bytes)
+{
+	uint64_t Value;
+	memcpy(&Value, Bytes, sizeof(Value));
+	return Value;
+}
+
+static inline uint32_t XXHashRead32(const uint8_t* Bytes)
+{
+	uint32_t Value;
+	memcpy(&Value, Bytes, sizeof(Value));
+	return Value;
+}
+
+static inline uint64_t XXHashRound(uint64_t Accumulator, uint64_t Input)
+{
+	Accumulator += Input * XXHashPrime2;
+	Accumulator = XXHashRotateLeft(Accumulator, 31u);
+	return Accumulator * XXHashPrime1;
+}
+
+static inline uint64_t XXHashMergeRound(uint64_t Accumulator, uint64_t Value)
+{
+	Accumulator ^= XXHashRound(0u, Value);
+	return Accumulator * XXHashPrime1 + XXHashPrime4;
+}
+
+uint64_t XXHash64(const void* Data, size_t Size, uint64_t Seed)
+{
+	auto Bytes = reinterpret_cast<const uint8_t*>(Data);
+	auto const End = Bytes + Size;
+	uint64_t Hash = 0u;
+
+	if (Size >= 32u)
+	{
+		uint64_t V1 = Seed + XXHashPrime1 + XXHashPrime2;
+		uint64_t V2 = Seed + XXHashPrime2;
+		uint64_t V3 = Seed;
+		uint64_t V4 = Seed - XXHashPrime1;
+
+		auto const Limit = End - 32u;
+		do
+		{
+			V1 = XXHashRound(V1, XXHashRead64(Bytes));
+			V2 = XXHashRound(V2, XXHashRead64(Bytes + 8u));
+			V3 = XXHashRound(V3, XXHashRead64(Bytes + 16u));
+			V4 = XXHashRound(V4, XXHashRead64(Bytes + 24u));
+			Bytes += 32u;
+		} while (Bytes <= Limit);
+
+		Hash = XXHashRotateLeft(V1, 1u) + XXHashRotateLeft(V2, 7u) + XXHashRotateLeft(V3, 12u) + XXHashRotateLeft(V4, 18u);
+		Hash = XXHashMergeRound(Hash, V1);
+		Hash = XXHashMergeRound(Hash, V2);
+		Hash = XXHashMergeRound(Hash, V3);
+		Hash = XXHashMergeRound(Hash, V4);
+	}
+	else
+	{
+		Hash = Seed + XXHashPrime5;
+	}
+
+	Hash += static_cast<uint64_t>(Size);
+
+	for (; Bytes + 8u <= End; Bytes += 8u)
+	{
+		Hash ^= XXHashRound(0u, XXHashRead64(Bytes));
+		Hash = XXHashRotateLeft(Hash, 27u) * XXHashPrime1 + XXHashPrime4;
+	}
+
+	if (Bytes + 4u <= End)
+	{
+		Hash ^= static_cast<uint64_t>(XXHashRead32(Bytes)) * XXHashPrime1;
+		Hash = XXHashRotateLeft(Hash, 23u) * XXHashPrime2 + XXHashPrime3;
+		Bytes += 4u;
+	}
+
+	for (; Bytes < End; ++Bytes)
+	{
+		Hash ^= static_cast<uint64_t>(*Bytes) * XXHashPrime5;
+		Hash = XXHashRotateLeft(Hash, 11u) * XXHashPrime1;
+	}
+
+	Hash ^= Hash >> 33u;
+	Hash *= XXHashPrime2;
+	Hash ^= Hash >> 29u;
+	Hash *= XXHashPrime3;
+	Hash ^= Hash >> 32u;
+
+	return Hash;
+}
@@ -2,15 +2,46 @@
 
 NAMESPACE_START(Math)
 
-AABB AABB::CreateFromVertices(const std::vector<Vector3>& Vertices)
+AABB AABB::CreateFromVertices(const void* Data, size_t Count, size_t Stride)
 {
-	Vector3 Min, Max;
-	for (uint32_t i = 0u; i < Vertices.size(); ++i)
+	if (!Data || Count == 0u)
 	{
-		Min = Math::Min(Min, Vertices[i]);
-		Max = Math::Max(Max, Vertices[i]);
+		return AABB(Vector3(0.0f), Vector3(0.0f));
 	}
 
+	assert(Stride >= sizeof(Float3));
+
+	auto Load = [Data, Stride](size_t Index) {
+		return DirectX::XMLoadFloat3(reinterpret_cast<const Float3*>(reinterpret_cast<const std::byte*>(Data) + Index * Stride));
+	};
+
+	/// Two independent accumulators per bound to hide the latency of min/max.
+	DirectX::XMVECTOR Min0 = Load(0u), Max0 = Min0;
+	DirectX::XMVECTOR Min1 = Min0, Max1 = Min0;
+
+	size_t Index = 1u;
+	for (; Index + 1u < Count; Index += 2u)
+	{
+		const DirectX::XMVECTOR V0 = Load(Index);
+		const DirectX::XMVECTOR V1 = Load(Index + 1u);
+
+		Min0 = DirectX::XMVectorMin(Min0, V0);
+		Max0 = DirectX::XMVectorMax(Max0, V0);
+		Min1 = DirectX::XMVectorMin(Min1, V1);
+		Max1 = DirectX::XMVectorMax(Max1, V1);
+	}
+
+	if (Index < Count)
+	{
+		const DirectX::XMVECTOR V = Load(Index);
+		Min0 = DirectX::XMVectorMin(Min0, V);
+		Max0 = DirectX::XMVectorMax(Max0, V);
+	}
+
+	Vector3 Min, Max;
+	DirectX::XMStoreFloat3(&Min, DirectX::XMVectorMin(Min0, Min1));
+	DirectX::XMStoreFloat3(&Max, DirectX::XMVectorMax(Max0, Max1));
+
 	return AABB(Min, Max);
 }
 
@@ -24,13 +24,28 @@ public:
 	inline Vector3 GetCenter() const { return (m_Max + m_Min) * 0.5f; }
 	inline Vector3 GetExtents() const { return (m_Max - m_Min) * 0.5f; }
 
-	inline static AABB CreateFromVertices(const Vector3* Data, uint32_t Count)
+	inline bool IsValid() const { return m_Min.x <= m_Max.x && m_Min.y <= m_Max.y && m_Min.z <= m_Max.z; }
+
+	inline AABB& Merge(const AABB& Other)
+	{
+		m_Min = Math::Min(m_Min, Other.m_Min);
+		m_Max = Math::Max(m_Max, Other.m_Max);
+		return *this;
+	}
+
+	/// Inverted box, merging anything into it yields that thing.
+	inline static AABB CreateEmpty()
+	{
+		return AABB(Vector3(std::numeric_limits<float>::max()), Vector3(std::numeric_limits<float>::lowest()));
+	}
+
+	/// Reduces the positions in place, Stride is the distance in bytes between two positions so interleaved vertex streams work as well.
+	static AABB CreateFromVertices(const void* Data, size_t Count, size_t Stride = sizeof(Vector3));
+
+	inline static AABB CreateFromVertices(const std::vector<Vector3>& Vertices)
 	{
-		std::vector<Vector3> Vertices(Count);
-		VERIFY(memcpy_s(Vertices.data(), sizeof(Vector3) * Count, Data, sizeof(Vector3) * Count) == 0);
-		return CreateFromVertices(Vertices);
+		return CreateFromVertices(Vertices.data(), Vertices.size());
 	}
-	static AABB CreateFromVertices(const std::vector<Vector3>& Vertices);
 
 	template<class Archive>
 	void serialize(Archive& Ar)
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Core/Math/Vector2.h"
+#include "Core/Math/Vector3.h"
+#include <DirectXPackedVector.h>
+
+NAMESPACE_START(Math)
+
+inline uint16_t FloatToHalf(float Value) { return DirectX::PackedVector::XMConvertFloatToHalf(Value); }
+inline float HalfToFloat(uint16_t Value) { return DirectX::PackedVector::XMConvertHalfToFloat(Value); }
+
+/// Round to nearest, the error is at most half a step: 1 / 65534 for snorm16, 1 / 510 for unorm8.
+inline int16_t QuantizeSNorm16(float Value)
+{
+	return static_cast<int16_t>(std::lround(std::clamp(Value, -1.0f, 1.0f) * 32767.0f));
+}
+
+inline float DequantizeSNorm16(int16_t Value)
+{
+	return std::max(static_cast<float>(Value) / 32767.0f, -1.0f);
+}
+
+inline uint8_t QuantizeUNorm8(float Value)
+{
+	return static_cast<uint8_t>(std::lround(std::clamp(Value, 0.0f, 1.0f) * 255.0f));
+}
+
+inline float DequantizeUNorm8(uint8_t Value)
+{
+	return static_cast<float>(Value) / 255.0f;
+}
+
+/// Octahedral mapping of a unit vector to [-1, 1]^2 (Cigolle et al. 2014, "A Survey of Efficient Representations for Independent Unit Vectors").
+inline Vector2 OctahedralEncode(const Vector3& Direction)
+{
+	const float InvL1Norm = 1.0f / (std::fabs(Direction.x) + std::fabs(Direction.y) + std::fabs(Direction.z));
+	float X = Direction.x * InvL1Norm;
+	float Y = Direction.y * InvL1Norm;
+
+	if (Direction.z < 0.0f)
+	{
+		const float FoldedX = (1.0f - std::fabs(Y)) * (X >= 0.0f ? 1.0f : -1.0f);
+		const float FoldedY = (1.0f - std::fabs(X)) * (Y >= 0.0f ? 1.0f : -1.0f);
+		X = FoldedX;
+		Y = FoldedY;
+	}
+
+	return Vector2(X, Y);
+}
+
+inline Vector3 OctahedralDecode(const Vector2& Encoded)
+{
+	float X = Encoded.x;
+	float Y = Encoded.y;
+	const float Z = 1.0f - std::fabs(X) - std::fabs(Y);
+
+	if (Z < 0.0f)
+	{
+		const float UnfoldedX = (1.0f - std::fabs(Y)) * (X >= 0.0f ? 1.0f : -1.0f);
+		const float UnfoldedY = (1.0f - std::fabs(X)) * (Y >= 0.0f ? 1.0f : -1.0f);
+		X = UnfoldedX;
+		Y = UnfoldedY;
+	}
+
+	const float InvLength = 1.0f / std::sqrt(X * X + Y * Y + Z * Z);
+	return Vector3(X * InvLength, Y * InvLength, Z * InvLength);
+}
+
+NAMESPACE_END(Math)
@@ -0,0 +1,94 @@
+#include "Core/Math/Sphere.h"
+
+NAMESPACE_START(Math)
+
+Sphere Sphere::CreateFromVertices(const void* Data, size_t Count, size_t Stride)
+{
+	if (!Data || Count == 0u)
+	{
+		return Sphere(Vector3(0.0f), 0.0f);
+	}
+
+	assert(Stride >= sizeof(Vector3));
+
+	auto GetVertex = [Data, Stride](size_t Index) -> const Vector3& {
+		return *reinterpret_cast<const Vector3*>(reinterpret_cast<const std::byte*>(Data) + Index * Stride);
+	};
+
+	static const Vector3 Normals[] =
+	{
+		Vector3(1.0f, 0.0f, 0.0f),
+		Vector3(0.0f, 1.0f, 0.0f),
+		Vector3(0.0f, 0.0f, 1.0f),
+		Vector3(1.0f, 1.0f, 1.0f),
+		Vector3(1.0f, 1.0f, -1.0f),
+		Vector3(1.0f, -1.0f, 1.0f),
+		Vector3(1.0f, -1.0f, -1.0f)
+	};
+	static constexpr size_t NumNormals = sizeof(Normals) / sizeof(Normals[0]);
+
+	size_t MinIndex[NumNormals] = {};
+	size_t MaxIndex[NumNormals] = {};
+	float MinProj[NumNormals];
+	float MaxProj[NumNormals];
+	for (size_t NormalIndex = 0u; NormalIndex < NumNormals; ++NormalIndex)
+	{
+		MinProj[NormalIndex] = MaxProj[NormalIndex] = Dot(GetVertex(0u), Normals[NormalIndex]);
+	}
+
+	for (size_t Index = 1u; Index < Count; ++Index)
+	{
+		const Vector3& Vertex = GetVertex(Index);
+		for (size_t NormalIndex = 0u; NormalIndex < NumNormals; ++NormalIndex)
+		{
+			const float Proj = Dot(Vertex, Normals[NormalIndex]);
+			if (Proj < MinProj[NormalIndex])
+			{
+				MinProj[NormalIndex] = Proj;
+				MinIndex[NormalIndex] = Index;
+			}
+			if (Proj > MaxProj[NormalIndex])
+			{
+				MaxProj[NormalIndex] = Proj;
+				MaxIndex[NormalIndex] = Index;
+			}
+		}
+	}
+
+	/// Seed with the most distant extremal pair.
+	Vector3 Center = GetVertex(0u);
+	float RadiusSq = 0.0f;
+	for (size_t NormalIndex = 0u; NormalIndex < NumNormals; ++NormalIndex)
+	{
+		const Vector3& Min = GetVertex(MinIndex[NormalIndex]);
+		const Vector3& Max = GetVertex(MaxIndex[NormalIndex]);
+		const Vector3 Delta = Max - Min;
+		const float DistanceSq = Dot(Delta, Delta) * 0.25f;
+		if (DistanceSq > RadiusSq)
+		{
+			RadiusSq = DistanceSq;
+			Center = (Min + Max) * 0.5f;
+		}
+	}
+
+	/// Ritter, move the sphere towards every outlier just enough to enclose it.
+	float Radius = std::sqrt(RadiusSq);
+	for (size_t Index = 0u; Index < Count; ++Index)
+	{
+		const Vector3& Vertex = GetVertex(Index);
+		const Vector3 Delta = Vertex - Center;
+		const float DistanceSq = Dot(Delta, Delta);
+		if (DistanceSq > RadiusSq)
+		{
+			const float Distance = std::sqrt(DistanceSq);
+			const float NewRadius = (Radius + Distance) * 0.5f;
+			Center = Center + Delta * ((NewRadius - Radius) / Distance);
+			Radius = NewRadius;
+			RadiusSq = Radius * Radius;
+		}
+	}
+
+	return Sphere(Center, Radius);
+}
+
+NAMESPACE_END(Math)
@@ -17,10 +17,20 @@ public:
 
 	const Vector3& GetCenter() const { return m_Center; }
 	float GetRadius() const { return m_Radius; }
+
+	inline bool Contains(const Vector3& Point) const
+	{
+		const Vector3 Delta = Point - m_Center;
+		return Dot(Delta, Delta) <= m_Radius * m_Radius;
+	}
+
+	/// Near optimal enclosing sphere, the initial sphere is seeded from the extremal points along 7 directions (EPOS-14), then grown by a Ritter pass.
+	/// Stride is the distance in bytes between two positions.
+	static Sphere CreateFromVertices(const void* Data, size_t Count, size_t Stride = sizeof(Vector3));
 protected:
 private:
 	Vector3 m_Center;
-	float m_Radius;
+	float m_Radius = 0.0f;
 };
 
 NAMESPACE_END(Math)
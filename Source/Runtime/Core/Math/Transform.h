@@ -54,7 +54,7 @@ public:
 
 	inline Transform& SetTranslationZ(const float Z)
 	{
-		m_Translation.x = Z;
+		m_Translation.z = Z;
 		return *this;
 	}
 
@@ -0,0 +1,639 @@
+#include "Core/Math/TransformSoA.h"
+
+#if defined(__AVX__)
+	#include <immintrin.h>
+#else
+	#include <algorithm>
+	#include <cstring>
+#endif
+
+NAMESPACE_START(Math)
+
+/// 8-wide float, AVX when the compiler targets it, plain loops otherwise so the math below is written once.
+#if defined(__AVX__)
+struct Float8
+{
+	__m256 V;
+
+	static inline Float8 Load(const float* Src) { return Float8{ _mm256_load_ps(Src) }; }
+	static inline Float8 LoadUnaligned(const float* Src) { return Float8{ _mm256_loadu_ps(Src) }; }
+	static inline Float8 Splat(float Value) { return Float8{ _mm256_set1_ps(Value) }; }
+
+	inline void Store(float* Dst) const { _mm256_store_ps(Dst, V); }
+	inline void StoreUnaligned(float* Dst) const { _mm256_storeu_ps(Dst, V); }
+
+	friend inline Float8 operator+(Float8 Left, Float8 Right) { return Float8{ _mm256_add_ps(Left.V, Right.V) }; }
+	friend inline Float8 operator-(Float8 Left, Float8 Right) { return Float8{ _mm256_sub_ps(Left.V, Right.V) }; }
+	friend inline Float8 operator*(Float8 Left, Float8 Right) { return Float8{ _mm256_mul_ps(Left.V, Right.V) }; }
+	friend inline Float8 operator/(Float8 Left, Float8 Right) { return Float8{ _mm256_div_ps(Left.V, Right.V) }; }
+	friend inline Float8 Abs(Float8 Value) { return Float8{ _mm256_andnot_ps(_mm256_set1_ps(-0.0f), Value.V) }; }
+	friend inline Float8 Sqrt(Float8 Value) { return Float8{ _mm256_sqrt_ps(Value.V) }; }
+
+	/// +1 or -1 with the sign bit of Value, -0 gives -1.
+	friend inline Float8 Sign(Float8 Value) { return Float8{ _mm256_or_ps(_mm256_and_ps(_mm256_set1_ps(-0.0f), Value.V), _mm256_set1_ps(1.0f)) }; }
+};
+#else
+struct Float8
+{
+	float V[SoALanes];
+
+	static inline Float8 Load(const float* Src) { Float8 Ret; std::memcpy(Ret.V, Src, sizeof(V)); return Ret; }
+	static inline Float8 LoadUnaligned(const float* Src) { return Load(Src); }
+	static inline Float8 Splat(float Value) { Float8 Ret; std::fill_n(Ret.V, SoALanes, Value); return Ret; }
+
+	inline void Store(float* Dst) const { std::memcpy(Dst, V, sizeof(V)); }
+	inline void StoreUnaligned(float* Dst) const { Store(Dst); }
+
+#define FLOAT8_OPERATOR(Op) \
+	friend inline Float8 operator Op(const Float8& Left, const Float8& Right) \
+	{ \
+		Float8 Ret; \
+		for (uint32_t Lane = 0u; Lane < SoALanes; ++Lane) { Ret.V[Lane] = Left.V[Lane] Op Right.V[Lane]; } \
+		return Ret; \
+	}
+	FLOAT8_OPERATOR(+)
+	FLOAT8_OPERATOR(-)
+	FLOAT8_OPERATOR(*)
+	FLOAT8_OPERATOR(/)
+#undef FLOAT8_OPERATOR
+
+	friend inline Float8 Abs(const Float8& Value)
+	{
+		Float8 Ret;
+		for (uint32_t Lane = 0u; Lane < SoALanes; ++Lane) { Ret.V[Lane] = std::fabs(Value.V[Lane]); }
+		return Ret;
+	}
+
+	friend inline Float8 Sqrt(const Float8& Value)
+	{
+		Float8 Ret;
+		for (uint32_t Lane = 0u; Lane < SoALanes; ++Lane) { Ret.V[Lane] = std::sqrt(Value.V[Lane]); }
+		return Ret;
+	}
+
+	friend inline Float8 Sign(const Float8& Value)
+	{
+		Float8 Ret;
+		for (uint32_t Lane = 0u; Lane < SoALanes; ++Lane) { Ret.V[Lane] = std::copysign(1.0f, Value.V[Lane]); }
+		return Ret;
+	}
+};
+#endif
+
+struct Matrix8
+{
+	Float8 M[4u][3u];
+
+	static inline Matrix8 Load(const MatrixLanes& Lanes)
+	{
+		Matrix8 Ret;
+		for (uint32_t Row = 0u; Row < 4u; ++Row)
+		{
+			for (uint32_t Column = 0u; Column < 3u; ++Column)
+			{
+				Ret.M[Row][Column] = Float8::Load(Lanes.M[Row][Column]);
+			}
+		}
+		return Ret;
+	}
+
+	inline void Store(MatrixLanes& Lanes) const
+	{
+		for (uint32_t Row = 0u; Row < 4u; ++Row)
+		{
+			for (uint32_t Column = 0u; Column < 3u; ++Column)
+			{
+				M[Row][Column].Store(Lanes.M[Row][Column]);
+			}
+		}
+	}
+};
+
+static inline Matrix8 Multiply(const Matrix8& Left, const Matrix8& Right)
+{
+	Matrix8 Ret;
+	for (uint32_t Row = 0u; Row < 4u; ++Row)
+	{
+		for (uint32_t Column = 0u; Column < 3u; ++Column)
+		{
+			Ret.M[Row][Column] =
+				Left.M[Row][0u] * Right.M[0u][Column] +
+				Left.M[Row][1u] * Right.M[1u][Column] +
+				Left.M[Row][2u] * Right.M[2u][Column];
+		}
+	}
+
+	Ret.M[3u][0u] = Ret.M[3u][0u] + Right.M[3u][0u];
+	Ret.M[3u][1u] = Ret.M[3u][1u] + Right.M[3u][1u];
+	Ret.M[3u][2u] = Ret.M[3u][2u] + Right.M[3u][2u];
+
+	return Ret;
+}
+
+/// Rows of the rotation matrix of a unit quaternion, same layout as DirectX::XMMatrixRotationQuaternion.
+static inline void QuaternionToRotation(const TransformLanes& Lanes, Matrix8& Out)
+{
+	const Float8 One = Float8::Splat(1.0f);
+	const Float8 Two = Float8::Splat(2.0f);
+
+	const Float8 X = Float8::Load(Lanes.RotationX);
+	const Float8 Y = Float8::Load(Lanes.RotationY);
+	const Float8 Z = Float8::Load(Lanes.RotationZ);
+	const Float8 W = Float8::Load(Lanes.RotationW);
+
+	const Float8 XX = X * X, YY = Y * Y, ZZ = Z * Z;
+	const Float8 XY = X * Y, XZ = X * Z, YZ = Y * Z;
+	const Float8 WX = W * X, WY = W * Y, WZ = W * Z;
+
+	Out.M[0u][0u] = One - Two * (YY + ZZ);
+	Out.M[0u][1u] = Two * (XY + WZ);
+	Out.M[0u][2u] = Two * (XZ - WY);
+
+	Out.M[1u][0u] = Two * (XY - WZ);
+	Out.M[1u][1u] = One - Two * (XX + ZZ);
+	Out.M[1u][2u] = Two * (YZ + WX);
+
+	Out.M[2u][0u] = Two * (XZ + WY);
+	Out.M[2u][1u] = Two * (YZ - WX);
+	Out.M[2u][2u] = One - Two * (XX + YY);
+
+	const Float8 Zero = Float8::Splat(0.0f);
+	Out.M[3u][0u] = Zero;
+	Out.M[3u][1u] = Zero;
+	Out.M[3u][2u] = Zero;
+}
+
+/// Cofactor rows of the upper 3x3, Cofactor[i] = Cross(Row[i + 1], Row[i + 2]). Row i of the inverse-transpose is Cofactor[i] / Det.
+static inline Float8 Cofactors(const Matrix8& In, Float8 (&Cofactor)[3u][3u])
+{
+	for (uint32_t Index = 0u; Index < 3u; ++Index)
+	{
+		const auto& A = In.M[(Index + 1u) % 3u];
+		const auto& B = In.M[(Index + 2u) % 3u];
+
+		Cofactor[Index][0u] = A[1u] * B[2u] - A[2u] * B[1u];
+		Cofactor[Index][1u] = A[2u] * B[0u] - A[0u] * B[2u];
+		Cofactor[Index][2u] = A[0u] * B[1u] - A[1u] * B[0u];
+	}
+
+	return In.M[0u][0u] * Cofactor[0u][0u] + In.M[0u][1u] * Cofactor[0u][1u] + In.M[0u][2u] * Cofactor[0u][2u];
+}
+
+/// Lerp of translation and scale, normalized lerp of rotation along the shortest arc.
+static inline void Interpolate(const TransformLanes& From, const TransformLanes& To, Float8 TranslationAlpha, Float8 RotationAlpha, Float8 ScaleAlpha, TransformLanes& Out)
+{
+	auto Lerp = [](const float* A, const float* B, Float8 Alpha, float* Dst) {
+		const Float8 Start = Float8::Load(A);
+		(Start + (Float8::Load(B) - Start) * Alpha).Store(Dst);
+	};
+
+	Lerp(From.TranslationX, To.TranslationX, TranslationAlpha, Out.TranslationX);
+	Lerp(From.TranslationY, To.TranslationY, TranslationAlpha, Out.TranslationY);
+	Lerp(From.TranslationZ, To.TranslationZ, TranslationAlpha, Out.TranslationZ);
+
+	Lerp(From.ScaleX, To.ScaleX, ScaleAlpha, Out.ScaleX);
+	Lerp(From.ScaleY, To.ScaleY, ScaleAlpha, Out.ScaleY);
+	Lerp(From.ScaleZ, To.ScaleZ, ScaleAlpha, Out.ScaleZ);
+
+	const Float8 X0 = Float8::Load(From.RotationX), Y0 = Float8::Load(From.RotationY), Z0 = Float8::Load(From.RotationZ), W0 = Float8::Load(From.RotationW);
+	const Float8 Flip = Sign(X0 * Float8::Load(To.RotationX) + Y0 * Float8::Load(To.RotationY) + Z0 * Float8::Load(To.RotationZ) + W0 * Float8::Load(To.RotationW));
+
+	const Float8 X = X0 + (Float8::Load(To.RotationX) * Flip - X0) * RotationAlpha;
+	const Float8 Y = Y0 + (Float8::Load(To.RotationY) * Flip - Y0) * RotationAlpha;
+	const Float8 Z = Z0 + (Float8::Load(To.RotationZ) * Flip - Z0) * RotationAlpha;
+	const Float8 W = W0 + (Float8::Load(To.RotationW) * Flip - W0) * RotationAlpha;
+
+	const Float8 InvLength = Float8::Splat(1.0f) / Sqrt(X * X + Y * Y + Z * Z + W * W);
+	(X * InvLength).Store(Out.RotationX);
+	(Y * InvLength).Store(Out.RotationY);
+	(Z * InvLength).Store(Out.RotationZ);
+	(W * InvLength).Store(Out.RotationW);
+}
+
+void TransformLanes::SetIdentity(uint32_t Lane)
+{
+	assert(Lane < SoALanes);
+
+	TranslationX[Lane] = TranslationY[Lane] = TranslationZ[Lane] = 0.0f;
+	ScaleX[Lane] = ScaleY[Lane] = ScaleZ[Lane] = 1.0f;
+	RotationX[Lane] = RotationY[Lane] = RotationZ[Lane] = 0.0f;
+	RotationW[Lane] = 1.0f;
+}
+
+void MatrixLanes::SetIdentity(uint32_t Lane)
+{
+	assert(Lane < SoALanes);
+
+	for (uint32_t Row = 0u; Row < 4u; ++Row)
+	{
+		for (uint32_t Column = 0u; Column < 3u; ++Column)
+		{
+			M[Row][Column][Lane] = Row == Column ? 1.0f : 0.0f;
+		}
+	}
+}
+
+void TransformSoA::Set(size_t Index, const Transform& InTransform)
+{
+	auto& Block = GetBlock(Index);
+	const size_t Lane = Index % SoALanes;
+
+	const Vector3 Translation = InTransform.GetTranslation();
+	const Vector3 Scalling = InTransform.GetScalling();
+	const Quaternion Rotation = InTransform.GetRotation();
+
+	Block.TranslationX[Lane] = Translation.x;
+	Block.TranslationY[Lane] = Translation.y;
+	Block.TranslationZ[Lane] = Translation.z;
+
+	Block.ScaleX[Lane] = Scalling.x;
+	Block.ScaleY[Lane] = Scalling.y;
+	Block.ScaleZ[Lane] = Scalling.z;
+
+	Block.RotationX[Lane] = Rotation.x;
+	Block.RotationY[Lane] = Rotation.y;
+	Block.RotationZ[Lane] = Rotation.z;
+	Block.RotationW[Lane] = Rotation.w;
+}
+
+Transform TransformSoA::Get(size_t Index) const
+{
+	const auto& Block = GetBlock(Index);
+	const size_t Lane = Index % SoALanes;
+
+	return Transform(
+		Vector3(Block.TranslationX[Lane], Block.TranslationY[Lane], Block.TranslationZ[Lane]),
+		Vector3(Block.ScaleX[Lane], Block.ScaleY[Lane], Block.ScaleZ[Lane]),
+		Quaternion(Block.RotationX[Lane], Block.RotationY[Lane], Block.RotationZ[Lane], Block.RotationW[Lane]));
+}
+
+void MatrixSoA::Set(size_t Index, const Matrix& InMatrix)
+{
+	auto& Block = GetBlock(Index);
+	const size_t Lane = Index % SoALanes;
+
+	for (uint32_t Row = 0u; Row < 4u; ++Row)
+	{
+		for (uint32_t Column = 0u; Column < 3u; ++Column)
+		{
+			Block.M[Row][Column][Lane] = InMatrix.m[Row][Column];
+		}
+	}
+}
+
+Matrix MatrixSoA::Get(size_t Index) const
+{
+	const auto& Block = GetBlock(Index);
+	const size_t Lane = Index % SoALanes;
+
+	return Matrix(
+		Block.M[0u][0u][Lane], Block.M[0u][1u][Lane], Block.M[0u][2u][Lane], 0.0f,
+		Block.M[1u][0u][Lane], Block.M[1u][1u][Lane], Block.M[1u][2u][Lane], 0.0f,
+		Block.M[2u][0u][Lane], Block.M[2u][1u][Lane], Block.M[2u][2u][Lane], 0.0f,
+		Block.M[3u][0u][Lane], Block.M[3u][1u][Lane], Block.M[3u][2u][Lane], 1.0f);
+}
+
+void ComputeMatrices(const TransformSoA& Transforms, MatrixSoA& Out)
+{
+	Out.Resize(Transforms.Size());
+
+	for (size_t BlockIndex = 0u; BlockIndex < Transforms.NumBlocks(); ++BlockIndex)
+	{
+		const auto& Lanes = Transforms.GetBlocks()[BlockIndex];
+
+		Matrix8 Result;
+		QuaternionToRotation(Lanes, Result);
+
+		const Float8 Scale[3u] = { Float8::Load(Lanes.ScaleX), Float8::Load(Lanes.ScaleY), Float8::Load(Lanes.ScaleZ) };
+		for (uint32_t Row = 0u; Row < 3u; ++Row)
+		{
+			Result.M[Row][0u] = Result.M[Row][0u] * Scale[Row];
+			Result.M[Row][1u] = Result.M[Row][1u] * Scale[Row];
+			Result.M[Row][2u] = Result.M[Row][2u] * Scale[Row];
+		}
+
+		Result.M[3u][0u] = Float8::Load(Lanes.TranslationX);
+		Result.M[3u][1u] = Float8::Load(Lanes.TranslationY);
+		Result.M[3u][2u] = Float8::Load(Lanes.TranslationZ);
+
+		Result.Store(Out.GetBlocks()[BlockIndex]);
+	}
+}
+
+void QuaternionToMatrices(const TransformSoA& Transforms, MatrixSoA& Out)
+{
+	Out.Resize(Transforms.Size());
+
+	for (size_t BlockIndex = 0u; BlockIndex < Transforms.NumBlocks(); ++BlockIndex)
+	{
+		Matrix8 Result;
+		QuaternionToRotation(Transforms.GetBlocks()[BlockIndex], Result);
+		Result.Store(Out.GetBlocks()[BlockIndex]);
+	}
+}
+
+void MultiplyMatrices(const MatrixSoA& Left, const MatrixSoA& Right, MatrixSoA& Out)
+{
+	assert(Left.Size() == Right.Size());
+	Out.Resize(Left.Size());
+
+	for (size_t BlockIndex = 0u; BlockIndex < Left.NumBlocks(); ++BlockIndex)
+	{
+		Multiply(Matrix8::Load(Left.GetBlocks()[BlockIndex]), Matrix8::Load(Right.GetBlocks()[BlockIndex])).Store(Out.GetBlocks()[BlockIndex]);
+	}
+}
+
+void ComposeLocalToWorld(const MatrixSoA& Local, const uint32_t* Parents, MatrixSoA& World)
+{
+	assert(Parents && &Local != &World);
+	World.Resize(Local.Size());
+
+	const size_t NumTransforms = Local.Size();
+
+	for (size_t BlockIndex = 0u; BlockIndex < Local.NumBlocks(); ++BlockIndex)
+	{
+		const size_t First = BlockIndex * SoALanes;
+		const size_t Last = std::min<size_t>(First + SoALanes, NumTransforms);
+
+		bool ParentsResolved = true;
+		for (size_t Index = First; Index < Last; ++Index)
+		{
+			assert(Parents[Index] == NONE_INDEX || Parents[Index] < Index);
+			ParentsResolved &= Parents[Index] == NONE_INDEX || Parents[Index] < First;
+		}
+
+		if (ParentsResolved)
+		{
+			MatrixLanes ParentLanes;
+			for (uint32_t Lane = 0u; Lane < SoALanes; ++Lane)
+			{
+				const size_t Index = First + Lane;
+				if (Index >= Last || Parents[Index] == NONE_INDEX)
+				{
+					ParentLanes.SetIdentity(Lane);
+					continue;
+				}
+
+				const auto& ParentBlock = World.GetBlocks()[Parents[Index] / SoALanes];
+				const size_t ParentLane = Parents[Index] % SoALanes;
+				for (uint32_t Row = 0u; Row < 4u; ++Row)
+				{
+					for (uint32_t Column = 0u; Column < 3u; ++Column)
+					{
+						ParentLanes.M[Row][Column][Lane] = ParentBlock.M[Row][Column][ParentLane];
+					}
+				}
+			}
+
+			Multiply(Matrix8::Load(Local.GetBlocks()[BlockIndex]), Matrix8::Load(ParentLanes)).Store(World.GetBlocks()[BlockIndex]);
+		}
+		else
+		{
+			/// Parent and child share a block, resolve the lanes one by one in order.
+			for (size_t Index = First; Index < Last; ++Index)
+			{
+				World.Set(Index, Parents[Index] == NONE_INDEX ? Local.Get(Index) : Local.Get(Index) * World.Get(Parents[Index]));
+			}
+		}
+	}
+}
+
+void InterpolateTransforms(const TransformSoA& From, const TransformSoA& To, const float* TranslationAlphas, const float* RotationAlphas, const float* ScaleAlphas, TransformSoA& Out)
+{
+	assert(From.Size() == To.Size() && TranslationAlphas && RotationAlphas && ScaleAlphas);
+	Out.Resize(From.Size());
+
+	for (size_t BlockIndex = 0u; BlockIndex < From.NumBlocks(); ++BlockIndex)
+	{
+		const size_t First = BlockIndex * SoALanes;
+		Interpolate(From.GetBlocks()[BlockIndex], To.GetBlocks()[BlockIndex],
+			Float8::LoadUnaligned(TranslationAlphas + First), Float8::LoadUnaligned(RotationAlphas + First), Float8::LoadUnaligned(ScaleAlphas + First),
+			Out.GetBlocks()[BlockIndex]);
+	}
+}
+
+void BlendTransforms(const TransformSoA& From, const TransformSoA& To, float Weight, TransformSoA& Out)
+{
+	assert(From.Size() == To.Size());
+	Out.Resize(From.Size());
+
+	const Float8 Alpha = Float8::Splat(Weight);
+	for (size_t BlockIndex = 0u; BlockIndex < From.NumBlocks(); ++BlockIndex)
+	{
+		Interpolate(From.GetBlocks()[BlockIndex], To.GetBlocks()[BlockIndex], Alpha, Alpha, Alpha, Out.GetBlocks()[BlockIndex]);
+	}
+}
+
+void AddTransforms(const TransformSoA& Base, const TransformSoA& Additive, float Weight, TransformSoA& Out)
+{
+	assert(Base.Size() == Additive.Size());
+	Out.Resize(Base.Size());
+
+	/// Identity lanes, the additive pose is faded in from them.
+	TransformLanes Identity;
+	for (uint32_t Lane = 0u; Lane < SoALanes; ++Lane)
+	{
+		Identity.SetIdentity(Lane);
+	}
+
+	const Float8 Alpha = Float8::Splat(Weight);
+	for (size_t BlockIndex = 0u; BlockIndex < Base.NumBlocks(); ++BlockIndex)
+	{
+		const auto& BaseLanes = Base.GetBlocks()[BlockIndex];
+		auto& OutLanes = Out.GetBlocks()[BlockIndex];
+
+		TransformLanes Delta;
+		Interpolate(Identity, Additive.GetBlocks()[BlockIndex], Alpha, Alpha, Alpha, Delta);
+
+		(Float8::Load(BaseLanes.TranslationX) + Float8::Load(Delta.TranslationX)).Store(OutLanes.TranslationX);
+		(Float8::Load(BaseLanes.TranslationY) + Float8::Load(Delta.TranslationY)).Store(OutLanes.TranslationY);
+		(Float8::Load(BaseLanes.TranslationZ) + Float8::Load(Delta.TranslationZ)).Store(OutLanes.TranslationZ);
+
+		(Float8::Load(BaseLanes.ScaleX) * Float8::Load(Delta.ScaleX)).Store(OutLanes.ScaleX);
+		(Float8::Load(BaseLanes.ScaleY) * Float8::Load(Delta.ScaleY)).Store(OutLanes.ScaleY);
+		(Float8::Load(BaseLanes.ScaleZ) * Float8::Load(Delta.ScaleZ)).Store(OutLanes.ScaleZ);
+
+		/// Hamilton product Base * Delta, i.e. XMQuaternionMultiply(Delta, Base): the delta rotates first, in the bone's local frame.
+		const Float8 PX = Float8::Load(BaseLanes.RotationX), PY = Float8::Load(BaseLanes.RotationY), PZ = Float8::Load(BaseLanes.RotationZ), PW = Float8::Load(BaseLanes.RotationW);
+		const Float8 QX = Float8::Load(Delta.RotationX), QY = Float8::Load(Delta.RotationY), QZ = Float8::Load(Delta.RotationZ), QW = Float8::Load(Delta.RotationW);
+
+		(PW * QX + PX * QW + PY * QZ - PZ * QY).Store(OutLanes.RotationX);
+		(PW * QY - PX * QZ + PY * QW + PZ * QX).Store(OutLanes.RotationY);
+		(PW * QZ + PX * QY - PY * QX + PZ * QW).Store(OutLanes.RotationZ);
+		(PW * QW - PX * QX - PY * QY - PZ * QZ).Store(OutLanes.RotationW);
+	}
+}
+
+void InverseMatrices(const MatrixSoA& Matrices, MatrixSoA& Out)
+{
+	Out.Resize(Matrices.Size());
+
+	for (size_t BlockIndex = 0u; BlockIndex < Matrices.NumBlocks(); ++BlockIndex)
+	{
+		const Matrix8 In = Matrix8::Load(Matrices.GetBlocks()[BlockIndex]);
+
+		Float8 Cofactor[3u][3u];
+		const Float8 InvDet = Float8::Splat(1.0f) / Cofactors(In, Cofactor);
+
+		/// Inverse of the upper 3x3 is the transposed cofactor matrix over the determinant.
+		Matrix8 Result;
+		for (uint32_t Row = 0u; Row < 3u; ++Row)
+		{
+			for (uint32_t Column = 0u; Column < 3u; ++Column)
+			{
+				Result.M[Row][Column] = Cofactor[Column][Row] * InvDet;
+			}
+		}
+
+		/// Translation = -T * Inverse(Upper3x3)
+		for (uint32_t Column = 0u; Column < 3u; ++Column)
+		{
+			Result.M[3u][Column] = Float8::Splat(0.0f) - (
+				In.M[3u][0u] * Result.M[0u][Column] +
+				In.M[3u][1u] * Result.M[1u][Column] +
+				In.M[3u][2u] * Result.M[2u][Column]);
+		}
+
+		Result.Store(Out.GetBlocks()[BlockIndex]);
+	}
+}
+
+void InverseTransposeMatrices(const MatrixSoA& Matrices, MatrixSoA& Out)
+{
+	Out.Resize(Matrices.Size());
+
+	for (size_t BlockIndex = 0u; BlockIndex < Matrices.NumBlocks(); ++BlockIndex)
+	{
+		const Matrix8 In = Matrix8::Load(Matrices.GetBlocks()[BlockIndex]);
+
+		Float8 Cofactor[3u][3u];
+		const Float8 InvDet = Float8::Splat(1.0f) / Cofactors(In, Cofactor);
+
+		Matrix8 Result;
+		for (uint32_t Row = 0u; Row < 3u; ++Row)
+		{
+			for (uint32_t Column = 0u; Column < 3u; ++Column)
+			{
+				Result.M[Row][Column] = Cofactor[Row][Column] * InvDet;
+			}
+		}
+
+		const Float8 Zero = Float8::Splat(0.0f);
+		Result.M[3u][0u] = Zero;
+		Result.M[3u][1u] = Zero;
+		Result.M[3u][2u] = Zero;
+
+		Result.Store(Out.GetBlocks()[BlockIndex]);
+	}
+}
+
+void TransformAABBs(const MatrixSoA& Matrices, const AABB* Bounds, AABB* Out)
+{
+	assert(Bounds && Out);
+
+	const size_t NumTransforms = Matrices.Size();
+
+	for (size_t BlockIndex = 0u; BlockIndex < Matrices.NumBlocks(); ++BlockIndex)
+	{
+		const size_t First = BlockIndex * SoALanes;
+		const size_t Last = std::min<size_t>(First + SoALanes, NumTransforms);
+
+		alignas(32) float Center[3u][SoALanes] = {};
+		alignas(32) float Extents[3u][SoALanes] = {};
+		for (size_t Index = First; Index < Last; ++Index)
+		{
+			const Vector3 BoxCenter = Bounds[Index].GetCenter();
+			const Vector3 BoxExtents = Bounds[Index].GetExtents();
+			const size_t Lane = Index - First;
+
+			Center[0u][Lane] = BoxCenter.x; Center[1u][Lane] = BoxCenter.y; Center[2u][Lane] = BoxCenter.z;
+			Extents[0u][Lane] = BoxExtents.x; Extents[1u][Lane] = BoxExtents.y; Extents[2u][Lane] = BoxExtents.z;
+		}
+
+		const Matrix8 M = Matrix8::Load(Matrices.GetBlocks()[BlockIndex]);
+		const Float8 C[3u] = { Float8::Load(Center[0u]), Float8::Load(Center[1u]), Float8::Load(Center[2u]) };
+		const Float8 E[3u] = { Float8::Load(Extents[0u]), Float8::Load(Extents[1u]), Float8::Load(Extents[2u]) };
+
+		for (uint32_t Column = 0u; Column < 3u; ++Column)
+		{
+			const Float8 NewCenter = C[0u] * M.M[0u][Column] + C[1u] * M.M[1u][Column] + C[2u] * M.M[2u][Column] + M.M[3u][Column];
+			const Float8 NewExtents = E[0u] * Abs(M.M[0u][Column]) + E[1u] * Abs(M.M[1u][Column]) + E[2u] * Abs(M.M[2u][Column]);
+
+			NewCenter.Store(Center[Column]);
+			NewExtents.Store(Extents[Column]);
+		}
+
+		for (size_t Index = First; Index < Last; ++Index)
+		{
+			const size_t Lane = Index - First;
+			const Vector3 BoxCenter(Center[0u][Lane], Center[1u][Lane], Center[2u][Lane]);
+			const Vector3 BoxExtents(Extents[0u][Lane], Extents[1u][Lane], Extents[2u][Lane]);
+			Out[Index] = AABB(BoxCenter - BoxExtents, BoxCenter + BoxExtents);
+		}
+	}
+}
+
+void TransformPoints(const Matrix& InMatrix, const Vector3* Points, Vector3* Out, size_t Count)
+{
+	assert(Points && Out);
+
+	/// Affine only, no perspective divide, the loop is simple enough to be auto vectorized.
+	for (size_t Index = 0u; Index < Count; ++Index)
+	{
+		const Vector3 Point = Points[Index];
+		Out[Index] = Vector3(
+			Point.x * InMatrix._11 + Point.y * InMatrix._21 + Point.z * InMatrix._31 + InMatrix._41,
+			Point.x * InMatrix._12 + Point.y * InMatrix._22 + Point.z * InMatrix._32 + InMatrix._42,
+			Point.x * InMatrix._13 + Point.y * InMatrix._23 + Point.z * InMatrix._33 + InMatrix._43);
+	}
+}
+
+void TransformVectors(const Matrix& InMatrix, const Vector3* Vectors, Vector3* Out, size_t Count)
+{
+	assert(Vectors && Out);
+
+	for (size_t Index = 0u; Index < Count; ++Index)
+	{
+		const Vector3 Vector = Vectors[Index];
+		Out[Index] = Vector3(
+			Vector.x * InMatrix._11 + Vector.y * InMatrix._21 + Vector.z * InMatrix._31,
+			Vector.x * InMatrix._12 + Vector.y * InMatrix._22 + Vector.z * InMatrix._32,
+			Vector.x * InMatrix._13 + Vector.y * InMatrix._23 + Vector.z * InMatrix._33);
+	}
+}
+
+void TransformPoints(const Matrix& InMatrix, const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutZ, size_t Count)
+{
+	assert(X && Y && Z && OutX && OutY && OutZ);
+
+	Float8 M[4u][3u];
+	for (uint32_t Row = 0u; Row < 4u; ++Row)
+	{
+		for (uint32_t Column = 0u; Column < 3u; ++Column)
+		{
+			M[Row][Column] = Float8::Splat(InMatrix.m[Row][Column]);
+		}
+	}
+
+	size_t Index = 0u;
+	for (; Index + SoALanes <= Count; Index += SoALanes)
+	{
+		const Float8 PX = Float8::LoadUnaligned(X + Index);
+		const Float8 PY = Float8::LoadUnaligned(Y + Index);
+		const Float8 PZ = Float8::LoadUnaligned(Z + Index);
+
+		(PX * M[0u][0u] + PY * M[1u][0u] + PZ * M[2u][0u] + M[3u][0u]).StoreUnaligned(OutX + Index);
+		(PX * M[0u][1u] + PY * M[1u][1u] + PZ * M[2u][1u] + M[3u][1u]).StoreUnaligned(OutY + Index);
+		(PX * M[0u][2u] + PY * M[1u][2u] + PZ * M[2u][2u] + M[3u][2u]).StoreUnaligned(OutZ + Index);
+	}
+
+	for (; Index < Count; ++Index)
+	{
+		const float PX = X[Index], PY = Y[Index], PZ = Z[Index];
+		OutX[Index] = PX * InMatrix._11 + PY * InMatrix._21 + PZ * InMatrix._31 + InMatrix._41;
+		OutY[Index] = PX * InMatrix._12 + PY * InMatrix._22 + PZ * InMatrix._32 + InMatrix._42;
+		OutZ[Index] = PX * InMatrix._13 + PY * InMatrix._23 + PZ * InMatrix._33 + InMatrix._43;
+	}
+}
+
+NAMESPACE_END(Math)
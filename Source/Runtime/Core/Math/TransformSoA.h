@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Core/Math/Math.h"
+
+NAMESPACE_START(Math)
+
+/// Batched transform math in AoSoA layout, every block packs 8 transforms lane by lane so one AVX register holds the same component of 8 transforms.
+/// Padding lanes of the last block are kept as identity, so every batch function is free to process whole blocks.
+static constexpr uint32_t SoALanes = 8u;
+
+struct alignas(32) TransformLanes
+{
+	float TranslationX[SoALanes];
+	float TranslationY[SoALanes];
+	float TranslationZ[SoALanes];
+
+	float ScaleX[SoALanes];
+	float ScaleY[SoALanes];
+	float ScaleZ[SoALanes];
+
+	float RotationX[SoALanes];
+	float RotationY[SoALanes];
+	float RotationZ[SoALanes];
+	float RotationW[SoALanes];
+
+	void SetIdentity(uint32_t Lane);
+};
+
+/// Affine 4x3 matrices (row vector convention, same as Math::Matrix), the last column is implicitly (0, 0, 0, 1).
+struct alignas(32) MatrixLanes
+{
+	float M[4u][3u][SoALanes];
+
+	void SetIdentity(uint32_t Lane);
+};
+
+template<class Lanes>
+class SoAContainer
+{
+public:
+	SoAContainer() = default;
+
+	SoAContainer(size_t Count)
+	{
+		Resize(Count);
+	}
+
+	void Resize(size_t Count)
+	{
+		const size_t NumBlocks = DivideAndRoundUp<size_t>(Count, SoALanes);
+
+		m_Blocks.resize(NumBlocks);
+
+		for (size_t Index = std::min(m_Count, Count); Index < NumBlocks * SoALanes; ++Index)
+		{
+			m_Blocks[Index / SoALanes].SetIdentity(static_cast<uint32_t>(Index % SoALanes));
+		}
+
+		m_Count = Count;
+	}
+
+	inline size_t Size() const { return m_Count; }
+	inline size_t NumBlocks() const { return m_Blocks.size(); }
+
+	inline Lanes* GetBlocks() { return m_Blocks.data(); }
+	inline const Lanes* GetBlocks() const { return m_Blocks.data(); }
+protected:
+	inline Lanes& GetBlock(size_t Index) { assert(Index < m_Count); return m_Blocks[Index / SoALanes]; }
+	inline const Lanes& GetBlock(size_t Index) const { assert(Index < m_Count); return m_Blocks[Index / SoALanes]; }
+private:
+	std::vector<Lanes> m_Blocks;
+	size_t m_Count = 0u;
+};
+
+class TransformSoA : public SoAContainer<TransformLanes>
+{
+public:
+	using SoAContainer::SoAContainer;
+
+	void Set(size_t Index, const Transform& InTransform);
+	Transform Get(size_t Index) const;
+};
+
+class MatrixSoA : public SoAContainer<MatrixLanes>
+{
+public:
+	using SoAContainer::SoAContainer;
+
+	void Set(size_t Index, const Matrix& InMatrix);
+	Matrix Get(size_t Index) const;
+};
+
+/// Out[i] = Scaling(S[i]) * Rotation(Q[i]) * Translation(T[i]), matches Transform::GetMatrix.
+void ComputeMatrices(const TransformSoA& Transforms, MatrixSoA& Out);
+
+/// Rotation part only, translation is left zero.
+void QuaternionToMatrices(const TransformSoA& Transforms, MatrixSoA& Out);
+
+/// Out[i] = Left[i] * Right[i].
+void MultiplyMatrices(const MatrixSoA& Left, const MatrixSoA& Right, MatrixSoA& Out);
+
+/// World[i] = Local[i] * World[Parents[i]], NONE_INDEX marks a root. Parents must be stored before their children,
+/// blocks whose parents all live in previous blocks (breadth first order) take the vectorized path.
+void ComposeLocalToWorld(const MatrixSoA& Local, const uint32_t* Parents, MatrixSoA& World);
+
+/// Per transform lerp of translation and scale, shortest arc normalized lerp of rotation. The alpha arrays hold NumBlocks() * SoALanes entries,
+/// so every channel of every transform has its own factor.
+void InterpolateTransforms(const TransformSoA& From, const TransformSoA& To, const float* TranslationAlphas, const float* RotationAlphas, const float* ScaleAlphas, TransformSoA& Out);
+
+/// Same with one factor for everything, Weight 0 gives From. Out may alias either input, here and in AddTransforms.
+void BlendTransforms(const TransformSoA& From, const TransformSoA& To, float Weight, TransformSoA& Out);
+
+/// Out = Base with Additive applied on top, faded in from identity by Weight: translations add, scales and rotations multiply (the delta rotates first).
+void AddTransforms(const TransformSoA& Base, const TransformSoA& Additive, float Weight, TransformSoA& Out);
+
+/// Affine inverse.
+void InverseMatrices(const MatrixSoA& Matrices, MatrixSoA& Out);
+
+/// Normal matrices, translation is dropped, matches Matrix::InverseTranspose.
+void InverseTransposeMatrices(const MatrixSoA& Matrices, MatrixSoA& Out);
+
+/// Out[i] = Bounds[i] transformed by Matrices[i], the result encloses the transformed box (Arvo).
+void TransformAABBs(const MatrixSoA& Matrices, const AABB* Bounds, AABB* Out);
+
+/// Transforms an array of points/vectors by one matrix. Points take the translation, vectors don't.
+void TransformPoints(const Matrix& InMatrix, const Vector3* Points, Vector3* Out, size_t Count);
+void TransformVectors(const Matrix& InMatrix, const Vector3* Vectors, Vector3* Out, size_t Count);
+
+/// Same as above for split component streams (X/Y/Z arrays), 8 points per iteration.
+void TransformPoints(const Matrix& InMatrix, const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutZ, size_t Count);
+
+NAMESPACE_END(Math)
@@ -34,25 +34,36 @@ const std::filesystem::path& Paths::ShaderPath()
 	return Path;
 }
 
-const std::filesystem::path& Paths::ShaderBinaryPath()
+const std::filesystem::path& Paths::MaterialPath()
+{
+	static std::filesystem::path Path;
+	if (Path.empty())
+	{
+		Path = AssetPath() / "Materials";
+	}
+	
+	return Path;
+}
+
+const std::filesystem::path& Paths::CookedAssetPath()
 {
 	static std::filesystem::path Path;
 	if (Path.empty())
 	{
-		Path = ShaderPath() / "ShaderBinary";
+		Path = AssetPath() / "Cooked";
 	}
 
 	return Path;
 }
 
-const std::filesystem::path& Paths::MaterialPath()
+const std::filesystem::path& Paths::DerivedDataPath()
 {
 	static std::filesystem::path Path;
 	if (Path.empty())
 	{
-		Path = AssetPath() / "Materials";
+		Path = CookedAssetPath() / "DerivedData";
 	}
-	
+
 	return Path;
 }
 
@@ -121,3 +132,14 @@ const std::filesystem::path& Paths::EditorThemePath()
 
 	return Path;
 }
+
+const std::filesystem::path& Paths::SavedPath()
+{
+	static std::filesystem::path Path;
+	if (Path.empty())
+	{
+		Path = RootPath() / "Saved";
+	}
+
+	return Path;
+}
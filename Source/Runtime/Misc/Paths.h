@@ -8,12 +8,14 @@ public:
 	static const std::filesystem::path& RootPath();
 	static const std::filesystem::path& AssetPath();
 	static const std::filesystem::path& ShaderPath();
-	static const std::filesystem::path& ShaderBinaryPath();
 	static const std::filesystem::path& MaterialPath();
+	static const std::filesystem::path& CookedAssetPath();
+	static const std::filesystem::path& DerivedDataPath();
 	static const std::filesystem::path& AudioPath();
 	static const std::filesystem::path& ScenePath();
 	static const std::filesystem::path& GltfSampleModelPath();
 	static const std::filesystem::path& ConfigPath();
 	static const std::filesystem::path& FontPath();
 	static const std::filesystem::path& EditorThemePath();
+	static const std::filesystem::path& SavedPath();
 };
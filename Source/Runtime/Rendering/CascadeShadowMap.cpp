@@ -0,0 +1,176 @@
+#include "Rendering/CascadeShadowMap.h"
+#include "Core/Math/TransformSoA.h"
+#include "Scene/SceneView.h"
+#include "Scene/Components/Camera.h"
+#include "Scene/Components/PrimitiveComponent.h"
+#include "Async/Task.h"
+
+void CascadeShadowMap::ComputeSplitDistances(ECascadeSplitScheme Scheme, float Lambda, float NearPlane, float FarPlane, uint32_t NumCascades, float* OutDistances)
+{
+	assert(OutDistances && NumCascades > 0u && NearPlane > 0.0f && FarPlane > NearPlane);
+
+	switch (Scheme)
+	{
+	case ECascadeSplitScheme::Uniform:
+		Lambda = 0.0f;
+		break;
+	case ECascadeSplitScheme::Logarithmic:
+		Lambda = 1.0f;
+		break;
+	case ECascadeSplitScheme::Practical:
+		Lambda = Math::Clamp(Lambda, 0.0f, 1.0f);
+		break;
+	}
+
+	const float Ratio = FarPlane / NearPlane;
+	for (uint32_t Index = 0u; Index <= NumCascades; ++Index)
+	{
+		const float Fraction = static_cast<float>(Index) / static_cast<float>(NumCascades);
+		const float Log = NearPlane * std::pow(Ratio, Fraction);
+		const float Uniform = NearPlane + (FarPlane - NearPlane) * Fraction;
+		OutDistances[Index] = Lambda * Log + (1.0f - Lambda) * Uniform;
+	}
+
+	OutDistances[0u] = NearPlane;
+	OutDistances[NumCascades] = FarPlane;
+}
+
+void CascadeShadowMap::Update(const SceneView& View, const Math::Vector3& LightDirection, const Math::AABB& SceneBounds, const RenderSettings::ShadowSettings& Settings)
+{
+	const Camera* ViewCamera = View.GetCamera();
+	assert(ViewCamera && Settings.NumCascades > 0u && Settings.ShadowMapSize > 0u);
+
+	/// The light view is anchored at the world origin and only depends on the light direction, so snapping in light space is stable across frames.
+	const Math::Vector3 Direction = Math::Normalize(LightDirection);
+	const Math::Vector3 Up = std::fabs(Direction.y) > 0.99f ? Math::Vector3(1.0f, 0.0f, 0.0f) : Math::Vector3(0.0f, 1.0f, 0.0f);
+	m_LightView = Math::Matrix::LookAtLH(Math::Vector3(0.0f), Direction, Up);
+
+	float SceneMinZ = std::numeric_limits<float>::max();
+	if (SceneBounds.IsValid())
+	{
+		const Math::Vector3 Min = SceneBounds.GetMin();
+		const Math::Vector3 Max = SceneBounds.GetMax();
+		const Math::Vector3 Corners[8u] =
+		{
+			Math::Vector3(Min.x, Min.y, Min.z), Math::Vector3(Max.x, Min.y, Min.z),
+			Math::Vector3(Min.x, Max.y, Min.z), Math::Vector3(Max.x, Max.y, Min.z),
+			Math::Vector3(Min.x, Min.y, Max.z), Math::Vector3(Max.x, Min.y, Max.z),
+			Math::Vector3(Min.x, Max.y, Max.z), Math::Vector3(Max.x, Max.y, Max.z)
+		};
+
+		Math::Vector3 LightSpaceCorners[8u];
+		Math::TransformPoints(m_LightView, Corners, LightSpaceCorners, 8u);
+		for (const auto& Corner : LightSpaceCorners)
+		{
+			SceneMinZ = std::min(SceneMinZ, Corner.z);
+		}
+	}
+
+	const float NearPlane = ViewCamera->GetNearPlane();
+	const float FarPlane = std::min(ViewCamera->GetFarPlane(), Settings.MaxShadowDistance);
+
+	std::vector<float> Splits(Settings.NumCascades + 1u);
+	ComputeSplitDistances(Settings.CascadeSplitScheme, Settings.SplitLambda, NearPlane, std::max(FarPlane, NearPlane + Math::Epsilon), Settings.NumCascades, Splits.data());
+
+	const float TanHalfFovY = std::tan(ViewCamera->GetFov() * 0.5f);
+	const float TanHalfFovX = TanHalfFovY * ViewCamera->GetAspect();
+
+	m_Cascades.resize(Settings.NumCascades);
+	for (uint32_t Index = 0u; Index < Settings.NumCascades; ++Index)
+	{
+		auto& Cascade = m_Cascades[Index];
+		Cascade.SplitNear = Splits[Index];
+		Cascade.SplitFar = Splits[Index + 1u];
+
+		Math::Vector3 Corners[8u];
+		for (uint32_t Plane = 0u; Plane < 2u; ++Plane)
+		{
+			const float Depth = Plane == 0u ? Cascade.SplitNear : Cascade.SplitFar;
+			const float X = Depth * TanHalfFovX;
+			const float Y = Depth * TanHalfFovY;
+
+			Corners[Plane * 4u + 0u] = Math::Vector3(-X, -Y, Depth);
+			Corners[Plane * 4u + 1u] = Math::Vector3(X, -Y, Depth);
+			Corners[Plane * 4u + 2u] = Math::Vector3(-X, Y, Depth);
+			Corners[Plane * 4u + 3u] = Math::Vector3(X, Y, Depth);
+		}
+		Math::TransformPoints(ViewCamera->GetInverseViewMatrix(), Corners, Corners, 8u);
+
+		/// The centroid of a symmetric frustum slice lies on the view axis, so the radius is invariant to camera rotation.
+		Math::Vector3 Center(0.0f);
+		for (const auto& Corner : Corners)
+		{
+			Center = Center + Corner * 0.125f;
+		}
+
+		float Radius = 0.0f;
+		for (const auto& Corner : Corners)
+		{
+			const Math::Vector3 Delta = Corner - Center;
+			Radius = std::max(Radius, Math::Dot(Delta, Delta));
+		}
+		Radius = std::ceil(std::sqrt(Radius) * 16.0f) / 16.0f;
+
+		Cascade.Bounds = Math::Sphere(Center, Radius);
+		Cascade.TexelSize = Radius * 2.0f / static_cast<float>(Settings.ShadowMapSize);
+
+		/// Snap the projection center to whole texels so static geometry always rasterizes to the same texels.
+		Math::Vector3 LightSpaceCenter;
+		Math::TransformPoints(m_LightView, &Center, &LightSpaceCenter, 1u);
+		LightSpaceCenter.x = std::floor(LightSpaceCenter.x / Cascade.TexelSize) * Cascade.TexelSize;
+		LightSpaceCenter.y = std::floor(LightSpaceCenter.y / Cascade.TexelSize) * Cascade.TexelSize;
+
+		Cascade.LightSpaceMin = Math::Vector3(LightSpaceCenter.x - Radius, LightSpaceCenter.y - Radius, std::min(LightSpaceCenter.z - Radius, SceneMinZ));
+		Cascade.LightSpaceMax = Math::Vector3(LightSpaceCenter.x + Radius, LightSpaceCenter.y + Radius, LightSpaceCenter.z + Radius);
+
+		Cascade.Projection = Math::Matrix::OrthographicOffCenterLH(
+			Cascade.LightSpaceMin.x, Cascade.LightSpaceMax.x,
+			Cascade.LightSpaceMin.y, Cascade.LightSpaceMax.y,
+			Cascade.LightSpaceMin.z, Cascade.LightSpaceMax.z);
+		Cascade.ViewProjection = m_LightView * Cascade.Projection;
+	}
+}
+
+bool CascadeShadowMap::IsCasterVisible(const ShadowCascade& Cascade, const Math::Vector3& LightSpaceCenter, float Radius)
+{
+	return LightSpaceCenter.x + Radius >= Cascade.LightSpaceMin.x && LightSpaceCenter.x - Radius <= Cascade.LightSpaceMax.x &&
+		LightSpaceCenter.y + Radius >= Cascade.LightSpaceMin.y && LightSpaceCenter.y - Radius <= Cascade.LightSpaceMax.y &&
+		LightSpaceCenter.z - Radius <= Cascade.LightSpaceMax.z;
+}
+
+void CascadeShadowMap::CullCasters(const std::vector<const PrimitiveComponent*>& Primitives)
+{
+	std::vector<const PrimitiveComponent*> Candidates;
+	std::vector<Math::Vector3> Centers;
+	std::vector<float> Radii;
+
+	Candidates.reserve(Primitives.size());
+	Centers.reserve(Primitives.size());
+	Radii.reserve(Primitives.size());
+
+	for (auto Primitive : Primitives)
+	{
+		if (Primitive && Primitive->IsCastShadow())
+		{
+			/// World space, not the mesh space bounds the primitive was built with.
+			const Math::Sphere Bounds = Primitive->GetBounds().GetSphere();
+			Candidates.push_back(Primitive);
+			Centers.push_back(Bounds.GetCenter());
+			Radii.push_back(Bounds.GetRadius());
+		}
+	}
+
+	/// The light view is shared by all cascades, move the centers into light space once.
+	Math::TransformPoints(m_LightView, Centers.data(), Centers.data(), Centers.size());
+
+	TFTask::ParallelFor(m_Cascades.begin(), m_Cascades.end(), [&Candidates, &Centers, &Radii](ShadowCascade& Cascade) {
+		Cascade.Casters.clear();
+		for (size_t Index = 0u; Index < Candidates.size(); ++Index)
+		{
+			if (IsCasterVisible(Cascade, Centers[Index], Radii[Index]))
+			{
+				Cascade.Casters.push_back(Candidates[Index]);
+			}
+		}
+	})->Wait();
+}
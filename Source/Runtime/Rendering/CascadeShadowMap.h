@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Core/Math/Math.h"
+#include "Rendering/RenderSettings.h"
+
+struct ShadowCascade
+{
+	/// View space depth range of the camera sub-frustum this cascade covers.
+	float SplitNear = 0.0f;
+	float SplitFar = 0.0f;
+
+	/// World space size of one shadow map texel.
+	float TexelSize = 0.0f;
+
+	/// World space bounding sphere of the sub-frustum, its radius only depends on the split so the projection does not swim as the camera rotates.
+	Math::Sphere Bounds;
+
+	/// Light view space box the orthographic projection was built from. Casters are extruded towards the light, so only MaxZ bounds them in depth.
+	Math::Vector3 LightSpaceMin;
+	Math::Vector3 LightSpaceMax;
+
+	Math::Matrix Projection;
+	Math::Matrix ViewProjection;
+
+	std::vector<const class PrimitiveComponent*> Casters;
+};
+
+class CascadeShadowMap
+{
+public:
+	/// Writes NumCascades + 1 view space distances, OutDistances[0] = NearPlane and OutDistances[NumCascades] = FarPlane.
+	static void ComputeSplitDistances(ECascadeSplitScheme Scheme, float Lambda, float NearPlane, float FarPlane, uint32_t NumCascades, float* OutDistances);
+
+	/// Fits one stable, texel snapped orthographic projection per cascade to the camera sub-frusta of the view.
+	/// SceneBounds pulls the near plane of every cascade back so casters between the light and the cascade are not clipped.
+	void Update(const class SceneView& View, const Math::Vector3& LightDirection, const Math::AABB& SceneBounds, const RenderSettings::ShadowSettings& Settings);
+
+	/// Fills ShadowCascade::Casters by the world space bounds of the primitives, every cascade is culled on its own worker.
+	void CullCasters(const std::vector<const class PrimitiveComponent*>& Primitives);
+
+	/// Sphere vs light space box test with the box extruded towards the light.
+	static bool IsCasterVisible(const ShadowCascade& Cascade, const Math::Vector3& LightSpaceCenter, float Radius);
+
+	inline const Math::Matrix& GetLightViewMatrix() const { return m_LightView; }
+	inline const std::vector<ShadowCascade>& GetCascades() const { return m_Cascades; }
+private:
+	Math::Matrix m_LightView;
+	std::vector<ShadowCascade> m_Cascades;
+};
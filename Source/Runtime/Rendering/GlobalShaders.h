@@ -19,6 +19,8 @@ public:
 		SHADER_DEFINE(bool, _HAS_UV0_, HasUV0)
 		SHADER_DEFINE(bool, _HAS_UV1_, HasUV1)
 		SHADER_DEFINE(bool, _HAS_COLOR_, HasColor)
+		SHADER_DEFINE(bool, _QUANTIZED_POSITION_, QuantizedPosition)
+		SHADER_DEFINE(bool, _OCTAHEDRAL_DIRECTION_, OctahedralDirection)
 	END_SHADER_DEFINES
 };
 
@@ -0,0 +1,40 @@
+#include "Asset/Material.h"
+#include "Services/AssetDatabase.h"
+
+/// Decides the color space and compressed format the texture is imported with.
+static ETextureUsage GetTextureUsage(MaterialProperty::ETextureType Type)
+{
+	switch (Type)
+	{
+	case MaterialProperty::ETextureType::Normal:
+		return ETextureUsage::Normal;
+	case MaterialProperty::ETextureType::Height:
+	case MaterialProperty::ETextureType::Shininess:
+	case MaterialProperty::ETextureType::Opacity:
+	case MaterialProperty::ETextureType::Displacement:
+	case MaterialProperty::ETextureType::AmbientOcclusion:
+		return ETextureUsage::Mask;
+	case MaterialProperty::ETextureType::Metalness:
+	case MaterialProperty::ETextureType::DiffuseRoughness:
+		return ETextureUsage::Linear;
+	default:
+		return ETextureUsage::Color;
+	}
+}
+
+void MaterialProperty::SetTexture(ETextureType Type, const std::filesystem::path& Path)
+{
+	assert(Type < ETextureType::Num);
+
+	TexturePaths[Type] = Path;
+
+	/// Shared textures are deduplicated by the asset database.
+	AssetDatabase::Get().AddDependency(GetPath(), Path);
+
+	AssetLoadRequest Request;
+	Request.Path = Path.string();
+	Request.Settings = static_cast<uint32_t>(GetTextureUsage(Type));
+	AssetDatabase::Get().RequestLoad(Request);
+
+	Textures[Type] = Request.Target ? Cast<Texture>(Request.Target) : nullptr;
+}
@@ -93,6 +93,13 @@ struct MaterialProperty : public Serializable<MaterialProperty>
 
 	Array<std::shared_ptr<Texture>, ETextureType> Textures;
 
+	/// Files the textures were requested from, empty for types without a texture. Not saved with the material, cooked scenes keep them.
+	Array<std::filesystem::path, ETextureType> TexturePaths;
+
+	/// Requests the texture and records the material -> texture dependency, so a changed texture reloads the material's dependents.
+	/// Every path a material is resolved on goes through here, import, existing material files and cooked scenes alike.
+	void SetTexture(ETextureType Type, const std::filesystem::path& Path);
+
 	template<class Archive>
 	void serialize(Archive& Ar)
 	{
@@ -3,6 +3,15 @@
 #include "Core/Math/Color.h"
 #include "RHI/RHIShader.h"
 #include "RHI/RHIPipeline.h"
+#include "RHI/RHITexture.h"
+
+enum class ERHIDeviceQueue : uint8_t
+{
+	Graphics,
+	Transfer,
+	Compute,
+	Num
+};
 
 enum class ERHICommandBufferLevel : uint8_t
 {
@@ -10,6 +19,37 @@ enum class ERHICommandBufferLevel : uint8_t
 	Secondary
 };
 
+enum class ERHITransitionFlags : uint8_t
+{
+	None,
+	/// First half of a split barrier, the resource may still be in use by earlier commands until the matching EndOnly half.
+	/// Backends without split barriers ignore it and issue the full barrier with the EndOnly half. Between queues, the BeginOnly half
+	/// releases the resource on the source queue and the EndOnly half acquires it on the destination queue, both are needed.
+	BeginOnly = 1 << 0,
+	EndOnly = 1 << 1,
+	/// The previous content is not needed, e.g. on the first use of memory another resource used before.
+	Discard = 1 << 2
+};
+ENUM_FLAG_OPERATORS(ERHITransitionFlags)
+
+/// A state change of a texture, or of a range of its subresources, or of a buffer. States may combine several read states.
+struct RHITransition
+{
+	const RHITexture* Texture = nullptr;
+	const RHIBuffer* Buffer = nullptr;
+
+	RHISubresource Subresource;
+
+	ERHIResourceState SrcState = ERHIResourceState::Unknown;
+	ERHIResourceState DstState = ERHIResourceState::Unknown;
+
+	ERHITransitionFlags Flags = ERHITransitionFlags::None;
+
+	/// Differ when the resource moves to another queue.
+	ERHIDeviceQueue SrcQueue = ERHIDeviceQueue::Graphics;
+	ERHIDeviceQueue DstQueue = ERHIDeviceQueue::Graphics;
+};
+
 class RHICommandBuffer
 {
 public:
@@ -65,6 +105,28 @@ public:
 	virtual void WriteTexture(const RHITexture* Texture, const RHIBuffer* StagingBuffer, size_t Size, uint32_t ArrayLayer, uint32_t MipLevel, size_t SrcOffset = 0u) = 0;
 	virtual void WriteTexture(const RHITexture* Texture, const RHIBuffer* StagingBuffer, size_t Size, size_t SrcOffset = 0u) = 0;
 
+	/// Issues all transitions as a single barrier.
+	virtual void Transition(const RHITransition* Transitions, uint32_t NumTransitions) = 0;
+
+	/// Records ended secondary command buffers into this primary one, in order. They are free for reuse once the submission of this one
+	/// completed, see RHICommandBufferPool.
+	void ExecuteCommands(RHICommandBuffer* const* CommandBuffers, uint32_t NumCommandBuffers)
+	{
+		assert(m_Level == ERHICommandBufferLevel::Primary && IsRecording() && CommandBuffers && NumCommandBuffers);
+
+		for (uint32_t Index = 0u; Index < NumCommandBuffers; ++Index)
+		{
+			auto CommandBuffer = CommandBuffers[Index];
+			assert(CommandBuffer->GetLevel() == ERHICommandBufferLevel::Secondary && CommandBuffer->IsEnded());
+
+			CommandBuffer->m_Primary = this;
+			CommandBuffer->m_PrimaryFenceSignaledCounter = GetFenceSignaledCounter();
+			CommandBuffer->SetStatus(EStatus::Submitted);
+		}
+
+		ExecuteSecondaryCommands(CommandBuffers, NumCommandBuffers);
+	}
+
 	virtual void SetViewport(const RHIViewport& Viewport) = 0;
 	virtual void SetViewports(const RHIViewport* Viewports, uint32_t NumViewports) = 0;
 
@@ -81,18 +143,68 @@ public:
 	inline uint64_t GetFenceSignaledCounter() const { return m_FenceSignaledCounter.load(std::memory_order_relaxed); }
 protected:
 	friend class RHICommandListContext;
+	friend class RHICommandBufferPool;
 
 	inline void SetStatus(EStatus State) { m_Status = State; }
 	virtual void RefreshStatus() = 0;
 
+	virtual void ExecuteSecondaryCommands(RHICommandBuffer* const* CommandBuffers, uint32_t NumCommandBuffers) = 0;
+
+	/// Secondary command buffers have no fence, the one they were executed in signaled its own once more when they are done.
+	inline bool IsPrimarySubmissionCompleted() const
+	{
+		return m_Primary && m_Primary->GetFenceSignaledCounter() > m_PrimaryFenceSignaledCounter;
+	}
+
 	EStatus m_Status = EStatus::Initial;
 	std::atomic<uint64_t> m_FenceSignaledCounter = 0u;
 private:
 	ERHICommandBufferLevel m_Level;
+
+	const RHICommandBuffer* m_Primary = nullptr;
+	uint64_t m_PrimaryFenceSignaledCounter = 0u;
 };
 
+/// Command buffers of a single recording thread, see RHICommandListContext::GetThreadCommandBufferPool. Only the owning thread ever
+/// touches a pool, so acquiring takes no lock.
 class RHICommandBufferPool
 {
+public:
+	virtual ~RHICommandBufferPool() = default;
+
+	/// A command buffer in recording state: a free one of the pool, reset if needed, or a new one.
+	RHICommandBuffer* Acquire(ERHICommandBufferLevel Level)
+	{
+		for (auto& CommandBuffer : m_CommandBuffers)
+		{
+			if (CommandBuffer->GetLevel() != Level)
+			{
+				continue;
+			}
+
+			CommandBuffer->RefreshStatus();
+
+			if (CommandBuffer->IsNeedReset())
+			{
+				CommandBuffer->Reset();
+			}
+
+			if (CommandBuffer->IsReady())
+			{
+				CommandBuffer->Begin();
+				return CommandBuffer.get();
+			}
+		}
+
+		auto CommandBuffer = m_CommandBuffers.emplace_back(AllocateCommandBuffer(Level)).get();
+		assert(CommandBuffer);
+		CommandBuffer->Begin();
+		return CommandBuffer;
+	}
+protected:
+	virtual RHICommandBufferPtr AllocateCommandBuffer(ERHICommandBufferLevel Level) = 0;
+private:
+	std::vector<RHICommandBufferPtr> m_CommandBuffers;
 };
 
 class RHICommandList
@@ -8,6 +8,16 @@ public:
 	virtual void SubmitGraphicsCommandBuffer() = 0;
 	virtual void SubmitUploadCommandBuffer(RHICommandBuffer* UploadCommandBuffer = nullptr) = 0;
 
+	/// Every context has a timeline its queue advances, values only ever grow. The highest value signaled so far.
+	virtual uint64_t GetTimelineValue() const = 0;
+
+	/// Submits the graphics command buffer, its commands signal Value on the timeline of this context once complete.
+	virtual void SignalTimeline(uint64_t Value) = 0;
+
+	/// Submits the commands recorded into the graphics command buffer so far, those recorded from now on wait for the timeline of
+	/// Other to reach Value before they execute.
+	virtual void WaitTimeline(RHICommandListContext& Other, uint64_t Value) = 0;
+
 	RHICommandBuffer* GetGraphicsCommandBuffer(ERHICommandBufferLevel Level = ERHICommandBufferLevel::Primary)
 	{
 		auto& CommandBufferList = Level == ERHICommandBufferLevel::Primary ? m_PrimaryCommandBufferList : m_SecondaryCommandBufferList;
@@ -58,6 +68,38 @@ public:
 		CommandBuffer->Begin();
 		return CommandBuffer;
 	}
+
+	/// Polls the fences of the submitted primary command buffers, uploads included, so their fence signaled counters are current.
+	void RefreshUploadCommandBuffers()
+	{
+		std::lock_guard Locker(m_PrimaryCommandBufferList.Lock);
+
+		for (auto& CommandBuffer : m_PrimaryCommandBufferList)
+		{
+			CommandBuffer->RefreshStatus();
+		}
+	}
+
+	/// The pool of the calling thread for this context, created on the first call from a thread. Later calls find it in a thread local
+	/// cache without locking, which is what parallel recording on task workers needs. The pools live as long as the context.
+	RHICommandBufferPool& GetThreadCommandBufferPool()
+	{
+		thread_local std::vector<std::pair<uint64_t, RHICommandBufferPool*>> t_ThreadPools;
+
+		for (auto& [ContextID, Pool] : t_ThreadPools)
+		{
+			if (ContextID == m_ID)
+			{
+				return *Pool;
+			}
+		}
+
+		std::lock_guard Locker(m_ThreadPoolsLock);
+		auto Pool = m_ThreadPools.emplace_back(CreateCommandBufferPool()).get();
+		assert(Pool);
+		t_ThreadPools.emplace_back(m_ID, Pool);
+		return *Pool;
+	}
 protected:
 	RHICommandBuffer* GetCommandBuffer(ERHICommandBufferLevel Level)
 	{
@@ -94,6 +136,9 @@ protected:
 
 	virtual RHICommandBufferPtr AllocateCommandBuffer(ERHICommandBufferLevel Level) = 0;
 
+	/// Command buffers of the pool must be executable in the primary command buffers of this context.
+	virtual RHICommandBufferPoolPtr CreateCommandBufferPool() = 0;
+
 	struct RHICommandBufferList : public std::vector<RHICommandBufferPtr>
 	{
 		std::mutex Lock;
@@ -103,4 +148,11 @@ protected:
 
 	RHICommandBufferList m_PrimaryCommandBufferList;
 	RHICommandBufferList m_SecondaryCommandBufferList;
+private:
+	/// Never reused, so the thread local caches can not mistake a pool of a destroyed context for one of a new context.
+	static inline std::atomic<uint64_t> s_NextID = 0u;
+	const uint64_t m_ID = s_NextID.fetch_add(1u, std::memory_order_relaxed);
+
+	std::mutex m_ThreadPoolsLock;
+	std::vector<RHICommandBufferPoolPtr> m_ThreadPools;
 };
\ No newline at end of file
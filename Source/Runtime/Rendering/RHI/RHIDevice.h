@@ -12,14 +12,6 @@
 /// ****  Depth range [0-1]
 /// </summary>
 
-enum class ERHIDeviceQueue : uint8_t
-{
-	Graphics,
-	Transfer,
-	Compute,
-	Num
-};
-
 struct RHIDeviceCapabilities
 {
 	uint32_t MaxTextureDimension1D = 0u;
@@ -46,6 +38,12 @@ struct RHIDeviceCapabilities
 
 	bool SupportsAsyncCompute = false;
 	bool SupportsTransferQueue = false;
+
+	/// Queues wait for and signal counted values, without it cross queue waits within a frame can not be expressed.
+	bool SupportsTimelineSemaphore = false;
+
+	/// Command buffers execute the BeginOnly half of a transition on the same queue, without it the graph issues whole barriers only.
+	bool SupportsSplitBarriers = false;
 };
 
 class RHIDevice
@@ -177,6 +177,7 @@ namespace RHI
 		{
 		case ERHIFormat::BC1_UNorm:   return ERHIFormat::BC1_UNorm_SRGB;
 		case ERHIFormat::BC2_UNorm:   return ERHIFormat::BC2_UNorm_SRGB;
+		case ERHIFormat::BC3_UNorm:   return ERHIFormat::BC3_UNorm_SRGB;
 		case ERHIFormat::BGRA8_UNorm: return ERHIFormat::BGRA8_UNorm_SRGB;
 		case ERHIFormat::BGRX8_UNorm: return ERHIFormat::BGRX8_UNorm_SRGB;
 		case ERHIFormat::BC7_UNorm:   return ERHIFormat::BC7_UNorm_SRGB;
@@ -257,8 +258,8 @@ namespace RHI
 			}
 			Attributes.RowPitch = BlockWidth * Attributes.BytesPerPixel;
 			Attributes.SlicePitch = Attributes.RowPitch * BlockHeight;
-			Attributes.NumRows = BlockWidth;
-			Attributes.NumCols = BlockHeight;
+			Attributes.NumRows = BlockHeight;
+			Attributes.NumCols = BlockWidth;
 		}
 		else if (IsPacked)
 		{
@@ -65,6 +65,10 @@ struct RHITextureDesc
 
 	std::shared_ptr<DataBlock> BulkData;
 
+	/// Offset of every subresource from the start of the bulk data, indexed by ArrayLayer * NumMipLevel + MipLevel.
+	/// Empty means the subresources are packed layer by layer, mip 0 first within each layer, as in DDS files.
+	std::vector<size_t> SubresourceOffsets;
+
 	FName Name;
 
 	inline RHITextureDesc& SetWidth(uint32_t Value) { Width = Value; return *this; }
@@ -80,7 +84,8 @@ struct RHITextureDesc
 	inline RHITextureDesc& SetLinear(bool Linear) { IsLinear = Linear; return *this; }
 	inline RHITextureDesc& SetBulkData(std::shared_ptr<DataBlock>& Data) { BulkData = Data; return *this; }
 	inline RHITextureDesc& SetBulkData(std::shared_ptr<DataBlock>&& Data) { BulkData = std::move(Data); return *this; }
-	inline RHITextureDesc& SetBulkData(size_t Size, const void* RawData = nullptr, size_t Offset = 0u) { BulkData = std::make_shared<DataBlock>(Size, RawData, Offset); return *this; }
+	inline RHITextureDesc& SetBulkData(size_t Size, const void* RawData = nullptr) { BulkData = std::make_shared<DataBlock>(Size, RawData); return *this; }
+	inline RHITextureDesc& SetSubresourceOffsets(std::vector<size_t>&& Offsets) { SubresourceOffsets = std::move(Offsets); return *this; }
 	inline RHITextureDesc& SetName(FName&& InName) { Name = std::move(InName); return *this; }
 
 	static RHITextureDesc Create1D(uint32_t Width, ERHIFormat Format, ERHIBufferUsageFlags Flags, uint16_t NumMipLevel = 1u, ERHISampleCount NumSamples = ERHISampleCount::Sample_1_Bit)
@@ -115,32 +115,63 @@ void RHIUploadManager::QueueSubmitUploadCommandBuffer(RHICommandBuffer* UploadCo
 	}
 }
 
-void RHIUploadManager::QueueUploadTexture(const RHITexture* Texture, const void* Data, size_t Size, size_t SrcOffset)
+/// Bytes of one subresource, every depth slice of the mip included.
+static size_t GetSubresourceSize(const RHITexture* Texture, uint32_t MipLevel)
 {
+	const uint32_t MipWidth = std::max(Texture->GetWidth() >> MipLevel, 1u);
+	const uint32_t MipHeight = std::max(Texture->GetHeight() >> MipLevel, 1u);
+	const uint32_t MipDepth = std::max(Texture->GetDepth() >> MipLevel, 1u);
+
+	return RHI::GetFormatAttributes(MipWidth, MipHeight, Texture->GetFormat()).SlicePitch * MipDepth;
+}
+
+RHIUploadTicket RHIUploadManager::QueueUploadTexture(const RHITexture* Texture, const void* Data, size_t Size, size_t SrcOffset)
+{
+	std::vector<size_t> SubresourceOffsets;
+	SubresourceOffsets.reserve(Texture->GetNumArrayLayer() * Texture->GetNumMipLevel());
+
+	size_t Offset = SrcOffset;
+	for (uint32_t ArrayLayer = 0u; ArrayLayer < Texture->GetNumArrayLayer(); ++ArrayLayer)
+	{
+		for (uint32_t MipLevel = 0u; MipLevel < Texture->GetNumMipLevel(); ++MipLevel)
+		{
+			SubresourceOffsets.push_back(Offset);
+			Offset += GetSubresourceSize(Texture, MipLevel);
+		}
+	}
+	assert(Offset - SrcOffset <= Size);
+
+	return QueueUploadTexture(Texture, Data, SubresourceOffsets);
+}
+
+RHIUploadTicket RHIUploadManager::QueueUploadTexture(const RHITexture* Texture, const void* Data, const std::vector<size_t>& SubresourceOffsets)
+{
+	const uint32_t NumMipLevel = Texture->GetNumMipLevel();
+	assert(SubresourceOffsets.size() == static_cast<size_t>(Texture->GetNumArrayLayer()) * NumMipLevel);
+
+	size_t Size = 0u;
+	for (uint32_t MipLevel = 0u; MipLevel < NumMipLevel; ++MipLevel)
+	{
+		Size += GetSubresourceSize(Texture, MipLevel);
+	}
+	Size *= Texture->GetNumArrayLayer();
+
 	auto CommandBuffer = GetUploadCommandBuffer();
 	auto StagingBuffer = AcquireStagingBuffer(CommandBuffer, Size, GetDefaultAlignment());
 
 	auto Mapped = reinterpret_cast<uint8_t*>(StagingBuffer.Buffer->Map(ERHIMapMode::WriteOnly, Size, StagingBuffer.Offset));
 
+	/// The staging copy is packed in the order WriteTexture expects, one copy per subresource whatever the source layout is.
 	for (uint32_t ArrayLayer = 0u; ArrayLayer < Texture->GetNumArrayLayer(); ++ArrayLayer)
 	{
-		for (uint32_t MipLevel = 0u; MipLevel < Texture->GetNumMipLevel(); ++MipLevel)
+		for (uint32_t MipLevel = 0u; MipLevel < NumMipLevel; ++MipLevel)
 		{
-			uint32_t MipWidth = std::max(Texture->GetWidth() >> MipLevel, 1u);
-			uint32_t MipHeight = std::max(Texture->GetHeight() >> MipLevel, 1u);
-			uint32_t MipDepth = std::max(Texture->GetDepth() >> MipLevel, 1u);
-			auto FormatAttributes = RHI::GetFormatAttributes(MipWidth, MipHeight, Texture->GetFormat());
+			const size_t SubresourceSize = GetSubresourceSize(Texture, MipLevel);
+			const uint8_t* Source = reinterpret_cast<const uint8_t*>(Data) + SubresourceOffsets[ArrayLayer * NumMipLevel + MipLevel];
 
-			for (uint32_t Depth = 0u; Depth < MipDepth; ++Depth)
-			{
-				const uint8_t* Source = reinterpret_cast<const uint8_t*>(Data) + SrcOffset + FormatAttributes.SlicePitch * Depth;
-				const size_t RowSize = FormatAttributes.RowPitch * FormatAttributes.NumRows;
-
-				VERIFY(memcpy_s(Mapped, RowSize, Source, RowSize) == 0);
+			VERIFY(memcpy_s(Mapped, SubresourceSize, Source, SubresourceSize) == 0);
 
-				Mapped += RowSize;
-				Source += RowSize;
-			}
+			Mapped += SubresourceSize;
 		}
 	}
 
@@ -148,11 +179,15 @@ void RHIUploadManager::QueueUploadTexture(const RHITexture* Texture, const void*
 
 	CommandBuffer->WriteTexture(Texture, StagingBuffer.Buffer, Size, StagingBuffer.Offset);
 
+	auto Ticket = MakeUploadTicket(CommandBuffer, StagingBuffer.Version);
+
 	QueueSubmitUploadCommandBuffer(CommandBuffer);
 	QueueReleaseStagingBuffer(StagingBuffer);
+
+	return Ticket;
 }
 
-void RHIUploadManager::QueueUploadTexture(const RHITexture* Texture, uint32_t ArrayLayer, uint32_t MipLevel, const void* Data, size_t Size, size_t SrcOffset)
+RHIUploadTicket RHIUploadManager::QueueUploadTexture(const RHITexture* Texture, uint32_t ArrayLayer, uint32_t MipLevel, const void* Data, size_t Size, size_t SrcOffset)
 {
 	auto CommandBuffer = GetUploadCommandBuffer();
 	auto StagingBuffer = AcquireStagingBuffer(CommandBuffer, Size, GetDefaultAlignment());
@@ -181,8 +216,12 @@ void RHIUploadManager::QueueUploadTexture(const RHITexture* Texture, uint32_t Ar
 
 	CommandBuffer->WriteTexture(Texture, StagingBuffer.Buffer, Size, ArrayLayer, MipLevel, StagingBuffer.Offset);
 
+	auto Ticket = MakeUploadTicket(CommandBuffer, StagingBuffer.Version);
+
 	QueueSubmitUploadCommandBuffer(CommandBuffer);
 	QueueReleaseStagingBuffer(StagingBuffer);
+
+	return Ticket;
 }
 
 RHICommandBuffer* RHIUploadManager::GetUploadCommandBuffer()
@@ -208,9 +247,55 @@ RHICommandBuffer* RHIUploadManager::GetUploadCommandBuffer()
 	}
 }
 
+RHIUploadTicket RHIUploadManager::MakeUploadTicket(RHICommandBuffer* CommandBuffer, uint64_t Version) const
+{
+	const bool OnTransferQueue = m_Device.GetCapabilities().SupportsTransferQueue;
+	auto Context = OnTransferQueue ? m_Device.GetImmediateCommandListContext(ERHIDeviceQueue::Transfer) : t_CommandListContext.get();
+
+	return RHIUploadTicket{ Context, CommandBuffer, Version, OnTransferQueue };
+}
+
+bool RHIUploadManager::IsUploadComplete(const RHIUploadTicket& Ticket) const
+{
+	if (!Ticket.IsValid())
+	{
+		return true;
+	}
+
+	/// Nobody else may poll the upload command buffers for a while, the counter only advances when someone does.
+	if (Ticket.CommandBuffer->GetFenceSignaledCounter() <= Ticket.Version)
+	{
+		Ticket.Context->RefreshUploadCommandBuffers();
+	}
+
+	return Ticket.CommandBuffer->GetFenceSignaledCounter() > Ticket.Version;
+}
+
+void RHIUploadManager::AcquireUploadedTexture(const RHIUploadTicket& Ticket, const RHITexture* Texture)
+{
+	assert(Texture && IsUploadComplete(Ticket));
+
+	if (!Ticket.OnTransferQueue)
+	{
+		return;
+	}
+
+	/// Same state on both sides, only the ownership moves. The release half went with the copy, the host saw its fence signal,
+	/// so the acquire submitted from now on is ordered after it.
+	RHITransition Acquire;
+	Acquire.Texture = Texture;
+	Acquire.SrcState = Acquire.DstState = Texture->GetState();
+	Acquire.SrcQueue = ERHIDeviceQueue::Transfer;
+	Acquire.DstQueue = ERHIDeviceQueue::Graphics;
+
+	m_Device.GetImmediateCommandListContext(ERHIDeviceQueue::Graphics)->GetGraphicsCommandBuffer()->Transition(&Acquire, 1u);
+}
+
 void RHIUploadManager::FlushPendingFreeStagingBuffers()
 {
-	for (auto It = m_PendingFreeStagingBufferList.begin(); It != m_PendingFreeStagingBufferList.end(); ++It)
+	std::lock_guard PendingFreeLocker(m_PendingFreeLock);
+
+	for (auto It = m_PendingFreeStagingBufferList.begin(); It != m_PendingFreeStagingBufferList.end();)
 	{
 		if (It->CommandBuffer->GetFenceSignaledCounter() > It->Version)
 		{
@@ -221,11 +306,11 @@ void RHIUploadManager::FlushPendingFreeStagingBuffers()
 					m_StagingBlockList.emplace_back(std::move(*(It->Owner)));
 				}
 
-				{
-					std::lock_guard Locker(m_PendingFreeLock);
-					It = m_PendingFreeStagingBufferList.erase(It);
-				}
+				It = m_PendingFreeStagingBufferList.erase(It);
+				continue;
 			}
 		}
+
+		++It;
 	}
 }
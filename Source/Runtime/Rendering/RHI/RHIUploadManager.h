@@ -3,6 +3,19 @@
 #include "Core/Singleton.h"
 #include "RHI/RHIBuffer.h"
 
+/// A queued upload. The copy is done on the GPU once the fence of its command buffer signaled past Version.
+struct RHIUploadTicket
+{
+	class RHICommandListContext* Context = nullptr;
+	RHICommandBuffer* CommandBuffer = nullptr;
+	uint64_t Version = 0u;
+
+	/// Copied on the transfer queue, which keeps ownership until the graphics queue acquires the resource.
+	bool OnTransferQueue = false;
+
+	inline bool IsValid() const { return CommandBuffer != nullptr; }
+};
+
 class RHIUploadManager : public LazySingleton<RHIUploadManager>
 {
 public:
@@ -10,8 +23,19 @@ public:
 	inline size_t GetUsedMemorySize() const { return m_UsedMemorySize.load(); }
 
 	void QueueUploadBuffer(const RHIBuffer* Buffer, const void* Data, size_t Size, size_t SrcOffset = 0u);
-	void QueueUploadTexture(const RHITexture* Texture, const void* Data, size_t Size, size_t SrcOffset = 0u);
-	void QueueUploadTexture(const RHITexture* Texture, uint32_t ArrayLayer, uint32_t MipLevel, const void* Data, size_t Size, size_t SrcOffset = 0u);
+	/// Data holds every subresource packed layer by layer, mip 0 first within each layer.
+	RHIUploadTicket QueueUploadTexture(const RHITexture* Texture, const void* Data, size_t Size, size_t SrcOffset = 0u);
+
+	/// Every subresource read from Data at its offset, see RHITextureDesc::SubresourceOffsets.
+	RHIUploadTicket QueueUploadTexture(const RHITexture* Texture, const void* Data, const std::vector<size_t>& SubresourceOffsets);
+	RHIUploadTicket QueueUploadTexture(const RHITexture* Texture, uint32_t ArrayLayer, uint32_t MipLevel, const void* Data, size_t Size, size_t SrcOffset = 0u);
+
+	/// Polls the fence of the upload, true once the GPU finished the copy.
+	bool IsUploadComplete(const RHIUploadTicket& Ticket) const;
+
+	/// Records the queue ownership acquire of a completed texture upload into the graphics command buffer, nothing if it was not copied on
+	/// the transfer queue. The texture must not be used on the graphics queue before.
+	void AcquireUploadedTexture(const RHIUploadTicket& Ticket, const RHITexture* Texture);
 
 	void FlushPendingFreeStagingBuffers();
 protected:
@@ -56,6 +80,7 @@ private:
 	}
 
 	RHICommandBuffer* GetUploadCommandBuffer();
+	RHIUploadTicket MakeUploadTicket(RHICommandBuffer* CommandBuffer, uint64_t Version) const;
 	StagingBuffer AcquireStagingBuffer(RHICommandBuffer* CommandBuffer, size_t Size, size_t Alignment);
 	void QueueReleaseStagingBuffer(StagingBuffer& Buffer);
 	void QueueSubmitUploadCommandBuffer(RHICommandBuffer* UploadCommandBuffer);
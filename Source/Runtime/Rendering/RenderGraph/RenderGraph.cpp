@@ -1,27 +1,1532 @@
 #include "Rendering/RenderGraph/RenderGraph.h"
-#include "Rendering/RenderGraph/ResourceManager.h"
+#include "Rendering/RenderGraph/RenderTargetPool.h"
+#include "Rendering/RenderGraph/RenderGraphExporter.h"
+#include "Core/ConsoleVariable.h"
+#include "Profile/CpuTimer.h"
+#include "Async/Task.h"
+#include "RHI/RHIDevice.h"
+#include "RHI/RHICommandListContext.h"
+#include "Rendering/RenderSettings.h"
+#include "Misc/Paths.h"
 #include "Scene/Scene.h"
 #include "Scene/SceneView.h"
+#include "Services/SpdLogService.h"
 
-RDGRenderGraph::RDGRenderGraph(const RenderSettings& Settings)
+DEFINE_LOG_CATEGORY(LogRenderGraph);
+
+ConsoleVariable<bool> CVarRDGCompileCache(
+	"rdg.compile_cache",
+	"Reuse the compiled plan of the previous frame while the render graph keeps its shape.",
+	true);
+
+ConsoleVariable<bool> CVarRDGAsyncCompute(
+	"rdg.async_compute",
+	"Run async compute passes of the render graph on the compute queue when the device has one.",
+	true);
+
+ConsoleVariable<bool> CVarRDGExport(
+	"rdg.export",
+	"Write the next executed render graph, or the declarations of one failing to compile, to Saved/RenderGraph as Graphviz DOT and JSON, the variable turns itself off again.",
+	false);
+
+ConsoleVariable<uint32_t> CVarRDGParallelMinPassesPerJob(
+	"rdg.parallel_min_passes_per_job",
+	"Fewest passes recorded into one command buffer when the render graph records passes in parallel.",
+	2u);
+
+ConsoleVariable<uint32_t> CVarRDGParallelMinWorkItemsPerJob(
+	"rdg.parallel_min_work_items_per_job",
+	"Fewest work items of a parallel pass recorded into one command buffer, passes with less than twice as many are not split.",
+	64u);
+
+static bool IsReadOnlyState(ERHIResourceState State)
+{
+	const auto WriteStates = ERHIResourceState::RenderTarget | ERHIResourceState::UnorderedAccess | ERHIResourceState::DepthWrite |
+		ERHIResourceState::StreamOut | ERHIResourceState::TransferDst | ERHIResourceState::ResolveDst | ERHIResourceState::AccelerationStructure;
+
+	return State != ERHIResourceState::Unknown && State != ERHIResourceState::Common && !EnumHasAnyFlags(State, WriteStates);
+}
+
+/// What imported and extracted resources are in outside the graph.
+static ERHIResourceState GetExternalState(const RDGResource& Resource)
+{
+	if (Resource.GetType() == RDGResource::EType::Texture)
+	{
+		if (Resource.IsImported() && Resource.GetRHI())
+		{
+			return static_cast<const RHITexture*>(Resource.GetRHI())->GetState();
+		}
+
+		return static_cast<const RDGTexture&>(Resource).GetDesc().PermanentState;
+	}
+
+	return static_cast<const RDGBuffer&>(Resource).GetDesc().PermanentStates;
+}
+
+RDGRenderGraph::RDGRenderGraph(const RenderSettings& Settings, RDGRenderTargetPool& Pool)
 	: m_Settings(Settings)
+	, m_Pool(Pool)
+{
+}
+
+void RDGRenderGraph::AddPassDependency(const RDGRenderPass& Producer, const RDGRenderPass& Consumer)
+{
+	assert(Producer.GetID() != Consumer.GetID());
+	m_PassDependencies.emplace_back(Producer.GetID(), Consumer.GetID());
+}
+
+void RDGRenderGraph::Execute(RHICommandListContext& Context, RHICommandListContext* AsyncComputeContext)
+{
+	/// The schedule synchronizes the queues with timeline values, binary semaphores would drop them.
+	const bool AsyncCompute = AsyncComputeContext && AsyncComputeContext != &Context &&
+		m_Pool.GetDevice().GetCapabilities().SupportsTimelineSemaphore;
+	if (!Compile(AsyncCompute))
+	{
+		/// The declarations are what went wrong, cycles and reads before writes show in them.
+		ExportIfRequested();
+		return;
+	}
+
+	AllocateResources();
+
+	auto GetContext = [&](ERHIDeviceQueue Queue) -> RHICommandListContext& {
+		return Queue == ERHIDeviceQueue::Compute ? *AsyncComputeContext : Context;
+	};
+
+	/// The schedule counts timeline values from the start of the frame.
+	const uint64_t GraphicsTimelineBase = Context.GetTimelineValue();
+	const uint64_t ComputeTimelineBase = AsyncCompute ? AsyncComputeContext->GetTimelineValue() : 0u;
+
+	auto Wait = [&](const RDGPassSchedule& Schedule) {
+		if (Schedule.WaitValue)
+		{
+			const bool OnCompute = Schedule.Queue == ERHIDeviceQueue::Compute;
+			GetContext(Schedule.Queue).WaitTimeline(OnCompute ? Context : *AsyncComputeContext,
+				(OnCompute ? GraphicsTimelineBase : ComputeTimelineBase) + Schedule.WaitValue);
+		}
+	};
+
+	auto Signal = [&](const RDGPassSchedule& Schedule) {
+		if (Schedule.SignalValue)
+		{
+			GetContext(Schedule.Queue).SignalTimeline(
+				(Schedule.Queue == ERHIDeviceQueue::Compute ? ComputeTimelineBase : GraphicsTimelineBase) + Schedule.SignalValue);
+		}
+	};
+
+	IssueBarriers(*Context.GetGraphicsCommandBuffer(), m_PrologueSchedule.Releases);
+	Signal(m_PrologueSchedule);
+
+	m_PassCpuTimes.assign(m_PassOrder.size(), 0.0f);
+
+	std::vector<RecordingJob> Jobs;
+	BuildRecordingJobs(Jobs);
+
+	if (!Jobs.empty())
+	{
+		auto RecordSecondary = [this, &GetContext](RecordingJob& Job) {
+			auto& JobContext = GetContext(m_PassSchedule[Job.PositionBegin].Queue);
+			Job.CommandBuffer = JobContext.GetThreadCommandBufferPool().Acquire(ERHICommandBufferLevel::Secondary);
+			RecordJob(*Job.CommandBuffer, Job);
+			Job.CommandBuffer->End();
+		};
+
+		auto RecordEvent = TFTask::ParallelFor(Jobs.begin(), Jobs.end(), [&RecordSecondary](RecordingJob& Job) {
+			if (!Job.OnExecutingThread)
+			{
+				RecordSecondary(Job);
+			}
+		});
+
+		for (auto& Job : Jobs)
+		{
+			if (Job.OnExecutingThread)
+			{
+				RecordSecondary(Job);
+			}
+		}
+
+		RecordEvent->Wait();
+
+		for (const auto& Job : Jobs)
+		{
+			m_PassCpuTimes[Job.PositionBegin] += Job.CpuTime;
+		}
+
+		/// Every queue executes the jobs between its waits and signals in one go.
+		std::vector<RHICommandBuffer*> CommandBuffers;
+		auto Queue = ERHIDeviceQueue::Graphics;
+
+		auto Flush = [&]() {
+			if (!CommandBuffers.empty())
+			{
+				GetContext(Queue).GetGraphicsCommandBuffer()->ExecuteCommands(CommandBuffers.data(), static_cast<uint32_t>(CommandBuffers.size()));
+				CommandBuffers.clear();
+			}
+		};
+
+		for (const auto& Job : Jobs)
+		{
+			const auto& Schedule = m_PassSchedule[Job.PositionBegin];
+			const auto& LastSchedule = m_PassSchedule[Job.PositionEnd - 1u];
+			const bool FirstRange = !Job.Ranged || Job.WorkItemBegin == 0u;
+			const bool LastRange = !Job.Ranged || Job.WorkItemEnd == m_Passes[m_PassOrder[Job.PositionBegin].GetIndex()]->GetNumWorkItems();
+
+			if (Schedule.Queue != Queue || (FirstRange && Schedule.WaitValue))
+			{
+				Flush();
+				Queue = Schedule.Queue;
+			}
+
+			if (FirstRange)
+			{
+				Wait(Schedule);
+			}
+
+			CommandBuffers.push_back(Job.CommandBuffer);
+
+			if (LastRange && LastSchedule.SignalValue)
+			{
+				Flush();
+				Signal(LastSchedule);
+			}
+		}
+
+		Flush();
+	}
+	else
+	{
+		for (uint32_t Position = 0u; Position < m_PassOrder.size(); ++Position)
+		{
+			const auto& Schedule = m_PassSchedule[Position];
+
+			RecordingJob Job;
+			Job.PositionBegin = Position;
+			Job.PositionEnd = Position + 1u;
+
+			Wait(Schedule);
+			RecordJob(*GetContext(Schedule.Queue).GetGraphicsCommandBuffer(), Job);
+			Signal(Schedule);
+		}
+	}
+
+	/// The graphics queue joins the compute queue before handing the resources out.
+	Wait(m_PassSchedule.back());
+	IssueBarriers(*Context.GetGraphicsCommandBuffer(), m_BarrierBatches.back());
+
+	for (auto& [Texture, OutTexture] : m_TextureExtractions)
+	{
+		*OutTexture = std::static_pointer_cast<RHITexture>(Texture->m_RHIResource);
+	}
+
+	for (auto& [Buffer, OutBuffer] : m_BufferExtractions)
+	{
+		*OutBuffer = std::static_pointer_cast<RHIBuffer>(Buffer->m_RHIResource);
+	}
+
+	ReleaseResources();
+
+	ExportIfRequested();
+}
+
+void RDGRenderGraph::ExportIfRequested() const
+{
+	if (CVarRDGExport.Get())
+	{
+		CVarRDGExport.Set(false);
+		RDGGraphExporter::Export(*this, Paths::SavedPath() / "RenderGraph");
+	}
+}
+
+void RDGRenderGraph::BuildRecordingJobs(std::vector<RecordingJob>& Jobs) const
+{
+	const bool ParallelPasses = m_Settings.EnableAsyncCommandlistSubmission;
+	const bool ParallelWorkItems = m_Settings.EnableAsyncMeshDrawCommandsBuilding;
+	const uint32_t NumWorkers = TFTask::GetNumWorkerThreads();
+	const uint32_t NumPositions = static_cast<uint32_t>(m_PassOrder.size());
+
+	if ((!ParallelPasses && !ParallelWorkItems) || NumWorkers < 2u || NumPositions == 0u)
+	{
+		return;
+	}
+
+	/// About one job per worker, but never so few passes per job that the command buffers cost more than they save.
+	const uint32_t PassesPerJob = ParallelPasses ? std::max((NumPositions + NumWorkers - 1u) / NumWorkers, CVarRDGParallelMinPassesPerJob.Get()) : NumPositions;
+	const uint32_t MinWorkItemsPerJob = std::max(CVarRDGParallelMinWorkItemsPerJob.Get(), 1u);
+	bool HasRangedJobs = false;
+
+	for (uint32_t Position = 0u; Position < NumPositions; ++Position)
+	{
+		const auto& Pass = *m_Passes[m_PassOrder[Position].GetIndex()];
+		const uint32_t NumWorkItems = Pass.GetNumWorkItems();
+
+		if (!Pass.AllowsAsyncExecute())
+		{
+			auto& Job = Jobs.emplace_back();
+			Job.PositionBegin = Position;
+			Job.PositionEnd = Position + 1u;
+			Job.OnExecutingThread = true;
+		}
+		else if (ParallelWorkItems && NumWorkItems >= 2u * MinWorkItemsPerJob)
+		{
+			const uint32_t NumJobs = std::min(NumWorkers, NumWorkItems / MinWorkItemsPerJob);
+
+			for (uint32_t Index = 0u; Index < NumJobs; ++Index)
+			{
+				auto& Job = Jobs.emplace_back();
+				Job.PositionBegin = Position;
+				Job.PositionEnd = Position + 1u;
+				Job.Ranged = true;
+				Job.WorkItemBegin = static_cast<uint32_t>(static_cast<uint64_t>(NumWorkItems) * Index / NumJobs);
+				Job.WorkItemEnd = static_cast<uint32_t>(static_cast<uint64_t>(NumWorkItems) * (Index + 1u) / NumJobs);
+			}
+
+			HasRangedJobs = true;
+		}
+		else if (!Jobs.empty() && !Jobs.back().Ranged && !Jobs.back().OnExecutingThread && Jobs.back().PositionEnd - Jobs.back().PositionBegin < PassesPerJob &&
+			!IsJobBoundary(Position))
+		{
+			++Jobs.back().PositionEnd;
+		}
+		else
+		{
+			auto& Job = Jobs.emplace_back();
+			Job.PositionBegin = Position;
+			Job.PositionEnd = Position + 1u;
+		}
+	}
+
+	/// Nothing recorded in parallel after all, the graphics command buffer records everything itself.
+	if (Jobs.size() < 2u || (!ParallelPasses && !HasRangedJobs))
+	{
+		Jobs.clear();
+	}
+}
+
+bool RDGRenderGraph::IsJobBoundary(uint32_t Position) const
+{
+	if (Position == 0u)
+	{
+		return true;
+	}
+
+	const auto& Schedule = m_PassSchedule[Position];
+	const auto& Previous = m_PassSchedule[Position - 1u];
+	return Schedule.Queue != Previous.Queue || Schedule.WaitValue || Previous.SignalValue;
+}
+
+void RDGRenderGraph::RecordJob(RHICommandBuffer& CommandBuffer, RecordingJob& Job)
+{
+	for (uint32_t Position = Job.PositionBegin; Position < Job.PositionEnd; ++Position)
+	{
+		auto& Pass = *m_Passes[m_PassOrder[Position].GetIndex()];
+
+		if (Job.Ranged)
+		{
+			/// The barriers before a split pass go with its first range, the releases after it with its last.
+			if (Job.WorkItemBegin == 0u)
+			{
+				IssueBarriers(CommandBuffer, m_BarrierBatches[Position]);
+			}
+
+			CpuTimer Timer;
+			Pass.ExecuteRange(CommandBuffer, Job.WorkItemBegin, Job.WorkItemEnd);
+			Job.CpuTime += Timer.GetElapsedMilliseconds();
+
+			if (Job.WorkItemEnd == Pass.GetNumWorkItems())
+			{
+				IssueBarriers(CommandBuffer, m_PassSchedule[Position].Releases);
+			}
+		}
+		else
+		{
+			IssueBarriers(CommandBuffer, m_BarrierBatches[Position]);
+
+			CpuTimer Timer;
+			Pass.Execute(CommandBuffer);
+			m_PassCpuTimes[Position] = Timer.GetElapsedMilliseconds();
+
+			IssueBarriers(CommandBuffer, m_PassSchedule[Position].Releases);
+		}
+	}
+}
+
+void RDGRenderGraph::AllocateResources()
 {
+	if (m_AliasingGroups.empty() && m_TextureExtractions.empty() && m_BufferExtractions.empty())
+	{
+		return;
+	}
+
+	for (auto& Group : m_AliasingGroups)
+	{
+		const auto& Representative = *m_Resources[Group.Resources.front().GetIndex()];
+
+		if (Group.Type == RDGResource::EType::Texture)
+		{
+			Group.RHIResource = m_Pool.AcquireTexture(static_cast<const RDGTexture&>(Representative).GetDesc());
+		}
+		else
+		{
+			auto Desc = static_cast<const RDGBuffer&>(Representative).GetDesc();
+			Desc.Size = Group.Size;
+			Group.RHIResource = m_Pool.AcquireBuffer(Desc);
+		}
+
+		for (auto ResourceID : Group.Resources)
+		{
+			m_Resources[ResourceID.GetIndex()]->m_RHIResource = Group.RHIResource;
+		}
+	}
+
+	/// Extracted resources outlive the graph, they get memory of their own.
+	for (auto& Resource : m_Resources)
+	{
+		if (Resource->IsExtracted() && !Resource->IsImported() && !Resource->m_RHIResource && Resource->GetLifetime().IsUsed())
+		{
+			if (Resource->GetType() == RDGResource::EType::Texture)
+			{
+				Resource->m_RHIResource = m_Pool.GetDevice().CreateTexture(static_cast<const RDGTexture&>(*Resource).GetDesc());
+			}
+			else
+			{
+				Resource->m_RHIResource = m_Pool.GetDevice().CreateBuffer(static_cast<const RDGBuffer&>(*Resource).GetDesc());
+			}
+		}
+	}
 }
 
-void RDGRenderGraph::Execute()
+void RDGRenderGraph::IssueBarriers(RHICommandBuffer& CommandBuffer, const RDGBarrierBatch& Batch) const
 {
+	if (Batch.Transitions.empty())
+	{
+		return;
+	}
+
+	std::vector<RHITransition> Transitions;
+	Transitions.reserve(Batch.Transitions.size());
+
+	for (const auto& Transition : Batch.Transitions)
+	{
+		const auto& Resource = *m_Resources[Transition.Resource.GetIndex()];
+		if (!Resource.m_RHIResource)
+		{
+			continue;
+		}
+
+		auto& RHITransition = Transitions.emplace_back();
+		if (Resource.GetType() == RDGResource::EType::Texture)
+		{
+			RHITransition.Texture = static_cast<const RHITexture*>(Resource.m_RHIResource.get());
+		}
+		else
+		{
+			RHITransition.Buffer = static_cast<const RHIBuffer*>(Resource.m_RHIResource.get());
+		}
+		RHITransition.Subresource = Transition.Subresource;
+		RHITransition.SrcState = Transition.SrcState;
+		RHITransition.DstState = Transition.DstState;
+		RHITransition.SrcQueue = Transition.SrcQueue;
+		RHITransition.DstQueue = Transition.DstQueue;
+		RHITransition.Flags = Transition.Flags;
+	}
+
+	if (!Transitions.empty())
+	{
+		CommandBuffer.Transition(Transitions.data(), static_cast<uint32_t>(Transitions.size()));
+	}
+}
+
+void RDGRenderGraph::ReleaseResources()
+{
+	for (auto& Group : m_AliasingGroups)
+	{
+		if (Group.RHIResource)
+		{
+			m_Pool.Release(Group.RHIResource);
+			Group.RHIResource.reset();
+		}
+
+		for (auto ResourceID : Group.Resources)
+		{
+			m_Resources[ResourceID.GetIndex()]->m_RHIResource.reset();
+		}
+	}
 }
 
 RDGTexture* RDGRenderGraph::CreateTexture(const RHITextureDesc& Desc)
 {
-	return nullptr;
+	return AllocateResource<RDGTexture>(Desc);
 }
 
 RDGBuffer* RDGRenderGraph::CreateBuffer(const RHIBufferDesc& Desc)
 {
-	return nullptr;
+	return AllocateResource<RDGBuffer>(Desc);
+}
+
+RDGTexture* RDGRenderGraph::RegisterExternalTexture(const RHITexturePtr& Texture, const RHITextureDesc& Desc)
+{
+	auto ExternalTexture = AllocateResource<RDGTexture>(Desc);
+	ExternalTexture->m_RHIResource = Texture;
+	ExternalTexture->m_Imported = true;
+	return ExternalTexture;
+}
+
+RDGBuffer* RDGRenderGraph::RegisterExternalBuffer(const RHIBufferPtr& Buffer, const RHIBufferDesc& Desc)
+{
+	auto ExternalBuffer = AllocateResource<RDGBuffer>(Desc);
+	ExternalBuffer->m_RHIResource = Buffer;
+	ExternalBuffer->m_Imported = true;
+	return ExternalBuffer;
+}
+
+void RDGRenderGraph::ExtractTexture(RDGTexture* Texture, RHITexturePtr& OutTexture)
+{
+	assert(Texture);
+	Texture->m_Extracted = true;
+	m_TextureExtractions.emplace_back(Texture, &OutTexture);
+}
+
+void RDGRenderGraph::ExtractBuffer(RDGBuffer* Buffer, RHIBufferPtr& OutBuffer)
+{
+	assert(Buffer);
+	Buffer->m_Extracted = true;
+	m_BufferExtractions.emplace_back(Buffer, &OutBuffer);
+}
+
+bool RDGRenderGraph::Compile(bool AsyncComputeQueue)
+{
+	CpuTimer Timer;
+
+	const bool AsyncCompute = AsyncComputeQueue && CVarRDGAsyncCompute.Get();
+
+	size_t ShapeHash = CVarRDGCompileCache.Get() ? ComputeShapeHash() : 0u;
+	if (ShapeHash)
+	{
+		HashCombine(ShapeHash, AsyncCompute);
+	}
+
+	if (RestoreCompiledShape(ShapeHash))
+	{
+		m_CompileStats.CompileTime = Timer.GetElapsedMilliseconds();
+		m_CompileStats.SavedTime = std::max(m_CompileStats.FullCompileTime - m_CompileStats.CompileTime, 0.0f);
+		++m_CompileStats.NumCacheHits;
+
+		m_Compiled = true;
+		return true;
+	}
+
+	m_CompiledShape.Valid = false;
+	m_Compiled = CompileFromScratch(AsyncCompute);
+
+	if (m_Compiled)
+	{
+		SaveCompiledShape(ShapeHash);
+	}
+
+	m_CompileStats.FullCompileTime = m_CompileStats.CompileTime = Timer.GetElapsedMilliseconds();
+	m_CompileStats.SavedTime = 0.0f;
+	++m_CompileStats.NumCacheMisses;
+
+	LOG_DEBUG(LogRenderGraph, "Compiled render graph of {} passes in {:.3f} ms, {} frames reused the previous plan.",
+		m_Passes.size(), m_CompileStats.FullCompileTime, m_CompileStats.NumCacheHits);
+
+	return m_Compiled;
+}
+
+void RDGRenderGraph::Reset()
+{
+	m_Passes.clear();
+	m_Resources.clear();
+	m_PassDependencies.clear();
+	m_TextureExtractions.clear();
+	m_BufferExtractions.clear();
+	m_Compiled = false;
+}
+
+size_t RDGRenderGraph::ComputeShapeHash() const
+{
+	size_t Hash = ComputeHash(m_Passes.size(), m_Resources.size(), m_PassDependencies.size());
+
+	for (const auto& Resource : m_Resources)
+	{
+		HashCombine(Hash, Resource->GetType(), Resource->IsImported(), Resource->IsExtracted(), GetExternalState(*Resource));
+
+		if (Resource->GetType() == RDGResource::EType::Texture)
+		{
+			HashCombine(Hash, RDGRenderTargetPool::ComputeKey(static_cast<const RDGTexture&>(*Resource).GetDesc()));
+		}
+		else
+		{
+			const auto& Desc = static_cast<const RDGBuffer&>(*Resource).GetDesc();
+			HashCombine(Hash, RDGRenderTargetPool::ComputeKey(Desc), Desc.Size);
+		}
+	}
+
+	for (const auto& Pass : m_Passes)
+	{
+		HashCombine(Hash, Pass->GetFlags(), Pass->m_TextureStates.size(), Pass->m_BufferStates.size());
+
+		for (const auto& TextureState : Pass->m_TextureStates)
+		{
+			const auto& Subresource = TextureState.Subresource;
+			HashCombine(Hash, TextureState.Texture->GetID().GetIndex(), TextureState.Access, TextureState.State,
+				Subresource.BaseMipLevel, Subresource.NumMips, Subresource.BaseArrayLayer, Subresource.NumLayers);
+		}
+
+		for (const auto& BufferState : Pass->m_BufferStates)
+		{
+			HashCombine(Hash, BufferState.Buffer->GetID().GetIndex(), BufferState.Access, BufferState.State);
+		}
+	}
+
+	for (const auto& [Producer, Consumer] : m_PassDependencies)
+	{
+		HashCombine(Hash, Producer.GetIndex(), Consumer.GetIndex());
+	}
+
+	return Hash;
+}
+
+void RDGRenderGraph::SaveCompiledShape(size_t ShapeHash)
+{
+	if (!ShapeHash)
+	{
+		return;
+	}
+
+	auto& Shape = m_CompiledShape;
+	Shape.Hash = ShapeHash;
+	Shape.Valid = true;
+
+	Shape.Producers.resize(m_Passes.size());
+	Shape.Successors.resize(m_Passes.size());
+	Shape.Culled.resize(m_Passes.size());
+	for (size_t Index = 0u; Index < m_Passes.size(); ++Index)
+	{
+		Shape.Producers[Index] = m_Passes[Index]->m_Producers;
+		Shape.Successors[Index] = m_Passes[Index]->m_Successors;
+		Shape.Culled[Index] = m_Passes[Index]->m_Culled;
+	}
+
+	Shape.Lifetimes.resize(m_Resources.size());
+	Shape.AliasingGroups.resize(m_Resources.size());
+	for (size_t Index = 0u; Index < m_Resources.size(); ++Index)
+	{
+		Shape.Lifetimes[Index] = m_Resources[Index]->m_Lifetime;
+		Shape.AliasingGroups[Index] = m_Resources[Index]->m_AliasingGroup;
+	}
+}
+
+bool RDGRenderGraph::RestoreCompiledShape(size_t ShapeHash)
+{
+	/// The pass order, the aliasing groups, the barrier batches and the pass schedule are still those of the last compile.
+	const auto& Shape = m_CompiledShape;
+	if (!ShapeHash || !Shape.Valid || Shape.Hash != ShapeHash || Shape.Culled.size() != m_Passes.size() || Shape.Lifetimes.size() != m_Resources.size())
+	{
+		return false;
+	}
+
+	for (size_t Index = 0u; Index < m_Passes.size(); ++Index)
+	{
+		m_Passes[Index]->m_Producers = Shape.Producers[Index];
+		m_Passes[Index]->m_Successors = Shape.Successors[Index];
+		m_Passes[Index]->m_Culled = Shape.Culled[Index];
+	}
+
+	for (size_t Index = 0u; Index < m_Resources.size(); ++Index)
+	{
+		m_Resources[Index]->m_Lifetime = Shape.Lifetimes[Index];
+		m_Resources[Index]->m_AliasingGroup = Shape.AliasingGroups[Index];
+	}
+
+	return true;
+}
+
+bool RDGRenderGraph::CompileFromScratch(bool AsyncComputeQueue)
+{
+	m_PassOrder.clear();
+
+	for (auto& Pass : m_Passes)
+	{
+		Pass->m_Producers.clear();
+		Pass->m_Successors.clear();
+		Pass->m_Culled = false;
+	}
+
+	if (!BuildDependencies() || !SortPasses())
+	{
+		/// Nothing of the last plan may pass for this graph's, an export then shows the declarations only.
+		m_PassOrder.clear();
+		m_AliasingGroups.clear();
+		m_TransientMemoryStats = RDGTransientMemoryStats();
+		m_BarrierBatches.clear();
+		m_PassSchedule.clear();
+		m_PrologueSchedule = RDGPassSchedule();
+		m_PassCpuTimes.clear();
+		return false;
+	}
+
+	CullPasses();
+
+	m_PassOrder.erase(std::remove_if(m_PassOrder.begin(), m_PassOrder.end(), [this](RDGPassID PassID) {
+		return m_Passes[PassID.GetIndex()]->IsCulled();
+	}), m_PassOrder.end());
+
+	AssignQueues(AsyncComputeQueue);
+	PlanTransientResources();
+
+	std::vector<RDGSyncEdge> SyncEdges;
+	PlanBarriers(SyncEdges);
+	PlanSynchronization(SyncEdges);
+
+	return true;
+}
+
+bool RDGRenderGraph::BuildDependencies()
+{
+	/// Every edge points from an earlier recorded pass to a later one, only explicit dependencies can close a cycle.
+	auto AddEdge = [this](RDGPassID From, RDGPassID To, bool DataFlow) {
+		auto& Successors = m_Passes[From.GetIndex()]->m_Successors;
+		if (std::find(Successors.begin(), Successors.end(), To) == Successors.end())
+		{
+			Successors.push_back(To);
+		}
+
+		if (DataFlow)
+		{
+			auto& Producers = m_Passes[To.GetIndex()]->m_Producers;
+			if (std::find(Producers.begin(), Producers.end(), From) == Producers.end())
+			{
+				Producers.push_back(From);
+			}
+		}
+	};
+
+	struct ResourceUsage
+	{
+		RDGPassID LastWriter;
+		std::vector<RDGPassID> Readers;
+	};
+	std::vector<ResourceUsage> Usages(m_Resources.size());
+
+	bool Valid = true;
+
+	auto VisitAccess = [&](const RDGRenderPass& Pass, const RDGResource& Resource, ERDGAccess Access) {
+		auto& Usage = Usages[Resource.GetID().GetIndex()];
+
+		if (EnumHasAnyFlags(Access, ERDGAccess::Read))
+		{
+			if (Usage.LastWriter.IsValid())
+			{
+				AddEdge(Usage.LastWriter, Pass.GetID(), true);
+			}
+			else if (!Resource.IsImported())
+			{
+				LOG_ERROR(LogRenderGraph, "Pass \"{}\" reads \"{}\" before any pass wrote it.", Pass.GetEvent().Name.Get(), Resource.GetName());
+				Valid = false;
+			}
+
+			Usage.Readers.push_back(Pass.GetID());
+		}
+
+		if (EnumHasAnyFlags(Access, ERDGAccess::Write))
+		{
+			/// Writes may be partial, the previous content stays an input of the writer.
+			if (Usage.LastWriter.IsValid() && Usage.LastWriter != Pass.GetID())
+			{
+				AddEdge(Usage.LastWriter, Pass.GetID(), true);
+			}
+
+			for (auto Reader : Usage.Readers)
+			{
+				if (Reader != Pass.GetID())
+				{
+					AddEdge(Reader, Pass.GetID(), false);
+				}
+			}
+
+			Usage.Readers.clear();
+			Usage.LastWriter = Pass.GetID();
+		}
+	};
+
+	for (auto& Pass : m_Passes)
+	{
+		for (auto& TextureState : Pass->m_TextureStates)
+		{
+			VisitAccess(*Pass, *TextureState.Texture, TextureState.Access);
+		}
+
+		for (auto& BufferState : Pass->m_BufferStates)
+		{
+			VisitAccess(*Pass, *BufferState.Buffer, BufferState.Access);
+		}
+	}
+
+	for (auto& [Producer, Consumer] : m_PassDependencies)
+	{
+		AddEdge(Producer, Consumer, true);
+	}
+
+	return Valid;
+}
+
+bool RDGRenderGraph::SortPasses()
+{
+	const size_t NumPasses = m_Passes.size();
+
+	std::vector<uint32_t> NumPendingProducers(NumPasses, 0u);
+	for (auto& Pass : m_Passes)
+	{
+		for (auto Successor : Pass->m_Successors)
+		{
+			++NumPendingProducers[Successor.GetIndex()];
+		}
+	}
+
+	/// Kahn's algorithm, always taking the earliest recorded ready pass keeps the recording order wherever the edges allow it.
+	std::priority_queue<RDGPassID::IndexType, std::vector<RDGPassID::IndexType>, std::greater<RDGPassID::IndexType>> ReadyPasses;
+	for (size_t Index = 0u; Index < NumPasses; ++Index)
+	{
+		if (NumPendingProducers[Index] == 0u)
+		{
+			ReadyPasses.push(static_cast<RDGPassID::IndexType>(Index));
+		}
+	}
+
+	m_PassOrder.reserve(NumPasses);
+	while (!ReadyPasses.empty())
+	{
+		const auto Index = ReadyPasses.top();
+		ReadyPasses.pop();
+
+		m_PassOrder.emplace_back(Index);
+
+		for (auto Successor : m_Passes[Index]->m_Successors)
+		{
+			if (--NumPendingProducers[Successor.GetIndex()] == 0u)
+			{
+				ReadyPasses.push(Successor.GetIndex());
+			}
+		}
+	}
+
+	if (m_PassOrder.size() != NumPasses)
+	{
+		std::string Cycle;
+		for (size_t Index = 0u; Index < NumPasses; ++Index)
+		{
+			if (NumPendingProducers[Index] > 0u)
+			{
+				Cycle += Cycle.empty() ? "\"" : ", \"";
+				Cycle += m_Passes[Index]->GetEvent().Name.Get();
+				Cycle += "\"";
+			}
+		}
+
+		LOG_ERROR(LogRenderGraph, "Render graph has a dependency cycle through passes {}.", Cycle);
+		return false;
+	}
+
+	return true;
+}
+
+void RDGRenderGraph::CullPasses()
+{
+	std::vector<RDGPassID> AlivePasses;
+	std::vector<bool> Alive(m_Passes.size(), false);
+
+	auto MarkAlive = [&](const RDGRenderPass& Pass) {
+		if (!Alive[Pass.GetID().GetIndex()])
+		{
+			Alive[Pass.GetID().GetIndex()] = true;
+			AlivePasses.push_back(Pass.GetID());
+		}
+	};
+
+	for (auto& Pass : m_Passes)
+	{
+		/// Passes declaring nothing are opaque to the graph, whatever they do is kept.
+		bool Root = Pass->IsNeverCull() || (Pass->m_TextureStates.empty() && Pass->m_BufferStates.empty());
+
+		for (auto& TextureState : Pass->m_TextureStates)
+		{
+			Root |= EnumHasAnyFlags(TextureState.Access, ERDGAccess::Write) && !TextureState.Texture->IsTransient();
+		}
+
+		for (auto& BufferState : Pass->m_BufferStates)
+		{
+			Root |= EnumHasAnyFlags(BufferState.Access, ERDGAccess::Write) && !BufferState.Buffer->IsTransient();
+		}
+
+		if (Root)
+		{
+			MarkAlive(*Pass);
+		}
+	}
+
+	while (!AlivePasses.empty())
+	{
+		const auto PassID = AlivePasses.back();
+		AlivePasses.pop_back();
+
+		for (auto Producer : m_Passes[PassID.GetIndex()]->m_Producers)
+		{
+			MarkAlive(*m_Passes[Producer.GetIndex()]);
+		}
+	}
+
+	size_t NumCulled = 0u;
+	for (auto& Pass : m_Passes)
+	{
+		Pass->m_Culled = !Alive[Pass->GetID().GetIndex()];
+		NumCulled += Pass->m_Culled ? 1u : 0u;
+	}
+
+	if (NumCulled)
+	{
+		LOG_DEBUG(LogRenderGraph, "Culled {} of {} render passes.", NumCulled, m_Passes.size());
+	}
+}
+
+void RDGRenderGraph::AssignQueues(bool AsyncComputeQueue)
+{
+	m_PassSchedule.assign(m_PassOrder.size() + 1u, RDGPassSchedule());
+	m_PrologueSchedule = RDGPassSchedule();
+
+	if (!AsyncComputeQueue)
+	{
+		return;
+	}
+
+	for (uint32_t Position = 0u; Position < m_PassOrder.size(); ++Position)
+	{
+		const auto& Pass = *m_Passes[m_PassOrder[Position].GetIndex()];
+		if (Pass.IsAsyncCompute() && !EnumHasAnyFlags(Pass.GetFlags(), ERDGPassFlags::Raster))
+		{
+			m_PassSchedule[Position].Queue = ERHIDeviceQueue::Compute;
+		}
+	}
+}
+
+void RDGRenderGraph::PlanTransientResources()
+{
+	m_AliasingGroups.clear();
+	m_TransientMemoryStats = RDGTransientMemoryStats();
+
+	for (auto& Resource : m_Resources)
+	{
+		Resource->m_Lifetime = RDGResourceLifetime();
+		Resource->m_AliasingGroup = RDGResource::NoAliasingGroup;
+	}
+
+	const uint32_t NumPositions = static_cast<uint32_t>(m_PassOrder.size());
+	for (uint32_t Position = 0u; Position < NumPositions; ++Position)
+	{
+		auto Use = [Position](RDGResource& Resource) {
+			auto& Lifetime = Resource.m_Lifetime;
+			if (!Lifetime.IsUsed())
+			{
+				Lifetime.FirstPass = Position;
+			}
+			Lifetime.LastPass = Position;
+		};
+
+		const auto& Pass = *m_Passes[m_PassOrder[Position].GetIndex()];
+		for (auto& TextureState : Pass.m_TextureStates)
+		{
+			Use(*TextureState.Texture);
+		}
+		for (auto& BufferState : Pass.m_BufferStates)
+		{
+			Use(*BufferState.Buffer);
+		}
+	}
+
+	std::vector<RDGResource*> Transients;
+	for (auto& Resource : m_Resources)
+	{
+		if (Resource->IsTransient() && Resource->GetLifetime().IsUsed())
+		{
+			Transients.push_back(Resource.get());
+		}
+	}
+
+	std::sort(Transients.begin(), Transients.end(), [](const RDGResource* Left, const RDGResource* Right) {
+		return Left->GetLifetime().FirstPass != Right->GetLifetime().FirstPass ?
+			Left->GetLifetime().FirstPass < Right->GetLifetime().FirstPass : Left->GetID().GetIndex() < Right->GetID().GetIndex();
+	});
+
+	/// Interval partitioning: sweeping the lifetimes by their start, a resource joins a compatible group whose last member is dead by then.
+	/// Within a key textures are all of a size, so this needs as few groups as resources of the key are alive at once. Buffers take the
+	/// group closest to their size to keep groups from growing.
+	std::unordered_map<size_t, std::vector<uint32_t>> GroupsByKey;
+	std::vector<uint32_t> GroupLastPasses;
+	std::vector<int64_t> LiveSizeDeltas(NumPositions + 1u, 0);
+
+	for (auto Resource : Transients)
+	{
+		const bool IsTexture = Resource->GetType() == RDGResource::EType::Texture;
+		const auto& Lifetime = Resource->GetLifetime();
+
+		size_t Key = 0u, Size = 0u;
+		if (IsTexture)
+		{
+			const auto& Texture = static_cast<const RDGTexture&>(*Resource);
+			Key = RDGRenderTargetPool::ComputeKey(Texture.GetDesc());
+			Size = Texture.ComputeMemorySize();
+		}
+		else
+		{
+			const auto& Buffer = static_cast<const RDGBuffer&>(*Resource);
+			Key = RDGRenderTargetPool::ComputeKey(Buffer.GetDesc());
+			Size = Buffer.ComputeMemorySize();
+		}
+		auto& KeyGroups = GroupsByKey[ComputeHash(Key, Resource->GetType())];
+
+		uint32_t BestGroup = RDGResource::NoAliasingGroup;
+		for (auto GroupIndex : KeyGroups)
+		{
+			if (GroupLastPasses[GroupIndex] >= Lifetime.FirstPass)
+			{
+				continue;
+			}
+
+			if (BestGroup == RDGResource::NoAliasingGroup)
+			{
+				BestGroup = GroupIndex;
+				continue;
+			}
+
+			const size_t GroupSize = m_AliasingGroups[GroupIndex].Size;
+			const size_t BestSize = m_AliasingGroups[BestGroup].Size;
+			const bool Fits = GroupSize >= Size;
+			const bool BestFits = BestSize >= Size;
+			if (Fits != BestFits ? Fits : (Fits ? GroupSize < BestSize : GroupSize > BestSize))
+			{
+				BestGroup = GroupIndex;
+			}
+		}
+
+		if (BestGroup == RDGResource::NoAliasingGroup)
+		{
+			BestGroup = static_cast<uint32_t>(m_AliasingGroups.size());
+			m_AliasingGroups.emplace_back().Type = Resource->GetType();
+			m_AliasingGroups.back().Key = Key;
+			GroupLastPasses.push_back(0u);
+			KeyGroups.push_back(BestGroup);
+		}
+
+		auto& Group = m_AliasingGroups[BestGroup];
+		Group.Size = std::max(Group.Size, Size);
+		Group.Resources.push_back(Resource->GetID());
+		GroupLastPasses[BestGroup] = Lifetime.LastPass;
+		Resource->m_AliasingGroup = BestGroup;
+
+		LiveSizeDeltas[Lifetime.FirstPass] += static_cast<int64_t>(Size);
+		LiveSizeDeltas[Lifetime.LastPass + 1u] -= static_cast<int64_t>(Size);
+
+		m_TransientMemoryStats.UnaliasedSize += Size;
+	}
+
+	int64_t LiveSize = 0;
+	for (auto Delta : LiveSizeDeltas)
+	{
+		LiveSize += Delta;
+		m_TransientMemoryStats.PeakLiveSize = std::max(m_TransientMemoryStats.PeakLiveSize, static_cast<size_t>(LiveSize));
+	}
+
+	for (const auto& Group : m_AliasingGroups)
+	{
+		m_TransientMemoryStats.AliasedSize += Group.Size;
+	}
+
+	m_TransientMemoryStats.NumResources = static_cast<uint32_t>(Transients.size());
+	m_TransientMemoryStats.NumAliasingGroups = static_cast<uint32_t>(m_AliasingGroups.size());
+
+	if (!Transients.empty())
+	{
+		LOG_DEBUG(LogRenderGraph, "{} transient resources in {} aliasing groups: {:.2f} MB aliased, {:.2f} MB unaliased, {:.2f} MB peak live.",
+			m_TransientMemoryStats.NumResources,
+			m_TransientMemoryStats.NumAliasingGroups,
+			static_cast<double>(m_TransientMemoryStats.AliasedSize) / Megabyte,
+			static_cast<double>(m_TransientMemoryStats.UnaliasedSize) / Megabyte,
+			static_cast<double>(m_TransientMemoryStats.PeakLiveSize) / Megabyte);
+	}
+}
+
+void RDGRenderGraph::PlanBarriers(std::vector<RDGSyncEdge>& SyncEdges)
+{
+	const uint32_t NumPositions = static_cast<uint32_t>(m_PassOrder.size());
+
+	m_BarrierBatches.clear();
+	m_BarrierBatches.resize(NumPositions + 1u);
+
+	static constexpr uint32_t NoTransition = ~0u;
+
+	/// Backends which can not begin a transition early get the whole one where it ends.
+	const bool SplitBarriers = m_Pool.GetDevice().GetCapabilities().SupportsSplitBarriers;
+
+	/// The epilogue after all passes is on the graphics queue.
+	auto GetQueue = [this, NumPositions](uint32_t Position) {
+		return Position < NumPositions ? m_PassSchedule[Position].Queue : ERHIDeviceQueue::Graphics;
+	};
+
+	/// Split transitions must begin on the queue they end on, at the first position of that queue after the last use.
+	std::vector<uint32_t> NextOnQueue[2];
+	for (auto& Next : NextOnQueue)
+	{
+		Next.assign(NumPositions + 1u, NumPositions);
+	}
+	for (uint32_t Position = NumPositions; Position-- > 0u;)
+	{
+		for (uint32_t QueueIndex = 0u; QueueIndex < 2u; ++QueueIndex)
+		{
+			NextOnQueue[QueueIndex][Position] = NextOnQueue[QueueIndex][Position + 1u];
+		}
+		NextOnQueue[GetQueue(Position) == ERHIDeviceQueue::Compute ? 1u : 0u][Position] = Position;
+	}
+
+	/// Releases after the pass at a position, -1 for the prologue.
+	auto GetReleases = [this](int32_t Position) -> std::vector<RDGTransition>& {
+		return Position < 0 ? m_PrologueSchedule.Releases.Transitions : m_PassSchedule[Position].Releases.Transitions;
+	};
+
+	struct TransitionRef
+	{
+		uint32_t Batch = NoTransition;
+		uint32_t Index = NoTransition;
+
+		/// Of the BeginOnly half of split transitions, and of the release of queue ownership transfers.
+		uint32_t BeginBatch = NoTransition;
+		uint32_t BeginIndex = NoTransition;
+		int32_t ReleasePosition = -1;
+		bool Release = false;
+
+		inline bool IsValid() const { return Batch != NoTransition; }
+		inline bool operator==(const TransitionRef& Other) const { return Batch == Other.Batch && Index == Other.Index; }
+	};
+
+	struct SubresourceState
+	{
+		ERHIResourceState State = ERHIResourceState::Unknown;
+
+		/// Pass order position of the last access, -1 for accesses before the graph.
+		int32_t LastPass = -1;
+
+		/// The resource the content belongs to, another member of the aliasing group once it used the memory.
+		RDGResourceID Owner;
+
+		/// The transition which put the subresource into its state, if any.
+		TransitionRef LastTransition;
+
+		/// The queue which owns the subresource and accessed it last, the graphics queue before the graph.
+		ERHIDeviceQueue Queue = ERHIDeviceQueue::Graphics;
+	};
+
+	/// The memory transitions act on, shared by all members of an aliasing group. Mip major.
+	struct PhysicalResource
+	{
+		uint32_t NumMips = 1u;
+		uint32_t NumLayers = 1u;
+		std::vector<SubresourceState> Subresources;
+	};
+
+	const uint32_t NumGroups = static_cast<uint32_t>(m_AliasingGroups.size());
+	std::vector<PhysicalResource> PhysicalResources(NumGroups + m_Resources.size());
+
+	auto GetPhysicalResource = [&](const RDGResource& Resource) -> PhysicalResource& {
+		const uint32_t Group = Resource.GetAliasingGroup();
+		auto& Physical = PhysicalResources[Group != RDGResource::NoAliasingGroup ? Group : NumGroups + Resource.GetID().GetIndex()];
+
+		if (Physical.Subresources.empty())
+		{
+			if (Resource.GetType() == RDGResource::EType::Texture)
+			{
+				const auto& Desc = static_cast<const RDGTexture&>(Resource).GetDesc();
+				const bool IsCube = Desc.Dimension == ERHITextureDimension::T_Cube || Desc.Dimension == ERHITextureDimension::T_Cube_Array;
+
+				Physical.NumMips = std::max<uint32_t>(Desc.NumMipLevel, 1u);
+				Physical.NumLayers = std::max<uint32_t>(Desc.NumArrayLayer, 1u) * (IsCube ? 6u : 1u);
+			}
+
+			SubresourceState Initial;
+			if (Resource.IsImported())
+			{
+				Initial.State = GetExternalState(Resource);
+				Initial.Owner = Resource.GetID();
+			}
+
+			Physical.Subresources.assign(Physical.NumMips * Physical.NumLayers, Initial);
+		}
+
+		return Physical;
+	};
+
+	auto ResolveSubresource = [](const PhysicalResource& Physical, const RHISubresource& Subresource) {
+		RHISubresource Resolved;
+		Resolved.BaseMipLevel = std::min<uint16_t>(Subresource.BaseMipLevel, static_cast<uint16_t>(Physical.NumMips - 1u));
+		Resolved.NumMips = static_cast<uint16_t>(std::min<uint32_t>(Subresource.NumMips, Physical.NumMips - Resolved.BaseMipLevel));
+		Resolved.BaseArrayLayer = std::min<uint16_t>(Subresource.BaseArrayLayer, static_cast<uint16_t>(Physical.NumLayers - 1u));
+		Resolved.NumLayers = static_cast<uint16_t>(std::min<uint32_t>(Subresource.NumLayers, Physical.NumLayers - Resolved.BaseArrayLayer));
+		return Resolved;
+	};
+
+	auto ForEachSubresource = [](const PhysicalResource& Physical, const RHISubresource& Range, auto&& Function) {
+		for (uint32_t Mip = Range.BaseMipLevel; Mip < static_cast<uint32_t>(Range.BaseMipLevel) + Range.NumMips; ++Mip)
+		{
+			for (uint32_t Layer = Range.BaseArrayLayer; Layer < static_cast<uint32_t>(Range.BaseArrayLayer) + Range.NumLayers; ++Layer)
+			{
+				Function(Mip, Layer, Mip * Physical.NumLayers + Layer);
+			}
+		}
+	};
+
+	/// A later read in another read only state widens the transition into the earlier one instead of adding another, as long as that
+	/// transition is still the last one of every subresource it covers.
+	auto TryWiden = [&](PhysicalResource& Physical, const TransitionRef& Ref, ERHIResourceState State) {
+		auto& Transition = m_BarrierBatches[Ref.Batch].Transitions[Ref.Index];
+
+		bool Widenable = true;
+		ForEachSubresource(Physical, Transition.Subresource, [&](uint32_t, uint32_t, uint32_t Index) {
+			Widenable &= Physical.Subresources[Index].LastTransition == Ref;
+		});
+
+		if (!Widenable)
+		{
+			return false;
+		}
+
+		Transition.DstState = Transition.DstState | State;
+		if (Ref.Release)
+		{
+			GetReleases(Ref.ReleasePosition)[Ref.BeginIndex].DstState = Transition.DstState;
+		}
+		else if (Ref.BeginBatch != NoTransition)
+		{
+			m_BarrierBatches[Ref.BeginBatch].Transitions[Ref.BeginIndex].DstState = Transition.DstState;
+		}
+
+		ForEachSubresource(Physical, Transition.Subresource, [&](uint32_t, uint32_t, uint32_t Index) {
+			Physical.Subresources[Index].State = Transition.DstState;
+		});
+
+		return true;
+	};
+
+	struct PendingTransition
+	{
+		uint32_t Mip = 0u;
+		uint32_t Layer = 0u;
+		ERHIResourceState SrcState = ERHIResourceState::Unknown;
+		ERHIResourceState DstState = ERHIResourceState::Unknown;
+		uint32_t BeginBatch = 0u;
+		bool Discard = false;
+
+		/// Queue ownership transfers are released right after ReleasePosition on SrcQueue.
+		ERHIDeviceQueue SrcQueue = ERHIDeviceQueue::Graphics;
+		bool Release = false;
+		int32_t ReleasePosition = -1;
+
+		inline bool IsBatchableWith(const PendingTransition& Other) const
+		{
+			return SrcState == Other.SrcState && DstState == Other.DstState && BeginBatch == Other.BeginBatch && Discard == Other.Discard &&
+				SrcQueue == Other.SrcQueue && Release == Other.Release && ReleasePosition == Other.ReleasePosition;
+		}
+	};
+	std::vector<PendingTransition> PendingTransitions;
+
+	auto AddTransition = [&](PhysicalResource& Physical, const RDGResource& Resource, const RHISubresource& Range, const PendingTransition& Pending, uint32_t Position) {
+		RDGTransition Transition;
+		Transition.Resource = Resource.GetID();
+		Transition.Subresource = Range;
+		Transition.SrcState = Pending.SrcState;
+		Transition.DstState = Pending.DstState;
+		Transition.SrcQueue = Pending.SrcQueue;
+		Transition.DstQueue = GetQueue(Position);
+		Transition.Flags = Pending.Discard ? ERHITransitionFlags::Discard : ERHITransitionFlags::None;
+
+		TransitionRef Ref;
+		if (Pending.Release)
+		{
+			auto& Releases = GetReleases(Pending.ReleasePosition);
+			Ref.Release = true;
+			Ref.ReleasePosition = Pending.ReleasePosition;
+			Ref.BeginIndex = static_cast<uint32_t>(Releases.size());
+			auto& Release = Releases.emplace_back(Transition);
+			Release.Flags = Release.Flags | ERHITransitionFlags::BeginOnly;
+
+			Transition.Flags = Transition.Flags | ERHITransitionFlags::EndOnly;
+		}
+		else if (Pending.BeginBatch < Position)
+		{
+			auto& BeginTransitions = m_BarrierBatches[Pending.BeginBatch].Transitions;
+			Ref.BeginBatch = Pending.BeginBatch;
+			Ref.BeginIndex = static_cast<uint32_t>(BeginTransitions.size());
+			auto& BeginTransition = BeginTransitions.emplace_back(Transition);
+			BeginTransition.Flags = BeginTransition.Flags | ERHITransitionFlags::BeginOnly;
+
+			Transition.Flags = Transition.Flags | ERHITransitionFlags::EndOnly;
+		}
+
+		auto& Transitions = m_BarrierBatches[Position].Transitions;
+		Ref.Batch = Position;
+		Ref.Index = static_cast<uint32_t>(Transitions.size());
+		Transitions.emplace_back(Transition);
+
+		ForEachSubresource(Physical, Range, [&](uint32_t, uint32_t, uint32_t Index) {
+			auto& State = Physical.Subresources[Index];
+			State.State = Pending.DstState;
+			State.LastTransition = Ref;
+			State.Queue = Transition.DstQueue;
+		});
+	};
+
+	/// Final accesses restore the permanent state exactly, they neither skip into a wider read state nor widen earlier transitions.
+	/// Moving to the other queue always takes a transition and a wait, the queue ownership of content which stays valid is transferred.
+	auto Access = [&](const RDGResource& Resource, const RHISubresource& Subresource, ERHIResourceState State, bool Writes, uint32_t Position, bool Final) {
+		auto& Physical = GetPhysicalResource(Resource);
+		const auto Range = ResolveSubresource(Physical, Subresource);
+		const auto Queue = GetQueue(Position);
+
+		PendingTransitions.clear();
+		std::vector<TransitionRef> Widened;
+
+		ForEachSubresource(Physical, Range, [&](uint32_t Mip, uint32_t Layer, uint32_t Index) {
+			auto& Current = Physical.Subresources[Index];
+			const bool Discard = Current.Owner != Resource.GetID();
+			const bool SamePass = !Discard && Current.LastPass == static_cast<int32_t>(Position);
+			const bool CrossQueue = Current.Queue != Queue;
+
+			/// Declarations of one pass overlapping each other, the subresource is in all their states at once.
+			const auto NeededState = SamePass ? (Current.State | State) : State;
+
+			const bool Covered = Current.State != ERHIResourceState::Unknown && (Current.State & NeededState) == NeededState;
+			if (!Discard && !Final && !CrossQueue && Covered && (SamePass || (!Writes && IsReadOnlyState(Current.State))))
+			{
+				Current.LastPass = static_cast<int32_t>(Position);
+				return;
+			}
+
+			if (!Discard && Final && !CrossQueue && Current.State == NeededState)
+			{
+				return;
+			}
+
+			const auto& Ref = Current.LastTransition;
+			if (!Discard && !Final && !CrossQueue && Ref.IsValid() &&
+				((SamePass && Ref.Batch == Position) || (!Writes && IsReadOnlyState(Current.State) && IsReadOnlyState(NeededState))))
+			{
+				if (std::find(Widened.begin(), Widened.end(), Ref) != Widened.end() || TryWiden(Physical, Ref, NeededState))
+				{
+					Widened.push_back(Ref);
+					Current.LastPass = static_cast<int32_t>(Position);
+					return;
+				}
+			}
+
+			if (CrossQueue)
+			{
+				SyncEdges.emplace_back(Current.LastPass, static_cast<int32_t>(Position));
+
+				/// Content nobody keeps needs no ownership transfer, nor a source scope on a queue the transition is not recorded on.
+				const bool KeepsContent = !Discard && Current.State != ERHIResourceState::Unknown;
+
+				auto& Pending = PendingTransitions.emplace_back();
+				Pending.Mip = Mip;
+				Pending.Layer = Layer;
+				Pending.SrcState = KeepsContent ? Current.State : ERHIResourceState::Unknown;
+				Pending.DstState = NeededState;
+				Pending.BeginBatch = Position;
+				Pending.Discard = Discard;
+				Pending.SrcQueue = KeepsContent ? Current.Queue : Queue;
+				Pending.Release = KeepsContent;
+				Pending.ReleasePosition = KeepsContent ? Current.LastPass : -1;
+			}
+			else
+			{
+				/// Nothing to wait for before the first use of fresh memory, otherwise the transition may start right after the last use.
+				const uint32_t BeginBatch = Current.LastPass + 1 < static_cast<int32_t>(Position) ?
+					NextOnQueue[Queue == ERHIDeviceQueue::Compute ? 1u : 0u][static_cast<uint32_t>(Current.LastPass + 1)] : Position;
+				const bool HasSlack = SplitBarriers && Current.State != ERHIResourceState::Unknown && BeginBatch < Position;
+
+				auto& Pending = PendingTransitions.emplace_back();
+				Pending.Mip = Mip;
+				Pending.Layer = Layer;
+				Pending.SrcState = Current.State;
+				Pending.DstState = NeededState;
+				Pending.BeginBatch = HasSlack ? BeginBatch : Position;
+				Pending.Discard = Discard;
+				Pending.SrcQueue = Queue;
+			}
+
+			Current.Owner = Resource.GetID();
+			Current.LastPass = static_cast<int32_t>(Position);
+		});
+
+		if (PendingTransitions.empty())
+		{
+			return;
+		}
+
+		const bool Batchable = PendingTransitions.size() == static_cast<size_t>(Range.NumMips) * Range.NumLayers &&
+			std::all_of(PendingTransitions.begin(), PendingTransitions.end(), [&](const PendingTransition& Pending) {
+				return Pending.IsBatchableWith(PendingTransitions.front());
+			});
+
+		if (Batchable)
+		{
+			AddTransition(Physical, Resource, Range, PendingTransitions.front(), Position);
+			return;
+		}
+
+		for (const auto& Pending : PendingTransitions)
+		{
+			AddTransition(Physical, Resource, RHISubresource{ static_cast<uint16_t>(Pending.Mip), 1u, static_cast<uint16_t>(Pending.Layer), 1u }, Pending, Position);
+		}
+	};
+
+	for (uint32_t Position = 0u; Position < NumPositions; ++Position)
+	{
+		const auto& Pass = *m_Passes[m_PassOrder[Position].GetIndex()];
+
+		for (auto& TextureState : Pass.m_TextureStates)
+		{
+			const bool Writes = EnumHasAnyFlags(TextureState.Access, ERDGAccess::Write) || !IsReadOnlyState(TextureState.State);
+			Access(*TextureState.Texture, TextureState.Subresource, TextureState.State, Writes, Position, false);
+		}
+
+		for (auto& BufferState : Pass.m_BufferStates)
+		{
+			const bool Writes = EnumHasAnyFlags(BufferState.Access, ERDGAccess::Write) || !IsReadOnlyState(BufferState.State);
+			Access(*BufferState.Buffer, RHI::AllSubresource, BufferState.State, Writes, Position, false);
+		}
+	}
+
+	/// Whoever uses imported and extracted resources after the graph expects them in the state they were in before, or were created in.
+	for (auto& Resource : m_Resources)
+	{
+		if ((!Resource->IsImported() && !Resource->IsExtracted()) || !Resource->GetLifetime().IsUsed())
+		{
+			continue;
+		}
+
+		const auto FinalState = GetExternalState(*Resource);
+		if (FinalState != ERHIResourceState::Unknown)
+		{
+			Access(*Resource, RHI::AllSubresource, FinalState, false, NumPositions, true);
+		}
+	}
+
+	size_t NumTransitions = 0u, NumBarriers = 0u;
+	for (const auto& Batch : m_BarrierBatches)
+	{
+		NumTransitions += Batch.Transitions.size();
+		NumBarriers += Batch.Transitions.empty() ? 0u : 1u;
+	}
+
+	NumTransitions += m_PrologueSchedule.Releases.Transitions.size();
+	NumBarriers += m_PrologueSchedule.Releases.Transitions.empty() ? 0u : 1u;
+	for (const auto& Schedule : m_PassSchedule)
+	{
+		NumTransitions += Schedule.Releases.Transitions.size();
+		NumBarriers += Schedule.Releases.Transitions.empty() ? 0u : 1u;
+	}
+
+	if (NumTransitions)
+	{
+		LOG_DEBUG(LogRenderGraph, "{} transitions in {} barriers for {} render passes.", NumTransitions, NumBarriers, NumPositions);
+	}
 }
 
-void RDGRenderGraph::Compile()
+void RDGRenderGraph::PlanSynchronization(std::vector<RDGSyncEdge>& SyncEdges)
 {
+	const int32_t NumPositions = static_cast<int32_t>(m_PassOrder.size());
+
+	auto GetQueue = [this, NumPositions](int32_t Position) {
+		return Position >= 0 && Position < NumPositions ? m_PassSchedule[Position].Queue : ERHIDeviceQueue::Graphics;
+	};
+
+	int32_t LastComputePosition = -1;
+	std::vector<int32_t> Positions(m_Passes.size(), -1);
+	for (int32_t Position = 0; Position < NumPositions; ++Position)
+	{
+		Positions[m_PassOrder[Position].GetIndex()] = Position;
+		if (GetQueue(Position) == ERHIDeviceQueue::Compute)
+		{
+			LastComputePosition = Position;
+		}
+	}
+
+	if (LastComputePosition < 0)
+	{
+		return;
+	}
+
+	/// Dependencies no resource expresses need the queues to wait for each other as well, and the graphics queue joins the compute queue
+	/// before the epilogue, whatever the compute queue did last must be complete when the frame is.
+	for (int32_t Position = 0; Position < NumPositions; ++Position)
+	{
+		for (auto Successor : m_Passes[m_PassOrder[Position].GetIndex()]->GetSuccessors())
+		{
+			const int32_t SuccessorPosition = Positions[Successor.GetIndex()];
+			if (SuccessorPosition >= 0 && GetQueue(SuccessorPosition) != GetQueue(Position))
+			{
+				SyncEdges.emplace_back(Position, SuccessorPosition);
+			}
+		}
+	}
+	SyncEdges.emplace_back(LastComputePosition, NumPositions);
+
+	std::sort(SyncEdges.begin(), SyncEdges.end(), [](const RDGSyncEdge& Left, const RDGSyncEdge& Right) {
+		return Left.second != Right.second ? Left.second < Right.second : Left.first > Right.first;
+	});
+
+	/// Queues execute in order, so waiting for a position waits for every earlier one of that queue too. Going through the waiting
+	/// positions in order, a queue only waits for the latest position an edge needs, and only if it did not wait for a later one already.
+	int32_t Waited[2] = { -2, -2 };
+	std::vector<std::pair<int32_t, int32_t>> Waits;
+	std::vector<bool> Signaled(NumPositions + 2u, false);
+
+	for (size_t Index = 0u; Index < SyncEdges.size(); ++Index)
+	{
+		const auto [From, To] = SyncEdges[Index];
+		if (Index > 0u && SyncEdges[Index - 1u].second == To)
+		{
+			continue;
+		}
+
+		assert(From < To && GetQueue(From) != GetQueue(To));
+
+		auto& QueueWaited = Waited[GetQueue(To) == ERHIDeviceQueue::Compute ? 1u : 0u];
+		if (From > QueueWaited)
+		{
+			QueueWaited = From;
+			Waits.emplace_back(From, To);
+			Signaled[From + 1] = true;
+		}
+	}
+
+	/// Signal values count up per queue in pass order, the prologue signals first.
+	std::vector<uint64_t> SignalValues(NumPositions + 2u, 0u);
+	uint64_t NumSignals[2] = { 0u, 0u };
+	for (int32_t Position = -1; Position < NumPositions; ++Position)
+	{
+		if (Signaled[Position + 1])
+		{
+			SignalValues[Position + 1] = ++NumSignals[GetQueue(Position) == ERHIDeviceQueue::Compute ? 1u : 0u];
+			(Position < 0 ? m_PrologueSchedule : m_PassSchedule[Position]).SignalValue = SignalValues[Position + 1];
+		}
+	}
+
+	for (const auto& [From, To] : Waits)
+	{
+		m_PassSchedule[To].WaitValue = SignalValues[From + 1];
+	}
+
+	LOG_DEBUG(LogRenderGraph, "{} of {} render passes on the async compute queue, {} waits between the queues.",
+		std::count_if(m_PassSchedule.begin(), m_PassSchedule.end(), [](const RDGPassSchedule& Schedule) {
+			return Schedule.Queue == ERHIDeviceQueue::Compute;
+		}), NumPositions, Waits.size());
 }
@@ -3,28 +3,292 @@
 #include "Rendering/RenderGraph/RenderPass.h"
 #include "Rendering/RenderGraph/RenderPassParameters.h"
 
+DECLARE_LOG_CATEGOTY(LogRenderGraph);
+
+/// Transient resources sharing one pooled RHI resource, their lifetimes never overlap.
+struct RDGAliasingGroup
+{
+	RDGResource::EType Type = RDGResource::EType::Texture;
+
+	/// See RDGRenderTargetPool::ComputeKey, every member has the same.
+	size_t Key = 0u;
+
+	/// Of the largest member.
+	size_t Size = 0u;
+
+	/// In pass order.
+	std::vector<RDGResourceID> Resources;
+
+	/// Acquired from RDGRenderTargetPool while the graph executes.
+	RHIResourcePtr RHIResource;
+};
+
+struct RDGTransientMemoryStats
+{
+	uint32_t NumResources = 0u;
+	uint32_t NumAliasingGroups = 0u;
+
+	/// Every transient resource in memory of its own.
+	size_t UnaliasedSize = 0u;
+
+	/// What the aliasing groups allocate.
+	size_t AliasedSize = 0u;
+
+	/// The most transient memory in use by the passes at any one time, the bound no aliasing can go below.
+	size_t PeakLiveSize = 0u;
+};
+
+struct RDGCompileStats
+{
+	/// Compiles which found the graph in the shape of the previous one and reused its plan.
+	uint64_t NumCacheHits = 0u;
+	uint64_t NumCacheMisses = 0u;
+
+	/// Milliseconds of the last compile which had to plan from scratch.
+	float FullCompileTime = 0.0f;
+
+	/// Milliseconds of the last compile, only hashing and restoring on a hit.
+	float CompileTime = 0.0f;
+
+	/// FullCompileTime minus CompileTime on a hit, zero on a miss.
+	float SavedTime = 0.0f;
+};
+
+/// A state change planned by the graph, of a range of texture subresources or of a whole buffer.
+struct RDGTransition
+{
+	RDGResourceID Resource;
+	RHISubresource Subresource;
+
+	ERHIResourceState SrcState = ERHIResourceState::Unknown;
+	ERHIResourceState DstState = ERHIResourceState::Unknown;
+
+	/// Differ for queue ownership transfers, which come as a BeginOnly release on the source queue and an EndOnly acquire on the other.
+	ERHIDeviceQueue SrcQueue = ERHIDeviceQueue::Graphics;
+	ERHIDeviceQueue DstQueue = ERHIDeviceQueue::Graphics;
+
+	/// Split transitions come as a BeginOnly half right after the last use of the source state and an EndOnly half before the first use
+	/// of the destination state. Discard marks the first use of memory whose content belongs to nobody or to another aliased resource.
+	ERHITransitionFlags Flags = ERHITransitionFlags::None;
+};
+
+/// The transitions between two passes, issued as one barrier.
+struct RDGBarrierBatch
+{
+	std::vector<RDGTransition> Transitions;
+};
+
+/// Where a pass executes and how its queue synchronizes with the other one. Timeline values count from the start of the frame, the graph
+/// adds the values the timelines of the contexts had reached before it executed.
+struct RDGPassSchedule
+{
+	ERHIDeviceQueue Queue = ERHIDeviceQueue::Graphics;
+
+	/// Before the pass, its queue waits for the timeline of the other queue to reach this value. Zero for no wait.
+	uint64_t WaitValue = 0u;
+
+	/// After the pass and its releases, its queue signals this value on its own timeline. Zero for no signal.
+	uint64_t SignalValue = 0u;
+
+	/// Queue ownership releases issued right after the pass, of resources the other queue uses next.
+	RDGBarrierBatch Releases;
+};
+
+/// Frame graph of lambda passes. Passes declare the resources they read and write, Compile derives the producer/consumer edges from
+/// these declarations in recording order, orders the passes topologically and culls every pass whose output never reaches an imported
+/// or extracted resource. Compile never touches the RHI, graphs can be built and compiled without a device.
+/// Transient resources, neither imported nor extracted, only get RHI memory while the graph executes: Compile groups those whose lifetimes
+/// do not overlap and whose descriptions are compatible, and every group is backed by a single resource of RDGRenderTargetPool.
+/// Compile also plans the transitions from the declared states, per subresource, so passes never issue barriers themselves.
+/// A graph kept alive across frames and Reset each frame caches its plan: as long as the passes, their declarations and the resource
+/// descriptions hash the same as last time, Compile restores the pass order, culling, aliasing and barriers instead of planning again.
+/// Given a compute context of its own, AsyncCompute passes which do not raster run on the compute queue, overlapping the graphics work they
+/// do not depend on. The queues then only wait for each other where a resource or a dependency crosses over, see GetPassSchedule.
+/// Execute may record on task workers, see RenderSettings::EnableAsyncCommandlistSubmission and EnableAsyncMeshDrawCommandsBuilding,
+/// pass lambdas must then be safe to run concurrently with each other unless flagged NoAsyncExecute.
 class RDGRenderGraph
 {
 public:
-	RDGRenderGraph(const struct RenderSettings& Settings);
+	/// Transient resources come from Pool, whose device also tells whether async compute can be scheduled.
+	RDGRenderGraph(const struct RenderSettings& Settings, class RDGRenderTargetPool& Pool);
 
 	template<class LAMBDA>
-	std::shared_ptr<RDGRenderPass> AddPass(RDGEvent&& Event, ERDGPassFlags Flags, LAMBDA&& Lambda)
+	RDGRenderPass& AddPass(RDGEvent&& Event, ERDGPassFlags Flags, LAMBDA&& Lambda)
 	{
-		using RDGPassType = RDGLambdaRenderPass<LAMBDA>;
+		using RDGPassType = RDGLambdaRenderPass<std::decay_t<LAMBDA>>;
 
-		return m_Passes.emplace_back(std::make_shared<RDGPassType>(std::forward<RDGEvent>(Event), Flags, std::forward<LAMBDA>(Lambda)));
+		const RDGPassID ID(static_cast<RDGPassID::IndexType>(m_Passes.size()));
+		return *m_Passes.emplace_back(std::make_unique<RDGPassType>(ID, std::forward<RDGEvent>(Event), Flags, std::forward<LAMBDA>(Lambda)));
 	}
 
-	void Execute();
+	/// A pass of NumWorkItems independent work items, e.g. draws. The lambda takes the command buffer and a range [Begin, End) of items to
+	/// record, the graph hands out the whole range at once or splits it across command buffers recorded in parallel. Every range starts
+	/// in a command buffer of its own and inherits no state from the previous one.
+	template<class LAMBDA>
+	RDGRenderPass& AddParallelPass(RDGEvent&& Event, ERDGPassFlags Flags, uint32_t NumWorkItems, LAMBDA&& Lambda)
+	{
+		using RDGPassType = RDGParallelLambdaRenderPass<std::decay_t<LAMBDA>>;
+
+		const RDGPassID ID(static_cast<RDGPassID::IndexType>(m_Passes.size()));
+		return *m_Passes.emplace_back(std::make_unique<RDGPassType>(ID, std::forward<RDGEvent>(Event), Flags, NumWorkItems, std::forward<LAMBDA>(Lambda)));
+	}
+
+	/// Orders Consumer after Producer and keeps Producer alive as long as Consumer is, for dependencies no declared resource expresses.
+	void AddPassDependency(const RDGRenderPass& Producer, const RDGRenderPass& Consumer);
+
+	/// Compiles the graph and records the surviving passes and their transitions in order into the graphics command buffer of Context.
+	/// Recorded in parallel, the passes go to secondary command buffers of the per thread pools of Context, which the graphics command
+	/// buffer then executes in pass order. Async compute passes go to AsyncComputeContext instead, if given, not Context itself and the
+	/// device supports timeline semaphores, otherwise they run on the graphics queue.
+	void Execute(RHICommandListContext& Context, RHICommandListContext* AsyncComputeContext = nullptr);
+
+	/// Returns false on cycles and on reads of resources no pass wrote before, the graph is not executable then. Without
+	/// AsyncComputeQueue, or with cvar rdg.async_compute off, every pass is scheduled on the graphics queue.
+	bool Compile(bool AsyncComputeQueue = false);
+
+	/// Drops the passes and resources for the next frame to add its own, the compiled plan stays for Compile to reuse.
+	void Reset();
+
+	/// Everything the compiled plan depends on: the passes with their flags and declarations, the explicit dependencies and the
+	/// descriptions, import and extraction of the resources. The pass lambdas and the RHI resources bound at execution are left out.
+	size_t ComputeShapeHash() const;
 
 	RDGTexture* CreateTexture(const RHITextureDesc& Desc);
 	RDGBuffer* CreateBuffer(const RHIBufferDesc& Desc);
 
+	/// Resources owned outside the graph, their content is valid when the frame starts.
+	RDGTexture* RegisterExternalTexture(const RHITexturePtr& Texture, const RHITextureDesc& Desc);
+	RDGBuffer* RegisterExternalBuffer(const RHIBufferPtr& Buffer, const RHIBufferDesc& Desc);
+
+	/// Hands the RHI resource out of the graph once executed, the passes writing it survive culling.
+	void ExtractTexture(RDGTexture* Texture, RHITexturePtr& OutTexture);
+	void ExtractBuffer(RDGBuffer* Buffer, RHIBufferPtr& OutBuffer);
+
+	inline bool IsCompiled() const { return m_Compiled; }
+
+	inline const std::vector<std::unique_ptr<RDGRenderPass>>& GetPasses() const { return m_Passes; }
+	inline const std::vector<std::unique_ptr<RDGResource>>& GetResources() const { return m_Resources; }
+
+	/// The passes to execute in order, culled passes are left out. Valid after Compile.
+	inline const std::vector<RDGPassID>& GetPassOrder() const { return m_PassOrder; }
+
+	inline const RDGRenderPass& GetPass(RDGPassID ID) const { return *m_Passes[ID.GetIndex()]; }
+
+	/// Valid after Compile.
+	inline const std::vector<RDGAliasingGroup>& GetAliasingGroups() const { return m_AliasingGroups; }
+	inline const RDGTransientMemoryStats& GetTransientMemoryStats() const { return m_TransientMemoryStats; }
+
+	/// One batch more than passes in GetPassOrder, batch N is issued before the N-th pass and the last one after all passes, returning
+	/// imported and extracted resources to their permanent states. Valid after Compile.
+	inline const std::vector<RDGBarrierBatch>& GetBarrierBatches() const { return m_BarrierBatches; }
+
+	/// One schedule more than passes in GetPassOrder, like the barrier batches. The last one is the graphics queue after all passes, it
+	/// waits for the compute queue to finish before the final barrier batch. Valid after Compile.
+	inline const std::vector<RDGPassSchedule>& GetPassSchedule() const { return m_PassSchedule; }
+
+	/// The graphics queue before the first pass: releases of resources the compute queue uses first, and the signal it waits for.
+	inline const RDGPassSchedule& GetPrologueSchedule() const { return m_PrologueSchedule; }
+
+	inline const RDGCompileStats& GetCompileStats() const { return m_CompileStats; }
+
+	/// Milliseconds recording each pass of GetPassOrder took in the last Execute, summed over the command buffers a parallel pass was
+	/// split across.
+	inline const std::vector<float>& GetPassCpuTimes() const { return m_PassCpuTimes; }
+
+	/// Those added by AddPassDependency, as producer and consumer.
+	inline const std::vector<std::pair<RDGPassID, RDGPassID>>& GetPassDependencies() const { return m_PassDependencies; }
+
 	const struct RenderSettings& GetRenderSettings() const { return m_Settings; }
+
+	inline class RDGRenderTargetPool& GetRenderTargetPool() const { return m_Pool; }
 private:
-	void Compile();
+	template<class Resource, class... Args>
+	Resource* AllocateResource(Args&&... InArgs)
+	{
+		const RDGResourceID ID(static_cast<RDGResourceID::IndexType>(m_Resources.size()));
+		return static_cast<Resource*>(m_Resources.emplace_back(std::make_unique<Resource>(ID, std::forward<Args>(InArgs)...)).get());
+	}
+
+	bool CompileFromScratch(bool AsyncComputeQueue);
+	void SaveCompiledShape(size_t ShapeHash);
+	bool RestoreCompiledShape(size_t ShapeHash);
+
+	bool BuildDependencies();
+	bool SortPasses();
+	void CullPasses();
+	void AssignQueues(bool AsyncComputeQueue);
+	void PlanTransientResources();
+
+	/// A position of the pass order to wait for a position on the other queue, -1 for the prologue and the pass count for the epilogue.
+	using RDGSyncEdge = std::pair<int32_t, int32_t>;
+
+	void PlanBarriers(std::vector<RDGSyncEdge>& SyncEdges);
+	void PlanSynchronization(std::vector<RDGSyncEdge>& SyncEdges);
+
+	void AllocateResources();
+	void ReleaseResources();
+
+	/// See cvar rdg.export.
+	void ExportIfRequested() const;
+	void IssueBarriers(RHICommandBuffer& CommandBuffer, const RDGBarrierBatch& Batch) const;
+
+	/// Consecutive passes [PositionBegin, PositionEnd) of the pass order, or the work items [WorkItemBegin, WorkItemEnd) of a single
+	/// pass split into several jobs, recorded into one command buffer.
+	struct RecordingJob
+	{
+		uint32_t PositionBegin = 0u;
+		uint32_t PositionEnd = 0u;
+
+		bool Ranged = false;
+		uint32_t WorkItemBegin = 0u;
+		uint32_t WorkItemEnd = 0u;
+
+		/// NoAsyncExecute passes are recorded on the thread executing the graph.
+		bool OnExecutingThread = false;
+
+		/// Spent recording the work items of a ranged job, the graph adds it to the pass once all jobs are recorded.
+		float CpuTime = 0.0f;
+
+		RHICommandBuffer* CommandBuffer = nullptr;
+	};
+
+	void BuildRecordingJobs(std::vector<RecordingJob>& Jobs) const;
+	void RecordJob(RHICommandBuffer& CommandBuffer, RecordingJob& Job);
+
+	/// A queue waits before the first position of a job only and signals after the last one only.
+	bool IsJobBoundary(uint32_t Position) const;
+
+	std::vector<std::unique_ptr<RDGRenderPass>> m_Passes;
+	std::vector<std::unique_ptr<RDGResource>> m_Resources;
+	std::vector<std::pair<RDGPassID, RDGPassID>> m_PassDependencies;
+	std::vector<std::pair<RDGTexture*, RHITexturePtr*>> m_TextureExtractions;
+	std::vector<std::pair<RDGBuffer*, RHIBufferPtr*>> m_BufferExtractions;
+
+	std::vector<RDGPassID> m_PassOrder;
+	std::vector<RDGAliasingGroup> m_AliasingGroups;
+	RDGTransientMemoryStats m_TransientMemoryStats;
+	std::vector<RDGBarrierBatch> m_BarrierBatches;
+	std::vector<RDGPassSchedule> m_PassSchedule;
+	RDGPassSchedule m_PrologueSchedule;
+	std::vector<float> m_PassCpuTimes;
+	bool m_Compiled = false;
+
+	/// What Compile stored in the passes and resources themselves, they do not survive Reset.
+	struct CompiledShape
+	{
+		size_t Hash = 0u;
+		bool Valid = false;
+
+		std::vector<std::vector<RDGPassID>> Producers;
+		std::vector<std::vector<RDGPassID>> Successors;
+		std::vector<bool> Culled;
+
+		std::vector<RDGResourceLifetime> Lifetimes;
+		std::vector<uint32_t> AliasingGroups;
+	};
+	CompiledShape m_CompiledShape;
+	RDGCompileStats m_CompileStats;
 
-	std::vector<std::shared_ptr<RDGRenderPass>> m_Passes;
 	const struct RenderSettings& m_Settings;
-};
\ No newline at end of file
+	class RDGRenderTargetPool& m_Pool;
+};
@@ -0,0 +1,483 @@
+#include "Rendering/RenderGraph/RenderGraphExporter.h"
+#include "Services/SpdLogService.h"
+
+static std::string Escape(std::string_view Text)
+{
+	std::string Escaped;
+	Escaped.reserve(Text.size());
+
+	for (const char Char : Text)
+	{
+		if (Char == '"' || Char == '\\')
+		{
+			Escaped += '\\';
+			Escaped += Char;
+		}
+		else if (Char == '\n')
+		{
+			Escaped += "\\n";
+		}
+		else if (static_cast<unsigned char>(Char) >= 0x20u)
+		{
+			Escaped += Char;
+		}
+	}
+
+	return Escaped;
+}
+
+static std::string GetStateName(ERHIResourceState State)
+{
+	switch (State)
+	{
+	case ERHIResourceState::Unknown:
+		return "Unknown";
+	case ERHIResourceState::Common:
+		return "Common";
+	default:
+		return std::string(magic_enum::enum_flags_name(State));
+	}
+}
+
+template<class Enum>
+static std::string GetFlagsName(Enum Flags)
+{
+	return Flags == Enum::None ? std::string("None") : std::string(magic_enum::enum_flags_name(Flags));
+}
+
+static std::string FormatSize(size_t Size)
+{
+	return Size >= Megabyte ? fmt::format("{:.2f} MB", static_cast<double>(Size) / Megabyte) : fmt::format("{:.2f} KB", static_cast<double>(Size) / 1024.0);
+}
+
+template<class Container, class Function>
+static std::string JoinJsonArray(const Container& Items, Function&& ToJson)
+{
+	std::string Joined = "[";
+	for (const auto& Item : Items)
+	{
+		Joined += Joined.size() > 1u ? ", " : "";
+		Joined += ToJson(Item);
+	}
+	return Joined + "]";
+}
+
+static std::string ToJsonSubresource(const RHISubresource& Subresource)
+{
+	if (Subresource == RHI::AllSubresource)
+	{
+		return "null";
+	}
+
+	return fmt::format("{{\"mip\": {}, \"mips\": {}, \"layer\": {}, \"layers\": {}}}",
+		Subresource.BaseMipLevel, Subresource.NumMips, Subresource.BaseArrayLayer, Subresource.NumLayers);
+}
+
+static size_t ComputeMemorySize(const RDGResource& Resource)
+{
+	return Resource.GetType() == RDGResource::EType::Texture ?
+		static_cast<const RDGTexture&>(Resource).ComputeMemorySize() : static_cast<const RDGBuffer&>(Resource).ComputeMemorySize();
+}
+
+static std::string GetDescription(const RDGResource& Resource)
+{
+	if (Resource.GetType() == RDGResource::EType::Texture)
+	{
+		const auto& Desc = static_cast<const RDGTexture&>(Resource).GetDesc();
+		return fmt::format("{}x{}x{}, {} mips, {} layers, {}", Desc.Width, Desc.Height, Desc.Depth, Desc.NumMipLevel, Desc.NumArrayLayer,
+			magic_enum::enum_name(Desc.Format));
+	}
+
+	return fmt::format("{} bytes", static_cast<const RDGBuffer&>(Resource).GetDesc().Size);
+}
+
+/// Pass order positions by pass ID, -1 for culled passes.
+static std::vector<int32_t> GetPassPositions(const RDGRenderGraph& Graph)
+{
+	std::vector<int32_t> Positions(Graph.GetPasses().size(), -1);
+
+	const auto& PassOrder = Graph.GetPassOrder();
+	for (size_t Position = 0u; Position < PassOrder.size(); ++Position)
+	{
+		Positions[PassOrder[Position].GetIndex()] = static_cast<int32_t>(Position);
+	}
+
+	return Positions;
+}
+
+/// The pass order position signaling Value on Queue, -1 for the prologue and -2 if nothing does.
+static int32_t FindSignal(const RDGRenderGraph& Graph, ERHIDeviceQueue Queue, uint64_t Value)
+{
+	if (Queue == ERHIDeviceQueue::Graphics && Graph.GetPrologueSchedule().SignalValue == Value)
+	{
+		return -1;
+	}
+
+	const auto& Schedule = Graph.GetPassSchedule();
+	for (size_t Position = 0u; Position + 1u < Schedule.size(); ++Position)
+	{
+		if (Schedule[Position].Queue == Queue && Schedule[Position].SignalValue == Value)
+		{
+			return static_cast<int32_t>(Position);
+		}
+	}
+
+	return -2;
+}
+
+std::string RDGGraphExporter::ToDot(const RDGRenderGraph& Graph, bool IncludeTimings)
+{
+	const auto Positions = GetPassPositions(Graph);
+	const auto& PassOrder = Graph.GetPassOrder();
+	const auto& Schedule = Graph.GetPassSchedule();
+	const auto& BarrierBatches = Graph.GetBarrierBatches();
+	const auto& CpuTimes = Graph.GetPassCpuTimes();
+	const bool Compiled = Schedule.size() == PassOrder.size() + 1u && BarrierBatches.size() == PassOrder.size() + 1u;
+
+	std::string Dot = "digraph RenderGraph\n{\n";
+	Dot += "\trankdir=LR;\n";
+	Dot += "\tnode [fontname=\"Helvetica\", fontsize=10];\n";
+	Dot += "\tedge [fontname=\"Helvetica\", fontsize=9];\n\n";
+
+	/// Graphics passes blue, compute queue passes orange, culled passes grey and dashed.
+	for (const auto& Pass : Graph.GetPasses())
+	{
+		const int32_t Position = Positions[Pass->GetID().GetIndex()];
+
+		std::string Label;
+		const char* Style = "filled";
+		const char* Color = "#9ecae1";
+
+		if (Position < 0)
+		{
+			Label = fmt::format("culled: {}\\n{}", Escape(Pass->GetEvent().Name.Get()), GetFlagsName(Pass->GetFlags()));
+			Style = "filled,dashed";
+			Color = "#d9d9d9";
+		}
+		else
+		{
+			Label = fmt::format("{}: {}\\n{}", Position, Escape(Pass->GetEvent().Name.Get()), GetFlagsName(Pass->GetFlags()));
+
+			if (Compiled)
+			{
+				const auto& PassSchedule = Schedule[Position];
+				if (PassSchedule.Queue == ERHIDeviceQueue::Compute)
+				{
+					Color = "#fdae6b";
+				}
+
+				const size_t NumTransitions = BarrierBatches[Position].Transitions.size() + PassSchedule.Releases.Transitions.size();
+				if (NumTransitions)
+				{
+					Label += fmt::format("\\n{} transitions", NumTransitions);
+				}
+			}
+
+			if (Pass->GetNumWorkItems())
+			{
+				Label += fmt::format("\\n{} work items", Pass->GetNumWorkItems());
+			}
+
+			if (IncludeTimings && static_cast<size_t>(Position) < CpuTimes.size())
+			{
+				Label += fmt::format("\\n{:.3f} ms", CpuTimes[Position]);
+			}
+		}
+
+		Dot += fmt::format("\tPass{} [shape=box, style=\"{}\", fillcolor=\"{}\", label=\"{}\"];\n", Pass->GetID().GetIndex(), Style, Color, Label);
+	}
+
+	const auto& Prologue = Graph.GetPrologueSchedule();
+	if (Prologue.SignalValue || !Prologue.Releases.Transitions.empty())
+	{
+		Dot += fmt::format("\tPrologue [shape=box, style=rounded, label=\"Prologue\\n{} releases\"];\n", Prologue.Releases.Transitions.size());
+	}
+
+	if (Compiled)
+	{
+		Dot += fmt::format("\tEpilogue [shape=box, style=rounded, label=\"Epilogue\\n{} transitions\"];\n", BarrierBatches.back().Transitions.size());
+	}
+	Dot += "\n";
+
+	auto AppendResource = [&Dot](const RDGResource& Resource, const char* Indent) {
+		const auto& Lifetime = Resource.GetLifetime();
+
+		std::string Label = fmt::format("{}\\n{}", Escape(Resource.GetName()), GetDescription(Resource));
+		if (Resource.IsImported())
+		{
+			Label += "\\nimported";
+		}
+		if (Resource.IsExtracted())
+		{
+			Label += "\\nextracted";
+		}
+		Label += Lifetime.IsUsed() ? fmt::format("\\npasses {} - {}", Lifetime.FirstPass, Lifetime.LastPass) : std::string("\\nunused");
+
+		Dot += fmt::format("{}Resource{} [shape={}, label=\"{}\"];\n", Indent, Resource.GetID().GetIndex(),
+			Resource.GetType() == RDGResource::EType::Texture ? "ellipse" : "cylinder", Label);
+	};
+
+	/// Resources sharing memory are drawn together.
+	const auto& AliasingGroups = Graph.GetAliasingGroups();
+	for (size_t GroupIndex = 0u; GroupIndex < AliasingGroups.size(); ++GroupIndex)
+	{
+		const auto& Group = AliasingGroups[GroupIndex];
+
+		Dot += fmt::format("\tsubgraph cluster_AliasingGroup{}\n\t{{\n", GroupIndex);
+		Dot += fmt::format("\t\tlabel=\"Aliasing group {}\\n{}\";\n\t\tstyle=dashed;\n", GroupIndex, FormatSize(Group.Size));
+		for (const auto ResourceID : Group.Resources)
+		{
+			AppendResource(*Graph.GetResources()[ResourceID.GetIndex()], "\t\t");
+		}
+		Dot += "\t}\n";
+	}
+
+	for (const auto& Resource : Graph.GetResources())
+	{
+		if (Resource->GetAliasingGroup() == RDGResource::NoAliasingGroup)
+		{
+			AppendResource(*Resource, "\t");
+		}
+	}
+	Dot += "\n";
+
+	for (const auto& Pass : Graph.GetPasses())
+	{
+		auto AppendAccess = [&Dot, &Pass](const RDGResource& Resource, ERDGAccess Access, ERHIResourceState State) {
+			if (EnumHasAnyFlags(Access, ERDGAccess::Read))
+			{
+				Dot += fmt::format("\tResource{} -> Pass{} [label=\"{}\"];\n", Resource.GetID().GetIndex(), Pass->GetID().GetIndex(), GetStateName(State));
+			}
+			if (EnumHasAnyFlags(Access, ERDGAccess::Write))
+			{
+				Dot += fmt::format("\tPass{} -> Resource{} [label=\"{}\"];\n", Pass->GetID().GetIndex(), Resource.GetID().GetIndex(), GetStateName(State));
+			}
+		};
+
+		for (const auto& TextureState : Pass->GetTextureStates())
+		{
+			AppendAccess(*TextureState.Texture, TextureState.Access, TextureState.State);
+		}
+
+		for (const auto& BufferState : Pass->GetBufferStates())
+		{
+			AppendAccess(*BufferState.Buffer, BufferState.Access, BufferState.State);
+		}
+	}
+
+	for (const auto& [Producer, Consumer] : Graph.GetPassDependencies())
+	{
+		Dot += fmt::format("\tPass{} -> Pass{} [style=dotted, label=\"dependency\"];\n", Producer.GetIndex(), Consumer.GetIndex());
+	}
+
+	/// Waits between the queues, from the signaling pass to the waiting one.
+	if (Compiled)
+	{
+		auto GetNode = [&PassOrder, &Schedule](int32_t Position) {
+			if (Position < 0)
+			{
+				return std::string("Prologue");
+			}
+			return static_cast<size_t>(Position) + 1u < Schedule.size() ? fmt::format("Pass{}", PassOrder[Position].GetIndex()) : std::string("Epilogue");
+		};
+
+		for (size_t Position = 0u; Position < Schedule.size(); ++Position)
+		{
+			const auto& PassSchedule = Schedule[Position];
+			if (!PassSchedule.WaitValue)
+			{
+				continue;
+			}
+
+			const auto SignalQueue = PassSchedule.Queue == ERHIDeviceQueue::Compute ? ERHIDeviceQueue::Graphics : ERHIDeviceQueue::Compute;
+			const int32_t SignalPosition = FindSignal(Graph, SignalQueue, PassSchedule.WaitValue);
+			if (SignalPosition > -2)
+			{
+				Dot += fmt::format("\t{} -> {} [style=bold, color=\"#e6550d\", constraint=false, label=\"wait {}\"];\n",
+					GetNode(SignalPosition), GetNode(static_cast<int32_t>(Position)), PassSchedule.WaitValue);
+			}
+		}
+	}
+
+	Dot += "}\n";
+	return Dot;
+}
+
+std::string RDGGraphExporter::ToJson(const RDGRenderGraph& Graph, bool IncludeTimings)
+{
+	const auto Positions = GetPassPositions(Graph);
+	const auto& PassOrder = Graph.GetPassOrder();
+	const auto& Schedule = Graph.GetPassSchedule();
+	const auto& BarrierBatches = Graph.GetBarrierBatches();
+	const auto& CpuTimes = Graph.GetPassCpuTimes();
+	const bool Compiled = Schedule.size() == PassOrder.size() + 1u && BarrierBatches.size() == PassOrder.size() + 1u;
+
+	auto ToJsonID = [](const auto& ID) {
+		return std::to_string(ID.GetIndex());
+	};
+
+	std::string Json = "{\n";
+
+	/// One element per line, so golden files diff line by line.
+	auto AppendArray = [&Json](const char* Name, const std::vector<std::string>& Elements, bool Last) {
+		Json += fmt::format("\t\"{}\": [", Name);
+		for (size_t Index = 0u; Index < Elements.size(); ++Index)
+		{
+			Json += Index ? ",\n\t\t" : "\n\t\t";
+			Json += Elements[Index];
+		}
+		Json += Elements.empty() ? "]" : "\n\t]";
+		Json += Last ? "\n" : ",\n";
+	};
+
+	std::vector<std::string> Elements;
+	for (const auto& Pass : Graph.GetPasses())
+	{
+		const int32_t Position = Positions[Pass->GetID().GetIndex()];
+		const bool Scheduled = Position >= 0 && Compiled;
+
+		std::string Element = fmt::format("{{\"id\": {}, \"name\": \"{}\", \"flags\": \"{}\", \"culled\": {}, \"position\": {}",
+			Pass->GetID().GetIndex(), Escape(Pass->GetEvent().Name.Get()), GetFlagsName(Pass->GetFlags()), Pass->IsCulled(),
+			Position >= 0 ? std::to_string(Position) : std::string("null"));
+
+		Element += fmt::format(", \"queue\": {}, \"wait_value\": {}, \"signal_value\": {}, \"work_items\": {}",
+			Scheduled ? fmt::format("\"{}\"", magic_enum::enum_name(Schedule[Position].Queue)) : std::string("null"),
+			Scheduled ? Schedule[Position].WaitValue : 0u,
+			Scheduled ? Schedule[Position].SignalValue : 0u,
+			Pass->GetNumWorkItems());
+
+		if (IncludeTimings)
+		{
+			Element += fmt::format(", \"cpu_ms\": {:.3f}", Position >= 0 && static_cast<size_t>(Position) < CpuTimes.size() ? CpuTimes[Position] : 0.0f);
+		}
+
+		Element += ", \"textures\": " + JoinJsonArray(Pass->GetTextureStates(), [](const RDGRenderPass::RDGTextureState& TextureState) {
+			return fmt::format("{{\"resource\": {}, \"access\": \"{}\", \"state\": \"{}\", \"subresource\": {}}}",
+				TextureState.Texture->GetID().GetIndex(), GetFlagsName(TextureState.Access), GetStateName(TextureState.State), ToJsonSubresource(TextureState.Subresource));
+		});
+
+		Element += ", \"buffers\": " + JoinJsonArray(Pass->GetBufferStates(), [](const RDGRenderPass::RDGBufferState& BufferState) {
+			return fmt::format("{{\"resource\": {}, \"access\": \"{}\", \"state\": \"{}\"}}",
+				BufferState.Buffer->GetID().GetIndex(), GetFlagsName(BufferState.Access), GetStateName(BufferState.State));
+		});
+
+		Element += ", \"producers\": " + JoinJsonArray(Pass->GetProducers(), ToJsonID);
+		Element += ", \"successors\": " + JoinJsonArray(Pass->GetSuccessors(), ToJsonID) + "}";
+
+		Elements.emplace_back(std::move(Element));
+	}
+	AppendArray("passes", Elements, false);
+
+	Elements.clear();
+	for (const auto& Resource : Graph.GetResources())
+	{
+		const auto& Lifetime = Resource->GetLifetime();
+		const uint32_t Group = Resource->GetAliasingGroup();
+
+		Elements.emplace_back(fmt::format("{{\"id\": {}, \"name\": \"{}\", \"type\": \"{}\", \"description\": \"{}\", \"imported\": {}, \"extracted\": {}, "
+			"\"size\": {}, \"first_pass\": {}, \"last_pass\": {}, \"aliasing_group\": {}}}",
+			Resource->GetID().GetIndex(),
+			Escape(Resource->GetName()),
+			magic_enum::enum_name(Resource->GetType()),
+			GetDescription(*Resource),
+			Resource->IsImported(),
+			Resource->IsExtracted(),
+			ComputeMemorySize(*Resource),
+			Lifetime.IsUsed() ? std::to_string(Lifetime.FirstPass) : std::string("null"),
+			Lifetime.IsUsed() ? std::to_string(Lifetime.LastPass) : std::string("null"),
+			Group != RDGResource::NoAliasingGroup ? std::to_string(Group) : std::string("null")));
+	}
+	AppendArray("resources", Elements, false);
+
+	Elements.clear();
+	for (const auto& Group : Graph.GetAliasingGroups())
+	{
+		Elements.emplace_back(fmt::format("{{\"type\": \"{}\", \"size\": {}, \"resources\": {}}}",
+			magic_enum::enum_name(Group.Type), Group.Size, JoinJsonArray(Group.Resources, ToJsonID)));
+	}
+	AppendArray("aliasing_groups", Elements, false);
+
+	/// In the order they are issued: the releases of the prologue, then per pass its barrier batch and its releases, then the epilogue.
+	/// Batches of passes carry their pass order position, those of the prologue and the epilogue their name instead.
+	Elements.clear();
+	auto AppendTransitions = [&Elements](const RDGBarrierBatch& Batch, const char* Kind, const std::string& Position) {
+		for (const auto& Transition : Batch.Transitions)
+		{
+			Elements.emplace_back(fmt::format("{{\"batch\": \"{}\", \"position\": {}, \"resource\": {}, \"subresource\": {}, \"src_state\": \"{}\", "
+				"\"dst_state\": \"{}\", \"src_queue\": \"{}\", \"dst_queue\": \"{}\", \"flags\": \"{}\"}}",
+				Kind,
+				Position,
+				Transition.Resource.GetIndex(),
+				ToJsonSubresource(Transition.Subresource),
+				GetStateName(Transition.SrcState),
+				GetStateName(Transition.DstState),
+				magic_enum::enum_name(Transition.SrcQueue),
+				magic_enum::enum_name(Transition.DstQueue),
+				GetFlagsName(Transition.Flags)));
+		}
+	};
+
+	if (Compiled)
+	{
+		AppendTransitions(Graph.GetPrologueSchedule().Releases, "prologue", "\"prologue\"");
+		for (size_t Position = 0u; Position < PassOrder.size(); ++Position)
+		{
+			AppendTransitions(BarrierBatches[Position], "pass", std::to_string(Position));
+			AppendTransitions(Schedule[Position].Releases, "release", std::to_string(Position));
+		}
+		AppendTransitions(BarrierBatches.back(), "epilogue", "\"epilogue\"");
+	}
+	AppendArray("transitions", Elements, false);
+
+	const auto& MemoryStats = Graph.GetTransientMemoryStats();
+	Json += fmt::format("\t\"transient_memory\": {{\"num_resources\": {}, \"num_aliasing_groups\": {}, \"unaliased_size\": {}, \"aliased_size\": {}, "
+		"\"peak_live_size\": {}}},\n",
+		MemoryStats.NumResources, MemoryStats.NumAliasingGroups, MemoryStats.UnaliasedSize, MemoryStats.AliasedSize, MemoryStats.PeakLiveSize);
+
+	Json += fmt::format("\t\"schedule\": {{\"prologue_signal_value\": {}, \"epilogue_wait_value\": {}}}",
+		Graph.GetPrologueSchedule().SignalValue, Compiled ? Schedule.back().WaitValue : 0u);
+
+	if (IncludeTimings)
+	{
+		const auto& CompileStats = Graph.GetCompileStats();
+		Json += fmt::format(",\n\t\"compile\": {{\"cache_hits\": {}, \"cache_misses\": {}, \"compile_ms\": {:.3f}, \"full_compile_ms\": {:.3f}}}",
+			CompileStats.NumCacheHits, CompileStats.NumCacheMisses, CompileStats.CompileTime, CompileStats.FullCompileTime);
+	}
+
+	Json += "\n}\n";
+	return Json;
+}
+
+bool RDGGraphExporter::Export(const RDGRenderGraph& Graph, const std::filesystem::path& BasePath)
+{
+	std::error_code ErrorCode;
+	if (BasePath.has_parent_path())
+	{
+		std::filesystem::create_directories(BasePath.parent_path(), ErrorCode);
+	}
+
+	auto Write = [](const std::filesystem::path& Path, const std::string& Text) {
+		std::ofstream Stream(Path, std::ios::trunc);
+		if (!Stream.is_open())
+		{
+			LOG_ERROR(LogRenderGraph, "Failed to create render graph export \"{}\".", Path.string());
+			return false;
+		}
+
+		Stream << Text;
+		return Stream.good();
+	};
+
+	auto DotPath = BasePath;
+	DotPath += ".dot";
+	auto JsonPath = BasePath;
+	JsonPath += ".json";
+
+	if (!Write(DotPath, ToDot(Graph)) || !Write(JsonPath, ToJson(Graph)))
+	{
+		return false;
+	}
+
+	LOG_INFO(LogRenderGraph, "Exported render graph of {} passes to \"{}\" and \"{}\".", Graph.GetPasses().size(), DotPath.string(), JsonPath.string());
+	return true;
+}
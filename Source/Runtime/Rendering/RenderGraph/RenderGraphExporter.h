@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Rendering/RenderGraph/RenderGraph.h"
+
+/// Text dumps of a compiled render graph: every pass with its declarations, queue, synchronization and CPU time, culled ones included,
+/// every resource with its lifetime and aliasing group, the transient memory, and every planned transition. Graphviz DOT is for looking
+/// at, JSON for tools and for headless tests comparing against golden files. Both list everything in ID and pass order, the same graph
+/// always gives the same text as long as the timings, of the passes and of the compile, are left out. A graph which failed to compile
+/// exports its passes, declarations and resources without any plan.
+class RDGGraphExporter
+{
+public:
+	static std::string ToDot(const RDGRenderGraph& Graph, bool IncludeTimings = true);
+	static std::string ToJson(const RDGRenderGraph& Graph, bool IncludeTimings = true);
+
+	/// Writes both next to each other, as BasePath with the extensions .dot and .json. See cvar rdg.export.
+	static bool Export(const RDGRenderGraph& Graph, const std::filesystem::path& BasePath);
+};
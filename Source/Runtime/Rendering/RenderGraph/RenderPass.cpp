@@ -43,3 +43,39 @@ RDGResource& RenderPass::AddResource(RDGResource::EType Type, const char* Name,
 {
 	return GetResourceManager().GetOrAllocateResource(Type, Name, Visibility);
 }
+
+RDGRenderPass& RDGRenderPass::AddTextureAccess(RDGTexture* Texture, ERDGAccess Access, ERHIResourceState State, const RHISubresource& Subresource)
+{
+	assert(Texture);
+
+	for (auto& TextureState : m_TextureStates)
+	{
+		if (TextureState.Texture == Texture && TextureState.Subresource == Subresource)
+		{
+			TextureState.Access = TextureState.Access | Access;
+			TextureState.State = TextureState.State | State;
+			return *this;
+		}
+	}
+
+	m_TextureStates.emplace_back(RDGTextureState{ Texture, Access, State, Subresource });
+	return *this;
+}
+
+RDGRenderPass& RDGRenderPass::AddBufferAccess(RDGBuffer* Buffer, ERDGAccess Access, ERHIResourceState State)
+{
+	assert(Buffer);
+
+	for (auto& BufferState : m_BufferStates)
+	{
+		if (BufferState.Buffer == Buffer)
+		{
+			BufferState.Access = BufferState.Access | Access;
+			BufferState.State = BufferState.State | State;
+			return *this;
+		}
+	}
+
+	m_BufferStates.emplace_back(RDGBufferState{ Buffer, Access, State });
+	return *this;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Rendering/RenderScene.h"
+#include "RHI/RHICommandBuffer.h"
+#include "Rendering/RenderGraph/RenderPassParameters.h"
 
 class RenderPass
 {
@@ -76,11 +78,26 @@ enum class ERDGPassFlags : uint16_t
 {
 	None,
 	Raster = 1 << 0,
+	Compute = 1 << 1,
+	/// Runs on the compute queue when the graph executes with a compute context of its own, unless it also rasters.
 	AsyncCompute = 1 << 2,
-	NoAsyncExecute = 1 << 3
+	/// Recorded on the thread executing the graph, never on task workers, for passes which are not safe to record concurrently.
+	NoAsyncExecute = 1 << 3,
+	NeverCull = 1 << 4
 };
 ENUM_FLAG_OPERATORS(ERDGPassFlags);
 
+enum class ERDGAccess : uint8_t
+{
+	None,
+	Read = 1 << 0,
+	Write = 1 << 1,
+	ReadWrite = Read | Write
+};
+ENUM_FLAG_OPERATORS(ERDGAccess);
+
+using RDGPassID = ObjectID<class RDGRenderPass>;
+
 struct RDGEvent
 {
 	FName Name;
@@ -101,52 +118,134 @@ class RDGRenderPass
 public:
 	struct RDGTextureState
 	{
+		RDGTexture* Texture = nullptr;
+		ERDGAccess Access = ERDGAccess::None;
+		ERHIResourceState State = ERHIResourceState::Unknown;
+		RHISubresource Subresource;
 	};
 
 	struct RDGBufferState
 	{
+		RDGBuffer* Buffer = nullptr;
+		ERDGAccess Access = ERDGAccess::None;
+		ERHIResourceState State = ERHIResourceState::Unknown;
 	};
 
-	RDGRenderPass(RDGEvent&& Event, ERDGPassFlags Flags)
-		: m_Event(std::move(Event))
+	RDGRenderPass(RDGPassID ID, RDGEvent&& Event, ERDGPassFlags Flags)
+		: m_ID(ID)
+		, m_Event(std::move(Event))
 		, m_Flags(Flags)
 	{
+		m_AllowAsyncExecute = !EnumHasAnyFlags(Flags, ERDGPassFlags::NoAsyncExecute);
 	}
 
+	virtual ~RDGRenderPass() = default;
+
+	inline RDGPassID GetID() const { return m_ID; }
 	inline RDGEvent& GetEvent() { return m_Event; }
+	inline const RDGEvent& GetEvent() const { return m_Event; }
 	inline ERDGPassFlags GetFlags() const { return m_Flags; }
 	inline bool IsAsyncCompute() const { return EnumHasAnyFlags(m_Flags, ERDGPassFlags::AsyncCompute); }
+	inline bool IsNeverCull() const { return EnumHasAnyFlags(m_Flags, ERDGPassFlags::NeverCull); }
 	inline bool IsCulled() const { return m_Culled; }
+	inline bool AllowsAsyncExecute() const { return m_AllowAsyncExecute; }
+
+	/// Of passes added by RDGRenderGraph::AddParallelPass, zero for others.
+	inline uint32_t GetNumWorkItems() const { return m_NumWorkItems; }
+
+	/// Declares what the pass does with a resource, the graph derives the pass order, culling and transitions from these alone.
+	/// Declaring a resource again merges the access and the states, textures only for the same subresources. Different subresources of
+	/// a texture may be in different states, e.g. when a pass reads one mip to write the next.
+	RDGRenderPass& ReadTexture(RDGTexture* Texture, ERHIResourceState State = ERHIResourceState::ShaderResource, const RHISubresource& Subresource = RHI::AllSubresource)
+	{
+		return AddTextureAccess(Texture, ERDGAccess::Read, State, Subresource);
+	}
+	RDGRenderPass& WriteTexture(RDGTexture* Texture, ERHIResourceState State = ERHIResourceState::RenderTarget, const RHISubresource& Subresource = RHI::AllSubresource)
+	{
+		return AddTextureAccess(Texture, ERDGAccess::Write, State, Subresource);
+	}
+	RDGRenderPass& ReadBuffer(RDGBuffer* Buffer, ERHIResourceState State = ERHIResourceState::ShaderResource) { return AddBufferAccess(Buffer, ERDGAccess::Read, State); }
+	RDGRenderPass& WriteBuffer(RDGBuffer* Buffer, ERHIResourceState State = ERHIResourceState::UnorderedAccess) { return AddBufferAccess(Buffer, ERDGAccess::Write, State); }
 
 	inline const std::vector<RDGTextureState>& GetTextureStates() const { return m_TextureStates; }
 	inline const std::vector<RDGBufferState>& GetBufferStates() const { return m_BufferStates; }
+
+	/// Passes whose output this pass consumes, valid after the graph compiled.
+	inline const std::vector<RDGPassID>& GetProducers() const { return m_Producers; }
+	/// Passes which must run after this pass, consumers as well as later writers of what it reads.
+	inline const std::vector<RDGPassID>& GetSuccessors() const { return m_Successors; }
 protected:
+	friend class RDGRenderGraph;
+
+	virtual void Execute(RHICommandBuffer& /*CommandBuffer*/) {}
 
-	virtual void Execute() {}
+	/// Records the work items [Begin, End) only, the graph may split a pass with work items across several command buffers.
+	virtual void ExecuteRange(RHICommandBuffer& CommandBuffer, uint32_t /*Begin*/, uint32_t /*End*/) { Execute(CommandBuffer); }
+
+	RDGRenderPass& AddTextureAccess(RDGTexture* Texture, ERDGAccess Access, ERHIResourceState State, const RHISubresource& Subresource);
+	RDGRenderPass& AddBufferAccess(RDGBuffer* Buffer, ERDGAccess Access, ERHIResourceState State);
 
 	bool m_AllowAsyncExecute = true;
 	bool m_Culled = false;
+	uint32_t m_NumWorkItems = 0u;
 
+	RDGPassID m_ID;
 	RDGEvent m_Event;
 	ERDGPassFlags m_Flags = ERDGPassFlags::None;
 
 	std::vector<RDGTextureState> m_TextureStates;
 	std::vector<RDGBufferState> m_BufferStates;
+
+	std::vector<RDGPassID> m_Producers;
+	std::vector<RDGPassID> m_Successors;
 };
 
 template<class LAMBDA>
 class RDGLambdaRenderPass : public RDGRenderPass
 {
 public:
-	RDGLambdaRenderPass(RDGEvent&& Event, ERDGPassFlags Flags, LAMBDA&& Lambda)
-		: RDGRenderPass(std::forward<RDGEvent>(Event), Flags)
+	RDGLambdaRenderPass(RDGPassID ID, RDGEvent&& Event, ERDGPassFlags Flags, LAMBDA Lambda)
+		: RDGRenderPass(ID, std::forward<RDGEvent>(Event), Flags)
 		, m_Lambda(std::move(Lambda))
 	{
 	}
 protected:
-	inline void Execute() override
+	/// The lambda takes the command buffer the graph records into, or nothing.
+	inline void Execute(RHICommandBuffer& CommandBuffer) override
+	{
+		if constexpr (std::is_invocable_v<LAMBDA&, RHICommandBuffer&>)
+		{
+			m_Lambda(CommandBuffer);
+		}
+		else
+		{
+			m_Lambda();
+		}
+	}
+private:
+	LAMBDA m_Lambda;
+};
+
+template<class LAMBDA>
+class RDGParallelLambdaRenderPass : public RDGRenderPass
+{
+public:
+	RDGParallelLambdaRenderPass(RDGPassID ID, RDGEvent&& Event, ERDGPassFlags Flags, uint32_t NumWorkItems, LAMBDA Lambda)
+		: RDGRenderPass(ID, std::forward<RDGEvent>(Event), Flags)
+		, m_Lambda(std::move(Lambda))
+	{
+		m_NumWorkItems = NumWorkItems;
+	}
+protected:
+	/// The lambda takes the command buffer and the range of work items to record into it.
+	inline void Execute(RHICommandBuffer& CommandBuffer) override
+	{
+		m_Lambda(CommandBuffer, 0u, m_NumWorkItems);
+	}
+
+	inline void ExecuteRange(RHICommandBuffer& CommandBuffer, uint32_t Begin, uint32_t End) override
 	{
-		m_Lambda();
+		m_Lambda(CommandBuffer, Begin, End);
 	}
 private:
 	LAMBDA m_Lambda;
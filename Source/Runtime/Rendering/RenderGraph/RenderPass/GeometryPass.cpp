@@ -5,6 +5,7 @@
 #include "Rendering/RenderScene.h"
 #include "Rendering/RenderGraph/RenderGraph.h"
 #include "Async/Task.h"
+#include "Asset/GlobalShaders.h"
 
 struct ScopeDebugMarker
 {
@@ -81,6 +82,18 @@ void MeshDrawCommandBuilder::SetupShaderParameters(RHIGraphicsPipelineDesc& Desc
 	//}
 }
 
+void MeshDrawCommandBuilder::SetupVertexDecoding(GenericVS& VertexShader, const StaticMesh& Mesh)
+{
+	const auto& Layout = Mesh.GetVertexLayout();
+
+	VertexShader.SetQuantizedPosition(Layout.Position != EPositionFormat::Float3);
+	VertexShader.SetOctahedralDirection(Layout.Direction == EDirectionFormat::Octahedral16);
+
+	auto& WVP = VertexShader.GetUniformBuffer();
+	WVP.PositionScale = Math::Vector4(Mesh.GetPositionScale(), 0.0f);
+	WVP.PositionBias = Math::Vector4(Mesh.GetPositionBias(), 0.0f);
+}
+
 RHIFrameBuffer* GeometryPass::GetFrameBuffer()
 {
 	//if (!m_FrameBuffer)
@@ -11,6 +11,9 @@ struct MeshDrawCommandBuilder
 		const class ISceneView& InView,
 		const Math::Transform& InTransform,
 		const MaterialProperty& InMaterial);
+
+	/// Selects how GenericVS decodes the mesh vertices and uploads the position dequantization, every builder drawing a mesh with GenericVS goes through here.
+	void SetupVertexDecoding(class GenericVS& VertexShader, const class StaticMesh& Mesh);
 };
 
 class GeometryPass : public RenderPass
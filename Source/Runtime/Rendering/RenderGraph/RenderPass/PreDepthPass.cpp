@@ -27,10 +27,16 @@ struct PreDepthMeshDrawCommandBuilder : public MeshDrawCommandBuilder
 		}
 		if (auto Buffer = Mesh.GetVertexBuffer(EVertexAttributes::UV0))
 		{
-			Command->VertexStream.Add(Location++, 0u, Buffer);
+			/// Interleaved vertices come in one stream that already holds UV0.
+			if (!Mesh.IsInterleaved())
+			{
+				Command->VertexStream.Add(Location++, 0u, Buffer);
+			}
 			VertexShader->SetDefine("_HAS_UV0_", true);
 		}
 
+		SetupVertexDecoding(*VertexShader, Mesh);
+
 		VertexShader->SetDefine("_HAS_NORMAL_", false);
 
 		Desc.SetShader(VertexShader)
@@ -2,6 +2,21 @@
 #include "Rendering/RenderGraph/RenderGraph.h"
 #include "RHI/RHISwapchain.h"
 
+size_t RDGTexture::ComputeMemorySize(const RHITextureDesc& Desc)
+{
+	size_t Size = 0u;
+	for (uint32_t MipLevel = 0u; MipLevel < Desc.NumMipLevel; ++MipLevel)
+	{
+		const uint32_t Width = std::max(Desc.Width >> MipLevel, 1u);
+		const uint32_t Height = std::max(Desc.Height >> MipLevel, 1u);
+		const uint32_t Depth = std::max(Desc.Depth >> MipLevel, 1u);
+
+		Size += RHI::GetFormatAttributes(Width, Height, Desc.Format).SlicePitch * Depth;
+	}
+
+	return Size * Desc.NumArrayLayer * static_cast<size_t>(Desc.SampleCount);
+}
+
 void RDGSceneTextures::InitializeWithSceneView(RDGRenderGraph& Graph, const RDGSceneViewInfo& ViewInfo)
 {
 	if (Graph.GetRenderSettings().RenderingPath == ERenderingPath::DeferredShading)
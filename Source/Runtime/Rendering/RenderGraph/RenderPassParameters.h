@@ -10,30 +10,89 @@
 using DAGNodeID = DirectedAcyclicGraph::NodeID;
 using RDGResourceID = ObjectID<class RDGResource>;
 
+/// Positions in the compiled pass order of the first and the last surviving pass using a resource.
+struct RDGResourceLifetime
+{
+	static constexpr uint32_t Unused = ~0u;
+
+	uint32_t FirstPass = Unused;
+	uint32_t LastPass = Unused;
+
+	inline bool IsUsed() const { return FirstPass != Unused; }
+	inline bool Overlaps(const RDGResourceLifetime& Other) const { return FirstPass <= Other.LastPass && Other.FirstPass <= LastPass; }
+};
+
 class RDGResource
 {
 public:
+	enum class EType : uint8_t
+	{
+		Buffer,
+		Texture
+	};
+
 	RDGResource(const RDGResource&) = delete;
 	virtual ~RDGResource() = default;
 
 	RHIResource* GetRHI() const { return m_RHIResource.get(); }
+
+	inline RDGResourceID GetID() const { return m_ID; }
+	inline EType GetType() const { return m_Type; }
+	inline const char* GetName() const { return m_Name.c_str(); }
+
+	/// Owned outside the graph, the content lives on before and after the frame.
+	inline bool IsImported() const { return m_Imported; }
+
+	/// Handed out of the graph after execution, see RDGRenderGraph::ExtractTexture.
+	inline bool IsExtracted() const { return m_Extracted; }
+
+	/// Only lives within the frame, nothing outside the graph sees it.
+	inline bool IsTransient() const { return !m_Imported && !m_Extracted; }
+
+	inline const RDGResourceLifetime& GetLifetime() const { return m_Lifetime; }
+
+	/// Index of the aliasing group sharing an RHI resource with this one, none for resources which are not transient or never used.
+	inline uint32_t GetAliasingGroup() const { return m_AliasingGroup; }
+
+	static constexpr uint32_t NoAliasingGroup = ~0u;
 protected:
-	RDGResource(const char* const Name)
-		: m_Name(Name)
+	friend class RDGRenderGraph;
+
+	RDGResource(RDGResourceID ID, EType Type, std::string_view Name)
+		: m_ID(ID)
+		, m_Type(Type)
+		, m_Name(Name)
 	{
 	}
 
-private:
-	const char* const m_Name;
 	RHIResourcePtr m_RHIResource = nullptr;
+private:
+	RDGResourceID m_ID;
+	EType m_Type;
+	bool m_Imported = false;
+	bool m_Extracted = false;
+	std::string m_Name;
+	RDGResourceLifetime m_Lifetime;
+	uint32_t m_AliasingGroup = NoAliasingGroup;
 };
 
 class RDGBuffer : public RDGResource
 {
 public:
-	using RDGResource::RDGResource;
+	RDGBuffer(RDGResourceID ID, const RHIBufferDesc& Desc)
+		: RDGResource(ID, EType::Buffer, Desc.Name.Get())
+		, m_Desc(Desc)
+	{
+		m_Desc.InitialData = nullptr;
+	}
 
 	RHIBuffer* GetRHI() const { return static_cast<RHIBuffer*>(RDGResource::GetRHI()); }
+
+	inline size_t ComputeMemorySize() const { return m_Desc.Size; }
+
+	inline const RHIBufferDesc& GetDesc() const { return m_Desc; }
+private:
+	RHIBufferDesc m_Desc;
 };
 
 template<class Parameters>
@@ -42,8 +101,12 @@ class RDGUniformBuffer : public RDGBuffer
 public:
 	Parameters& GetParameters() { return *m_Parameters; }
 
-	RDGUniformBuffer(const char* const Name)
-		: RDGBuffer(Name)
+	RDGUniformBuffer(RDGResourceID ID, const char* const Name)
+		: RDGBuffer(ID, RHIBufferDesc()
+			.SetSize(sizeof(Parameters))
+			.SetUsages(ERHIBufferUsageFlags::UniformBuffer)
+			.SetAccessFlags(ERHIDeviceAccessFlags::GpuReadCpuWrite)
+			.SetName(Name))
 		, m_Parameters(new Parameters())
 	{
 	}
@@ -54,13 +117,24 @@ private:
 class RDGTexture : public RDGResource
 {
 public:
+	RDGTexture(RDGResourceID ID, const RHITextureDesc& Desc)
+		: RDGResource(ID, EType::Texture, Desc.Name.Get())
+		, m_Desc(Desc)
+	{
+		m_Desc.BulkData.reset();
+	}
+
 	RHITexture* GetRHI() const { return static_cast<RHITexture*>(RDGResource::GetRHI()); }
 
 	const RHISubresource& GetSubresource() const { return m_Subresource; }
 
-	uint32_t ComputeMemorySize() const;
+	inline size_t ComputeMemorySize() const { return ComputeMemorySize(m_Desc); }
+
+	/// Every mip of every layer and sample, tightly packed.
+	static size_t ComputeMemorySize(const RHITextureDesc& Desc);
 
 	inline RHITextureDesc& GetDesc() { return m_Desc; }
+	inline const RHITextureDesc& GetDesc() const { return m_Desc; }
 private:
 	RHISubresource m_Subresource;
 	RHITextureDesc m_Desc;
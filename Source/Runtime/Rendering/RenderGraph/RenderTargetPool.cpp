@@ -1 +1,140 @@
-#include "Rendering/RenderTargetPool.h"
\ No newline at end of file
+#include "Rendering/RenderGraph/RenderTargetPool.h"
+#include "Core/ConsoleVariable.h"
+#include "RHI/RHIDevice.h"
+
+ConsoleVariable<uint32_t> CVarRDGPoolMaxIdleFrames(
+	"rdg.pool_max_idle_frames",
+	"Frames a pooled transient render target or buffer stays alive without being used.",
+	30u);
+
+/// Released resources are reused once the frames that may still access them on the GPU have retired.
+static constexpr uint64_t NumRetiredFrames = 3u;
+
+size_t RDGRenderTargetPool::ComputeKey(const RHITextureDesc& Desc)
+{
+	return ComputeHash(
+		Desc.Width,
+		Desc.Height,
+		Desc.Depth,
+		Desc.NumArrayLayer,
+		Desc.NumMipLevel,
+		Desc.Format,
+		Desc.BufferUsageFlags,
+		Desc.Dimension,
+		Desc.SampleCount,
+		Desc.IsLinear);
+}
+
+size_t RDGRenderTargetPool::ComputeKey(const RHIBufferDesc& Desc)
+{
+	return ComputeHash(
+		Desc.BufferUsageFlags,
+		Desc.AccessFlags);
+}
+
+RDGRenderTargetPool::PooledResource* RDGRenderTargetPool::FindFree(size_t Key, size_t Size)
+{
+	PooledResource* BestFit = nullptr;
+
+	for (auto& Pooled : m_Resources)
+	{
+		if (!Pooled.InUse && Pooled.ReleasedFrame + NumRetiredFrames <= m_Frame && Pooled.Key == Key && Pooled.Size >= Size && (!BestFit || Pooled.Size < BestFit->Size))
+		{
+			BestFit = &Pooled;
+		}
+	}
+
+	return BestFit;
+}
+
+RHITexturePtr RDGRenderTargetPool::AcquireTexture(const RHITextureDesc& Desc)
+{
+	const size_t Key = ComputeKey(Desc);
+	const size_t Size = RDGTexture::ComputeMemorySize(Desc);
+
+	std::lock_guard Locker(m_Lock);
+
+	auto Pooled = FindFree(Key, Size);
+	if (!Pooled)
+	{
+		auto Texture = m_Device.CreateTexture(Desc);
+		if (!Texture)
+		{
+			return nullptr;
+		}
+
+		Pooled = &m_Resources.emplace_back(PooledResource{ Texture, Key, Size });
+	}
+
+	Pooled->InUse = true;
+	Pooled->LastUsedFrame = m_Frame;
+	return std::static_pointer_cast<RHITexture>(Pooled->Resource);
+}
+
+RHIBufferPtr RDGRenderTargetPool::AcquireBuffer(const RHIBufferDesc& Desc)
+{
+	const size_t Key = ComputeKey(Desc);
+
+	std::lock_guard Locker(m_Lock);
+
+	auto Pooled = FindFree(Key, Desc.Size);
+	if (!Pooled)
+	{
+		auto Buffer = m_Device.CreateBuffer(Desc);
+		if (!Buffer)
+		{
+			return nullptr;
+		}
+
+		Pooled = &m_Resources.emplace_back(PooledResource{ Buffer, Key, Desc.Size });
+	}
+
+	Pooled->InUse = true;
+	Pooled->LastUsedFrame = m_Frame;
+	return std::static_pointer_cast<RHIBuffer>(Pooled->Resource);
+}
+
+void RDGRenderTargetPool::Release(const RHIResourcePtr& Resource)
+{
+	std::lock_guard Locker(m_Lock);
+
+	for (auto& Pooled : m_Resources)
+	{
+		if (Pooled.Resource == Resource)
+		{
+			assert(Pooled.InUse);
+			Pooled.InUse = false;
+			Pooled.ReleasedFrame = m_Frame;
+			return;
+		}
+	}
+
+	assert(false);
+}
+
+void RDGRenderTargetPool::Tick()
+{
+	std::lock_guard Locker(m_Lock);
+
+	++m_Frame;
+
+	/// Never free what the GPU may still access.
+	const uint64_t MaxIdleFrames = std::max<uint64_t>(CVarRDGPoolMaxIdleFrames.Get(), NumRetiredFrames);
+	m_Resources.erase(std::remove_if(m_Resources.begin(), m_Resources.end(), [this, MaxIdleFrames](const PooledResource& Pooled) {
+		return !Pooled.InUse && m_Frame - Pooled.LastUsedFrame > MaxIdleFrames;
+	}), m_Resources.end());
+}
+
+void RDGRenderTargetPool::GetStats(uint32_t& NumRenderTargets, size_t& MemorySizeOfPool, size_t& MemorySizeUsed) const
+{
+	std::lock_guard Locker(m_Lock);
+
+	NumRenderTargets = static_cast<uint32_t>(m_Resources.size());
+	MemorySizeOfPool = MemorySizeUsed = 0u;
+
+	for (const auto& Pooled : m_Resources)
+	{
+		MemorySizeOfPool += Pooled.Size;
+		MemorySizeUsed += Pooled.InUse ? Pooled.Size : 0u;
+	}
+}
@@ -1,14 +1,56 @@
 #pragma once
 
+#include "Core/Singleton.h"
 #include "Rendering/RenderGraph/RenderPassParameters.h"
 
-class RDGRenderTargetPool
+/// Keeps the RHI textures and buffers backing transient render graph resources alive across frames. The graph acquires one pooled
+/// resource per aliasing group when it executes and releases it again once the frame is recorded, so later frames get the same
+/// memory back instead of allocating. A released entry is handed out again only once the frames that may still use it on the GPU,
+/// async compute included, have retired. Entries nobody acquired for cvar rdg.pool_max_idle_frames frames are freed.
+class RDGRenderTargetPool : public LazySingleton<RDGRenderTargetPool>
 {
 public:
-	void GetStats(uint32_t& NumRenderTargets, uint32_t& MemorySizeOfPool, uint32_t& MemorySizeUsed);
+	/// Hash of everything two textures must agree on to share an RHI texture.
+	static size_t ComputeKey(const RHITextureDesc& Desc);
 
+	/// Buffers of the same key share memory however large they are, a pooled buffer serves every request it is large enough for.
+	static size_t ComputeKey(const RHIBufferDesc& Desc);
 
+	RHITexturePtr AcquireTexture(const RHITextureDesc& Desc);
+	RHIBufferPtr AcquireBuffer(const RHIBufferDesc& Desc);
+
+	void Release(const RHIResourcePtr& Resource);
+
+	/// Once per frame, frees the entries idle for too long.
+	void Tick();
+
+	void GetStats(uint32_t& NumRenderTargets, size_t& MemorySizeOfPool, size_t& MemorySizeUsed) const;
+
+	inline const RHIDevice& GetDevice() const { return m_Device; }
+
+	/// The application shares the lazy singleton, a graph may also be given a pool of its own, e.g. over a null device in tests.
+	RDGRenderTargetPool(const RHIDevice& Device)
+		: m_Device(Device)
+	{
+	}
+protected:
+	ALLOW_ACCESS_LAZY(RDGRenderTargetPool);
 private:
-	RDGRenderTarget* Create(RHITextureDesc& Desc, const char* Name);
-};
+	struct PooledResource
+	{
+		RHIResourcePtr Resource;
+		size_t Key = 0u;
+		size_t Size = 0u;
+		uint64_t LastUsedFrame = 0u;
+		uint64_t ReleasedFrame = 0u;
+		bool InUse = false;
+	};
+
+	PooledResource* FindFree(size_t Key, size_t Size);
 
+	const RHIDevice& m_Device;
+
+	mutable std::mutex m_Lock;
+	std::vector<PooledResource> m_Resources;
+	uint64_t m_Frame = 0u;
+};
@@ -27,6 +27,13 @@ enum class EShadowTechnique : uint8_t
 	Cascade
 };
 
+enum class ECascadeSplitScheme : uint8_t
+{
+	Uniform,
+	Logarithmic,
+	Practical, DESCRIPTION("Blend of uniform and logarithmic splits, weighted by SplitLambda")
+};
+
 enum class EToneMappingTechnique : uint8_t
 {
 	None,
@@ -107,6 +114,29 @@ struct RenderSettings
 		}
 	};
 
+	struct ShadowSettings
+	{
+		uint32_t NumCascades = 4u;
+		uint32_t ShadowMapSize = 2048u;
+
+		float SplitLambda = 0.75f;
+		float MaxShadowDistance = 200.0f;
+
+		ECascadeSplitScheme CascadeSplitScheme = ECascadeSplitScheme::Practical;
+
+		template<class Archive>
+		void serialize(Archive& Ar)
+		{
+			Ar(
+				CEREAL_NVP(NumCascades),
+				CEREAL_NVP(ShadowMapSize),
+				CEREAL_NVP(SplitLambda),
+				CEREAL_NVP(MaxShadowDistance),
+				CEREAL_NVP_ENUM(ECascadeSplitScheme, CascadeSplitScheme)
+			);
+		}
+	};
+
 	bool Enable = true;
 	bool VSync = false;
 	bool FullScreen = false;
@@ -133,6 +163,7 @@ struct RenderSettings
 	
 	PostProcessingSettings PostProcessing;
 	DebugDrawSettings DebugDraw;
+	ShadowSettings Shadow;
 
 	template<class Archive>
 	void serialize(Archive& Ar)
@@ -157,7 +188,8 @@ struct RenderSettings
 			CEREAL_NVP_ENUM(EAntiAliasingTechnique, AntiAliasingTechnique),
 			CEREAL_NVP_ENUM(ERHIDeviceType, DeviceType),
 			CEREAL_NVP(PostProcessing),
-			CEREAL_NVP(DebugDraw)
+			CEREAL_NVP(DebugDraw),
+			CEREAL_NVP(Shadow)
 		);
 	}
 };
@@ -2,24 +2,34 @@
 #include "RHI/RHIDevice.h"
 #include "Paths.h"
 
-ShaderBinary::ShaderBinary(const Shader& InShader, ERHIDeviceType DeviceType, ShaderBlob& Blob)
-	: BaseClass(GetPath(InShader, DeviceType))
+ShaderBinary::ShaderBinary(const Shader& InShader, ERHIDeviceType DeviceType, uint64_t SourceHash, ShaderBlob& Blob)
+	: BaseClass(GetPath(InShader, DeviceType, SourceHash))
 	, m_DeviceType(DeviceType)
-	, m_ShaderLastWriteTime(InShader.GetLastWriteTime())
+	, m_SourceHash(SourceHash)
 	, m_Blob(std::move(Blob))
 {
 	Save(true);
 }
 
-std::filesystem::path ShaderBinary::GetPath(const Shader& InShader, ERHIDeviceType DeviceType)
+DerivedDataKey ShaderBinary::GetKey(const Shader& InShader, ERHIDeviceType DeviceType, uint64_t SourceHash)
 {
-	const std::filesystem::path RelativePath = std::filesystem::relative(InShader.GetPath(), Paths::ShaderPath()).parent_path();
-	return Paths::ShaderBinaryPath() / 
-		RelativePath / 
-		String::Format("%s_%s_%llu.json", 
-			InShader.GetStem().c_str(), 
-			RHIDevice::GetName(DeviceType), 
-			std::hash<Shader>()(InShader));
+	/// XXHash64 rather than std::hash, keys must be the same in every run.
+	const auto Stage = InShader.GetStage();
+	uint64_t SettingsHash = XXHash64(&Stage, sizeof(Stage));
+	SettingsHash = XXHash64(&DeviceType, sizeof(DeviceType), SettingsHash);
+	SettingsHash = XXHash64(InShader.GetEntryPoint(), strlen(InShader.GetEntryPoint()) + 1u, SettingsHash);
+	for (const auto& [Name, Value] : InShader.GetDefines())
+	{
+		SettingsHash = XXHash64(Name.c_str(), Name.size() + 1u, SettingsHash);
+		SettingsHash = XXHash64(Value.c_str(), Value.size() + 1u, SettingsHash);
+	}
+
+	return DerivedDataKey{ "Shader", Version, SourceHash, SettingsHash };
+}
+
+std::filesystem::path ShaderBinary::GetPath(const Shader& InShader, ERHIDeviceType DeviceType, uint64_t SourceHash)
+{
+	return DerivedDataCache::Get().GetPath(GetKey(InShader, DeviceType, SourceHash));
 }
 
 size_t Shader::GetHash() const
@@ -59,23 +69,23 @@ const RHIShader* Shader::GetRHI(const RHIDevice& Device)
 	return GetFallback(Device);
 }
 
-void Shader::SetBlob(ShaderBlob& Blob, ERHIDeviceType DeviceType)
+void Shader::SetBlob(ShaderBlob& Blob, ERHIDeviceType DeviceType, uint64_t SourceHash)
 {
 	if (m_CachedBinary)
 	{
 #if _DEBUG
 		if (m_CachedBinary->GetDeviceType() != DeviceType)
 		{
-			m_CachedBinary = std::make_shared<ShaderBinary>(*this, DeviceType, Blob);
+			m_CachedBinary = std::make_shared<ShaderBinary>(*this, DeviceType, SourceHash, Blob);
 			return;
 		}
 #endif
-		m_CachedBinary->SetBlob(Blob, GetLastWriteTime());
+		m_CachedBinary->SetBlob(*this, Blob, SourceHash);
 		SetStatus(Asset::EStatus::Loading);
 	}
 	else
 	{
-		m_CachedBinary = std::make_shared<ShaderBinary>(*this, DeviceType, Blob);
+		m_CachedBinary = std::make_shared<ShaderBinary>(*this, DeviceType, SourceHash, Blob);
 	}
 }
 
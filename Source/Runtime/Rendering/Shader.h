@@ -2,6 +2,7 @@
 
 #include "Core/Math/Matrix.h"
 #include "Asset/SerializableAsset.h"
+#include "Asset/DerivedDataCache.h"
 #include "RHI/RHITexture.h"
 #include "RHI/RHIShader.h"
 #include "RHI/RHIBuffer.h"
@@ -128,12 +129,15 @@ private:
 	std::map<std::string, std::string> m_Defines;
 };
 
+/// Compiled shader, stored in the derived data cache keyed by the content hash of the shader source and the files it includes.
 class ShaderBinary : public Serializable<ShaderBinary>
 {
 public:
 	using BaseClass::BaseClass;
 
-	ShaderBinary(const class Shader& InShader, ERHIDeviceType DeviceType, ShaderBlob& Blob);
+	static constexpr uint32_t Version = 1u;
+
+	ShaderBinary(const class Shader& InShader, ERHIDeviceType DeviceType, uint64_t SourceHash, ShaderBlob& Blob);
 
 	inline const ShaderBlob& GetBlob() const
 	{
@@ -146,7 +150,7 @@ public:
 	{
 		Ar(
 			CEREAL_BASE(BaseClass),
-			CEREAL_NVP(m_ShaderLastWriteTime),
+			CEREAL_NVP(m_SourceHash),
 			CEREAL_NVP(m_Blob)
 		);
 	}
@@ -160,20 +164,24 @@ protected:
 		m_Blob.Reset();
 	}
 
-	inline void SetBlob(ShaderBlob& InBlob, time_t LastWriteTime)
+	/// New source content is a new cache entry, the binary moves there.
+	inline void SetBlob(const class Shader& InShader, ShaderBlob& InBlob, uint64_t SourceHash)
 	{
 		std::lock_guard<std::mutex> Lock(m_BlobLock);
 		m_Blob = std::move(InBlob);
-		m_ShaderLastWriteTime = LastWriteTime;
+		m_SourceHash = SourceHash;
+		SetPath(GetPath(InShader, m_DeviceType, SourceHash));
 		Save(true);
 	}
 
 	inline ERHIDeviceType GetDeviceType() const { return m_DeviceType; }
 private:
-	static std::filesystem::path GetPath(const Shader& InShader, ERHIDeviceType DeviceType);
+	/// SourceHash covers the source files, the key settings everything else which changes the compiled code.
+	static DerivedDataKey GetKey(const Shader& InShader, ERHIDeviceType DeviceType, uint64_t SourceHash);
+	static std::filesystem::path GetPath(const Shader& InShader, ERHIDeviceType DeviceType, uint64_t SourceHash);
 
 	ERHIDeviceType m_DeviceType = ERHIDeviceType::Num;
-	time_t m_ShaderLastWriteTime = 0;
+	uint64_t m_SourceHash = 0u;
 	ShaderBlob m_Blob;
 	mutable std::mutex m_BlobLock;
 };
@@ -213,7 +221,7 @@ protected:
 	{
 		m_CachedBinary = std::move(InBinary);
 	}
-	void SetBlob(ShaderBlob& Blob, ERHIDeviceType DeviceType);
+	void SetBlob(ShaderBlob& Blob, ERHIDeviceType DeviceType, uint64_t SourceHash);
 
 	virtual const RHIShader* GetFallback(const class RHIDevice&) const;
 private:
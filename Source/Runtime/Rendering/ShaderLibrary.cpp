@@ -94,47 +94,97 @@ void ShaderLibrary::RegisterShader(Shader& InShader)
 	}
 }
 
-std::unordered_set<std::filesystem::path> ShaderLibrary::ParseIncludeFiles(const Shader& InShader)
+/// The include directives of a single file, resolved against IncludeRoot.
+static std::vector<std::filesystem::path> ParseIncludeDirectives(const std::filesystem::path& Path, const std::filesystem::path& IncludeRoot)
 {
-	std::unordered_set<std::filesystem::path> IncludeFiles;
+	static const std::regex s_IncludeRegex(R"(^\s*#\s*include\s*([<"])([^>"]+)[>"])");
+
+	std::vector<std::filesystem::path> IncludeFiles;
 
-	if (std::filesystem::exists(InShader.GetPath()))
+	std::ifstream File(Path);
+	if (File.is_open())
 	{
-		std::ifstream ShaderFile(InShader.GetPath());
-		if (ShaderFile.is_open())
+		std::string Line;
+		while (std::getline(File, Line))
 		{
-			std::string Line;
-			std::regex IncludeRegex(R"(^\s*#\s*include\s*([<"])([^>"]+)[>"])");
-			while (std::getline(ShaderFile, Line))
+			std::smatch Match;
+			if (std::regex_search(Line, Match, s_IncludeRegex) && Match.size() == 3)
 			{
-				std::smatch Match;
-				if (std::regex_search(Line, Match, IncludeRegex))
-				{
-					if (Match.size() == 3)
-					{
-						IncludeFiles.emplace((Paths::ShaderPath().parent_path() / Match[2].str()).make_preferred());
-					}
-				}
+				IncludeFiles.emplace_back((IncludeRoot / Match[2].str()).lexically_normal().make_preferred());
 			}
-			ShaderFile.close();
 		}
 	}
 
 	return IncludeFiles;
 }
 
+std::vector<std::filesystem::path> ShaderLibrary::GatherIncludeFiles(const std::filesystem::path& SourcePath, const std::filesystem::path& IncludeRoot)
+{
+	std::unordered_set<std::filesystem::path> Visited;
+	std::vector<std::filesystem::path> Pending = ParseIncludeDirectives(SourcePath, IncludeRoot);
+
+	/// A header reached again, through a diamond or a cycle, is followed once.
+	while (!Pending.empty())
+	{
+		auto IncludeFile = std::move(Pending.back());
+		Pending.pop_back();
+
+		if (Visited.insert(IncludeFile).second && std::filesystem::is_regular_file(IncludeFile))
+		{
+			auto Nested = ParseIncludeDirectives(IncludeFile, IncludeRoot);
+			Pending.insert(Pending.end(), std::make_move_iterator(Nested.begin()), std::make_move_iterator(Nested.end()));
+		}
+	}
+
+	std::vector<std::filesystem::path> IncludeFiles(Visited.begin(), Visited.end());
+	std::sort(IncludeFiles.begin(), IncludeFiles.end());
+	return IncludeFiles;
+}
+
+std::unordered_set<std::filesystem::path> ShaderLibrary::ParseIncludeFiles(const Shader& InShader)
+{
+	auto IncludeFiles = GatherIncludeFiles(InShader.GetPath(), Paths::ShaderPath().parent_path());
+	return std::unordered_set<std::filesystem::path>(IncludeFiles.begin(), IncludeFiles.end());
+}
+
+uint64_t ShaderLibrary::ComputeSourceHash(const std::filesystem::path& SourcePath, const std::filesystem::path& IncludeRoot)
+{
+	uint64_t Hash = File::ComputeContentHash(SourcePath);
+
+	/// Include paths take part, moving code between headers changes the hash. Sorted by the relative paths, so where the include root
+	/// lives does not matter.
+	std::vector<std::pair<std::string, std::filesystem::path>> IncludeFiles;
+	for (auto& IncludeFile : GatherIncludeFiles(SourcePath, IncludeRoot))
+	{
+		IncludeFiles.emplace_back(IncludeFile.lexically_relative(IncludeRoot).generic_string(), std::move(IncludeFile));
+	}
+	std::sort(IncludeFiles.begin(), IncludeFiles.end());
+
+	for (const auto& [RelativePath, IncludeFile] : IncludeFiles)
+	{
+		const uint64_t IncludeHash = File::ComputeContentHash(IncludeFile);
+		Hash = XXHash64(RelativePath.c_str(), RelativePath.size() + 1u, Hash);
+		Hash = XXHash64(&IncludeHash, sizeof(IncludeHash), Hash);
+	}
+
+	return Hash;
+}
+
 void ShaderLibrary::Compile(Shader& InShader, ERHIDeviceType DeviceType)
 {
 	assert(std::filesystem::exists(InShader.GetPath()));
 
 	RegisterShader(InShader);
 
-	auto CachedBinaryPath = ShaderBinary::GetPath(InShader, DeviceType);
+	const uint64_t SourceHash = ComputeSourceHash(InShader.GetPath(), Paths::ShaderPath().parent_path());
+	const auto CachedBinaryKey = ShaderBinary::GetKey(InShader, DeviceType, SourceHash);
+	auto CachedBinaryPath = DerivedDataCache::Get().GetPath(CachedBinaryKey);
 	if (std::filesystem::exists(CachedBinaryPath))
 	{
 		std::shared_ptr<ShaderBinary> CachedBinary = ShaderBinary::Load(CachedBinaryPath);
-		if (CachedBinary->GetBlob().IsValid() && CachedBinary->m_ShaderLastWriteTime == InShader.GetLastWriteTime())
+		if (CachedBinary->GetBlob().IsValid() && CachedBinary->m_SourceHash == SourceHash)
 		{
+			DerivedDataCache::Get().Touch(CachedBinaryKey);
 			InShader.SetBinary(CachedBinary);
 			LOG_DEBUG(LogShaderLibrary, "Load shader binary from \"{}\".", CachedBinaryPath.string());
 			return;
@@ -161,7 +211,7 @@ void ShaderLibrary::Compile(Shader& InShader, ERHIDeviceType DeviceType)
 				InShader);
 			if (Blob.IsValid())
 			{
-				InShader.SetBlob(Blob, DeviceType);
+				InShader.SetBlob(Blob, DeviceType, SourceHash);
 				LOG_INFO(LogShaderLibrary, "Shader \"{}\" compile success for device \"{}\".", InShader.GetStem(), magic_enum::enum_name(DeviceType).data());
 			}
 		}
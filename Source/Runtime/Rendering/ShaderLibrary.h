@@ -21,6 +21,14 @@ public:
 
 	void Compile(Shader& InShader, ERHIDeviceType DeviceType);
 	void QueueCompile(Shader& InShader, ERHIDeviceType DeviceType);
+
+	/// Every file SourcePath includes, directly or through other includes, once each and sorted. Include directives resolve against
+	/// IncludeRoot, files which do not exist there are listed but not followed.
+	static std::vector<std::filesystem::path> GatherIncludeFiles(const std::filesystem::path& SourcePath, const std::filesystem::path& IncludeRoot);
+
+	/// XXHash64 of the source and of every file of its include closure together with its path relative to IncludeRoot, the key of
+	/// the cached binaries. Editing any header the source reaches, however indirectly, changes it.
+	static uint64_t ComputeSourceHash(const std::filesystem::path& SourcePath, const std::filesystem::path& IncludeRoot);
 protected:
 private:
 	using LinkedShaders = std::unordered_set<Shader*>;
@@ -32,6 +40,7 @@ private:
 
 	void RegisterShader(Shader& InShader);
 
+	/// The include closure of the shader, the same files hot reload tracks and the source hash covers.
 	std::unordered_set<std::filesystem::path> ParseIncludeFiles(const Shader& InShader);
 
 	inline IShaderCompiler* GetCompiler(ERHIDeviceType DeviceType) { return m_Compilers[DeviceType].get(); }
@@ -1,6 +1,237 @@
 #include "Asset/Texture.h"
+#include "Asset/MappedFile.h"
+#include "Async/Task.h"
 #include "RHI/RHIDevice.h"
+#include "RHI/RHIUploadManager.h"
+
+extern RHIDevice* GRenderDevice;
+
+/// Desc of the texture holding only the NumMips smallest mips of Desc.
+static RHITextureDesc GetResidentMipsDesc(const RHITextureDesc& Desc, uint32_t NumMips)
+{
+	const uint32_t FirstMip = Desc.NumMipLevel - NumMips;
+
+	RHITextureDesc ResidentDesc(Desc);
+	ResidentDesc.SetWidth(std::max(Desc.Width >> FirstMip, 1u))
+		.SetHeight(std::max(Desc.Height >> FirstMip, 1u))
+		.SetNumMipLevel(NumMips);
+	ResidentDesc.BulkData.reset();
+	ResidentDesc.SubresourceOffsets.clear();
+
+	return ResidentDesc;
+}
+
+Texture::~Texture()
+{
+	if (m_StreamingTask)
+	{
+		m_StreamingTask->Wait();
+	}
+}
+
+size_t Texture::GetMipsSize(uint32_t NumMips) const
+{
+	if (!IsStreamable())
+	{
+		return NumMips ? GetMemorySize() : 0u;
+	}
+
+	assert(NumMips <= m_Mips.size());
+
+	if (NumMips == 0u)
+	{
+		return 0u;
+	}
+
+	const auto& LastMip = m_Mips.back();
+	return LastMip.Offset + LastMip.Size - m_Mips[m_Mips.size() - NumMips].Offset;
+}
+
+void Texture::InitializeMips(const std::filesystem::path& MipDataPath, size_t MipDataOffset, uint32_t MaxTailMipSize)
+{
+	m_Mips.clear();
+	m_MipDataPath = MipDataPath;
+	m_MipData.reset();
+	m_MipDataOffset = MipDataOffset;
+	m_NumTailMips = 0u;
+
+	if (m_MipDataPath.empty() || !m_Desc.SubresourceOffsets.empty() || m_Desc.Dimension != ERHITextureDimension::T_2D || m_Desc.NumArrayLayer != 1u || m_Desc.NumMipLevel <= 1u)
+	{
+		return;
+	}
+
+	size_t Offset = 0u;
+	for (uint32_t Mip = 0u; Mip < m_Desc.NumMipLevel; ++Mip)
+	{
+		const uint32_t Width = std::max(m_Desc.Width >> Mip, 1u);
+		const uint32_t Height = std::max(m_Desc.Height >> Mip, 1u);
+		const size_t Size = RHI::GetFormatAttributes(Width, Height, m_Desc.Format).SlicePitch;
+
+		m_Mips.emplace_back(MipLevel{ Offset, Size });
+		Offset += Size;
+
+		if (std::max(Width, Height) <= MaxTailMipSize)
+		{
+			++m_NumTailMips;
+		}
+	}
+	m_NumTailMips = std::max(m_NumTailMips, 1u);
+
+	if (!m_Desc.BulkData || m_Desc.BulkData->GetSize() < Offset)
+	{
+		LOG_WARNING(LogAsset, "Mip chain of texture \"{}\" is truncated, it will not stream", GetName());
+		m_Mips.clear();
+		return;
+	}
+
+	if (IsStreamable())
+	{
+		m_MipData = MappedFile::Open(m_MipDataPath);
+		if (!m_MipData || m_MipData->GetSize() < m_MipDataOffset + Offset)
+		{
+			LOG_WARNING(LogAsset, "Mip data of texture \"{}\" can not be mapped, it will not stream", GetName());
+			m_MipData.reset();
+			m_Mips.clear();
+			return;
+		}
+
+		const auto& FirstTailMip = m_Mips[m_Mips.size() - m_NumTailMips];
+		m_Desc.SetBulkData(GetMipsSize(m_NumTailMips), m_Desc.BulkData->GetRawData() + FirstTailMip.Offset);
+	}
+	else
+	{
+		m_Mips.clear();
+	}
+}
 
 void Texture::CreateRHI()
 {
+	const uint32_t NumMips = GetNumTailMips();
+
+	if (GRenderDevice && m_Desc.BulkData)
+	{
+		m_RHIResource = GRenderDevice->CreateTexture(GetResidentMipsDesc(m_Desc, NumMips));
+
+		/// Non streamable textures keep all mips in the bulk data, containers with their own subresource order are uploaded in place.
+		if (!m_Desc.SubresourceOffsets.empty())
+		{
+			RHIUploadManager::Get().QueueUploadTexture(m_RHIResource.get(), m_Desc.BulkData->GetRawData(), m_Desc.SubresourceOffsets);
+		}
+		else if (m_Desc.BulkData->GetSize() >= GetMipsSize(NumMips))
+		{
+			RHIUploadManager::Get().QueueUploadTexture(m_RHIResource.get(), m_Desc.BulkData->GetRawData(), GetMipsSize(NumMips));
+		}
+	}
+
+	m_NumRequestedMips.store(NumMips, std::memory_order_release);
+	m_NumResidentMips.store(NumMips, std::memory_order_release);
 }
+
+void Texture::ReleaseRHI()
+{
+	if (m_StreamingTask)
+	{
+		m_StreamingTask->Wait();
+		m_StreamingTask.reset();
+	}
+
+	m_PendingRHIResource.reset();
+	m_PendingUpload = RHIUploadTicket();
+	m_RHIResource.reset();
+
+	m_NumRequestedMips.store(0u, std::memory_order_release);
+	m_NumResidentMips.store(0u, std::memory_order_release);
+}
+
+bool Texture::StreamIn(uint32_t NumMips)
+{
+	assert(NumMips <= GetNumMipLevels());
+
+	if (!IsStreamable() || IsStreaming() || NumMips <= GetNumResidentMips())
+	{
+		return false;
+	}
+
+	return RequestMips(NumMips);
+}
+
+bool Texture::StreamOut(uint32_t NumMips)
+{
+	NumMips = std::max(NumMips, GetNumTailMips());
+
+	if (!IsStreamable() || IsStreaming() || NumMips >= GetNumResidentMips())
+	{
+		return false;
+	}
+
+	return RequestMips(NumMips);
+}
+
+bool Texture::RequestMips(uint32_t NumMips)
+{
+	m_NumRequestedMips.store(NumMips, std::memory_order_release);
+	m_StreamingFailed = false;
+
+	/// Both directions recreate the texture from the file, the mips are contiguous from the requested top mip to the smallest one.
+	/// Streaming out could copy on the GPU instead, but the tail is small and the mapped pages are usually still cached.
+	/// The mapping was checked to cover every mip when the texture loaded.
+	m_StreamingTask = TFTask::Launch("Texture.StreamMips", [this, NumMips]() {
+		const size_t Offset = m_MipDataOffset + m_Mips[m_Mips.size() - NumMips].Offset;
+		const size_t Size = GetMipsSize(NumMips);
+
+		if (GRenderDevice)
+		{
+			m_PendingRHIResource = GRenderDevice->CreateTexture(GetResidentMipsDesc(m_Desc, NumMips));
+
+			m_PendingUpload = RHIUploadManager::Get().QueueUploadTexture(m_PendingRHIResource.get(), m_MipData->GetData() + Offset, Size);
+		}
+	}, TFTask::EThread::WorkerThread, TFTask::EPriority::Low);
+
+	return true;
+}
+
+bool Texture::FinishStreaming(RHITexturePtr& OutReleased)
+{
+	if (!IsStreaming() || (!m_StreamingTask && !m_PendingUpload.IsValid()))
+	{
+		return false;
+	}
+
+	if (m_StreamingTask)
+	{
+		if (!m_StreamingTask->IsCompleted())
+		{
+			return false;
+		}
+
+		m_StreamingTask->Wait();
+		m_StreamingTask.reset();
+	}
+
+	/// A failed read keeps the old mips.
+	if (m_StreamingFailed)
+	{
+		m_PendingRHIResource.reset();
+		m_PendingUpload = RHIUploadTicket();
+		m_NumRequestedMips.store(GetNumResidentMips(), std::memory_order_release);
+		return true;
+	}
+
+	/// The task only queued the copy, the old texture stays in use until the GPU is done with it.
+	if (m_PendingUpload.IsValid())
+	{
+		if (!RHIUploadManager::Get().IsUploadComplete(m_PendingUpload))
+		{
+			return false;
+		}
+
+		RHIUploadManager::Get().AcquireUploadedTexture(m_PendingUpload, m_PendingRHIResource.get());
+		m_PendingUpload = RHIUploadTicket();
+	}
+
+	OutReleased = std::move(m_RHIResource);
+	m_RHIResource = std::move(m_PendingRHIResource);
+	m_NumResidentMips.store(GetNumRequestedMips(), std::memory_order_release);
+
+	return true;
+}
\ No newline at end of file
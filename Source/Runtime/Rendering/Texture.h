@@ -3,13 +3,29 @@
 #include "Core/Math/Color.h"
 #include "Asset/Asset.h"
 #include "Asset/RenderResource.h"
+#include "Asset/StreamableRenderAsset.h"
 #include "RHI/RHITexture.h"
+#include "RHI/RHIUploadManager.h"
 
-class Texture : public Asset, public RenderResource
+/// What the texels mean, decides the color space, the compressed format and how mips are filtered at import.
+enum class ETextureUsage : uint8_t
+{
+	Color,  /// sRGB color, BC1/BC3/BC7
+	Linear, /// Linear data with up to four channels, same formats as color without the sRGB decode
+	Normal, /// Tangent space normals, BC5 keeps x and y, z is reconstructed in the shader
+	Mask    /// Single linear channel in red, BC4
+};
+
+/// 2D textures with a full mip chain stream their mips, only the tail mips stay in the bulk data and on the GPU permanently.
+/// Streamed mips are read straight from the texture file, or its cooked file for imported images, and swapped in by the TextureStreamingManager.
+/// The file stays mapped as long as the texture lives, so neither the derived data cache collecting it nor an edit of the source pulls it away.
+class Texture : public Asset, public RenderResource, public StreamableRenderAsset
 {
 public:
 	using Asset::Asset;
 
+	~Texture();
+
 	const RHITexture* GetRHI() const { assert(m_RHIResource); return m_RHIResource.get(); }
 
 	inline uint32_t GetWidth() const { return m_Desc.Width; }
@@ -23,15 +39,63 @@ public:
 	inline bool IsLinear() const { return m_Desc.IsLinear; }
 	inline const DataBlock& GetBulkData() const { return *m_Desc.BulkData; }
 
+	/// Set by the TextureLoader from AssetLoadRequest::Settings when the texture is created.
+	inline void SetUsage(ETextureUsage Usage) { m_Usage = Usage; }
+	inline ETextureUsage GetUsage() const { return m_Usage; }
+
+	size_t GetMemorySize() const override { return m_Desc.BulkData ? m_Desc.BulkData->GetSize() : 0u; }
+
+	inline bool IsStreamable() const { return !m_Mips.empty() && m_NumTailMips < GetNumMipLevels(); }
+
+	/// Mips that never stream out.
+	inline uint32_t GetNumTailMips() const { return IsStreamable() ? m_NumTailMips : GetNumMipLevels(); }
+
+	/// Device memory of the NumMips smallest mips.
+	size_t GetMipsSize(uint32_t NumMips) const;
+
+	bool StreamIn(uint32_t NumMips) override final;
+	bool StreamOut(uint32_t NumMips) override final;
 protected:
 	friend class TextureLoader;
+	friend class TextureStreamingManager;
+
+	struct MipLevel
+	{
+		size_t Offset = 0u;
+		size_t Size = 0u;
+	};
 
 	inline RHITextureDesc& GetDesc() { return m_Desc; }
 
 	static Texture* CreateColoredTexture(std::string_view Name, const Math::Color& Value, uint32_t Width = 1u, uint32_t Height = 1u);
 
-	void CreateRHI();
+	/// Creates the RHI texture with the tail mips resident.
+	void CreateRHI() override;
+	void ReleaseRHI() override;
+
+	/// MipDataPath is the file mips stream from and MipDataOffset is where mip 0 starts in it, an empty path keeps every mip resident.
+	/// Streamable textures drop every mip above the tail from the bulk data.
+	void InitializeMips(const std::filesystem::path& MipDataPath, size_t MipDataOffset, uint32_t MaxTailMipSize);
+
+	/// Swaps in the texture of a completed request once its upload finished on the GPU, OutReleased receives the previous one which the GPU
+	/// may still be reading.
+	bool FinishStreaming(RHITexturePtr& OutReleased);
+
+	bool RequestMips(uint32_t NumMips);
 
 	RHITextureDesc m_Desc;
 	RHITexturePtr m_RHIResource;
+
+	ETextureUsage m_Usage = ETextureUsage::Color;
+
+	std::vector<MipLevel> m_Mips;
+	std::filesystem::path m_MipDataPath;
+	std::shared_ptr<class MappedFile> m_MipData;
+	size_t m_MipDataOffset = 0u;
+	uint32_t m_NumTailMips = 0u;
+
+	RHITexturePtr m_PendingRHIResource;
+	RHIUploadTicket m_PendingUpload;
+	std::shared_ptr<class TFTask> m_StreamingTask;
+	bool m_StreamingFailed = false;
 };
@@ -0,0 +1,347 @@
+#include "Rendering/TextureStreamingManager.h"
+#include "Rendering/Material.h"
+#include "Scene/Scene.h"
+#include "Scene/Components/StaticMeshComponent.h"
+#include "Core/ConsoleVariable.h"
+#include "RHI/RHIDevice.h"
+#include "RHI/RHIUploadManager.h"
+
+extern RHIDevice* GRenderDevice;
+
+ConsoleVariable<uint32_t> CVarTextureStreamingPoolSize(
+	"r.streaming.pool_size",
+	"Device memory for textures in megabytes. The tail mips of every texture are always resident and count against it.",
+	512u);
+
+ConsoleVariable<float> CVarTextureStreamingMipBias(
+	"r.streaming.mip_bias",
+	"Added to the wanted mip of every texture, positive values stream less detail.",
+	0.0f);
+
+ConsoleVariable<uint32_t> CVarTextureStreamingMaxInflightRequests(
+	"r.streaming.max_inflight_requests",
+	"Largest number of textures recreated at the same time.",
+	8u);
+
+ConsoleVariable<bool> CVarTextureStreamingLogStats(
+	"r.streaming.log_stats",
+	"Log the wanted, budgeted and committed texture memory every frame.",
+	false);
+
+/// Replaced textures are released once the frames that may still sample them have retired.
+static constexpr uint64_t NumRetiredFrames = 3u;
+
+TextureStreamingView TextureStreamingView::Create(const Camera& InCamera, float ViewHeight)
+{
+	return TextureStreamingView{ InCamera.GetEyePosition(), ViewHeight * 0.5f / std::tanf(InCamera.GetFov() * 0.5f) };
+}
+
+float TextureStreamingManager::GetPriority(const StreamingTexture& Texture, uint32_t NumMips)
+{
+	const uint32_t TopMip = Texture.Target->GetNumMipLevels() - NumMips;
+	const uint32_t TopMipSize = std::max(std::max(Texture.Target->GetWidth(), Texture.Target->GetHeight()) >> TopMip, 1u);
+
+	return Texture.ScreenSize / TopMipSize;
+}
+
+void TextureStreamingManager::Update(const Scene& InScene, const std::vector<TextureStreamingView>& Views)
+{
+	++m_Frame;
+
+	if (GRenderDevice)
+	{
+		RHIUploadManager::Create(*GRenderDevice);
+	}
+
+	const size_t PoolSize = static_cast<size_t>(CVarTextureStreamingPoolSize.Get()) * Megabyte;
+
+	FinishRequests();
+	ReleaseRetiredTextures(false);
+	GatherTextures(InScene, Views);
+	UpdateBudgetedMips(PoolSize);
+	IssueRequests(PoolSize);
+
+	m_Stats.PoolSize = PoolSize;
+	m_Stats.NumTextures = static_cast<uint32_t>(m_Textures.size());
+	m_Stats.CommittedSize = GetCommittedSize();
+	m_Stats.ResidentSize = m_Stats.NumStreamingTextures = 0u;
+	for (const auto& [Key, Texture] : m_Textures)
+	{
+		m_Stats.ResidentSize += Texture.Target->GetMipsSize(Texture.Target->GetNumResidentMips());
+		m_Stats.NumStreamingTextures += Texture.Target->IsStreaming() ? 1u : 0u;
+	}
+
+	if (CVarTextureStreamingLogStats.Get())
+	{
+		LOG_INFO(LogDefault, "Texture streaming: {} textures, {} streaming, wanted {} MB, budgeted {} MB, resident {} MB, committed {} MB of {} MB",
+			m_Stats.NumTextures, m_Stats.NumStreamingTextures, m_Stats.WantedSize / Megabyte, m_Stats.BudgetedSize / Megabyte,
+			m_Stats.ResidentSize / Megabyte, m_Stats.CommittedSize / Megabyte, m_Stats.PoolSize / Megabyte);
+	}
+}
+
+void TextureStreamingManager::FinishRequests()
+{
+	for (auto It = m_Textures.begin(); It != m_Textures.end();)
+	{
+		auto& Target = *It->second.Target;
+		const size_t ResidentSize = Target.GetMipsSize(Target.GetNumResidentMips());
+
+		RHITexturePtr Released;
+		if (Target.FinishStreaming(Released) && Released)
+		{
+			m_RetiredTextures.emplace_back(RetiredTexture{ std::move(Released), ResidentSize, m_Frame });
+		}
+
+		/// Textures no primitive referenced for a whole frame drop all their mips once no request is in flight.
+		if (It->second.LastSeenFrame + 1u < m_Frame && !Target.IsStreaming())
+		{
+			if (Target.m_RHIResource)
+			{
+				m_RetiredTextures.emplace_back(RetiredTexture{ std::move(Target.m_RHIResource), Target.GetMipsSize(Target.GetNumResidentMips()), m_Frame });
+			}
+			Target.ReleaseRHI();
+
+			It = m_Textures.erase(It);
+		}
+		else
+		{
+			++It;
+		}
+	}
+}
+
+void TextureStreamingManager::ReleaseRetiredTextures(bool Force)
+{
+	while (!m_RetiredTextures.empty() && (Force || m_RetiredTextures.front().Frame + NumRetiredFrames <= m_Frame))
+	{
+		m_RetiredTextures.pop_front();
+	}
+}
+
+void TextureStreamingManager::GatherTextures(const Scene& InScene, const std::vector<TextureStreamingView>& Views)
+{
+	std::unordered_set<const PrimitiveComponent*> RemovedPrimitives(InScene.GetRemovedPrimitives().begin(), InScene.GetRemovedPrimitives().end());
+
+	for (auto& [Key, Texture] : m_Textures)
+	{
+		Texture.ScreenSize = 0.0f;
+	}
+
+	for (auto Primitive : InScene.GetAddedPrimitives())
+	{
+		/// A removed primitive may already be destroyed, only its address is safe to look at.
+		if (!Primitive || RemovedPrimitives.contains(Primitive) || !Primitive->IsA<StaticMeshComponent>())
+		{
+			continue;
+		}
+
+		auto MeshComp = static_cast<const StaticMeshComponent*>(Primitive);
+		if (!MeshComp->HasMaterialProperty())
+		{
+			continue;
+		}
+
+		/// Projected diameter of the world space bounding sphere, a view inside the sphere sees it at its nearest.
+		const Math::Sphere Bounds = MeshComp->GetBounds().GetSphere();
+		float ScreenSize = 0.0f;
+		for (const auto& View : Views)
+		{
+			const float DeltaX = Bounds.GetCenter().x - View.Origin.x;
+			const float DeltaY = Bounds.GetCenter().y - View.Origin.y;
+			const float DeltaZ = Bounds.GetCenter().z - View.Origin.z;
+			const float Distance = std::max(std::sqrtf(DeltaX * DeltaX + DeltaY * DeltaY + DeltaZ * DeltaZ), Bounds.GetRadius());
+
+			if (Distance > 0.0f)
+			{
+				ScreenSize = std::max(ScreenSize, 2.0f * Bounds.GetRadius() * View.ScreenScale / Distance);
+			}
+		}
+
+		for (const auto& Target : MeshComp->GetMaterialProperty().Textures)
+		{
+			if (!Target || !Target->IsReady(std::memory_order_acquire))
+			{
+				continue;
+			}
+
+			auto It = m_Textures.find(Target.get());
+			if (It == m_Textures.end())
+			{
+				It = m_Textures.emplace(Target.get(), StreamingTexture{ Target }).first;
+
+				if (!Target->GetNumResidentMips() && !Target->IsStreaming())
+				{
+					Target->CreateRHI();
+				}
+			}
+
+			It->second.ScreenSize = std::max(It->second.ScreenSize, ScreenSize);
+			It->second.LastSeenFrame = m_Frame;
+		}
+	}
+
+	const float MipBias = CVarTextureStreamingMipBias.Get();
+	for (auto& [Key, Texture] : m_Textures)
+	{
+		const uint32_t NumMips = Texture.Target->GetNumMipLevels();
+		const uint32_t NumTailMips = Texture.Target->GetNumTailMips();
+
+		uint32_t TopMip = NumMips - NumTailMips;
+		if (Texture.ScreenSize > 0.0f)
+		{
+			const float MaxSize = static_cast<float>(std::max(Texture.Target->GetWidth(), Texture.Target->GetHeight()));
+			const float WantedTopMip = std::floor(std::log2(MaxSize / Texture.ScreenSize) + MipBias);
+			TopMip = std::min(static_cast<uint32_t>(std::max(WantedTopMip, 0.0f)), TopMip);
+		}
+
+		Texture.WantedMips = NumMips - TopMip;
+	}
+}
+
+void TextureStreamingManager::UpdateBudgetedMips(size_t PoolSize)
+{
+	struct MipStep
+	{
+		StreamingTexture* Texture;
+		uint32_t NumMips;
+		float Priority;
+	};
+
+	m_Stats.TailSize = m_Stats.WantedSize = 0u;
+
+	std::vector<MipStep> Steps;
+	for (auto& [Key, Texture] : m_Textures)
+	{
+		Texture.BudgetedMips = Texture.Target->GetNumTailMips();
+
+		m_Stats.TailSize += Texture.Target->GetMipsSize(Texture.BudgetedMips);
+		m_Stats.WantedSize += Texture.Target->GetMipsSize(Texture.WantedMips);
+
+		for (uint32_t NumMips = Texture.BudgetedMips + 1u; NumMips <= Texture.WantedMips; ++NumMips)
+		{
+			Steps.emplace_back(MipStep{ &Texture, NumMips, GetPriority(Texture, NumMips - 1u) });
+		}
+	}
+
+	/// Every step adds the next more detailed mip of one texture, the most magnified textures are served first. The priority of
+	/// a texture's steps drops with every mip, so sorting keeps each texture's steps in order, ties are broken by the mip count.
+	std::sort(Steps.begin(), Steps.end(), [](const MipStep& Lhs, const MipStep& Rhs) {
+		return Lhs.Priority != Rhs.Priority ? Lhs.Priority > Rhs.Priority : Lhs.NumMips < Rhs.NumMips;
+	});
+
+	size_t BudgetedSize = m_Stats.TailSize;
+	for (const auto& Step : Steps)
+	{
+		auto& Texture = *Step.Texture;
+		if (Step.NumMips != Texture.BudgetedMips + 1u)
+		{
+			continue;
+		}
+
+		const size_t StepSize = Texture.Target->GetMipsSize(Step.NumMips) - Texture.Target->GetMipsSize(Texture.BudgetedMips);
+		if (BudgetedSize + StepSize > PoolSize)
+		{
+			continue;
+		}
+
+		BudgetedSize += StepSize;
+		Texture.BudgetedMips = Step.NumMips;
+	}
+
+	m_Stats.BudgetedSize = BudgetedSize;
+
+	if (m_Stats.TailSize > PoolSize)
+	{
+		LOG_WARNING(LogDefault, "Tail mips of the streamed textures need {} MB, more than the {} MB pool", m_Stats.TailSize / Megabyte, PoolSize / Megabyte);
+	}
+}
+
+size_t TextureStreamingManager::GetCommittedSize() const
+{
+	size_t Size = 0u;
+
+	for (const auto& [Key, Texture] : m_Textures)
+	{
+		Size += Texture.Target->GetMipsSize(Texture.Target->GetNumResidentMips());
+		if (Texture.Target->IsStreaming())
+		{
+			Size += Texture.Target->GetMipsSize(Texture.Target->GetNumRequestedMips());
+		}
+	}
+
+	for (const auto& Retired : m_RetiredTextures)
+	{
+		Size += Retired.Size;
+	}
+
+	return Size;
+}
+
+void TextureStreamingManager::IssueRequests(size_t PoolSize)
+{
+	uint32_t NumInflight = 0u;
+	std::vector<StreamingTexture*> Requests;
+
+	for (auto& [Key, Texture] : m_Textures)
+	{
+		if (Texture.Target->IsStreaming())
+		{
+			++NumInflight;
+		}
+		else if (Texture.Target->IsStreamable() && Texture.BudgetedMips != Texture.Target->GetNumResidentMips())
+		{
+			Requests.push_back(&Texture);
+		}
+	}
+
+	/// Stream outs free memory for the stream ins and go first, stream ins are ordered by how blurry the texture is now.
+	std::sort(Requests.begin(), Requests.end(), [](const StreamingTexture* Lhs, const StreamingTexture* Rhs) {
+		const bool LhsOut = Lhs->BudgetedMips < Lhs->Target->GetNumResidentMips();
+		const bool RhsOut = Rhs->BudgetedMips < Rhs->Target->GetNumResidentMips();
+		if (LhsOut != RhsOut)
+		{
+			return LhsOut;
+		}
+
+		return GetPriority(*Lhs, Lhs->Target->GetNumResidentMips()) > GetPriority(*Rhs, Rhs->Target->GetNumResidentMips());
+	});
+
+	/// The old texture lives until the new one is swapped in and the GPU is done with it, so every request temporarily needs
+	/// the whole new texture on top of the committed memory.
+	size_t CommittedSize = GetCommittedSize();
+	const uint32_t MaxInflight = std::max(CVarTextureStreamingMaxInflightRequests.Get(), 1u);
+
+	for (auto Texture : Requests)
+	{
+		if (NumInflight >= MaxInflight)
+		{
+			break;
+		}
+
+		/// A pool that shrank below the committed memory still lets one stream out through at a time, or nothing would ever be freed.
+		const bool StreamIn = Texture->BudgetedMips > Texture->Target->GetNumResidentMips();
+		const size_t RequestSize = Texture->Target->GetMipsSize(Texture->BudgetedMips);
+		if (CommittedSize + RequestSize > PoolSize && (StreamIn || NumInflight))
+		{
+			continue;
+		}
+
+		const bool Issued = StreamIn ? Texture->Target->StreamIn(Texture->BudgetedMips) : Texture->Target->StreamOut(Texture->BudgetedMips);
+		if (Issued)
+		{
+			CommittedSize += RequestSize;
+			++NumInflight;
+		}
+	}
+}
+
+void TextureStreamingManager::Finalize()
+{
+	for (auto& [Key, Texture] : m_Textures)
+	{
+		Texture.Target->ReleaseRHI();
+	}
+
+	m_Textures.clear();
+	ReleaseRetiredTextures(true);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Core/Singleton.h"
+#include "Core/Math/Vector3.h"
+#include "Asset/Texture.h"
+
+/// A point the scene is seen from. ScreenScale turns a world size seen at distance one into pixels.
+struct TextureStreamingView
+{
+	Math::Vector3 Origin;
+	float ScreenScale = 0.0f;
+
+	static TextureStreamingView Create(const class Camera& InCamera, float ViewHeight);
+};
+
+/// Sizes in bytes of device memory. Committed counts the resident mips, the textures being recreated by in flight requests
+/// and the replaced textures the GPU may still read. Requests are only issued while it fits into the pool, so it exceeds the
+/// pool only when the tail mips alone do or the pool shrank below what is already committed.
+struct TextureStreamingStats
+{
+	size_t PoolSize = 0u;
+	size_t TailSize = 0u;
+	size_t WantedSize = 0u;
+	size_t BudgetedSize = 0u;
+	size_t ResidentSize = 0u;
+	size_t CommittedSize = 0u;
+	uint32_t NumTextures = 0u;
+	uint32_t NumStreamingTextures = 0u;
+};
+
+class TextureStreamingManager : public Singleton<TextureStreamingManager>
+{
+public:
+	/// Once per frame on the main thread. Swaps in completed requests, computes the wanted mips of every texture from the largest
+	/// screen size of the primitives using it, fits the wanted mips into the pool and issues the most urgent requests.
+	void Update(const class Scene& InScene, const std::vector<TextureStreamingView>& Views);
+
+	/// Waits for every request and releases the textures of all tracked assets.
+	void Finalize();
+
+	inline const TextureStreamingStats& GetStats() const { return m_Stats; }
+protected:
+	ALLOW_ACCESS(TextureStreamingManager);
+private:
+	struct StreamingTexture
+	{
+		std::shared_ptr<Texture> Target;
+		float ScreenSize = 0.0f;
+		uint32_t WantedMips = 0u;
+		uint32_t BudgetedMips = 0u;
+		uint64_t LastSeenFrame = 0u;
+	};
+
+	struct RetiredTexture
+	{
+		RHITexturePtr Resource;
+		size_t Size = 0u;
+		uint64_t Frame = 0u;
+	};
+
+	void FinishRequests();
+	void GatherTextures(const class Scene& InScene, const std::vector<TextureStreamingView>& Views);
+	void UpdateBudgetedMips(size_t PoolSize);
+	void IssueRequests(size_t PoolSize);
+	void ReleaseRetiredTextures(bool Force);
+
+	size_t GetCommittedSize() const;
+
+	/// Pixels per texel of the most detailed resident mip, larger means blurrier.
+	static float GetPriority(const StreamingTexture& Texture, uint32_t NumMips);
+
+	std::unordered_map<const Texture*, StreamingTexture> m_Textures;
+	std::deque<RetiredTexture> m_RetiredTextures;
+	uint64_t m_Frame = 0u;
+	TextureStreamingStats m_Stats;
+};
@@ -2,14 +2,22 @@
 
 #include "Core/Math/AABB.h"
 #include "Core/Math/Sphere.h"
+#include "Core/Math/Matrix.h"
 
 class BoxSphereBounds
 {
 public:
 	BoxSphereBounds() = default;
+	/// The sphere is centered on the box origin.
 	BoxSphereBounds(const Math::Vector3& Origin, const Math::Vector3& Extents, const float Radius)
+		: BoxSphereBounds(Origin, Extents, Origin, Radius)
+	{
+	}
+
+	BoxSphereBounds(const Math::Vector3& Origin, const Math::Vector3& Extents, const Math::Vector3& SphereCenter, const float Radius)
 		: m_Origin(Origin)
 		, m_Extents(Extents)
+		, m_SphereCenter(SphereCenter)
 		, m_SphereRadius(Radius)
 	{
 	}
@@ -17,7 +25,36 @@ public:
 	inline const Math::Vector3& GetOrigin() const { return m_Origin; }
 	inline const Math::Vector3& GetExtents() const { return m_Extents; }
 	inline Math::AABB GetAABB() const { return Math::AABB(m_Origin - m_Extents, m_Origin + m_Extents); }
-	inline Math::Sphere GetSphere() const { return Math::Sphere(m_Origin, m_SphereRadius); }
+	inline Math::Sphere GetSphere() const { return Math::Sphere(m_SphereCenter, m_SphereRadius); }
+
+	/// The box encloses the transformed box (Arvo), the sphere center moves with the affine Transform and the radius grows by its largest
+	/// axis scale.
+	BoxSphereBounds TransformBy(const Math::Matrix& Transform) const
+	{
+		const auto& M = Transform.m;
+
+		auto TransformPoint = [&M](const Math::Vector3& Point) {
+			return Math::Vector3(
+				Point.x * M[0u][0u] + Point.y * M[1u][0u] + Point.z * M[2u][0u] + M[3u][0u],
+				Point.x * M[0u][1u] + Point.y * M[1u][1u] + Point.z * M[2u][1u] + M[3u][1u],
+				Point.x * M[0u][2u] + Point.y * M[1u][2u] + Point.z * M[2u][2u] + M[3u][2u]);
+		};
+
+		float MaxAxisLengthSq = 0.0f;
+		for (uint32_t Row = 0u; Row < 3u; ++Row)
+		{
+			MaxAxisLengthSq = std::max(MaxAxisLengthSq, M[Row][0u] * M[Row][0u] + M[Row][1u] * M[Row][1u] + M[Row][2u] * M[Row][2u]);
+		}
+
+		return BoxSphereBounds(
+			TransformPoint(m_Origin),
+			Math::Vector3(
+				m_Extents.x * std::fabs(M[0u][0u]) + m_Extents.y * std::fabs(M[1u][0u]) + m_Extents.z * std::fabs(M[2u][0u]),
+				m_Extents.x * std::fabs(M[0u][1u]) + m_Extents.y * std::fabs(M[1u][1u]) + m_Extents.z * std::fabs(M[2u][1u]),
+				m_Extents.x * std::fabs(M[0u][2u]) + m_Extents.y * std::fabs(M[1u][2u]) + m_Extents.z * std::fabs(M[2u][2u])),
+			TransformPoint(m_SphereCenter),
+			m_SphereRadius * std::sqrt(MaxAxisLengthSq));
+	}
 
 	template<class Archive>
 	void serialize(Archive& Ar)
@@ -25,12 +62,14 @@ public:
 		Ar(
 			CEREAL_NVP(m_Origin),
 			CEREAL_NVP(m_Extents),
+			CEREAL_NVP(m_SphereCenter),
 			CEREAL_NVP(m_SphereRadius)
 		);
 	}
 private:
 	Math::Vector3 m_Origin;
 	Math::Vector3 m_Extents;
+	Math::Vector3 m_SphereCenter;
 
 	float m_SphereRadius = 0.0f;
 };
@@ -0,0 +1,84 @@
+#include "Scene/Components/AnimationBlendTree.h"
+
+Math::TransformSoA& AnimationContext::AcquirePose()
+{
+	if (m_NumUsedPoses == m_Poses.size())
+	{
+		m_Poses.emplace_back(std::make_unique<Math::TransformSoA>());
+	}
+
+	return *m_Poses[m_NumUsedPoses++];
+}
+
+void AnimationContext::ReleasePose()
+{
+	assert(m_NumUsedPoses > 0u);
+	--m_NumUsedPoses;
+}
+
+void AnimationClipNode::Advance(float ElapsedSeconds)
+{
+	const float Duration = m_Clip->GetDuration();
+	m_Time += ElapsedSeconds * m_PlayRate;
+
+	if (Duration <= 0.0f)
+	{
+		m_Time = 0.0f;
+	}
+	else if (m_Loop)
+	{
+		m_Time = std::fmod(m_Time, Duration);
+		m_Time = m_Time < 0.0f ? m_Time + Duration : m_Time;
+	}
+	else
+	{
+		m_Time = std::clamp(m_Time, 0.0f, Duration);
+	}
+}
+
+void AnimationClipNode::Evaluate(AnimationContext& Context, Math::TransformSoA& OutPose)
+{
+	m_Clip->Sample(m_Time, Context.GetDefaultPose(), m_Cache, OutPose);
+}
+
+void AnimationLerpNode::Advance(float ElapsedSeconds)
+{
+	m_From->Advance(ElapsedSeconds);
+	m_To->Advance(ElapsedSeconds);
+}
+
+void AnimationLerpNode::Evaluate(AnimationContext& Context, Math::TransformSoA& OutPose)
+{
+	/// Only the weighted side is needed at either end.
+	if (m_Weight <= 0.0f || m_Weight >= 1.0f)
+	{
+		(m_Weight <= 0.0f ? m_From : m_To)->Evaluate(Context, OutPose);
+		return;
+	}
+
+	auto& ToPose = Context.AcquirePose();
+	m_From->Evaluate(Context, OutPose);
+	m_To->Evaluate(Context, ToPose);
+	Math::BlendTransforms(OutPose, ToPose, m_Weight, OutPose);
+	Context.ReleasePose();
+}
+
+void AnimationAdditiveNode::Advance(float ElapsedSeconds)
+{
+	m_Base->Advance(ElapsedSeconds);
+	m_Additive->Advance(ElapsedSeconds);
+}
+
+void AnimationAdditiveNode::Evaluate(AnimationContext& Context, Math::TransformSoA& OutPose)
+{
+	m_Base->Evaluate(Context, OutPose);
+	if (m_Weight <= 0.0f)
+	{
+		return;
+	}
+
+	auto& AdditivePose = Context.AcquirePose();
+	m_Additive->Evaluate(Context, AdditivePose);
+	Math::AddTransforms(OutPose, AdditivePose, m_Weight, OutPose);
+	Context.ReleasePose();
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Scene/Components/AnimationClip.h"
+
+/// Scratch poses for evaluating a blend tree, reused from frame to frame so evaluation does not allocate once warmed up.
+class AnimationContext
+{
+public:
+	AnimationContext(const Math::TransformSoA& DefaultPose)
+		: m_DefaultPose(DefaultPose)
+	{
+	}
+
+	inline const Math::TransformSoA& GetDefaultPose() const { return m_DefaultPose; }
+
+	/// Stack like, every acquired pose must be released in reverse order.
+	Math::TransformSoA& AcquirePose();
+	void ReleasePose();
+private:
+	const Math::TransformSoA& m_DefaultPose;
+	std::vector<std::unique_ptr<Math::TransformSoA>> m_Poses;
+	uint32_t m_NumUsedPoses = 0u;
+};
+
+/// Blend trees are owned per instance: nodes keep their own playback state.
+class AnimationBlendNode
+{
+public:
+	virtual ~AnimationBlendNode() = default;
+
+	virtual void Advance(float ElapsedSeconds) = 0;
+
+	/// Writes the local pose, one transform per skeleton bone.
+	virtual void Evaluate(AnimationContext& Context, Math::TransformSoA& OutPose) = 0;
+};
+
+class AnimationClipNode : public AnimationBlendNode
+{
+public:
+	AnimationClipNode(const std::shared_ptr<const AnimationClip>& Clip, float PlayRate = 1.0f, bool Loop = true)
+		: m_Clip(Clip)
+		, m_PlayRate(PlayRate)
+		, m_Loop(Loop)
+	{
+		assert(m_Clip);
+	}
+
+	inline const AnimationClip& GetClip() const { return *m_Clip; }
+
+	inline float GetTime() const { return m_Time; }
+	inline void SetTime(float Time) { m_Time = Time; }
+
+	inline void SetPlayRate(float PlayRate) { m_PlayRate = PlayRate; }
+
+	void Advance(float ElapsedSeconds) override final;
+	void Evaluate(AnimationContext& Context, Math::TransformSoA& OutPose) override final;
+private:
+	std::shared_ptr<const AnimationClip> m_Clip;
+	AnimationSamplingCache m_Cache;
+	float m_Time = 0.0f;
+	float m_PlayRate = 1.0f;
+	bool m_Loop = true;
+};
+
+/// Lerp between two poses, Weight 0 is From, 1 is To.
+class AnimationLerpNode : public AnimationBlendNode
+{
+public:
+	AnimationLerpNode(std::unique_ptr<AnimationBlendNode>&& From, std::unique_ptr<AnimationBlendNode>&& To, float Weight = 0.0f)
+		: m_From(std::move(From))
+		, m_To(std::move(To))
+		, m_Weight(Weight)
+	{
+		assert(m_From && m_To);
+	}
+
+	inline float GetWeight() const { return m_Weight; }
+	inline void SetWeight(float Weight) { m_Weight = std::clamp(Weight, 0.0f, 1.0f); }
+
+	void Advance(float ElapsedSeconds) override final;
+	void Evaluate(AnimationContext& Context, Math::TransformSoA& OutPose) override final;
+private:
+	std::unique_ptr<AnimationBlendNode> m_From;
+	std::unique_ptr<AnimationBlendNode> m_To;
+	float m_Weight = 0.0f;
+};
+
+/// Base pose with an additive pose (see RawAnimationClip::MakeAdditive) layered on top by Weight.
+class AnimationAdditiveNode : public AnimationBlendNode
+{
+public:
+	AnimationAdditiveNode(std::unique_ptr<AnimationBlendNode>&& Base, std::unique_ptr<AnimationBlendNode>&& Additive, float Weight = 1.0f)
+		: m_Base(std::move(Base))
+		, m_Additive(std::move(Additive))
+		, m_Weight(Weight)
+	{
+		assert(m_Base && m_Additive);
+	}
+
+	inline float GetWeight() const { return m_Weight; }
+	inline void SetWeight(float Weight) { m_Weight = std::clamp(Weight, 0.0f, 1.0f); }
+
+	void Advance(float ElapsedSeconds) override final;
+	void Evaluate(AnimationContext& Context, Math::TransformSoA& OutPose) override final;
+private:
+	std::unique_ptr<AnimationBlendNode> m_Base;
+	std::unique_ptr<AnimationBlendNode> m_Additive;
+	float m_Weight = 1.0f;
+};
@@ -0,0 +1,435 @@
+#include "Scene/Components/AnimationClip.h"
+
+static constexpr float QuantizedTimeScale = 65535.0f;
+static constexpr float QuantizedValueScale = 65535.0f;
+static constexpr float QuantizedRotationScale = 32767.0f;
+
+/// Smallest three components of a unit quaternion lie in [-1/sqrt(2), 1/sqrt(2)].
+static constexpr float RotationRange = 0.70710678f;
+
+template<class T>
+using RawKey = RawAnimationTrack::Key<T>;
+
+static float GetError(const Math::Vector3& Left, const Math::Vector3& Right)
+{
+	return std::max({ std::fabs(Left.x - Right.x), std::fabs(Left.y - Right.y), std::fabs(Left.z - Right.z) });
+}
+
+static float GetError(const Math::Quaternion& Left, const Math::Quaternion& Right)
+{
+	/// q and -q are the same rotation.
+	const float Sign = Left.Dot(Right) < 0.0f ? -1.0f : 1.0f;
+	return std::max({ std::fabs(Left.x - Right.x * Sign), std::fabs(Left.y - Right.y * Sign), std::fabs(Left.z - Right.z * Sign), std::fabs(Left.w - Right.w * Sign) });
+}
+
+static Math::Vector3 Interpolate(const Math::Vector3& From, const Math::Vector3& To, float Alpha)
+{
+	return Math::Vector3(From.x + (To.x - From.x) * Alpha, From.y + (To.y - From.y) * Alpha, From.z + (To.z - From.z) * Alpha);
+}
+
+/// Same normalized lerp as Math::InterpolateTransforms, so the reduction measures what the sampler plays back.
+static Math::Quaternion Interpolate(const Math::Quaternion& From, const Math::Quaternion& To, float Alpha)
+{
+	const float Sign = From.Dot(To) < 0.0f ? -1.0f : 1.0f;
+	Math::Quaternion Result(
+		From.x + (To.x * Sign - From.x) * Alpha,
+		From.y + (To.y * Sign - From.y) * Alpha,
+		From.z + (To.z * Sign - From.z) * Alpha,
+		From.w + (To.w * Sign - From.w) * Alpha);
+	Result.Normalize();
+	return Result;
+}
+
+/// Greedy reduction: from every kept key, extend the segment as long as it reproduces all skipped keys within Tolerance.
+/// A channel that never leaves the tolerance of its first key collapses to that key.
+template<class T>
+static std::vector<RawKey<T>> ReduceKeys(const std::vector<RawKey<T>>& Keys, float Tolerance)
+{
+	if (Keys.size() <= 1u)
+	{
+		return Keys;
+	}
+
+	bool Constant = true;
+	for (const auto& Key : Keys)
+	{
+		Constant &= GetError(Key.Value, Keys.front().Value) <= Tolerance;
+	}
+	if (Constant)
+	{
+		return { Keys.front() };
+	}
+
+	auto IsReproduced = [&Keys, Tolerance](size_t First, size_t Last) {
+		const float Duration = Keys[Last].Time - Keys[First].Time;
+		for (size_t Index = First + 1u; Index < Last; ++Index)
+		{
+			const float Alpha = Duration > 0.0f ? (Keys[Index].Time - Keys[First].Time) / Duration : 0.0f;
+			if (GetError(Interpolate(Keys[First].Value, Keys[Last].Value, Alpha), Keys[Index].Value) > Tolerance)
+			{
+				return false;
+			}
+		}
+		return true;
+	};
+
+	std::vector<RawKey<T>> Reduced{ Keys.front() };
+	size_t First = 0u;
+	while (First + 1u < Keys.size())
+	{
+		size_t Last = First + 1u;
+		while (Last + 1u < Keys.size() && IsReproduced(First, Last + 1u))
+		{
+			++Last;
+		}
+
+		Reduced.push_back(Keys[Last]);
+		First = Last;
+	}
+
+	return Reduced;
+}
+
+static uint16_t QuantizeTime(float Time, float Duration)
+{
+	return Duration > 0.0f ? static_cast<uint16_t>(std::lround(std::clamp(Time / Duration, 0.0f, 1.0f) * QuantizedTimeScale)) : 0u;
+}
+
+static std::array<uint16_t, 3u> EncodeRotation(const Math::Quaternion& Rotation)
+{
+	const float Components[4u] = { Rotation.x, Rotation.y, Rotation.z, Rotation.w };
+
+	uint32_t Largest = 0u;
+	for (uint32_t Index = 1u; Index < 4u; ++Index)
+	{
+		Largest = std::fabs(Components[Index]) > std::fabs(Components[Largest]) ? Index : Largest;
+	}
+
+	/// The dropped component is rebuilt as a positive square root, flip the quaternion to match.
+	const float Sign = Components[Largest] < 0.0f ? -1.0f : 1.0f;
+
+	std::array<uint16_t, 3u> Encoded{};
+	for (uint32_t Index = 0u, Slot = 0u; Index < 4u; ++Index)
+	{
+		if (Index != Largest)
+		{
+			const float Normalized = std::clamp(Components[Index] * Sign / RotationRange, -1.0f, 1.0f) * 0.5f + 0.5f;
+			Encoded[Slot++] = static_cast<uint16_t>(std::lround(Normalized * QuantizedRotationScale));
+		}
+	}
+
+	/// The index of the dropped component goes into the spare top bits.
+	Encoded[0u] |= static_cast<uint16_t>((Largest & 1u) << 15u);
+	Encoded[1u] |= static_cast<uint16_t>((Largest >> 1u) << 15u);
+	return Encoded;
+}
+
+static Math::Quaternion DecodeRotation(const std::array<uint16_t, 3u>& Encoded)
+{
+	const uint32_t Largest = ((Encoded[0u] >> 15u) & 1u) | (((Encoded[1u] >> 15u) & 1u) << 1u);
+
+	float Components[4u];
+	float LengthSq = 0.0f;
+	for (uint32_t Index = 0u, Slot = 0u; Index < 4u; ++Index)
+	{
+		if (Index != Largest)
+		{
+			const float Normalized = static_cast<float>(Encoded[Slot++] & 0x7FFFu) / QuantizedRotationScale;
+			Components[Index] = (Normalized * 2.0f - 1.0f) * RotationRange;
+			LengthSq += Components[Index] * Components[Index];
+		}
+	}
+	Components[Largest] = std::sqrt(std::max(1.0f - LengthSq, 0.0f));
+
+	return Math::Quaternion(Components);
+}
+
+void RawAnimationClip::MakeAdditive()
+{
+	for (auto& Track : Tracks)
+	{
+		if (!Track.Translations.empty())
+		{
+			const Math::Vector3 Reference = Track.Translations.front().Value;
+			for (auto& Key : Track.Translations)
+			{
+				Key.Value = Math::Vector3(Key.Value.x - Reference.x, Key.Value.y - Reference.y, Key.Value.z - Reference.z);
+			}
+		}
+
+		if (!Track.Scales.empty())
+		{
+			const Math::Vector3 Reference = Track.Scales.front().Value;
+			auto SafeDivide = [](float Value, float Divisor) { return std::fabs(Divisor) > 1e-6f ? Value / Divisor : 1.0f; };
+			for (auto& Key : Track.Scales)
+			{
+				Key.Value = Math::Vector3(SafeDivide(Key.Value.x, Reference.x), SafeDivide(Key.Value.y, Reference.y), SafeDivide(Key.Value.z, Reference.z));
+			}
+		}
+
+		if (!Track.Rotations.empty())
+		{
+			/// Delta * Reference = Key, operator* rotates by the left operand first: the delta applies before the base pose as in Math::AddTransforms.
+			const Math::Quaternion InverseReference = Track.Rotations.front().Value.Conjugate();
+			for (auto& Key : Track.Rotations)
+			{
+				Key.Value = Key.Value * InverseReference;
+			}
+		}
+	}
+
+	Additive = true;
+}
+
+std::shared_ptr<AnimationClip> AnimationClip::Compress(const RawAnimationClip& Raw, const AnimationCompressionSettings& Settings)
+{
+	auto Clip = std::make_shared<AnimationClip>();
+	Clip->m_Name = Raw.Name;
+	Clip->m_Duration = Raw.Duration;
+	Clip->m_Additive = Raw.Additive;
+	Clip->m_NumTracks = static_cast<uint32_t>(Raw.Tracks.size());
+
+	for (auto& Keys : Clip->m_Keys)
+	{
+		Keys.Channels.resize(Raw.Tracks.size());
+	}
+
+	auto AddVectorKeys = [&Clip](ChannelKeys& Keys, Channel& Target, const std::vector<RawKey<Math::Vector3>>& Reduced) {
+		if (Reduced.empty())
+		{
+			return;
+		}
+
+		float Max[3u] = { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+		Target.Min[0u] = Target.Min[1u] = Target.Min[2u] = std::numeric_limits<float>::max();
+		for (const auto& Key : Reduced)
+		{
+			const float Value[3u] = { Key.Value.x, Key.Value.y, Key.Value.z };
+			for (uint32_t Component = 0u; Component < 3u; ++Component)
+			{
+				Target.Min[Component] = std::min(Target.Min[Component], Value[Component]);
+				Max[Component] = std::max(Max[Component], Value[Component]);
+			}
+		}
+
+		for (uint32_t Component = 0u; Component < 3u; ++Component)
+		{
+			Target.Extent[Component] = Max[Component] - Target.Min[Component];
+		}
+
+		for (const auto& Key : Reduced)
+		{
+			const float Value[3u] = { Key.Value.x, Key.Value.y, Key.Value.z };
+			std::array<uint16_t, 3u> Encoded{};
+			for (uint32_t Component = 0u; Component < 3u; ++Component)
+			{
+				const float Normalized = Target.Extent[Component] > 0.0f ? (Value[Component] - Target.Min[Component]) / Target.Extent[Component] : 0.0f;
+				Encoded[Component] = static_cast<uint16_t>(std::lround(std::clamp(Normalized, 0.0f, 1.0f) * QuantizedValueScale));
+			}
+
+			Keys.Times.push_back(QuantizeTime(Key.Time, Clip->m_Duration));
+			Keys.Values.push_back(Encoded);
+		}
+	};
+
+	for (size_t TrackIndex = 0u; TrackIndex < Raw.Tracks.size(); ++TrackIndex)
+	{
+		const auto& Track = Raw.Tracks[TrackIndex];
+
+		{
+			auto& Keys = Clip->m_Keys[EChannel::Translation];
+			auto& Target = Keys.Channels[TrackIndex];
+			const auto Reduced = ReduceKeys(Track.Translations, Settings.TranslationTolerance);
+
+			Target.FirstKey = static_cast<uint32_t>(Keys.Values.size());
+			Target.NumKeys = static_cast<uint32_t>(Reduced.size());
+			AddVectorKeys(Keys, Target, Reduced);
+		}
+
+		{
+			auto& Keys = Clip->m_Keys[EChannel::Scale];
+			auto& Target = Keys.Channels[TrackIndex];
+			const auto Reduced = ReduceKeys(Track.Scales, Settings.ScaleTolerance);
+
+			Target.FirstKey = static_cast<uint32_t>(Keys.Values.size());
+			Target.NumKeys = static_cast<uint32_t>(Reduced.size());
+			AddVectorKeys(Keys, Target, Reduced);
+		}
+
+		{
+			/// Keep consecutive keys in the same hemisphere, so interpolating between them takes the short way as the importer meant.
+			auto Rotations = Track.Rotations;
+			for (size_t Index = 1u; Index < Rotations.size(); ++Index)
+			{
+				auto& Value = Rotations[Index].Value;
+				if (Value.Dot(Rotations[Index - 1u].Value) < 0.0f)
+				{
+					Value = Math::Quaternion(-Value.x, -Value.y, -Value.z, -Value.w);
+				}
+			}
+
+			auto& Keys = Clip->m_Keys[EChannel::Rotation];
+			auto& Target = Keys.Channels[TrackIndex];
+			const auto Reduced = ReduceKeys(Rotations, Settings.RotationTolerance);
+
+			Target.FirstKey = static_cast<uint32_t>(Keys.Values.size());
+			Target.NumKeys = static_cast<uint32_t>(Reduced.size());
+			for (const auto& Key : Reduced)
+			{
+				Keys.Times.push_back(QuantizeTime(Key.Time, Clip->m_Duration));
+				Keys.Values.push_back(EncodeRotation(Key.Value));
+			}
+		}
+	}
+
+	return Clip;
+}
+
+size_t AnimationClip::GetSize() const
+{
+	size_t Size = 0u;
+	for (const auto& Keys : m_Keys)
+	{
+		Size += Keys.Channels.size() * sizeof(Channel) + Keys.Times.size() * sizeof(uint16_t) + Keys.Values.size() * sizeof(std::array<uint16_t, 3u>);
+	}
+	return Size;
+}
+
+void AnimationClip::DecodeKey(EChannel Type, const Channel& Target, uint32_t Key, Math::TransformLanes& Lanes, uint32_t Lane) const
+{
+	const auto& Encoded = m_Keys[Type].Values[Target.FirstKey + Key];
+
+	if (Type == EChannel::Rotation)
+	{
+		const Math::Quaternion Rotation = DecodeRotation(Encoded);
+		Lanes.RotationX[Lane] = Rotation.x;
+		Lanes.RotationY[Lane] = Rotation.y;
+		Lanes.RotationZ[Lane] = Rotation.z;
+		Lanes.RotationW[Lane] = Rotation.w;
+		return;
+	}
+
+	float Value[3u];
+	for (uint32_t Component = 0u; Component < 3u; ++Component)
+	{
+		Value[Component] = Target.Min[Component] + Target.Extent[Component] * (static_cast<float>(Encoded[Component]) / QuantizedValueScale);
+	}
+
+	float* Dst[3u] = { Lanes.TranslationX, Lanes.TranslationY, Lanes.TranslationZ };
+	if (Type == EChannel::Scale)
+	{
+		Dst[0u] = Lanes.ScaleX;
+		Dst[1u] = Lanes.ScaleY;
+		Dst[2u] = Lanes.ScaleZ;
+	}
+
+	Dst[0u][Lane] = Value[0u];
+	Dst[1u][Lane] = Value[1u];
+	Dst[2u][Lane] = Value[2u];
+}
+
+uint32_t AnimationClip::FindKey(const ChannelKeys& Keys, const Channel& Target, uint16_t Time, uint32_t Cursor) const
+{
+	static constexpr uint32_t MaxLinearSteps = 4u;
+
+	const uint16_t* Times = Keys.Times.data() + Target.FirstKey;
+	uint32_t Key = std::min(Cursor, Target.NumKeys - 1u);
+
+	if (Times[Key] <= Time)
+	{
+		for (uint32_t Step = 0u; Step < MaxLinearSteps; ++Step)
+		{
+			if (Key + 1u >= Target.NumKeys || Times[Key + 1u] > Time)
+			{
+				return Key;
+			}
+			++Key;
+		}
+	}
+
+	/// Jumped backwards or far ahead, e.g. looped or seeked.
+	const uint16_t* Next = std::upper_bound(Times, Times + Target.NumKeys, Time);
+	return Next == Times ? 0u : static_cast<uint32_t>(Next - Times - 1u);
+}
+
+void AnimationClip::Sample(float Time, const Math::TransformSoA& DefaultPose, AnimationSamplingCache& Cache, Math::TransformSoA& OutPose) const
+{
+	assert(m_Additive || DefaultPose.Size() == m_NumTracks);
+
+	Cache.From.Resize(m_NumTracks);
+	Cache.To.Resize(m_NumTracks);
+	Cache.Cursors.resize(m_NumTracks * static_cast<size_t>(EChannel::Num), 0u);
+
+	const size_t NumPadded = Cache.From.NumBlocks() * Math::SoALanes;
+	Cache.Alphas.resize(NumPadded * static_cast<size_t>(EChannel::Num), 0.0f);
+
+	Math::TransformLanes Identity;
+	for (uint32_t Lane = 0u; Lane < Math::SoALanes; ++Lane)
+	{
+		Identity.SetIdentity(Lane);
+	}
+
+	const float NormalizedTime = m_Duration > 0.0f ? std::clamp(Time / m_Duration, 0.0f, 1.0f) * QuantizedTimeScale : 0.0f;
+	const uint16_t KeyTime = static_cast<uint16_t>(NormalizedTime);
+
+	for (uint32_t ChannelIndex = 0u; ChannelIndex < static_cast<uint32_t>(EChannel::Num); ++ChannelIndex)
+	{
+		const EChannel Type = static_cast<EChannel>(ChannelIndex);
+		const auto& Keys = m_Keys[Type];
+		float* Alphas = Cache.Alphas.data() + NumPadded * ChannelIndex;
+		uint32_t* Cursors = Cache.Cursors.data() + static_cast<size_t>(m_NumTracks) * ChannelIndex;
+
+		for (uint32_t Track = 0u; Track < m_NumTracks; ++Track)
+		{
+			const auto& Target = Keys.Channels[Track];
+			auto& From = Cache.From.GetBlocks()[Track / Math::SoALanes];
+			auto& To = Cache.To.GetBlocks()[Track / Math::SoALanes];
+			const uint32_t Lane = Track % Math::SoALanes;
+
+			if (Target.NumKeys == 0u)
+			{
+				const auto& Default = m_Additive ? Identity : DefaultPose.GetBlocks()[Track / Math::SoALanes];
+				const uint32_t DefaultLane = m_Additive ? 0u : Lane;
+				switch (Type)
+				{
+				case EChannel::Translation:
+					From.TranslationX[Lane] = To.TranslationX[Lane] = Default.TranslationX[DefaultLane];
+					From.TranslationY[Lane] = To.TranslationY[Lane] = Default.TranslationY[DefaultLane];
+					From.TranslationZ[Lane] = To.TranslationZ[Lane] = Default.TranslationZ[DefaultLane];
+					break;
+				case EChannel::Rotation:
+					From.RotationX[Lane] = To.RotationX[Lane] = Default.RotationX[DefaultLane];
+					From.RotationY[Lane] = To.RotationY[Lane] = Default.RotationY[DefaultLane];
+					From.RotationZ[Lane] = To.RotationZ[Lane] = Default.RotationZ[DefaultLane];
+					From.RotationW[Lane] = To.RotationW[Lane] = Default.RotationW[DefaultLane];
+					break;
+				case EChannel::Scale:
+					From.ScaleX[Lane] = To.ScaleX[Lane] = Default.ScaleX[DefaultLane];
+					From.ScaleY[Lane] = To.ScaleY[Lane] = Default.ScaleY[DefaultLane];
+					From.ScaleZ[Lane] = To.ScaleZ[Lane] = Default.ScaleZ[DefaultLane];
+					break;
+				}
+
+				Alphas[Track] = 0.0f;
+				continue;
+			}
+
+			const uint32_t Key = FindKey(Keys, Target, KeyTime, Cursors[Track]);
+			const uint32_t NextKey = std::min(Key + 1u, Target.NumKeys - 1u);
+			Cursors[Track] = Key;
+
+			DecodeKey(Type, Target, Key, From, Lane);
+			DecodeKey(Type, Target, NextKey, To, Lane);
+
+			const float KeyStart = Keys.Times[Target.FirstKey + Key];
+			const float KeyEnd = Keys.Times[Target.FirstKey + NextKey];
+			Alphas[Track] = KeyEnd > KeyStart ? std::clamp((NormalizedTime - KeyStart) / (KeyEnd - KeyStart), 0.0f, 1.0f) : 0.0f;
+		}
+	}
+
+	Math::InterpolateTransforms(Cache.From, Cache.To,
+		Cache.Alphas.data() + NumPadded * static_cast<size_t>(EChannel::Translation),
+		Cache.Alphas.data() + NumPadded * static_cast<size_t>(EChannel::Rotation),
+		Cache.Alphas.data() + NumPadded * static_cast<size_t>(EChannel::Scale),
+		OutPose);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Core/Math/TransformSoA.h"
+#include "Core/Name.h"
+
+/// Keyframes of one bone as imported, times in seconds. An empty channel keeps the default pose of the bone.
+struct RawAnimationTrack
+{
+	template<class T>
+	struct Key
+	{
+		float Time = 0.0f;
+		T Value;
+	};
+
+	std::vector<Key<Math::Vector3>> Translations;
+	std::vector<Key<Math::Quaternion>> Rotations;
+	std::vector<Key<Math::Vector3>> Scales;
+};
+
+/// One track per skeleton bone.
+struct RawAnimationClip
+{
+	std::string Name;
+	float Duration = 0.0f;
+	bool Additive = false;
+	std::vector<RawAnimationTrack> Tracks;
+
+	/// Turns every key into the delta from the first key of its channel, for Math::AddTransforms.
+	void MakeAdditive();
+};
+
+/// Largest error key reduction may introduce, quantization adds at most half a step of the channel range on top.
+struct AnimationCompressionSettings
+{
+	float TranslationTolerance = 1e-4f;
+	float RotationTolerance = 1e-4f;
+	float ScaleTolerance = 1e-4f;
+};
+
+/// Decoding state of one playing clip, every instance needs its own. Cursors remember the last key per channel,
+/// so playing forwards only ever steps a key or two instead of searching.
+struct AnimationSamplingCache
+{
+	std::vector<uint32_t> Cursors;
+	Math::TransformSoA From;
+	Math::TransformSoA To;
+	std::vector<float> Alphas;
+};
+
+/// Compressed, immutable clip shared by all instances. Keys that linear interpolation reproduces within tolerance are dropped,
+/// times are quantized to 16 bits of the duration, translations and scales to 16 bits per component of their channel range,
+/// rotations to the smallest three components with 15 bits each.
+class AnimationClip
+{
+public:
+	static std::shared_ptr<AnimationClip> Compress(const RawAnimationClip& Raw, const AnimationCompressionSettings& Settings = AnimationCompressionSettings());
+
+	inline const std::string& GetName() const { return m_Name; }
+	inline float GetDuration() const { return m_Duration; }
+	inline bool IsAdditive() const { return m_Additive; }
+	inline uint32_t GetNumTracks() const { return m_NumTracks; }
+
+	/// Compressed keys and ranges, for statistics.
+	size_t GetSize() const;
+
+	/// Samples the local pose at Time, clamped to the clip. Undriven channels take DefaultPose, or identity for additive clips.
+	/// The keys are decoded per channel, interpolation runs on whole SoA blocks.
+	void Sample(float Time, const Math::TransformSoA& DefaultPose, AnimationSamplingCache& Cache, Math::TransformSoA& OutPose) const;
+private:
+	enum class EChannel : uint8_t
+	{
+		Translation,
+		Rotation,
+		Scale,
+		Num
+	};
+
+	struct Channel
+	{
+		uint32_t FirstKey = 0u;
+		uint32_t NumKeys = 0u;
+		float Min[3u] = {};
+		float Extent[3u] = {};
+	};
+
+	struct ChannelKeys
+	{
+		std::vector<Channel> Channels;
+		std::vector<uint16_t> Times;
+		std::vector<std::array<uint16_t, 3u>> Values;
+	};
+
+	void DecodeKey(EChannel Type, const Channel& Target, uint32_t Key, Math::TransformLanes& Lanes, uint32_t Lane) const;
+	uint32_t FindKey(const ChannelKeys& Keys, const Channel& Target, uint16_t Time, uint32_t Cursor) const;
+
+	std::string m_Name;
+	float m_Duration = 0.0f;
+	bool m_Additive = false;
+	uint32_t m_NumTracks = 0u;
+	Array<ChannelKeys, EChannel> m_Keys;
+};
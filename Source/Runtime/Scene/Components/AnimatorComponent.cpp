@@ -0,0 +1,48 @@
+#include "Scene/Components/AnimatorComponent.h"
+#include "Scene/Components/SkeletalMeshComponent.h"
+#include "Scene/Components/Skeleton.h"
+
+void AnimatorComponent::SetSkeleton(const std::shared_ptr<Skeleton>& InSkeleton)
+{
+	assert(InSkeleton);
+
+	m_Skeleton = InSkeleton;
+	m_Context = std::make_unique<AnimationContext>(m_Skeleton->GetBindPose());
+	m_LocalPose = m_Skeleton->GetBindPose();
+}
+
+void AnimatorComponent::AddTarget(const std::shared_ptr<SkeletalMeshComponent>& Target)
+{
+	assert(Target && Target->HasSkinnedMesh() && Target->GetSkinnedMesh().GetSkeleton() == m_Skeleton.get());
+	m_Targets.push_back(Target);
+}
+
+void AnimatorComponent::Evaluate(float ElapsedSeconds)
+{
+	if (!m_Skeleton || !m_BlendTree)
+	{
+		return;
+	}
+
+	m_BlendTree->Advance(ElapsedSeconds);
+	m_BlendTree->Evaluate(*m_Context, m_LocalPose);
+
+	Math::ComputeMatrices(m_LocalPose, m_LocalMatrices);
+	Math::ComposeLocalToWorld(m_LocalMatrices, m_Skeleton->GetParents(), m_ModelPose);
+
+	for (auto& Target : m_Targets)
+	{
+		auto& LocalPose = Target->GetLocalPose();
+		for (uint32_t Bone = 0u; Bone < m_Skeleton->GetNumBones(); ++Bone)
+		{
+			LocalPose[Bone] = m_LocalMatrices.Get(Bone);
+		}
+	}
+}
+
+TFTaskEventPtr AnimatorComponent::EvaluateAsync(const std::vector<AnimatorComponent*>& Animators, float ElapsedSeconds)
+{
+	return TFTask::ParallelFor(Animators.begin(), Animators.end(), [ElapsedSeconds](AnimatorComponent* Animator) {
+		Animator->Evaluate(ElapsedSeconds);
+	});
+}
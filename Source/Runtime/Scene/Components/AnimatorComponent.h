@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Scene/Components/ComponentBase.h"
+#include "Scene/Components/AnimationBlendTree.h"
+#include "Async/Task.h"
+
+/// Plays a blend tree on a skeleton and poses the skeletal meshes bound to it.
+/// Not ticked one by one, Scene::Tick evaluates all animators of a frame together with EvaluateAsync.
+class AnimatorComponent : public ComponentBase
+{
+public:
+	REGISTER_COMPONENT(AnimatorComponent, ComponentBase);
+
+	using ComponentBase::ComponentBase;
+
+	void SetSkeleton(const std::shared_ptr<class Skeleton>& InSkeleton);
+	inline const class Skeleton* GetSkeleton() const { return m_Skeleton.get(); }
+
+	inline void SetBlendTree(std::unique_ptr<AnimationBlendNode>&& BlendTree) { m_BlendTree = std::move(BlendTree); }
+	inline AnimationBlendNode* GetBlendTree() const { return m_BlendTree.get(); }
+
+	/// Clips available to the blend tree, e.g. all the animations of an imported scene.
+	inline void AddClip(const std::shared_ptr<AnimationClip>& Clip) { m_Clips.push_back(Clip); }
+	inline const std::vector<std::shared_ptr<AnimationClip>>& GetClips() const { return m_Clips; }
+
+	/// Targets must use the animator's skeleton.
+	void AddTarget(const std::shared_ptr<class SkeletalMeshComponent>& Target);
+
+	/// Advances the blend tree, samples the local pose, converts it to model space and hands it to the targets.
+	void Evaluate(float ElapsedSeconds);
+
+	inline const Math::TransformSoA& GetLocalPose() const { return m_LocalPose; }
+	inline const Math::MatrixSoA& GetModelPose() const { return m_ModelPose; }
+
+	/// One job per animator, animators must stay alive until the returned event is done.
+	static TFTaskEventPtr EvaluateAsync(const std::vector<AnimatorComponent*>& Animators, float ElapsedSeconds);
+private:
+	std::shared_ptr<class Skeleton> m_Skeleton;
+	std::unique_ptr<AnimationContext> m_Context;
+	std::unique_ptr<AnimationBlendNode> m_BlendTree;
+	std::vector<std::shared_ptr<AnimationClip>> m_Clips;
+	std::vector<std::shared_ptr<class SkeletalMeshComponent>> m_Targets;
+
+	Math::TransformSoA m_LocalPose;
+	Math::MatrixSoA m_LocalMatrices;
+	Math::MatrixSoA m_ModelPose;
+};
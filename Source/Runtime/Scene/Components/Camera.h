@@ -39,6 +39,12 @@ public:
 	inline const Math::Vector3& GetEyePosition() const { return m_Eye; }
 	inline const Math::Vector3& GetLookAt() const { return m_LookAt; }
 	inline Math::Matrix GetViewProjectionMatrix() const { return m_View * m_Projection; }
+	inline const Math::Matrix& GetInverseViewMatrix() const { return m_InverseView; }
+
+	inline float GetFov() const { return m_Fov; }
+	inline float GetAspect() const { return m_Aspect; }
+	inline float GetNearPlane() const { return m_NearPlane; }
+	inline float GetFarPlane() const { return m_FarPlane; }
 
 	inline void SetClipToBoundary(bool Clip, const Math::Vector3& Min, const Math::Vector3& Max)
 	{
@@ -2,9 +2,5 @@
 
 #include "Core/Cereal.h"
 #include "Scene/Components/ComponentBase.h"
-
-class SkeletalMeshComponent : public ComponentBase
-{
-public:
-	REGISTER_COMPONENT(SkeletalMeshComponent, ComponentBase);
-};
\ No newline at end of file
+#include "Scene/Components/SkeletalMeshComponent.h"
+#include "Scene/Components/AnimatorComponent.h"
@@ -11,11 +11,23 @@ public:
 
 	using ComponentBase::ComponentBase;
 
+	/// World space, the local bounds transformed by the world transform. Kept up to date by both setters below.
 	inline const BoxSphereBounds& GetBounds() const { return m_Bounds; }
-	inline void SetBounds(const BoxSphereBounds& Bounds) { m_Bounds = Bounds; }
 
+	/// Mesh space, as the mesh was built.
 	inline const BoxSphereBounds& GetLocalBounds() const { return m_LocalBounds; }
-	inline void SetLocalBounds(const BoxSphereBounds& Bounds) { m_LocalBounds = Bounds; }
+	inline void SetLocalBounds(const BoxSphereBounds& Bounds)
+	{
+		m_LocalBounds = Bounds;
+		m_Bounds = m_LocalBounds.TransformBy(m_WorldTransform);
+	}
+
+	inline const Math::Matrix& GetWorldTransform() const { return m_WorldTransform; }
+	inline void SetWorldTransform(const Math::Matrix& WorldTransform)
+	{
+		m_WorldTransform = WorldTransform;
+		m_Bounds = m_LocalBounds.TransformBy(m_WorldTransform);
+	}
 
 	inline bool IsCastShadow() const { return m_CastShadow; }
 	inline void SetCastShadow(bool CastShadow) { m_CastShadow = CastShadow; }
@@ -30,6 +42,7 @@ public:
 			CEREAL_BASE(ComponentBase),
 			CEREAL_NVP(m_Bounds),
 			CEREAL_NVP(m_LocalBounds),
+			CEREAL_NVP(m_WorldTransform),
 			CEREAL_NVP(m_CastShadow),
 			CEREAL_NVP(m_Name)
 		);
@@ -37,6 +50,7 @@ public:
 private:
 	BoxSphereBounds m_Bounds;
 	BoxSphereBounds m_LocalBounds;
+	Math::Matrix m_WorldTransform;
 
 	bool m_CastShadow = true;
 
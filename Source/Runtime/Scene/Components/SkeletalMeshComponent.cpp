@@ -0,0 +1,84 @@
+#include "Scene/Components/SkeletalMeshComponent.h"
+#include "Scene/Components/Skeleton.h"
+#include "Scene/Components/StaticMesh.h"
+#include <DirectXPackedVector.h>
+
+void SkeletalMeshComponent::SetSkinnedMesh(const std::shared_ptr<SkinnedMesh>& Mesh)
+{
+	std::shared_ptr<StaticMesh> Static = Mesh;
+	SetMesh(Static);
+
+	m_SkinnedMesh = Mesh;
+	m_SkinnedMesh->GetSkeleton()->GetBindPose(m_LocalPose);
+}
+
+void SkeletalMeshComponent::Skin()
+{
+	assert(m_SkinnedMesh && m_SkinnedMesh->GetData());
+
+	const MeshData& Data = *m_SkinnedMesh->GetData();
+	const Skeleton& Bones = *m_SkinnedMesh->GetSkeleton();
+	assert(m_LocalPose.size() == Bones.GetNumBones());
+
+	m_GlobalPose.resize(Bones.GetNumBones());
+	Bones.ComputeGlobalPose(m_LocalPose.data(), m_GlobalPose.data());
+
+	m_SkinMatrices.resize(m_SkinnedMesh->GetNumPaletteBones());
+	m_SkinnedMesh->ComputeSkinMatrices(m_GlobalPose.data(), m_InverseMeshTransform, m_SkinMatrices.data());
+
+	m_SkinnedPositions.resize(Data.GetNumVertex());
+	m_SkinnedNormals.resize(Data.HasNormal() ? Data.GetNumVertex() : 0u);
+
+	SkinVertices(Data, m_SkinMatrices.data(), 0u, Data.GetNumVertex(), m_SkinnedPositions.data(), m_SkinnedNormals.data());
+}
+
+TFTaskEventPtr SkeletalMeshComponent::SkinAsync(const std::vector<SkeletalMeshComponent*>& Components)
+{
+	return TFTask::ParallelFor(Components.begin(), Components.end(), [](SkeletalMeshComponent* Component) {
+		Component->Skin();
+	});
+}
+
+void SkeletalMeshComponent::SkinVertices(const MeshData& Data, const Math::Matrix* SkinMatrices, uint32_t First, uint32_t Count, Math::Vector3* OutPositions, Math::Vector3* OutNormals)
+{
+	using namespace DirectX;
+
+	assert(Data.HasSkin() && Data.GetVertexLayout().Position == EPositionFormat::Float3 && Data.GetVertexLayout().Direction == EDirectionFormat::Float3);
+	assert(First + Count <= Data.GetNumVertex());
+
+	const bool HasNormal = Data.HasNormal();
+
+	for (uint32_t Index = First; Index < First + Count; ++Index)
+	{
+		const uint8_t* BoneIndices = reinterpret_cast<const uint8_t*>(Data.GetElementData(EVertexElement::BoneIndices, Index));
+		const uint8_t* BoneWeights = reinterpret_cast<const uint8_t*>(Data.GetElementData(EVertexElement::BoneWeights, Index));
+		const XMVECTOR Weights = PackedVector::XMLoadUByteN4(reinterpret_cast<const PackedVector::XMUBYTEN4*>(BoneWeights));
+
+		/// Influences are sorted largest first with unused ones zeroed, so the first one is always present.
+		XMMATRIX Blend = MATRIX_LOAD(&SkinMatrices[BoneIndices[0]]);
+		const XMVECTOR Weight0 = XMVectorSplatX(Weights);
+		Blend.r[0] = XMVectorMultiply(Blend.r[0], Weight0);
+		Blend.r[1] = XMVectorMultiply(Blend.r[1], Weight0);
+		Blend.r[2] = XMVectorMultiply(Blend.r[2], Weight0);
+		Blend.r[3] = XMVectorMultiply(Blend.r[3], Weight0);
+
+		for (uint32_t Influence = 1u; Influence < 4u && BoneWeights[Influence] != 0u; ++Influence)
+		{
+			const XMMATRIX Bone = MATRIX_LOAD(&SkinMatrices[BoneIndices[Influence]]);
+			const XMVECTOR Weight = XMVectorSwizzle(Weights, Influence, Influence, Influence, Influence);
+			Blend.r[0] = XMVectorMultiplyAdd(Bone.r[0], Weight, Blend.r[0]);
+			Blend.r[1] = XMVectorMultiplyAdd(Bone.r[1], Weight, Blend.r[1]);
+			Blend.r[2] = XMVectorMultiplyAdd(Bone.r[2], Weight, Blend.r[2]);
+			Blend.r[3] = XMVectorMultiplyAdd(Bone.r[3], Weight, Blend.r[3]);
+		}
+
+		const XMVECTOR Position = XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(Data.GetElementData(EVertexElement::Position, Index)));
+		XMStoreFloat3(&OutPositions[Index - First], XMVector3Transform(Position, Blend));
+
+		if (HasNormal)
+		{
+			const XMVECTOR Normal = XMLoadFloat3(reinterpret_cast<const XMFLOAT3*>(Data.GetElementData(EVertexElement::Normal, Index)));
+			XMStoreFloat3(&OutNormals[Index - First], XMVector3Normalize(XMVector3TransformNormal(Normal, Blend)));
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Scene/Components/StaticMeshComponent.h"
+#include "Core/Math/Matrix.h"
+#include "Async/Task.h"
+
+class SkeletalMeshComponent : public StaticMeshComponent
+{
+public:
+	REGISTER_COMPONENT(SkeletalMeshComponent, StaticMeshComponent);
+
+	using StaticMeshComponent::StaticMeshComponent;
+
+	/// Also resets the pose to the bind pose of the mesh's skeleton.
+	void SetSkinnedMesh(const std::shared_ptr<class SkinnedMesh>& Mesh);
+	inline bool HasSkinnedMesh() const { return m_SkinnedMesh != nullptr; }
+	inline const class SkinnedMesh& GetSkinnedMesh() const
+	{
+		assert(m_SkinnedMesh);
+		return *m_SkinnedMesh;
+	}
+
+	/// World transform of the node the mesh is attached to, skinned vertices are brought back into its space.
+	inline void SetMeshTransform(const Math::Matrix& WorldTransform) { m_InverseMeshTransform = Math::Matrix::Inverse(WorldTransform); }
+
+	/// Parent relative transform per skeleton bone.
+	inline std::vector<Math::Matrix>& GetLocalPose() { return m_LocalPose; }
+	inline const std::vector<Math::Matrix>& GetLocalPose() const { return m_LocalPose; }
+
+	/// Resolves the current pose and skins every vertex on the calling thread.
+	void Skin();
+
+	inline const std::vector<Math::Vector3>& GetSkinnedPositions() const { return m_SkinnedPositions; }
+	inline const std::vector<Math::Vector3>& GetSkinnedNormals() const { return m_SkinnedNormals; }
+
+	/// CPU memory of the pose and skinning buffers, the skinned mesh itself is not included.
+	inline size_t GetBuffersSize() const
+	{
+		return (m_LocalPose.capacity() + m_GlobalPose.capacity() + m_SkinMatrices.capacity()) * sizeof(Math::Matrix) +
+			(m_SkinnedPositions.capacity() + m_SkinnedNormals.capacity()) * sizeof(Math::Vector3);
+	}
+
+	/// One job per component, components must stay alive until the returned event is done.
+	static TFTaskEventPtr SkinAsync(const std::vector<SkeletalMeshComponent*>& Components);
+
+	/// Linear blend skinning of the float positions and normals of [First, First + Count). Weights are unorm8 and sum to one,
+	/// SkinMatrices is indexed by the mesh's bone indices. OutNormals is ignored when the mesh has no normals.
+	static void SkinVertices(const struct MeshData& Data, const Math::Matrix* SkinMatrices, uint32_t First, uint32_t Count, Math::Vector3* OutPositions, Math::Vector3* OutNormals);
+private:
+	std::shared_ptr<class SkinnedMesh> m_SkinnedMesh;
+	std::vector<Math::Matrix> m_LocalPose;
+	std::vector<Math::Matrix> m_GlobalPose;
+	std::vector<Math::Matrix> m_SkinMatrices;
+	Math::Matrix m_InverseMeshTransform;
+
+	std::vector<Math::Vector3> m_SkinnedPositions;
+	std::vector<Math::Vector3> m_SkinnedNormals;
+};
@@ -0,0 +1,41 @@
+#include "Scene/Components/Skeleton.h"
+
+uint32_t Skeleton::AddBone(FName&& Name, uint32_t Parent, const Math::Matrix& LocalBindTransform)
+{
+	assert(Parent == ~0u || Parent < m_Bones.size());
+
+	const uint32_t Index = static_cast<uint32_t>(m_Bones.size());
+	m_BoneIndices.emplace(std::string(Name.Get()), Index);
+	m_Bones.push_back(Bone{ std::move(Name), Parent, LocalBindTransform });
+	m_Parents.push_back(Parent == ~0u ? NONE_INDEX : Parent);
+
+	Math::Transform BindTransform;
+	BindTransform.SetMatrix(LocalBindTransform);
+	m_BindPose.Resize(m_Bones.size());
+	m_BindPose.Set(Index, BindTransform);
+	return Index;
+}
+
+uint32_t Skeleton::FindBone(std::string_view Name) const
+{
+	auto It = m_BoneIndices.find(std::string(Name));
+	return It == m_BoneIndices.end() ? ~0u : It->second;
+}
+
+void Skeleton::GetBindPose(std::vector<Math::Matrix>& OutLocalPose) const
+{
+	OutLocalPose.resize(m_Bones.size());
+	for (size_t Index = 0u; Index < m_Bones.size(); ++Index)
+	{
+		OutLocalPose[Index] = m_Bones[Index].LocalBindTransform;
+	}
+}
+
+void Skeleton::ComputeGlobalPose(const Math::Matrix* LocalPose, Math::Matrix* OutGlobalPose) const
+{
+	for (size_t Index = 0u; Index < m_Bones.size(); ++Index)
+	{
+		const uint32_t Parent = m_Bones[Index].Parent;
+		OutGlobalPose[Index] = Parent == ~0u ? LocalPose[Index] : LocalPose[Index] * OutGlobalPose[Parent];
+	}
+}
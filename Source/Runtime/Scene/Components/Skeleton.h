@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Core/Math/TransformSoA.h"
+#include "Core/Name.h"
+
+struct Bone
+{
+	FName Name;
+	uint32_t Parent = ~0u;
+
+	/// Relative to the parent bone, in the pose the skin was bound in.
+	Math::Matrix LocalBindTransform;
+};
+
+/// Bone hierarchy shared by all skinned meshes of a scene. Bones are stored parents first,
+/// so a pose is resolved in a single pass from the first bone to the last.
+class Skeleton
+{
+public:
+	/// The parent must have been added before.
+	uint32_t AddBone(FName&& Name, uint32_t Parent, const Math::Matrix& LocalBindTransform);
+
+	uint32_t FindBone(std::string_view Name) const;
+
+	inline const Bone& GetBone(uint32_t Index) const { return m_Bones[Index]; }
+	inline const std::vector<Bone>& GetBones() const { return m_Bones; }
+	inline uint32_t GetNumBones() const { return static_cast<uint32_t>(m_Bones.size()); }
+
+	/// Parent per bone, NONE_INDEX for roots, laid out for Math::ComposeLocalToWorld.
+	inline const uint32_t* GetParents() const { return m_Parents.data(); }
+
+	void GetBindPose(std::vector<Math::Matrix>& OutLocalPose) const;
+
+	/// Decomposed bind pose, the default for bones an animation does not drive.
+	inline const Math::TransformSoA& GetBindPose() const { return m_BindPose; }
+
+	/// OutGlobalPose[Bone] = LocalPose[Bone] * OutGlobalPose[Parent], both arrays hold one matrix per bone.
+	void ComputeGlobalPose(const Math::Matrix* LocalPose, Math::Matrix* OutGlobalPose) const;
+private:
+	std::vector<Bone> m_Bones;
+	std::vector<uint32_t> m_Parents;
+	Math::TransformSoA m_BindPose;
+	std::unordered_map<std::string, uint32_t> m_BoneIndices;
+};
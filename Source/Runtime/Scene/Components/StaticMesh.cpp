@@ -1,6 +1,10 @@
 #include "Scene/Components/StaticMesh.h"
 #include "RHI/RHIDevice.h"
 #include "RHI/RHICommandListContext.h"
+#include "Core/Math/Math.h"
+#include "Core/Math/Quantization.h"
+#include "Scene/Components/Skeleton.h"
+#include "Async/Task.h"
 
 MeshData::MeshData(
 	uint32_t NumVertex, 
@@ -11,7 +15,9 @@ MeshData::MeshData(
 	bool HasUV0, 
 	bool HasUV1, 
 	bool HasColor, 
-	ERHIPrimitiveTopology PrimitiveTopology)
+	bool HasSkin,
+	ERHIPrimitiveTopology PrimitiveTopology,
+	const VertexLayout& Layout)
 	: MeshProperty(
 		NumVertex, 
 		NumIndex, 
@@ -21,44 +27,304 @@ MeshData::MeshData(
 		HasUV0, 
 		HasUV1, 
 		HasColor,
+		HasSkin,
 		NumVertex >= std::numeric_limits<uint16_t>::max() ? ERHIIndexFormat::UInt32 : ERHIIndexFormat::UInt16,
-		PrimitiveTopology)
+		PrimitiveTopology,
+		Layout)
 {
 	assert(NumVertex && NumIndex && NumPrimitive);
 
-	VerticesData.Size += PositionStride * NumVertex; // Position
-	VerticesData.Size += HasNormal ? PositionStride * NumVertex : 0u; // Normal
-	VerticesData.Size += HasTangent ? PositionStride * NumVertex * 2u : 0u; // Tangent and BiTangent
-	VerticesData.Size += HasUV0 ? PositionStride * NumVertex : 0u; // UV0
-	VerticesData.Size += HasUV1 ? PositionStride * NumVertex : 0u; // UV1
-	VerticesData.Size += HasColor ? ColorStride * NumVertex : 0u; // Color
-	VerticesData.Data.reset(new std::byte[VerticesData.Size]());
+	VerticesData = DataBlock(GetVerticesDataSize());
+	IndicesData = DataBlock(GetIndexDataSize());
+}
+
+MeshData::MeshData(const MeshProperty& Properties, DataBlock&& Vertices, DataBlock&& Indices)
+	: MeshProperty(Properties)
+	, VerticesData(std::move(Vertices))
+	, IndicesData(std::move(Indices))
+{
+	assert(VerticesData.Size == GetVerticesDataSize());
+	assert(IndicesData.Size == GetIndexDataSize());
+}
+
+void MeshData::SetSkin(uint32_t Index, const std::array<uint8_t, 4u>& BoneIndices, const std::array<float, 4u>& BoneWeights)
+{
+	assert(HasSkin());
+
+	std::array<uint8_t, 4u> Weights{};
+	uint32_t Sum = 0u, Largest = 0u;
+	for (uint32_t Slot = 0u; Slot < 4u; ++Slot)
+	{
+		Weights[Slot] = static_cast<uint8_t>(std::lround(std::clamp(BoneWeights[Slot], 0.0f, 1.0f) * 255.0f));
+		Sum += Weights[Slot];
+		Largest = BoneWeights[Slot] > BoneWeights[Largest] ? Slot : Largest;
+	}
+
+	/// Rounding can be off by up to 2 in total, the largest weight absorbs it so the blend never scales the vertex.
+	if (Sum != 0u)
+	{
+		Weights[Largest] = static_cast<uint8_t>(static_cast<int32_t>(Weights[Largest]) + 255 - static_cast<int32_t>(Sum));
+	}
+
+	SetElement(EVertexElement::BoneIndices, Index, BoneIndices);
+	SetElement(EVertexElement::BoneWeights, Index, Weights);
+}
+
+bool MeshProperty::HasElement(EVertexAttributes Attributes, const VertexLayout& Layout, EVertexElement Element)
+{
+	auto HasAttribute = [Attributes](EVertexAttributes Attribute) {
+		return (Attributes & Attribute) == Attribute;
+	};
+
+	switch (Element)
+	{
+	case EVertexElement::Position:
+		return true;
+	case EVertexElement::Normal:
+		return HasAttribute(EVertexAttributes::Normal);
+	case EVertexElement::Tangent:
+		return HasAttribute(EVertexAttributes::Tangent);
+	case EVertexElement::BiTangent:
+		return HasAttribute(EVertexAttributes::Tangent) && Layout.Direction == EDirectionFormat::Float3;
+	case EVertexElement::UV0:
+		return HasAttribute(EVertexAttributes::UV0);
+	case EVertexElement::UV1:
+		return HasAttribute(EVertexAttributes::UV1);
+	case EVertexElement::Color:
+		return HasAttribute(EVertexAttributes::Color);
+	case EVertexElement::BoneIndices:
+	case EVertexElement::BoneWeights:
+		return HasAttribute(EVertexAttributes::Skin);
+	}
+	return false;
+}
+
+uint32_t MeshProperty::GetElementSize(EVertexElement Element, const VertexLayout& Layout)
+{
+	switch (Element)
+	{
+	case EVertexElement::Position:
+		return Layout.Position == EPositionFormat::Float3 ? sizeof(Math::Vector3) : sizeof(uint16_t) * 4u;
+	case EVertexElement::Normal:
+		return Layout.Direction == EDirectionFormat::Float3 ? sizeof(Math::Vector3) : sizeof(int16_t) * 2u;
+	case EVertexElement::Tangent:
+		return Layout.Direction == EDirectionFormat::Float3 ? sizeof(Math::Vector3) : sizeof(int16_t) * 4u;
+	case EVertexElement::BiTangent:
+		return Layout.Direction == EDirectionFormat::Float3 ? sizeof(Math::Vector3) : 0u;
+	case EVertexElement::UV0:
+	case EVertexElement::UV1:
+		return Layout.Texcoord == ETexcoordFormat::Float2 ? sizeof(Math::Vector2) : sizeof(uint16_t) * 2u;
+	case EVertexElement::Color:
+		return Layout.Color == EColorFormat::Float4 ? sizeof(Math::Color) : sizeof(uint8_t) * 4u;
+	case EVertexElement::BoneIndices:
+	case EVertexElement::BoneWeights:
+		return sizeof(uint8_t) * 4u;
+	}
+	return 0u;
+}
+
+ERHIFormat MeshProperty::GetElementFormat(EVertexElement Element, const VertexLayout& Layout)
+{
+	switch (Element)
+	{
+	case EVertexElement::Position:
+		switch (Layout.Position)
+		{
+		case EPositionFormat::Half4: return ERHIFormat::RGBA16_Float;
+		case EPositionFormat::SNorm16x4: return ERHIFormat::RGBA16_SNorm;
+		default: return ERHIFormat::RGB32_Float;
+		}
+	case EVertexElement::Normal:
+		return Layout.Direction == EDirectionFormat::Float3 ? ERHIFormat::RGB32_Float : ERHIFormat::RG16_SNorm;
+	case EVertexElement::Tangent:
+		return Layout.Direction == EDirectionFormat::Float3 ? ERHIFormat::RGB32_Float : ERHIFormat::RGBA16_SNorm;
+	case EVertexElement::BiTangent:
+		return ERHIFormat::RGB32_Float;
+	case EVertexElement::UV0:
+	case EVertexElement::UV1:
+		return Layout.Texcoord == ETexcoordFormat::Float2 ? ERHIFormat::RG32_Float : ERHIFormat::RG16_Float;
+	case EVertexElement::Color:
+		return Layout.Color == EColorFormat::Float4 ? ERHIFormat::RGBA32_Float : ERHIFormat::RGBA8_UNorm;
+	case EVertexElement::BoneIndices:
+		return ERHIFormat::RGBA8_UInt;
+	case EVertexElement::BoneWeights:
+		return ERHIFormat::RGBA8_UNorm;
+	}
+	return ERHIFormat::Unknown;
+}
+
+void MeshProperty::UpdateElementOffsets()
+{
+	/// Non interleaved streams are stored back to back in element order, interleaved vertices in the same order within a vertex.
+	/// Every element size is a multiple of 4 bytes, so each stream and each interleaved vertex stays 4 byte aligned.
+	m_VertexSize = 0u;
+	for (uint32_t Index = 0u; Index < static_cast<uint32_t>(EVertexElement::Num); ++Index)
+	{
+		const EVertexElement Element = static_cast<EVertexElement>(Index);
+		const uint32_t Size = GetElementSize(Element);
+		assert(Size % sizeof(float) == 0u);
+
+		m_ElementOffsets[Element] = IsInterleaved() ? m_VertexSize : static_cast<size_t>(m_VertexSize) * m_NumVertex;
+		m_VertexSize += Size;
+	}
+}
+
+Math::Vector3 MeshData::GetPosition(uint32_t Index) const
+{
+	const Math::Vector3& Scale = GetPositionScale();
+	const Math::Vector3& Bias = GetPositionBias();
+
+	switch (GetVertexLayout().Position)
+	{
+	case EPositionFormat::Half4:
+	{
+		const auto Value = GetElement<std::array<uint16_t, 4u>>(EVertexElement::Position, Index);
+		return Math::Vector3(
+			Math::HalfToFloat(Value[0]) * Scale.x + Bias.x,
+			Math::HalfToFloat(Value[1]) * Scale.y + Bias.y,
+			Math::HalfToFloat(Value[2]) * Scale.z + Bias.z);
+	}
+	case EPositionFormat::SNorm16x4:
+	{
+		const auto Value = GetElement<std::array<int16_t, 4u>>(EVertexElement::Position, Index);
+		return Math::Vector3(
+			Math::DequantizeSNorm16(Value[0]) * Scale.x + Bias.x,
+			Math::DequantizeSNorm16(Value[1]) * Scale.y + Bias.y,
+			Math::DequantizeSNorm16(Value[2]) * Scale.z + Bias.z);
+	}
+	default:
+		return GetElement<Math::Vector3>(EVertexElement::Position, Index);
+	}
+}
+
+static float GetMaxDistanceSq(const std::byte* Positions, size_t Count, size_t Stride, const Math::Vector3& Origin)
+{
+	const DirectX::XMVECTOR OriginV = DirectX::XMLoadFloat3(&Origin);
+	DirectX::XMVECTOR MaxDistanceSq = DirectX::XMVectorZero();
+	for (size_t Index = 0u; Index < Count; ++Index)
+	{
+		const DirectX::XMVECTOR Position = DirectX::XMLoadFloat3(reinterpret_cast<const Math::Vector3*>(Positions + Index * Stride));
+		MaxDistanceSq = DirectX::XMVectorMax(MaxDistanceSq, DirectX::XMVector3LengthSq(DirectX::XMVectorSubtract(Position, OriginV)));
+	}
+	return DirectX::XMVectorGetX(MaxDistanceSq);
+}
+
+BoxSphereBounds MeshData::ComputeBounds(bool AllowParallel) const
+{
+	/// Below this the reduction is memory bound on one core already and dispatching costs more than it saves.
+	static constexpr size_t ParallelChunkSize = 64u * 1024u;
+
+	const size_t NumVertex = GetNumVertex();
+
+	/// Full precision positions are reduced in place with the stride of the layout, interleaved or not. Quantized ones are decoded once.
+	std::vector<Math::Vector3> DecodedPositions;
+	const std::byte* Positions = nullptr;
+	size_t Stride = sizeof(Math::Vector3);
+	if (GetVertexLayout().Position == EPositionFormat::Float3)
+	{
+		Positions = VerticesData.Data.get() + GetElementOffset(EVertexElement::Position);
+		Stride = GetElementStride(EVertexElement::Position);
+	}
+	else
+	{
+		DecodedPositions.resize(NumVertex);
+		for (uint32_t Index = 0u; Index < NumVertex; ++Index)
+		{
+			DecodedPositions[Index] = GetPosition(Index);
+		}
+		Positions = reinterpret_cast<const std::byte*>(DecodedPositions.data());
+	}
+
+	Math::AABB Box;
+	float RadiusSq = 0.0f;
+
+	if (!AllowParallel || NumVertex <= ParallelChunkSize)
+	{
+		Box = Math::AABB::CreateFromVertices(Positions, NumVertex, Stride);
+		RadiusSq = GetMaxDistanceSq(Positions, NumVertex, Stride, Box.GetCenter());
+	}
+	else
+	{
+		struct Chunk
+		{
+			size_t First = 0u;
+			size_t Count = 0u;
+			Math::AABB Box;
+			float RadiusSq = 0.0f;
+		};
+
+		std::vector<Chunk> Chunks(Math::DivideAndRoundUp(NumVertex, ParallelChunkSize));
+		for (size_t Index = 0u; Index < Chunks.size(); ++Index)
+		{
+			Chunks[Index].First = Index * ParallelChunkSize;
+			Chunks[Index].Count = std::min(ParallelChunkSize, NumVertex - Chunks[Index].First);
+		}
+
+		TFTask::CorunParallelFor(Chunks.begin(), Chunks.end(), [Positions, Stride](Chunk& Target) {
+			Target.Box = Math::AABB::CreateFromVertices(Positions + Target.First * Stride, Target.Count, Stride);
+		});
+
+		Box = Math::AABB::CreateEmpty();
+		for (const auto& Target : Chunks)
+		{
+			Box.Merge(Target.Box);
+		}
+
+		const Math::Vector3 Origin = Box.GetCenter();
+		TFTask::CorunParallelFor(Chunks.begin(), Chunks.end(), [Positions, Stride, &Origin](Chunk& Target) {
+			Target.RadiusSq = GetMaxDistanceSq(Positions + Target.First * Stride, Target.Count, Stride, Origin);
+		});
 
-	IndicesData.Size += NumIndex * static_cast<size_t>(GetIndexFormat());
-	IndicesData.Data.reset(new std::byte[IndicesData.Size]());
+		for (const auto& Target : Chunks)
+		{
+			RadiusSq = std::max(RadiusSq, Target.RadiusSq);
+		}
+	}
+
+	/// The farthest distance from the box origin is exact for a sphere around it, the EPOS/Ritter fit picks its own center and is
+	/// usually tighter for elongated or diagonal meshes. The smaller one is kept.
+	const Math::Sphere FittedSphere = Math::Sphere::CreateFromVertices(Positions, NumVertex, Stride);
+	const float BoxSphereRadius = std::sqrt(RadiusSq);
+	if (FittedSphere.GetRadius() < BoxSphereRadius)
+	{
+		return BoxSphereBounds(Box.GetCenter(), Box.GetExtents(), FittedSphere.GetCenter(), FittedSphere.GetRadius());
+	}
+
+	return BoxSphereBounds(Box.GetCenter(), Box.GetExtents(), BoxSphereRadius);
 }
 
-RHIInputLayoutDesc MeshProperty::GetInputLayout(EVertexAttributes Attributes, ERHIVertexInputRate InputRate)
+RHIInputLayoutDesc MeshProperty::GetInputLayout(EVertexAttributes Attributes, const VertexLayout& Layout, ERHIVertexInputRate InputRate)
 {
+	static const char* const Usages[] = { "POSITION", "NORMAL", "TANGENT", "BITANGENT", "TEXCOORD0", "TEXCOORD1", "COLOR", "BLENDINDICES", "BLENDWEIGHT" };
+	static_assert(std::size(Usages) == static_cast<size_t>(EVertexElement::Num));
+
 	RHIInputLayoutDesc Desc;
 	uint32_t Binding = 0u;
 	uint32_t Location = 0u;
 
-	auto AddAttribute = [&Desc, &Binding, &Location, Attributes, InputRate](EVertexAttributes Attribute, size_t Stride, ERHIFormat Format, const char* Usage) {
-		if ((Attributes & Attribute) == Attribute)
+	/// AddAttribute accumulates the binding stride, so bindings start out empty.
+	if (Layout.Interleaved)
+	{
+		Desc.AddBinding(Binding, 0u, InputRate);
+	}
+
+	for (uint32_t Index = 0u; Index < static_cast<uint32_t>(EVertexElement::Num); ++Index)
+	{
+		const EVertexElement Element = static_cast<EVertexElement>(Index);
+		if (!HasElement(Attributes, Layout, Element))
 		{
-			Desc.AddBinding(Binding++, Stride, InputRate)
-				.AddAttribute(Location++, Stride, Format, Usage);
+			/// Keep the locations of the following elements where the shader expects them.
+			Location += (Element == EVertexElement::BiTangent && (Attributes & EVertexAttributes::Tangent) == EVertexAttributes::Tangent) ? 1u : 0u;
+			continue;
+		}
+
+		if (!Layout.Interleaved)
+		{
+			Desc.AddBinding(Binding++, 0u, InputRate);
 		}
-	};
 
-	AddAttribute(EVertexAttributes::Position, PositionStride, ERHIFormat::RGB32_Float, "POSITION");
-	AddAttribute(EVertexAttributes::Normal, PositionStride, ERHIFormat::RGB32_Float, "NORMAL");
-	AddAttribute(EVertexAttributes::Tangent, PositionStride, ERHIFormat::RGB32_Float, "TANGENT");
-	AddAttribute(EVertexAttributes::Tangent, PositionStride, ERHIFormat::RGB32_Float, "BITANGENT");
-	AddAttribute(EVertexAttributes::UV0, PositionStride, ERHIFormat::RGB32_Float, "TEXCOORD0");
-	AddAttribute(EVertexAttributes::UV1, PositionStride, ERHIFormat::RGB32_Float, "TEXCOORD1");
-	AddAttribute(EVertexAttributes::Color, ColorStride, ERHIFormat::RGBA32_Float, "COLOR");
+		Desc.AddAttribute(Location++, GetElementSize(Element, Layout), GetElementFormat(Element, Layout), Usages[Index]);
+	}
 
 	return Desc;
 }
@@ -68,22 +334,56 @@ StaticMesh::StaticMesh(const MeshProperty& Properties)
 {
 }
 
+StaticMesh::StaticMesh(const MeshData& Data)
+	: MeshProperty(Data)
+	, m_Data(std::make_shared<MeshData>(Data))
+{
+}
+
+SkinnedMesh::SkinnedMesh(const MeshData& Data, std::shared_ptr<Skeleton> InSkeleton)
+	: StaticMesh(Data)
+	, m_Skeleton(std::move(InSkeleton))
+{
+	assert(Data.HasSkin() && m_Skeleton);
+}
+
+void SkinnedMesh::AddPaletteBone(uint32_t SkeletonBone, const Math::Matrix& InverseBindTransform)
+{
+	assert(SkeletonBone < m_Skeleton->GetNumBones() && m_Palette.size() < MaxPaletteBones);
+
+	m_Palette.push_back(SkeletonBone);
+	m_InverseBindTransforms.push_back(InverseBindTransform);
+}
+
+void SkinnedMesh::ComputeSkinMatrices(const Math::Matrix* GlobalPose, const Math::Matrix& InverseMeshTransform, Math::Matrix* OutSkinMatrices) const
+{
+	for (size_t Index = 0u; Index < m_Palette.size(); ++Index)
+	{
+		OutSkinMatrices[Index] = m_InverseBindTransforms[Index] * GlobalPose[m_Palette[Index]] * InverseMeshTransform;
+	}
+}
+
 const RHIBuffer* PrimitiveBuffers::GetVertexBuffer(EVertexAttributes Attributes) const
 {
+	if (m_Interleaved)
+	{
+		return m_VertexBuffers[EVertexElement::Position].get();
+	}
+
 	switch (Attributes)
 	{
 	case EVertexAttributes::Position:
-		return m_VertexBuffers[0u].get();
+		return m_VertexBuffers[EVertexElement::Position].get();
 	case EVertexAttributes::Normal:
-		return m_VertexBuffers[1u].get();
+		return m_VertexBuffers[EVertexElement::Normal].get();
 	case EVertexAttributes::Tangent:
-		return m_VertexBuffers[2u].get();
+		return m_VertexBuffers[EVertexElement::Tangent].get();
 	case EVertexAttributes::UV0:
-		return m_VertexBuffers[3u].get();
+		return m_VertexBuffers[EVertexElement::UV0].get();
 	case EVertexAttributes::UV1:
-		return m_VertexBuffers[4u].get();
+		return m_VertexBuffers[EVertexElement::UV1].get();
 	case EVertexAttributes::Color:
-		return m_VertexBuffers[5u].get();
+		return m_VertexBuffers[EVertexElement::Color].get();
 	}
 	return nullptr;
 }
@@ -109,35 +409,29 @@ void PrimitiveBuffers::CreateRHI(const MeshData& Data, RHIDevice& Device)
 		assert(Data.VerticesData.Data);
 
 		Desc.SetUsages(ERHIBufferUsageFlags::VertexBuffer)
-			.SetPermanentStates(ERHIResourceState::VertexBuffer)
-			.SetSize(Data.GetPositionDataSize())
-			.SetInitialData(Data.VerticesData.Data.get() + Data.GetPositionOffset());
-			//.SetName(String::Format("%s-VertexPosition", Data.GetName()));
-		m_VertexBuffers[0u] = Device.CreateBuffer(Desc);
-
-		auto CreateVerteBuffer = [&Data, &Device, &Desc, this](bool ShouldCreate, size_t Size, size_t Offset, size_t Index) {
-			if (ShouldCreate)
-			{
-				Desc.SetSize(Size)
-					.SetInitialData(Data.VerticesData.Data.get() + Offset);
-					//.SetName(std::move(Name));
-				m_VertexBuffers[Index] = Device.CreateBuffer(Desc);
-			}
-		};
-
-		CreateVerteBuffer(Data.HasNormal(), Data.GetNormalDataSize(), Data.GetNormalOffset(), 1u);
-			//String::Format("%s-VertexNormal", Data.GetName()));
-
-		CreateVerteBuffer(Data.HasTangent(), Data.GetTangentDataSize(), Data.GetTangentOffset(), 2u);
-			//String::Format("%s-VertexTangent", Data.GetName()));
-
-		CreateVerteBuffer(Data.HasUV0(), Data.GetUV0DataSize(), Data.GetUV0Offset(), 3u);
-			//String::Format("%s-VertexUV0", Data.GetName()));
+			.SetAccessFlags(ERHIDeviceAccessFlags::GpuRead)
+			.SetPermanentStates(ERHIResourceState::VertexBuffer);
 
-		CreateVerteBuffer(Data.HasUV1(), Data.GetUV1DataSize(), Data.GetUV1Offset(), 4u);
-			//String::Format("%s-VertexUV1", Data.GetName()));
+		m_Interleaved = Data.IsInterleaved();
+		if (m_Interleaved)
+		{
+			Desc.SetSize(Data.GetVerticesDataSize())
+				.SetInitialData(Data.VerticesData.Data.get());
+				//.SetName(String::Format("%s-Vertices", Data.GetName()));
+			m_VertexBuffers[EVertexElement::Position] = Device.CreateBuffer(Desc);
+			return;
+		}
 
-		CreateVerteBuffer(Data.HasColor(), Data.GetColorDataSize(), Data.GetColorOffset(), 5u);
-			//String::Format("%s-VertexColor", Data.GetName()));
+		for (uint32_t Index = 0u; Index < static_cast<uint32_t>(EVertexElement::Num); ++Index)
+		{
+			const EVertexElement Element = static_cast<EVertexElement>(Index);
+			if (Data.HasElement(Element))
+			{
+				Desc.SetSize(static_cast<size_t>(Data.GetElementSize(Element)) * Data.GetNumVertex())
+					.SetInitialData(Data.VerticesData.Data.get() + Data.GetElementOffset(Element));
+					//.SetName(String::Format("%s-Vertex%s", Data.GetName(), Usage));
+				m_VertexBuffers[Element] = Device.CreateBuffer(Desc);
+			}
+		}
 	}
 }
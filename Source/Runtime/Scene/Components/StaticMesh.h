@@ -6,6 +6,7 @@
 #include "Core/Math/Sphere.h"
 #include "Core/Math/Color.h"
 #include "Core/Math/Transform.h"
+#include "Scene/BoxSphereBounds.h"
 #include "Asset/Material.h"
 
 enum class EVertexAttributes : uint8_t
@@ -16,10 +17,78 @@ enum class EVertexAttributes : uint8_t
 	UV0 = 1 << 3,
 	UV1 = 1 << 4,
 	Color = 1 << 5,
-	Num = 6
+	Skin = 1 << 6,
+	Num = 7
 };
 ENUM_FLAG_OPERATORS(EVertexAttributes);
 
+/// Individual vertex streams, the Tangent attribute covers both Tangent and BiTangent, the Skin attribute both bone streams.
+enum class EVertexElement : uint8_t
+{
+	Position,
+	Normal,
+	Tangent,
+	BiTangent,
+	UV0,
+	UV1,
+	Color,
+	BoneIndices, DESCRIPTION("Four uint8 indices into the bone palette of the SkinnedMesh.")
+	BoneWeights, DESCRIPTION("Four unorm8 weights that sum up to exactly 255.")
+	Num
+};
+
+enum class EPositionFormat : uint8_t
+{
+	Float3,
+	Half4, DESCRIPTION("Normalized to [-1, 1] by the per mesh position scale and bias, w is padding.")
+	SNorm16x4, DESCRIPTION("Normalized to [-1, 1] by the per mesh position scale and bias, w is padding.")
+};
+
+enum class EDirectionFormat : uint8_t
+{
+	Float3,
+	Octahedral16, DESCRIPTION("Normal as RG16_SNorm, tangent as RGBA16_SNorm (Octahedral.xy, Handedness, 0), the bitangent is reconstructed as cross(Normal, Tangent) * Handedness.")
+};
+
+enum class ETexcoordFormat : uint8_t
+{
+	Float2,
+	Half2
+};
+
+enum class EColorFormat : uint8_t
+{
+	Float4,
+	UNorm8x4
+};
+
+/// Storage format of the vertex elements. Everything but the default keeps vertices compact at a bounded precision loss:
+///   SNorm16x4 positions: Extent / 65534 per axis, Half4 positions: Extent / 4096 per axis.
+///   Octahedral16 directions: 3 / 32767 euclidean.
+///   Half2 texcoords: |UV| / 2048.
+///   UNorm8x4 colors: 1 / 510 per channel.
+struct VertexLayout
+{
+	EPositionFormat Position = EPositionFormat::Float3;
+	EDirectionFormat Direction = EDirectionFormat::Float3;
+	ETexcoordFormat Texcoord = ETexcoordFormat::Float2;
+	EColorFormat Color = EColorFormat::Float4;
+
+	/// One stream with all elements of a vertex next to each other instead of one stream per element.
+	bool Interleaved = false;
+
+	inline bool IsQuantized() const
+	{
+		return Position != EPositionFormat::Float3 || Direction != EDirectionFormat::Float3 || Texcoord != ETexcoordFormat::Float2 || Color != EColorFormat::Float4;
+	}
+
+	inline bool operator==(const VertexLayout& Other) const
+	{
+		return Position == Other.Position && Direction == Other.Direction && Texcoord == Other.Texcoord && Color == Other.Color && Interleaved == Other.Interleaved;
+	}
+	inline bool operator!=(const VertexLayout& Other) const { return !(*this == Other); }
+};
+
 class MeshProperty
 {
 public:
@@ -32,13 +101,16 @@ public:
 		bool HasUV0, 
 		bool HasUV1, 
 		bool HasColor, 
+		bool HasSkin,
 		ERHIIndexFormat IndexFormat, 
-		ERHIPrimitiveTopology PrimitiveTopology)
+		ERHIPrimitiveTopology PrimitiveTopology,
+		const VertexLayout& Layout = VertexLayout())
 		: m_NumVertex(NumVertex)
 		, m_NumIndex(NumIndex)
 		, m_NumPrimitive(NumPrimitive)
 		, m_IndexFormat(IndexFormat)
 		, m_PrimitiveTopology(PrimitiveTopology)
+		, m_Layout(Layout)
 	{
 		EVertexAttributes None = static_cast<EVertexAttributes>(0u);
 
@@ -47,6 +119,9 @@ public:
 		m_VertexAttributes = m_VertexAttributes | (HasUV0 ? EVertexAttributes::UV0 : None);
 		m_VertexAttributes = m_VertexAttributes | (HasUV1 ? EVertexAttributes::UV1 : None);
 		m_VertexAttributes = m_VertexAttributes | (HasColor ? EVertexAttributes::Color : None);
+		m_VertexAttributes = m_VertexAttributes | (HasSkin ? EVertexAttributes::Skin : None);
+
+		UpdateElementOffsets();
 	}
 
 	MeshProperty(const MeshProperty&) = default;
@@ -57,6 +132,7 @@ public:
 	inline bool HasUV0() const { return HasAttribute(EVertexAttributes::UV0); }
 	inline bool HasUV1() const { return HasAttribute(EVertexAttributes::UV1); }
 	inline bool HasColor() const { return HasAttribute(EVertexAttributes::Color); }
+	inline bool HasSkin() const { return HasAttribute(EVertexAttributes::Skin); }
 
 	inline uint32_t GetNumVertex() const { return m_NumVertex; }
 	inline uint32_t GetNumIndex() const { return m_NumIndex; }
@@ -67,12 +143,35 @@ public:
 
 	inline MaterialID GetMaterialID() const { return m_MaterialID; }
 
-	inline RHIInputLayoutDesc GetInputLayout() const { return GetInputLayout(m_VertexAttributes); }
+	inline EVertexAttributes GetVertexAttributes() const { return m_VertexAttributes; }
+
+	inline const VertexLayout& GetVertexLayout() const { return m_Layout; }
+	inline bool IsInterleaved() const { return m_Layout.Interleaved; }
+
+	inline bool HasElement(EVertexElement Element) const { return HasElement(m_VertexAttributes, m_Layout, Element); }
+	inline uint32_t GetElementSize(EVertexElement Element) const { return HasElement(Element) ? GetElementSize(Element, m_Layout) : 0u; }
+
+	/// Byte offset of the first vertex of the element within the vertex data, and the distance between two vertices of it.
+	inline size_t GetElementOffset(EVertexElement Element) const { return m_ElementOffsets[Element]; }
+	inline size_t GetElementStride(EVertexElement Element) const { return IsInterleaved() ? m_VertexSize : GetElementSize(Element); }
 
-	static RHIInputLayoutDesc GetInputLayout(EVertexAttributes Attributes, ERHIVertexInputRate InputRate = ERHIVertexInputRate::Vertex);
+	inline uint32_t GetVertexSize() const { return m_VertexSize; }
+	inline size_t GetVerticesDataSize() const { return static_cast<size_t>(m_VertexSize) * m_NumVertex; }
+	inline size_t GetIndexDataSize() const { return m_NumIndex * static_cast<size_t>(m_IndexFormat); }
+
+	/// Quantized positions decode as Encoded * Scale + Bias, GenericVS does it with _QUANTIZED_POSITION_ and WVP.PositionScale/PositionBias.
+	inline const Math::Vector3& GetPositionScale() const { return m_PositionScale; }
+	inline const Math::Vector3& GetPositionBias() const { return m_PositionBias; }
+	inline void SetPositionDequantization(const Math::Vector3& Scale, const Math::Vector3& Bias) { m_PositionScale = Scale; m_PositionBias = Bias; }
+
+	inline RHIInputLayoutDesc GetInputLayout() const { return GetInputLayout(m_VertexAttributes, m_Layout); }
+
+	static RHIInputLayoutDesc GetInputLayout(EVertexAttributes Attributes, const VertexLayout& Layout = VertexLayout(), ERHIVertexInputRate InputRate = ERHIVertexInputRate::Vertex);
+
+	static bool HasElement(EVertexAttributes Attributes, const VertexLayout& Layout, EVertexElement Element);
+	static uint32_t GetElementSize(EVertexElement Element, const VertexLayout& Layout);
+	static ERHIFormat GetElementFormat(EVertexElement Element, const VertexLayout& Layout);
 
-	static const size_t PositionStride = sizeof(Math::Vector3);
-	static const size_t ColorStride = sizeof(Math::Color);
 	static const size_t AlignOf = alignof(Math::Vector4);
 
 	static_assert(AlignOf == sizeof(float));
@@ -80,6 +179,8 @@ private:
 	inline bool HasAttribute(EVertexAttributes Attribute) const { return (m_VertexAttributes & Attribute) == Attribute; }
 	inline void SetMaterialID(MaterialID ID) { m_MaterialID = ID; }
 
+	void UpdateElementOffsets();
+
 	uint32_t m_NumVertex = 0u;
 	uint32_t m_NumIndex = 0u;
 	uint32_t m_NumPrimitive = 0u;
@@ -88,6 +189,13 @@ private:
 	EVertexAttributes m_VertexAttributes = EVertexAttributes::Position;
 	ERHIIndexFormat m_IndexFormat = ERHIIndexFormat::UInt16;
 	ERHIPrimitiveTopology m_PrimitiveTopology = ERHIPrimitiveTopology::TriangleList;
+
+	VertexLayout m_Layout;
+	uint32_t m_VertexSize = 0u;
+	Array<size_t, EVertexElement> m_ElementOffsets{};
+
+	Math::Vector3 m_PositionScale = Math::Vector3(1.0f);
+	Math::Vector3 m_PositionBias = Math::Vector3(0.0f);
 };
 
 struct MeshData : public MeshProperty
@@ -101,46 +209,56 @@ struct MeshData : public MeshProperty
 		bool HasUV0, 
 		bool HasUV1, 
 		bool HasColor, 
-		ERHIPrimitiveTopology PrimitiveTopology);
+		bool HasSkin,
+		ERHIPrimitiveTopology PrimitiveTopology,
+		const VertexLayout& Layout = VertexLayout());
+
+	/// Adopts prebuilt attribute and index blocks, e.g. views into a cooked mesh file. The blocks must match the layout implied by Properties.
+	MeshData(const MeshProperty& Properties, DataBlock&& Vertices, DataBlock&& Indices);
 
 	MeshData(const MeshData&) = default;
 	MeshData& operator=(const MeshData&) = default;
 
+	/// The setters write the full precision layout, quantized layouts are produced from it by MeshQuantizer.
 	inline void SetPosition(uint32_t Index, const Math::Vector3& Position)
 	{
-		SetVertexData(Index, GetPositionOffset(), Position);
+		assert(GetVertexLayout().Position == EPositionFormat::Float3);
+		SetElement(EVertexElement::Position, Index, Position);
 	}
 	inline void SetNormal(uint32_t Index, const Math::Vector3& Normal)
 	{ 
-		assert(HasNormal());
-		SetVertexData(Index, GetNormalOffset(), Normal);
+		assert(HasNormal() && GetVertexLayout().Direction == EDirectionFormat::Float3);
+		SetElement(EVertexElement::Normal, Index, Normal);
 	}
 	inline void SetTangent(uint32_t Index, const Math::Vector3& Tangent)
 	{
-		assert(HasTangent());
-		SetVertexData(Index, GetTangentOffset(), Tangent);
+		assert(HasTangent() && GetVertexLayout().Direction == EDirectionFormat::Float3);
+		SetElement(EVertexElement::Tangent, Index, Tangent);
 	}
 	inline void SetBitangent(uint32_t Index, const Math::Vector3& Bitangent) 
 	{ 
-		assert(HasTangent());
-		SetVertexData(Index, GetBiTangentOffset(), Bitangent);
+		assert(HasTangent() && GetVertexLayout().Direction == EDirectionFormat::Float3);
+		SetElement(EVertexElement::BiTangent, Index, Bitangent);
 	}
-	inline void SetUV0(uint32_t Index, const Math::Vector3& UV) 
+	inline void SetUV0(uint32_t Index, const Math::Vector2& UV) 
 	{
-		assert(HasUV0());
-		SetVertexData(Index, GetUV0Offset(), UV);
+		assert(HasUV0() && GetVertexLayout().Texcoord == ETexcoordFormat::Float2);
+		SetElement(EVertexElement::UV0, Index, UV);
 	}
-	inline void SetUV1(uint32_t Index, const Math::Vector3& UV) 
+	inline void SetUV1(uint32_t Index, const Math::Vector2& UV) 
 	{
-		assert(HasUV1());
-		SetVertexData(Index, GetUV1Offset(), UV);
+		assert(HasUV1() && GetVertexLayout().Texcoord == ETexcoordFormat::Float2);
+		SetElement(EVertexElement::UV1, Index, UV);
 	}
 	inline void SetColor(uint32_t Index, const Math::Color& Color) 
 	{
-		assert(HasColor());
-		SetVertexData(Index, GetColorOffset(), Color);
+		assert(HasColor() && GetVertexLayout().Color == EColorFormat::Float4);
+		SetElement(EVertexElement::Color, Index, Color);
 	}
 
+	/// Weights must be normalized and sorted largest first, they are stored as unorm8 with the rounding error folded into the largest one.
+	void SetSkin(uint32_t Index, const std::array<uint8_t, 4u>& BoneIndices, const std::array<float, 4u>& BoneWeights);
+
 	inline void SetFace(uint32_t FaceIndex, uint32_t Index0, uint32_t Index1, uint32_t Index2)
 	{
 		if (GetIndexFormat() == ERHIIndexFormat::UInt16)
@@ -159,28 +277,42 @@ struct MeshData : public MeshProperty
 		}
 	}
 
-	template<class Vector, size_t Stride = sizeof(Vector)>
-	inline void SetVertexData(uint32_t Index, size_t Offset, const Vector& Value)
+	inline std::byte* GetElementData(EVertexElement Element, uint32_t Index) const
+	{
+		assert(HasElement(Element) && Index < GetNumVertex());
+		return VerticesData.Data.get() + GetElementOffset(Element) + Index * GetElementStride(Element);
+	}
+
+	/// Interleaved elements are not necessarily aligned to their type, so values are copied bytewise.
+	template<class T>
+	inline void SetElement(EVertexElement Element, uint32_t Index, const T& Value)
+	{
+		assert(sizeof(T) == GetElementSize(Element));
+		memcpy(GetElementData(Element, Index), &Value, sizeof(T));
+	}
+
+	template<class T>
+	inline T GetElement(EVertexElement Element, uint32_t Index) const
 	{
-		*(reinterpret_cast<Vector*>(VerticesData.Data.get() + Offset + Index * Stride)) = Value;
+		assert(sizeof(T) == GetElementSize(Element));
+		T Value;
+		memcpy(&Value, GetElementData(Element, Index), sizeof(T));
+		return Value;
 	}
 
-	inline size_t GetIndexDataSize() const { return GetNumIndex() * static_cast<size_t>(GetIndexFormat()); }
+	/// Any layout, quantized positions are decoded.
+	Math::Vector3 GetPosition(uint32_t Index) const;
 
-	inline size_t GetPositionDataSize() const { return PositionStride * GetNumVertex(); }
-	inline size_t GetNormalDataSize() const { return HasNormal() ? (PositionStride * GetNumVertex()) : 0u; }
-	inline size_t GetTangentDataSize() const { return HasTangent() ? (PositionStride * GetNumVertex()) : 0u; }
-	inline size_t GetUV0DataSize() const { return HasUV0() ? (PositionStride * GetNumVertex()) : 0u; }
-	inline size_t GetUV1DataSize() const { return HasUV1() ? (PositionStride * GetNumVertex()) : 0u; }
-	inline size_t GetColorDataSize() const { return HasColor() ? (ColorStride * GetNumVertex()) : 0u; }
+	/// Only valid for the full precision, non interleaved layout.
+	inline const Math::Vector3* GetPositions() const
+	{
+		assert(GetVertexLayout().Position == EPositionFormat::Float3 && !IsInterleaved());
+		return reinterpret_cast<const Math::Vector3*>(VerticesData.Data.get() + GetElementOffset(EVertexElement::Position));
+	}
 
-	inline size_t GetPositionOffset() const { return 0u; }
-	inline size_t GetNormalOffset() const { return GetPositionOffset() + GetPositionDataSize(); }
-	inline size_t GetTangentOffset() const { return GetNormalOffset() + GetNormalDataSize(); }
-	inline size_t GetBiTangentOffset() const { return GetTangentOffset() + GetTangentDataSize(); }
-	inline size_t GetUV0Offset() const { return GetBiTangentOffset() + GetTangentDataSize(); }
-	inline size_t GetUV1Offset() const { return GetUV0Offset() + GetUV0DataSize(); }
-	inline size_t GetColorOffset() const { return GetUV1Offset() + GetUV1DataSize(); }
+	/// Box and sphere from the position stream of any layout, large meshes are reduced in parallel unless AllowParallel is false.
+	/// Callers on a worker help with the reduction rather than block on it.
+	BoxSphereBounds ComputeBounds(bool AllowParallel = true) const;
 
 	DataBlock VerticesData;
 	DataBlock IndicesData;
@@ -196,26 +328,58 @@ public:
 	inline const RHIBuffer* GetUV0Buffer() const { return GetVertexBuffer(EVertexAttributes::UV0); }
 	inline const RHIBuffer* GetUV1Buffer() const { return GetVertexBuffer(EVertexAttributes::UV1); }
 	inline const RHIBuffer* GetColorBuffer() const { return GetVertexBuffer(EVertexAttributes::Color); }
+	inline const RHIBuffer* GetBiTangentBuffer() const { return m_VertexBuffers[EVertexElement::BiTangent].get(); }
+	inline const RHIBuffer* GetBoneIndicesBuffer() const { return m_Interleaved ? GetPositionBuffer() : m_VertexBuffers[EVertexElement::BoneIndices].get(); }
+	inline const RHIBuffer* GetBoneWeightsBuffer() const { return m_Interleaved ? GetPositionBuffer() : m_VertexBuffers[EVertexElement::BoneWeights].get(); }
+
+	/// Interleaved meshes have one vertex buffer only, every attribute returns it.
 	inline const RHIBuffer* GetVertexBuffer(EVertexAttributes Attributes) const;
 private:
 	friend class AssimpSceneLoader;
 
 	virtual void CreateRHI(const MeshData& Data, class RHIDevice& Device);
 
-	Array<RHIBufferPtr, EVertexAttributes> m_VertexBuffers;
+	Array<RHIBufferPtr, EVertexElement> m_VertexBuffers;
 	RHIBufferPtr m_IndexBuffer;
+	bool m_Interleaved = false;
 };
 
 class StaticMesh : public MeshProperty, public PrimitiveBuffers
 {
 public:
 	StaticMesh(const MeshProperty& Properties);
-};
 
-class SkinnedMeshBuffers : public PrimitiveBuffers
-{
+	/// Keeps the CPU side data, it is shared with the source blocks rather than copied.
+	StaticMesh(const MeshData& Data);
+
+	inline const MeshData* GetData() const { return m_Data.get(); }
+private:
+	std::shared_ptr<MeshData> m_Data;
 };
 
+/// A StaticMesh whose vertices carry up to four bone influences. Bone indices address the mesh's own palette,
+/// which maps them to skeleton bones, so a palette holds at most MaxPaletteBones entries.
 class SkinnedMesh : public StaticMesh
 {
+public:
+	static constexpr uint32_t MaxPaletteBones = 256u;
+
+	SkinnedMesh(const MeshData& Data, std::shared_ptr<class Skeleton> InSkeleton);
+
+	/// InverseBindTransform goes from mesh space to the bone space at bind time.
+	void AddPaletteBone(uint32_t SkeletonBone, const Math::Matrix& InverseBindTransform);
+
+	inline const class Skeleton* GetSkeleton() const { return m_Skeleton.get(); }
+	inline const std::shared_ptr<class Skeleton>& GetSkeletonPtr() const { return m_Skeleton; }
+	inline uint32_t GetNumPaletteBones() const { return static_cast<uint32_t>(m_Palette.size()); }
+	inline uint32_t GetPaletteBone(uint32_t Index) const { return m_Palette[Index]; }
+	inline const Math::Matrix& GetInverseBindTransform(uint32_t Index) const { return m_InverseBindTransforms[Index]; }
+
+	/// OutSkinMatrices[Index] = InverseBind[Index] * GlobalPose[Palette[Index]] * InverseMeshTransform, one matrix per palette bone.
+	/// GlobalPose is in model space, InverseMeshTransform brings the result back to the space of the mesh node.
+	void ComputeSkinMatrices(const Math::Matrix* GlobalPose, const Math::Matrix& InverseMeshTransform, Math::Matrix* OutSkinMatrices) const;
+private:
+	std::shared_ptr<class Skeleton> m_Skeleton;
+	std::vector<uint32_t> m_Palette;
+	std::vector<Math::Matrix> m_InverseBindTransforms;
 };
\ No newline at end of file
@@ -10,6 +10,7 @@ public:
 	using PrimitiveComponent::PrimitiveComponent;
 
 	inline void SetMesh(std::shared_ptr<class StaticMesh>& Mesh) { m_StaticMesh = Mesh; }
+	inline bool HasMesh() const { return m_StaticMesh != nullptr; }
 	inline const class StaticMesh& GetMesh() const
 	{
 		assert(m_StaticMesh);
@@ -17,6 +18,7 @@ public:
 	}
 
 	inline void SetMaterialProperty(std::shared_ptr<struct MaterialProperty>& Material){ m_Material = Material; }
+	inline bool HasMaterialProperty() const { return m_Material != nullptr; }
 	inline const struct MaterialProperty& GetMaterialProperty() const
 	{
 		assert(m_Material);
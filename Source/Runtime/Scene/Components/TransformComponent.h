@@ -111,6 +111,7 @@ public:
 	inline Math::Vector3 GetTranslation() const { return m_Transform.GetTranslation(); }
 	inline Math::Vector3 GetScalling() const { return m_Transform.GetScalling(); }
 	inline Math::Quaternion GetRotation() const { return m_Transform.GetRotation(); }
+	inline Math::Matrix GetMatrix() const { return m_Transform.GetMatrix(); }
 	inline void Reset() { m_Transform.Identity(); }
 
 	template<class Archive>
@@ -3,8 +3,19 @@
 #include "Services/AssetDatabase.h"
 #include "Async/Task.h"
 #include "Components/PrimitiveComponent.h"
+#include "Components/AnimatorComponent.h"
+#include "Components/StaticMesh.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/Skeleton.h"
+#include "Core/ConsoleVariable.h"
+#include "Profile/CpuTimer.h"
 #include "Paths.h"
 
+ConsoleVariable<bool> CVarLogAnimationThroughput(
+	"anim.log_throughput",
+	"Log how long evaluating the animators of a frame takes and the resulting poses per second.",
+	false);
+
 void Scene::Tick(float ElapsedSeconds)
 {
 	if (!IsReady())
@@ -12,6 +23,8 @@ void Scene::Tick(float ElapsedSeconds)
 		return;
 	}
 
+	std::vector<AnimatorComponent*> Animators;
+
 	for (auto& Entity : GetAllEntities())
 	{
 		if (!Entity.IsAlive() || !Entity.IsVisible())
@@ -21,12 +34,30 @@ void Scene::Tick(float ElapsedSeconds)
 
 		for (auto Comp : Entity.GetAllComponents())
 		{
-			if (Comp && Comp->IsTickable())
+			if (Comp && Comp->IsA<AnimatorComponent>())
+			{
+				Animators.push_back(static_cast<AnimatorComponent*>(Comp.get()));
+			}
+			else if (Comp && Comp->IsTickable())
 			{
 				Comp->Tick(ElapsedSeconds);
 			}
 		}
 	}
+
+	/// Every animator is independent, so thousands of characters spread over all workers.
+	if (!Animators.empty())
+	{
+		CpuTimer Timer;
+		AnimatorComponent::EvaluateAsync(Animators, ElapsedSeconds)->Wait();
+
+		if (CVarLogAnimationThroughput.Get())
+		{
+			const float Milliseconds = Timer.GetElapsedMilliseconds();
+			LOG_INFO(LogDefault, "Evaluate {} animators on {} workers in {:.3f} ms, {:.0f} poses per second",
+				Animators.size(), TFTask::GetNumWorkerThreads(), Milliseconds, Milliseconds > 0.0f ? Animators.size() * 1000.0f / Milliseconds : 0.0f);
+		}
+	}
 }
 
 void Scene::AddPrimitive(const PrimitiveComponent* PrimitiveComp)
@@ -93,6 +124,71 @@ void Scene::OnPostLoad()
 	AssetDatabase::Get().RequestLoad(*m_AssimpLoadRequests);
 }
 
+size_t AssimpScene::GetMemorySize() const
+{
+	std::unordered_set<const void*> Counted;
+	size_t Size = 0u;
+
+	auto CountMesh = [&Counted, &Size](const StaticMesh& Mesh) {
+		auto Data = Mesh.GetData();
+		if (Data && Counted.insert(Data).second)
+		{
+			Size += Data->VerticesData.GetSize() + Data->IndicesData.GetSize();
+		}
+	};
+
+	auto CountSkeleton = [&Counted, &Size](const Skeleton* TargetSkeleton) {
+		if (TargetSkeleton && Counted.insert(TargetSkeleton).second)
+		{
+			Size += TargetSkeleton->GetNumBones() * (sizeof(Bone) + sizeof(uint32_t) + sizeof(Math::Transform));
+		}
+	};
+
+	for (const auto& Ent : GetAllEntities())
+	{
+		for (const auto& Comp : Ent.GetAllComponents())
+		{
+			if (!Comp)
+			{
+				continue;
+			}
+
+			if (Comp->IsA<SkeletalMeshComponent>())
+			{
+				auto& SkeletalMeshComp = static_cast<const SkeletalMeshComponent&>(*Comp);
+				Size += SkeletalMeshComp.GetBuffersSize();
+				if (SkeletalMeshComp.HasSkinnedMesh())
+				{
+					CountMesh(SkeletalMeshComp.GetSkinnedMesh());
+					CountSkeleton(SkeletalMeshComp.GetSkinnedMesh().GetSkeleton());
+				}
+			}
+			else if (Comp->IsA<StaticMeshComponent>())
+			{
+				auto& StaticMeshComp = static_cast<const StaticMeshComponent&>(*Comp);
+				if (StaticMeshComp.HasMesh())
+				{
+					CountMesh(StaticMeshComp.GetMesh());
+				}
+			}
+			else if (Comp->IsA<AnimatorComponent>())
+			{
+				auto& Animator = static_cast<const AnimatorComponent&>(*Comp);
+				CountSkeleton(Animator.GetSkeleton());
+				for (const auto& Clip : Animator.GetClips())
+				{
+					if (Clip && Counted.insert(Clip.get()).second)
+					{
+						Size += Clip->GetSize();
+					}
+				}
+			}
+		}
+	}
+
+	return Size;
+}
+
 Scene::~Scene()
 {
 	RemoveInvalidEntities();
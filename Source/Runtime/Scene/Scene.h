@@ -9,6 +9,9 @@
 struct AssimpScene : public Asset, public SceneGraph
 {
 	using Asset::Asset;
+
+	/// Mesh data, skeletons, animation clips and skinning buffers, each counted once however many entities share it.
+	size_t GetMemorySize() const override final;
 };
 
 class Scene : public ITickable, public SceneGraph, public Serializable<Scene>
@@ -147,6 +147,7 @@ public:
 protected:
 	friend class SceneGraph;
 	friend class Scene;
+	friend struct AssimpScene;
 
 	inline void SetID(EntityID ID) { m_ID = std::move(ID); }
 	
@@ -298,6 +299,7 @@ public:
 
 protected:
 	friend class AssimpSceneLoader;
+	friend class CookedScene;
 
 	inline void SetRoot(EntityID ID) { m_Root = ID; }
 
@@ -48,6 +48,7 @@ public:
 
 	virtual void SetCamera(class Camera* Camera);
 	inline class Camera* GetCamera() { return m_Camera; }
+	inline const class Camera* GetCamera() const { return m_Camera; }
 	
 	inline bool IsInverseDepth() const { return m_InverseDepth; }
 	inline void SetInverseDepth(bool InverseDepth) { m_InverseDepth = InverseDepth; }
@@ -0,0 +1,215 @@
+#include "Common/TestUtils.h"
+#include "Core/ConsoleVariable.h"
+#include "Services/AssetDatabase.h"
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+
+extern ConsoleVariable<uint32_t> CVarAssetMemoryBudget;
+
+/// Charges the size of its file against the budget.
+class TestAsset : public Asset
+{
+public:
+	using Asset::Asset;
+
+	size_t GetMemorySize() const override final { return m_MemorySize; }
+protected:
+	friend class TestAssetLoader;
+
+	size_t m_MemorySize = 0u;
+};
+
+/// Records the order assets are loaded in, loads run on the workers.
+class TestAssetLoader : public AssetLoader
+{
+public:
+	TestAssetLoader()
+		: AssetLoader({ ".testasset" })
+	{
+	}
+
+	bool Load(Asset& Target) override final
+	{
+		static_cast<TestAsset&>(Target).m_MemorySize = static_cast<size_t>(std::filesystem::file_size(Target.GetPath()));
+
+		std::lock_guard Locker(m_Lock);
+		m_Loaded.push_back(Target.GetPath());
+		return true;
+	}
+
+	std::vector<std::filesystem::path> GetLoaded() const
+	{
+		std::lock_guard Locker(m_Lock);
+		return m_Loaded;
+	}
+protected:
+	std::shared_ptr<Asset> CreateAsset(const std::filesystem::path& Path, uint32_t) override final
+	{
+		return std::make_shared<TestAsset>(Path);
+	}
+private:
+	mutable std::mutex m_Lock;
+	std::vector<std::filesystem::path> m_Loaded;
+};
+
+class AssetDatabaseTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite()
+	{
+		InitializeTaskSystem();
+	}
+
+	void SetUp() override
+	{
+		m_Root = GetTestTempPath();
+
+		auto Loader = std::make_unique<TestAssetLoader>();
+		m_Loader = Loader.get();
+		AssetDatabase::Get().RegisterAssetLoader(std::move(Loader));
+	}
+
+	void TearDown() override
+	{
+		AssetDatabase::Get().Finalize();
+		CVarAssetMemoryBudget.Set(1024u);
+	}
+
+	std::filesystem::path CreateAsset(const char* Name, size_t Size = 100u)
+	{
+		const auto Path = m_Root / Name;
+		EXPECT_TRUE(WriteTextFile(Path, std::string(Size, '\0')));
+		return Path;
+	}
+
+	/// Synchronous, the returned handle is the only one outside the database.
+	AssetHandle Load(const std::filesystem::path& Path)
+	{
+		AssetLoadRequest Request;
+		Request.Path = Path.string();
+		Request.Async = false;
+		AssetDatabase::Get().RequestLoad(Request);
+
+		EXPECT_TRUE(Request.Target && Request.Target->IsReady(std::memory_order_acquire)) << Path;
+		return Request.Target;
+	}
+
+	std::filesystem::path m_Root;
+	TestAssetLoader* m_Loader = nullptr;
+};
+
+TEST_F(AssetDatabaseTest, EvictsLeastRecentlyUsedFirst)
+{
+	const auto A = CreateAsset("A.testasset");
+	const auto B = CreateAsset("B.testasset");
+	const auto C = CreateAsset("C.testasset");
+
+	Load(A);
+	Load(B);
+	Load(C);
+	EXPECT_EQ(AssetDatabase::Get().GetResidentBytes(), 300u);
+
+	/// Looking A up makes B the least recently used one.
+	ASSERT_NE(AssetDatabase::Get().FindAsset(A), nullptr);
+
+	AssetDatabase::Get().EvictUnreferencedAssets(250u);
+	EXPECT_EQ(AssetDatabase::Get().FindAsset(B), nullptr);
+	EXPECT_EQ(AssetDatabase::Get().GetResidentBytes(), 200u);
+
+	/// C is held and stays, even though A was used more recently.
+	auto HeldC = AssetDatabase::Get().FindAsset(C);
+	ASSERT_NE(HeldC, nullptr);
+
+	AssetDatabase::Get().EvictUnreferencedAssets(0u);
+	EXPECT_EQ(AssetDatabase::Get().FindAsset(A), nullptr);
+	EXPECT_EQ(AssetDatabase::Get().FindAsset(C), HeldC);
+	EXPECT_EQ(AssetDatabase::Get().GetResidentBytes(), 100u);
+}
+
+TEST_F(AssetDatabaseTest, EvictsOnLoadBeyondTheBudget)
+{
+	CVarAssetMemoryBudget.Set(1u);
+
+	const auto A = CreateAsset("A.testasset", 512u * 1024u);
+	const auto B = CreateAsset("B.testasset", 512u * 1024u);
+	const auto C = CreateAsset("C.testasset", 512u * 1024u);
+
+	auto HeldA = Load(A);
+	Load(B);
+	EXPECT_EQ(AssetDatabase::Get().GetResidentBytes(), 1024u * 1024u);
+
+	/// A is the least recently used one but held, B goes instead.
+	Load(C);
+	EXPECT_EQ(AssetDatabase::Get().GetResidentBytes(), 1024u * 1024u);
+	EXPECT_EQ(AssetDatabase::Get().FindAsset(A), HeldA);
+	EXPECT_EQ(AssetDatabase::Get().FindAsset(B), nullptr);
+	EXPECT_NE(AssetDatabase::Get().FindAsset(C), nullptr);
+
+	/// Evicted assets load again on request.
+	Load(B);
+	EXPECT_EQ(m_Loader->GetLoaded().size(), 4u);
+	EXPECT_LE(AssetDatabase::Get().GetResidentBytes(), 1024u * 1024u);
+}
+
+TEST_F(AssetDatabaseTest, ReloadsOnOtherSettingsOnly)
+{
+	const auto Path = CreateAsset("A.testasset");
+
+	AssetLoadRequest Request;
+	Request.Path = Path.string();
+	Request.Async = false;
+	Request.Settings = 1u;
+	AssetDatabase::Get().RequestLoad(Request);
+	auto First = Request.Target;
+
+	/// Without settings the request takes the ones the asset was loaded with.
+	Request.Settings.reset();
+	AssetDatabase::Get().RequestLoad(Request);
+	EXPECT_EQ(Request.Target, First);
+
+	Request.Settings = 2u;
+	AssetDatabase::Get().RequestLoad(Request);
+	EXPECT_NE(Request.Target, First);
+	EXPECT_EQ(m_Loader->GetLoaded().size(), 2u);
+}
+
+TEST_F(AssetDatabaseTest, LoadsAndInvalidatesDependencies)
+{
+	const auto Scene = CreateAsset("Scene.testasset");
+	const auto Material = CreateAsset("Material.testasset");
+	const auto Texture = CreateAsset("Texture.testasset");
+	const auto Unrelated = CreateAsset("Unrelated.testasset");
+
+	ASSERT_TRUE(AssetDatabase::Get().AddDependency(Scene, Material));
+	ASSERT_TRUE(AssetDatabase::Get().AddDependency(Material, Texture));
+	EXPECT_EQ(AssetDatabase::Get().GetDependents(Texture), (std::vector<std::filesystem::path>{ Material, Scene }));
+	EXPECT_EQ(AssetDatabase::Get().GetDependents(Texture, false), (std::vector<std::filesystem::path>{ Material }));
+
+	/// Edges closing a cycle are rejected and leave the graph as it was.
+	EXPECT_FALSE(AssetDatabase::Get().AddDependency(Texture, Scene));
+	EXPECT_FALSE(AssetDatabase::Get().AddDependency(Texture, Material));
+	EXPECT_FALSE(AssetDatabase::Get().AddDependency(Texture, Texture));
+	EXPECT_TRUE(AssetDatabase::Get().GetDependencies(Texture).empty());
+
+	/// Loading the scene loads what it depends on first.
+	auto SceneAsset = Load(Scene);
+	Load(Unrelated);
+	EXPECT_EQ(m_Loader->GetLoaded(), (std::vector<std::filesystem::path>{ Texture, Material, Scene, Unrelated }));
+	EXPECT_NE(AssetDatabase::Get().FindAsset(Texture), nullptr);
+	EXPECT_NE(AssetDatabase::Get().FindAsset(Material), nullptr);
+
+	/// A changed texture reloads everything up the chain, dependencies before dependents, and nothing else.
+	AssetDatabase::Get().Invalidate(Texture);
+
+	std::vector<std::filesystem::path> Loaded;
+	for (uint32_t Retry = 0u; Retry < 1000u && (Loaded = m_Loader->GetLoaded()).size() < 7u; ++Retry)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	EXPECT_EQ(Loaded, (std::vector<std::filesystem::path>{ Texture, Material, Scene, Unrelated, Texture, Material, Scene }));
+
+	auto ReloadedScene = AssetDatabase::Get().FindAsset(Scene);
+	ASSERT_NE(ReloadedScene, nullptr);
+	EXPECT_NE(ReloadedScene, SceneAsset);
+}
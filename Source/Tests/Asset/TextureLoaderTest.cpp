@@ -0,0 +1,228 @@
+#include "Common/TestUtils.h"
+#include "Asset/Texture.h"
+#include "Asset/AssetLoaders/TextureLoader.h"
+#include <Asset/DDS.h>
+#include <gtest/gtest.h>
+#include <fstream>
+
+/// Mirrors the KTX 2.0 header and level index the loader reads.
+struct TestKTX2Header
+{
+	uint8_t Identifier[12u] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+	uint32_t VkFormat = 37u; /// VK_FORMAT_R8G8B8A8_UNORM
+	uint32_t TypeSize = 1u;
+	uint32_t PixelWidth = 0u;
+	uint32_t PixelHeight = 0u;
+	uint32_t PixelDepth = 0u;
+	uint32_t LayerCount = 0u;
+	uint32_t FaceCount = 1u;
+	uint32_t LevelCount = 0u;
+	uint32_t SupercompressionScheme = 0u;
+
+	uint32_t DFDByteOffset = 0u;
+	uint32_t DFDByteLength = 0u;
+	uint32_t KVDByteOffset = 0u;
+	uint32_t KVDByteLength = 0u;
+	uint64_t SGDByteOffset = 0u;
+	uint64_t SGDByteLength = 0u;
+};
+static_assert(sizeof(TestKTX2Header) == 80u);
+
+struct TestKTX2LevelIndex
+{
+	uint64_t ByteOffset;
+	uint64_t ByteLength;
+	uint64_t UncompressedByteLength;
+};
+
+/// Synthetic RGBA8 files, the pixel bytes are zeros.
+class TextureLoaderTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite()
+	{
+		InitializeTaskSystem();
+	}
+
+	void SetUp() override
+	{
+		m_Root = GetTestTempPath();
+	}
+
+	template<class T>
+	static void Append(std::string& Data, const T& Value)
+	{
+		Data.append(reinterpret_cast<const char*>(&Value), sizeof(T));
+	}
+
+	static size_t GetChainSize(uint32_t Width, uint32_t Height, uint32_t NumMips)
+	{
+		size_t Size = 0u;
+		for (uint32_t Mip = 0u; Mip < NumMips; ++Mip)
+		{
+			Size += static_cast<size_t>(std::max(Width >> Mip, 1u)) * std::max(Height >> Mip, 1u) * 4u;
+		}
+		return Size;
+	}
+
+	/// A DX10 header, the file holds PixelsSize bytes after the headers.
+	std::filesystem::path WriteDDS(const char* Name, uint32_t Width, uint32_t Height, uint32_t NumMips, uint32_t ArraySize, bool IsCube, size_t PixelsSize)
+	{
+		DirectX::DDS_HEADER Header{};
+		Header.size = sizeof(DirectX::DDS_HEADER);
+		Header.flags = DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP;
+		Header.width = Width;
+		Header.height = Height;
+		Header.mipMapCount = NumMips;
+		Header.ddspf.size = sizeof(DirectX::DDS_PIXELFORMAT);
+		Header.ddspf.flags = DDS_FOURCC;
+		Header.ddspf.fourCC = MAKEFOURCC('D', 'X', '1', '0');
+		Header.caps = DDS_SURFACE_FLAGS_TEXTURE;
+
+		DirectX::DDS_HEADER_DXT10 DXTHeader{};
+		DXTHeader.dxgiFormat = DXGI_FORMAT_R8G8B8A8_UNORM;
+		DXTHeader.resourceDimension = DirectX::DDS_DIMENSION_TEXTURE2D;
+		DXTHeader.miscFlag = IsCube ? DirectX::DDS_RESOURCE_MISC_TEXTURECUBE : 0u;
+		DXTHeader.arraySize = ArraySize;
+
+		std::string Data;
+		Append(Data, DirectX::DDS_MAGIC);
+		Append(Data, Header);
+		Append(Data, DXTHeader);
+		Data.append(PixelsSize, '\0');
+
+		return Write(Name, Data);
+	}
+
+	/// Levels are stored smallest first, Truncate bytes are cut off the end of the file.
+	std::filesystem::path WriteKTX2(const char* Name, uint32_t Width, uint32_t Height, uint32_t NumLevels, size_t Truncate = 0u)
+	{
+		TestKTX2Header Header;
+		Header.PixelWidth = Width;
+		Header.PixelHeight = Height;
+		Header.LevelCount = NumLevels;
+
+		std::vector<TestKTX2LevelIndex> Levels(std::max(NumLevels, 1u));
+		size_t Offset = sizeof(TestKTX2Header) + sizeof(TestKTX2LevelIndex) * Levels.size();
+		for (uint32_t Level = static_cast<uint32_t>(Levels.size()); Level-- > 0u;)
+		{
+			const size_t Size = GetChainSize(std::max(Width >> Level, 1u), std::max(Height >> Level, 1u), 1u);
+			Levels[Level] = TestKTX2LevelIndex{ Offset, Size, Size };
+			Offset += Size;
+		}
+
+		std::string Data;
+		Append(Data, Header);
+		for (const auto& Level : Levels)
+		{
+			Append(Data, Level);
+		}
+		Data.resize(Offset - std::min(Truncate, Offset), '\0');
+
+		return Write(Name, Data);
+	}
+
+	std::filesystem::path Write(const char* Name, const std::string& Data)
+	{
+		const auto Path = m_Root / Name;
+		std::ofstream Stream(Path, std::ios::binary | std::ios::trunc);
+		Stream.write(Data.data(), static_cast<std::streamsize>(Data.size()));
+		EXPECT_TRUE(Stream.good());
+		return Path;
+	}
+
+	std::shared_ptr<Texture> Load(const std::filesystem::path& Path, bool& OutLoaded)
+	{
+		auto Image = std::make_shared<Texture>(Path);
+		OutLoaded = m_Loader.Load(*Image);
+		return Image;
+	}
+
+	bool Load(const std::filesystem::path& Path)
+	{
+		bool Loaded = false;
+		Load(Path, Loaded);
+		return Loaded;
+	}
+
+	std::filesystem::path m_Root;
+	TextureLoader m_Loader;
+};
+
+TEST_F(TextureLoaderTest, LoadsDDS)
+{
+	const auto Path = WriteDDS("Image.dds", 16u, 8u, 5u, 1u, false, GetChainSize(16u, 8u, 5u));
+
+	bool Loaded = false;
+	auto Image = Load(Path, Loaded);
+	ASSERT_TRUE(Loaded);
+
+	const auto& Desc = Image->GetDesc();
+	EXPECT_EQ(Desc.Width, 16u);
+	EXPECT_EQ(Desc.Height, 8u);
+	EXPECT_EQ(Desc.NumMipLevel, 5u);
+	EXPECT_EQ(Desc.NumArrayLayer, 1u);
+	EXPECT_EQ(Desc.Dimension, ERHITextureDimension::T_2D);
+}
+
+TEST_F(TextureLoaderTest, LoadsDDSCubemaps)
+{
+	const auto Path = WriteDDS("Cube.dds", 8u, 8u, 4u, 2u, true, GetChainSize(8u, 8u, 4u) * 12u);
+
+	bool Loaded = false;
+	auto Image = Load(Path, Loaded);
+	ASSERT_TRUE(Loaded);
+
+	EXPECT_EQ(Image->GetDesc().NumArrayLayer, 12u);
+	EXPECT_EQ(Image->GetDesc().Dimension, ERHITextureDimension::T_Cube_Array);
+}
+
+TEST_F(TextureLoaderTest, RejectsTruncatedDDS)
+{
+	EXPECT_FALSE(Load(WriteDDS("Image.dds", 16u, 8u, 5u, 1u, false, GetChainSize(16u, 8u, 5u) - 1u)));
+}
+
+TEST_F(TextureLoaderTest, RejectsDDSOutsideTheLimits)
+{
+	EXPECT_FALSE(Load(WriteDDS("ZeroWidth.dds", 0u, 8u, 1u, 1u, false, 64u)));
+	EXPECT_FALSE(Load(WriteDDS("TooWide.dds", 16385u, 1u, 1u, 1u, false, 16385u * 4u)));
+	EXPECT_FALSE(Load(WriteDDS("TooManyMips.dds", 16u, 16u, 16u, 1u, false, 4096u)));
+	EXPECT_FALSE(Load(WriteDDS("TooManyLayers.dds", 1u, 1u, 1u, 2049u, false, 2049u * 4u)));
+
+	/// 6 times the array size wraps around to 6 layers in 32 bits.
+	EXPECT_FALSE(Load(WriteDDS("WrappingCube.dds", 1u, 1u, 1u, 0x80000001u, true, 6u * 4u)));
+
+	/// The header claims far more pixels than any size_t can address, the file is tiny.
+	EXPECT_FALSE(Load(WriteDDS("Huge.dds", 0xFFFFFFFFu, 0xFFFFFFFFu, 1u, 1u, false, 64u)));
+}
+
+TEST_F(TextureLoaderTest, LoadsKTX2)
+{
+	const auto Path = WriteKTX2("Image.ktx2", 8u, 8u, 4u);
+
+	bool Loaded = false;
+	auto Image = Load(Path, Loaded);
+	ASSERT_TRUE(Loaded);
+
+	const auto& Desc = Image->GetDesc();
+	EXPECT_EQ(Desc.Width, 8u);
+	EXPECT_EQ(Desc.Height, 8u);
+	EXPECT_EQ(Desc.NumMipLevel, 4u);
+	EXPECT_EQ(Desc.Dimension, ERHITextureDimension::T_2D);
+
+	/// The smallest level comes first in the file.
+	const size_t LevelsOffset = sizeof(TestKTX2Header) + sizeof(TestKTX2LevelIndex) * 4u;
+	EXPECT_EQ(Desc.SubresourceOffsets, (std::vector<size_t>{ LevelsOffset + 4u + 16u + 64u, LevelsOffset + 4u + 16u, LevelsOffset + 4u, LevelsOffset }));
+}
+
+TEST_F(TextureLoaderTest, RejectsTruncatedKTX2)
+{
+	EXPECT_FALSE(Load(WriteKTX2("Image.ktx2", 8u, 8u, 4u, 1u)));
+}
+
+TEST_F(TextureLoaderTest, RejectsKTX2OutsideTheLimits)
+{
+	EXPECT_FALSE(Load(WriteKTX2("ZeroWidth.ktx2", 0u, 8u, 1u)));
+	EXPECT_FALSE(Load(WriteKTX2("TooWide.ktx2", 16385u, 1u, 1u)));
+	EXPECT_FALSE(Load(WriteKTX2("TooManyMips.ktx2", 16u, 16u, 16u)));
+}
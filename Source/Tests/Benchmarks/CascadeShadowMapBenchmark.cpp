@@ -0,0 +1,72 @@
+#include "Common/TestUtils.h"
+#include "Rendering/CascadeShadowMap.h"
+#include "Scene/SceneView.h"
+#include "Scene/Components/Camera.h"
+#include "Scene/Components/PrimitiveComponent.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+/// 4 cascades over the first 200 units of a camera looking down +Z, the casters are scattered over a 1000 x 1000 field around it
+/// so some land in every cascade and most in none.
+class CascadeShadowMapBenchmark : public benchmark::Fixture
+{
+public:
+	void SetUp(const benchmark::State& State) override
+	{
+		InitializeTaskSystem();
+
+		m_Camera = std::make_unique<Camera>(Camera::EMode::FirstPerson, Math::Vector3(0.0f, 2.0f, 0.0f), Math::Vector3(0.0f, 2.0f, 1.0f), Math::PI_Div4, 16.0f / 9.0f, 0.1f, 1000.0f);
+		m_View.SetCamera(m_Camera.get());
+
+		RenderSettings::ShadowSettings Settings;
+		Settings.NumCascades = 4u;
+		m_ShadowMap.Update(m_View, Math::Vector3(0.3f, -1.0f, 0.2f), Math::AABB(Math::Vector3(-500.0f, 0.0f, -500.0f), Math::Vector3(500.0f, 50.0f, 500.0f)), Settings);
+
+		std::mt19937 Random(1u);
+		std::uniform_real_distribution<float> Position(-500.0f, 500.0f);
+		std::uniform_real_distribution<float> Height(0.0f, 50.0f);
+
+		const size_t NumCasters = static_cast<size_t>(State.range(0));
+		m_Owners.resize(NumCasters);
+		m_Primitives.resize(NumCasters);
+		for (size_t Index = 0u; Index < NumCasters; ++Index)
+		{
+			auto& Primitive = m_Owners[Index];
+			Primitive = std::make_shared<PrimitiveComponent>();
+			Primitive->SetLocalBounds(BoxSphereBounds(Math::Vector3(0.0f), Math::Vector3(1.0f), std::sqrt(3.0f)));
+			Primitive->SetWorldTransform(Math::Matrix::Translation(Position(Random), Height(Random), Position(Random)));
+			m_Primitives[Index] = Primitive.get();
+		}
+	}
+
+	void TearDown(const benchmark::State&) override
+	{
+		m_Primitives.clear();
+		m_Owners.clear();
+	}
+protected:
+	std::unique_ptr<Camera> m_Camera;
+	PlanarSceneView m_View;
+	CascadeShadowMap m_ShadowMap;
+
+	std::vector<const PrimitiveComponent*> m_Primitives;
+	std::vector<std::shared_ptr<PrimitiveComponent>> m_Owners;
+};
+
+BENCHMARK_DEFINE_F(CascadeShadowMapBenchmark, CullCasters)(benchmark::State& State)
+{
+	for (auto _ : State)
+	{
+		m_ShadowMap.CullCasters(m_Primitives);
+		benchmark::DoNotOptimize(m_ShadowMap.GetCascades().data());
+	}
+
+	size_t NumCasters = 0u;
+	for (const auto& Cascade : m_ShadowMap.GetCascades())
+	{
+		NumCasters += Cascade.Casters.size();
+	}
+	State.counters["Casters"] = static_cast<double>(NumCasters);
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK_REGISTER_F(CascadeShadowMapBenchmark, CullCasters)->Arg(100000)->Unit(benchmark::kMicrosecond);
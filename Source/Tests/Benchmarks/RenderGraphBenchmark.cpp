@@ -0,0 +1,148 @@
+#include "Common/RecordingRHI.h"
+#include "Rendering/RenderGraph/RenderGraph.h"
+#include "Rendering/RenderGraph/RenderTargetPool.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+static const std::vector<std::string>& GetPassNames(uint32_t NumPasses)
+{
+	static std::vector<std::string> s_Names;
+
+	while (s_Names.size() < NumPasses)
+	{
+		s_Names.emplace_back("Pass" + std::to_string(s_Names.size()));
+	}
+	return s_Names;
+}
+
+/// Every pass writes a texture of its own and reads up to two of the last eight, every fiftieth also writes the back buffer, every
+/// fourth runs async compute. The same seed gives the same graph, so frames after the first keep its shape.
+static void AddPasses(RDGRenderGraph& Graph, const RHITexturePtr& BackBuffer, const RHITextureDesc& BackBufferDesc, uint32_t NumPasses)
+{
+	const auto& Names = GetPassNames(NumPasses);
+	std::mt19937 Random(1u);
+	std::vector<RDGTexture*> Textures;
+	Textures.reserve(NumPasses);
+
+	auto Output = Graph.RegisterExternalTexture(BackBuffer, BackBufferDesc);
+
+	for (uint32_t Index = 0u; Index < NumPasses; ++Index)
+	{
+		const bool AsyncCompute = Index % 4u == 3u;
+		auto& Pass = Graph.AddPass(RDGEvent(Names[Index].c_str()), AsyncCompute ? ERDGPassFlags::Compute | ERDGPassFlags::AsyncCompute : ERDGPassFlags::Raster,
+			[](RHICommandBuffer& CommandBuffer) { CommandBuffer.Draw(3u); });
+
+		for (uint32_t Read = 0u; Read < 2u && !Textures.empty(); ++Read)
+		{
+			const size_t Window = std::min<size_t>(Textures.size(), 8u);
+			Pass.ReadTexture(Textures[Textures.size() - 1u - Random() % Window]);
+		}
+
+		RHITextureDesc Desc;
+		Desc.Width = Desc.Height = 256u << (Random() % 3u);
+		Desc.Format = ERHIFormat::RGBA8_UNorm;
+		Desc.Dimension = ERHITextureDimension::T_2D;
+		Desc.Name = Names[Index].c_str();
+
+		auto Texture = Graph.CreateTexture(Desc);
+		Pass.WriteTexture(Texture, AsyncCompute ? ERHIResourceState::UnorderedAccess : ERHIResourceState::RenderTarget);
+		Textures.push_back(Texture);
+
+		if (Index % 50u == 49u)
+		{
+			Pass.WriteTexture(Output);
+		}
+	}
+}
+
+class RenderGraphBenchmark : public benchmark::Fixture
+{
+public:
+	RenderGraphBenchmark()
+		: m_Pool(m_Device)
+	{
+		m_BackBufferDesc.Width = m_BackBufferDesc.Height = 1024u;
+		m_BackBufferDesc.Format = ERHIFormat::RGBA8_UNorm;
+		m_BackBufferDesc.Dimension = ERHITextureDimension::T_2D;
+		m_BackBufferDesc.PermanentState = ERHIResourceState::Present;
+		m_BackBufferDesc.Name = "BackBuffer";
+		m_BackBuffer = std::make_shared<RecordingTexture>(m_BackBufferDesc);
+	}
+protected:
+	RenderSettings m_Settings;
+	RecordingDevice m_Device;
+	RDGRenderTargetPool m_Pool;
+
+	RHITextureDesc m_BackBufferDesc;
+	RHITexturePtr m_BackBuffer;
+};
+
+/// Planning from scratch: dependencies, sorting, culling, aliasing, barriers and the async compute schedule.
+BENCHMARK_DEFINE_F(RenderGraphBenchmark, CompileFromScratch)(benchmark::State& State)
+{
+	const uint32_t NumPasses = static_cast<uint32_t>(State.range(0));
+
+	for (auto _ : State)
+	{
+		State.PauseTiming();
+		RDGRenderGraph Graph(m_Settings, m_Pool);
+		AddPasses(Graph, m_BackBuffer, m_BackBufferDesc, NumPasses);
+		State.ResumeTiming();
+
+		benchmark::DoNotOptimize(Graph.Compile(true));
+	}
+
+	State.SetItemsProcessed(State.iterations() * NumPasses);
+}
+BENCHMARK_REGISTER_F(RenderGraphBenchmark, CompileFromScratch)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+/// A graph rebuilt every frame in the same shape, compiling only hashes it and restores the plan of the previous frame.
+BENCHMARK_DEFINE_F(RenderGraphBenchmark, CompileCached)(benchmark::State& State)
+{
+	const uint32_t NumPasses = static_cast<uint32_t>(State.range(0));
+	RDGRenderGraph Graph(m_Settings, m_Pool);
+	AddPasses(Graph, m_BackBuffer, m_BackBufferDesc, NumPasses);
+	Graph.Compile(true);
+
+	for (auto _ : State)
+	{
+		State.PauseTiming();
+		Graph.Reset();
+		AddPasses(Graph, m_BackBuffer, m_BackBufferDesc, NumPasses);
+		State.ResumeTiming();
+
+		benchmark::DoNotOptimize(Graph.Compile(true));
+	}
+
+	State.counters["CacheHits"] = static_cast<double>(Graph.GetCompileStats().NumCacheHits);
+	State.SetItemsProcessed(State.iterations() * NumPasses);
+}
+BENCHMARK_REGISTER_F(RenderGraphBenchmark, CompileCached)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+/// A whole frame on the recording device: building the graph, compiling from the cache, acquiring pooled memory and recording the
+/// passes and barriers on both queues.
+BENCHMARK_DEFINE_F(RenderGraphBenchmark, BuildAndExecute)(benchmark::State& State)
+{
+	const uint32_t NumPasses = static_cast<uint32_t>(State.range(0));
+	RDGRenderGraph Graph(m_Settings, m_Pool);
+	RecordingCommandListContext Graphics("Graphics");
+	RecordingCommandListContext Compute("Compute");
+
+	for (auto _ : State)
+	{
+		AddPasses(Graph, m_BackBuffer, m_BackBufferDesc, NumPasses);
+		Graph.Execute(Graphics, &Compute);
+		Graphics.SubmitGraphicsCommandBuffer();
+		Compute.SubmitGraphicsCommandBuffer();
+
+		State.PauseTiming();
+		Graph.Reset();
+		m_Pool.Tick();
+		Graphics.ClearSubmitted();
+		Compute.ClearSubmitted();
+		State.ResumeTiming();
+	}
+
+	State.SetItemsProcessed(State.iterations() * NumPasses);
+}
+BENCHMARK_REGISTER_F(RenderGraphBenchmark, BuildAndExecute)->Arg(500)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,54 @@
+#include "Common/TestUtils.h"
+#include "Scene/Components/StaticMesh.h"
+#include <benchmark/benchmark.h>
+#include <random>
+
+/// Bounds of a point cloud with normals, texcoords and a single face. The first argument is the vertex count, the second interleaves
+/// the vertices and the third allows the parallel reduction.
+class StaticMeshBenchmark : public benchmark::Fixture
+{
+public:
+	void SetUp(const benchmark::State& State) override
+	{
+		InitializeTaskSystem();
+
+		VertexLayout Layout;
+		Layout.Interleaved = State.range(1) != 0;
+
+		const uint32_t NumVertex = static_cast<uint32_t>(State.range(0));
+		m_Data = std::make_unique<MeshData>(NumVertex, 3u, 1u, true, false, true, false, false, false, ERHIPrimitiveTopology::TriangleList, Layout);
+		m_Data->SetFace(0u, 0u, 1u, 2u);
+
+		std::mt19937 Random(1u);
+		std::uniform_real_distribution<float> Coordinate(-100.0f, 100.0f);
+		for (uint32_t Index = 0u; Index < NumVertex; ++Index)
+		{
+			m_Data->SetPosition(Index, Math::Vector3(Coordinate(Random), Coordinate(Random), Coordinate(Random)));
+			m_Data->SetNormal(Index, Math::Vector3(0.0f, 0.0f, 1.0f));
+			m_Data->SetUV0(Index, Math::Vector2(0.0f, 0.0f));
+		}
+	}
+
+	void TearDown(const benchmark::State&) override
+	{
+		m_Data.reset();
+	}
+protected:
+	std::unique_ptr<MeshData> m_Data;
+};
+
+BENCHMARK_DEFINE_F(StaticMeshBenchmark, ComputeBounds)(benchmark::State& State)
+{
+	const bool AllowParallel = State.range(2) != 0;
+	for (auto _ : State)
+	{
+		BoxSphereBounds Bounds = m_Data->ComputeBounds(AllowParallel);
+		benchmark::DoNotOptimize(Bounds);
+	}
+
+	State.SetItemsProcessed(State.iterations() * State.range(0));
+}
+BENCHMARK_REGISTER_F(StaticMeshBenchmark, ComputeBounds)
+	->ArgNames({ "Vertices", "Interleaved", "Parallel" })
+	->ArgsProduct({ { 1000000 }, { 0, 1 }, { 0, 1 } })
+	->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,171 @@
+#include "Common/RecordingRHI.h"
+
+RecordingBuffer::RecordingBuffer(const RHIBufferDesc& Desc)
+	: RHIBuffer(Desc)
+	, m_Memory(Desc.Size)
+{
+	if (Desc.InitialData)
+	{
+		std::memcpy(m_Memory.data(), Desc.InitialData, Desc.Size);
+	}
+}
+
+void* RecordingBuffer::Map(ERHIMapMode Mode, size_t Size, size_t Offset)
+{
+	assert(!m_MappedMemory.Memory && Offset <= m_Memory.size());
+
+	m_MappedMemory.Memory = m_Memory.data() + Offset;
+	m_MappedMemory.Size = Size == RHI_WHOLE_SIZE ? m_Memory.size() - Offset : Size;
+	m_MappedMemory.Offset = Offset;
+	m_MappedMemory.Mode = Mode;
+	return m_MappedMemory.Memory;
+}
+
+void RecordingBuffer::Unmap()
+{
+	assert(m_MappedMemory.Memory);
+	m_MappedMemory = RHIMappedMemory();
+}
+
+void RecordingCommandBuffer::Begin()
+{
+	assert(IsReady());
+
+	m_Commands.clear();
+	m_Barriers.clear();
+	SetStatus(EStatus::Recording);
+}
+
+void RecordingCommandBuffer::End()
+{
+	assert(IsRecording());
+	SetStatus(EStatus::Ended);
+}
+
+void RecordingCommandBuffer::Reset()
+{
+	SetStatus(EStatus::Initial);
+}
+
+void RecordingCommandBuffer::Transition(const RHITransition* Transitions, uint32_t NumTransitions)
+{
+	assert(IsRecording());
+
+	m_Barriers.emplace_back(Transitions, Transitions + NumTransitions);
+	m_Commands.emplace_back("Barrier");
+}
+
+void RecordingCommandBuffer::Submit()
+{
+	assert(GetLevel() == ERHICommandBufferLevel::Primary);
+
+	End();
+	m_FenceSignaledCounter.fetch_add(1u, std::memory_order_relaxed);
+	SetStatus(EStatus::NeedReset);
+}
+
+void RecordingCommandBuffer::RefreshStatus()
+{
+	if (GetLevel() == ERHICommandBufferLevel::Secondary && IsSubmitted() && IsPrimarySubmissionCompleted())
+	{
+		SetStatus(EStatus::NeedReset);
+	}
+}
+
+void RecordingCommandBuffer::ExecuteSecondaryCommands(RHICommandBuffer* const* CommandBuffers, uint32_t NumCommandBuffers)
+{
+	for (uint32_t Index = 0u; Index < NumCommandBuffers; ++Index)
+	{
+		auto& Secondary = static_cast<const RecordingCommandBuffer&>(*CommandBuffers[Index]);
+
+		m_Commands.insert(m_Commands.end(), Secondary.m_Commands.begin(), Secondary.m_Commands.end());
+		m_Barriers.insert(m_Barriers.end(), Secondary.m_Barriers.begin(), Secondary.m_Barriers.end());
+	}
+}
+
+void RecordingCommandListContext::SubmitGraphicsCommandBuffer()
+{
+	if (auto CommandBuffer = static_cast<RecordingCommandBuffer*>(m_PrimaryCommandBufferList.Graphics))
+	{
+		m_SubmittedCommands.insert(m_SubmittedCommands.end(), CommandBuffer->GetCommands().begin(), CommandBuffer->GetCommands().end());
+		m_SubmittedBarriers.insert(m_SubmittedBarriers.end(), CommandBuffer->GetBarriers().begin(), CommandBuffer->GetBarriers().end());
+
+		CommandBuffer->Submit();
+		m_PrimaryCommandBufferList.Graphics = nullptr;
+	}
+}
+
+void RecordingCommandListContext::SubmitUploadCommandBuffer(RHICommandBuffer* UploadCommandBuffer)
+{
+	auto CommandBuffer = static_cast<RecordingCommandBuffer*>(UploadCommandBuffer ? UploadCommandBuffer : m_PrimaryCommandBufferList.Upload);
+	if (CommandBuffer)
+	{
+		CommandBuffer->Submit();
+	}
+
+	if (CommandBuffer == m_PrimaryCommandBufferList.Upload)
+	{
+		m_PrimaryCommandBufferList.Upload = nullptr;
+	}
+}
+
+void RecordingCommandListContext::SignalTimeline(uint64_t Value)
+{
+	assert(Value > m_TimelineValue);
+
+	SubmitGraphicsCommandBuffer();
+
+	m_TimelineValue = Value;
+	m_SubmittedCommands.emplace_back(fmt::format("Signal {} {}", m_Name, Value));
+}
+
+void RecordingCommandListContext::WaitTimeline(RHICommandListContext& Other, uint64_t Value)
+{
+	assert(&Other != this);
+
+	SubmitGraphicsCommandBuffer();
+
+	m_SubmittedCommands.emplace_back(fmt::format("Wait {} {}", static_cast<RecordingCommandListContext&>(Other).GetName(), Value));
+}
+
+void RecordingCommandListContext::ClearSubmitted()
+{
+	m_SubmittedCommands.clear();
+	m_SubmittedBarriers.clear();
+}
+
+RecordingDevice::RecordingDevice(bool SupportsTimelineSemaphore, bool SupportsSplitBarriers)
+{
+	m_Capabilities.SupportsAsyncCompute = true;
+	m_Capabilities.SupportsTimelineSemaphore = SupportsTimelineSemaphore;
+	m_Capabilities.SupportsSplitBarriers = SupportsSplitBarriers;
+}
+
+RHITexturePtr RecordingDevice::CreateTexture(const RHITextureDesc& Desc) const
+{
+	m_NumCreatedTextures.fetch_add(1u, std::memory_order_relaxed);
+	return std::make_shared<RecordingTexture>(Desc);
+}
+
+RHIBufferPtr RecordingDevice::CreateBuffer(const RHIBufferDesc& Desc) const
+{
+	m_NumCreatedBuffers.fetch_add(1u, std::memory_order_relaxed);
+	return std::make_shared<RecordingBuffer>(Desc);
+}
+
+RHICommandListContext* RecordingDevice::GetImmediateCommandListContext(ERHIDeviceQueue Queue)
+{
+	std::lock_guard Locker(m_CmdListContextLock);
+
+	auto& Context = m_ImmediateContexts[static_cast<size_t>(Queue)];
+	if (!Context)
+	{
+		Context = std::make_unique<RecordingCommandListContext>(Queue == ERHIDeviceQueue::Compute ? "Compute" : (Queue == ERHIDeviceQueue::Transfer ? "Transfer" : "Graphics"));
+	}
+	return Context.get();
+}
+
+RHICommandListContextPtr RecordingDevice::AcquireDeferredCommandListContext()
+{
+	return std::make_shared<RecordingCommandListContext>("Deferred");
+}
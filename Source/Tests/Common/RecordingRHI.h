@@ -0,0 +1,168 @@
+#pragma once
+
+#include "RHI/RHIDevice.h"
+#include "RHI/RHICommandListContext.h"
+#include "RHI/RHIBuffer.h"
+
+/// A device without a GPU for headless tests and benchmarks. Textures only keep their descriptions, buffers are backed by host memory,
+/// and command buffers execute nothing but log what is recorded, so tests can compare the command stream of a frame as text.
+
+class RecordingTexture final : public RHITexture
+{
+public:
+	using RHITexture::RHITexture;
+};
+
+class RecordingBuffer final : public RHIBuffer
+{
+public:
+	RecordingBuffer(const RHIBufferDesc& Desc);
+
+	void* Map(ERHIMapMode Mode, size_t Size, size_t Offset) override final;
+	void Unmap() override final;
+	void FlushMappedRange(size_t, size_t) override final {}
+	void InvalidateMappedRange(size_t, size_t) override final {}
+private:
+	std::vector<uint8_t> m_Memory;
+};
+
+/// Logs debug markers by name, draws and dispatches by kind, and every barrier as "Barrier" with its transitions kept aside. A primary
+/// command buffer executing secondary ones appends their logs to its own, as if it recorded their commands itself.
+class RecordingCommandBuffer final : public RHICommandBuffer
+{
+public:
+	using RHICommandBuffer::RHICommandBuffer;
+
+	void Begin() override final;
+	void End() override final;
+	void Reset() override final;
+
+	void BeginDebugMarker(const char* Name, const Math::Color&) override final { m_Commands.emplace_back(Name); }
+	void EndDebugMarker() override final {}
+
+	void SetVertexBuffer(const RHIBuffer*, uint32_t, size_t) override final {}
+	void SetVertexStream(uint32_t, const RHIVertexStream&) override final {}
+	void SetIndexBuffer(const RHIBuffer*, size_t, ERHIIndexFormat) override final {}
+	void SetPrimitiveTopology(ERHIPrimitiveTopology) override final {}
+
+	void Draw(uint32_t, uint32_t) override final { m_Commands.emplace_back("Draw"); }
+	void DrawInstanced(uint32_t, uint32_t, uint32_t, uint32_t) override final { m_Commands.emplace_back("Draw"); }
+	void DrawIndirect(const RHIBuffer*, size_t, uint32_t, uint32_t) override final { m_Commands.emplace_back("Draw"); }
+
+	void DrawIndexed(uint32_t, uint32_t, int32_t) override final { m_Commands.emplace_back("Draw"); }
+	void DrawIndexedInstanced(uint32_t, uint32_t, uint32_t, int32_t, uint32_t) override final { m_Commands.emplace_back("Draw"); }
+	void DrawIndexedIndirect(const RHIBuffer*, size_t, uint32_t, uint32_t) override final { m_Commands.emplace_back("Draw"); }
+
+	void Dispatch(uint32_t, uint32_t, uint32_t) override final { m_Commands.emplace_back("Dispatch"); }
+	void DispatchIndirect(const RHIBuffer*, size_t) override final { m_Commands.emplace_back("Dispatch"); }
+
+	void PushConstants(ERHIShaderStage, const RHIBuffer*, const void*, size_t, size_t) override final {}
+
+	void SetGraphicsPipeline(const RHIGraphicsPipeline*) override final {}
+
+	void ClearColorTexture(const RHITexture*, const Math::Color&) override final {}
+	void ClearDepthStencilTexture(const RHITexture*, bool, bool, float, uint8_t) override final {}
+
+	void WriteBuffer(const RHIBuffer*, const RHIBuffer*, size_t, size_t, size_t) override final {}
+	void WriteTexture(const RHITexture*, const RHIBuffer*, size_t, uint32_t, uint32_t, size_t) override final {}
+	void WriteTexture(const RHITexture*, const RHIBuffer*, size_t, size_t) override final {}
+
+	void Transition(const RHITransition* Transitions, uint32_t NumTransitions) override final;
+
+	void SetViewport(const RHIViewport&) override final {}
+	void SetViewports(const RHIViewport*, uint32_t) override final {}
+
+	void SetScissorRect(const RHIScissorRect&) override final {}
+	void SetScissorRects(const RHIScissorRect*, uint32_t) override final {}
+
+	/// Appends to the log, for what the command buffer does not record itself, e.g. the queue synchronization of its context.
+	inline void AddCommand(std::string&& Command) { m_Commands.emplace_back(std::move(Command)); }
+
+	inline const std::vector<std::string>& GetCommands() const { return m_Commands; }
+	inline const std::vector<std::vector<RHITransition>>& GetBarriers() const { return m_Barriers; }
+
+	/// Ends a primary command buffer and completes its submission at once, the secondary ones it executed become free for reuse.
+	void Submit();
+protected:
+	void RefreshStatus() override final;
+
+	void ExecuteSecondaryCommands(RHICommandBuffer* const* CommandBuffers, uint32_t NumCommandBuffers) override final;
+private:
+	std::vector<std::string> m_Commands;
+	std::vector<std::vector<RHITransition>> m_Barriers;
+};
+
+class RecordingCommandBufferPool final : public RHICommandBufferPool
+{
+protected:
+	RHICommandBufferPtr AllocateCommandBuffer(ERHICommandBufferLevel Level) override final { return std::make_shared<RecordingCommandBuffer>(Level); }
+};
+
+/// Submitting moves the log of the graphics command buffer to the submitted commands of the context, in queue order. Timeline signals
+/// and waits submit too and then log as "Signal <Name> <Value>" and "Wait <Other Name> <Value>", nothing ever blocks.
+class RecordingCommandListContext final : public RHICommandListContext
+{
+public:
+	RecordingCommandListContext(std::string_view Name)
+		: m_Name(Name)
+	{
+	}
+
+	void SubmitGraphicsCommandBuffer() override final;
+	void SubmitUploadCommandBuffer(RHICommandBuffer* UploadCommandBuffer) override final;
+
+	uint64_t GetTimelineValue() const override final { return m_TimelineValue; }
+	void SignalTimeline(uint64_t Value) override final;
+	void WaitTimeline(RHICommandListContext& Other, uint64_t Value) override final;
+
+	inline const std::string& GetName() const { return m_Name; }
+
+	inline const std::vector<std::string>& GetSubmittedCommands() const { return m_SubmittedCommands; }
+	inline const std::vector<std::vector<RHITransition>>& GetSubmittedBarriers() const { return m_SubmittedBarriers; }
+
+	/// For the next frame to start from an empty log, the timeline keeps its value.
+	void ClearSubmitted();
+protected:
+	RHICommandBufferPtr AllocateCommandBuffer(ERHICommandBufferLevel Level) override final { return std::make_shared<RecordingCommandBuffer>(Level); }
+	RHICommandBufferPoolPtr CreateCommandBufferPool() override final { return std::make_shared<RecordingCommandBufferPool>(); }
+private:
+	std::string m_Name;
+	uint64_t m_TimelineValue = 0u;
+
+	std::vector<std::string> m_SubmittedCommands;
+	std::vector<std::vector<RHITransition>> m_SubmittedBarriers;
+};
+
+class RecordingDevice final : public RHIDevice
+{
+public:
+	RecordingDevice(bool SupportsTimelineSemaphore = true, bool SupportsSplitBarriers = true);
+
+	ERHIDeviceType GetType() const override final { return ERHIDeviceType::Software; }
+
+	void WaitIdle() const override final {}
+
+	RHIShaderPtr CreateShader(const RHIShaderDesc&) const override final { return nullptr; }
+	RHITexturePtr CreateTexture(const RHITextureDesc& Desc) const override final;
+	RHIInputLayoutPtr CreateInputLayout(const RHIInputLayoutDesc&) const override final { return nullptr; }
+	RHIFrameBufferPtr CreateFrameBuffer(const RHIFrameBufferDesc&) const override final { return nullptr; }
+	RHIGraphicsPipelinePtr CreateGraphicsPipeline(const RHIGraphicsPipelineDesc&) const override final { return nullptr; }
+	RHIPipelineStatePtr CreatePipelineState(const RHIGraphicsPipelineDesc&) const override final { return nullptr; }
+	RHIBufferPtr CreateBuffer(const RHIBufferDesc& Desc) const override final;
+	RHISamplerPtr CreateSampler(const RHISamplerDesc&) const override final { return nullptr; }
+	RHISwapchainPtr CreateSwapchain(const RHISwapchainDesc&) const override final { return nullptr; }
+
+	RHICommandListContext* GetImmediateCommandListContext(ERHIDeviceQueue Queue) override final;
+	RHICommandListContextPtr AcquireDeferredCommandListContext() override final;
+	void ReleaseDeferredCommandListContext(RHICommandListContextPtr& CmdListContext) override final { CmdListContext.reset(); }
+
+	inline uint32_t GetNumCreatedTextures() const { return m_NumCreatedTextures.load(std::memory_order_relaxed); }
+	inline uint32_t GetNumCreatedBuffers() const { return m_NumCreatedBuffers.load(std::memory_order_relaxed); }
+protected:
+	void SetupCapabilities() override final {}
+private:
+	std::array<std::unique_ptr<RecordingCommandListContext>, static_cast<size_t>(ERHIDeviceQueue::Num)> m_ImmediateContexts;
+
+	mutable std::atomic<uint32_t> m_NumCreatedTextures = 0u;
+	mutable std::atomic<uint32_t> m_NumCreatedBuffers = 0u;
+};
@@ -0,0 +1,72 @@
+#include "Common/TestUtils.h"
+#include "Async/Task.h"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+std::filesystem::path GetTestDataPath()
+{
+	return std::filesystem::path(ROCKCAT_TEST_DATA_PATH);
+}
+
+std::filesystem::path GetTestTempPath()
+{
+	const auto TestInfo = testing::UnitTest::GetInstance()->current_test_info();
+	auto Path = std::filesystem::temp_directory_path() / "RockcatTests" / TestInfo->test_suite_name() / TestInfo->name();
+
+	std::error_code ErrorCode;
+	std::filesystem::remove_all(Path, ErrorCode);
+	std::filesystem::create_directories(Path);
+	return Path;
+}
+
+void InitializeTaskSystem()
+{
+	static std::once_flag s_Initialized;
+	std::call_once(s_Initialized, []() {
+		TFTask::Initialize();
+		std::atexit([]() { TFTask::Finalize(); });
+	});
+}
+
+std::string ReadTextFile(const std::filesystem::path& Path)
+{
+	std::ifstream File(Path, std::ios::in | std::ios::binary);
+	if (!File.is_open())
+	{
+		return std::string();
+	}
+
+	std::stringstream Stream;
+	Stream << File.rdbuf();
+	return Stream.str();
+}
+
+bool WriteTextFile(const std::filesystem::path& Path, const std::string& Text)
+{
+	std::ofstream File(Path, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!File.is_open())
+	{
+		return false;
+	}
+
+	File.write(Text.data(), static_cast<std::streamsize>(Text.size()));
+	return File.good();
+}
+
+void ExpectMatchesGoldenFile(const std::filesystem::path& RelativePath, const std::string& Actual)
+{
+	const auto Path = GetTestDataPath() / RelativePath;
+
+	if (std::getenv("ROCKCAT_UPDATE_GOLDEN"))
+	{
+		std::filesystem::create_directories(Path.parent_path());
+		EXPECT_TRUE(WriteTextFile(Path, Actual)) << "Failed to update golden file " << Path;
+		return;
+	}
+
+	const auto Expected = ReadTextFile(Path);
+	ASSERT_FALSE(Expected.empty()) << "Missing golden file " << Path << ", run with ROCKCAT_UPDATE_GOLDEN=1 to create it.";
+	EXPECT_EQ(Actual, Expected) << "Differs from golden file " << Path;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+/// Data files of the tests, see Source/Tests/Data.
+std::filesystem::path GetTestDataPath();
+
+/// An empty directory of its own for the calling test, removed again by the next call for the same test.
+std::filesystem::path GetTestTempPath();
+
+/// Starts the task executors once per process and stops them at exit, call it before dispatching tasks.
+void InitializeTaskSystem();
+
+std::string ReadTextFile(const std::filesystem::path& Path);
+bool WriteTextFile(const std::filesystem::path& Path, const std::string& Text);
+
+/// Compares against a golden file under Source/Tests/Data. With the environment variable ROCKCAT_UPDATE_GOLDEN set, writes Actual as
+/// the new golden file instead, for reviewing the differences in version control.
+void ExpectMatchesGoldenFile(const std::filesystem::path& RelativePath, const std::string& Actual);
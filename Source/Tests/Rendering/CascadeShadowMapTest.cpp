@@ -0,0 +1,134 @@
+#include "Common/TestUtils.h"
+#include "Rendering/CascadeShadowMap.h"
+#include "Scene/SceneView.h"
+#include "Scene/Components/Camera.h"
+#include "Scene/Components/PrimitiveComponent.h"
+#include <gtest/gtest.h>
+
+/// Camera at the origin looking down +Z, sun straight down, 4 cascades over the first 100 units.
+class CascadeShadowMapTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite()
+	{
+		InitializeTaskSystem();
+	}
+
+	void SetUp() override
+	{
+		m_Camera = std::make_unique<Camera>(Camera::EMode::FirstPerson, Math::Vector3(0.0f, 0.0f, 0.0f), Math::Vector3(0.0f, 0.0f, 1.0f), Math::PI_Div4, 1.0f, 0.1f, 100.0f);
+		m_View.SetCamera(m_Camera.get());
+
+		m_Settings.NumCascades = 4u;
+		m_ShadowMap.Update(m_View, Math::Vector3(0.0f, -1.0f, 0.0f), Math::AABB::CreateEmpty(), m_Settings);
+	}
+
+	/// A unit sphere around the mesh origin, placed in the world by Translation.
+	std::shared_ptr<PrimitiveComponent> AddPrimitive(const Math::Vector3& Translation, bool CastShadow = true)
+	{
+		auto Primitive = std::make_shared<PrimitiveComponent>();
+		Primitive->SetLocalBounds(BoxSphereBounds(Math::Vector3(0.0f), Math::Vector3(1.0f), std::sqrt(3.0f)));
+		Primitive->SetWorldTransform(Math::Matrix::Translation(Translation));
+		Primitive->SetCastShadow(CastShadow);
+
+		m_Primitives.push_back(Primitive.get());
+		m_Owners.push_back(Primitive);
+		return Primitive;
+	}
+
+	size_t CountCascades(const PrimitiveComponent* Primitive) const
+	{
+		size_t Count = 0u;
+		for (const auto& Cascade : m_ShadowMap.GetCascades())
+		{
+			Count += std::count(Cascade.Casters.begin(), Cascade.Casters.end(), Primitive);
+		}
+		return Count;
+	}
+
+	std::unique_ptr<Camera> m_Camera;
+	PlanarSceneView m_View;
+	RenderSettings::ShadowSettings m_Settings;
+	CascadeShadowMap m_ShadowMap;
+
+	std::vector<const PrimitiveComponent*> m_Primitives;
+	std::vector<std::shared_ptr<PrimitiveComponent>> m_Owners;
+};
+
+TEST(CascadeShadowMapSplitTest, ComputesSplitDistances)
+{
+	float Uniform[5u], Logarithmic[5u];
+	CascadeShadowMap::ComputeSplitDistances(ECascadeSplitScheme::Uniform, 0.5f, 1.0f, 81.0f, 4u, Uniform);
+	CascadeShadowMap::ComputeSplitDistances(ECascadeSplitScheme::Logarithmic, 0.5f, 1.0f, 81.0f, 4u, Logarithmic);
+
+	const float ExpectedUniform[5u] = { 1.0f, 21.0f, 41.0f, 61.0f, 81.0f };
+	const float ExpectedLogarithmic[5u] = { 1.0f, 3.0f, 9.0f, 27.0f, 81.0f };
+	for (uint32_t Index = 0u; Index < 5u; ++Index)
+	{
+		EXPECT_NEAR(Uniform[Index], ExpectedUniform[Index], 1e-3f);
+		EXPECT_NEAR(Logarithmic[Index], ExpectedLogarithmic[Index], 1e-3f);
+	}
+}
+
+TEST_F(CascadeShadowMapTest, FitsCascadesToTheView)
+{
+	const auto& Cascades = m_ShadowMap.GetCascades();
+	ASSERT_EQ(Cascades.size(), 4u);
+
+	EXPECT_FLOAT_EQ(Cascades.front().SplitNear, 0.1f);
+	EXPECT_FLOAT_EQ(Cascades.back().SplitFar, 100.0f);
+	for (size_t Index = 1u; Index < Cascades.size(); ++Index)
+	{
+		EXPECT_FLOAT_EQ(Cascades[Index].SplitNear, Cascades[Index - 1u].SplitFar);
+		EXPECT_GT(Cascades[Index].Bounds.GetRadius(), Cascades[Index - 1u].Bounds.GetRadius());
+	}
+}
+
+TEST_F(CascadeShadowMapTest, CullsCastersByWorldBounds)
+{
+	auto InView = AddPrimitive(Math::Vector3(0.0f, 0.0f, 10.0f));
+	auto BehindView = AddPrimitive(Math::Vector3(0.0f, 0.0f, -500.0f));
+	auto BesideView = AddPrimitive(Math::Vector3(500.0f, 0.0f, 10.0f));
+
+	m_ShadowMap.CullCasters(m_Primitives);
+
+	/// All three share the same mesh space bounds around the origin, which the first cascade covers.
+	EXPECT_GE(CountCascades(InView.get()), 1u);
+	EXPECT_EQ(CountCascades(BehindView.get()), 0u);
+	EXPECT_EQ(CountCascades(BesideView.get()), 0u);
+}
+
+TEST_F(CascadeShadowMapTest, KeepsCastersBetweenLightAndCascade)
+{
+	auto InView = AddPrimitive(Math::Vector3(0.0f, 0.0f, 10.0f));
+	auto AboveView = AddPrimitive(Math::Vector3(0.0f, 500.0f, 10.0f));
+	auto BelowView = AddPrimitive(Math::Vector3(0.0f, -500.0f, 10.0f));
+
+	m_ShadowMap.CullCasters(m_Primitives);
+
+	EXPECT_EQ(CountCascades(AboveView.get()), CountCascades(InView.get()));
+	EXPECT_EQ(CountCascades(BelowView.get()), 0u);
+}
+
+TEST_F(CascadeShadowMapTest, SkipsPrimitivesWithoutShadows)
+{
+	auto Primitive = AddPrimitive(Math::Vector3(0.0f, 0.0f, 10.0f), false);
+	m_Primitives.push_back(nullptr);
+
+	m_ShadowMap.CullCasters(m_Primitives);
+
+	EXPECT_EQ(CountCascades(Primitive.get()), 0u);
+}
+
+TEST_F(CascadeShadowMapTest, UsesScaledWorldBounds)
+{
+	/// The unit sphere misses the view by far, scaled up it reaches into it.
+	auto Primitive = std::make_shared<PrimitiveComponent>();
+	Primitive->SetLocalBounds(BoxSphereBounds(Math::Vector3(0.0f), Math::Vector3(1.0f), 1.0f));
+	Primitive->SetWorldTransform(Math::Matrix::Scaling(100.0f) * Math::Matrix::Translation(150.0f, 0.0f, 10.0f));
+	m_Primitives.push_back(Primitive.get());
+
+	m_ShadowMap.CullCasters(m_Primitives);
+
+	EXPECT_GE(CountCascades(Primitive.get()), 1u);
+}
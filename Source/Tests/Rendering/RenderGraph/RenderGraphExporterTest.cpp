@@ -0,0 +1,94 @@
+#include "Common/RecordingRHI.h"
+#include "Common/TestUtils.h"
+#include "Rendering/RenderGraph/RenderGraphExporter.h"
+#include "Rendering/RenderGraph/RenderTargetPool.h"
+#include <gtest/gtest.h>
+
+static RHITextureDesc MakeTextureDesc(uint32_t Size, const char* Name)
+{
+	RHITextureDesc Desc;
+	Desc.Width = Size;
+	Desc.Height = Size;
+	Desc.Format = ERHIFormat::RGBA8_UNorm;
+	Desc.Dimension = ERHITextureDimension::T_2D;
+	Desc.Name = Name;
+	return Desc;
+}
+
+/// Exports leave the timings out, so the text only changes with the graph, the plan or the format.
+class RenderGraphExporterTest : public testing::Test
+{
+protected:
+	RenderGraphExporterTest()
+		: m_Pool(m_Device)
+		, m_Graph(m_Settings, m_Pool)
+	{
+	}
+
+	RenderSettings m_Settings;
+	RecordingDevice m_Device;
+	RDGRenderTargetPool m_Pool;
+	RDGRenderGraph m_Graph;
+
+	RHITextureDesc m_BackBufferDesc = MakeTextureDesc(64u, "BackBuffer").SetPermanentState(ERHIResourceState::Present);
+	RHITexturePtr m_BackBuffer = std::make_shared<RecordingTexture>(m_BackBufferDesc);
+};
+
+TEST_F(RenderGraphExporterTest, MatchesGoldenFiles)
+{
+	/// Aliasing, a culled pass, split and cross queue transitions and every kind of synchronization in one graph.
+	auto BackBuffer = m_Graph.RegisterExternalTexture(m_BackBuffer, m_BackBufferDesc);
+	auto GBuffer = m_Graph.CreateTexture(MakeTextureDesc(64u, "GBuffer"));
+	auto Lighting = m_Graph.CreateBuffer(RHIBufferDesc().SetSize(256u).SetUsages(ERHIBufferUsageFlags::UnorderedAccess).SetName("Lighting"));
+	auto Shadow = m_Graph.CreateTexture(MakeTextureDesc(32u, "Shadow"));
+	auto Bloom = m_Graph.CreateTexture(MakeTextureDesc(64u, "Bloom"));
+	auto Debug = m_Graph.CreateTexture(MakeTextureDesc(64u, "Debug"));
+
+	m_Graph.AddPass(RDGEvent("GBuffer"), ERDGPassFlags::Raster, [] {}).WriteTexture(GBuffer);
+	m_Graph.AddPass(RDGEvent("LightCulling"), ERDGPassFlags::Compute | ERDGPassFlags::AsyncCompute, [] {}).ReadTexture(GBuffer).WriteBuffer(Lighting);
+	m_Graph.AddPass(RDGEvent("Shadow"), ERDGPassFlags::Raster, [] {}).WriteTexture(Shadow);
+	m_Graph.AddPass(RDGEvent("DebugView"), ERDGPassFlags::Raster, [] {}).ReadTexture(GBuffer).WriteTexture(Debug);
+	m_Graph.AddPass(RDGEvent("Lighting"), ERDGPassFlags::Raster, [] {}).ReadBuffer(Lighting).ReadTexture(Shadow).WriteTexture(Bloom);
+	m_Graph.AddPass(RDGEvent("Composite"), ERDGPassFlags::Raster, [] {}).ReadTexture(Bloom).WriteTexture(BackBuffer);
+
+	ASSERT_TRUE(m_Graph.Compile(true));
+
+	ExpectMatchesGoldenFile("RenderGraph/AsyncCompute.dot", RDGGraphExporter::ToDot(m_Graph, false));
+	ExpectMatchesGoldenFile("RenderGraph/AsyncCompute.json", RDGGraphExporter::ToJson(m_Graph, false));
+}
+
+TEST_F(RenderGraphExporterTest, ExportsDeclarationsOfFailedCompile)
+{
+	auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+	auto& P0 = m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::Raster | ERDGPassFlags::NeverCull, [] {});
+	P0.WriteTexture(A);
+	auto& P1 = m_Graph.AddPass(RDGEvent("P1"), ERDGPassFlags::Raster | ERDGPassFlags::NeverCull, [] {});
+	P1.ReadTexture(A);
+	m_Graph.AddPassDependency(P1, P0);
+
+	ASSERT_FALSE(m_Graph.Compile());
+
+	ExpectMatchesGoldenFile("RenderGraph/Cycle.json", RDGGraphExporter::ToJson(m_Graph, false));
+}
+
+TEST_F(RenderGraphExporterTest, ExportsIdenticalText)
+{
+	auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+	auto BackBuffer = m_Graph.RegisterExternalTexture(m_BackBuffer, m_BackBufferDesc);
+	m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::Raster, [] {}).WriteTexture(A);
+	m_Graph.AddPass(RDGEvent("P1"), ERDGPassFlags::Raster, [] {}).ReadTexture(A).WriteTexture(BackBuffer);
+	ASSERT_TRUE(m_Graph.Compile());
+
+	const auto Dot = RDGGraphExporter::ToDot(m_Graph, false);
+	const auto Json = RDGGraphExporter::ToJson(m_Graph, false);
+
+	/// Compiled again from the cache, the plan and therefore the text stay the same.
+	ASSERT_TRUE(m_Graph.Compile());
+	EXPECT_EQ(RDGGraphExporter::ToDot(m_Graph, false), Dot);
+	EXPECT_EQ(RDGGraphExporter::ToJson(m_Graph, false), Json);
+
+	const auto BasePath = GetTestTempPath() / "RenderGraph";
+	ASSERT_TRUE(RDGGraphExporter::Export(m_Graph, BasePath));
+	EXPECT_EQ(ReadTextFile(std::filesystem::path(BasePath).replace_extension(".json")), RDGGraphExporter::ToJson(m_Graph));
+	EXPECT_FALSE(ReadTextFile(std::filesystem::path(BasePath).replace_extension(".dot")).empty());
+}
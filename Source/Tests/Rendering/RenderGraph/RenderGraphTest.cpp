@@ -0,0 +1,451 @@
+#include "Common/RecordingRHI.h"
+#include "Rendering/RenderGraph/RenderGraph.h"
+#include "Rendering/RenderGraph/RenderTargetPool.h"
+#include <gtest/gtest.h>
+
+using EState = ERHIResourceState;
+using EQueue = ERHIDeviceQueue;
+using EFlags = ERHITransitionFlags;
+
+static RHITextureDesc MakeTextureDesc(uint32_t Size, const char* Name, uint16_t NumMips = 1u)
+{
+	RHITextureDesc Desc;
+	Desc.Width = Size;
+	Desc.Height = Size;
+	Desc.NumMipLevel = NumMips;
+	Desc.Format = ERHIFormat::RGBA8_UNorm;
+	Desc.Dimension = ERHITextureDimension::T_2D;
+	Desc.Name = Name;
+	return Desc;
+}
+
+/// The pass logs its name as a debug marker, the command log then shows where it was recorded.
+static auto MarkPass(const char* Name)
+{
+	return [Name](RHICommandBuffer& CommandBuffer) {
+		CommandBuffer.BeginDebugMarker(Name, Math::Color::White);
+		CommandBuffer.EndDebugMarker();
+	};
+}
+
+static std::ptrdiff_t Find(const std::vector<std::string>& Commands, const std::string& Command)
+{
+	auto It = std::find(Commands.begin(), Commands.end(), Command);
+	return It == Commands.end() ? -1 : It - Commands.begin();
+}
+
+class RenderGraphTest : public testing::Test
+{
+protected:
+	RenderGraphTest(bool SupportsTimelineSemaphore = true, bool SupportsSplitBarriers = true)
+		: m_Device(SupportsTimelineSemaphore, SupportsSplitBarriers)
+		, m_Pool(m_Device)
+		, m_Graph(m_Settings, m_Pool)
+	{
+	}
+
+	/// P1 runs async compute between the graphics passes P0 and P3, P2 does not depend on it and overlaps it.
+	void AddAsyncComputeGraph()
+	{
+		auto BackBuffer = m_Graph.RegisterExternalTexture(m_BackBuffer, m_BackBufferDesc);
+		auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+		auto B = m_Graph.CreateBuffer(RHIBufferDesc().SetSize(256u).SetUsages(ERHIBufferUsageFlags::UnorderedAccess).SetName("B"));
+		auto C = m_Graph.CreateTexture(MakeTextureDesc(32u, "C"));
+
+		m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::Raster, MarkPass("P0")).WriteTexture(A);
+		m_Graph.AddPass(RDGEvent("P1"), ERDGPassFlags::Compute | ERDGPassFlags::AsyncCompute, MarkPass("P1")).ReadTexture(A).WriteBuffer(B);
+		m_Graph.AddPass(RDGEvent("P2"), ERDGPassFlags::Raster, MarkPass("P2")).WriteTexture(C);
+		m_Graph.AddPass(RDGEvent("P3"), ERDGPassFlags::Raster, MarkPass("P3")).ReadBuffer(B).ReadTexture(C).WriteTexture(BackBuffer);
+	}
+
+	void NextFrame()
+	{
+		m_Graph.Reset();
+		m_Pool.Tick();
+		m_Graphics.ClearSubmitted();
+		m_Compute.ClearSubmitted();
+	}
+
+	RenderSettings m_Settings;
+	RecordingDevice m_Device;
+	RDGRenderTargetPool m_Pool;
+	RDGRenderGraph m_Graph;
+
+	RecordingCommandListContext m_Graphics{ "Graphics" };
+	RecordingCommandListContext m_Compute{ "Compute" };
+
+	RHITextureDesc m_BackBufferDesc = MakeTextureDesc(64u, "BackBuffer").SetPermanentState(EState::Present);
+	RHITexturePtr m_BackBuffer = std::make_shared<RecordingTexture>(m_BackBufferDesc);
+};
+
+class RenderGraphNoTimelineTest : public RenderGraphTest
+{
+protected:
+	RenderGraphNoTimelineTest()
+		: RenderGraphTest(false)
+	{
+	}
+};
+
+class RenderGraphNoSplitBarriersTest : public RenderGraphTest
+{
+protected:
+	RenderGraphNoSplitBarriersTest()
+		: RenderGraphTest(true, false)
+	{
+	}
+};
+
+TEST_F(RenderGraphTest, RejectsCycles)
+{
+	auto& P0 = m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::NeverCull, [] {});
+	auto& P1 = m_Graph.AddPass(RDGEvent("P1"), ERDGPassFlags::NeverCull, [] {});
+	m_Graph.AddPassDependency(P1, P0);
+	m_Graph.AddPassDependency(P0, P1);
+
+	EXPECT_FALSE(m_Graph.Compile());
+	EXPECT_FALSE(m_Graph.IsCompiled());
+	EXPECT_TRUE(m_Graph.GetPassOrder().empty());
+	EXPECT_TRUE(m_Graph.GetBarrierBatches().empty());
+
+	/// Nothing is recorded for a graph which does not compile.
+	m_Graph.Execute(m_Graphics);
+	m_Graphics.SubmitGraphicsCommandBuffer();
+	EXPECT_TRUE(m_Graphics.GetSubmittedCommands().empty());
+}
+
+TEST_F(RenderGraphTest, OrdersByExplicitDependencies)
+{
+	auto& P0 = m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::NeverCull, [] {});
+	auto& P1 = m_Graph.AddPass(RDGEvent("P1"), ERDGPassFlags::NeverCull, [] {});
+	m_Graph.AddPassDependency(P1, P0);
+
+	ASSERT_TRUE(m_Graph.Compile());
+	ASSERT_EQ(m_Graph.GetPassOrder().size(), 2u);
+	EXPECT_EQ(m_Graph.GetPassOrder()[0], P1.GetID());
+	EXPECT_EQ(m_Graph.GetPassOrder()[1], P0.GetID());
+}
+
+TEST_F(RenderGraphTest, RejectsReadsBeforeWrites)
+{
+	auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+	m_Graph.AddPass(RDGEvent("Read"), ERDGPassFlags::Raster | ERDGPassFlags::NeverCull, [] {}).ReadTexture(A);
+
+	EXPECT_FALSE(m_Graph.Compile());
+}
+
+TEST_F(RenderGraphTest, CullsPassesWithoutOutput)
+{
+	auto BackBuffer = m_Graph.RegisterExternalTexture(m_BackBuffer, m_BackBufferDesc);
+	auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+	auto B = m_Graph.CreateTexture(MakeTextureDesc(64u, "B"));
+	auto C = m_Graph.CreateTexture(MakeTextureDesc(64u, "C"));
+	auto Unused = m_Graph.CreateTexture(MakeTextureDesc(64u, "Unused"));
+
+	m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::Raster, MarkPass("P0")).WriteTexture(A);
+	m_Graph.AddPass(RDGEvent("P1"), ERDGPassFlags::Raster, MarkPass("P1")).ReadTexture(A).WriteTexture(B);
+	auto& Dead = m_Graph.AddPass(RDGEvent("Dead"), ERDGPassFlags::Raster, MarkPass("Dead"));
+	Dead.ReadTexture(A).WriteTexture(Unused);
+	m_Graph.AddPass(RDGEvent("P2"), ERDGPassFlags::Raster, MarkPass("P2")).ReadTexture(B).WriteTexture(C);
+	m_Graph.AddPass(RDGEvent("P3"), ERDGPassFlags::Raster, MarkPass("P3")).ReadTexture(C).WriteTexture(BackBuffer);
+
+	m_Graph.Execute(m_Graphics);
+	m_Graphics.SubmitGraphicsCommandBuffer();
+
+	EXPECT_TRUE(Dead.IsCulled());
+	EXPECT_EQ(m_Graph.GetPassOrder().size(), 4u);
+
+	const auto& Commands = m_Graphics.GetSubmittedCommands();
+	EXPECT_EQ(Find(Commands, "Dead"), -1);
+	EXPECT_LT(Find(Commands, "P0"), Find(Commands, "P1"));
+	EXPECT_LT(Find(Commands, "P1"), Find(Commands, "P2"));
+	EXPECT_LT(Find(Commands, "P2"), Find(Commands, "P3"));
+
+	/// A and C never live at the same time and share memory, B overlaps both.
+	const auto& Stats = m_Graph.GetTransientMemoryStats();
+	EXPECT_EQ(Stats.NumResources, 3u);
+	EXPECT_EQ(Stats.NumAliasingGroups, 2u);
+	EXPECT_EQ(A->GetAliasingGroup(), C->GetAliasingGroup());
+	EXPECT_NE(A->GetAliasingGroup(), B->GetAliasingGroup());
+	EXPECT_EQ(Unused->GetAliasingGroup(), RDGResource::NoAliasingGroup);
+	EXPECT_LE(Stats.PeakLiveSize, Stats.AliasedSize);
+	EXPECT_LT(Stats.AliasedSize, Stats.UnaliasedSize);
+	EXPECT_EQ(m_Device.GetNumCreatedTextures(), 2u);
+}
+
+TEST_F(RenderGraphTest, PlansBarriers)
+{
+	auto BackBuffer = m_Graph.RegisterExternalTexture(m_BackBuffer, m_BackBufferDesc);
+	auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+	auto B = m_Graph.CreateTexture(MakeTextureDesc(64u, "B"));
+
+	m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::Raster, MarkPass("P0")).WriteTexture(A);
+	m_Graph.AddPass(RDGEvent("P1"), ERDGPassFlags::Raster, MarkPass("P1")).ReadTexture(A).WriteTexture(B);
+	m_Graph.AddPass(RDGEvent("P2"), ERDGPassFlags::Raster, MarkPass("P2")).ReadTexture(A, EState::TransferSrc).ReadTexture(B).WriteTexture(BackBuffer);
+
+	m_Graph.Execute(m_Graphics);
+	m_Graphics.SubmitGraphicsCommandBuffer();
+
+	const auto& Batches = m_Graph.GetBarrierBatches();
+	ASSERT_EQ(Batches.size(), 4u);
+
+	/// A starts without content, the back buffer leaves Present right away but only has to be a render target by P2.
+	ASSERT_EQ(Batches[0].Transitions.size(), 2u);
+	EXPECT_EQ(Batches[0].Transitions[0].Resource, A->GetID());
+	EXPECT_EQ(Batches[0].Transitions[0].Flags, EFlags::Discard);
+	EXPECT_EQ(Batches[0].Transitions[0].DstState, EState::RenderTarget);
+	EXPECT_EQ(Batches[0].Transitions[1].Resource, BackBuffer->GetID());
+	EXPECT_EQ(Batches[0].Transitions[1].Flags, EFlags::BeginOnly);
+	EXPECT_EQ(Batches[0].Transitions[1].SrcState, EState::Present);
+
+	/// A goes straight to every read state it is in until its last use.
+	ASSERT_EQ(Batches[1].Transitions.size(), 2u);
+	EXPECT_EQ(Batches[1].Transitions[0].Resource, A->GetID());
+	EXPECT_EQ(Batches[1].Transitions[0].DstState, EState::ShaderResource | EState::TransferSrc);
+
+	ASSERT_EQ(Batches[2].Transitions.size(), 2u);
+	EXPECT_EQ(Batches[2].Transitions[0].Resource, B->GetID());
+	EXPECT_EQ(Batches[2].Transitions[1].Resource, BackBuffer->GetID());
+	EXPECT_EQ(Batches[2].Transitions[1].Flags, EFlags::EndOnly);
+
+	/// The back buffer returns to its permanent state.
+	ASSERT_EQ(Batches[3].Transitions.size(), 1u);
+	EXPECT_EQ(Batches[3].Transitions[0].SrcState, EState::RenderTarget);
+	EXPECT_EQ(Batches[3].Transitions[0].DstState, EState::Present);
+
+	/// Every batch is one barrier, issued right before its pass.
+	const auto& Commands = m_Graphics.GetSubmittedCommands();
+	EXPECT_EQ(m_Graphics.GetSubmittedBarriers().size(), 4u);
+	EXPECT_EQ(Commands, (std::vector<std::string>{ "Barrier", "P0", "Barrier", "P1", "Barrier", "P2", "Barrier" }));
+}
+
+TEST_F(RenderGraphNoSplitBarriersTest, PlansWholeBarriers)
+{
+	auto BackBuffer = m_Graph.RegisterExternalTexture(m_BackBuffer, m_BackBufferDesc);
+	auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+	auto B = m_Graph.CreateTexture(MakeTextureDesc(64u, "B"));
+
+	m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::Raster, MarkPass("P0")).WriteTexture(A);
+	m_Graph.AddPass(RDGEvent("P1"), ERDGPassFlags::Raster, MarkPass("P1")).ReadTexture(A).WriteTexture(B);
+	m_Graph.AddPass(RDGEvent("P2"), ERDGPassFlags::Raster, MarkPass("P2")).ReadTexture(A, EState::TransferSrc).ReadTexture(B).WriteTexture(BackBuffer);
+
+	ASSERT_TRUE(m_Graph.Compile());
+
+	/// The back buffer leaves Present only right before P2, in one piece.
+	const auto& Batches = m_Graph.GetBarrierBatches();
+	ASSERT_EQ(Batches.size(), 4u);
+	ASSERT_EQ(Batches[0].Transitions.size(), 1u);
+	EXPECT_EQ(Batches[0].Transitions[0].Resource, A->GetID());
+
+	ASSERT_EQ(Batches[2].Transitions.size(), 2u);
+	EXPECT_EQ(Batches[2].Transitions[1].Resource, BackBuffer->GetID());
+	EXPECT_EQ(Batches[2].Transitions[1].Flags, EFlags::None);
+	EXPECT_EQ(Batches[2].Transitions[1].SrcState, EState::Present);
+	EXPECT_EQ(Batches[2].Transitions[1].DstState, EState::RenderTarget);
+
+	for (const auto& Batch : Batches)
+	{
+		for (const auto& Transition : Batch.Transitions)
+		{
+			EXPECT_FALSE(EnumHasAnyFlags(Transition.Flags, EFlags::BeginOnly | EFlags::EndOnly));
+		}
+	}
+}
+
+TEST_F(RenderGraphTest, PlansBarriersPerSubresource)
+{
+	auto Texture = m_Graph.CreateTexture(MakeTextureDesc(64u, "MipChain", 4u));
+
+	m_Graph.AddPass(RDGEvent("Base"), ERDGPassFlags::Raster, [] {}).WriteTexture(Texture, EState::RenderTarget, RHISubresource{ 0u, 1u, 0u, 1u });
+	for (uint16_t Mip = 1u; Mip < 4u; ++Mip)
+	{
+		m_Graph.AddPass(RDGEvent("Downsample"), ERDGPassFlags::Compute, [] {})
+			.ReadTexture(Texture, EState::ShaderResource, RHISubresource{ static_cast<uint16_t>(Mip - 1u), 1u, 0u, 1u })
+			.WriteTexture(Texture, EState::UnorderedAccess, RHISubresource{ Mip, 1u, 0u, 1u });
+	}
+	m_Graph.AddPass(RDGEvent("Use"), ERDGPassFlags::Raster | ERDGPassFlags::NeverCull, [] {}).ReadTexture(Texture);
+
+	ASSERT_TRUE(m_Graph.Compile());
+
+	/// Mips 0 to 2 are already read by then, only the last one changes state.
+	const auto& Batches = m_Graph.GetBarrierBatches();
+	ASSERT_EQ(Batches.size(), 6u);
+	ASSERT_EQ(Batches[4].Transitions.size(), 1u);
+	EXPECT_EQ(Batches[4].Transitions[0].Subresource.BaseMipLevel, 3u);
+	EXPECT_TRUE(Batches[5].Transitions.empty());
+}
+
+TEST_F(RenderGraphTest, SchedulesAsyncCompute)
+{
+	AddAsyncComputeGraph();
+	ASSERT_TRUE(m_Graph.Compile(true));
+
+	/// The compute queue waits for P0, the graphics queue for P1 before P3 only, so P2 overlaps P1.
+	const auto& Schedule = m_Graph.GetPassSchedule();
+	ASSERT_EQ(Schedule.size(), 5u);
+	EXPECT_EQ(Schedule[0].Queue, EQueue::Graphics);
+	EXPECT_EQ(Schedule[1].Queue, EQueue::Compute);
+	EXPECT_EQ(Schedule[2].Queue, EQueue::Graphics);
+	EXPECT_EQ(Schedule[3].Queue, EQueue::Graphics);
+
+	EXPECT_EQ(Schedule[0].WaitValue, 0u);
+	EXPECT_EQ(Schedule[0].SignalValue, 1u);
+	EXPECT_EQ(Schedule[1].WaitValue, 1u);
+	EXPECT_EQ(Schedule[1].SignalValue, 1u);
+	EXPECT_EQ(Schedule[2].WaitValue, 0u);
+	EXPECT_EQ(Schedule[2].SignalValue, 0u);
+	EXPECT_EQ(Schedule[3].WaitValue, 1u);
+	EXPECT_EQ(Schedule[4].WaitValue, 0u);
+	EXPECT_EQ(m_Graph.GetPrologueSchedule().SignalValue, 0u);
+
+	/// A moves to the compute queue after P0, B back to graphics after P1, each as a release and a matching acquire.
+	ASSERT_EQ(Schedule[0].Releases.Transitions.size(), 1u);
+	const auto& ReleaseA = Schedule[0].Releases.Transitions[0];
+	EXPECT_EQ(ReleaseA.SrcQueue, EQueue::Graphics);
+	EXPECT_EQ(ReleaseA.DstQueue, EQueue::Compute);
+	EXPECT_EQ(ReleaseA.Flags, EFlags::BeginOnly);
+
+	const auto& Batch1 = m_Graph.GetBarrierBatches()[1].Transitions;
+	auto AcquireA = std::find_if(Batch1.begin(), Batch1.end(), [&ReleaseA](const RDGTransition& Transition) { return Transition.Resource == ReleaseA.Resource; });
+	ASSERT_NE(AcquireA, Batch1.end());
+	EXPECT_EQ(AcquireA->Flags, EFlags::EndOnly);
+	EXPECT_EQ(AcquireA->SrcState, ReleaseA.SrcState);
+	EXPECT_EQ(AcquireA->DstState, ReleaseA.DstState);
+
+	ASSERT_EQ(Schedule[1].Releases.Transitions.size(), 1u);
+	EXPECT_EQ(Schedule[1].Releases.Transitions[0].SrcQueue, EQueue::Compute);
+	EXPECT_EQ(Schedule[1].Releases.Transitions[0].DstQueue, EQueue::Graphics);
+
+	for (size_t Index = 0u; Index < m_Graph.GetBarrierBatches().size(); ++Index)
+	{
+		for (const auto& Transition : m_Graph.GetBarrierBatches()[Index].Transitions)
+		{
+			EXPECT_TRUE(Transition.SrcQueue == Transition.DstQueue || Index == 1u || Index == 3u);
+		}
+	}
+}
+
+TEST_F(RenderGraphTest, ExecutesAsyncComputeOnTimelines)
+{
+	for (uint32_t Frame = 0u; Frame < 3u; ++Frame)
+	{
+		const uint64_t GraphicsBase = m_Graphics.GetTimelineValue();
+		const uint64_t ComputeBase = m_Compute.GetTimelineValue();
+
+		AddAsyncComputeGraph();
+		m_Graph.Execute(m_Graphics, &m_Compute);
+		m_Graphics.SubmitGraphicsCommandBuffer();
+		m_Compute.SubmitGraphicsCommandBuffer();
+
+		const auto& Graphics = m_Graphics.GetSubmittedCommands();
+		const auto& Compute = m_Compute.GetSubmittedCommands();
+		const auto GraphicsSignal = fmt::format("Signal Graphics {}", GraphicsBase + 1u);
+		const auto ComputeWait = fmt::format("Wait Graphics {}", GraphicsBase + 1u);
+		const auto ComputeSignal = fmt::format("Signal Compute {}", ComputeBase + 1u);
+		const auto GraphicsWait = fmt::format("Wait Compute {}", ComputeBase + 1u);
+
+		EXPECT_LT(Find(Graphics, "P0"), Find(Graphics, GraphicsSignal));
+		EXPECT_LT(Find(Graphics, GraphicsSignal), Find(Graphics, "P2"));
+		EXPECT_LT(Find(Graphics, "P2"), Find(Graphics, GraphicsWait));
+		EXPECT_LT(Find(Graphics, GraphicsWait), Find(Graphics, "P3"));
+		EXPECT_EQ(Find(Graphics, "P1"), -1);
+
+		EXPECT_LT(Find(Compute, ComputeWait), Find(Compute, "P1"));
+		EXPECT_LT(Find(Compute, "P1"), Find(Compute, ComputeSignal));
+		EXPECT_EQ(Find(Compute, "P0"), -1);
+
+		EXPECT_EQ(m_Graphics.GetTimelineValue(), GraphicsBase + 1u);
+		EXPECT_EQ(m_Compute.GetTimelineValue(), ComputeBase + 1u);
+
+		NextFrame();
+	}
+
+	/// The later frames kept the shape of the first one.
+	EXPECT_EQ(m_Graph.GetCompileStats().NumCacheHits, 2u);
+}
+
+TEST_F(RenderGraphNoTimelineTest, RunsAsyncComputeOnGraphicsQueue)
+{
+	AddAsyncComputeGraph();
+	m_Graph.Execute(m_Graphics, &m_Compute);
+	m_Graphics.SubmitGraphicsCommandBuffer();
+	m_Compute.SubmitGraphicsCommandBuffer();
+
+	for (const auto& Schedule : m_Graph.GetPassSchedule())
+	{
+		EXPECT_EQ(Schedule.Queue, EQueue::Graphics);
+		EXPECT_EQ(Schedule.WaitValue, 0u);
+		EXPECT_EQ(Schedule.SignalValue, 0u);
+		EXPECT_TRUE(Schedule.Releases.Transitions.empty());
+	}
+
+	EXPECT_NE(Find(m_Graphics.GetSubmittedCommands(), "P1"), -1);
+	EXPECT_TRUE(m_Compute.GetSubmittedCommands().empty());
+	EXPECT_EQ(m_Compute.GetTimelineValue(), 0u);
+}
+
+TEST_F(RenderGraphTest, ReusesCompiledPlan)
+{
+	AddAsyncComputeGraph();
+	ASSERT_TRUE(m_Graph.Compile());
+	const auto PassOrder = m_Graph.GetPassOrder();
+	const size_t NumBatches = m_Graph.GetBarrierBatches().size();
+	m_Graph.Reset();
+
+	AddAsyncComputeGraph();
+	ASSERT_TRUE(m_Graph.Compile());
+	EXPECT_EQ(m_Graph.GetCompileStats().NumCacheHits, 1u);
+	EXPECT_EQ(m_Graph.GetPassOrder(), PassOrder);
+	EXPECT_EQ(m_Graph.GetBarrierBatches().size(), NumBatches);
+	m_Graph.Reset();
+
+	/// A graph of another shape plans from scratch.
+	auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+	m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::Raster | ERDGPassFlags::NeverCull, [] {}).WriteTexture(A);
+	ASSERT_TRUE(m_Graph.Compile());
+	EXPECT_EQ(m_Graph.GetCompileStats().NumCacheHits, 1u);
+	EXPECT_EQ(m_Graph.GetCompileStats().NumCacheMisses, 2u);
+}
+
+TEST_F(RenderGraphTest, ReusesPooledResourcesOnceRetired)
+{
+	auto AddFrame = [this]() {
+		auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+		m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::Raster | ERDGPassFlags::NeverCull, [] {}).WriteTexture(A);
+		m_Graph.Execute(m_Graphics);
+		m_Graphics.SubmitGraphicsCommandBuffer();
+		NextFrame();
+	};
+
+	/// The first frames may still be in flight on the GPU, each needs memory of its own.
+	AddFrame();
+	AddFrame();
+	AddFrame();
+	EXPECT_EQ(m_Device.GetNumCreatedTextures(), 3u);
+
+	/// From then on the oldest one has retired.
+	AddFrame();
+	AddFrame();
+	EXPECT_EQ(m_Device.GetNumCreatedTextures(), 3u);
+
+	uint32_t NumRenderTargets = 0u;
+	size_t MemorySizeOfPool = 0u, MemorySizeUsed = 0u;
+	m_Pool.GetStats(NumRenderTargets, MemorySizeOfPool, MemorySizeUsed);
+	EXPECT_EQ(NumRenderTargets, 3u);
+	EXPECT_EQ(MemorySizeUsed, 0u);
+}
+
+TEST_F(RenderGraphTest, ExtractsResources)
+{
+	auto A = m_Graph.CreateTexture(MakeTextureDesc(64u, "A"));
+	m_Graph.AddPass(RDGEvent("P0"), ERDGPassFlags::Raster, MarkPass("P0")).WriteTexture(A);
+
+	RHITexturePtr Extracted;
+	m_Graph.ExtractTexture(A, Extracted);
+	m_Graph.Execute(m_Graphics);
+
+	ASSERT_NE(Extracted, nullptr);
+	EXPECT_EQ(Extracted->GetWidth(), 64u);
+	EXPECT_EQ(m_Graph.GetPassOrder().size(), 1u);
+	EXPECT_TRUE(m_Graph.GetAliasingGroups().empty());
+}
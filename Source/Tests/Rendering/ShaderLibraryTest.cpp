@@ -0,0 +1,85 @@
+#include "Common/TestUtils.h"
+#include "Services/ShaderLibrary.h"
+#include <gtest/gtest.h>
+
+/// Main.frag -> A.hlsli -> B.hlsli -> C.hlsli, with B and C including each other and Main also reaching C through D.hlsli.
+class ShaderLibraryTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		m_Root = GetTestTempPath();
+
+		Write("Shaders/Main.frag", "#include \"Shaders/A.hlsli\"\n#include \"Shaders/D.hlsli\"\nvoid main() {}\n");
+		Write("Shaders/A.hlsli", "#include \"Shaders/B.hlsli\"\nfloat A() { return B(); }\n");
+		Write("Shaders/B.hlsli", "#pragma once\n#include \"Shaders/C.hlsli\"\nfloat B() { return C(); }\n");
+		Write("Shaders/C.hlsli", "#pragma once\n#include \"Shaders/B.hlsli\"\nfloat C() { return 1.0; }\n");
+		Write("Shaders/D.hlsli", "#ifdef __cplusplus\n#include \"Runtime/Missing.h\"\n#endif\n#include <Shaders/C.hlsli>\n");
+		Write("Shaders/Unrelated.hlsli", "float Unrelated() { return 0.0; }\n");
+	}
+
+	void Write(const char* RelativePath, const std::string& Text)
+	{
+		std::filesystem::create_directories((m_Root / RelativePath).parent_path());
+		ASSERT_TRUE(WriteTextFile(m_Root / RelativePath, Text));
+	}
+
+	uint64_t ComputeHash() const
+	{
+		return ShaderLibrary::ComputeSourceHash(m_Root / "Shaders/Main.frag", m_Root);
+	}
+
+	std::filesystem::path m_Root;
+};
+
+TEST_F(ShaderLibraryTest, GathersIncludeClosureOnce)
+{
+	auto IncludeFiles = ShaderLibrary::GatherIncludeFiles(m_Root / "Shaders/Main.frag", m_Root);
+
+	std::vector<std::string> RelativePaths;
+	for (const auto& IncludeFile : IncludeFiles)
+	{
+		RelativePaths.push_back(IncludeFile.lexically_relative(m_Root).generic_string());
+	}
+
+	EXPECT_EQ(RelativePaths, (std::vector<std::string>{
+		"Runtime/Missing.h",
+		"Shaders/A.hlsli",
+		"Shaders/B.hlsli",
+		"Shaders/C.hlsli",
+		"Shaders/D.hlsli"}));
+}
+
+TEST_F(ShaderLibraryTest, KeepsSourceHashStable)
+{
+	const uint64_t Hash = ComputeHash();
+	EXPECT_EQ(ComputeHash(), Hash);
+
+	Write("Shaders/B.hlsli", ReadTextFile(m_Root / "Shaders/B.hlsli"));
+	EXPECT_EQ(ComputeHash(), Hash);
+
+	Write("Shaders/Unrelated.hlsli", "float Unrelated() { return 2.0; }\n");
+	EXPECT_EQ(ComputeHash(), Hash);
+
+	/// The key does not depend on where the shaders live.
+	const auto MovedRoot = m_Root / "Moved";
+	std::filesystem::create_directories(MovedRoot);
+	std::filesystem::copy(m_Root / "Shaders", MovedRoot / "Shaders");
+	EXPECT_EQ(ShaderLibrary::ComputeSourceHash(MovedRoot / "Shaders/Main.frag", MovedRoot), Hash);
+}
+
+TEST_F(ShaderLibraryTest, InvalidatesOnNestedIncludeChanges)
+{
+	const uint64_t Hash = ComputeHash();
+	const auto Original = ReadTextFile(m_Root / "Shaders/C.hlsli");
+
+	Write("Shaders/C.hlsli", "#pragma once\n#include \"Shaders/B.hlsli\"\nfloat C() { return 2.0; }\n");
+	EXPECT_NE(ComputeHash(), Hash);
+
+	Write("Shaders/C.hlsli", Original);
+	EXPECT_EQ(ComputeHash(), Hash);
+
+	/// A header which did not exist before takes part once it is created.
+	Write("Runtime/Missing.h", "#pragma once\n");
+	EXPECT_NE(ComputeHash(), Hash);
+}
@@ -0,0 +1,194 @@
+#include "Common/TestUtils.h"
+#include "Asset/Texture.h"
+#include "Core/ConsoleVariable.h"
+#include "Rendering/Material.h"
+#include "Rendering/TextureStreamingManager.h"
+#include "Scene/Scene.h"
+#include "Scene/Components/StaticMeshComponent.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+extern ConsoleVariable<uint32_t> CVarTextureStreamingPoolSize;
+
+/// A 1024 x 1024 RGBA8 texture streaming from a file of zeros, mips up to 64 x 64 form the tail. Without a render device streaming
+/// only moves the mip counts, which is all the manager looks at.
+class StreamingTestTexture : public Texture
+{
+public:
+	static constexpr uint32_t Size = 1024u;
+	static constexpr uint32_t NumMips = 11u;
+	static constexpr uint32_t NumTailMips = 7u;
+
+	StreamingTestTexture(const std::filesystem::path& Path)
+		: Texture(Path)
+	{
+		m_Desc.SetWidth(Size)
+			.SetHeight(Size)
+			.SetNumMipLevel(NumMips)
+			.SetFormat(ERHIFormat::RGBA8_UNorm)
+			.SetDimension(ERHITextureDimension::T_2D);
+
+		size_t ChainSize = 0u;
+		for (uint32_t Mip = 0u; Mip < NumMips; ++Mip)
+		{
+			ChainSize += RHI::GetFormatAttributes(std::max(Size >> Mip, 1u), std::max(Size >> Mip, 1u), m_Desc.Format).SlicePitch;
+		}
+		WriteTextFile(Path, std::string(ChainSize, '\0'));
+
+		m_Desc.SetBulkData(ChainSize);
+		InitializeMips(Path, 0u, 64u);
+		SetStatus(EStatus::Ready);
+	}
+};
+
+/// One view at the origin, 1000 pixels cover a unit seen from one unit away.
+class TextureStreamingManagerTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite()
+	{
+		InitializeTaskSystem();
+	}
+
+	void SetUp() override
+	{
+		m_Root = GetTestTempPath();
+		m_Scene = std::make_shared<Scene>(m_Root / "Streaming.scene");
+		m_Views.push_back(TextureStreamingView{ Math::Vector3(0.0f), 1000.0f });
+	}
+
+	void TearDown() override
+	{
+		TextureStreamingManager::Get().Finalize();
+		CVarTextureStreamingPoolSize.Set(512u);
+	}
+
+	/// A unit box around the mesh origin with a material of one texture, placed in the world by Translation.
+	std::shared_ptr<StaticMeshComponent> AddMesh(const Math::Vector3& Translation, const std::shared_ptr<Texture>& Target)
+	{
+		auto Material = std::make_shared<MaterialProperty>(m_Root / "Streaming.material");
+		Material->Textures[MaterialProperty::ETextureType::BaseColor] = Target;
+
+		auto MeshComp = std::make_shared<StaticMeshComponent>();
+		MeshComp->SetLocalBounds(BoxSphereBounds(Math::Vector3(0.0f), Math::Vector3(1.0f), 1.0f));
+		MeshComp->SetWorldTransform(Math::Matrix::Translation(Translation));
+		MeshComp->SetMaterialProperty(Material);
+
+		m_Scene->AddPrimitive(MeshComp.get());
+		return MeshComp;
+	}
+
+	std::shared_ptr<StreamingTestTexture> CreateTexture(const char* Name)
+	{
+		return std::make_shared<StreamingTestTexture>(m_Root / Name);
+	}
+
+	/// Runs frames until no request is in flight any more.
+	void Simulate(uint32_t MaxFrames = 200u)
+	{
+		for (uint32_t Frame = 0u; Frame < MaxFrames; ++Frame)
+		{
+			TextureStreamingManager::Get().Update(*m_Scene, m_Views);
+
+			const auto& Stats = TextureStreamingManager::Get().GetStats();
+			if (Frame > 0u && Stats.NumStreamingTextures == 0u && Stats.CommittedSize == Stats.ResidentSize)
+			{
+				return;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		FAIL() << "Streaming did not settle within " << MaxFrames << " frames";
+	}
+
+	std::filesystem::path m_Root;
+	std::shared_ptr<Scene> m_Scene;
+	std::vector<TextureStreamingView> m_Views;
+};
+
+TEST_F(TextureStreamingManagerTest, StreamsByWorldSpaceDistance)
+{
+	auto NearTexture = CreateTexture("Near.bin");
+	auto FarTexture = CreateTexture("Far.bin");
+
+	/// Both meshes share the mesh space bounds, only their world transforms differ.
+	auto NearMesh = AddMesh(Math::Vector3(0.0f, 0.0f, 5.0f), NearTexture);
+	auto FarMesh = AddMesh(Math::Vector3(0.0f, 0.0f, 500.0f), FarTexture);
+
+	Simulate();
+
+	/// 400 pixels on screen want the 512 x 512 mip on top, 4 pixels leave only the tail.
+	EXPECT_EQ(NearTexture->GetNumResidentMips(), StreamingTestTexture::NumMips - 1u);
+	EXPECT_EQ(FarTexture->GetNumResidentMips(), StreamingTestTexture::NumTailMips);
+	EXPECT_EQ(TextureStreamingManager::Get().GetStats().NumTextures, 2u);
+}
+
+TEST_F(TextureStreamingManagerTest, StreamsOutAsViewsMoveAway)
+{
+	auto Target = CreateTexture("Texture.bin");
+	auto Mesh = AddMesh(Math::Vector3(0.0f, 0.0f, 5.0f), Target);
+
+	Simulate();
+	EXPECT_EQ(Target->GetNumResidentMips(), StreamingTestTexture::NumMips - 1u);
+
+	m_Views.front().Origin = Math::Vector3(0.0f, 0.0f, -495.0f);
+	Simulate();
+	EXPECT_EQ(Target->GetNumResidentMips(), StreamingTestTexture::NumTailMips);
+}
+
+TEST_F(TextureStreamingManagerTest, FitsIntoThePool)
+{
+	CVarTextureStreamingPoolSize.Set(2u);
+
+	std::vector<std::shared_ptr<StreamingTestTexture>> Textures;
+	std::vector<std::shared_ptr<StaticMeshComponent>> Meshes;
+	for (uint32_t Index = 0u; Index < 4u; ++Index)
+	{
+		Textures.push_back(CreateTexture(("Texture" + std::to_string(Index) + ".bin").c_str()));
+		Meshes.push_back(AddMesh(Math::Vector3(0.0f, 0.0f, 5.0f + Index * 5.0f), Textures.back()));
+	}
+
+	Simulate();
+
+	const auto& Stats = TextureStreamingManager::Get().GetStats();
+	EXPECT_GT(Stats.WantedSize, Stats.PoolSize);
+	EXPECT_LE(Stats.BudgetedSize, Stats.PoolSize);
+	EXPECT_LE(Stats.CommittedSize, Stats.PoolSize);
+
+	/// The nearest texture is the most magnified one and is served first.
+	EXPECT_EQ(Textures.front()->GetNumResidentMips(), StreamingTestTexture::NumMips - 1u);
+	for (const auto& Target : Textures)
+	{
+		EXPECT_GE(Target->GetNumResidentMips(), StreamingTestTexture::NumTailMips);
+	}
+}
+
+TEST_F(TextureStreamingManagerTest, SkipsRemovedPrimitives)
+{
+	auto Target = CreateTexture("Texture.bin");
+	auto Mesh = AddMesh(Math::Vector3(0.0f, 0.0f, 5.0f), Target);
+
+	/// The scene still lists the destroyed primitive as added, the manager must not touch it.
+	m_Scene->RemovePrimitive(Mesh.get());
+	Mesh.reset();
+
+	Simulate();
+
+	EXPECT_EQ(TextureStreamingManager::Get().GetStats().NumTextures, 0u);
+	EXPECT_EQ(Target->GetNumResidentMips(), 0u);
+}
+
+TEST_F(TextureStreamingManagerTest, ReleasesTexturesNoLongerSeen)
+{
+	auto Target = CreateTexture("Texture.bin");
+	auto Mesh = AddMesh(Math::Vector3(0.0f, 0.0f, 5.0f), Target);
+
+	Simulate();
+	EXPECT_EQ(TextureStreamingManager::Get().GetStats().NumTextures, 1u);
+
+	m_Scene->RemovePrimitive(Mesh.get());
+	Simulate();
+
+	EXPECT_EQ(TextureStreamingManager::Get().GetStats().NumTextures, 0u);
+	EXPECT_EQ(Target->GetNumResidentMips(), 0u);
+}
@@ -0,0 +1,53 @@
+#include "Scene/BoxSphereBounds.h"
+#include <gtest/gtest.h>
+
+static void ExpectNear(const Math::Vector3& Actual, const Math::Vector3& Expected)
+{
+	EXPECT_NEAR(Actual.x, Expected.x, 1e-4f);
+	EXPECT_NEAR(Actual.y, Expected.y, 1e-4f);
+	EXPECT_NEAR(Actual.z, Expected.z, 1e-4f);
+}
+
+TEST(BoxSphereBoundsTest, TransformsByIdentity)
+{
+	const BoxSphereBounds Bounds(Math::Vector3(1.0f, 2.0f, 3.0f), Math::Vector3(1.0f, 2.0f, 3.0f), 4.0f);
+	const auto Transformed = Bounds.TransformBy(Math::Matrix());
+
+	ExpectNear(Transformed.GetOrigin(), Bounds.GetOrigin());
+	ExpectNear(Transformed.GetExtents(), Bounds.GetExtents());
+	EXPECT_FLOAT_EQ(Transformed.GetSphere().GetRadius(), 4.0f);
+}
+
+TEST(BoxSphereBoundsTest, TransformsByScaleRotationAndTranslation)
+{
+	const BoxSphereBounds Bounds(Math::Vector3(1.0f, 0.0f, 0.0f), Math::Vector3(1.0f, 2.0f, 3.0f), 4.0f);
+
+	/// Scale first, then a quarter turn around Z maps +X to +Y, then move.
+	const Math::Matrix Transform = Math::Matrix::Scaling(2.0f, 1.0f, 1.0f) * Math::Matrix::RotationZAxis(Math::PI_Div2) * Math::Matrix::Translation(10.0f, 0.0f, 0.0f);
+	const auto Transformed = Bounds.TransformBy(Transform);
+
+	ExpectNear(Transformed.GetOrigin(), Math::Vector3(10.0f, 2.0f, 0.0f));
+	ExpectNear(Transformed.GetExtents(), Math::Vector3(2.0f, 2.0f, 3.0f));
+	EXPECT_NEAR(Transformed.GetSphere().GetRadius(), 8.0f, 1e-4f);
+}
+
+TEST(BoxSphereBoundsTest, EnclosesRotatedBoxes)
+{
+	const BoxSphereBounds Bounds(Math::Vector3(0.0f), Math::Vector3(1.0f), std::sqrt(3.0f));
+	const auto Transformed = Bounds.TransformBy(Math::Matrix::RotationYAxis(Math::PI_Div4));
+
+	/// The box grows to hold the rotated corners, the sphere does not.
+	const float Diagonal = std::sqrt(2.0f);
+	ExpectNear(Transformed.GetExtents(), Math::Vector3(Diagonal, 1.0f, Diagonal));
+	EXPECT_NEAR(Transformed.GetSphere().GetRadius(), std::sqrt(3.0f), 1e-4f);
+}
+
+TEST(BoxSphereBoundsTest, TransformsTheSphereCenter)
+{
+	const BoxSphereBounds Bounds(Math::Vector3(5.0f, 0.0f, 0.0f), Math::Vector3(5.0f, 10.0f, 10.0f), Math::Vector3(10.0f, 0.0f, 0.0f), 10.0f);
+	const auto Transformed = Bounds.TransformBy(Math::Matrix::Scaling(2.0f, 2.0f, 2.0f) * Math::Matrix::Translation(0.0f, 0.0f, 5.0f));
+
+	ExpectNear(Transformed.GetOrigin(), Math::Vector3(10.0f, 0.0f, 5.0f));
+	ExpectNear(Transformed.GetSphere().GetCenter(), Math::Vector3(20.0f, 0.0f, 5.0f));
+	EXPECT_NEAR(Transformed.GetSphere().GetRadius(), 20.0f, 1e-4f);
+}
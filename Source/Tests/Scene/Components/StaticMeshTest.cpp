@@ -0,0 +1,137 @@
+#include "Common/TestUtils.h"
+#include "Scene/Components/StaticMesh.h"
+#include "Asset/AssetLoaders/MeshQuantizer.h"
+#include <gtest/gtest.h>
+#include <random>
+
+/// Point clouds with a single face, only the positions matter for the bounds.
+class StaticMeshTest : public ::testing::Test
+{
+protected:
+	static void SetUpTestSuite()
+	{
+		InitializeTaskSystem();
+	}
+
+	static MeshData CreateMesh(const std::vector<Math::Vector3>& Positions, const VertexLayout& Layout = VertexLayout())
+	{
+		MeshData Data(static_cast<uint32_t>(Positions.size()), 3u, 1u, true, false, true, false, false, false, ERHIPrimitiveTopology::TriangleList);
+		Data.SetFace(0u, 0u, 1u, 2u);
+		for (uint32_t Index = 0u; Index < Data.GetNumVertex(); ++Index)
+		{
+			Data.SetPosition(Index, Positions[Index]);
+			Data.SetNormal(Index, Math::Vector3(0.0f, 0.0f, 1.0f));
+			Data.SetUV0(Index, Math::Vector2(0.0f, 0.0f));
+		}
+		return Layout != Data.GetVertexLayout() ? MeshQuantizer::Quantize(Data, Layout) : Data;
+	}
+
+	static std::vector<Math::Vector3> CreateRandomPositions(size_t Count)
+	{
+		std::mt19937 Random(7u);
+		std::uniform_real_distribution<float> Coordinate(-3.0f, 5.0f);
+
+		std::vector<Math::Vector3> Positions(Count);
+		for (auto& Position : Positions)
+		{
+			Position = Math::Vector3(Coordinate(Random), Coordinate(Random) * 2.0f, Coordinate(Random) * 0.5f);
+		}
+		return Positions;
+	}
+
+	static void ExpectEncloses(const MeshData& Data, const BoxSphereBounds& Bounds, float Tolerance)
+	{
+		const Math::AABB Box = Bounds.GetAABB();
+		const Math::Sphere Sphere = Bounds.GetSphere();
+
+		for (uint32_t Index = 0u; Index < Data.GetNumVertex(); ++Index)
+		{
+			const Math::Vector3 Position = Data.GetPosition(Index);
+			EXPECT_GE(Position.x, Box.GetMin().x - Tolerance);
+			EXPECT_GE(Position.y, Box.GetMin().y - Tolerance);
+			EXPECT_GE(Position.z, Box.GetMin().z - Tolerance);
+			EXPECT_LE(Position.x, Box.GetMax().x + Tolerance);
+			EXPECT_LE(Position.y, Box.GetMax().y + Tolerance);
+			EXPECT_LE(Position.z, Box.GetMax().z + Tolerance);
+
+			const Math::Vector3 Delta = Position - Sphere.GetCenter();
+			EXPECT_LE(std::sqrt(Math::Dot(Delta, Delta)), Sphere.GetRadius() + Tolerance);
+		}
+	}
+
+	static void ExpectNear(const Math::Vector3& Actual, const Math::Vector3& Expected, float Tolerance)
+	{
+		EXPECT_NEAR(Actual.x, Expected.x, Tolerance);
+		EXPECT_NEAR(Actual.y, Expected.y, Tolerance);
+		EXPECT_NEAR(Actual.z, Expected.z, Tolerance);
+	}
+};
+
+TEST_F(StaticMeshTest, ComputesBoundsOfEveryLayout)
+{
+	const auto Positions = CreateRandomPositions(1000u);
+	const MeshData Reference = CreateMesh(Positions);
+	const BoxSphereBounds Expected = Reference.ComputeBounds(false);
+
+	ExpectEncloses(Reference, Expected, 1e-4f);
+	ExpectNear(Expected.GetAABB().GetMin(), Math::AABB::CreateFromVertices(Positions).GetMin(), 0.0f);
+	ExpectNear(Expected.GetAABB().GetMax(), Math::AABB::CreateFromVertices(Positions).GetMax(), 0.0f);
+
+	VertexLayout Interleaved;
+	Interleaved.Interleaved = true;
+
+	VertexLayout SNorm16;
+	SNorm16.Position = EPositionFormat::SNorm16x4;
+	SNorm16.Interleaved = true;
+
+	VertexLayout Half;
+	Half.Position = EPositionFormat::Half4;
+
+	/// Quantized bounds enclose the decoded positions, which are off the source by up to Extent / 4096 per axis for half floats,
+	/// 16 / 4096 for the widest axis here.
+	for (const auto& Layout : { Interleaved, SNorm16, Half })
+	{
+		const MeshData Data = CreateMesh(Positions, Layout);
+		const BoxSphereBounds Bounds = Data.ComputeBounds(false);
+		const float Tolerance = Layout.Position == EPositionFormat::Half4 ? 2.0f * 16.0f / 4096.0f : 1e-3f;
+
+		ExpectEncloses(Data, Bounds, 1e-4f);
+		ExpectNear(Bounds.GetOrigin(), Expected.GetOrigin(), Tolerance);
+		ExpectNear(Bounds.GetExtents(), Expected.GetExtents(), Tolerance);
+		EXPECT_NEAR(Bounds.GetSphere().GetRadius(), Expected.GetSphere().GetRadius(), Tolerance * 2.0f);
+	}
+}
+
+TEST_F(StaticMeshTest, ComputesTheSameBoundsInParallel)
+{
+	/// Several chunks of the parallel reduction.
+	const MeshData Data = CreateMesh(CreateRandomPositions(200000u));
+
+	const BoxSphereBounds Serial = Data.ComputeBounds(false);
+	const BoxSphereBounds Parallel = Data.ComputeBounds(true);
+
+	ExpectNear(Parallel.GetOrigin(), Serial.GetOrigin(), 0.0f);
+	ExpectNear(Parallel.GetExtents(), Serial.GetExtents(), 0.0f);
+	ExpectNear(Parallel.GetSphere().GetCenter(), Serial.GetSphere().GetCenter(), 0.0f);
+	EXPECT_EQ(Parallel.GetSphere().GetRadius(), Serial.GetSphere().GetRadius());
+}
+
+TEST_F(StaticMeshTest, FitsTheSphereAroundItsOwnCenter)
+{
+	/// A cone with the apex at the origin and a base circle of radius 10 at x = 10. The sphere around the box origin (5, 0, 0) needs a
+	/// radius of sqrt(125), the one around the base center (10, 0, 0) only 10.
+	std::vector<Math::Vector3> Positions{ Math::Vector3(0.0f) };
+	for (uint32_t Index = 0u; Index < 64u; ++Index)
+	{
+		const float Angle = Math::PI * 2.0f * Index / 64.0f;
+		Positions.emplace_back(10.0f, std::cos(Angle) * 10.0f, std::sin(Angle) * 10.0f);
+	}
+
+	const MeshData Data = CreateMesh(Positions);
+	const BoxSphereBounds Bounds = Data.ComputeBounds(false);
+
+	ExpectEncloses(Data, Bounds, 1e-4f);
+	ExpectNear(Bounds.GetOrigin(), Math::Vector3(5.0f, 0.0f, 0.0f), 1e-4f);
+	ExpectNear(Bounds.GetSphere().GetCenter(), Math::Vector3(10.0f, 0.0f, 0.0f), 1e-2f);
+	EXPECT_LT(Bounds.GetSphere().GetRadius(), 10.01f);
+}